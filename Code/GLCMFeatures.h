@@ -77,6 +77,11 @@ class GLCMFeatures{
         }
 		~GLCMFeatures() {
 		}
+		//voxel list of the VOI matrix if the mask is sparse, otherwise nullptr
+		const VoxelList<T> *voxelList = nullptr;
+		void setVoxelList(const VoxelList<T> *voxels) {
+			voxelList = voxels;
+		}
 
         //!define the different feature values of the GLCM matrix
         T jointMaximum =NAN;
@@ -111,43 +116,43 @@ class GLCMFeatures{
 
 
         void getXYDirections(int &directionX, int &directionY, int angle);
-		std::vector<std::pair<T, T> > getNeighbours2D(boost::multi_array<T, R> inputMatrix, int depth, int directionX, int directionY);
-		std::vector<std::pair<T, T> > getNeighbours3D(boost::multi_array<T, R> inputMatrix, int angle, int directionZ);
+		std::vector<std::pair<T, T> > getNeighbours2D(const boost::multi_array<T, R> &inputMatrix, int depth, int directionX, int directionY, const VoxelList<T> *voxels = nullptr);
+		std::vector<std::pair<T, T> > getNeighbours3D(const boost::multi_array<T, R> &inputMatrix, int angle, int directionZ, const VoxelList<T> *voxels = nullptr);
         void getDiagonalProbabilities(boost::multi_array<float, 2> &glcMatrix);
         void getCrossProbabilities(boost::multi_array<float, 2> &glcMatrix);
-		void calculateMeanRowProb(boost::multi_array<float, 2> glcMatrix);
-        void calculateMeanColProb(boost::multi_array<float, 2> glcMatrix);
-        void calculateRowProb(boost::multi_array<float, 2> glcMatrix);
-        void calculateColProb(boost::multi_array<float, 2> glcMatrix);
+		void calculateMeanRowProb(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateMeanColProb(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateRowProb(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateColProb(const boost::multi_array<float, 2> &glcMatrix);
 
 
-        void calculateJointMaximum(boost::multi_array<float, 2> glcMatrix);
-        void calculateJointAverage(boost::multi_array<float, 2> glcMatrix);
-        void calculateJointVariance(boost::multi_array<float, 2> glcMatrix, T jointAvg);
-        void calculateJointEntropy(boost::multi_array<float, 2> glcMatrix);
+        void calculateJointMaximum(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateJointAverage(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateJointVariance(const boost::multi_array<float, 2> &glcMatrix, T jointAvg);
+        void calculateJointEntropy(const boost::multi_array<float, 2> &glcMatrix);
         void calculateDiffAverage();
         void calculateDiffVariance(T diffAverage);
         void calculateDiffEntropy();
         void calculateSumAverage();
         void calculateSumVariance(T sumAverage);
         void calculateSumEntropy();
-        void calculateAngSecMoment(boost::multi_array<float, 2> glcMatrix);
-        void calculateContrast(boost::multi_array<float, 2> glcMatrix);
-        void calculateDissimilarity(boost::multi_array<float, 2> glcMatrix);
-        void calculateInverseDiff(boost::multi_array<float, 2> glcMatrix);
-        void calculateInverseDiffNorm(boost::multi_array<float, 2> glcMatrix, T inverseDiff);
-        void calculateInverseDiffMom(boost::multi_array<float, 2> glcMatrix);
-        void calculateInverseDiffMomNorm(boost::multi_array<float, 2> glcMatrix);
-        void calculateInverseVariance(boost::multi_array<float, 2> glcMatrix);
-        void calculateCorrelation(boost::multi_array<float, 2> glcMatrix);
-
-
-        void calculateAutoCorrelation(boost::multi_array<float, 2> glcMatrix);
-        void calculateClusterTendency(boost::multi_array<float, 2> glcMatrix);
-        void calculateClusterShade(boost::multi_array<float, 2> glcMatrix);
-        void calculateClusterProminence(boost::multi_array<float, 2> glcMatrix);
-        void calculateFirstMCorrelation(boost::multi_array<float, 2> glcMatrix);
-        void calculateSecondMCorrelation(boost::multi_array<float, 2> glcMatrix);
+        void calculateAngSecMoment(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateContrast(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateDissimilarity(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateInverseDiff(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateInverseDiffNorm(const boost::multi_array<float, 2> &glcMatrix, T inverseDiff);
+        void calculateInverseDiffMom(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateInverseDiffMomNorm(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateInverseVariance(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateCorrelation(const boost::multi_array<float, 2> &glcMatrix);
+
+
+        void calculateAutoCorrelation(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateClusterTendency(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateClusterShade(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateClusterProminence(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateFirstMCorrelation(const boost::multi_array<float, 2> &glcMatrix);
+        void calculateSecondMCorrelation(const boost::multi_array<float, 2> &glcMatrix);
 
         //store the feature values in a csv-file
         void defineGLCMFeatures(vector<string> &features);
@@ -199,6 +204,7 @@ void GLCMFeatures<T, R>::getXYDirections(int &directionX, int &directionY, int a
 The method getNeighbors2D stores all neighbor pairs for the desired angle and the actual input matrix in a vector
 @param[in] inputMatrix: the original matrix of the VOI
 @param[in] angle : the actual angle
+@param[in] voxels: voxel list of the VOI matrix if the mask is sparse, otherwise nullptr
 @param[out] neighbors: vector containing all neighbor pairs of the actual direction
 
 The method works as follows: \n
@@ -206,27 +212,28 @@ It looks for every matrix elements at the neighbors of the desired direction and
 its neighbors. These pairs are stored in a vector and are returned.
 */
 template <class T, size_t R>
-std::vector<std::pair<T, T> > GLCMFeatures<T, R>::getNeighbours2D(boost::multi_array<T, R> inputMatrix, int depth, int directionX, int directionY) {
+std::vector<std::pair<T, T> > GLCMFeatures<T, R>::getNeighbours2D(const boost::multi_array<T, R> &inputMatrix, int depth, int directionX, int directionY, const VoxelList<T> *voxels) {
 	//store the neighbours as pairs in a vector
 	std::vector<std::pair<T, T> > neighbours;
 
 
-	T neighbour1;
-	T neighbour2;
 	int maxRowNumber = inputMatrix.shape()[0];
 	int maxColNumber = inputMatrix.shape()[1];
-
-	for (int row = 0; row < maxRowNumber; row++) {
-		//find now the neighbors, row by row
-		for (int col = 0; col < maxColNumber - directionX*(directionX + 1) / 2; col++) {
-			if (row - directionY > -1 && col + directionX > -1) {
-				neighbour1 = inputMatrix[row][col][depth];
-				neighbour2 = inputMatrix[row - directionY][col + directionX][depth];
-
-				neighbours.push_back(std::make_pair(neighbour1, neighbour2));
-			}
-		}
+	//reserve the maximal number of pairs once, so that the vector does not grow while it is filled
+	if (voxels != nullptr) {
+		neighbours.reserve(voxels->sliceOffsets[depth + 1] - voxels->sliceOffsets[depth]);
+	}
+	else {
+		neighbours.reserve(maxRowNumber*maxColNumber);
 	}
+	//find now the neighbors, row by row (if the mask is sparse only for the voxels inside the mask)
+	forEachVoxelInSlice(inputMatrix, voxels, depth, [&](int row, int col, int actDepth) {
+		if (col < maxColNumber - directionX*(directionX + 1) / 2 && row - directionY > -1 && col + directionX > -1) {
+			T neighbour1 = inputMatrix[row][col][actDepth];
+			T neighbour2 = inputMatrix[row - directionY][col + directionX][actDepth];
+			neighbours.push_back(std::make_pair(neighbour1, neighbour2));
+		}
+	});
 
 	return neighbours;
 }
@@ -236,13 +243,14 @@ The method getNeighbors3D stores all neighbor pairs for the desired angle and th
 @param[in] inputMatrix: the original matrix of the VOI
 @param[in] angle : the actual angle
 @param[in] directionZ: goes in the z-direction, adds the 3D calculation
+@param[in] voxels: voxel list of the VOI matrix if the mask is sparse, otherwise nullptr
 @param[out] neighbors: vector containing all neighbor pairs of the actual direction
 The method works as follows: \n
 It looks for every matrix elements at the neighbors of the desired direction and makes a pair of the actual matrix element and
 its neighbors. These pairs are stored in a vector and are returned.
 */
 template <class T, size_t R>
-std::vector<std::pair<T, T> > GLCMFeatures<T, R>::getNeighbours3D(boost::multi_array<T, R> inputMatrix, int angle, int directionZ) {
+std::vector<std::pair<T, T> > GLCMFeatures<T, R>::getNeighbours3D(const boost::multi_array<T, R> &inputMatrix, int angle, int directionZ, const VoxelList<T> *voxels) {
 	//    store the neighbours as pairs in a vector
 	std::vector<std::pair<T, T> > neighbours;
 	int directionX;
@@ -251,24 +259,24 @@ std::vector<std::pair<T, T> > GLCMFeatures<T, R>::getNeighbours3D(boost::multi_a
 	GLCMFeatures<T, R> glcm;
 	glcm.getXYDirections(directionX, directionY, angle);
 
-	T neighbour1;
-	T neighbour2;
-	int maxRowNumber = inputMatrix.shape()[0];
 	int maxColNumber = inputMatrix.shape()[1];
 	int maxDepthNumber = inputMatrix.shape()[2];
+	if (voxels != nullptr) {
+		neighbours.reserve(voxels->size());
+	}
+	else {
+		neighbours.reserve(inputMatrix.num_elements());
+	}
 	//if we have a 3D image go also in the depth
-	for (int depth = 0; depth < maxDepthNumber - directionZ*(directionZ + 1) / 2; depth++) {
-		for (int row = 0; row < maxRowNumber; row++) {
-			//find now the neighbors, row by row
-			for (int col = 0; col < maxColNumber - directionX*(directionX + 1) / 2; col++) {
-				neighbour1 = inputMatrix[row][col][depth];
-				if (row - directionY > -1 && col + directionX > -1 && depth + directionZ > -1) {
-					neighbour2 = inputMatrix[row - directionY][col + directionX][depth + directionZ];
-					neighbours.push_back(std::make_pair(neighbour1, neighbour2));
-				}
+	forEachVoxel(inputMatrix, voxels, [&](int row, int col, int depth) {
+		if (depth < maxDepthNumber - directionZ*(directionZ + 1) / 2 && col < maxColNumber - directionX*(directionX + 1) / 2) {
+			if (row - directionY > -1 && col + directionX > -1 && depth + directionZ > -1) {
+				T neighbour1 = inputMatrix[row][col][depth];
+				T neighbour2 = inputMatrix[row - directionY][col + directionX][depth + directionZ];
+				neighbours.push_back(std::make_pair(neighbour1, neighbour2));
 			}
 		}
-	}
+	});
 	return neighbours;
 }
 
@@ -280,7 +288,7 @@ std::vector<std::pair<T, T> > GLCMFeatures<T, R>::getNeighbours3D(boost::multi_a
 Calculate the mean row probability
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateMeanRowProb(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateMeanRowProb(const boost::multi_array<float, 2> &glcMatrix){
     calculateRowProb(glcMatrix);
     meanRowProb = 0;
 	stdRowProb = 0;
@@ -301,7 +309,7 @@ void GLCMFeatures<T,R>::calculateMeanRowProb(boost::multi_array<float, 2> glcMat
 Calculate the mean column probability
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateMeanColProb(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateMeanColProb(const boost::multi_array<float, 2> &glcMatrix){
     calculateColProb(glcMatrix);
     meanColProb = 0;
     for(int k = 0; k < N_g; k++){
@@ -353,7 +361,7 @@ Calculate the sum of the row probabilities and store them in vector sumProbRows
 formula see above
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateRowProb(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateRowProb(const boost::multi_array<float, 2> &glcMatrix){
     T rowProb;
     sumProbRows.clear();
     for(int i = 0; i < N_g; i++ ){
@@ -374,7 +382,7 @@ Calculate the sum of the col probabilities and store them in vector sumProbCOls
 formula see above
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateColProb(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateColProb(const boost::multi_array<float, 2> &glcMatrix){
     T colProb;
     sumProbCols.clear();
     for(int j = 0; j < N_g; j++ ){
@@ -418,7 +426,7 @@ void GLCMFeatures<T, R>::getCrossProbabilities(boost::multi_array<float, 2> &glc
 The joint maximum is the probability belonging to the neighbor pair which occurs the most in the VOI
 */
 template <class T, size_t R>
-void GLCMFeatures<T, R>::calculateJointMaximum(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T, R>::calculateJointMaximum(const boost::multi_array<float, 2> &glcMatrix){
     N_g = glcMatrix.shape()[0];
     jointMaximum = *max_element( glcMatrix.origin(), glcMatrix.origin() + glcMatrix.num_elements());
 }
@@ -429,7 +437,7 @@ The joint average is the sum of joint probabilities. This sum is weighted by the
 probabilities.
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateJointAverage(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateJointAverage(const boost::multi_array<float, 2> &glcMatrix){
     jointAverage = 0;
     for(int row = 0; row < N_g; row++){
         for(int col = 0; col < N_g; col++){
@@ -447,7 +455,7 @@ Calculates the joint variance using the joint average defined before \n
 The joint variance is the variance of the numbers of neighbor pairs
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateJointVariance(boost::multi_array<float, 2> glcMatrix, T jointAvg){
+void GLCMFeatures<T,R>::calculateJointVariance(const boost::multi_array<float, 2> &glcMatrix, T jointAvg){
     jointVariance = 0;
     for(int row = 0; row < N_g; row++){
         for(int col = 0; col < N_g; col++){
@@ -464,7 +472,7 @@ Calculates the joint entropy \n
 The joint entropy is a measurement for the uncertainity of numbers of neighbor pairs
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateJointEntropy(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateJointEntropy(const boost::multi_array<float, 2> &glcMatrix){
     jointEntropy = 0;
     float actElement;
     for(int i = 0; i < N_g; i++){
@@ -578,7 +586,7 @@ void GLCMFeatures<T,R>::calculateSumEntropy(){
 The angular second moment is the same as the energy of the probability distribution
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateAngSecMoment(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateAngSecMoment(const boost::multi_array<float, 2> &glcMatrix){
     angSecMoment = for_each(glcMatrix.origin(), glcMatrix.origin() + glcMatrix.num_elements(), square_accumulate<float>()).result();
 }
 
@@ -592,7 +600,7 @@ The contrast is a weighted sum of the elements of the GLC-matrix. The bigger the
 the higher the weight
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateContrast(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateContrast(const boost::multi_array<float, 2> &glcMatrix){
     contrast = 0;
     for(int i = 0; i < N_g; i++){
         for(int j = 0; j < N_g; j++){
@@ -610,7 +618,7 @@ The calculation of the dissimilarity is similar to the calculation of the contra
 It represents the mean difference of the intensity values between neighboring pixels/voxels
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateDissimilarity(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateDissimilarity(const boost::multi_array<float, 2> &glcMatrix){
     dissimilarity = 0;
     for(int i = 0; i < N_g; i++){
         for(int j = 0; j < N_g; j++){
@@ -630,7 +638,7 @@ The more equal the neighbor pairs are, the lower is the denominator and the high
 
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateInverseDiff(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateInverseDiff(const boost::multi_array<float, 2> &glcMatrix){
     inverseDiff = 0;
     for(int i = 0; i < N_g; i++){
         for(int j = 0; j < N_g; j++){
@@ -648,7 +656,7 @@ The calculation of the inverse difference norm is similar to the inverse differe
 The difference of the intensity differences is here normalised by the number of different grey levels \n
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateInverseDiffNorm(boost::multi_array<float, 2> glcMatrix, T inverseDiff){
+void GLCMFeatures<T,R>::calculateInverseDiffNorm(const boost::multi_array<float, 2> &glcMatrix, T inverseDiff){
     inverseDiffNorm = 0;
     for(int i = 0; i < N_g; i++){
         for(int j = 0; j < N_g; j++){
@@ -667,7 +675,7 @@ It is also a weighted sum of the elements of the GLC-matrix. The higher the inte
 pair differ, the smaller is the weight.
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateInverseDiffMom(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateInverseDiffMom(const boost::multi_array<float, 2> &glcMatrix){
     inverseDiffMom = 0;
     for(int i = 0; i < N_g; i++){
         for(int j = 0; j < N_g; j++){
@@ -686,7 +694,7 @@ The calculation of the inverse difference moment norm is similar to the one of i
 Here the difference of the intensities of neighbor pairs is normalised by the number of grey levels
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateInverseDiffMomNorm(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateInverseDiffMomNorm(const boost::multi_array<float, 2> &glcMatrix){
     inverseDiffMomNorm = 0;
     for(int i = 0; i < N_g; i++){
         for(int j = 0; j < N_g;j++){
@@ -703,7 +711,7 @@ void GLCMFeatures<T,R>::calculateInverseDiffMomNorm(boost::multi_array<float, 2>
 The inverse variance is another measure if the image is locally homogen or not.
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateInverseVariance(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateInverseVariance(const boost::multi_array<float, 2> &glcMatrix){
     inverseVar = 0;
     for(int i = 0; i < N_g;  i++){
         for(int j = i + 1; j < N_g; j++){
@@ -719,7 +727,7 @@ void GLCMFeatures<T,R>::calculateInverseVariance(boost::multi_array<float, 2> gl
 The correlation shows the correlation between different grey values
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateCorrelation(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateCorrelation(const boost::multi_array<float, 2> &glcMatrix){
     calculateMeanColProb(glcMatrix);
     calculateMeanRowProb(glcMatrix);
     correlation = 0;
@@ -740,7 +748,7 @@ void GLCMFeatures<T,R>::calculateCorrelation(boost::multi_array<float, 2> glcMat
 AUto correlation measures the fineness or coarseness of the VOI.
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateAutoCorrelation(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateAutoCorrelation(const boost::multi_array<float, 2> &glcMatrix){
     autoCorrelation = 0;
     for(int row = 1; row < N_g + 1; row++){
         for(int col = 1; col < N_g + 1; col++){
@@ -758,7 +766,7 @@ void GLCMFeatures<T,R>::calculateAutoCorrelation(boost::multi_array<float, 2> gl
 The cluster tendency gives information about the formation of voxels with similar grey values in groups
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateClusterTendency(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateClusterTendency(const boost::multi_array<float, 2> &glcMatrix){
     clusterTendency = 0;
     for(int i = 0; i < N_g; i++ ){
         for(int j = 0; j < N_g; j++){
@@ -774,7 +782,7 @@ void GLCMFeatures<T,R>::calculateClusterTendency(boost::multi_array<float, 2> gl
 The cluster shade measures the skewness and asymmetry of the VOI
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateClusterShade(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateClusterShade(const boost::multi_array<float, 2> &glcMatrix){
     clusterShade = 0;
     for(int i = 0; i < N_g; i++ ){
         for(int j = 0; j < N_g; j++){
@@ -791,7 +799,7 @@ void GLCMFeatures<T,R>::calculateClusterShade(boost::multi_array<float, 2> glcMa
 The cluster prominence gives also information about the skewness and asymmetry of the VOI (higher value: more assymetry)
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateClusterProminence(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateClusterProminence(const boost::multi_array<float, 2> &glcMatrix){
     clusterProminence = 0;
     for(int i = 0; i < N_g; i++ ){
         for(int j = 0; j < N_g; j++){
@@ -807,7 +815,7 @@ void GLCMFeatures<T,R>::calculateClusterProminence(boost::multi_array<float, 2>
 The first moment of correlation measures as well the homogeneity
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateFirstMCorrelation(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateFirstMCorrelation(const boost::multi_array<float, 2> &glcMatrix){
     HXY = 0;
     HX = 0;
     HXY1 = 0;
@@ -842,7 +850,7 @@ void GLCMFeatures<T,R>::calculateFirstMCorrelation(boost::multi_array<float, 2>
 The second moment of correlation measures the similarity in intensity values for neighbor pairs
 */
 template <class T, size_t R>
-void GLCMFeatures<T,R>::calculateSecondMCorrelation(boost::multi_array<float, 2> glcMatrix){
+void GLCMFeatures<T,R>::calculateSecondMCorrelation(const boost::multi_array<float, 2> &glcMatrix){
     HXY2 = 0;
     for(int i = 0; i < N_g; i++ ){
       for(int j = 0; j < N_g; j++){
@@ -19,7 +19,7 @@ class GLCMFeatures2DAVG : public GLCMFeatures<T,R>  {
 
         void extractGLCMDataAVG(vector<T> &glcmData, GLCMFeatures2DAVG<T, R> glcmFeatures);
         
-        boost::multi_array<float, 2> calculateMatrix2DAVG( boost::multi_array<T, R> inputMatrix, int depth, int angle);
+        void calculateMatrix2DAVG( const boost::multi_array<T, R> &inputMatrix, int depth, int angle, boost::multi_array<float, 2> &GLCMatrix);
 
         vector<T> diagonalProbabilities;
         vector<T> crossProbabilities;
@@ -35,10 +35,10 @@ class GLCMFeatures2DAVG : public GLCMFeatures<T,R>  {
 		}
 		~GLCMFeatures2DAVG() {
 		}
-        void calculateAllGLCMFeatures2DAVG(GLCMFeatures2DAVG<T,R> &glcmFeat, boost::multi_array<T,R> inputMatrix, float maxIntensity);
-		void fill2DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle);
+        void calculateAllGLCMFeatures2DAVG(GLCMFeatures2DAVG<T,R> &glcmFeat, const boost::multi_array<T,R> &inputMatrix, float maxIntensity);
+		void fill2DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle);
         void writeCSVFileGLCM2DAVG(GLCMFeatures2DAVG<T,R> glcmFeat, string outputFolder);
-		void writeOneFileGLCM2DAVG(GLCMFeatures2DAVG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr);
+		void writeOneFileGLCM2DAVG(GLCMFeatures2DAVG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr);
 };
 
 
@@ -47,18 +47,11 @@ In the method calculateMatrix the GLCM-matrices for every direction are calculat
 matrices is divided by the sum of the elements (= nr. of neighbor pairs) to obtain a matrix which contains the probabilities
 for the occurence of every neighbor pair.
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[out]: GLCM-matrix
+@param[out]: GLCM-matrix, it has the size sizeMatrix x sizeMatrix and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLCMFeatures2DAVG<T,R>::calculateMatrix2DAVG( boost::multi_array<T, R> inputMatrix, int depth, int angle){
-    typedef boost::multi_array<float, 2> glcmat;
-
-    glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
-
+void GLCMFeatures2DAVG<T,R>::calculateMatrix2DAVG( const boost::multi_array<T, R> &inputMatrix, int depth, int angle, boost::multi_array<float, 2> &GLCMatrix){
     fill2DMatrices(inputMatrix, GLCMatrix, depth,angle);
-
-    return GLCMatrix;
-
 }
 
 
@@ -76,29 +69,33 @@ As next step, the GLCMatrix is filled: for every neighborpair the position in th
 the value on this position of the GLCMatrix is increased +1
 */
 template <class T, size_t R>
-void GLCMFeatures2DAVG<T, R>::fill2DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle){
+void GLCMFeatures2DAVG<T, R>::fill2DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle){
     //vector in which all neihbor pairs are stored
      std::vector<std::pair<T, T> > neighbours;
 	 int directionX;
 	 int directionY;
 	 //define in which direction you have to look for a neighbor
 	 glcmComb.getXYDirections(directionX, directionY, angle);
-     neighbours = glcmComb.getNeighbours2D(inputMatrix, depth,  directionX, directionY);
-     std::pair<T, T> actNeighbour;
-     //iterate over the neighbor-vector
-     for(int neighbourNr =0; neighbourNr<neighbours.size(); neighbourNr++){
-        actNeighbour = neighbours[neighbourNr];
-
-        if(!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)){
-            glcMatrix[actNeighbour.first-1][actNeighbour.second-1] += 1;
-        }
-     }
+     //the counts are taken from the texture matrix store if they were stored before
+     string matrixKey = getTextureMatrixKey("GLCM2D", depth, angle);
+     TextureMatrixStore::caseStore().fillPairMatrix(matrixKey, inputMatrix, glcMatrix, depth, -directionY, directionX, 0, [&]() {
+         neighbours = glcmComb.getNeighbours2D(inputMatrix, depth,  directionX, directionY, sparseVoxels(this->voxelList, inputMatrix));
+         std::pair<T, T> actNeighbour;
+         //iterate over the neighbor-vector
+         for(int neighbourNr =0; neighbourNr<neighbours.size(); neighbourNr++){
+            actNeighbour = neighbours[neighbourNr];
+
+            if(!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)){
+                glcMatrix[actNeighbour.first-1][actNeighbour.second-1] += 1;
+            }
+         }
+     });
 
 }
 
 
 template <class T, size_t R>
-void GLCMFeatures2DAVG<T, R>::calculateAllGLCMFeatures2DAVG(GLCMFeatures2DAVG<T,R> &glcmFeatures, boost::multi_array<T, R> inputMatrix, float maxIntensity){
+void GLCMFeatures2DAVG<T, R>::calculateAllGLCMFeatures2DAVG(GLCMFeatures2DAVG<T,R> &glcmFeatures, const boost::multi_array<T, R> &inputMatrix, float maxIntensity){
     T sumJointMaximum = 0;
     T sumJointAverage = 0;
     T sumJointVariance = 0;
@@ -133,9 +130,13 @@ void GLCMFeatures2DAVG<T, R>::calculateAllGLCMFeatures2DAVG(GLCMFeatures2DAVG<T,
     for(int depth = 0; depth < totalDepth; depth++){
         for(int i = 0; i < 4; i++){
           ang = 180-i*45;
-          boost::multi_array<float,2> sum(boost::extents[sizeMatrix][sizeMatrix]) ;
-          boost::multi_array<float,2> inverseMatrix(boost::extents[sizeMatrix][sizeMatrix]);
-          boost::multi_array<float,2> GLCMatrix = glcmFeatures.calculateMatrix2DAVG(inputMatrix, depth, ang);
+          ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+          boost::multi_array<float,2> &GLCMatrix = GLCMatrixBuffer.get();
+          ScratchMatrix<float> sumBuffer(sizeMatrix, sizeMatrix);
+          boost::multi_array<float,2> &sum = sumBuffer.get();
+          ScratchMatrix<float> inverseMatrixBuffer(sizeMatrix, sizeMatrix);
+          boost::multi_array<float,2> &inverseMatrix = inverseMatrixBuffer.get();
+          glcmFeatures.calculateMatrix2DAVG(inputMatrix, depth, ang, GLCMatrix);
 		  
           sum = GLCMatrix;
           inverse(GLCMatrix, inverseMatrix);
@@ -254,7 +255,7 @@ void GLCMFeatures2DAVG<T, R>::writeCSVFileGLCM2DAVG(GLCMFeatures2DAVG<T,R> glcmF
 }
 
 template <class T, size_t R>
-void GLCMFeatures2DAVG<T, R>::writeOneFileGLCM2DAVG(GLCMFeatures2DAVG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLCMFeatures2DAVG<T, R>::writeOneFileGLCM2DAVG(GLCMFeatures2DAVG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
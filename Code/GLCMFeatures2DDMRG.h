@@ -19,7 +19,7 @@ private:
 
 	void extractGLCMDataDMRG(vector<T> &glcmData, GLCMFeatures2DDMRG<T, R> glcmFeatures);
 	//void fill2DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle);
-	boost::multi_array<float, 2> calculateMatrix2DDMRG(boost::multi_array<T, R> inputMatrix, int angle);
+	void calculateMatrix2DDMRG(const boost::multi_array<T, R> &inputMatrix, int angle, boost::multi_array<float, 2> &sum);
 
 	vector<T> diagonalProbabilities;
 	vector<T> crossProbabilities;
@@ -31,13 +31,14 @@ private:
 	T HXY2;
 
 public:
+	using GLCMFeatures2DAVG<T, R>::setVoxelList;
 	GLCMFeatures2DDMRG() {
 	}
 	~GLCMFeatures2DDMRG() {
 	}
-	void calculateAllGLCMFeatures2DDMRG(GLCMFeatures2DDMRG<T, R> &glcmFeat, boost::multi_array<T, R> inputMatrix, float maxIntensity);
+	void calculateAllGLCMFeatures2DDMRG(GLCMFeatures2DDMRG<T, R> &glcmFeat, const boost::multi_array<T, R> &inputMatrix, float maxIntensity);
 	void writeCSVFileGLCM2DDMRG(GLCMFeatures2DDMRG<T, R> glcmFeat, string outputFolder);
-	void writeOneFileGLCM2DDMRG(GLCMFeatures2DDMRG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileGLCM2DDMRG(GLCMFeatures2DDMRG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr);
 };
 
 
@@ -46,16 +47,18 @@ In the method calculateMatrix the GLCM-matrices for every direction are calculat
 matrices is divided by the sum of the elements (= nr. of neighbor pairs) to obtain a matrix which contains the probabilities
 for the occurence of every neighbor pair.
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[out]: GLCM-matrix
+@param[out]: GLCM-matrix, it has the size sizeMatrix x sizeMatrix and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLCMFeatures2DDMRG<T, R>::calculateMatrix2DDMRG(boost::multi_array<T, R> inputMatrix, int angle) {
+void GLCMFeatures2DDMRG<T, R>::calculateMatrix2DDMRG(const boost::multi_array<T, R> &inputMatrix, int angle, boost::multi_array<float, 2> &sum) {
 	typedef boost::multi_array<float, 2> glcmat;
 	GLCMFeatures2DAVG<T, R> glcmAVG;
-	glcmat sum(boost::extents[sizeMatrix][sizeMatrix]);
+	glcmAVG.setVoxelList(this->voxelList);
 	for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
-		glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
-		glcmat inverseMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+		ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+		glcmat &GLCMatrix = GLCMatrixBuffer.get();
+		ScratchMatrix<float> inverseMatrixBuffer(sizeMatrix, sizeMatrix);
+		glcmat &inverseMatrix = inverseMatrixBuffer.get();
 		glcmAVG.fill2DMatrices(inputMatrix, GLCMatrix, depth, angle);
 		inverse(GLCMatrix, inverseMatrix);
 		matrixSum(sum, GLCMatrix);
@@ -69,13 +72,12 @@ boost::multi_array<float, 2> GLCMFeatures2DDMRG<T, R>::calculateMatrix2DDMRG(boo
 		transform(sum.origin(), sum.origin() + sum.num_elements(),
 			sum.origin(), bind2nd(std::divides<float>(), int(sumMatrElement)));
 	}
-	return sum;
 }
 
 
 
 template <class T, size_t R>
-void GLCMFeatures2DDMRG<T, R>::calculateAllGLCMFeatures2DDMRG(GLCMFeatures2DDMRG<T, R> &glcmFeatures, boost::multi_array<T, R> inputMatrix, float maxIntensity) {
+void GLCMFeatures2DDMRG<T, R>::calculateAllGLCMFeatures2DDMRG(GLCMFeatures2DDMRG<T, R> &glcmFeatures, const boost::multi_array<T, R> &inputMatrix, float maxIntensity) {
 	
 	T sumJointMaximum = 0;
 	T sumJointAverage = 0;
@@ -110,7 +112,9 @@ void GLCMFeatures2DDMRG<T, R>::calculateAllGLCMFeatures2DDMRG(GLCMFeatures2DDMRG
 	sizeMatrix = maxIntensity;
 	for (int i = 0; i < 4; i++) {
 		ang = 180 - i * 45;
-		boost::multi_array<float, 2> GLCMatrix = glcmFeatures.calculateMatrix2DDMRG(inputMatrix, ang);
+		ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+		boost::multi_array<float, 2> &GLCMatrix = GLCMatrixBuffer.get();
+		glcmFeatures.calculateMatrix2DDMRG(inputMatrix, ang, GLCMatrix);
 
 		glcmFeatures.calculateJointMaximum(GLCMatrix);
 		sumJointMaximum += this->jointMaximum;
@@ -218,7 +222,7 @@ void GLCMFeatures2DDMRG<T, R>::writeCSVFileGLCM2DDMRG(GLCMFeatures2DDMRG<T, R> g
 }
 
 template <class T, size_t R>
-void GLCMFeatures2DDMRG<T, R>::writeOneFileGLCM2DDMRG(GLCMFeatures2DDMRG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLCMFeatures2DDMRG<T, R>::writeOneFileGLCM2DDMRG(GLCMFeatures2DDMRG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -22,8 +22,8 @@ class GLCMFeatures2DMRG : GLCMFeatures<T,R>  {
         GLCMFeatures<T, R> glcmComb;
 
         void extractGLCMDataMRG(vector<T> &glcmData, GLCMFeatures2DMRG<T, R> glcmFeatures);
-        void fill2DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle);
-        boost::multi_array<float, 2> calculateMatrix2DMRG( boost::multi_array<T, R> inputMatrix, int depth, float maxIntensity);
+        void fill2DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle);
+        void calculateMatrix2DMRG( const boost::multi_array<T, R> &inputMatrix, int depth, float maxIntensity, boost::multi_array<float, 2> &sum);
 
         vector<T> diagonalProbabilities;
         vector<T> crossProbabilities;
@@ -35,13 +35,14 @@ class GLCMFeatures2DMRG : GLCMFeatures<T,R>  {
         T HXY2;
 
     public:
+		using GLCMFeatures<T, R>::setVoxelList;
 		GLCMFeatures2DMRG() {
 		}
 		~GLCMFeatures2DMRG() {
 		}
-        void calculateAllGLCMFeatures2DMRG(GLCMFeatures2DMRG<T,R> &glcmFeat, boost::multi_array<T,R> inputMatrix, float maxIntensity, vector<float> spacing, ConfigFile config);
+        void calculateAllGLCMFeatures2DMRG(GLCMFeatures2DMRG<T,R> &glcmFeat, const boost::multi_array<T,R> &inputMatrix, float maxIntensity, const vector<float> &spacing, const ConfigFile &config);
         void writeCSVFileGLCM2DMRG(GLCMFeatures2DMRG<T,R> glcmFeat, string outputFolder);
-		void writeOneFileGLCM2DMRG(GLCMFeatures2DMRG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr);
+		void writeOneFileGLCM2DMRG(GLCMFeatures2DMRG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr);
 };
 
 
@@ -50,18 +51,19 @@ In the method calculateMatrix the GLCM-matrices for every direction are calculat
 matrices is divided by the sum of the elements (= nr. of neighbor pairs) to obtain a matrix which contains the probabilities
 for the occurence of every neighbor pair.
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[out]: GLCM-matrix
+@param[out]: GLCM-matrix, it has the size maxIntensity x maxIntensity and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLCMFeatures2DMRG<T,R>::calculateMatrix2DMRG( boost::multi_array<T, R> inputMatrix, int depth, float maxIntensity){
+void GLCMFeatures2DMRG<T,R>::calculateMatrix2DMRG( const boost::multi_array<T, R> &inputMatrix, int depth, float maxIntensity, boost::multi_array<float, 2> &sum){
     typedef boost::multi_array<float, 2> glcmat;
     int sizeMatrix = maxIntensity;
     int ang;
-    glcmat sum(boost::extents[sizeMatrix][sizeMatrix]);
     for(int i = 0; i<4; i++){
             ang = 180-i*45;
-            glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
-            glcmat inverseMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+            ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+            glcmat &GLCMatrix = GLCMatrixBuffer.get();
+            ScratchMatrix<float> inverseMatrixBuffer(sizeMatrix, sizeMatrix);
+            glcmat &inverseMatrix = inverseMatrixBuffer.get();
             fill2DMatrices(inputMatrix, GLCMatrix, depth,ang);
             inverse(GLCMatrix, inverseMatrix);
             matrixSum(sum, GLCMatrix);
@@ -76,8 +78,6 @@ boost::multi_array<float, 2> GLCMFeatures2DMRG<T,R>::calculateMatrix2DMRG( boost
 		transform(sum.origin(), sum.origin() + sum.num_elements(),
 			sum.origin(), bind2nd(std::divides<double>(), int(sumMatrElement)));
 	}
-    return sum;
-
 }
 
 
@@ -95,7 +95,7 @@ As next step, the GLCMatrix is filled: for every neighborpair the position in th
 the value on this position of the GLCMatrix is increased +1
 */
 template <class T, size_t R>
-void GLCMFeatures2DMRG<T, R>::fill2DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle){
+void GLCMFeatures2DMRG<T, R>::fill2DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle){
     //vector in which all neihbor pairs are stored
     std::vector<std::pair<T, T> > neighbours;
     float weight;
@@ -105,15 +105,19 @@ void GLCMFeatures2DMRG<T, R>::fill2DMatrices(boost::multi_array<T, R> inputMatri
     //define in which direction you have to look for a neighbor
     glcmComb.getXYDirections(directionX, directionY, angle);
      //fill this vector
-     neighbours = glcmComb.getNeighbours2D(inputMatrix, depth,  directionX, directionY);
-     std::pair<T, T> actNeighbour;
-     //iterate over the neighbor-vector
-     for(int neighbourNr =0; neighbourNr<neighbours.size(); neighbourNr++){
-        actNeighbour = neighbours[neighbourNr];
-        if(!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)){
-            glcMatrix[actNeighbour.first-1][actNeighbour.second-1] += 1;
-        }
-     }
+     //the counts are taken from the texture matrix store if they were stored before
+     string matrixKey = getTextureMatrixKey("GLCM2D", depth, angle);
+     TextureMatrixStore::caseStore().fillPairMatrix(matrixKey, inputMatrix, glcMatrix, depth, -directionY, directionX, 0, [&]() {
+         neighbours = glcmComb.getNeighbours2D(inputMatrix, depth,  directionX, directionY, sparseVoxels(this->voxelList, inputMatrix));
+         std::pair<T, T> actNeighbour;
+         //iterate over the neighbor-vector
+         for(int neighbourNr =0; neighbourNr<neighbours.size(); neighbourNr++){
+            actNeighbour = neighbours[neighbourNr];
+            if(!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)){
+                glcMatrix[actNeighbour.first-1][actNeighbour.second-1] += 1;
+            }
+         }
+     });
 	 weight = calculateWeight2D(directionX, directionY, normGLCM, actualSpacing);
      multSkalarMatrix(glcMatrix, weight);
 }
@@ -121,7 +125,7 @@ void GLCMFeatures2DMRG<T, R>::fill2DMatrices(boost::multi_array<T, R> inputMatri
 
 
 template <class T, size_t R>
-void GLCMFeatures2DMRG<T, R>::calculateAllGLCMFeatures2DMRG(GLCMFeatures2DMRG<T,R> &glcmFeatures, boost::multi_array<T, R> inputMatrix, float maxIntensity, vector<float> spacing, ConfigFile config){
+void GLCMFeatures2DMRG<T, R>::calculateAllGLCMFeatures2DMRG(GLCMFeatures2DMRG<T,R> &glcmFeatures, const boost::multi_array<T, R> &inputMatrix, float maxIntensity, const vector<float> &spacing, const ConfigFile &config){
 
     //get which norm should be used in the calculation of the GLCM features
     normGLCM = config.normGLCM;
@@ -156,7 +160,9 @@ void GLCMFeatures2DMRG<T, R>::calculateAllGLCMFeatures2DMRG(GLCMFeatures2DMRG<T,
 
 
     for(int depth = 0; depth < totalDepth; depth++){
-          boost::multi_array<float,2> GLCM180= glcmFeatures.calculateMatrix2DMRG(inputMatrix, depth, maxIntensity);
+          ScratchMatrix<float> GLCM180Buffer(maxIntensity, maxIntensity);
+          boost::multi_array<float,2> &GLCM180 = GLCM180Buffer.get();
+          glcmFeatures.calculateMatrix2DMRG(inputMatrix, depth, maxIntensity, GLCM180);
           glcmFeatures.calculateJointMaximum(GLCM180);
           sumJointMaximum += this->jointMaximum;
           glcmFeatures.calculateJointAverage(GLCM180);
@@ -262,7 +268,7 @@ void GLCMFeatures2DMRG<T, R>::writeCSVFileGLCM2DMRG(GLCMFeatures2DMRG<T,R> glcmF
 }
 
 template <class T, size_t R>
-void GLCMFeatures2DMRG<T, R>::writeOneFileGLCM2DMRG(GLCMFeatures2DMRG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLCMFeatures2DMRG<T, R>::writeOneFileGLCM2DMRG(GLCMFeatures2DMRG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -18,8 +18,8 @@ class GLCMFeatures2DVMRG : GLCMFeatures<T,R>  {
         string normGLCM;
         vector<float> actualSpacing;
         void extractGLCMDataVMRG(vector<T> &glcmData, GLCMFeatures2DVMRG<T, R> glcmFeatures);
-        void fill2DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle);
-        boost::multi_array<float, 2> calculateMatrix2DVMRG( boost::multi_array<T, R> inputMatrix, float maxIntensity);
+        void fill2DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle);
+        void calculateMatrix2DVMRG( const boost::multi_array<T, R> &inputMatrix, float maxIntensity, boost::multi_array<float, 2> &sum);
 
         int N_g;
         vector<T> diagonalProbabilities;
@@ -32,13 +32,14 @@ class GLCMFeatures2DVMRG : GLCMFeatures<T,R>  {
         T HXY2;
 
     public:
+		using GLCMFeatures<T, R>::setVoxelList;
 		GLCMFeatures2DVMRG() {
 		}
 		~GLCMFeatures2DVMRG() {
 		}
-        void calculateAllGLCMFeatures2DVMRG(GLCMFeatures2DVMRG<T,R> &glcmFeat, boost::multi_array<T,R> inputMatrix, float maxIntensity, vector<float> spacing, ConfigFile config);
+        void calculateAllGLCMFeatures2DVMRG(GLCMFeatures2DVMRG<T,R> &glcmFeat, const boost::multi_array<T,R> &inputMatrix, float maxIntensity, const vector<float> &spacing, const ConfigFile &config);
         void writeCSVFileGLCM2DVMRG(GLCMFeatures2DVMRG<T,R> glcmFeat, string outputFolder);
-		void writeOneFileGLCM2DVMRG(GLCMFeatures2DVMRG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr);
+		void writeOneFileGLCM2DVMRG(GLCMFeatures2DVMRG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr);
 };
 
 
@@ -47,20 +48,20 @@ In the method calculateMatrix the GLCM-matrices for every direction are calculat
 matrices is divided by the sum of the elements (= nr. of neighbor pairs) to obtain a matrix which contains the probabilities
 for the occurence of every neighbor pair.
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[out]: GLCM-matrix
+@param[out]: GLCM-matrix, it has the size maxIntensity x maxIntensity and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLCMFeatures2DVMRG<T,R>::calculateMatrix2DVMRG( boost::multi_array<T, R> inputMatrix, float maxIntensity){
+void GLCMFeatures2DVMRG<T,R>::calculateMatrix2DVMRG( const boost::multi_array<T, R> &inputMatrix, float maxIntensity, boost::multi_array<float, 2> &sum){
     typedef boost::multi_array<float, 2> glcmat;
     int sizeMatrix = maxIntensity;
     int ang;
-	
 
-    glcmat sum(boost::extents[sizeMatrix][sizeMatrix]);
     for(int depth = 0; depth < inputMatrix.shape()[2]; depth++){
         for(int i = 0; i<4; i++){
-            glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
-            glcmat inverseMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+            ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+            glcmat &GLCMatrix = GLCMatrixBuffer.get();
+            ScratchMatrix<float> inverseMatrixBuffer(sizeMatrix, sizeMatrix);
+            glcmat &inverseMatrix = inverseMatrixBuffer.get();
             ang = 180-i*45;
             fill2DMatrices(inputMatrix, GLCMatrix, depth,ang);
             inverse(GLCMatrix, inverseMatrix);
@@ -75,8 +76,6 @@ boost::multi_array<float, 2> GLCMFeatures2DVMRG<T,R>::calculateMatrix2DVMRG( boo
     //of the occurence of a neighbor pair
     transform( sum.origin(), sum.origin() + sum.num_elements(),
                     sum.origin(),  bind2nd(std::divides<double>(),int(sumMatrElement)));
-    return sum;
-
 }
 
 
@@ -94,7 +93,7 @@ As next step, the GLCMatrix is filled: for every neighborpair the position in th
 the value on this position of the GLCMatrix is increased +1
 */
 template <class T, size_t R>
-void GLCMFeatures2DVMRG<T, R>::fill2DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle){
+void GLCMFeatures2DVMRG<T, R>::fill2DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth, int angle){
     //vector in which all neihbor pairs are stored
     std::vector<std::pair<T, T> > neighbours;
     float weight;
@@ -104,15 +103,19 @@ void GLCMFeatures2DVMRG<T, R>::fill2DMatrices(boost::multi_array<T, R> inputMatr
     //define in which direction you have to look for a neighbor
     glcmComb.getXYDirections(directionX, directionY, angle);
      //fill this vector
-     neighbours = glcmComb.getNeighbours2D(inputMatrix, depth,  directionX, directionY);
-     std::pair<T, T> actNeighbour;
-     //iterate over the neighbor-vector
-     for(int neighbourNr =0; neighbourNr<neighbours.size(); neighbourNr++){
-        actNeighbour = neighbours[neighbourNr];
-        if(!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)){
-            glcMatrix[actNeighbour.first-1][actNeighbour.second-1] += 1;
-        }
-     }
+     //the counts are taken from the texture matrix store if they were stored before
+     string matrixKey = getTextureMatrixKey("GLCM2D", depth, angle);
+     TextureMatrixStore::caseStore().fillPairMatrix(matrixKey, inputMatrix, glcMatrix, depth, -directionY, directionX, 0, [&]() {
+         neighbours = glcmComb.getNeighbours2D(inputMatrix, depth,  directionX, directionY, sparseVoxels(this->voxelList, inputMatrix));
+         std::pair<T, T> actNeighbour;
+         //iterate over the neighbor-vector
+         for(int neighbourNr =0; neighbourNr<neighbours.size(); neighbourNr++){
+            actNeighbour = neighbours[neighbourNr];
+            if(!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)){
+                glcMatrix[actNeighbour.first-1][actNeighbour.second-1] += 1;
+            }
+         }
+     });
 	 weight = calculateWeight2D(directionX, directionY, normGLCM, actualSpacing);
      multSkalarMatrix(glcMatrix, weight);
 }
@@ -121,11 +124,13 @@ void GLCMFeatures2DVMRG<T, R>::fill2DMatrices(boost::multi_array<T, R> inputMatr
 
 
 template <class T, size_t R>
-void GLCMFeatures2DVMRG<T, R>::calculateAllGLCMFeatures2DVMRG(GLCMFeatures2DVMRG<T,R> &glcmFeatures, boost::multi_array<T, R> inputMatrix, float maxIntensity, vector<float> spacing, ConfigFile config){
+void GLCMFeatures2DVMRG<T, R>::calculateAllGLCMFeatures2DVMRG(GLCMFeatures2DVMRG<T,R> &glcmFeatures, const boost::multi_array<T, R> &inputMatrix, float maxIntensity, const vector<float> &spacing, const ConfigFile &config){
     //get which norm should be used in the calculation of the GLCM features
     normGLCM = config.normGLCM;
     actualSpacing = spacing;
-    boost::multi_array<float,2> glcmVMRG= glcmFeatures.calculateMatrix2DVMRG(inputMatrix, maxIntensity);
+    ScratchMatrix<float> glcmVMRGBuffer(maxIntensity, maxIntensity);
+    boost::multi_array<float,2> &glcmVMRG = glcmVMRGBuffer.get();
+    glcmFeatures.calculateMatrix2DVMRG(inputMatrix, maxIntensity, glcmVMRG);
 	glcmFeatures.calculateJointMaximum(glcmVMRG);
     glcmFeatures.calculateJointAverage(glcmVMRG);
     glcmFeatures.calculateJointVariance(glcmVMRG, this->jointAverage);
@@ -179,7 +184,7 @@ void GLCMFeatures2DVMRG<T, R>::writeCSVFileGLCM2DVMRG(GLCMFeatures2DVMRG<T,R> gl
 }
 
 template <class T, size_t R>
-void GLCMFeatures2DVMRG<T, R>::writeOneFileGLCM2DVMRG(GLCMFeatures2DVMRG<T, R> glcmFeat, ConfigFile config,int &parameterSpaceNr) {
+void GLCMFeatures2DVMRG<T, R>::writeOneFileGLCM2DVMRG(GLCMFeatures2DVMRG<T, R> glcmFeat, const ConfigFile &config,int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
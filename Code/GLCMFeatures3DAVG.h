@@ -22,8 +22,8 @@ private:
 	typedef boost::multi_array<float, 2>  glcmat;
 	void defineGLCMFeatures3DAVG(vector<string> &features);
 	void extractGLCMData3D(vector<T> &glcmData, GLCMFeatures3DAVG<T, R> glcmFeatures);
-	void fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &sum, int angle, int directionZ);
-	boost::multi_array<float, 2> getMatrixSum(boost::multi_array<T, R> inputMatrix, int ang, int directionZ);
+	void fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &sum, int angle, int directionZ);
+	void getMatrixSum(const boost::multi_array<T, R> &inputMatrix, int ang, int directionZ, boost::multi_array<float, 2> &GLCMatrix);
 	//store different grey levels in vector
 	vector<T> diffGreyLevels;
 	vector<T> diagonalProbabilities;
@@ -36,13 +36,14 @@ private:
 	T HXY2;
 
 public:
+	using GLCMFeatures<T, R>::setVoxelList;
 	GLCMFeatures3DAVG() {
 	}
 	~GLCMFeatures3DAVG() {
 	}
 	void writeCSVFileGLCM3DAVG(GLCMFeatures3DAVG<T, R> glcmFeat, string outputFolder);
-	void writeOneFileGLCM3DAVG(GLCMFeatures3DAVG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr);
-	void calculateAllGLCMFeatures3DAVG(GLCMFeatures3DAVG<T, R> &glcmFeat, boost::multi_array<T, R> inputMatrix, float maxIntensity);
+	void writeOneFileGLCM3DAVG(GLCMFeatures3DAVG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr);
+	void calculateAllGLCMFeatures3DAVG(GLCMFeatures3DAVG<T, R> &glcmFeat, const boost::multi_array<T, R> &inputMatrix, float maxIntensity);
    
 };
 
@@ -59,19 +60,26 @@ In the method fill3DMatrices the matrix is filled for all directions
 The function works analog to the 2D method
 */
 template <class T, size_t R>
-void GLCMFeatures3DAVG<T, R>::fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int angle, int directionZ) {
+void GLCMFeatures3DAVG<T, R>::fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int angle, int directionZ) {
 	std::vector<std::pair<T, T> > neighbours;
+	int directionX;
+	int directionY;
+	glcm.getXYDirections(directionX, directionY, angle);
 	//get the vector of the nieghbour pairs
-	neighbours = glcm.getNeighbours3D(inputMatrix, angle, directionZ);
-	std::pair<T, T> actNeighbour;
-	//iterate over the neighbor-vector
-	for (int neighbourNr = 0; neighbourNr<neighbours.size(); neighbourNr++) {
-		actNeighbour = neighbours[neighbourNr];
-		if (!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)) {
-			glcMatrix[actNeighbour.first - 1][actNeighbour.second - 1] += 1;
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLCM3D", angle, directionZ);
+	TextureMatrixStore::caseStore().fillPairMatrix(matrixKey, inputMatrix, glcMatrix, -1, -directionY, directionX, directionZ, [&]() {
+		neighbours = glcm.getNeighbours3D(inputMatrix, angle, directionZ, sparseVoxels(this->voxelList, inputMatrix));
+		std::pair<T, T> actNeighbour;
+		//iterate over the neighbor-vector
+		for (int neighbourNr = 0; neighbourNr<neighbours.size(); neighbourNr++) {
+			actNeighbour = neighbours[neighbourNr];
+			if (!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)) {
+				glcMatrix[actNeighbour.first - 1][actNeighbour.second - 1] += 1;
 
+			}
 		}
-	}
+	});
 }
 
 
@@ -81,19 +89,15 @@ In the method getMatrixSum calculates the sum from one GLCM matrix and its inver
 @param[in]: the GLCMatrix that will be filled with the corresponding values
 @param[in]: direction that determines how the matrix will be filled
 @param[in] directionZ: determines the direction in the depth
+@param[out]: GLCM-matrix, it has the size sizeMatrix x sizeMatrix and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLCMFeatures3DAVG<T, R>::getMatrixSum(boost::multi_array<T, R> inputMatrix, int ang, int directionZ) {
-
-	glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
-
+void GLCMFeatures3DAVG<T, R>::getMatrixSum(const boost::multi_array<T, R> &inputMatrix, int ang, int directionZ, boost::multi_array<float, 2> &GLCMatrix) {
 	fill3DMatrices(inputMatrix, GLCMatrix, ang, directionZ);
-
-	return GLCMatrix;
 }
 
 template <class T, size_t R>
-void GLCMFeatures3DAVG<T, R>::calculateAllGLCMFeatures3DAVG(GLCMFeatures3DAVG<T, R> &glcmFeatures, boost::multi_array<T, R> inputMatrix, float maxIntensity) {
+void GLCMFeatures3DAVG<T, R>::calculateAllGLCMFeatures3DAVG(GLCMFeatures3DAVG<T, R> &glcmFeatures, const boost::multi_array<T, R> &inputMatrix, float maxIntensity) {
 
 	int ang;
 	int directionZ = 0;
@@ -127,8 +131,10 @@ void GLCMFeatures3DAVG<T, R>::calculateAllGLCMFeatures3DAVG(GLCMFeatures3DAVG<T,
 	T sumSecondMCorrelation = 0;
 
 
-	glcmat sum(boost::extents[sizeMatrix][sizeMatrix]);
-	glcmat inverseMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+	ScratchMatrix<float> sumBuffer(sizeMatrix, sizeMatrix);
+	glcmat &sum = sumBuffer.get();
+	ScratchMatrix<float> inverseMatrixBuffer(sizeMatrix, sizeMatrix);
+	glcmat &inverseMatrix = inverseMatrixBuffer.get();
 	for (int i = 0; i<5; i++) {
 
 		ang = 180 - i * 45;
@@ -136,7 +142,8 @@ void GLCMFeatures3DAVG<T, R>::calculateAllGLCMFeatures3DAVG(GLCMFeatures3DAVG<T,
 			for (int j = 0; j<3; j++) {
 
 				directionZ = -1 + j;
-				glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+				ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+				glcmat &GLCMatrix = GLCMatrixBuffer.get();
 
 				fill3DMatrices(inputMatrix, GLCMatrix, ang, directionZ);
 
@@ -211,7 +218,9 @@ void GLCMFeatures3DAVG<T, R>::calculateAllGLCMFeatures3DAVG(GLCMFeatures3DAVG<T,
 
 		else {
 			directionZ = 1;
-			boost::multi_array<float, 2> GLCMatrix = glcmFeatures.getMatrixSum(inputMatrix, ang, directionZ);
+			ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+			glcmat &GLCMatrix = GLCMatrixBuffer.get();
+			glcmFeatures.getMatrixSum(inputMatrix, ang, directionZ, GLCMatrix);
 			inverse(GLCMatrix, inverseMatrix);
 			sum = GLCMatrix;
 			matrixSum(sum, inverseMatrix);
@@ -328,7 +337,7 @@ void GLCMFeatures3DAVG<T, R>::writeCSVFileGLCM3DAVG(GLCMFeatures3DAVG<T,R> glcmF
 }
 
 template <class T, size_t R>
-void GLCMFeatures3DAVG<T, R>::writeOneFileGLCM3DAVG(GLCMFeatures3DAVG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLCMFeatures3DAVG<T, R>::writeOneFileGLCM3DAVG(GLCMFeatures3DAVG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -22,8 +22,8 @@ private:
 	vector<float> actualSpacing;
 	void defineGLCMFeatures3DMRG(vector<string> &features);
 	void extractGLCMData3D(vector<T> &glcmData, GLCMFeatures3DMRG<T, R> glcmFeatures);
-	void fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int angle, int directionZ);
-	boost::multi_array<float, 2> getMatrixSum(boost::multi_array<T, R> inputMatrix, float maxIntensity);
+	void fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int angle, int directionZ);
+	void getMatrixSum(const boost::multi_array<T, R> &inputMatrix, float maxIntensity, boost::multi_array<float, 2> &sum);
 	//store different grey levels in vector
 	vector<T> diffGreyLevels;
 
@@ -36,13 +36,14 @@ private:
 	T HXY1;
 	T HXY2;
 public:
+	using GLCMFeatures<T, R>::setVoxelList;
 	GLCMFeatures3DMRG() {
 	}
 	~GLCMFeatures3DMRG() {
 	}
 	void writeCSVFileGLCM3DMRG(GLCMFeatures3DMRG<T, R> glcmFeat, string outputFolder);
-	void writeOneFileGLCM3DMRG(GLCMFeatures3DMRG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr);
-	void calculateAllGLCMFeatures3DMRG(GLCMFeatures3DMRG<T, R> &glcmFeat, boost::multi_array<T, R> inputMatrix, float maxIntensity, vector<float> spacing, ConfigFile config);
+	void writeOneFileGLCM3DMRG(GLCMFeatures3DMRG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr);
+	void calculateAllGLCMFeatures3DMRG(GLCMFeatures3DMRG<T, R> &glcmFeat, const boost::multi_array<T, R> &inputMatrix, float maxIntensity, const vector<float> &spacing, const ConfigFile &config);
 };
 
 
@@ -57,7 +58,7 @@ In the method fill3DMatrices the GLCM matrix is filled with the according values
 @param[in]: in directionZ: in which z direction we are going
 */
 template <class T, size_t R>
-void GLCMFeatures3DMRG<T, R>::fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int angle, int directionZ) {
+void GLCMFeatures3DMRG<T, R>::fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int angle, int directionZ) {
 
 	float weight;
 	int directionX;
@@ -66,16 +67,20 @@ void GLCMFeatures3DMRG<T, R>::fill3DMatrices(boost::multi_array<T, R> inputMatri
 	GLCMFeatures<T, R> glcm;
 	glcm.getXYDirections(directionX, directionY, angle);
 	//get the vector of the nieghbour pairs
-	std::vector<std::pair<T, T> > neighbours = glcm.getNeighbours3D(inputMatrix, angle, directionZ);
-	std::pair<T, T> actNeighbour;
-	//iterate over the neighbor-vector
-	for (int neighbourNr = 0; neighbourNr<neighbours.size(); neighbourNr++) {
-		actNeighbour = neighbours[neighbourNr];
-
-		if (!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)) {
-			glcMatrix[actNeighbour.first - 1][actNeighbour.second - 1] += 1;
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLCM3D", angle, directionZ);
+	TextureMatrixStore::caseStore().fillPairMatrix(matrixKey, inputMatrix, glcMatrix, -1, -directionY, directionX, directionZ, [&]() {
+		std::vector<std::pair<T, T> > neighbours = glcm.getNeighbours3D(inputMatrix, angle, directionZ, sparseVoxels(this->voxelList, inputMatrix));
+		std::pair<T, T> actNeighbour;
+		//iterate over the neighbor-vector
+		for (int neighbourNr = 0; neighbourNr<neighbours.size(); neighbourNr++) {
+			actNeighbour = neighbours[neighbourNr];
+
+			if (!std::isnan(actNeighbour.first) && !std::isnan(actNeighbour.second)) {
+				glcMatrix[actNeighbour.first - 1][actNeighbour.second - 1] += 1;
+			}
 		}
-	}
+	});
 	weight = calculateWeight3D(directionX, directionY, directionZ, normGLCM, actualSpacing);
 	multSkalarMatrix(glcMatrix, weight);
 
@@ -85,24 +90,24 @@ void GLCMFeatures3DMRG<T, R>::fill3DMatrices(boost::multi_array<T, R> inputMatri
 In the method getMatrixSum calculates the sum of all calculated GLCM matrices
 @param[in] inputMatrix: the original matrix of the VOI
 @param[in]: float maxValue: maximum intensity value of VOI,
-@param[out]: boost multi_array: summed GLCM matrices
+@param[out]: boost multi_array: summed GLCM matrices, it has the size maxIntensity x maxIntensity and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLCMFeatures3DMRG<T, R>::getMatrixSum(boost::multi_array<T, R> inputMatrix, float maxIntensity) {
+void GLCMFeatures3DMRG<T, R>::getMatrixSum(const boost::multi_array<T, R> &inputMatrix, float maxIntensity, boost::multi_array<float, 2> &sum) {
 
 	int sizeMatrix = maxIntensity;
 
 	int ang;
 	int directionZ = 0;
-	glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
-	glcmat sum(boost::extents[sizeMatrix][sizeMatrix]);
-	glcmat inverseMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+	ScratchMatrix<float> inverseMatrixBuffer(sizeMatrix, sizeMatrix);
+	glcmat &inverseMatrix = inverseMatrixBuffer.get();
 
 	for (int i = 0; i<5; i++) {
 		ang = 180 - i * 45;
 		if (ang >0) {
 			for (int j = 0; j<3; j++) {
-				glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+				ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+				glcmat &GLCMatrix = GLCMatrixBuffer.get();
 				directionZ = -1 + j;
 				fill3DMatrices(inputMatrix, GLCMatrix, ang, directionZ);
 				inverse(GLCMatrix, inverseMatrix);
@@ -113,7 +118,8 @@ boost::multi_array<float, 2> GLCMFeatures3DMRG<T, R>::getMatrixSum(boost::multi_
 		}
 		else {
 			directionZ = 1;
-			glcmat GLCMatrix(boost::extents[sizeMatrix][sizeMatrix]);
+			ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+			glcmat &GLCMatrix = GLCMatrixBuffer.get();
 
 			fill3DMatrices(inputMatrix, GLCMatrix, ang, directionZ);
 			inverse(GLCMatrix, inverseMatrix);
@@ -130,16 +136,17 @@ boost::multi_array<float, 2> GLCMFeatures3DMRG<T, R>::getMatrixSum(boost::multi_
 		transform(sum.origin(), sum.origin() + sum.num_elements(),
 			sum.origin(), bind2nd(std::divides<double>(), int(sumMatrElement)));
 	}
-	return sum;
 }
 
 template <class T, size_t R>
-void GLCMFeatures3DMRG<T, R>::calculateAllGLCMFeatures3DMRG(GLCMFeatures3DMRG<T, R> &GLCMFeatures3DMRG, boost::multi_array<T, R> inputMatrix, float maxIntensity, vector<float> spacing, ConfigFile config) {
+void GLCMFeatures3DMRG<T, R>::calculateAllGLCMFeatures3DMRG(GLCMFeatures3DMRG<T, R> &GLCMFeatures3DMRG, const boost::multi_array<T, R> &inputMatrix, float maxIntensity, const vector<float> &spacing, const ConfigFile &config) {
 	//get which norm should be used in the calculation of the GLCM features
 	normGLCM = config.normGLCM;
 	actualSpacing = spacing;
 
-	boost::multi_array<float, 2> GLCM180 = GLCMFeatures3DMRG.getMatrixSum(inputMatrix, maxIntensity);
+	ScratchMatrix<float> GLCM180Buffer(maxIntensity, maxIntensity);
+	boost::multi_array<float, 2> &GLCM180 = GLCM180Buffer.get();
+	GLCMFeatures3DMRG.getMatrixSum(inputMatrix, maxIntensity, GLCM180);
 
 	GLCMFeatures3DMRG.calculateJointMaximum(GLCM180);
 	GLCMFeatures3DMRG.calculateJointAverage(GLCM180);
@@ -221,7 +228,7 @@ void GLCMFeatures3DMRG<T, R>::writeCSVFileGLCM3DMRG(GLCMFeatures3DMRG<T,R> glcmF
 }
 
 template <class T, size_t R>
-void GLCMFeatures3DMRG<T, R>::writeOneFileGLCM3DMRG(GLCMFeatures3DMRG<T, R> glcmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLCMFeatures3DMRG<T, R>::writeOneFileGLCM3DMRG(GLCMFeatures3DMRG<T, R> glcmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -30,15 +30,15 @@ class GLDZMFeatures2DAVG : public GLSZMFeatures2DMRG<T,R>{
 		void fillConvolutionalVectorGLD(vector<T> &convolutionalVector);
 		int checkNeighbors(boost::multi_array<T, R> &distanceMap, boost::multi_array<T, R> &inputMatrix, vector< int> actIndex, int actualDistance);
 		void extractGLDZMData2DAVG(vector<T> &gldzmData, GLDZMFeatures2DAVG<T, R> gldzmFeatures);
-        boost::multi_array<float, 2> fillMatrix(boost::multi_array<T,R> inputMatrix, boost::multi_array<T, R> distanceMap, boost::multi_array<float, 2>  &gldzmat, int depth);
-        boost::multi_array<float, 2> getMatrix( boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap, int depth);
+        void fillMatrix(const boost::multi_array<T,R> &inputMatrix, const boost::multi_array<T, R> &distanceMap, boost::multi_array<float, 2>  &gldzmat, int depth);
+        int getNrDistances(const boost::multi_array<T, R> &inputMatrix);
 		int checkNeighborsNAN(boost::multi_array<T, R> &inputMatrix, boost::multi_array<T, R> &tempMatrix, vector< int> actIndex, int actDist);
      public:
-		 boost::multi_array<T, R> generateDistanceMap(boost::multi_array<T, R> inputMatrix, Image<T, R> imageAttr, boost::multi_array<T, R> &distanceMap, ConfigFile config);
+		 boost::multi_array<T, R> generateDistanceMap(const boost::multi_array<T, R> &inputMatrix, const Image<T, R> &imageAttr, boost::multi_array<T, R> &distanceMap, const ConfigFile &config);
 
         void writeCSVFileGLDZM2DAVG(GLDZMFeatures2DAVG<T,R> gldzmFeat, string outputFolder);
-		void writeOneFileGLDZM2DAVG(GLDZMFeatures2DAVG<T, R> gldzmFeat, ConfigFile config, int &parameterSpaceNr);
-        void calculateAllGLDZMFeatures2DAVG(GLDZMFeatures2DAVG<T,R> &gldzmFeat, Image<T,R> imageAttr, boost::multi_array<T, R> distanceMap, ConfigFile config);
+		void writeOneFileGLDZM2DAVG(GLDZMFeatures2DAVG<T, R> gldzmFeat, const ConfigFile &config, int &parameterSpaceNr);
+        void calculateAllGLDZMFeatures2DAVG(GLDZMFeatures2DAVG<T,R> &gldzmFeat, const Image<T,R> &imageAttr, const boost::multi_array<T, R> &distanceMap, const ConfigFile &config);
 };
 
 template <class T, size_t R>
@@ -74,7 +74,7 @@ According to the position of a value in the matrix, the corresponding distance i
 @param[out]: distance map
 */
 template <class T, size_t R>
-boost::multi_array<T, R> GLDZMFeatures2DAVG<T, R>::generateDistanceMap(boost::multi_array<T,R> inputMatrix, Image<T, R> imageAttr, boost::multi_array<T,R> &distanceMap, ConfigFile config){
+boost::multi_array<T, R> GLDZMFeatures2DAVG<T, R>::generateDistanceMap(const boost::multi_array<T,R> &inputMatrix, const Image<T, R> &imageAttr, boost::multi_array<T,R> &distanceMap, const ConfigFile &config){
 	boost::multi_array<float, 3> distanceMapTmp(boost::extents[distanceMap.shape()[0]][distanceMap.shape()[1]][distanceMap.shape()[2]]);
 	
 	//construct convolutional kernel
@@ -85,7 +85,7 @@ boost::multi_array<T, R> GLDZMFeatures2DAVG<T, R>::generateDistanceMap(boost::mu
 	float voxelSize[] = { 1,1,1 };
 	ImageType::Pointer kernel = converArray2Image(kernelArray, dimKernel, voxelSize);
 	//assign the image matrix
-	boost::multi_array<T, 3> actualMatrix = inputMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = inputMatrix;
 	//how many grey levels do I have
 	int sizeGreyLevels = (imageAttr.diffGreyLevels).size();
 	//the original (not discretize image!)
@@ -208,10 +208,12 @@ int GLDZMFeatures2DAVG<T, R>::checkNeighborsNAN(boost::multi_array<T, R> &inputM
 In the method fillMatrix the GLDZM matrix is filled, taking the original matrix of the VOI as input. \n
 The GLDZM matrix is given as reference and filled in the function
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[in]: boost::multi_array<T, 3> GLDZM: GLDZM matrix
+@param[in]: boost::multi_array<T, 3> GLDZM: GLDZM matrix, it has getNrDistances columns and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLDZMFeatures2DAVG<T, R>::fillMatrix(boost::multi_array<T,R> inputMatrix, boost::multi_array<T, R> distanceMap, boost::multi_array<float, 2>  &gldzmat, int depth){
+void GLDZMFeatures2DAVG<T, R>::fillMatrix(const boost::multi_array<T,R> &inputMatrix, const boost::multi_array<T, R> &distanceMap, boost::multi_array<float, 2>  &gldzmat, int depth){
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
 	
 	vector<vector<int> > matrixIndices;
     vector<int> actualIndex;
@@ -220,18 +222,18 @@ boost::multi_array<float, 2> GLDZMFeatures2DAVG<T, R>::fillMatrix(boost::multi_a
     totalNrZones=0;
 	int actualGreyIndex;
 
-    for(int row = 0; row<inputMatrix.shape()[0]; row++){
-        for(int col=0; col<inputMatrix.shape()[1];col++){
-			actualElement = inputMatrix[row][col][depth];
+    for(int row = 0; row<zoneMatrix.shape()[0]; row++){
+        for(int col=0; col<zoneMatrix.shape()[1];col++){
+			actualElement = zoneMatrix[row][col][depth];
 			if (!isnan(actualElement)) {
 				actualGreyIndex = GLSZM2D.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actualElement);
-                inputMatrix[row][col][depth]=NAN;
+                zoneMatrix[row][col][depth]=NAN;
                 actualIndex.push_back(row);
                 actualIndex.push_back(col);
                 actualIndex.push_back(depth);
                 matrixIndices.push_back(actualIndex);
                 actualIndex.clear();
-                GLSZM2D.getNeighbors(inputMatrix, actualElement, matrixIndices);
+                GLSZM2D.getNeighbors(zoneMatrix, actualElement, matrixIndices);
             }
             if(matrixIndices.size()>0){
 				minDistance = GLDZM2D.getMinimalDistance(distanceMap, matrixIndices);
@@ -242,7 +244,6 @@ boost::multi_array<float, 2> GLDZMFeatures2DAVG<T, R>::fillMatrix(boost::multi_a
             }
         }
     }
-    return gldzmat;
 }
 
 
@@ -270,31 +271,20 @@ int GLDZMFeatures2DAVG<T, R>::checkNeighbors(boost::multi_array<T, R> &distanceM
 	return distance;
 }
 /*!
-In the method getMatrix the GLDZM matrix is generated and filled using the function fillMatrix.
-The function is mainly used get the size of the GLDZM matrix. \n
+In the method getNrDistances the number of columns of the GLDZM matrix is calculated. \n
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[out]: boost::multi_array<T, 3> GLDZM: GLDZM matrix
+@param[out]: number of columns of the GLDZM matrix
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLDZMFeatures2DAVG<T,R>::getMatrix( boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap, int depth){
-    typedef boost::multi_array<float, 2>  gldzmat;
-
-    int sizeGreyLevels = (this->diffGreyLevels).size();
-
-	int nrCols = std::min(std::ceil(float(inputMatrix.shape()[0]) / 2), std::ceil(float(inputMatrix.shape()[1]) / 2))+1;
-    gldzmat GLDZMatrix(boost::extents[sizeGreyLevels][nrCols]);
-	
-	fillMatrix(inputMatrix, distanceMap, GLDZMatrix, depth);
-
-    return GLDZMatrix;
-
+int GLDZMFeatures2DAVG<T,R>::getNrDistances( const boost::multi_array<T, R> &inputMatrix){
+	return std::min(std::ceil(float(inputMatrix.shape()[0]) / 2), std::ceil(float(inputMatrix.shape()[1]) / 2))+1;
 }
 
 
 
 
 template <class T, size_t R>
-void GLDZMFeatures2DAVG<T, R>::calculateAllGLDZMFeatures2DAVG(GLDZMFeatures2DAVG<T, R> &gldzmFeatures, Image<T, R> imageAttr, boost::multi_array<T, R> distanceMap, ConfigFile config) {
+void GLDZMFeatures2DAVG<T, R>::calculateAllGLDZMFeatures2DAVG(GLDZMFeatures2DAVG<T, R> &gldzmFeatures, const Image<T, R> &imageAttr, const boost::multi_array<T, R> &distanceMap, const ConfigFile &config) {
 	this->diffGreyLevels = imageAttr.diffGreyLevels;
 	int totalDepth = imageAttr.imageMatrix.shape()[2];
 	gldzmFeatures.getConfigValues(config);
@@ -315,8 +305,11 @@ void GLDZMFeatures2DAVG<T, R>::calculateAllGLDZMFeatures2DAVG(GLDZMFeatures2DAVG
 	T sumRunLengthVar = 0;
 	T sumRunEntropy = 0;
 	
+    int nrDistances = getNrDistances(imageAttr.imageMatrix);
     for(int depth = 0; depth < totalDepth; depth++){
-		boost::multi_array<float, 2> GLDZM = gldzmFeatures.getMatrix(imageAttr.imageMatrix, distanceMap, depth);
+		ScratchMatrix<float> GLDZMBuffer(this->diffGreyLevels.size(), nrDistances);
+		boost::multi_array<float, 2> &GLDZM = GLDZMBuffer.get();
+		gldzmFeatures.fillMatrix(imageAttr.imageMatrix, distanceMap, GLDZM, depth);
         float totalSum = gldzmFeatures.calculateTotalSum(GLDZM);
         rowSums=gldzmFeatures.calculateRowSums(GLDZM);
         colSums = gldzmFeatures.calculateColSums(GLDZM);
@@ -347,7 +340,9 @@ void GLDZMFeatures2DAVG<T, R>::calculateAllGLDZMFeatures2DAVG(GLDZMFeatures2DAVG
         sumRunLengthNonUniformity += this->runLengthNonUniformity;
         gldzmFeatures.calculateRunPercentage(imageAttr.imageMatrix, depth, totalSum, 1);
         sumRunPercentage += this->runPercentage;
-        boost::multi_array<float,2> probMatrix = gldzmFeatures.calculateProbMatrix(GLDZM, totalSum);
+        ScratchMatrix<float> probMatrixBuffer(GLDZM.shape()[0], GLDZM.shape()[1]);
+        boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+        gldzmFeatures.calculateProbMatrix(GLDZM, totalSum, probMatrix);
         float meanGrey = gldzmFeatures.calculateMeanProbGrey(probMatrix);
 
         gldzmFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
@@ -422,7 +417,7 @@ void GLDZMFeatures2DAVG<T, R>::writeCSVFileGLDZM2DAVG(GLDZMFeatures2DAVG<T,R> gl
 }
 
 template <class T, size_t R>
-void GLDZMFeatures2DAVG<T, R>::writeOneFileGLDZM2DAVG(GLDZMFeatures2DAVG<T, R> gldzmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLDZMFeatures2DAVG<T, R>::writeOneFileGLDZM2DAVG(GLDZMFeatures2DAVG<T, R> gldzmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
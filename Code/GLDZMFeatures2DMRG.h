@@ -27,16 +27,16 @@ class GLDZMFeatures2D : public GLSZMFeatures2DMRG<T,R>{
 		
 		GLSZMFeatures2DMRG<T, R> GLSZM2D;
         void extractGLDZMData(vector<T> &gldzmData, GLDZMFeatures2D<T, R> gldzmFeatures);
-        boost::multi_array<float, 2> fillMatrix(boost::multi_array<T,R> inputMatrix, boost::multi_array<T, R> distanceMap, boost::multi_array<float, 2>  &gldzmat);
-        boost::multi_array<float, 2> getMatrix( boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap);
+        void fillMatrix(const boost::multi_array<T,R> &inputMatrix, const boost::multi_array<T, R> &distanceMap, boost::multi_array<float, 2>  &gldzmat);
+        int getNrDistances(const boost::multi_array<T, R> &inputMatrix);
 
      public:
 		void defineGLDZMFeatures(vector<string> &features);
 		void defineGLDZMFeaturesOntology(vector<string> &features);
-        int getMinimalDistance(boost::multi_array<T,R> distanceMap, vector<vector<int> > matrixIndices);
+        int getMinimalDistance(const boost::multi_array<T,R> &distanceMap, vector<vector<int> > matrixIndices);
         void writeCSVFileGLDZM(GLDZMFeatures2D<T,R> gldzmFeat, string outputFolder);
-		void writeOneFileGLDZM(GLDZMFeatures2D<T, R> gldzmFeat, ConfigFile config, int &parameterSpaceNr);
-		void calculateAllGLDZMFeatures2D(GLDZMFeatures2D<T,R> &gldzmFeat, boost::multi_array<T, R> distanceMap, Image<T, R> imageAttr, ConfigFile config);
+		void writeOneFileGLDZM(GLDZMFeatures2D<T, R> gldzmFeat, const ConfigFile &config, int &parameterSpaceNr);
+		void calculateAllGLDZMFeatures2D(GLDZMFeatures2D<T,R> &gldzmFeat, const boost::multi_array<T, R> &distanceMap, const Image<T, R> &imageAttr, const ConfigFile &config);
 };
 
 
@@ -47,10 +47,12 @@ class GLDZMFeatures2D : public GLSZMFeatures2DMRG<T,R>{
 In the method fillMatrix the GLDZM matrix is filled, taking the original matrix of the VOI as input. \n
 The GLDZM matrix is given as reference and filled in the function
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[in]: boost::multi_array<T, 3> GLDZM: GLDZM matrix 
+@param[in]: boost::multi_array<T, 3> GLDZM: GLDZM matrix, it has getNrDistances columns and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLDZMFeatures2D<T, R>::fillMatrix(boost::multi_array<T,R> inputMatrix, boost::multi_array<T, R> distanceMap, boost::multi_array<float, 2>  &gldzmat){
+void GLDZMFeatures2D<T, R>::fillMatrix(const boost::multi_array<T,R> &inputMatrix, const boost::multi_array<T, R> &distanceMap, boost::multi_array<float, 2>  &gldzmat){
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
 	//store the matrix indices of a neighborhood in a vector
     vector<vector<int> > matrixIndices;
 	//vector with indices of actual position
@@ -60,19 +62,19 @@ boost::multi_array<float, 2> GLDZMFeatures2D<T, R>::fillMatrix(boost::multi_arra
     totalNrZones=0;
 	//get zones for every grey level present in VOI
 	int actualGreyIndex;
-	for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
-		for (int row = 0; row < inputMatrix.shape()[0]; row++) {
-			for (int col = 0; col < inputMatrix.shape()[1]; col++) {
-				actualElement = inputMatrix[row][col][depth];
+	for (int depth = 0; depth < zoneMatrix.shape()[2]; depth++) {
+		for (int row = 0; row < zoneMatrix.shape()[0]; row++) {
+			for (int col = 0; col < zoneMatrix.shape()[1]; col++) {
+				actualElement = zoneMatrix[row][col][depth];
 				if (!isnan(actualElement)) {
 					actualGreyIndex = GLSZM2D.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actualElement);
-					inputMatrix[row][col][depth] = NAN;
+					zoneMatrix[row][col][depth] = NAN;
 					actualIndex.push_back(row);
 					actualIndex.push_back(col);
 					actualIndex.push_back(depth);
 					matrixIndices.push_back(actualIndex);
 					actualIndex.clear();
-					GLSZM2D.getNeighbors(inputMatrix, actualElement, matrixIndices);
+					GLSZM2D.getNeighbors(zoneMatrix, actualElement, matrixIndices);
 				}
 				if (matrixIndices.size() > 0) {
 					minDistance = getMinimalDistance(distanceMap, matrixIndices);
@@ -85,27 +87,17 @@ boost::multi_array<float, 2> GLDZMFeatures2D<T, R>::fillMatrix(boost::multi_arra
 		}
 
 	}
-    return gldzmat;
 }
 
 /*!
-In the method getMatrix the GLDZM matrix is generated and filled using the function fillMatrix. 
-The function is mainly used get the size of the GLDZM matrix. \n
+In the method getNrDistances the number of columns of the GLDZM matrix is calculated. \n
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[out]: boost::multi_array<T, 3> GLDZM: GLDZM matrix
+@param[out]: number of columns of the GLDZM matrix
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLDZMFeatures2D<T,R>::getMatrix( boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap){
-    typedef boost::multi_array<float, 2>  gldzmat;
-	//all grey levels present in VOI
-    int sizeGreyLevels = (this->diffGreyLevels).size();
-    //define the glcMatrices
+int GLDZMFeatures2D<T,R>::getNrDistances( const boost::multi_array<T, R> &inputMatrix){
 	//the size is the minimum of the half of the side lengths + 1, because the minimum of the half length has to be included
-
-	int nrCols = std::min(std::ceil(double(inputMatrix.shape()[0]) / 2), std::ceil(double(inputMatrix.shape()[1]) / 2)) +1;
-    gldzmat GLDZMatrix(boost::extents[sizeGreyLevels][nrCols]);
-	fillMatrix(inputMatrix, distanceMap, GLDZMatrix);
-    return GLDZMatrix;
+	return std::min(std::ceil(double(inputMatrix.shape()[0]) / 2), std::ceil(double(inputMatrix.shape()[1]) / 2)) +1;
 }
 
 /*!
@@ -114,7 +106,7 @@ In the method getMinimalDistance gets the minimal distance of a zone to the VOI
 @param[in]: vector<vector<int>> matrixIndices: vector with all matrix indices of the actual zone
 */
 template <class T, size_t R>
-int GLDZMFeatures2D<T, R>::getMinimalDistance(boost::multi_array<T,R> distanceMap, vector<vector<int> > matrixIndices){
+int GLDZMFeatures2D<T, R>::getMinimalDistance(const boost::multi_array<T,R> &distanceMap, vector<vector<int> > matrixIndices){
     vector<int> distances;
     int actualX;
     int actualY;
@@ -147,13 +139,15 @@ int GLDZMFeatures2D<T, R>::getMinimalDistance(boost::multi_array<T,R> distanceMa
 }
 
 template <class T, size_t R>
-void GLDZMFeatures2D<T, R>::calculateAllGLDZMFeatures2D(GLDZMFeatures2D<T,R> &gldzmFeatures, boost::multi_array<T, R> distanceMap, Image<T,R> imageAttr, ConfigFile config){
+void GLDZMFeatures2D<T, R>::calculateAllGLDZMFeatures2D(GLDZMFeatures2D<T,R> &gldzmFeatures, const boost::multi_array<T, R> &distanceMap, const Image<T,R> &imageAttr, const ConfigFile &config){
     //store all grey levels of actual VOI in vector
 	this->diffGreyLevels = imageAttr.diffGreyLevels;
 	//read in the config values for the extended emphasis values
 	gldzmFeatures.getConfigValues(config);
 
-    boost::multi_array<float,2> GLDZM=gldzmFeatures.getMatrix(imageAttr.imageMatrix, distanceMap);
+    ScratchMatrix<float> GLDZMBuffer(this->diffGreyLevels.size(), getNrDistances(imageAttr.imageMatrix));
+    boost::multi_array<float,2> &GLDZM = GLDZMBuffer.get();
+    gldzmFeatures.fillMatrix(imageAttr.imageMatrix, distanceMap, GLDZM);
 
 	float totalSum = gldzmFeatures.calculateTotalSum(GLDZM);
     
@@ -173,7 +167,9 @@ void GLDZMFeatures2D<T, R>::calculateAllGLDZMFeatures2D(GLDZMFeatures2D<T,R> &gl
     gldzmFeatures.calculateRunLengthNonUniformityNorm(rowSums, totalSum);
     gldzmFeatures.calculateRunLengthNonUniformity(rowSums, totalSum);
     gldzmFeatures.calculateRunPercentage3D(imageAttr.vectorOfMatrixElements, totalSum, 4);
-    boost::multi_array<float,2> probMatrix = gldzmFeatures.calculateProbMatrix(GLDZM, totalSum);
+    ScratchMatrix<float> probMatrixBuffer(GLDZM.shape()[0], GLDZM.shape()[1]);
+    boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+    gldzmFeatures.calculateProbMatrix(GLDZM, totalSum, probMatrix);
 	float meanGrey = gldzmFeatures.calculateMeanProbGrey(probMatrix);
 
     gldzmFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
@@ -230,7 +226,7 @@ void GLDZMFeatures2D<T, R>::writeCSVFileGLDZM(GLDZMFeatures2D<T,R> gldzmFeat, st
 
 
 template <class T, size_t R>
-void GLDZMFeatures2D<T, R>::writeOneFileGLDZM(GLDZMFeatures2D<T, R> gldzmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLDZMFeatures2D<T, R>::writeOneFileGLDZM(GLDZMFeatures2D<T, R> gldzmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -34,20 +34,20 @@ class GLDZMFeatures3D : public GLDZMFeatures2D<T,R>{
 
         void extractGLDZMData3D(vector<T> &gldzmData, GLDZMFeatures3D<T, R> gldzmFeatures);
 		
-		boost::multi_array<T, R> generateDistanceMap3D(Image<T,R> imageAttr, boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap2D, boost::multi_array<T, R> &distanceMap, ConfigFile config);
-        void fillMatrix3D(boost::multi_array<T,R> inputMatrix, boost::multi_array<T, R> distanceMatrix, boost::multi_array<float, 2>  &gldzmat);
-        boost::multi_array<float, 2> getMatrix3D( boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMatrix);
-		int getMaxDistance(boost::multi_array<T, R> inputMatrix);
+		boost::multi_array<T, R> generateDistanceMap3D(const Image<T,R> &imageAttr, const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &distanceMap2D, boost::multi_array<T, R> &distanceMap, const ConfigFile &config);
+        void fillMatrix3D(const boost::multi_array<T,R> &inputMatrix, const boost::multi_array<T, R> &distanceMatrix, boost::multi_array<float, 2>  &gldzmat, const VoxelList<T> *voxels = nullptr);
+        int getNrDistances3D(const boost::multi_array<T, R> &inputMatrix);
+		int getMaxDistance(const boost::multi_array<T, R> &inputMatrix);
 		void fillConvolutionalVectorGLD(vector<T> &convolutionalVector, int is3D);
      public:
         void writeCSVFileGLDZM3D(GLDZMFeatures3D<T,R> gldzmFeat, string outputFolder);
-		void writeOneFileGLDZM3D(GLDZMFeatures3D<T, R> gldzmFeat, ConfigFile config, int &parameterSpaceNr);
-        void calculateAllGLDZMFeatures3D(GLDZMFeatures3D<T,R> &gldzmFeat, boost::multi_array<T, R> distanceMap, Image<T,R> imageAttr, ConfigFile config);
+		void writeOneFileGLDZM3D(GLDZMFeatures3D<T, R> gldzmFeat, const ConfigFile &config, int &parameterSpaceNr);
+        void calculateAllGLDZMFeatures3D(GLDZMFeatures3D<T,R> &gldzmFeat, const boost::multi_array<T, R> &distanceMap, const Image<T,R> &imageAttr, const ConfigFile &config);
 
 };
 
 template <class T, size_t R>
-int GLDZMFeatures3D<T, R>::getMaxDistance(boost::multi_array<T, R> inputMatrix) {
+int GLDZMFeatures3D<T, R>::getMaxDistance(const boost::multi_array<T, R> &inputMatrix) {
 	vector<float> distances;
 	distances.push_back(ceil(inputMatrix.shape()[0] / 2));
 	distances.push_back(ceil(inputMatrix.shape()[1] / 2));
@@ -105,7 +105,7 @@ void GLDZMFeatures3D<T, R>::fillConvolutionalVectorGLD(vector<T> &convolutionalV
 }
 
 template <class T, size_t R>
-boost::multi_array<T, R> GLDZMFeatures3D<T, R>::generateDistanceMap3D(Image<T, R> imageAttr, boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap2D, boost::multi_array<T, R> &distanceMap3D, ConfigFile config) {
+boost::multi_array<T, R> GLDZMFeatures3D<T, R>::generateDistanceMap3D(const Image<T, R> &imageAttr, const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &distanceMap2D, boost::multi_array<T, R> &distanceMap3D, const ConfigFile &config) {
 	int dist = 1;
 	//construct convolutional kernel
 	vector<float> convolutionalVector;
@@ -115,7 +115,7 @@ boost::multi_array<T, R> GLDZMFeatures3D<T, R>::generateDistanceMap3D(Image<T, R
 	float voxelSize[] = { 1,1,1 };
 	ImageType::Pointer kernel = converArray2Image(kernelArray, dimKernel, voxelSize);
 	//assign the image matrix
-	boost::multi_array<T, 3> actualMatrix = inputMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = inputMatrix;
 	//how many grey levels do I have
 	int sizeGreyLevels = (imageAttr.diffGreyLevels).size();
 	//the original (not discretize image!)
@@ -202,53 +202,50 @@ In the method fillMatrix3D the GLDZM matrix is filled, taking the original matri
 The GLDZM matrix is given as reference and filled in the function
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
 @param[in]: boost::multi_array<T, 3> GLDZM: GLDZM matrix
+@param[in] voxels: voxel list of the VOI matrix if the mask is sparse, otherwise nullptr
 */
 template <class T, size_t R>
-void GLDZMFeatures3D<T, R>::fillMatrix3D(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap, boost::multi_array<float, 2>  &gldzmat) {
+void GLDZMFeatures3D<T, R>::fillMatrix3D(const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &distanceMap, boost::multi_array<float, 2>  &gldzmat, const VoxelList<T> *voxels) {
+	//the voxel list can only be used if it belongs to the input matrix
+	voxels = sparseVoxels(voxels, inputMatrix);
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
 	vector<vector<int> > matrixIndices;
 	vector<int> actualIndex;
 	T actElement;
 	int minDistance;
 	int actGreyIndex;
 
-	for (int depth = 0; depth<inputMatrix.shape()[2]; depth++) {
-		for (int row = 0; row<inputMatrix.shape()[0]; row++) {
-			for (int col = 0; col<inputMatrix.shape()[1]; col++) {
-				actElement = inputMatrix[row][col][depth];
-				if (!isnan(actElement)) {
-					actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
-					inputMatrix[row][col][depth] = NAN;
-					actualIndex.push_back(row);
-					actualIndex.push_back(col);
-					actualIndex.push_back(depth);
-					matrixIndices.push_back(actualIndex);
-					actualIndex.clear();
-					GLSZM3D.getNeighbors3D(inputMatrix, actElement, matrixIndices);
-					
-				}
-				if (matrixIndices.size()>0) {
-					minDistance = GLDZM2D.getMinimalDistance(distanceMap, matrixIndices);
-					matrixIndices.clear();
-					gldzmat[actGreyIndex][minDistance - 1] += 1;
-					totalNrZones += 1;
-				}
-			}
+	forEachVoxel(zoneMatrix, voxels, [&](int row, int col, int depth) {
+		actElement = zoneMatrix[row][col][depth];
+		if (!isnan(actElement)) {
+			actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
+			zoneMatrix[row][col][depth] = NAN;
+			actualIndex.push_back(row);
+			actualIndex.push_back(col);
+			actualIndex.push_back(depth);
+			matrixIndices.push_back(actualIndex);
+			actualIndex.clear();
+			GLSZM3D.getNeighbors3D(zoneMatrix, actElement, matrixIndices);
+			
 		}
-	}
+		if (matrixIndices.size()>0) {
+			minDistance = GLDZM2D.getMinimalDistance(distanceMap, matrixIndices);
+			matrixIndices.clear();
+			gldzmat[actGreyIndex][minDistance - 1] += 1;
+			totalNrZones += 1;
+		}
+	});
 }
 
 
 /*!
-In the method getMatrix3D the GLDZM matrix is generated and filled using the function fillMatrix.
-The function is mainly used get the size of the GLDZM matrix. \n
+In the method getNrDistances3D the number of columns of the GLDZM matrix is calculated. \n
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
-@param[out]: boost::multi_array<T, 3> GLDZM: GLDZM matrix
+@param[out]: number of columns of the GLDZM matrix
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLDZMFeatures3D<T,R>::getMatrix3D( boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> distanceMap){
-    typedef boost::multi_array<float, 2>  gldzmat;
-	//get the number of different grey levels in the VOI
-    int sizeGreyLevels = (this->diffGreyLevels).size();
+int GLDZMFeatures3D<T,R>::getNrDistances3D( const boost::multi_array<T, R> &inputMatrix){
 	//in order to get the maximal distance to the  borders, calculate the distance from
 	//the center voxel to the border
     int colSize = ceil(double(inputMatrix.shape()[0])/2);
@@ -258,14 +255,11 @@ boost::multi_array<float, 2> GLDZMFeatures3D<T,R>::getMatrix3D( boost::multi_arr
     if(ceil(double(inputMatrix.shape()[2])/2)<colSize){
         colSize = ceil(double(inputMatrix.shape()[2])/2);
     }
-    gldzmat GLDZMatrix(boost::extents[sizeGreyLevels][colSize]);
-	fillMatrix3D(inputMatrix, distanceMap, GLDZMatrix);
-
-    return GLDZMatrix;
+    return colSize;
 }
 
 template <class T, size_t R>
-void GLDZMFeatures3D<T, R>::calculateAllGLDZMFeatures3D(GLDZMFeatures3D<T,R> &gldzmFeatures, boost::multi_array<T, R> distanceMap2D, Image<T,R> imageAttr, ConfigFile config){
+void GLDZMFeatures3D<T, R>::calculateAllGLDZMFeatures3D(GLDZMFeatures3D<T,R> &gldzmFeatures, const boost::multi_array<T, R> &distanceMap2D, const Image<T,R> &imageAttr, const ConfigFile &config){
 	gldzmFeatures.getConfigValues(config);
 	this->diffGreyLevels = imageAttr.diffGreyLevels;
 	boost::multi_array<T, R> distanceMap(boost::extents[imageAttr.imageMatrix.shape()[0]][imageAttr.imageMatrix.shape()[1]][imageAttr.imageMatrix.shape()[2]]);
@@ -275,7 +269,9 @@ void GLDZMFeatures3D<T, R>::calculateAllGLDZMFeatures3D(GLDZMFeatures3D<T,R> &gl
 	else {
 		generateDistanceMap3D(imageAttr, imageAttr.imageMatrixOriginal, distanceMap2D, distanceMap, config);
 	}
-    boost::multi_array<float,2> GLDZM=gldzmFeatures.getMatrix3D(imageAttr.imageMatrix, distanceMap);
+    ScratchMatrix<float> GLDZMBuffer(this->diffGreyLevels.size(), getNrDistances3D(imageAttr.imageMatrix));
+    boost::multi_array<float,2> &GLDZM = GLDZMBuffer.get();
+    gldzmFeatures.fillMatrix3D(imageAttr.imageMatrix, distanceMap, GLDZM, imageAttr.getVoxelList());
 	
 	float totalSum = gldzmFeatures.calculateTotalSum(GLDZM);
     rowSums=gldzmFeatures.calculateRowSums(GLDZM);
@@ -294,7 +290,9 @@ void GLDZMFeatures3D<T, R>::calculateAllGLDZMFeatures3D(GLDZMFeatures3D<T,R> &gl
     gldzmFeatures.calculateRunLengthNonUniformityNorm(rowSums, totalSum);
     gldzmFeatures.calculateRunLengthNonUniformity(rowSums, totalSum);
     gldzmFeatures.calculateRunPercentage3D(imageAttr.vectorOfMatrixElements, totalSum, 1);
-    boost::multi_array<float,2> probMatrix = gldzmFeatures.calculateProbMatrix(GLDZM, totalSum);
+    ScratchMatrix<float> probMatrixBuffer(GLDZM.shape()[0], GLDZM.shape()[1]);
+    boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+    gldzmFeatures.calculateProbMatrix(GLDZM, totalSum, probMatrix);
 	float meanGrey = gldzmFeatures.calculateMeanProbGrey(probMatrix);
 
     gldzmFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
@@ -350,7 +348,7 @@ void GLDZMFeatures3D<T, R>::writeCSVFileGLDZM3D(GLDZMFeatures3D<T,R> gldzmFeat,
 }
 
 template <class T, size_t R>
-void GLDZMFeatures3D<T, R>::writeOneFileGLDZM3D(GLDZMFeatures3D<T, R> gldzmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLDZMFeatures3D<T, R>::writeOneFileGLDZM3D(GLDZMFeatures3D<T, R> gldzmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -76,42 +76,43 @@ class GLRLMFeatures  {
         float runLengthVar = NAN;
         float runEntropy = NAN;
 
-        vector<float> calculateRowSums(boost::multi_array<float,2> glrlmatrix);
-        vector<float> calculateColSums(boost::multi_array<float,2> glrlmatrix);
-		int findIndex(vector<T> array, int size, T target);
+        vector<float> calculateRowSums(const boost::multi_array<float,2> &glrlmatrix);
+        vector<float> calculateColSums(const boost::multi_array<float,2> &glrlmatrix);
+		int findIndex(const vector<T> &array, int size, T target);
 
-		void getConfigValues(ConfigFile config);
+		void getConfigValues(const ConfigFile &config);
 		void setEmphasisValues(int extEmph, float powRow, float powCol);
-        float calculateTotalSum(boost::multi_array<float,2> glrlMatrix);
-        int getMaxRunLength(boost::multi_array<T, R> inputMatrix);
+        float calculateTotalSum(const boost::multi_array<float,2> &glrlMatrix);
+        int getMaxRunLength(const boost::multi_array<T, R> &inputMatrix);
 		
-        void calculateShortRunEmphasis(vector<float> colSums, float totalSum);
-        void calculateLongRunEmphasis(vector<float> colSums, float totalSum);
-        void calculateLowGreyEmph(vector<float> colSums, float totalSum);
-        void calculateHighGreyEmph(vector<float> colSums, float totalSum);
-        void calculateShortRunLow(boost::multi_array<float,2> glrlmatrix, float totalSum);
-        void calculateShortRunHigh(boost::multi_array<float,2> glrlmatrix, float totalSum);
-        void calculateLongRunLowEmph(boost::multi_array<float,2> glrlmatrix, float totalSum);
-        void calculateLongRunHighEmph(boost::multi_array<float,2> glrlmatrix, float totalSum);
-        void calculateGreyNonUniformity(vector<float> colSums, float totalSum);
-        void calculateGreyNonUniformityNorm(vector<float> colSums, float totalSum);
-        void calculateRunLengthNonUniformityNorm(vector<float> rowSums, float totalSum);
-        void calculateRunLengthNonUniformity(vector<float> rowSums, float totalSum);
-
-        int calculateTotalNrVoxels(boost::multi_array<T,R> inputMatrix, int depth);
-        void calculateTotalNrVoxels3D(vector<T> vectorMatrElement);
-        void calculateRunPercentage(boost::multi_array<T,R> inputMatrix, int depth, float totalSum, int nrNeighbor);
-        void calculateRunPercentage3D(vector<T> vectorMatrElement, float totalSum, int nrNeighbor);
-        boost::multi_array<float,2> calculateProbMatrix(boost::multi_array<float,2> glrlmatrix, float totalSum);
-        float calculateMeanProbGrey(boost::multi_array<float,2> probMatrix);
-        void calculateGreyLevelVar(boost::multi_array<float,2> probMatrix, float mean);
-        float calculateMeanProbRun(boost::multi_array<float,2> probMatrix);
-        void calculateRunLengthVar(boost::multi_array<float,2> probMatrix, float meanRun);
-        void calculateRunEntropy(boost::multi_array<float,2> probMatrix);
+        void calculateShortRunEmphasis(const vector<float> &colSums, float totalSum);
+        void calculateLongRunEmphasis(const vector<float> &colSums, float totalSum);
+        void calculateLowGreyEmph(const vector<float> &colSums, float totalSum);
+        void calculateHighGreyEmph(const vector<float> &colSums, float totalSum);
+        void calculateShortRunLow(const boost::multi_array<float,2> &glrlmatrix, float totalSum);
+        void calculateShortRunHigh(const boost::multi_array<float,2> &glrlmatrix, float totalSum);
+        void calculateLongRunLowEmph(const boost::multi_array<float,2> &glrlmatrix, float totalSum);
+        void calculateLongRunHighEmph(const boost::multi_array<float,2> &glrlmatrix, float totalSum);
+        void calculateGreyNonUniformity(const vector<float> &colSums, float totalSum);
+        void calculateGreyNonUniformityNorm(const vector<float> &colSums, float totalSum);
+        void calculateRunLengthNonUniformityNorm(const vector<float> &rowSums, float totalSum);
+        void calculateRunLengthNonUniformity(const vector<float> &rowSums, float totalSum);
+
+        int calculateTotalNrVoxels(const boost::multi_array<T,R> &inputMatrix, int depth);
+        void calculateTotalNrVoxels3D(const vector<T> &vectorMatrElement);
+        void calculateRunPercentage(const boost::multi_array<T,R> &inputMatrix, int depth, float totalSum, int nrNeighbor);
+        void calculateRunPercentage3D(const vector<T> &vectorMatrElement, float totalSum, int nrNeighbor);
+        boost::multi_array<float,2> calculateProbMatrix(const boost::multi_array<float,2> &glrlmatrix, float totalSum);
+        void calculateProbMatrix(const boost::multi_array<float,2> &glrlmatrix, float totalSum, boost::multi_array<float,2> &probMatrix);
+        float calculateMeanProbGrey(const boost::multi_array<float,2> &probMatrix);
+        void calculateGreyLevelVar(const boost::multi_array<float,2> &probMatrix, float mean);
+        float calculateMeanProbRun(const boost::multi_array<float,2> &probMatrix);
+        void calculateRunLengthVar(const boost::multi_array<float,2> &probMatrix, float meanRun);
+        void calculateRunEntropy(const boost::multi_array<float,2> &probMatrix);
 		
 };
 template <class T, size_t R>
-int GLRLMFeatures<T, R>::findIndex(vector<T> array, int size, T target) {
+int GLRLMFeatures<T, R>::findIndex(const vector<T> &array, int size, T target) {
 	int i = 0;
 	while ((i < size) && (array[i] != target)) i++;
 	return (i < size) ? (i) : (-1);
@@ -119,7 +120,7 @@ int GLRLMFeatures<T, R>::findIndex(vector<T> array, int size, T target) {
 
 
 template<class T, size_t R>
-void GLRLMFeatures<T, R>::getConfigValues(ConfigFile config) {
+void GLRLMFeatures<T, R>::getConfigValues(const ConfigFile &config) {
 	if (config.extendedEmphasis == 1) {
 		setEmphasisValues(config.extendedEmphasis, config.powerRow, config.powerCol);
 	}
@@ -143,13 +144,19 @@ void GLRLMFeatures<T, R>::setEmphasisValues(int extEmph, float row, float col) {
 //from the GLRL-Matrix calculate the probability matrx
 //do this by dividing every matrix elemnt with the total nr. of voxels
 template <class T, size_t R>
-boost::multi_array<float,2> GLRLMFeatures<T, R>::calculateProbMatrix(boost::multi_array<float,2> glrlmatrix, float totalSum){
-	boost::multi_array<float,2> probMatrix=glrlmatrix;
-    transform( probMatrix.origin(), probMatrix.origin() + probMatrix.num_elements(),
-                    probMatrix.origin(),  bind2nd(std::divides<float>(),int(totalSum)));
+boost::multi_array<float,2> GLRLMFeatures<T, R>::calculateProbMatrix(const boost::multi_array<float,2> &glrlmatrix, float totalSum){
+	boost::multi_array<float,2> probMatrix(boost::extents[glrlmatrix.shape()[0]][glrlmatrix.shape()[1]]);
+	calculateProbMatrix(glrlmatrix, totalSum, probMatrix);
     return probMatrix;
 }
 
+//the probability matrix is written to a matrix of the same size (e.g. a matrix of the matrix pool)
+template <class T, size_t R>
+void GLRLMFeatures<T, R>::calculateProbMatrix(const boost::multi_array<float,2> &glrlmatrix, float totalSum, boost::multi_array<float,2> &probMatrix){
+    transform( glrlmatrix.origin(), glrlmatrix.origin() + glrlmatrix.num_elements(),
+                    probMatrix.origin(),  bind2nd(std::divides<float>(),int(totalSum)));
+}
+
 /*!
 \brief calculateMeanProbGrey
 @param boost::multi_array<float,2> probMatrix matrix filled with the probabilities
@@ -158,7 +165,7 @@ calculates the mean probability of the appearance of every grey level
 TODO change bordwers in for loop (probMatrix.shape())
 */
 template <class T, size_t R>
-float GLRLMFeatures<T, R>::calculateMeanProbGrey(boost::multi_array<float,2> probMatrix){
+float GLRLMFeatures<T, R>::calculateMeanProbGrey(const boost::multi_array<float,2> &probMatrix){
     float mean=0;
     for(int i=0; i<probMatrix.shape()[0]; i++){
         for(int j=0; j<probMatrix.shape()[1]; j++){
@@ -175,7 +182,7 @@ float GLRLMFeatures<T, R>::calculateMeanProbGrey(boost::multi_array<float,2> pro
 
 //calcuöate the mean probability of the runlength
 template <class T, size_t R>
-float GLRLMFeatures<T, R>::calculateMeanProbRun(boost::multi_array<float,2> probMatrix){
+float GLRLMFeatures<T, R>::calculateMeanProbRun(const boost::multi_array<float,2> &probMatrix){
     float mean = 0;
     for(int i = 0; i < probMatrix.shape()[0]; i++){
         for(int j = 0; j < probMatrix.shape()[1]; j++){
@@ -197,7 +204,7 @@ get the maximal run length \n
 The maximal run length is the maximal size of one dimension
 */
 template <class T, size_t R>
-int GLRLMFeatures<T, R>::getMaxRunLength(boost::multi_array<T, R> inputMatrix){
+int GLRLMFeatures<T, R>::getMaxRunLength(const boost::multi_array<T, R> &inputMatrix){
     maxRunLength = std::max(inputMatrix.shape()[0], inputMatrix.shape()[1]);
     maxRunLength = std::max(maxRunLength, int(inputMatrix.shape()[2]));
     return maxRunLength;
@@ -209,7 +216,7 @@ int GLRLMFeatures<T, R>::getMaxRunLength(boost::multi_array<T, R> inputMatrix){
 calculate the sum of all matrix elements
 */
 template<class T, size_t R>
-float GLRLMFeatures<T, R>::calculateTotalSum(boost::multi_array<float,2> glrlmatrix){
+float GLRLMFeatures<T, R>::calculateTotalSum(const boost::multi_array<float,2> &glrlmatrix){
     T sum = 0;
     sum = accumulate(glrlmatrix.origin(), glrlmatrix.origin() + glrlmatrix.num_elements(), 0 );
     return sum;
@@ -222,7 +229,7 @@ float GLRLMFeatures<T, R>::calculateTotalSum(boost::multi_array<float,2> glrlmat
 calculates the sum of rows and stores them in the vector rowSums
 */
 template<class T, size_t R>
-vector<float> GLRLMFeatures<T,R>::calculateRowSums(boost::multi_array<float,2> glrlmatrix){
+vector<float> GLRLMFeatures<T,R>::calculateRowSums(const boost::multi_array<float,2> &glrlmatrix){
     vector<float> rowSums;
     rowSums.clear();
     int sum =0;
@@ -247,7 +254,7 @@ vector<float> GLRLMFeatures<T,R>::calculateRowSums(boost::multi_array<float,2> g
 calculates the sum of columns and stores them in the vector colSums
 */
 template<class T, size_t R>
-vector<float> GLRLMFeatures<T,R>::calculateColSums(boost::multi_array<float,2> glrlmatrix){
+vector<float> GLRLMFeatures<T,R>::calculateColSums(const boost::multi_array<float,2> &glrlmatrix){
     int sum = 0;
 
     vector<float> colSums;
@@ -315,7 +322,7 @@ calculates the total number of voxels of one slice of the matrix
 
 */
 template <class T, size_t R>
-int GLRLMFeatures<T, R>::calculateTotalNrVoxels(boost::multi_array<T,R> inputMatrix, int depth){
+int GLRLMFeatures<T, R>::calculateTotalNrVoxels(const boost::multi_array<T,R> &inputMatrix, int depth){
     vector<T> vectorSliceElements;
     for(int row = 0; row < inputMatrix.shape()[0]; row++){
         for(int col = 0; col < inputMatrix.shape()[1]; col++){
@@ -329,7 +336,7 @@ int GLRLMFeatures<T, R>::calculateTotalNrVoxels(boost::multi_array<T,R> inputMat
 }
 
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateTotalNrVoxels3D(vector<T> vectorMatrElement){
+void GLRLMFeatures<T, R>::calculateTotalNrVoxels3D(const vector<T> &vectorMatrElement){
     totalNrVoxels=boost::size(vectorMatrElement);
 }
 
@@ -342,7 +349,7 @@ This feature emphasizes the short runs. The higher the value, the more short run
 */
 
 template<class T, size_t R>
-void GLRLMFeatures<T, R>::calculateShortRunEmphasis(vector<float> rowSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateShortRunEmphasis(const vector<float> &rowSums, float totalSum){
     shortRunEmphasis = 0;
 	if (totalSum != 0) {
 		for(int j=0; j<rowSums.size(); j++){
@@ -379,7 +386,7 @@ This feature emphasizes the long runs. The higher the value, the more long runs
 */
 
 template<class T, size_t R>
-void GLRLMFeatures<T, R>::calculateLongRunEmphasis(vector<float> rowSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateLongRunEmphasis(const vector<float> &rowSums, float totalSum){
     longRunEmphasis=0;
 	if (totalSum != 0) {
 		for(int j=0; j<rowSums.size(); j++){
@@ -411,7 +418,7 @@ void GLRLMFeatures<T, R>::calculateLongRunEmphasis(vector<float> rowSums, float
 This feature emphasizes the low grey levels. The higher the value, the more low grey levels are in the matrix.
 */
 template<class T, size_t R>
-void GLRLMFeatures<T, R>::calculateLowGreyEmph(vector<float> colSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateLowGreyEmph(const vector<float> &colSums, float totalSum){
     lowGreyEmph=0;
 	if (totalSum != 0) {
 		for(int i=0; i<colSums.size(); i++){
@@ -439,7 +446,7 @@ void GLRLMFeatures<T, R>::calculateLowGreyEmph(vector<float> colSums, float tota
 This feature emphasizes the high grey levels. The higher the value, the more high grey levels are in the matrix.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateHighGreyEmph(vector<float> colSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateHighGreyEmph(const vector<float> &colSums, float totalSum){
     highGreyEmph=0;
 	if (totalSum != 0) {
 		for(int i=0; i<colSums.size(); i++){
@@ -470,7 +477,7 @@ void GLRLMFeatures<T, R>::calculateHighGreyEmph(vector<float> colSums, float tot
 This feature emphasizes the low grey levels which habe a short run. The higher the value, the more low grey levels with short runs are in the matrix.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateShortRunLow(boost::multi_array<float,2> glrlmatrix, float totalSum){
+void GLRLMFeatures<T, R>::calculateShortRunLow(const boost::multi_array<float,2> &glrlmatrix, float totalSum){
     shortRunLow = 0;
 	if (totalSum != 0) {
 		for(int row = 0; row < glrlmatrix.shape()[0]; row++){
@@ -504,7 +511,7 @@ void GLRLMFeatures<T, R>::calculateShortRunLow(boost::multi_array<float,2> glrlm
 This feature emphasizes the high grey levels which habe a short run. The higher the value, the more high grey levels with short runs are in the matrix.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateShortRunHigh(boost::multi_array<float,2> glrlmatrix, float totalSum){
+void GLRLMFeatures<T, R>::calculateShortRunHigh(const boost::multi_array<float,2> &glrlmatrix, float totalSum){
     shortRunHigh = 0;
 	if (totalSum != 0) {
 		for(int row = 0; row < glrlmatrix.shape()[0]; row++){
@@ -535,7 +542,7 @@ void GLRLMFeatures<T, R>::calculateShortRunHigh(boost::multi_array<float,2> glrl
 This feature emphasizes the low grey levels which habe a long run. The higher the value, the more low grey levels with long runs are in the matrix.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateLongRunLowEmph(boost::multi_array<float,2> glrlmatrix, float totalSum){
+void GLRLMFeatures<T, R>::calculateLongRunLowEmph(const boost::multi_array<float,2> &glrlmatrix, float totalSum){
     longRunLowEmph = 0;
 	if (totalSum != 0) {
 		for(int row = 0; row < glrlmatrix.shape()[0]; row++){
@@ -568,7 +575,7 @@ void GLRLMFeatures<T, R>::calculateLongRunLowEmph(boost::multi_array<float,2> gl
 This feature emphasizes the high grey levels which habe a long run. The higher the value, the more high grey levels with long runs are in the matrix.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateLongRunHighEmph(boost::multi_array<float,2> glrlmatrix, float totalSum){
+void GLRLMFeatures<T, R>::calculateLongRunHighEmph(const boost::multi_array<float,2> &glrlmatrix, float totalSum){
     longRunHighEmph=0;
 	if (totalSum != 0) {
 		for (int row = 0; row < glrlmatrix.shape()[0]; row++) {
@@ -598,7 +605,7 @@ This features is a measure for the distribution of the grey levels in the image
 The more equally distrbuted the runs of the grey levels are, the lower is the value.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateGreyNonUniformity(vector<float> colSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateGreyNonUniformity(const vector<float> &colSums, float totalSum){
     greyNonUniformity = 0;
     greyNonUniformity = for_each(colSums.begin(), colSums.end(), square_accumulate<float>()).result();
 	if (totalSum != 0) {
@@ -618,7 +625,7 @@ void GLRLMFeatures<T, R>::calculateGreyNonUniformity(vector<float> colSums, floa
 This features is a normalized version of the grey-non-uniformity feature.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateGreyNonUniformityNorm(vector<float> colSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateGreyNonUniformityNorm(const vector<float> &colSums, float totalSum){
     greyNonUniformityNorm = for_each(colSums.begin(), colSums.end(), square_accumulate<float>()).result();
 	if (totalSum != 0) {
 		greyNonUniformityNorm = greyNonUniformityNorm / pow(totalSum, 2);
@@ -639,7 +646,7 @@ This feature is a measurement for the distribution of the run length. \n
 The lower this value is, the more equally the run length are distributed.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateRunLengthNonUniformity(vector<float> rowSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateRunLengthNonUniformity(const vector<float> &rowSums, float totalSum){
     runLengthNonUniformity=for_each(rowSums.begin(), rowSums.end(), square_accumulate<float>()).result();
 	if (totalSum != 0) {
 		runLengthNonUniformity = runLengthNonUniformity / totalSum;
@@ -658,7 +665,7 @@ void GLRLMFeatures<T, R>::calculateRunLengthNonUniformity(vector<float> rowSums,
 This is a normalised version of the run-length non uniformity feature.
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateRunLengthNonUniformityNorm(vector<float> rowSums, float totalSum){
+void GLRLMFeatures<T, R>::calculateRunLengthNonUniformityNorm(const vector<float> &rowSums, float totalSum){
     runLengthNonUniformityNorm=for_each(rowSums.begin(), rowSums.end(), square_accumulate<float>()).result();
 	if (totalSum != 0) {
 		runLengthNonUniformityNorm = runLengthNonUniformityNorm / pow(totalSum, 2);
@@ -677,7 +684,7 @@ void GLRLMFeatures<T, R>::calculateRunLengthNonUniformityNorm(vector<float> rowS
 calculates the fraction of runs appearing in the matrix and potential runs
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateRunPercentage(boost::multi_array<T,R> inputMatrix, int depth, float totalSum, int nrNeighbor){
+void GLRLMFeatures<T, R>::calculateRunPercentage(const boost::multi_array<T,R> &inputMatrix, int depth, float totalSum, int nrNeighbor){
 	//if (depth == 0) {
 	//	totalNrVoxels = inputMatrix.shape()[0] * inputMatrix.shape()[1] * inputMatrix.shape()[2];
 	//}
@@ -693,7 +700,7 @@ void GLRLMFeatures<T, R>::calculateRunPercentage(boost::multi_array<T,R> inputMa
 }
 
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateRunPercentage3D(vector<T> vectorMatrElement, float totalSum, int nrNeighbor){
+void GLRLMFeatures<T, R>::calculateRunPercentage3D(const vector<T> &vectorMatrElement, float totalSum, int nrNeighbor){
     calculateTotalNrVoxels3D(vectorMatrElement);
 	if ((totalNrVoxels)*nrNeighbor != 0) {
 		runPercentage = totalSum / ((totalNrVoxels)*nrNeighbor);
@@ -712,7 +719,7 @@ calculates the variance of grey levels \n
 the lower the value, the more homogeneous is the region
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateGreyLevelVar(boost::multi_array<float,2> probMatrix, float meanGrey){
+void GLRLMFeatures<T, R>::calculateGreyLevelVar(const boost::multi_array<float,2> &probMatrix, float meanGrey){
     greyLevelVar=0;
     for(int i=0; i<probMatrix.shape()[0]; i++){
         for(int j= 0; j<probMatrix.shape()[1]; j++){
@@ -733,7 +740,7 @@ calculates the variance of run length \n
 the lower the value, the more homogeneous is the region
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateRunLengthVar(boost::multi_array<float,2> probMatrix, float meanRun){
+void GLRLMFeatures<T, R>::calculateRunLengthVar(const boost::multi_array<float,2> &probMatrix, float meanRun){
     runLengthVar = 0;
     for(int i=0; i<probMatrix.shape()[0]; i++){
         for(int j= 0; j<probMatrix.shape()[1]; j++){
@@ -751,7 +758,7 @@ void GLRLMFeatures<T, R>::calculateRunLengthVar(boost::multi_array<float,2> prob
 calculates the entropy of the probability matrix
 */
 template <class T, size_t R>
-void GLRLMFeatures<T, R>::calculateRunEntropy(boost::multi_array<float,2> probMatrix){
+void GLRLMFeatures<T, R>::calculateRunEntropy(const boost::multi_array<float,2> &probMatrix){
     runEntropy=0;
     for(int i=0; i<probMatrix.shape()[0]; i++){
         for(int j= 0; j<probMatrix.shape()[1]; j++){
@@ -27,7 +27,7 @@ private:
 
 	int maxRunLength;
 
-	boost::multi_array<float, 2> createGLRLMatrixAVG(boost::multi_array<T, R> inputMatrix, int depth, int ang);
+	void createGLRLMatrixAVG(const boost::multi_array<T, R> &inputMatrix, int depth, int ang, boost::multi_array<float, 2> &GLRLMatrix);
 	void extractGLRLMDataAVG(vector<T> &glrlmData, GLRLMFeatures2DAVG<T, R> glrlmFeatures);
 
 public:
@@ -35,11 +35,11 @@ public:
 	}
 	~GLRLMFeatures2DAVG() {
 	}
-	void fill2DMatrices2DAVG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, vector<float> diffGreyLevels, int depth, int ang);
+	void fill2DMatrices2DAVG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, const vector<float> &diffGreyLevels, int depth, int ang);
 
-	void calculateAllGLRLMFeatures2DAVG(GLRLMFeatures2DAVG<T, R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffFGrey, ConfigFile config);
+	void calculateAllGLRLMFeatures2DAVG(GLRLMFeatures2DAVG<T, R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffFGrey, const ConfigFile &config);
 	void writeCSVFileGLRLM2DAVG(GLRLMFeatures2DAVG<T, R> glrlmFeat, string outputFolder);
-	void writeOneFileGLRLM2DAVG(GLRLMFeatures2DAVG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileGLRLM2DAVG(GLRLMFeatures2DAVG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr);
 
 };
 
@@ -48,14 +48,11 @@ In the method createGLRLMatrixW=Merge the GLRLM-matrix for given slice is calcul
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
 @param[in] : int depth: number of the actual slice
 @param[in] : int angle: angle
-@param[out]: GLCM-matrix
+@param[out]: GLRLM-matrix, it has the size number of grey levels x maxRunLength and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLRLMFeatures2DAVG<T, R>::createGLRLMatrixAVG(boost::multi_array<T, R> inputMatrix, int depth, int ang) {
-	int sizeMatrix = this->diffGreyLevels.size();
-	glrlmMat GLRLMatrix(boost::extents[sizeMatrix][this->maxRunLength]);
+void GLRLMFeatures2DAVG<T, R>::createGLRLMatrixAVG(const boost::multi_array<T, R> &inputMatrix, int depth, int ang, boost::multi_array<float, 2> &GLRLMatrix) {
 	fill2DMatrices2DAVG(inputMatrix, GLRLMatrix, this->diffGreyLevels, depth, ang);
-	return GLRLMatrix;
 }
 
 
@@ -71,7 +68,9 @@ In the method fill2DMatrices2DWOMerge the matrix is filled for the given image s
 The function works analog to the function in GLRLMFeatures2DFullMerge
 */
 template <class T, size_t R>
-void GLRLMFeatures2DAVG<T, R>::fill2DMatrices2DAVG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, vector<float> diffGreyLevels, int depth, int ang) {
+void GLRLMFeatures2DAVG<T, R>::fill2DMatrices2DAVG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, const vector<float> &diffGreyLevels, int depth, int ang) {
+	//runs are marked by setting their elements to NAN, this is done in a scratch copy of the actual slice
+	boost::multi_array<T, 2> runSlice = getSliceCopy(inputMatrix, depth);
 
 	T actGreyLevel = 0;
 	T actElement = 0;
@@ -79,54 +78,58 @@ void GLRLMFeatures2DAVG<T, R>::fill2DMatrices2DAVG(boost::multi_array<T, R> inpu
 	int maxRowNr = inputMatrix.shape()[0];
 	int maxColNr = inputMatrix.shape()[1];
 	glrlm.getXYDirections(directionX, directionY, ang);
-	//have a look at the image-matrix slide by slide (2D)
-	//look for every grey level separately in every image slide
-	int actGreyIndex;
-	//get the grey level we are interested at the moment
-
-	for (int row = 0; row<maxRowNr; row++) {
-		for (int column = 0; column<maxColNr; column++) {
-			//         //at the beginning the run length =0
-			runLength = 0;
-			//get the actual matrix element
-			actElement = inputMatrix[maxRowNr - row - 1][column][depth];
-			actGreyIndex = glrlm.findIndex(diffGreyLevels, boost::size(diffGreyLevels), actElement);
-			//if the actual matrix element is the same as the actual gre level
-			if (!std::isnan(actElement)) {
-				//set the run length to 1
-				runLength = 1;
-				//to avoid to take an element more than once, set the element to NAN
-				inputMatrix[maxRowNr - row - 1][column][depth] = NAN;
-				////          //now look at the matrix element in the actual direction (depends on the
-				//angle we are interested at the moment
-				int colValue = column + directionX;
-				int rowValue = maxRowNr - 1 - (row + directionY);
-				//now have a look at the following elements in the desired direction
-				//stop as soon as we look at an element diifferent from our actual element
-				while (colValue<maxColNr && rowValue>-1 && colValue>-1 && inputMatrix[rowValue][colValue][depth] == actElement) {
-					//for every element we find, count the runLength
-					runLength += 1;
-					inputMatrix[rowValue][colValue][depth] = NAN;
-					//go further in the desired direction
-					colValue += 1 * directionX;
-					rowValue -= 1 * directionY;
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLRLM2D", depth, ang);
+	TextureMatrixStore::caseStore().fillRunMatrix(matrixKey, inputMatrix, glrlMatrix, depth, -directionY, directionX, 0, [&]() {
+		//have a look at the image-matrix slide by slide (2D)
+		//look for every grey level separately in every image slide
+		int actGreyIndex;
+		//get the grey level we are interested at the moment
+
+		for (int row = 0; row<maxRowNr; row++) {
+			for (int column = 0; column<maxColNr; column++) {
+				//         //at the beginning the run length =0
+				runLength = 0;
+				//get the actual matrix element
+				actElement = runSlice[maxRowNr - row - 1][column];
+				actGreyIndex = glrlm.findIndex(diffGreyLevels, boost::size(diffGreyLevels), actElement);
+				//if the actual matrix element is the same as the actual gre level
+				if (!std::isnan(actElement)) {
+					//set the run length to 1
+					runLength = 1;
+					//to avoid to take an element more than once, set the element to NAN
+					runSlice[maxRowNr - row - 1][column] = NAN;
+					////          //now look at the matrix element in the actual direction (depends on the
+					//angle we are interested at the moment
+					int colValue = column + directionX;
+					int rowValue = maxRowNr - 1 - (row + directionY);
+					//now have a look at the following elements in the desired direction
+					//stop as soon as we look at an element diifferent from our actual element
+					while (colValue<maxColNr && rowValue>-1 && colValue>-1 && runSlice[rowValue][colValue] == actElement) {
+						//for every element we find, count the runLength
+						runLength += 1;
+						runSlice[rowValue][colValue] = NAN;
+						//go further in the desired direction
+						colValue += 1 * directionX;
+						rowValue -= 1 * directionY;
+					}
 				}
-			}
-			//as soon as we cannot find an element in the desired direction, count one up in the desired
-			//position of the glrl-matrix
+				//as soon as we cannot find an element in the desired direction, count one up in the desired
+				//position of the glrl-matrix
 			
-			if (runLength > 0 && runLength < glrlMatrix.shape()[1] + 1) {
+				if (runLength > 0 && runLength < glrlMatrix.shape()[1] + 1) {
 				
-				glrlMatrix[actGreyIndex][runLength - 1] += 1;
-			}
+					glrlMatrix[actGreyIndex][runLength - 1] += 1;
+				}
 
+			}
 		}
-	}
+	});
 }
 
 
 template <class T, size_t R>
-void GLRLMFeatures2DAVG<T, R>::calculateAllGLRLMFeatures2DAVG(GLRLMFeatures2DAVG<T, R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, ConfigFile config) {
+void GLRLMFeatures2DAVG<T, R>::calculateAllGLRLMFeatures2DAVG(GLRLMFeatures2DAVG<T, R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const ConfigFile &config) {
 	this->diffGreyLevels = diffGrey;
 	glrlmFeatures.getConfigValues(config);
 	T sumShortRunEmphasis = 0;
@@ -163,13 +166,17 @@ void GLRLMFeatures2DAVG<T, R>::calculateAllGLRLMFeatures2DAVG(GLRLMFeatures2DAVG
 
 		for (int i = 0; i < 4; i++) {
 			ang = 180 - i * 45;
-			boost::multi_array<float, 2> glrlMatrix = createGLRLMatrixAVG(inputMatrix, depth, ang);
+			ScratchMatrix<float> glrlMatrixBuffer(this->diffGreyLevels.size(), maxRunLength);
+			boost::multi_array<float, 2> &glrlMatrix = glrlMatrixBuffer.get();
+			createGLRLMatrixAVG(inputMatrix, depth, ang, glrlMatrix);
 
 			totalSum = glrlmFeatures.calculateTotalSum(glrlMatrix);
 			rowSums = glrlmFeatures.calculateRowSums(glrlMatrix);
 			colSums = glrlmFeatures.calculateColSums(glrlMatrix);
 
-			boost::multi_array<float, 2> probMatrix = glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum);
+			ScratchMatrix<float> probMatrixBuffer(glrlMatrix.shape()[0], glrlMatrix.shape()[1]);
+			boost::multi_array<float, 2> &probMatrix = probMatrixBuffer.get();
+			glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum, probMatrix);
 			meanGrey = glrlmFeatures.calculateMeanProbGrey(probMatrix);
 			meanRun = glrlmFeatures.calculateMeanProbRun(probMatrix);
 
@@ -260,7 +267,7 @@ void GLRLMFeatures2DAVG<T, R>::writeCSVFileGLRLM2DAVG(GLRLMFeatures2DAVG<T, R> g
 }
 
 template <class T, size_t R>
-void GLRLMFeatures2DAVG<T, R>::writeOneFileGLRLM2DAVG(GLRLMFeatures2DAVG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLRLMFeatures2DAVG<T, R>::writeOneFileGLRLM2DAVG(GLRLMFeatures2DAVG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -29,18 +29,18 @@ private:
 	int maxRunLength;
 	string normGLRLM;
 	vector<float> actualSpacing;
-	boost::multi_array<float, 2> createGLRLMatrix2DDMRG(boost::multi_array<T, R> inputMatrix, int ang);
+	void createGLRLMatrix2DDMRG(const boost::multi_array<T, R> &inputMatrix, int ang, boost::multi_array<float, 2> &sum);
 	void extractGLRLMData2DDMRG(vector<T> &glrlmData, GLRLMFEATURES2DDMRG<T, R> glrlmFeatures);
-	void fill2DMatrices2DDMRG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int depth, int ang);
-	void calculateRunPercentage2DDMRG(boost::multi_array<T, R> inputMatrix, int depth, float totalSum, int nrNeighbor);
+	void fill2DMatrices2DDMRG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int depth, int ang);
+	void calculateRunPercentage2DDMRG(const boost::multi_array<T, R> &inputMatrix, int depth, float totalSum, int nrNeighbor);
 public:
 	GLRLMFEATURES2DDMRG() {
 	}
 	~GLRLMFEATURES2DDMRG() {
 	}
-	void calculateAllGLRLMFeatures2DDMRG(GLRLMFEATURES2DDMRG<T, R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffFGrey, vector<float> spacing, ConfigFile config);
+	void calculateAllGLRLMFeatures2DDMRG(GLRLMFEATURES2DDMRG<T, R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffFGrey, const vector<float> &spacing, const ConfigFile &config);
 	void writeCSVFileGLRLM2DDMRG(GLRLMFEATURES2DDMRG<T, R> glrlmFeat, string outputFolder);
-	void writeOneFileGLRLM2DDMRG(GLRLMFEATURES2DDMRG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileGLRLM2DDMRG(GLRLMFEATURES2DDMRG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr);
 
 };
 
@@ -49,17 +49,17 @@ In the method createGLRLMatrixW=Merge the GLRLM-matrix for given slice is calcul
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
 @param[in] : int depth: number of the actual slice
 @param[in] : int angle: angle
-@param[out]: GLCM-matrix
+@param[out]: GLRLM-matrix, it has the size number of grey levels x maxRunLength and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLRLMFEATURES2DDMRG<T, R>::createGLRLMatrix2DDMRG(boost::multi_array<T, R> inputMatrix, int ang) {
+void GLRLMFEATURES2DDMRG<T, R>::createGLRLMatrix2DDMRG(const boost::multi_array<T, R> &inputMatrix, int ang, boost::multi_array<float, 2> &sum) {
 	GLRLMFeatures2DAVG<T, R> glrlm2Davg;
 	int sizeMatrix = this->diffGreyLevels.size();
-	glrlmMat sum(boost::extents[sizeMatrix][this->maxRunLength]);
 	float weight;
 	for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
 		
-		glrlmMat GLRLMatrix(boost::extents[sizeMatrix][maxRunLength]);
+		ScratchMatrix<float> GLRLMatrixBuffer(sizeMatrix, maxRunLength);
+		glrlmMat &GLRLMatrix = GLRLMatrixBuffer.get();
 		glrlm2Davg.fill2DMatrices2DAVG(inputMatrix, GLRLMatrix, this->diffGreyLevels,depth, ang);
 		
 
@@ -67,13 +67,13 @@ boost::multi_array<float, 2> GLRLMFEATURES2DDMRG<T, R>::createGLRLMatrix2DDMRG(b
 		multSkalarMatrix(GLRLMatrix, weight);
 		matrixSum(sum, GLRLMatrix);
 	}
-
-	return sum;
 }
 	
 
 template <class T, size_t R>
-void GLRLMFEATURES2DDMRG<T, R>::fill2DMatrices2DDMRG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int depth, int ang) {
+void GLRLMFEATURES2DDMRG<T, R>::fill2DMatrices2DDMRG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int depth, int ang) {
+	//runs are marked by setting their elements to NAN, this is done in a scratch copy of the actual slice
+	boost::multi_array<T, 2> runSlice = getSliceCopy(inputMatrix, depth);
 
 	T actGreyLevel = 0;
 	T actElement = 0;
@@ -81,51 +81,55 @@ void GLRLMFEATURES2DDMRG<T, R>::fill2DMatrices2DDMRG(boost::multi_array<T, R> in
 	int maxRowNr = inputMatrix.shape()[0];
 	int maxColNr = inputMatrix.shape()[1];
 	glrlm.getXYDirections(directionX, directionY, ang);
-	//have a look at the image-matrix slide by slide (2D)
-	//look for every grey level separately in every image slide
-	int actGreyIndex;
-	//get the grey level we are interested at the moment
-
-	for (int row = 0; row<maxRowNr; row++) {
-		for (int column = 0; column<maxColNr; column++) {
-			//         //at the beginning the run length =0
-			runLength = 0;
-			//get the actual matrix element
-			actElement = inputMatrix[maxRowNr - row - 1][column][depth];
-			actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
-			//if the actual matrix element is the same as the actual gre level
-			if (!std::isnan(actElement)) {
-				//set the run length to 1
-				runLength = 1;
-				//to avoid to take an element more than once, set the element to NAN
-				inputMatrix[maxRowNr - row - 1][column][depth] = NAN;
-				////          //now look at the matrix element in the actual direction (depends on the
-				//angle we are interested at the moment
-				int colValue = column + directionX;
-				int rowValue = maxRowNr - 1 - (row + directionY);
-				//now have a look at the following elements in the desired direction
-				//stop as soon as we look at an element diifferent from our actual element
-				while (colValue<maxColNr && rowValue>-1 && colValue>-1 && inputMatrix[rowValue][colValue][depth] == actElement) {
-					//for every element we find, count the runLength
-					runLength += 1;
-					inputMatrix[rowValue][colValue][depth] = NAN;
-					//go further in the desired direction
-					colValue += 1 * directionX;
-					rowValue -= 1 * directionY;
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLRLM2D", depth, ang);
+	TextureMatrixStore::caseStore().fillRunMatrix(matrixKey, inputMatrix, glrlMatrix, depth, -directionY, directionX, 0, [&]() {
+		//have a look at the image-matrix slide by slide (2D)
+		//look for every grey level separately in every image slide
+		int actGreyIndex;
+		//get the grey level we are interested at the moment
+
+		for (int row = 0; row<maxRowNr; row++) {
+			for (int column = 0; column<maxColNr; column++) {
+				//         //at the beginning the run length =0
+				runLength = 0;
+				//get the actual matrix element
+				actElement = runSlice[maxRowNr - row - 1][column];
+				actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
+				//if the actual matrix element is the same as the actual gre level
+				if (!std::isnan(actElement)) {
+					//set the run length to 1
+					runLength = 1;
+					//to avoid to take an element more than once, set the element to NAN
+					runSlice[maxRowNr - row - 1][column] = NAN;
+					////          //now look at the matrix element in the actual direction (depends on the
+					//angle we are interested at the moment
+					int colValue = column + directionX;
+					int rowValue = maxRowNr - 1 - (row + directionY);
+					//now have a look at the following elements in the desired direction
+					//stop as soon as we look at an element diifferent from our actual element
+					while (colValue<maxColNr && rowValue>-1 && colValue>-1 && runSlice[rowValue][colValue] == actElement) {
+						//for every element we find, count the runLength
+						runLength += 1;
+						runSlice[rowValue][colValue] = NAN;
+						//go further in the desired direction
+						colValue += 1 * directionX;
+						rowValue -= 1 * directionY;
+					}
+				}
+				//as soon as we cannot find an element in the desired direction, count one up in the desired
+				//position of the glrl-matrix
+				if (runLength > 0 && runLength < glrlMatrix.shape()[1] + 1) {
+					glrlMatrix[actGreyIndex][runLength - 1] += 1;
 				}
-			}
-			//as soon as we cannot find an element in the desired direction, count one up in the desired
-			//position of the glrl-matrix
-			if (runLength > 0 && runLength < glrlMatrix.shape()[1] + 1) {
-				glrlMatrix[actGreyIndex][runLength - 1] += 1;
-			}
 
+			}
 		}
-	}
+	});
 }
 
 template <class T, size_t R>
-void GLRLMFEATURES2DDMRG<T, R>::calculateRunPercentage2DDMRG(boost::multi_array<T, R> inputMatrix, int depth, float totalSum, int nrNeighbor) {
+void GLRLMFEATURES2DDMRG<T, R>::calculateRunPercentage2DDMRG(const boost::multi_array<T, R> &inputMatrix, int depth, float totalSum, int nrNeighbor) {
 	int totalNrVoxels = 0;
 	for (int depth = 0; depth < inputMatrix.shape()[2];  depth++) {
 		for (int row = 0; row < inputMatrix.shape()[0]; row++) {
@@ -147,7 +151,7 @@ void GLRLMFEATURES2DDMRG<T, R>::calculateRunPercentage2DDMRG(boost::multi_array<
 }
 
 template <class T, size_t R>
-void GLRLMFEATURES2DDMRG<T, R>::calculateAllGLRLMFeatures2DDMRG(GLRLMFEATURES2DDMRG<T, R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<float> spacing, ConfigFile config) {
+void GLRLMFEATURES2DDMRG<T, R>::calculateAllGLRLMFeatures2DDMRG(GLRLMFEATURES2DDMRG<T, R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<float> &spacing, const ConfigFile &config) {
 	this->diffGreyLevels = diffGrey;
 	normGLRLM = config.normGLRLM;
 	actualSpacing = spacing;
@@ -184,13 +188,17 @@ void GLRLMFEATURES2DDMRG<T, R>::calculateAllGLRLMFeatures2DDMRG(GLRLMFEATURES2DD
 	int ang;
 	for (int i = 0; i < 4; i++) {
 		ang = 180 - i * 45;
-		boost::multi_array<float, 2> glrlMatrix = createGLRLMatrix2DDMRG(inputMatrix, ang);
+		ScratchMatrix<float> glrlMatrixBuffer(this->diffGreyLevels.size(), maxRunLength);
+		boost::multi_array<float, 2> &glrlMatrix = glrlMatrixBuffer.get();
+		createGLRLMatrix2DDMRG(inputMatrix, ang, glrlMatrix);
 
 		totalSum = glrlmFeatures.calculateTotalSum(glrlMatrix);
 		rowSums = glrlmFeatures.calculateRowSums(glrlMatrix);
 		colSums = glrlmFeatures.calculateColSums(glrlMatrix);
 
-		boost::multi_array<float, 2> probMatrix = glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum);
+		ScratchMatrix<float> probMatrixBuffer(glrlMatrix.shape()[0], glrlMatrix.shape()[1]);
+		boost::multi_array<float, 2> &probMatrix = probMatrixBuffer.get();
+		glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum, probMatrix);
 		meanGrey = glrlmFeatures.calculateMeanProbGrey(probMatrix);
 		meanRun = glrlmFeatures.calculateMeanProbRun(probMatrix);
 
@@ -280,7 +288,7 @@ void GLRLMFEATURES2DDMRG<T, R>::writeCSVFileGLRLM2DDMRG(GLRLMFEATURES2DDMRG<T, R
 }
 
 template <class T, size_t R>
-void GLRLMFEATURES2DDMRG<T, R>::writeOneFileGLRLM2DDMRG(GLRLMFEATURES2DDMRG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLRLMFEATURES2DDMRG<T, R>::writeOneFileGLRLM2DDMRG(GLRLMFEATURES2DDMRG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
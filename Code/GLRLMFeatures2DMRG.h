@@ -32,9 +32,9 @@ class GLRLMFeatures2DMRG : GLRLMFeatures<T,R>  {
 		vector<float> actualSpacing;
 		string normGLRLM;
 
-        boost::multi_array<float,2> createGLRLMatrixMRG(boost::multi_array<T, R> inputMatrix, int depth);
+        void createGLRLMatrixMRG(const boost::multi_array<T, R> &inputMatrix, int depth, boost::multi_array<float,2> &sum);
         void extractGLRLMDataMRG(vector<T> &glrlmData, GLRLMFeatures2DMRG<T, R> glrlmFeatures);
-        void fill2DMatrices2DMRG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang);
+        void fill2DMatrices2DMRG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang);
 
 
     public:
@@ -42,9 +42,9 @@ class GLRLMFeatures2DMRG : GLRLMFeatures<T,R>  {
 		}
 		~GLRLMFeatures2DMRG() {
 		}
-        void calculateAllGLRLMFeatures2DMRG(GLRLMFeatures2DMRG<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<float> spacing, ConfigFile config);
+        void calculateAllGLRLMFeatures2DMRG(GLRLMFeatures2DMRG<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<float> &spacing, const ConfigFile &config);
         void writeCSVFileGLRLM2DMRG(GLRLMFeatures2DMRG<T,R> glrlmFeat, string outputFolder);
-		void writeOneFileGLRLM2DMRG(GLRLMFeatures2DMRG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr);
+		void writeOneFileGLRLM2DMRG(GLRLMFeatures2DMRG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr);
 
 };
 
@@ -53,25 +53,23 @@ class GLRLMFeatures2DMRG : GLRLMFeatures<T,R>  {
 In the method createGLRLMatrixMRG the GLRLM-matrix for given slice is calculated \n
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
 @param[in] : int depth: number of the actual slice
-@param[out]: GLCM-matrix
+@param[out]: GLRLM-matrix, it has the size number of grey levels x maxRunLength and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float,2> GLRLMFeatures2DMRG<T, R>::createGLRLMatrixMRG(boost::multi_array<T,R> inputMatrix, int depth){
+void GLRLMFeatures2DMRG<T, R>::createGLRLMatrixMRG(const boost::multi_array<T,R> &inputMatrix, int depth, boost::multi_array<float,2> &sum){
 
     int sizeMatrix = this->diffGreyLevels.size();
-    glrlmMat sum(boost::extents[sizeMatrix][maxRunLength]);
     int ang;
 	float weight;
     for(int i = 0; i < 4; i++){
         ang = 180-i*45;
-        glrlmMat GLRLMatrix(boost::extents[sizeMatrix][maxRunLength]);
+        ScratchMatrix<float> GLRLMatrixBuffer(sizeMatrix, maxRunLength);
+        glrlmMat &GLRLMatrix = GLRLMatrixBuffer.get();
         fill2DMatrices2DMRG(inputMatrix, GLRLMatrix, depth, ang);
 		weight = calculateWeight2D(directionX, directionY, normGLRLM, actualSpacing);
 		multSkalarMatrix(GLRLMatrix, weight);
         matrixSum(sum, GLRLMatrix);
     }
-
-    return sum;
 }
 
 /*!
@@ -84,7 +82,9 @@ In the method fill2DMatrices2DMRG the matrix is filled for the given image slice
 The function works analog to the function in GLRLMFeatures2DFullMerge
 */
 template <class T, size_t R>
-void GLRLMFeatures2DMRG<T, R>::fill2DMatrices2DMRG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang){
+void GLRLMFeatures2DMRG<T, R>::fill2DMatrices2DMRG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang){
+	//runs are marked by setting their elements to NAN, this is done in a scratch copy of the actual slice
+	boost::multi_array<T, 2> runSlice = getSliceCopy(inputMatrix, depth);
 
     T actElement = 0;
 	int actGreyIndex;
@@ -92,49 +92,53 @@ void GLRLMFeatures2DMRG<T, R>::fill2DMatrices2DMRG(boost::multi_array<T, R> inpu
     int maxRowNr = inputMatrix.shape()[0];
     int maxColNr = inputMatrix.shape()[1];
     glrlm.getXYDirections(directionX, directionY, ang);
-    //have a look at the image-matrix slide by slide (2D)
-    //look for every grey level separately in every image slide
-    //now look at the image matrix slide by slide
-	for(int row = 0; row<maxRowNr;row++){
-        for(int column = 0; column<maxColNr; column++){
-			//at the beginning the run length =0
-            runLength =0;
-           //get the actual matrix element
-			actElement = inputMatrix[maxRowNr-row-1][column][depth];
-            //if the actual matrix element is the same as the actual gre level
-			if (!isnan(actElement) ){
-				//set the run length to 1
-				runLength = 1;
-				actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
-				//to avoid to take an element more than once, set the element to NAN
-				inputMatrix[maxRowNr - row - 1][column][depth] = NAN;
-				//now look at the matrix element in the actual direction (depends on the
-				//angle we are interested at the moment
-				int colValue = column + directionX;
-				int rowValue = maxRowNr - 1 - (row + directionY);
-				//now have a look at the following elements in the desired direction
-			   //stop as soon as we look at an element diifferent from our actual element
-				while (colValue<maxColNr && rowValue>-1 && colValue > -1 && inputMatrix[rowValue][colValue][depth] == actElement) {
-					//for every element we find, count the runLength
-					runLength += 1;
-					inputMatrix[rowValue][colValue][depth] = NAN;
-					//go further in the desired direction
-					colValue += 1 * directionX;
-					rowValue -= 1 * directionY;
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLRLM2D", depth, ang);
+	TextureMatrixStore::caseStore().fillRunMatrix(matrixKey, inputMatrix, glrlMatrix, depth, -directionY, directionX, 0, [&]() {
+	    //have a look at the image-matrix slide by slide (2D)
+	    //look for every grey level separately in every image slide
+	    //now look at the image matrix slide by slide
+		for(int row = 0; row<maxRowNr;row++){
+	        for(int column = 0; column<maxColNr; column++){
+				//at the beginning the run length =0
+	            runLength =0;
+	           //get the actual matrix element
+				actElement = runSlice[maxRowNr-row-1][column];
+	            //if the actual matrix element is the same as the actual gre level
+				if (!isnan(actElement) ){
+					//set the run length to 1
+					runLength = 1;
+					actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
+					//to avoid to take an element more than once, set the element to NAN
+					runSlice[maxRowNr - row - 1][column] = NAN;
+					//now look at the matrix element in the actual direction (depends on the
+					//angle we are interested at the moment
+					int colValue = column + directionX;
+					int rowValue = maxRowNr - 1 - (row + directionY);
+					//now have a look at the following elements in the desired direction
+				   //stop as soon as we look at an element diifferent from our actual element
+					while (colValue<maxColNr && rowValue>-1 && colValue > -1 && runSlice[rowValue][colValue] == actElement) {
+						//for every element we find, count the runLength
+						runLength += 1;
+						runSlice[rowValue][colValue] = NAN;
+						//go further in the desired direction
+						colValue += 1 * directionX;
+						rowValue -= 1 * directionY;
+					}
 				}
-			}
-            //as soon as we cannot find an element in the desired direction, count one up in the desired
-            //position of the glrl-matrix
-            if(runLength > 0 && runLength < glrlMatrix.shape()[1] + 1){
-				glrlMatrix[actGreyIndex][runLength-1] += 1;
-            }
-       }  
-    }
+	            //as soon as we cannot find an element in the desired direction, count one up in the desired
+	            //position of the glrl-matrix
+	            if(runLength > 0 && runLength < glrlMatrix.shape()[1] + 1){
+					glrlMatrix[actGreyIndex][runLength-1] += 1;
+	            }
+	       }  
+	    }
+	});
 }
 
 
 template <class T, size_t R>
-void GLRLMFeatures2DMRG<T, R>::calculateAllGLRLMFeatures2DMRG(GLRLMFeatures2DMRG<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<float> spacing, ConfigFile config){
+void GLRLMFeatures2DMRG<T, R>::calculateAllGLRLMFeatures2DMRG(GLRLMFeatures2DMRG<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<float> &spacing, const ConfigFile &config){
 
     this->diffGreyLevels = diffGrey;
 
@@ -170,13 +174,17 @@ void GLRLMFeatures2DMRG<T, R>::calculateAllGLRLMFeatures2DMRG(GLRLMFeatures2DMRG
     maxRunLength = glrlm.getMaxRunLength(inputMatrix);
 	glrlmFeatures.getConfigValues(config);
     for(int depth = 0; depth < totalDepth; depth++){
-        boost::multi_array<float,2> glrlMatrix = createGLRLMatrixMRG(inputMatrix, depth);
+        ScratchMatrix<float> glrlMatrixBuffer(this->diffGreyLevels.size(), maxRunLength);
+        boost::multi_array<float,2> &glrlMatrix = glrlMatrixBuffer.get();
+        createGLRLMatrixMRG(inputMatrix, depth, glrlMatrix);
 		
         totalSum = glrlmFeatures.calculateTotalSum(glrlMatrix);
         rowSums = glrlmFeatures.calculateRowSums(glrlMatrix);
         colSums = glrlmFeatures.calculateColSums(glrlMatrix);
 
-        boost::multi_array<float,2> probMatrix = glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum);
+        ScratchMatrix<float> probMatrixBuffer(glrlMatrix.shape()[0], glrlMatrix.shape()[1]);
+        boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+        glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum, probMatrix);
         meanGrey = glrlmFeatures.calculateMeanProbGrey(probMatrix);
         meanRun = glrlmFeatures.calculateMeanProbRun(probMatrix);
 
@@ -278,7 +286,7 @@ void GLRLMFeatures2DMRG<T, R>::writeCSVFileGLRLM2DMRG(GLRLMFeatures2DMRG<T, R> g
 }
 
 template <class T, size_t R>
-void GLRLMFeatures2DMRG<T, R>::writeOneFileGLRLM2DMRG(GLRLMFeatures2DMRG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLRLMFeatures2DMRG<T, R>::writeOneFileGLRLM2DMRG(GLRLMFeatures2DMRG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
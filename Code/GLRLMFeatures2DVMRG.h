@@ -28,7 +28,7 @@ class GLRLMFeatures2DVMRG : GLRLMFeatures<T,R>  {
         vector<float> actualSpacing;
         string normGLRLM;
 		vector<float> emphasisValues;
-        boost::multi_array<float,2> createGLRLMatrixVMRG(boost::multi_array<T, R> inputMatrix, int depth, int ang);
+        void createGLRLMatrixVMRG(const boost::multi_array<T, R> &inputMatrix, int depth, int ang, boost::multi_array<float,2> &GLRLMatrix);
         void extractGLRLMDataVMRG(vector<T> &glrlmData, GLRLMFeatures2DVMRG<T, R> glrlmFeatures);
 
 
@@ -40,10 +40,10 @@ class GLRLMFeatures2DVMRG : GLRLMFeatures<T,R>  {
         float powRow;
         float powCol;
 
-        void calculateAllGLRLMFeatures2DVMRG(GLRLMFeatures2DVMRG<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElem, vector<float> spacing, ConfigFile config);
+        void calculateAllGLRLMFeatures2DVMRG(GLRLMFeatures2DVMRG<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElem, const vector<float> &spacing, const ConfigFile &config);
         void writeCSVFileGLRLM2DVMRG(GLRLMFeatures2DVMRG<T,R> glrlmFeat, string outputFolder);
-        void writeOneFileGLRLM2DVMRG(GLRLMFeatures2DVMRG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr);
-		void fill2DMatrices2DVMRG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang);
+        void writeOneFileGLRLM2DVMRG(GLRLMFeatures2DVMRG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr);
+		void fill2DMatrices2DVMRG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang);
 
 };
 
@@ -53,19 +53,13 @@ In the method createGLRLMatrixFullMerge the GLRLM-matrix for the given angle and
 @param[in]: boost::multi_array<T, 3> inputMatrix: original matrix of the VOI
 @param[in] : int angle: angle that is used to calculate the run length
 @param[in] : int depth: number of the actual slice
-@param[out]: GLCM-matrix
+@param[out]: GLRLM-matrix, it has the size number of grey levels x maxRunLength and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float,2> GLRLMFeatures2DVMRG<T, R>::createGLRLMatrixVMRG(boost::multi_array<T,R> inputMatrix, int depth, int ang){
-    int sizeMatrix = this->diffGreyLevels.size();
+void GLRLMFeatures2DVMRG<T, R>::createGLRLMatrixVMRG(const boost::multi_array<T,R> &inputMatrix, int depth, int ang, boost::multi_array<float,2> &GLRLMatrix){
     glrlm.getXYDirections(directionX, directionY, 180);
 
-    boost::multi_array<float,2> GLRLMatrix(boost::extents[sizeMatrix][maxRunLength]);
-
     fill2DMatrices2DVMRG(inputMatrix, GLRLMatrix, depth, ang);
-
-    return GLRLMatrix;
-
 }
 
 /*!
@@ -83,7 +77,9 @@ for every grey level, the run length is determined \n
 he corresponding element of the GLRLMatrix is increased
 */
 template <class T, size_t R>
-void GLRLMFeatures2DVMRG<T, R>::fill2DMatrices2DVMRG(boost::multi_array<T, R> inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang){
+void GLRLMFeatures2DVMRG<T, R>::fill2DMatrices2DVMRG(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float,2> &glrlMatrix, int depth, int ang){
+	//runs are marked by setting their elements to NAN, this is done in a scratch copy of the actual slice
+	boost::multi_array<T, 2> runSlice = getSliceCopy(inputMatrix, depth);
 
     T actElement = 0;
 	int actGreyIndex;
@@ -91,47 +87,51 @@ void GLRLMFeatures2DVMRG<T, R>::fill2DMatrices2DVMRG(boost::multi_array<T, R> in
     int maxRowNr = inputMatrix.shape()[0];
     int maxColNr = inputMatrix.shape()[1];
     glrlm.getXYDirections(directionX, directionY, ang);
-    //have a look at the image-matrix slide by slide (2D)
-    //now look at the image matrix slide by slide
-	for (int row = 0; row < maxRowNr; row++) {
-		for (int column = 0; column < maxColNr; column++) {
-			//at the beginning the run length =0
-			runLength = 0;
-			//get the actual matrix element
-			actElement = inputMatrix[maxRowNr - row - 1][column][depth];
-			//if the actual matrix element is the same as the actual gre level
-			if (!isnan(actElement)) {
-				//set the run length to 1
-				runLength = 1;
-				//to avoid to take an element more than once, set the element to NAN
-				inputMatrix[maxRowNr - row - 1][column][depth] = NAN;
-				actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
-				//now look at the matrix element in the actual direction (depends on the
-				//angle we are interested at the moment
-				int colValue = column + directionX;
-				int rowValue = maxRowNr - 1 - (row + directionY);
-				//now have a look at the following elements in the desired direction
-				//stop as soon as we look at an element diifferent from our actual element
-				while (colValue<maxColNr && rowValue>-1 && colValue > -1 && inputMatrix[rowValue][colValue][depth] == actElement) {
-					//for every element we find, count the runLength
-					runLength += 1;
-					inputMatrix[rowValue][colValue][depth] = NAN;
-					//go further in the desired direction
-					colValue += 1 * directionX;
-					rowValue -= 1 * directionY;
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLRLM2D", depth, ang);
+	TextureMatrixStore::caseStore().fillRunMatrix(matrixKey, inputMatrix, glrlMatrix, depth, -directionY, directionX, 0, [&]() {
+	    //have a look at the image-matrix slide by slide (2D)
+	    //now look at the image matrix slide by slide
+		for (int row = 0; row < maxRowNr; row++) {
+			for (int column = 0; column < maxColNr; column++) {
+				//at the beginning the run length =0
+				runLength = 0;
+				//get the actual matrix element
+				actElement = runSlice[maxRowNr - row - 1][column];
+				//if the actual matrix element is the same as the actual gre level
+				if (!isnan(actElement)) {
+					//set the run length to 1
+					runLength = 1;
+					//to avoid to take an element more than once, set the element to NAN
+					runSlice[maxRowNr - row - 1][column] = NAN;
+					actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
+					//now look at the matrix element in the actual direction (depends on the
+					//angle we are interested at the moment
+					int colValue = column + directionX;
+					int rowValue = maxRowNr - 1 - (row + directionY);
+					//now have a look at the following elements in the desired direction
+					//stop as soon as we look at an element diifferent from our actual element
+					while (colValue<maxColNr && rowValue>-1 && colValue > -1 && runSlice[rowValue][colValue] == actElement) {
+						//for every element we find, count the runLength
+						runLength += 1;
+						runSlice[rowValue][colValue] = NAN;
+						//go further in the desired direction
+						colValue += 1 * directionX;
+						rowValue -= 1 * directionY;
+					}
+				}
+				//as soon as we cannot find an element in the desired direction, count one up in the desired
+				//position of the glrl-matrix
+				if (runLength > 0 && runLength < glrlMatrix.shape()[1] + 1) {
+					glrlMatrix[actGreyIndex][runLength - 1] += 1;
 				}
-			}
-			//as soon as we cannot find an element in the desired direction, count one up in the desired
-			//position of the glrl-matrix
-			if (runLength > 0 && runLength < glrlMatrix.shape()[1] + 1) {
-				glrlMatrix[actGreyIndex][runLength - 1] += 1;
 			}
 		}
-	}
+	});
 }
 
 template <class T, size_t R>
-void GLRLMFeatures2DVMRG<T, R>::calculateAllGLRLMFeatures2DVMRG(GLRLMFeatures2DVMRG<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElem, vector<float> spacing, ConfigFile config){
+void GLRLMFeatures2DVMRG<T, R>::calculateAllGLRLMFeatures2DVMRG(GLRLMFeatures2DVMRG<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElem, const vector<float> &spacing, const ConfigFile &config){
     this->diffGreyLevels = diffGrey;
 
     actualSpacing = spacing;
@@ -164,13 +164,16 @@ void GLRLMFeatures2DVMRG<T, R>::calculateAllGLRLMFeatures2DVMRG(GLRLMFeatures2DV
 
     maxRunLength = glrlm.getMaxRunLength(inputMatrix);
 
-    boost::multi_array<float, 2> sum(boost::extents[this->diffGreyLevels.size()][maxRunLength]);
+    ScratchMatrix<float> sumBuffer(this->diffGreyLevels.size(), maxRunLength);
+    boost::multi_array<float, 2> &sum = sumBuffer.get();
     float weight;
     int ang;
     for(int depth = 0; depth < totalDepth; depth++){
         for(int i = 0; i < 4; i++){
             ang = 180-i*45;
-            boost::multi_array<float,2> glrlMatrix = glrlmFeatures.createGLRLMatrixVMRG(inputMatrix, depth, ang);
+            ScratchMatrix<float> glrlMatrixBuffer(this->diffGreyLevels.size(), maxRunLength);
+            boost::multi_array<float,2> &glrlMatrix = glrlMatrixBuffer.get();
+            glrlmFeatures.createGLRLMatrixVMRG(inputMatrix, depth, ang, glrlMatrix);
             weight = calculateWeight2D(directionX, directionY, normGLRLM, actualSpacing);
             multSkalarMatrix(glrlMatrix, weight);
             matrixSum(sum, glrlMatrix);
@@ -184,7 +187,9 @@ void GLRLMFeatures2DVMRG<T, R>::calculateAllGLRLMFeatures2DVMRG(GLRLMFeatures2DV
 
     colSums = glrlmFeatures.calculateColSums(sum);
 
-    boost::multi_array<float,2> probMatrix = glrlmFeatures.calculateProbMatrix(sum, totalSum);
+    ScratchMatrix<float> probMatrixBuffer(sum.shape()[0], sum.shape()[1]);
+    boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+    glrlmFeatures.calculateProbMatrix(sum, totalSum, probMatrix);
     meanGrey = glrlmFeatures.calculateMeanProbGrey(probMatrix);
     meanRun = glrlmFeatures.calculateMeanProbRun(probMatrix);
     glrlmFeatures.calculateShortRunEmphasis(rowSums, totalSum);
@@ -230,7 +235,7 @@ void GLRLMFeatures2DVMRG<T, R>::writeCSVFileGLRLM2DVMRG(GLRLMFeatures2DVMRG<T, R
 }
 
 template <class T, size_t R>
-void GLRLMFeatures2DVMRG<T, R>::writeOneFileGLRLM2DVMRG(GLRLMFeatures2DVMRG<T, R> glrlmFeat2D, ConfigFile config, int &parameterSpaceNr) {
+void GLRLMFeatures2DVMRG<T, R>::writeOneFileGLRLM2DVMRG(GLRLMFeatures2DVMRG<T, R> glrlmFeat2D, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -263,8 +268,8 @@ void GLRLMFeatures2DVMRG<T, R>::writeOneFileGLRLM2DVMRG(GLRLMFeatures2DVMRG<T, R
 		featParamSpaceTableName[featParamSpaceTable.size()] = '\0';
 
 		ofstream featSpaceTable;
-		parameterSpaceNr += 1;
 		string parameterSpaceName = "FeatureParameterSpace_" + std::to_string(config.featureParameterSpaceNr);
+		parameterSpaceNr += 1;
 		featSpaceTable.open(featParamSpaceTableName, std::ios_base::app);
 		featSpaceTable << parameterSpaceName << "," << "2Dvmrg" << "," << config.imageSpaceName << "," << config.interpolationMethod << "\n";
 		featSpaceTable.close();
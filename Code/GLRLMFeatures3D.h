@@ -21,17 +21,17 @@ private:
 	vector<float> actualSpacing;
 	string normGLRLM;
 	float totalSum;
-    boost::multi_array<float, 2> createGLRLMatrix3D(boost::multi_array<T, R> inputMatrix);
+    void createGLRLMatrix3D(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &sum);
     void extractGLRLMData3D(vector<T> &glrlmData, GLRLMFeatures3D<T, R> glrlmFeatures);
-    void fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ);
+    void fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ);
     int maxRunLength;
     int totalNrVoxels;
 public:
 	GLRLMFeatures3D(){}
 	~GLRLMFeatures3D(){}
-    void calculateAllGLRLMFeatures3D(GLRLMFeatures3D<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElem, vector<float> spacing, ConfigFile config);
+    void calculateAllGLRLMFeatures3D(GLRLMFeatures3D<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElem, const vector<float> &spacing, const ConfigFile &config);
     void writeCSVFileGLRLM3D(GLRLMFeatures3D<T,R> glrlmFeat, string outputFolder);
-	void writeOneFileGLRLM3D(GLRLMFeatures3D<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileGLRLM3D(GLRLMFeatures3D<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr);
 
 };
 
@@ -46,111 +46,117 @@ The method getNeighbors3D stores all neighbor pairs for the desired angle and th
 The direction-parameters determine in which direction the run length is calculated
 */
 template <class T, size_t R>
-void GLRLMFeatures3D<T, R>::fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ){
-	float actGreyLevel = 0;
-	float actElement = 0;
-    int runLength=0;
-    int maxRowNr = inputMatrix.shape()[0];
-    int maxColNr = inputMatrix.shape()[1];
-    int maxDepth = inputMatrix.shape()[2];
-    //have a look at the image-matrix slide by slide (2D)
-    //look for every grey level separately in every image slide
-    for(int actGreyIndex=0; actGreyIndex<this->diffGreyLevels.size(); actGreyIndex++){
-        //get the grey level we are interested at the moment
-        actGreyLevel = this->diffGreyLevels[actGreyIndex];
-        //now look at the image matrix slide by slide
-        for(int depth = 0; depth < maxDepth; depth++){
-            for(int row = 0; row < maxRowNr; row++){
-                for(int column = 0; column < maxColNr; column++){
-//                  //at the beginning the run length =0
-                    runLength = 0;
-                    //get the actual matrix element
-                    int actDepth;
-                    if(directionZ > 0){
-                        actDepth = depth;
-                    }
-                    else{
-                        actDepth = maxDepth - depth -1;
-                    }
-                    int actRow;
-                    if(directionY < 0){
-                        actRow = maxRowNr-row-1;
-                    }
-                    else{
-                        actRow = row;
-                    }
-                    actElement = inputMatrix[actRow][column][actDepth];
-                    //if the actual matrix element is the same as the actual gre level
-                    if(actElement == actGreyLevel){
-                        //set the run length to 1
-                        runLength = 1;
-                        //to avoid to take an element more than once, set the element to NAN
-                        inputMatrix[actRow][column][actDepth] = NAN;
-                        //now look at the matrix element in the actual direction (depends on the
-                        //angle we are interested at the moment
-                        int colValue = column + directionX;
-                        int rowValue = actRow + directionY;
-                        int depthValue = actDepth + directionZ;
-                        //now have a look at the following elements in the desired direction
-                        //stop as soon as we look at an element diifferent from our actual element
-                        while(colValue < maxColNr && rowValue > -1 && rowValue < maxRowNr && colValue > -1 && depthValue < maxDepth && depthValue > -1 && inputMatrix[rowValue][colValue][depthValue] == actGreyLevel ){
-                            //for every element we find, count the runLength
-                            runLength += 1;
-                            inputMatrix[rowValue][colValue][depthValue]=NAN;
-                            //go further in the desired direction
-                            colValue += directionX;
-                            rowValue += directionY;
-
-                            depthValue += directionZ;
-                      }
-                   }
-                   //as soon as we cannot find an element in the desired direction, count one up in the desired
-                   //position of the glrl-matrix
-                    if(runLength > 0 && runLength < maxRunLength+1){
-                        glrlMatrix[actGreyIndex][runLength-1]+=1;
-                    }
-                }
-            }
-        }
-    }
+void GLRLMFeatures3D<T, R>::fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ){
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLRLM3D", directionX, directionY, directionZ);
+	TextureMatrixStore::caseStore().fillRunMatrix(matrixKey, inputMatrix, glrlMatrix, -1, directionY, directionX, directionZ, [&]() {
+		//runs are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+		boost::multi_array<T, R> runMatrix = inputMatrix;
+		float actGreyLevel = 0;
+		float actElement = 0;
+	    int runLength=0;
+	    int maxRowNr = runMatrix.shape()[0];
+	    int maxColNr = runMatrix.shape()[1];
+	    int maxDepth = runMatrix.shape()[2];
+	    //have a look at the image-matrix slide by slide (2D)
+	    //look for every grey level separately in every image slide
+	    for(int actGreyIndex=0; actGreyIndex<this->diffGreyLevels.size(); actGreyIndex++){
+	        //get the grey level we are interested at the moment
+	        actGreyLevel = this->diffGreyLevels[actGreyIndex];
+	        //now look at the image matrix slide by slide
+	        for(int depth = 0; depth < maxDepth; depth++){
+	            for(int row = 0; row < maxRowNr; row++){
+	                for(int column = 0; column < maxColNr; column++){
+	//                  //at the beginning the run length =0
+	                    runLength = 0;
+	                    //get the actual matrix element
+	                    int actDepth;
+	                    if(directionZ > 0){
+	                        actDepth = depth;
+	                    }
+	                    else{
+	                        actDepth = maxDepth - depth -1;
+	                    }
+	                    int actRow;
+	                    if(directionY < 0){
+	                        actRow = maxRowNr-row-1;
+	                    }
+	                    else{
+	                        actRow = row;
+	                    }
+	                    actElement = runMatrix[actRow][column][actDepth];
+	                    //if the actual matrix element is the same as the actual gre level
+	                    if(actElement == actGreyLevel){
+	                        //set the run length to 1
+	                        runLength = 1;
+	                        //to avoid to take an element more than once, set the element to NAN
+	                        runMatrix[actRow][column][actDepth] = NAN;
+	                        //now look at the matrix element in the actual direction (depends on the
+	                        //angle we are interested at the moment
+	                        int colValue = column + directionX;
+	                        int rowValue = actRow + directionY;
+	                        int depthValue = actDepth + directionZ;
+	                        //now have a look at the following elements in the desired direction
+	                        //stop as soon as we look at an element diifferent from our actual element
+	                        while(colValue < maxColNr && rowValue > -1 && rowValue < maxRowNr && colValue > -1 && depthValue < maxDepth && depthValue > -1 && runMatrix[rowValue][colValue][depthValue] == actGreyLevel ){
+	                            //for every element we find, count the runLength
+	                            runLength += 1;
+	                            runMatrix[rowValue][colValue][depthValue]=NAN;
+	                            //go further in the desired direction
+	                            colValue += directionX;
+	                            rowValue += directionY;
+
+	                            depthValue += directionZ;
+	                      }
+	                   }
+	                   //as soon as we cannot find an element in the desired direction, count one up in the desired
+	                   //position of the glrl-matrix
+	                    if(runLength > 0 && runLength < maxRunLength+1){
+	                        glrlMatrix[actGreyIndex][runLength-1]+=1;
+	                    }
+	                }
+	            }
+	        }
+	    }
+	});
 }
 
 
 /*!
 The method createGLRLMatrix3D sums up all matrices of the different directions
 @param[in] inputMatrix: the original matrix of the VOI
+@param[out] sum: summed GLRLM-matrix, it has the size number of grey levels x maxRunLength and is set to 0
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLRLMFeatures3D<T, R>::createGLRLMatrix3D(boost::multi_array<T,R> inputMatrix){
+void GLRLMFeatures3D<T, R>::createGLRLMatrix3D(const boost::multi_array<T,R> &inputMatrix, boost::multi_array<float, 2> &sum){
     typedef boost::multi_array<float, 2> glrlmat;
 
     int directionX;
     int directionY;
     int directionZ;;
 
-    maxRunLength = glrlm.getMaxRunLength(inputMatrix);
     int sizeMatrix = this->diffGreyLevels.size();
-    glrlmat GLRLMatrix(boost::extents[sizeMatrix][maxRunLength]);
-    glrlmat sum(boost::extents[sizeMatrix][maxRunLength]);
 	float weight;
     for(int i = 0; i < 13; i++){
         glrlm3D.getXYdirections3D(directionX, directionY, directionZ, i);
-        glrlmat GLRLMatrix(boost::extents[sizeMatrix][maxRunLength]);
+        ScratchMatrix<float> GLRLMatrixBuffer(sizeMatrix, maxRunLength);
+        glrlmat &GLRLMatrix = GLRLMatrixBuffer.get();
         fill3DMatrices(inputMatrix, GLRLMatrix, directionX, directionY, directionZ);
 		weight = calculateWeight3D(directionX, directionY, directionZ, normGLRLM, actualSpacing);
 		multSkalarMatrix(GLRLMatrix, weight);
 		matrixSum(sum, GLRLMatrix);
     }
-
-    return sum;
 }
 
 template <class T, size_t R>
-void GLRLMFeatures3D<T, R>::calculateAllGLRLMFeatures3D(GLRLMFeatures3D<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElement, vector<float> spacing, ConfigFile config){
+void GLRLMFeatures3D<T, R>::calculateAllGLRLMFeatures3D(GLRLMFeatures3D<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElement, const vector<float> &spacing, const ConfigFile &config){
     this->diffGreyLevels = diffGrey;
 	actualSpacing = spacing;
 	normGLRLM = config.normGLRLM;
-	boost::multi_array<float,2> glrlMatrix = glrlmFeatures.createGLRLMatrix3D(inputMatrix);
+	maxRunLength = glrlm.getMaxRunLength(inputMatrix);
+	ScratchMatrix<float> glrlMatrixBuffer(this->diffGreyLevels.size(), maxRunLength);
+	boost::multi_array<float,2> &glrlMatrix = glrlMatrixBuffer.get();
+	glrlmFeatures.createGLRLMatrix3D(inputMatrix, glrlMatrix);
 	glrlmFeatures.getConfigValues(config);
     totalSum=glrlmFeatures.calculateTotalSum(glrlMatrix);
     vector<float> rowSums =glrlmFeatures.calculateRowSums(glrlMatrix);
@@ -168,7 +174,9 @@ void GLRLMFeatures3D<T, R>::calculateAllGLRLMFeatures3D(GLRLMFeatures3D<T,R> &gl
     glrlmFeatures.calculateRunLengthNonUniformityNorm(rowSums, totalSum);
     glrlmFeatures.calculateRunLengthNonUniformity(rowSums, totalSum);
     glrlmFeatures.calculateRunPercentage3D(vectorMatrElement, totalSum, 13);
-    boost::multi_array<float,2> probMatrix = glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum);
+    ScratchMatrix<float> probMatrixBuffer(glrlMatrix.shape()[0], glrlMatrix.shape()[1]);
+    boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+    glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum, probMatrix);
 	float meanGrey = glrlmFeatures.calculateMeanProbGrey(probMatrix);
 
     glrlmFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
@@ -227,7 +235,7 @@ void GLRLMFeatures3D<T, R>::writeCSVFileGLRLM3D(GLRLMFeatures3D<T,R> glrlmFeat,
 
 
 template <class T, size_t R>
-void GLRLMFeatures3D<T, R>::writeOneFileGLRLM3D(GLRLMFeatures3D<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLRLMFeatures3D<T, R>::writeOneFileGLRLM3D(GLRLMFeatures3D<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -16,11 +16,11 @@ class GLRLMFeatures3DAVG : GLRLMFeatures<T,R>{
 private:
     GLRLMFeatures<T,R> glrlm;
     double totalSum;
-    boost::multi_array<float, 2> createGLRLMatrix3D(boost::multi_array<T, R> inputMatrix, int ang);
+    void createGLRLMatrix3D(const boost::multi_array<T, R> &inputMatrix, int ang, boost::multi_array<float, 2> &GLRLMatrix);
     void extractGLRLMData3D(vector<T> &glrlmData, GLRLMFeatures3DAVG<T, R> glrlmFeatures);
 
-    void fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ);
-    void getMaxRunLength3D(boost::multi_array<T, R> inputMatrix);
+    void fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ);
+    void getMaxRunLength3D(const boost::multi_array<T, R> &inputMatrix);
     int maxRunLength;
 
     int totalNrVoxels;
@@ -28,96 +28,102 @@ private:
 public:
 	GLRLMFeatures3DAVG(){}
 	~GLRLMFeatures3DAVG(){}
-    void calculateAllGLRLMFeatures3DAVG(GLRLMFeatures3DAVG<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElem, ConfigFile config);
+    void calculateAllGLRLMFeatures3DAVG(GLRLMFeatures3DAVG<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElem, const ConfigFile &config);
     void writeCSVFileGLRLM3DAVG(GLRLMFeatures3DAVG<T,R> glrlmFeat, string outputFolder);
-	void writeOneFileGLRLM3DAVG(GLRLMFeatures3DAVG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileGLRLM3DAVG(GLRLMFeatures3DAVG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr);
     void getXYdirections3D(int &directionX, int &directionY, int &directionZ, int ang);
 
 };
 
 template <class T, size_t R>
-void GLRLMFeatures3DAVG<T, R>::getMaxRunLength3D(boost::multi_array<T, R> inputMatrix){
+void GLRLMFeatures3DAVG<T, R>::getMaxRunLength3D(const boost::multi_array<T, R> &inputMatrix){
     int tempMax = std::max(inputMatrix.shape()[0], inputMatrix.shape()[1]);
     maxRunLength = std::max(tempMax, int(inputMatrix.shape()[2]));
 }
 
 //fill now the GLRLMatrices with the right values
 template <class T, size_t R>
-void GLRLMFeatures3DAVG<T, R>::fill3DMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ){
-     double actGreyLevel = 0;
-    double actElement = 0;
-    int runLength=0;
-    int maxRowNr = inputMatrix.shape()[0];
-    int maxColNr = inputMatrix.shape()[1];
-    int maxDepth = inputMatrix.shape()[2];
-    //have a look at the image-matrix slide by slide (2D)
-    //look for every grey level separately in every image slide
-    for(int actGreyIndex=0; actGreyIndex<this->diffGreyLevels.size(); actGreyIndex++){
-        //get the grey level we are interested at the moment
-        actGreyLevel = this->diffGreyLevels[actGreyIndex];
-        //now look at the image matrix slide by slide
-        for(int depth = 0; depth < maxDepth; depth++){
-            for(int row = 0; row < maxRowNr;row++){
-                for(int column = 0; column < maxColNr; column++){
-
-//                  //at the beginning the run length =0
-                    runLength =0;
-                    //get the actual matrix element
-                    int actDepth;
-                    if(directionZ >0){
-                        actDepth = depth;
-                    }
-                    else{
-                        actDepth = maxDepth - depth -1;
-
-                    }
-                    int actRow;
-                    if(directionY < 0){
-                        actRow = maxRowNr-row-1;
-                    }
-                    else{
-                        actRow = row;
-                    }
-                    actElement = inputMatrix[actRow][column][actDepth];
-
-                    //if the actual matrix element is the same as the actual gre level
-                    if(actElement == actGreyLevel){
-                        //set the run length to 1
-                        runLength = 1;
-
-                        //to avoid to take an element more than once, set the element to NAN
-                        inputMatrix[actRow][column][actDepth] = NAN;
-
-////                    //now look at the matrix element in the actual direction (depends on the
-                        //angle we are interested at the moment
-                        int colValue = column + directionX;
-                        int rowValue = actRow + directionY;
-
-
-                        int depthValue = actDepth + directionZ;
-
-                        //now have a look at the following elements in the desired direction
-                        //stop as soon as we look at an element diifferent from our actual element
-                        while(colValue < maxColNr && rowValue > -1 && rowValue < maxRowNr && colValue > -1 && depthValue < maxDepth && depthValue > -1 && inputMatrix[rowValue][colValue][depthValue] == actGreyLevel ){
-                            //for every element we find, count the runLength
-                            runLength += 1;
-                            inputMatrix[rowValue][colValue][depthValue]=NAN;
-                            //go further in the desired direction
-                            colValue +=1*directionX;
-                            rowValue +=1*directionY;
-
-                            depthValue +=1*directionZ;
-                      }
-                   }
-                   //as soon as we cannot find an element in the desired direction, count one up in the desired
-                   //position of the glrl-matrix
-                    if(runLength>0&&runLength<maxRunLength+1){
-                        glrlMatrix[actGreyIndex][runLength-1]+=1;
-                    }
-                }
-            }
-        }
-    }
+void GLRLMFeatures3DAVG<T, R>::fill3DMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glrlMatrix, int directionX, int directionY, int directionZ){
+	//the counts are taken from the texture matrix store if they were stored before
+	string matrixKey = getTextureMatrixKey("GLRLM3D", directionX, directionY, directionZ);
+	TextureMatrixStore::caseStore().fillRunMatrix(matrixKey, inputMatrix, glrlMatrix, -1, directionY, directionX, directionZ, [&]() {
+		//runs are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+		boost::multi_array<T, R> runMatrix = inputMatrix;
+	     double actGreyLevel = 0;
+	    double actElement = 0;
+	    int runLength=0;
+	    int maxRowNr = runMatrix.shape()[0];
+	    int maxColNr = runMatrix.shape()[1];
+	    int maxDepth = runMatrix.shape()[2];
+	    //have a look at the image-matrix slide by slide (2D)
+	    //look for every grey level separately in every image slide
+	    for(int actGreyIndex=0; actGreyIndex<this->diffGreyLevels.size(); actGreyIndex++){
+	        //get the grey level we are interested at the moment
+	        actGreyLevel = this->diffGreyLevels[actGreyIndex];
+	        //now look at the image matrix slide by slide
+	        for(int depth = 0; depth < maxDepth; depth++){
+	            for(int row = 0; row < maxRowNr;row++){
+	                for(int column = 0; column < maxColNr; column++){
+
+	//                  //at the beginning the run length =0
+	                    runLength =0;
+	                    //get the actual matrix element
+	                    int actDepth;
+	                    if(directionZ >0){
+	                        actDepth = depth;
+	                    }
+	                    else{
+	                        actDepth = maxDepth - depth -1;
+
+	                    }
+	                    int actRow;
+	                    if(directionY < 0){
+	                        actRow = maxRowNr-row-1;
+	                    }
+	                    else{
+	                        actRow = row;
+	                    }
+	                    actElement = runMatrix[actRow][column][actDepth];
+
+	                    //if the actual matrix element is the same as the actual gre level
+	                    if(actElement == actGreyLevel){
+	                        //set the run length to 1
+	                        runLength = 1;
+
+	                        //to avoid to take an element more than once, set the element to NAN
+	                        runMatrix[actRow][column][actDepth] = NAN;
+
+	////                    //now look at the matrix element in the actual direction (depends on the
+	                        //angle we are interested at the moment
+	                        int colValue = column + directionX;
+	                        int rowValue = actRow + directionY;
+
+
+	                        int depthValue = actDepth + directionZ;
+
+	                        //now have a look at the following elements in the desired direction
+	                        //stop as soon as we look at an element diifferent from our actual element
+	                        while(colValue < maxColNr && rowValue > -1 && rowValue < maxRowNr && colValue > -1 && depthValue < maxDepth && depthValue > -1 && runMatrix[rowValue][colValue][depthValue] == actGreyLevel ){
+	                            //for every element we find, count the runLength
+	                            runLength += 1;
+	                            runMatrix[rowValue][colValue][depthValue]=NAN;
+	                            //go further in the desired direction
+	                            colValue +=1*directionX;
+	                            rowValue +=1*directionY;
+
+	                            depthValue +=1*directionZ;
+	                      }
+	                   }
+	                   //as soon as we cannot find an element in the desired direction, count one up in the desired
+	                   //position of the glrl-matrix
+	                    if(runLength>0&&runLength<maxRunLength+1){
+	                        glrlMatrix[actGreyIndex][runLength-1]+=1;
+	                    }
+	                }
+	            }
+	        }
+	    }
+	});
 }
 
 template <class T, size_t R>
@@ -190,35 +196,19 @@ void GLRLMFeatures3DAVG<T, R>::getXYdirections3D(int &directionX, int &direction
 
 }
 
-//create the GLRL-matrices for all the angles
+//create the GLRL-matrix for one angle, the matrix has the size number of grey levels x maxRunLength and is set to 0
 template <class T, size_t R>
-boost::multi_array<float, 2> GLRLMFeatures3DAVG<T, R>::createGLRLMatrix3D(boost::multi_array<T,R> inputMatrix, int ang){
-    typedef boost::multi_array<float, 2> glrlmat;
-
+void GLRLMFeatures3DAVG<T, R>::createGLRLMatrix3D(const boost::multi_array<T,R> &inputMatrix, int ang, boost::multi_array<float, 2> &GLRLMatrix){
     int directionX;
     int directionY;
     int directionZ;
 
-
-//    define the glcMatrices
-//
-//    fill the 2D Matrices
-    getMaxRunLength3D(inputMatrix);
-    int sizeMatrix = this->diffGreyLevels.size();
-
-    glrlmat GLRLMatrix(boost::extents[sizeMatrix][maxRunLength]);
-    glrlmat sum(boost::extents[sizeMatrix][maxRunLength]);
-
     getXYdirections3D(directionX, directionY, directionZ, ang);
     fill3DMatrices(inputMatrix, GLRLMatrix, directionX, directionY, directionZ);
-
-
-    return GLRLMatrix;
-
 }
 
 template <class T, size_t R>
-void GLRLMFeatures3DAVG<T, R>::calculateAllGLRLMFeatures3DAVG(GLRLMFeatures3DAVG<T,R> &glrlmFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElem, ConfigFile config){
+void GLRLMFeatures3DAVG<T, R>::calculateAllGLRLMFeatures3DAVG(GLRLMFeatures3DAVG<T,R> &glrlmFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElem, const ConfigFile &config){
     this->diffGreyLevels = diffGrey;
 	glrlmFeatures.getConfigValues(config);
 
@@ -249,16 +239,19 @@ void GLRLMFeatures3DAVG<T, R>::calculateAllGLRLMFeatures3DAVG(GLRLMFeatures3DAVG
     int directionZ = -1;
 
 
+    getMaxRunLength3D(inputMatrix);
     for(int i = 0; i < 13; i++){
-
-
-        boost::multi_array<float,2> glrlMatrix = createGLRLMatrix3D(inputMatrix, i);
+        ScratchMatrix<float> glrlMatrixBuffer(this->diffGreyLevels.size(), maxRunLength);
+        boost::multi_array<float,2> &glrlMatrix = glrlMatrixBuffer.get();
+        createGLRLMatrix3D(inputMatrix, i, glrlMatrix);
 
         totalSum = glrlmFeatures.calculateTotalSum(glrlMatrix);
         rowSums = glrlmFeatures.calculateRowSums(glrlMatrix);
         colSums = glrlmFeatures.calculateColSums(glrlMatrix);
 
-        boost::multi_array<float,2> probMatrix = glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum);
+        ScratchMatrix<float> probMatrixBuffer(glrlMatrix.shape()[0], glrlMatrix.shape()[1]);
+        boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+        glrlmFeatures.calculateProbMatrix(glrlMatrix, totalSum, probMatrix);
         meanGrey = glrlmFeatures.calculateMeanProbGrey(probMatrix);
         meanRun = glrlmFeatures.calculateMeanProbRun(probMatrix);
 
@@ -364,7 +357,7 @@ void GLRLMFeatures3DAVG<T, R>::writeCSVFileGLRLM3DAVG(GLRLMFeatures3DAVG<T,R> gl
 
 
 template <class T, size_t R>
-void GLRLMFeatures3DAVG<T, R>::writeOneFileGLRLM3DAVG(GLRLMFeatures3DAVG<T, R> glrlmFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLRLMFeatures3DAVG<T, R>::writeOneFileGLRLM3DAVG(GLRLMFeatures3DAVG<T, R> glrlmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -399,8 +392,8 @@ void GLRLMFeatures3DAVG<T, R>::writeOneFileGLRLM3DAVG(GLRLMFeatures3DAVG<T, R> g
 
 		ofstream featSpaceTable;
 		featSpaceTable.open(featParamSpaceTableName, std::ios_base::app);
-		parameterSpaceNr += 1;
 		string parameterSpaceName = "FeatureParameterSpace_" + std::to_string(config.featureParameterSpaceNr);
+		parameterSpaceNr += 1;
 		featSpaceTable << parameterSpaceName << "," << "3DAVG" << "," << config.imageSpaceName << "," << config.interpolationMethod << "\n";
 		featSpaceTable.close();
 
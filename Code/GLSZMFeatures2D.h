@@ -24,9 +24,9 @@ class GLSZMFeatures2DMRG : public GLRLMFeatures<T, R>{
 		vector<float> rowSums;
 		vector<float> colSums;
 		GLRLMFeatures<T, R> glrlm;
-		int getBiggestZoneNr(boost::multi_array<T, R> inputMatrix);
-		boost::multi_array<float, 2> getGLSZMMatrix(boost::multi_array<T, R> inputMatrix);
-        void fill2DGLSZMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix);
+		int getBiggestZoneNr(const boost::multi_array<T, R> &inputMatrix);
+		void getGLSZMMatrix(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &GLSZMatrix);
+        void fill2DGLSZMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix);
 		void extractGLSZMData(vector<T> &GLSZMData, GLSZMFeatures2DMRG<T, R> GLSZMFeatures);
 
     public:
@@ -35,9 +35,9 @@ class GLSZMFeatures2DMRG : public GLRLMFeatures<T, R>{
 		void defineGLSZMFeaturesOntology(vector<string> &features);
         void getNeighbors(boost::multi_array<T, R> &inputMatrix, T actElement, vector<vector< int> > &matrixIndices);
         void getALLXYDirections(int &directionX, int &directionY, int angle);
-        void calculateAllGLSZMFeatures2DMRG(GLSZMFeatures2DMRG<T,R> &GLSZMFeat, boost::multi_array<T,R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElem, ConfigFile config);
+        void calculateAllGLSZMFeatures2DMRG(GLSZMFeatures2DMRG<T,R> &GLSZMFeat, const boost::multi_array<T,R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElem, const ConfigFile &config);
         void writeCSVFileGLSZM(GLSZMFeatures2DMRG<T,R> GLSZMFeat, string outputFolder);
-		void writeOneFileGLSZM(GLSZMFeatures2DMRG<T, R> GLSZMFeat, ConfigFile config, int &parameterSpaceNr);
+		void writeOneFileGLSZM(GLSZMFeatures2DMRG<T, R> GLSZMFeat, const ConfigFile &config, int &parameterSpaceNr);
 
 };
 
@@ -53,7 +53,9 @@ of a neighborhood, it is set to NAN.\n
 The size of the neighborhoods are stored in the matrix.
 */
 template <class T, size_t R>
-void GLSZMFeatures2DMRG<T, R>::fill2DGLSZMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &GLSZMatrix){
+void GLSZMFeatures2DMRG<T, R>::fill2DGLSZMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &GLSZMatrix){
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
 	T actElement;
 	vector<vector<int> > matrixIndices;
 	vector<int> actualIndex;
@@ -63,19 +65,19 @@ void GLSZMFeatures2DMRG<T, R>::fill2DGLSZMatrices(boost::multi_array<T, R> input
 	//go element by element through the image
 	//look at the neighbors of every element and check if they have the same grey value
 	//set every element already seen to NAN
-	for (int depth = 0; depth<inputMatrix.shape()[2]; depth++) {
-		for (int row = 0; row<inputMatrix.shape()[0]; row++) {
-			for (int col = 0; col<inputMatrix.shape()[1]; col++) {
-				actElement = inputMatrix[row][col][depth];
+	for (int depth = 0; depth<zoneMatrix.shape()[2]; depth++) {
+		for (int row = 0; row<zoneMatrix.shape()[0]; row++) {
+			for (int col = 0; col<zoneMatrix.shape()[1]; col++) {
+				actElement = zoneMatrix[row][col][depth];
 				if (!isnan(actElement)) {
 					actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actElement);
-					inputMatrix[row][col][depth] = NAN;
+					zoneMatrix[row][col][depth] = NAN;
 					actualIndex.push_back(row);
 					actualIndex.push_back(col);
 					actualIndex.push_back(depth);
 					matrixIndices.push_back(actualIndex);
 					actualIndex.clear();
-					getNeighbors(inputMatrix, actElement, matrixIndices);
+					getNeighbors(zoneMatrix, actElement, matrixIndices);
 				}
 				//the number of the voxels of the actual zone 
 				tempZoneSize = matrixIndices.size();
@@ -107,7 +109,9 @@ It gets the zone sizes for every intensity value and compares them \n
 The biggest zone size is stored in the int value maxZoneNumber
 */
 template <class T, size_t R>
-int GLSZMFeatures2DMRG<T, R>::getBiggestZoneNr(boost::multi_array<T, R> inputMatrix){
+int GLSZMFeatures2DMRG<T, R>::getBiggestZoneNr(const boost::multi_array<T, R> &inputMatrix){
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
 	T actualElement;
 	vector<vector<int> > matrixIndices;
 	vector<int> actualIndex;
@@ -116,19 +120,19 @@ int GLSZMFeatures2DMRG<T, R>::getBiggestZoneNr(boost::multi_array<T, R> inputMat
 	int actualGreyIndex;
 	//calculate biggest zone for every intensity value
 		//get the neighbors for every element in the matrix
-		for (int depth = 0; depth<inputMatrix.shape()[2]; depth++) {
-			for (int row = 0; row<inputMatrix.shape()[0]; row++) {
-				for (int col = 0; col<inputMatrix.shape()[1]; col++) {
-					actualElement = inputMatrix[row][col][depth];
+		for (int depth = 0; depth<zoneMatrix.shape()[2]; depth++) {
+			for (int row = 0; row<zoneMatrix.shape()[0]; row++) {
+				for (int col = 0; col<zoneMatrix.shape()[1]; col++) {
+					actualElement = zoneMatrix[row][col][depth];
 					if (!isnan(actualElement)) {
 						actualGreyIndex = findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actualElement);
-						inputMatrix[row][col][depth] = NAN;
+						zoneMatrix[row][col][depth] = NAN;
 						actualIndex.push_back(row);
 						actualIndex.push_back(col);
 						actualIndex.push_back(depth);
 						matrixIndices.push_back(actualIndex);
 						actualIndex.clear();
-						getNeighbors(inputMatrix, actualElement, matrixIndices);
+						getNeighbors(zoneMatrix, actualElement, matrixIndices);
 					}
 				}
 				//the number of the voxels of the actual zone 
@@ -244,33 +248,27 @@ void GLSZMFeatures2DMRG<T, R>::getALLXYDirections(int &directionX, int &directio
 /*!
 In the method getGLSZMMatrix the GLSZM matrices with the right size are generated and filled using the fill2DGLSZM function.
 @param[in] inputMatrix: the original matrix of the VOI
-@param[out]: filled GLSZM
+@param[out] GLSZMatrix: filled GLSZM, it has the size number of grey levels x maxZoneSize and is set to 0
 
-This function only initiates a GLSZM with the right size.
+Afterwards maxZoneSize is the size of the biggest zone.
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLSZMFeatures2DMRG<T,R>::getGLSZMMatrix( boost::multi_array<T, R> inputMatrix){
-    typedef boost::multi_array<float, 2>  GLSZMat;
-    //maxZoneSize=getBiggestZoneNr(inputMatrix);
-	maxZoneSize = inputMatrix.shape()[0] * inputMatrix.shape()[1];
-    int sizeMatrix= (this->diffGreyLevels).size();
-    GLSZMat GLSZMatrix(boost::extents[sizeMatrix][maxZoneSize]);
+void GLSZMFeatures2DMRG<T,R>::getGLSZMMatrix( const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &GLSZMatrix){
     fill2DGLSZMatrices(inputMatrix, GLSZMatrix);
-
-	GLSZMat smallGLSZM(boost::extents[sizeMatrix][maxZoneSize]);
-	for (int row = 0; row < sizeMatrix; row++) {
-		for (int col = 0; col < maxZoneSize; col++) {
-			smallGLSZM[row][col] = GLSZMatrix[row][col];
-		}
-	}
-    return smallGLSZM;
 }
 
 template <class T, size_t R>
-void GLSZMFeatures2DMRG<T, R>::calculateAllGLSZMFeatures2DMRG(GLSZMFeatures2DMRG<T,R> &GLSZMFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, vector<T> vectorMatrElem, ConfigFile config){
+void GLSZMFeatures2DMRG<T, R>::calculateAllGLSZMFeatures2DMRG(GLSZMFeatures2DMRG<T,R> &GLSZMFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const vector<T> &vectorMatrElem, const ConfigFile &config){
 	this->diffGreyLevels = diffGrey;
 	GLSZMFeatures.getConfigValues(config);
-	boost::multi_array<float, 2> GLSZM = GLSZMFeatures.getGLSZMMatrix(inputMatrix);
+	//maxZoneSize=getBiggestZoneNr(inputMatrix);
+	maxZoneSize = inputMatrix.shape()[0] * inputMatrix.shape()[1];
+	ScratchMatrix<float> fullGLSZMBuffer(this->diffGreyLevels.size(), maxZoneSize);
+	GLSZMFeatures.getGLSZMMatrix(inputMatrix, fullGLSZMBuffer.get());
+	//the matrix is cut to the biggest zone, maxZoneSize is set while the matrix is filled
+	ScratchMatrix<float> GLSZMBuffer(this->diffGreyLevels.size(), maxZoneSize);
+	boost::multi_array<float, 2> &GLSZM = GLSZMBuffer.get();
+	copyColumns(fullGLSZMBuffer.get(), GLSZM);
 
 	float totalSum = GLSZMFeatures.calculateTotalSum(GLSZM);
 
@@ -290,7 +288,9 @@ void GLSZMFeatures2DMRG<T, R>::calculateAllGLSZMFeatures2DMRG(GLSZMFeatures2DMRG
 	GLSZMFeatures.calculateRunLengthNonUniformityNorm(rowSums, totalSum);
 	GLSZMFeatures.calculateRunLengthNonUniformity(rowSums, totalSum);
 	GLSZMFeatures.calculateRunPercentage3D(vectorMatrElem, totalSum, 1);
-	boost::multi_array<float, 2> probMatrix = GLSZMFeatures.calculateProbMatrix(GLSZM, totalSum);
+	ScratchMatrix<float> probMatrixBuffer(GLSZM.shape()[0], GLSZM.shape()[1]);
+	boost::multi_array<float, 2> &probMatrix = probMatrixBuffer.get();
+	GLSZMFeatures.calculateProbMatrix(GLSZM, totalSum, probMatrix);
 	float meanGrey = GLSZMFeatures.calculateMeanProbGrey(probMatrix);
 
 	GLSZMFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
@@ -343,7 +343,7 @@ void GLSZMFeatures2DMRG<T, R>::writeCSVFileGLSZM(GLSZMFeatures2DMRG<T,R> GLSZMFe
 }
 
 template <class T, size_t R>
-void GLSZMFeatures2DMRG<T, R>::writeOneFileGLSZM(GLSZMFeatures2DMRG<T, R> GLSZMFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLSZMFeatures2DMRG<T, R>::writeOneFileGLSZM(GLSZMFeatures2DMRG<T, R> GLSZMFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -22,9 +22,9 @@ class  GLSZMFeatures2DAVG : public GLSZMFeatures2DMRG<T, R>{
         void extractGLSZMData(vector<T> &GLSZMData, GLSZMFeatures2DAVG<T, R> GLSZMFeatures);
 		GLSZMFeatures2DMRG<T, R> glszm2D;
 		GLRLMFeatures<T, R> glrlm;
-        void fill2DGLSZMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth);
-        boost::multi_array<float, 2> getGLSZMMatrix( boost::multi_array<T, R> inputMatrix, int depth);
-        int getBiggestZoneNr(boost::multi_array<T, R> inputMatrix);
+        void fill2DGLSZMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, int depth);
+        void getGLSZMMatrix( const boost::multi_array<T, R> &inputMatrix, int depth, boost::multi_array<float, 2> &GLSZMatrix);
+        int getBiggestZoneNr(const boost::multi_array<T, R> &inputMatrix);
         int maxZoneSize;
         vector<float> rowSums;
         vector<float> colSums;
@@ -32,9 +32,9 @@ class  GLSZMFeatures2DAVG : public GLSZMFeatures2DMRG<T, R>{
         void getNeighbors(boost::multi_array<T, R> &inputMatrix, T actElement, vector<vector< int> > &matrixIndices);
         void getALLXYDirections(int &directionX, int &directionY, int angle);
 
-        void calculateAllGLSZMFeatures2DAVG(GLSZMFeatures2DAVG<T,R> &GLSZMFeat, boost::multi_array<T,R> inputMatrix, vector<T> diffGrey, ConfigFile config);
+        void calculateAllGLSZMFeatures2DAVG(GLSZMFeatures2DAVG<T,R> &GLSZMFeat, const boost::multi_array<T,R> &inputMatrix, const vector<T> &diffGrey, const ConfigFile &config);
         void writeCSVFileGLSZM2DAVG(GLSZMFeatures2DAVG<T,R> GLSZMFeat, string outputFolder);
-		void writeOneFileGLSZM2DAVG(GLSZMFeatures2DAVG<T, R> GLSZMFeat, ConfigFile config, int &parameterSpaceNr);
+		void writeOneFileGLSZM2DAVG(GLSZMFeatures2DAVG<T, R> GLSZMFeat, const ConfigFile &config, int &parameterSpaceNr);
 
 };
 
@@ -49,7 +49,9 @@ of a neighborhood, it is set to NAN.\n
 The size of the neighborhoods are stored in the matrix.
 */
 template <class T, size_t R>
-void GLSZMFeatures2DAVG<T, R>::fill2DGLSZMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &GLSZMatrix, int depth){
+void GLSZMFeatures2DAVG<T, R>::fill2DGLSZMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &GLSZMatrix, int depth){
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
      T actualElement;
      vector<vector<int> > matrixIndices;
      vector<int> actualIndex;
@@ -60,18 +62,18 @@ void GLSZMFeatures2DAVG<T, R>::fill2DGLSZMatrices(boost::multi_array<T, R> input
      //go element by element through the image
      //look at the neighbors of every element and check if they have the same grey value
      //set every element already seen to NAN
-	 for (int row = 0; row < inputMatrix.shape()[0]; row++) {
-		 for (int col = 0; col < inputMatrix.shape()[1]; col++) {
-			 actualElement = inputMatrix[row][col][depth];
+	 for (int row = 0; row < zoneMatrix.shape()[0]; row++) {
+		 for (int col = 0; col < zoneMatrix.shape()[1]; col++) {
+			 actualElement = zoneMatrix[row][col][depth];
 			 if (!isnan(actualElement)) {
 				 actualGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actualElement);
-				 inputMatrix[row][col][depth] = NAN;
+				 zoneMatrix[row][col][depth] = NAN;
 				 actualIndex.push_back(row);
 				 actualIndex.push_back(col);
 				 actualIndex.push_back(depth);
 				 matrixIndices.push_back(actualIndex);
 				 actualIndex.clear();
-				 getNeighbors(inputMatrix, actualElement, matrixIndices);
+				 getNeighbors(zoneMatrix, actualElement, matrixIndices);
 			 }
 			 tempZoneSize = matrixIndices.size();
 			 if (tempZoneSize > maxZoneSize) {
@@ -89,27 +91,29 @@ void GLSZMFeatures2DAVG<T, R>::fill2DGLSZMatrices(boost::multi_array<T, R> input
 
 
 template <class T, size_t R>
-int GLSZMFeatures2DAVG<T, R>::getBiggestZoneNr(boost::multi_array<T, R> inputMatrix){
+int GLSZMFeatures2DAVG<T, R>::getBiggestZoneNr(const boost::multi_array<T, R> &inputMatrix){
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
      T actualElement;
      vector<vector<int> > matrixIndices;
      vector<int> actualIndex;
      maxZoneSize=0;
      int tempZoneSize=0;
 	 int actualGreyIndex;
-	 for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
+	 for (int depth = 0; depth < zoneMatrix.shape()[2]; depth++) {
 
-		 for (int row = 0; row < inputMatrix.shape()[0]; row++) {
-			 for (int col = 0; col < inputMatrix.shape()[1]; col++) {
-				 actualElement = inputMatrix[row][col][depth];
+		 for (int row = 0; row < zoneMatrix.shape()[0]; row++) {
+			 for (int col = 0; col < zoneMatrix.shape()[1]; col++) {
+				 actualElement = zoneMatrix[row][col][depth];
 				 if (!isnan(actualElement)) {
 					 actualGreyIndex = glszm2D.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actualElement);
-					 inputMatrix[row][col][depth] = NAN;
+					 zoneMatrix[row][col][depth] = NAN;
 					 actualIndex.push_back(row);
 					 actualIndex.push_back(col);
 					 actualIndex.push_back(depth);
 					 matrixIndices.push_back(actualIndex);
 					 actualIndex.clear();
-					 getNeighbors(inputMatrix, actualElement, matrixIndices);
+					 getNeighbors(zoneMatrix, actualElement, matrixIndices);
 
 				 }
 			 }
@@ -220,31 +224,17 @@ void GLSZMFeatures2DAVG<T, R>::getALLXYDirections(int &directionX, int &directio
 In the method getGLSZMMatrix the GLSZM matrices with the right size are generated and filled using the fill2DGLSZM function.
 @param[in] inputMatrix: the original matrix of the VOI
 @param[in] depth: number of actual slice for which the GLSZM should be calculated
-@param[out]: filled GLSZM
+@param[out] GLSZMatrix: filled GLSZM, it has the size number of grey levels x maxZoneSize and is set to 0
 
-This function only initiates a GLSZM with the right size.
+Afterwards maxZoneSize is the size of the biggest zone of the slice.
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLSZMFeatures2DAVG<T,R>::getGLSZMMatrix( boost::multi_array<T, R> inputMatrix, int depth){
-    typedef boost::multi_array<float, 2>  GLSZMat;
-    //maxZoneSize=getBiggestZoneNr(inputMatrix);
-    int sizeMatrix= (this->diffGreyLevels).size();
-	maxZoneSize = inputMatrix.shape()[0] * inputMatrix.shape()[1];
-    GLSZMat GLSZMatrix(boost::extents[sizeMatrix][maxZoneSize]);
+void GLSZMFeatures2DAVG<T,R>::getGLSZMMatrix( const boost::multi_array<T, R> &inputMatrix, int depth, boost::multi_array<float, 2> &GLSZMatrix){
     fill2DGLSZMatrices(inputMatrix, GLSZMatrix, depth);
-
-	GLSZMat smallGLSZM(boost::extents[sizeMatrix][maxZoneSize]);
-	for (int row = 0; row < sizeMatrix; row++) {
-		for (int col = 0; col < maxZoneSize; col++) {
-			smallGLSZM[row][col] = GLSZMatrix[row][col];
-		}
-	}
-    return smallGLSZM;
-
 }
 
 template <class T, size_t R>
-void GLSZMFeatures2DAVG<T, R>::calculateAllGLSZMFeatures2DAVG(GLSZMFeatures2DAVG<T,R> &GLSZMFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGrey, ConfigFile config){
+void GLSZMFeatures2DAVG<T, R>::calculateAllGLSZMFeatures2DAVG(GLSZMFeatures2DAVG<T,R> &GLSZMFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGrey, const ConfigFile &config){
 	GLSZMFeatures.getConfigValues(config);
 	this->diffGreyLevels = diffGrey;
     T sumShortRunEmphasis = 0;
@@ -274,7 +264,14 @@ void GLSZMFeatures2DAVG<T, R>::calculateAllGLSZMFeatures2DAVG(GLSZMFeatures2DAVG
     float meanRun;
 
     for(int depth = 0; depth < totalDepth; depth++){
-        boost::multi_array<float,2> GLSZM=GLSZMFeatures.getGLSZMMatrix(inputMatrix, depth);
+        //maxZoneSize=getBiggestZoneNr(inputMatrix);
+        maxZoneSize = inputMatrix.shape()[0] * inputMatrix.shape()[1];
+        ScratchMatrix<float> fullGLSZMBuffer(this->diffGreyLevels.size(), maxZoneSize);
+        GLSZMFeatures.getGLSZMMatrix(inputMatrix, depth, fullGLSZMBuffer.get());
+        //the matrix is cut to the biggest zone, maxZoneSize is set while the matrix is filled
+        ScratchMatrix<float> GLSZMBuffer(this->diffGreyLevels.size(), maxZoneSize);
+        boost::multi_array<float, 2> &GLSZM = GLSZMBuffer.get();
+        copyColumns(fullGLSZMBuffer.get(), GLSZM);
 		
 		
         float totalSum = GLSZMFeatures.calculateTotalSum(GLSZM);
@@ -283,7 +280,9 @@ void GLSZMFeatures2DAVG<T, R>::calculateAllGLSZMFeatures2DAVG(GLSZMFeatures2DAVG
         rowSums = GLSZMFeatures.calculateRowSums(GLSZM);
         colSums = GLSZMFeatures.calculateColSums(GLSZM);
 
-        boost::multi_array<float,2> probMatrix = GLSZMFeatures.calculateProbMatrix(GLSZM, totalSum);
+        ScratchMatrix<float> probMatrixBuffer(GLSZM.shape()[0], GLSZM.shape()[1]);
+        boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+        GLSZMFeatures.calculateProbMatrix(GLSZM, totalSum, probMatrix);
         meanGrey = GLSZMFeatures.calculateMeanProbGrey(probMatrix);
         meanRun = GLSZMFeatures.calculateMeanProbRun(probMatrix);
 
@@ -391,7 +390,7 @@ void GLSZMFeatures2DAVG<T, R>::writeCSVFileGLSZM2DAVG(GLSZMFeatures2DAVG<T,R> GL
 }
 
 template <class T, size_t R>
-void GLSZMFeatures2DAVG<T, R>::writeOneFileGLSZM2DAVG(GLSZMFeatures2DAVG<T, R> GLSZMFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLSZMFeatures2DAVG<T, R>::writeOneFileGLSZM2DAVG(GLSZMFeatures2DAVG<T, R> GLSZMFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
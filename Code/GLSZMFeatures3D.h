@@ -26,15 +26,15 @@ class GLSZMFeatures3D : public GLSZMFeatures2DMRG<T, R>{
 		vector<T> vectorMatrElem;
 
         void extractGLSZMData3D(vector<T> &GLSZMData, GLSZMFeatures3D<T, R> GLSZMFeatures);
-        boost::multi_array<float, 2> getGLSZMMatrix3D(boost::multi_array<T,R> inputMatrix, vector<T> vectorMatrElem);
-        void fill3DGLSZMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &glcMatrix);
-        int getBiggestZoneNr3D(vector<T> vectorMatrElem);
+        void getGLSZMMatrix3D(const boost::multi_array<T,R> &inputMatrix, boost::multi_array<float, 2> &GLSZMatrix, const VoxelList<T> *voxels = nullptr);
+        void fill3DGLSZMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &glcMatrix, const VoxelList<T> *voxels = nullptr);
+        int getBiggestZoneNr3D(const vector<T> &vectorMatrElem);
 
     public:
         void getNeighbors3D(boost::multi_array<T, R> &inputMatrix, T actElement, vector<vector< int> > &matrixIndices);
-        void calculateAllGLSZMFeatures3D(GLSZMFeatures3D<T,R> &GLSZMFeat, Image<T, R> imageAttr, ConfigFile config);
+        void calculateAllGLSZMFeatures3D(GLSZMFeatures3D<T,R> &GLSZMFeat, const Image<T, R> &imageAttr, const ConfigFile &config);
         void writeCSVFileGLSZM3D(GLSZMFeatures3D<T,R> GLSZMFeat, string outputFolder);
-		void writeOneFileGLSZM3D(GLSZMFeatures3D<T, R> GLSZMFeat, ConfigFile config, int &parameterSpaceNr);
+		void writeOneFileGLSZM3D(GLSZMFeatures3D<T, R> GLSZMFeat, const ConfigFile &config, int &parameterSpaceNr);
 
 };
 
@@ -46,13 +46,18 @@ class GLSZMFeatures3D : public GLSZMFeatures2DMRG<T, R>{
 In the method fill3DGLSZMatrices the GLSZM matrices are filled using the matrix filled with the intensity values of the VOI.
 @param[in] inputMatrix: the original matrix of the VOI
 @param[in]: GLSZM is given as reference
+@param[in] voxels: voxel list of the VOI matrix if the mask is sparse, then only the voxels of the list are used as starting points of a zone
 
 It checks the neighborhood of every element of the input matrix. Is an element already considered as an element
 of a neighborhood, it is set to NAN.\n
 The size of the neighborhoods are stored in the matrix.
 */
 template <class T, size_t R>
-void GLSZMFeatures3D<T, R>::fill3DGLSZMatrices(boost::multi_array<T, R> inputMatrix, boost::multi_array<float, 2> &GLSZMatrix) {
+void GLSZMFeatures3D<T, R>::fill3DGLSZMatrices(const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &GLSZMatrix, const VoxelList<T> *voxels) {
+	//the voxel list can only be used if it belongs to the input matrix
+	voxels = sparseVoxels(voxels, inputMatrix);
+	//zones are marked by setting their elements to NAN, this is done in a scratch copy of the VOI matrix
+	boost::multi_array<T, R> zoneMatrix = inputMatrix;
 	T actualElement;
 	vector<vector<int> > matrixIndices;
 	vector<int> actualIndex;
@@ -64,39 +69,35 @@ void GLSZMFeatures3D<T, R>::fill3DGLSZMatrices(boost::multi_array<T, R> inputMat
 	//go element by element through the image
 	//look at the neighbors of every element and check if they have the same grey value
 	//set every element already seen to NAN
-	for (int depth = 0; depth<inputMatrix.shape()[2]; depth++) {
-		for (int row = 0; row<inputMatrix.shape()[0]; row++) {
-			for (int col = 0; col < inputMatrix.shape()[1]; col++) {
-				actualElement = inputMatrix[row][col][depth];
-				if (!isnan(actualElement)) {
-					actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actualElement);
-					inputMatrix[row][col][depth] = NAN;
-					actualIndex.push_back(row);
-					actualIndex.push_back(col);
-					actualIndex.push_back(depth);
-					matrixIndices.push_back(actualIndex);
-					actualIndex.clear();
-					getNeighbors3D(inputMatrix, actualElement, matrixIndices);
-				}
-				tempZoneSize = matrixIndices.size();
-				if (tempZoneSize>maxZoneSize) {
-					maxZoneSize = tempZoneSize;
-				}
-				if (matrixIndices.size() > 0) {
+	forEachVoxel(zoneMatrix, voxels, [&](int row, int col, int depth) {
+		actualElement = zoneMatrix[row][col][depth];
+		if (!isnan(actualElement)) {
+			actGreyIndex = glrlm.findIndex(this->diffGreyLevels, boost::size(this->diffGreyLevels), actualElement);
+			zoneMatrix[row][col][depth] = NAN;
+			actualIndex.push_back(row);
+			actualIndex.push_back(col);
+			actualIndex.push_back(depth);
+			matrixIndices.push_back(actualIndex);
+			actualIndex.clear();
+			getNeighbors3D(zoneMatrix, actualElement, matrixIndices);
+		}
+		tempZoneSize = matrixIndices.size();
+		if (tempZoneSize>maxZoneSize) {
+			maxZoneSize = tempZoneSize;
+		}
+		if (matrixIndices.size() > 0) {
 
-					GLSZMatrix[actGreyIndex][matrixIndices.size() - 1] += 1;
-					matrixIndices.clear();
-				}
-			}
+			GLSZMatrix[actGreyIndex][matrixIndices.size() - 1] += 1;
+			matrixIndices.clear();
 		}
-	}
+	});
 
 }
 
 
 
 template <class T, size_t R>
-int GLSZMFeatures3D<T, R>::getBiggestZoneNr3D(vector<T> vectorMatrElem) {
+int GLSZMFeatures3D<T, R>::getBiggestZoneNr3D(const vector<T> &vectorMatrElem) {
 	T actGreyElement;
 	vector<vector<int> > matrixIndices;
 	vector<int> actualIndex;
@@ -198,37 +199,31 @@ void GLSZMFeatures3D<T, R>::getNeighbors3D(boost::multi_array<T, R> &inputMatrix
 /*!
 In the method getGLSZMMatrix3D the GLSZM matrices with the right size are generated and filled using the fill2DGLSZM function.
 @param[in] inputMatrix: the original matrix of the VOI
-@param[in] depth: number of actual slice for which the GLSZM should be calculated
-@param[out]: filled GLSZM
+@param[out] GLSZMatrix: filled GLSZM, it has the size number of grey levels x maxZoneSize and is set to 0
+@param[in] voxels: voxel list of the VOI (can be nullptr)
 
-This function only initiates a GLSZM with the right size.
+Afterwards maxZoneSize is the size of the biggest zone.
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> GLSZMFeatures3D<T,R>::getGLSZMMatrix3D( boost::multi_array<T, R> inputMatrix, vector<T> vectorMatrElem){
-    typedef boost::multi_array<float, 2>  GLSZMat;
-	//get the maximal zone size in order to determine the size of the matrix
-    //maxZoneSize=getBiggestZoneNr3D(inputMatrix);
-	maxZoneSize = inputMatrix.shape()[0] * inputMatrix.shape()[1] * inputMatrix.shape()[2];
-    int sizeMatrix= (this->diffGreyLevels).size();
-    GLSZMat GLSZMatrix(boost::extents[sizeMatrix][maxZoneSize]);
-	
-    fill3DGLSZMatrices(inputMatrix, GLSZMatrix);
-	GLSZMat smallGLSZM(boost::extents[sizeMatrix][maxZoneSize]);
-	for (int row = 0; row < sizeMatrix; row++) {
-		for (int col = 0; col < maxZoneSize; col++) {
-			smallGLSZM[row][col] = GLSZMatrix[row][col];
-		}
-	}
-    return smallGLSZM;
-
+void GLSZMFeatures3D<T,R>::getGLSZMMatrix3D( const boost::multi_array<T, R> &inputMatrix, boost::multi_array<float, 2> &GLSZMatrix, const VoxelList<T> *voxels){
+    fill3DGLSZMatrices(inputMatrix, GLSZMatrix, voxels);
 }
 
 template <class T, size_t R>
-void GLSZMFeatures3D<T, R>::calculateAllGLSZMFeatures3D(GLSZMFeatures3D<T,R> &GLSZMFeatures, Image<T,R> imageAttr, ConfigFile config){
+void GLSZMFeatures3D<T, R>::calculateAllGLSZMFeatures3D(GLSZMFeatures3D<T,R> &GLSZMFeatures, const Image<T,R> &imageAttr, const ConfigFile &config){
     this->diffGreyLevels = imageAttr.diffGreyLevels;
 	GLSZMFeatures.getConfigValues(config);
 
-    boost::multi_array<float,2> GLSZM=GLSZMFeatures.getGLSZMMatrix3D(imageAttr.imageMatrix, imageAttr.vectorOfMatrixElements);
+	//get the maximal zone size in order to determine the size of the matrix
+    //maxZoneSize=getBiggestZoneNr3D(inputMatrix);
+	//a zone can not contain more voxels than the VOI
+	maxZoneSize = imageAttr.vectorOfMatrixElements.size();
+    ScratchMatrix<float> fullGLSZMBuffer(this->diffGreyLevels.size(), maxZoneSize);
+    GLSZMFeatures.getGLSZMMatrix3D(imageAttr.imageMatrix, fullGLSZMBuffer.get(), imageAttr.getVoxelList());
+    //the matrix is cut to the biggest zone, maxZoneSize is set while the matrix is filled
+    ScratchMatrix<float> GLSZMBuffer(this->diffGreyLevels.size(), maxZoneSize);
+    boost::multi_array<float, 2> &GLSZM = GLSZMBuffer.get();
+    copyColumns(fullGLSZMBuffer.get(), GLSZM);
     float totalSum = GLSZMFeatures.calculateTotalSum(GLSZM);
     rowSums=GLSZMFeatures.calculateRowSums(GLSZM);
     colSums = GLSZMFeatures.calculateColSums(GLSZM);
@@ -245,7 +240,9 @@ void GLSZMFeatures3D<T, R>::calculateAllGLSZMFeatures3D(GLSZMFeatures3D<T,R> &GL
     GLSZMFeatures.calculateRunLengthNonUniformityNorm(rowSums, totalSum);
     GLSZMFeatures.calculateRunLengthNonUniformity(rowSums, totalSum);
     GLSZMFeatures.calculateRunPercentage3D(imageAttr.vectorOfMatrixElements, totalSum, 1);
-    boost::multi_array<float,2> probMatrix = GLSZMFeatures.calculateProbMatrix(GLSZM, totalSum);
+    ScratchMatrix<float> probMatrixBuffer(GLSZM.shape()[0], GLSZM.shape()[1]);
+    boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+    GLSZMFeatures.calculateProbMatrix(GLSZM, totalSum, probMatrix);
 	float meanGrey = GLSZMFeatures.calculateMeanProbGrey(probMatrix);
 
     GLSZMFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
@@ -302,7 +299,7 @@ void GLSZMFeatures3D<T, R>::writeCSVFileGLSZM3D(GLSZMFeatures3D<T,R> GLSZMFeat,
 }
 
 template <class T, size_t R>
-void GLSZMFeatures3D<T, R>::writeOneFileGLSZM3D(GLSZMFeatures3D<T, R> GLSZMFeat, ConfigFile config, int &parameterSpaceNr) {
+void GLSZMFeatures3D<T, R>::writeOneFileGLSZM3D(GLSZMFeatures3D<T, R> GLSZMFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -22,48 +22,37 @@ class NGLDMFeatures2DAVG : public NGLDMFeatures2DMRG<T,R>{
 
         NGLDMFeatures2DMRG<T, R> ngldm;
         void extractNGLDMData2DAVG(vector<T> &ngldmData, NGLDMFeatures2DAVG<T, R> ngldmFeatures);
-        boost::multi_array<float, 2> getMatrix(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> ngldmNr, int depth);
+        void getMatrix(const boost::multi_array<T, R> &ngldmNr, int depth, boost::multi_array<float, 2> &NGLDMatrix);
 
     public:
         //double dependenceCountEnergy;
         void writeCSVFileNGLDM2DAVG(NGLDMFeatures2DAVG<T,R> ngldmFeat, string outputFolder);
-		void writeOneFileNGLDM2DAVG(NGLDMFeatures2DAVG<T, R> ngldmFeat, ConfigFile config, int &parameterSpaceNr);
-        void calculateAllNGLDMFeatures2DAVG(NGLDMFeatures2DAVG<T, R> &ngldmFeatures, Image<T, R> imageAttr, boost::multi_array<T, R> ngldmMatrix, ConfigFile config);
+		void writeOneFileNGLDM2DAVG(NGLDMFeatures2DAVG<T, R> ngldmFeat, const ConfigFile &config, int &parameterSpaceNr);
+        void calculateAllNGLDMFeatures2DAVG(NGLDMFeatures2DAVG<T, R> &ngldmFeatures, const Image<T, R> &imageAttr, const boost::multi_array<T, R> &ngldmMatrix, const ConfigFile &config);
 
 };
 
 /*!
 \brief getMatrix
-@param[in] boost multi array inputMatrix: matrix filled with intensity values
 @param[in] boost multi array ngldmNr: already filled NGLDM matrix, this matrix is 3D
 @param[in] int depth: index of the actual slice
-@param[out] boost multi array: filled 2D NGLD matrix
+@param[out] NGLDMatrix: filled 2D NGLD matrix, it has the size number of grey levels x 9 (8 neighbors) and is set to 0
 
 This function converts the 3D NGLDM matrix in the required 2D NGLD matrix for every slice
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> NGLDMFeatures2DAVG<T, R>::getMatrix(boost::multi_array<T,R> inputMatrix, boost::multi_array<T, R> ngldmNr, int depth){
-    typedef boost::multi_array<float, 2>  ngldmat;
-    vector<int> actualIndex;
-    T actualElement;
-    int sizeGreyLevels = (this->diffGreyLevels).size();
-	int actualGreyIndex;
-    int ngldmnr;
-    //define the NGLDMarices; col.size=9 because we have 8 neighbors
-    ngldmat NGLDMatrix(boost::extents[sizeGreyLevels][9]);
-
+void NGLDMFeatures2DAVG<T, R>::getMatrix(const boost::multi_array<T, R> &ngldmNr, int depth, boost::multi_array<float, 2> &NGLDMatrix){
     for(int row =0; row<ngldmNr.shape()[0]; row++){
 		for(int col =0; col<ngldmNr.shape()[1]; col++){
 			NGLDMatrix[row][col] = ngldmNr[row][col][depth];
               
         }
     }
-    return NGLDMatrix;
 }
 
 
 template <class T, size_t R>
-void NGLDMFeatures2DAVG<T, R>::calculateAllNGLDMFeatures2DAVG(NGLDMFeatures2DAVG<T,R> &ngldmFeatures, Image<T, R> imageAttr, boost::multi_array<T,R> ngldmMatrix, ConfigFile config){
+void NGLDMFeatures2DAVG<T, R>::calculateAllNGLDMFeatures2DAVG(NGLDMFeatures2DAVG<T,R> &ngldmFeatures, const Image<T, R> &imageAttr, const boost::multi_array<T,R> &ngldmMatrix, const ConfigFile &config){
 	ngldmFeatures.getConfigValues(config);
 	//get config values
 	coarseParam = config.coarsenessParam;
@@ -96,10 +85,15 @@ void NGLDMFeatures2DAVG<T, R>::calculateAllNGLDMFeatures2DAVG(NGLDMFeatures2DAVG
 
     for(int depth = 0; depth < totalDepth; depth++){
 
-        boost::multi_array<float,2> NGLDM=ngldmFeatures.getMatrix(imageAttr.imageMatrix, ngldmMatrix, depth);
+        //col.size=9 because we have 8 neighbors
+        ScratchMatrix<float> NGLDMBuffer(this->diffGreyLevels.size(), 9);
+        boost::multi_array<float,2> &NGLDM = NGLDMBuffer.get();
+        ngldmFeatures.getMatrix(ngldmMatrix, depth, NGLDM);
         totalSum = ngldmFeatures.calculateTotalSum(NGLDM);
 
-        boost::multi_array<float,2> probMatrix = ngldmFeatures.calculateProbMatrix(NGLDM, totalSum);
+        ScratchMatrix<float> probMatrixBuffer(NGLDM.shape()[0], NGLDM.shape()[1]);
+        boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+        ngldmFeatures.calculateProbMatrix(NGLDM, totalSum, probMatrix);
 
         meanGrey = ngldmFeatures.calculateMeanProbGrey(probMatrix);
         meanRun = ngldmFeatures.calculateMeanProbRun(probMatrix);
@@ -207,7 +201,7 @@ void NGLDMFeatures2DAVG<T, R>::writeCSVFileNGLDM2DAVG(NGLDMFeatures2DAVG<T,R> ng
 }
 
 template <class T, size_t R>
-void NGLDMFeatures2DAVG<T, R>::writeOneFileNGLDM2DAVG(NGLDMFeatures2DAVG<T, R> ngldmFeat, ConfigFile config, int &parameterSpaceNr) {
+void NGLDMFeatures2DAVG<T, R>::writeOneFileNGLDM2DAVG(NGLDMFeatures2DAVG<T, R> ngldmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -27,17 +27,17 @@ class NGLDMFeatures2DMRG : public GLRLMFeatures<T,R>{
 		int coarseParam;
 
         void extractNGLDMData(vector<T> &ngldmData, NGLDMFeatures2DMRG<T, R> ngldmFeatures);
-        boost::multi_array<float, 2> getMatrix(boost::multi_array<T,R> inputMatrix);
+        void getMatrix(const boost::multi_array<T,R> &inputMatrix, boost::multi_array<float, 2> &NGLDMatrix);
 
 		
 
     public:
         float dependenceCountEnergy = NAN;
-		int findIndex(vector<T> array, int size, T target);
+		int findIndex(const vector<T> &array, int size, T target);
         void writeCSVFileNGLDM2DMRG(NGLDMFeatures2DMRG<T,R> ngldmFeat, string outputFolder);
-		void writeOneFileNGLDM2DMRG(NGLDMFeatures2DMRG<T, R> ngldmFeat, ConfigFile config, int &parameterSpaceNr);
-        void calculateAllNGLDMFeatures2DMRG(NGLDMFeatures2DMRG<T,R> &ngldmFeatures, Image<T, R> imageAttr, boost::multi_array<T, R> ngldmMatrix, ConfigFile config);
-        void calculateDependenceCountEnergy(boost::multi_array<float,2> probMatrix);
+		void writeOneFileNGLDM2DMRG(NGLDMFeatures2DMRG<T, R> ngldmFeat, const ConfigFile &config, int &parameterSpaceNr);
+        void calculateAllNGLDMFeatures2DMRG(NGLDMFeatures2DMRG<T,R> &ngldmFeatures, const Image<T, R> &imageAttr, const boost::multi_array<T, R> &ngldmMatrix, const ConfigFile &config);
+        void calculateDependenceCountEnergy(const boost::multi_array<float,2> &probMatrix);
         void defineNGLDMFeatures(vector<string> &features);
 		void defineNGLDMFeaturesOntology(vector<string> &features);
 
@@ -53,7 +53,7 @@ This function finds a specific element in an array and returns the index of the
 In our case, it is used to find the position of the actual grey level in the vector containing all grey levels.
 */
 template <class T, size_t R>
-int NGLDMFeatures2DMRG<T, R>::findIndex(vector<T> array, int size, T target) {
+int NGLDMFeatures2DMRG<T, R>::findIndex(const vector<T> &array, int size, T target) {
 	int i = 0;
 	while ((i < size) && (array[i] != target)) i++;
 	return (i < size) ? (i) : (-1);
@@ -62,14 +62,13 @@ int NGLDMFeatures2DMRG<T, R>::findIndex(vector<T> array, int size, T target) {
 /*!
 \brief getMatrix
 @param boost multi array ngldmMatrix: Matrix containing NGLDM elements for every slice, this matrix just has to be merged to a 2D matrix
-@param[out] boost multi array: filled NGLD matrix
+@param[out] NGLDMatrix: filled NGLD matrix, it has the size of the first two dimensions of ngldmMatrix and is set to 0
 
 The function fills the NGLDMatrix with the corresponding values using the function getNeighborGreyLevels. It 
 checks voxel by voxel the neighborhood in the distance that is set by the user.
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> NGLDMFeatures2DMRG<T, R>::getMatrix(boost::multi_array<T,R> ngldmMatrix){
-	boost::multi_array<float, 2> NGLDMatrix(boost::extents[ngldmMatrix.shape()[0]][ngldmMatrix.shape()[1]]);
+void NGLDMFeatures2DMRG<T, R>::getMatrix(const boost::multi_array<T,R> &ngldmMatrix, boost::multi_array<float, 2> &NGLDMatrix){
 	//check every element of the VOI
 	for (int depth = 0; depth < ngldmMatrix.shape()[2]; depth++) {
 		for (int row = 0; row < ngldmMatrix.shape()[0]; row++) {
@@ -79,7 +78,6 @@ boost::multi_array<float, 2> NGLDMFeatures2DMRG<T, R>::getMatrix(boost::multi_ar
 
 		}
 	}
-    return NGLDMatrix;
 }
 
 
@@ -91,7 +89,7 @@ boost::multi_array<float, 2> NGLDMFeatures2DMRG<T, R>::getMatrix(boost::multi_ar
 The function calculate the dependence count energy: \f$ F_{countEnergy} = \sum_{i=1}^{N_{g} \sum_{j=1}^{N_{g} p_{ij}^{2} \f$.
 */
 template <class T, size_t R>
-void NGLDMFeatures2DMRG<T, R>::calculateDependenceCountEnergy(boost::multi_array<float,2> probMatrix){
+void NGLDMFeatures2DMRG<T, R>::calculateDependenceCountEnergy(const boost::multi_array<float,2> &probMatrix){
     dependenceCountEnergy=0;
     for(int row=0; row<probMatrix.shape()[0]; row++){
         for(int col=0; col<probMatrix.shape()[1]; col++){
@@ -105,14 +103,16 @@ void NGLDMFeatures2DMRG<T, R>::calculateDependenceCountEnergy(boost::multi_array
 
 
 template <class T, size_t R>
-void NGLDMFeatures2DMRG<T, R>::calculateAllNGLDMFeatures2DMRG(NGLDMFeatures2DMRG<T,R> &ngldmFeatures, Image<T, R> imageAttr, boost::multi_array<T, R> ngldmMatrix, ConfigFile config){
+void NGLDMFeatures2DMRG<T, R>::calculateAllNGLDMFeatures2DMRG(NGLDMFeatures2DMRG<T,R> &ngldmFeatures, const Image<T, R> &imageAttr, const boost::multi_array<T, R> &ngldmMatrix, const ConfigFile &config){
     this->diffGreyLevels = imageAttr.diffGreyLevels;
 	ngldmFeatures.getConfigValues(config);
 	//get values from config file
 	coarseParam = config.coarsenessParam;
 	this->dist = config.distNGLDM;
 	//get NGLDM 
-    boost::multi_array<float,2> NGLDM=ngldmFeatures.getMatrix(ngldmMatrix);
+    ScratchMatrix<float> NGLDMBuffer(ngldmMatrix.shape()[0], ngldmMatrix.shape()[1]);
+    boost::multi_array<float,2> &NGLDM = NGLDMBuffer.get();
+    ngldmFeatures.getMatrix(ngldmMatrix, NGLDM);
     float totalSum = ngldmFeatures.calculateTotalSum(NGLDM);
 
     rowSums=ngldmFeatures.calculateRowSums(NGLDM);
@@ -130,7 +130,9 @@ void NGLDMFeatures2DMRG<T, R>::calculateAllNGLDMFeatures2DMRG(NGLDMFeatures2DMRG
     ngldmFeatures.calculateRunLengthNonUniformityNorm(rowSums, totalSum);
     ngldmFeatures.calculateRunLengthNonUniformity(rowSums, totalSum);
     ngldmFeatures.calculateRunPercentage3D(imageAttr.vectorOfMatrixElements, totalSum, 1);
-    boost::multi_array<float,2> probMatrix = ngldmFeatures.calculateProbMatrix(NGLDM, totalSum);
+    ScratchMatrix<float> probMatrixBuffer(NGLDM.shape()[0], NGLDM.shape()[1]);
+    boost::multi_array<float,2> &probMatrix = probMatrixBuffer.get();
+    ngldmFeatures.calculateProbMatrix(NGLDM, totalSum, probMatrix);
     float meanGrey = ngldmFeatures.calculateMeanProbGrey(probMatrix);
     ngldmFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
 
@@ -187,7 +189,7 @@ void NGLDMFeatures2DMRG<T, R>::writeCSVFileNGLDM2DMRG(NGLDMFeatures2DMRG<T,R> ng
 }
 
 template <class T, size_t R>
-void NGLDMFeatures2DMRG<T, R>::writeOneFileNGLDM2DMRG(NGLDMFeatures2DMRG<T, R> ngldmFeat, ConfigFile config, int &parameterSpaceNr) {
+void NGLDMFeatures2DMRG<T, R>::writeOneFileNGLDM2DMRG(NGLDMFeatures2DMRG<T, R> ngldmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -32,8 +32,8 @@ class NGLDMFeatures3D : public NGLDMFeatures2DMRG<T,R>{
     public:
 		//vector<T> diffGreyLevels;
         void writeCSVFileNGLDM3D(NGLDMFeatures3D<T,R> ngldmFeat, string outputFolder);
-		void writeOneFileNGLDM3D(NGLDMFeatures3D<T, R> ngldmFeat, ConfigFile config, int &parameterSpaceNr);
-        void calculateAllNGLDMFeatures3D(NGLDMFeatures3D<T,R> &ngldmFeatures, boost::multi_array<float, 2> ngldm3DMatrix, Image<T, R> imageAttr, ConfigFile config);
+		void writeOneFileNGLDM3D(NGLDMFeatures3D<T, R> ngldmFeat, const ConfigFile &config, int &parameterSpaceNr);
+        void calculateAllNGLDMFeatures3D(NGLDMFeatures3D<T,R> &ngldmFeatures, const boost::multi_array<float, 2> &ngldm3DMatrix, const Image<T, R> &imageAttr, const ConfigFile &config);
 };
 
 
@@ -47,7 +47,7 @@ class NGLDMFeatures3D : public NGLDMFeatures2DMRG<T,R>{
 This function calculates all NGLDM features.
 */
 template <class T, size_t R>
-void NGLDMFeatures3D<T, R>::calculateAllNGLDMFeatures3D(NGLDMFeatures3D<T,R> &ngldmFeatures, boost::multi_array<float, 2> NGLDM, Image<T,R> imageAttr, ConfigFile config){
+void NGLDMFeatures3D<T, R>::calculateAllNGLDMFeatures3D(NGLDMFeatures3D<T,R> &ngldmFeatures, const boost::multi_array<float, 2> &NGLDM, const Image<T,R> &imageAttr, const ConfigFile &config){
 	ngldmFeatures.getConfigValues(config);
 
 	coarseParam = config.coarsenessParam;
@@ -77,7 +77,9 @@ void NGLDMFeatures3D<T, R>::calculateAllNGLDMFeatures3D(NGLDMFeatures3D<T,R> &ng
 		
 		ngldmFeatures.calculateRunPercentage3D(imageAttr.vectorOfMatrixElements, totalSum, 1);
 		std::cout << "HERE" << std::endl;
-		boost::multi_array<float, 2> probMatrix = ngldmFeatures.calculateProbMatrix(NGLDM, totalSum);
+		ScratchMatrix<float> probMatrixBuffer(NGLDM.shape()[0], NGLDM.shape()[1]);
+		boost::multi_array<float, 2> &probMatrix = probMatrixBuffer.get();
+		ngldmFeatures.calculateProbMatrix(NGLDM, totalSum, probMatrix);
 		float meanGrey = ngldmFeatures.calculateMeanProbGrey(probMatrix);
 
 		ngldmFeatures.calculateGreyLevelVar(probMatrix, meanGrey);
@@ -118,7 +120,7 @@ void NGLDMFeatures3D<T, R>::writeCSVFileNGLDM3D(NGLDMFeatures3D<T,R> ngldmFeat,
 }
 
 template <class T, size_t R>
-void NGLDMFeatures3D<T, R>::writeOneFileNGLDM3D(NGLDMFeatures3D<T, R> ngldmFeat, ConfigFile config, int &parameterSpaceNr) {
+void NGLDMFeatures3D<T, R>::writeOneFileNGLDM3D(NGLDMFeatures3D<T, R> ngldmFeat, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -30,12 +30,12 @@ private:
 	void extractNGTDMData2DAVG(vector<T> &ngtdmData, NGTDM2DAVG<T, R> ngtdmFeatures);
 
 
-	boost::multi_array<float, 2> getNGTDMatrix2DAVG(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> sumNeighborHoods, int depth, ConfigFile config);
+	void getNGTDMatrix2DAVG(const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &sumNeighborHoods, int depth, boost::multi_array<float, 2> &NGTDMatrix, const VoxelList<T> *voxels = nullptr);
 public:
-	void getProbability(vector<T> elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix);
-	void calculateAllNGTDMFeatures2DAVG(NGTDM2DAVG<T, R> &ngtdmFeatures, Image<T, R> imageAttr, boost::multi_array<T, R> sumNeighborHoods, vector<float> spacing, ConfigFile config);
+	void getProbability(const vector<T> &elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix);
+	void calculateAllNGTDMFeatures2DAVG(NGTDM2DAVG<T, R> &ngtdmFeatures, const Image<T, R> &imageAttr, const boost::multi_array<T, R> &sumNeighborHoods, const vector<float> &spacing, const ConfigFile &config);
 	void writeCSVFileNGTDM2DAVG(NGTDM2DAVG<T, R> ngtdm, string outputFolder);
-	void writeOneFileNGTDM2DAVG(NGTDM2DAVG<T, R> ngtdm, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileNGTDM2DAVG(NGTDM2DAVG<T, R> ngtdm, const ConfigFile &config, int &parameterSpaceNr);
 };
 
 
@@ -46,45 +46,41 @@ In this function the NGTDM is filled.
 @param[in] boost multi array inputMatrix: matrix filled with intensity values
 @param[in] int dist: size of neighborhood
 @param[in] int depth: actual number of slice
-@param[out] boost multi array: filled NGTD matrix
+@param[out] NGTDMatrix: filled NGTD matrix, it has the size number of grey levels x 3 and is set to 0
+@param[in] voxels: voxel list of the VOI matrix if the mask is sparse, otherwise nullptr
 The function fills the NGTDMatrix with the corresponding values
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> NGTDM2DAVG<T, R>::getNGTDMatrix2DAVG(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> sumNeighborHoods, int depth, ConfigFile config) {
-	typedef boost::multi_array<float, 2>  ngtdmat;
-	int sizeMatrix = this->diffGreyLevels.size();
-	ngtdmat NGTDMatrix(boost::extents[sizeMatrix][3]);
+void NGTDM2DAVG<T, R>::getNGTDMatrix2DAVG(const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &sumNeighborHoods, int depth, boost::multi_array<float, 2> &NGTDMatrix, const VoxelList<T> *voxels) {
+	voxels = sparseVoxels(voxels, inputMatrix);
 	int indexOfElement[3] = { 0,0,0 };
 	std::vector<T> elementsOfWholeNeighborhoods;
 	T sumOfActualNeighborhood;
 	T s = 0;
 	T actualElement;
 	int posActualElement;
-	for (int row = 0; row < inputMatrix.shape()[0]; row++) {
-		for (int col = 0; col < inputMatrix.shape()[1]; col++) {
-			indexOfElement[0] = row;
-			indexOfElement[1] = col;
-			indexOfElement[2] = depth;
-			//get actual Element if it is the centre of a whole neighborhood
-			actualElement = inputMatrix[row][col][depth];
-			if (!std::isnan(actualElement)) {
-				//get the sum of the actual neighborhood
-				sumOfActualNeighborhood = sumNeighborHoods[row][col][depth];
-				//get the s_i value
-				s = abs(actualElement - sumOfActualNeighborhood);
-				//get the position of the actual Element in the diffGreyLevel vector and so also in the matrix
-				posActualElement = std::find(this->diffGreyLevels.begin(), this->diffGreyLevels.end(), actualElement) - this->diffGreyLevels.begin();
-				//add the s_i value to the right element in the matrix
-				NGTDMatrix[posActualElement][2] += s;
-				NGTDMatrix[posActualElement][0] += 1;
-				//save the actual Element in a vector, so we can calculate later the probabilities
-				elementsOfWholeNeighborhoods.push_back(actualElement);
-			}
+	forEachVoxelInSlice(inputMatrix, voxels, depth, [&](int row, int col, int depth) {
+		indexOfElement[0] = row;
+		indexOfElement[1] = col;
+		indexOfElement[2] = depth;
+		//get actual Element if it is the centre of a whole neighborhood
+		actualElement = inputMatrix[row][col][depth];
+		if (!std::isnan(actualElement)) {
+			//get the sum of the actual neighborhood
+			sumOfActualNeighborhood = sumNeighborHoods[row][col][depth];
+			//get the s_i value
+			s = abs(actualElement - sumOfActualNeighborhood);
+			//get the position of the actual Element in the diffGreyLevel vector and so also in the matrix
+			posActualElement = std::find(this->diffGreyLevels.begin(), this->diffGreyLevels.end(), actualElement) - this->diffGreyLevels.begin();
+			//add the s_i value to the right element in the matrix
+			NGTDMatrix[posActualElement][2] += s;
+			NGTDMatrix[posActualElement][0] += 1;
+			//save the actual Element in a vector, so we can calculate later the probabilities
+			elementsOfWholeNeighborhoods.push_back(actualElement);
 		}
-	}
+	});
 	getProbability(elementsOfWholeNeighborhoods, NGTDMatrix);
 	elementsOfWholeNeighborhoods.clear();
-	return NGTDMatrix;
 }
 
 
@@ -97,7 +93,7 @@ boost::multi_array<float, 2> NGTDM2DAVG<T, R>::getNGTDMatrix2DAVG(boost::multi_a
 The function calculates the probability matrix of the NGTD matrix, as many features are calculated using the probabilities.
 */
 template <class T, size_t R>
-void NGTDM2DAVG<T, R>::getProbability(vector<T> elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix) {
+void NGTDM2DAVG<T, R>::getProbability(const vector<T> &elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix) {
 	float numItem = 0;
 	for (int actElementIndex = 0; actElementIndex<boost::size(this->diffGreyLevels); actElementIndex++) {
 		numItem += ngtdMatrix[actElementIndex][0];
@@ -112,7 +108,7 @@ void NGTDM2DAVG<T, R>::getProbability(vector<T> elementsOfWholeNeighborhood, boo
 
 
 template <class T, size_t R>
-void NGTDM2DAVG<T, R>::calculateAllNGTDMFeatures2DAVG(NGTDM2DAVG<T, R> &ngtdmFeatures, Image<T, R> imageAttr, boost::multi_array<T,R> sumNeighborHoods, vector<float> spacing, ConfigFile config) {
+void NGTDM2DAVG<T, R>::calculateAllNGTDMFeatures2DAVG(NGTDM2DAVG<T, R> &ngtdmFeatures, const Image<T, R> &imageAttr, const boost::multi_array<T,R> &sumNeighborHoods, const vector<float> &spacing, const ConfigFile &config) {
 	this->diffGreyLevels = imageAttr.diffGreyLevels;
 	//fill these values with the values set by user
 	actualSpacing = spacing;
@@ -127,7 +123,9 @@ void NGTDM2DAVG<T, R>::calculateAllNGTDMFeatures2DAVG(NGTDM2DAVG<T, R> &ngtdmFea
 
 	int totalDepth = imageAttr.imageMatrix.shape()[2];
 	for (int depth = 0; depth < totalDepth; depth++) {
-		boost::multi_array<float, 2> ngtdm = ngtdmFeatures.getNGTDMatrix2DAVG(imageAttr.imageMatrix, sumNeighborHoods, depth, config);
+		ScratchMatrix<float> ngtdmBuffer(this->diffGreyLevels.size(), 3);
+		boost::multi_array<float, 2> &ngtdm = ngtdmBuffer.get();
+		ngtdmFeatures.getNGTDMatrix2DAVG(imageAttr.imageMatrix, sumNeighborHoods, depth, ngtdm, imageAttr.getVoxelList());
 		ngtdmFeatures.calculateCoarseness(ngtdm);
 
 		sumCoarseness += this->coarseness;
@@ -173,7 +171,7 @@ void NGTDM2DAVG<T, R>::writeCSVFileNGTDM2DAVG(NGTDM2DAVG<T, R> ngtdmFeatures, st
 }
 
 template <class T, size_t R>
-void NGTDM2DAVG<T, R>::writeOneFileNGTDM2DAVG(NGTDM2DAVG<T, R> ngtdmFeatures, ConfigFile config, int &parameterSpaceNr) {
+void NGTDM2DAVG<T, R>::writeOneFileNGTDM2DAVG(NGTDM2DAVG<T, R> ngtdmFeatures, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
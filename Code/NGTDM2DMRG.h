@@ -27,7 +27,7 @@ private:
 	vector<float> actualSpacing;
 	string normNGTDM;
 	int dist;
-	boost::multi_array<float, 2> getNGTDMatrix(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> neighborHoodSum);
+	void getNGTDMatrix(const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &neighborHoodSum, boost::multi_array<float, 2> &NGTDMatrix, const VoxelList<T> *voxels = nullptr);
 
 	void extractNGTDMData(vector<T> &ngtdmData, NGTDMFeatures2DMRG<T, R> NGTDMFeatures2DMRG);
 
@@ -39,20 +39,20 @@ public:
 	double complexity = NAN;
 	double strength = NAN;
 
-	void getProbability(vector<T> elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix);
-	double calculateSumSi(boost::multi_array<float, 2> ngtdm);
-	double calculateSumSiPi(boost::multi_array<float, 2> ngtdm);
-	int getNGP(boost::multi_array<float, 2> ngtdm);
-	int getNV(boost::multi_array<float, 2> ngtdm);
-
-	void calculateStrength(boost::multi_array<float, 2> ngtdm);
-	void calculateComplexity(boost::multi_array<float, 2> ngtdm);
-	void calculateCoarseness(boost::multi_array<float, 2> ngtdm);
-	void calculateContrast(boost::multi_array<float, 2> ngtdm);
-	void calculateBusyness(boost::multi_array<float, 2> ngtdm);
-	void calculateAllNGTDMFeatures2DMRG(NGTDMFeatures2DMRG<T, R> &ngtdm, Image<T, R> imageAttr, boost::multi_array<T,R> neighborHoodSum, vector<float> spacing, ConfigFile config);
+	void getProbability(const vector<T> &elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix);
+	double calculateSumSi(const boost::multi_array<float, 2> &ngtdm);
+	double calculateSumSiPi(const boost::multi_array<float, 2> &ngtdm);
+	int getNGP(const boost::multi_array<float, 2> &ngtdm);
+	int getNV(const boost::multi_array<float, 2> &ngtdm);
+
+	void calculateStrength(const boost::multi_array<float, 2> &ngtdm);
+	void calculateComplexity(const boost::multi_array<float, 2> &ngtdm);
+	void calculateCoarseness(const boost::multi_array<float, 2> &ngtdm);
+	void calculateContrast(const boost::multi_array<float, 2> &ngtdm);
+	void calculateBusyness(const boost::multi_array<float, 2> &ngtdm);
+	void calculateAllNGTDMFeatures2DMRG(NGTDMFeatures2DMRG<T, R> &ngtdm, const Image<T, R> &imageAttr, const boost::multi_array<T,R> &neighborHoodSum, const vector<float> &spacing, const ConfigFile &config);
 	void writeCSVFileNGTDM(NGTDMFeatures2DMRG<T, R> ngtdm, string outputFolder);
-	void writeOneFileNGTDM(NGTDMFeatures2DMRG<T, R> ngtdm, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileNGTDM(NGTDMFeatures2DMRG<T, R> ngtdm, const ConfigFile &config, int &parameterSpaceNr);
 	void defineNGTDMFeatures2DMRG(vector<string> &features);
 	void defineNGTDMFeatures2DMRGOntology(vector<string> &features);
 };
@@ -61,47 +61,41 @@ public:
 \brief getNGTDMatrix
 @param boost multi array inputMatrix: matrix filled with intensity values
 @param int dist: size of neighborhood
-@param[out] boost multi array: filled NGTD matrix
+@param[out] NGTDMatrix: filled NGTD matrix, it has the size number of grey levels x 3 and is set to 0
+@param voxels: voxel list of the VOI matrix if the mask is sparse, otherwise nullptr
 
 The function fills the NGTDMatrix with the corresponding values
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> NGTDMFeatures2DMRG<T, R>::getNGTDMatrix(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> neighborHoodSum) {
-	typedef boost::multi_array<float, 2>  ngtdmat;
-	int sizeMatrix = diffGreyLevels.size();
-	ngtdmat NGTDMatrix(boost::extents[sizeMatrix][3]);
+void NGTDMFeatures2DMRG<T, R>::getNGTDMatrix(const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &neighborHoodSum, boost::multi_array<float, 2> &NGTDMatrix, const VoxelList<T> *voxels) {
+	voxels = sparseVoxels(voxels, inputMatrix);
 	int indexOfElement[3] = { 0,0,0 };
 	std::vector<T> elementsOfWholeNeighborhoods;
 	T sumOfActualNeighborhood;
 	T s;
 	T actualElement;
 	int posActualElement;
-	for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
-		for (int row = 0; row < inputMatrix.shape()[0]; row++) {
-			for (int col = 0; col < inputMatrix.shape()[1]; col++) {
-				indexOfElement[0] = row;
-				indexOfElement[1] = col;
-				indexOfElement[2] = depth;
-				//get actual Element if it is the centre of a whole neighborhood
-				actualElement = inputMatrix[row][col][depth];
-				if (!std::isnan(actualElement)) {
-					//get the sum of the actual neighborhood
-					sumOfActualNeighborhood = neighborHoodSum[row][col][depth];
-					//get the s_i value
-					s = abs(actualElement - sumOfActualNeighborhood);
-					//get the position of the actual Element in the diffGreyLevel vector and so also in the matrix
-					posActualElement = std::find(diffGreyLevels.begin(), diffGreyLevels.end(), actualElement) - diffGreyLevels.begin();
-					//add the s_i value to the right element in the matrix
-					NGTDMatrix[posActualElement][2] += s;
-					NGTDMatrix[posActualElement][0] += 1;
-					//save the actual Element in a vector, so we can calculate later the probabilities
-					elementsOfWholeNeighborhoods.push_back(actualElement);
-				}
-			}
+	forEachVoxel(inputMatrix, voxels, [&](int row, int col, int depth) {
+		indexOfElement[0] = row;
+		indexOfElement[1] = col;
+		indexOfElement[2] = depth;
+		//get actual Element if it is the centre of a whole neighborhood
+		actualElement = inputMatrix[row][col][depth];
+		if (!std::isnan(actualElement)) {
+			//get the sum of the actual neighborhood
+			sumOfActualNeighborhood = neighborHoodSum[row][col][depth];
+			//get the s_i value
+			s = abs(actualElement - sumOfActualNeighborhood);
+			//get the position of the actual Element in the diffGreyLevel vector and so also in the matrix
+			posActualElement = std::find(diffGreyLevels.begin(), diffGreyLevels.end(), actualElement) - diffGreyLevels.begin();
+			//add the s_i value to the right element in the matrix
+			NGTDMatrix[posActualElement][2] += s;
+			NGTDMatrix[posActualElement][0] += 1;
+			//save the actual Element in a vector, so we can calculate later the probabilities
+			elementsOfWholeNeighborhoods.push_back(actualElement);
 		}
-	}
+	});
 	getProbability(elementsOfWholeNeighborhoods, NGTDMatrix);
-	return NGTDMatrix;
 }
 
 
@@ -113,7 +107,7 @@ boost::multi_array<float, 2> NGTDMFeatures2DMRG<T, R>::getNGTDMatrix(boost::mult
 The function calculates the probability matrix of the NGTD matrix, as many features are calculated using the probabilities.
 */
 template <class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::getProbability(vector<T> elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix) {
+void NGTDMFeatures2DMRG<T, R>::getProbability(const vector<T> &elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix) {
 	int numItem = 0;
 	for (int actElementIndex = 0; actElementIndex<diffGreyLevels.size(); actElementIndex++) {
 		numItem += ngtdMatrix[actElementIndex][0];
@@ -131,7 +125,7 @@ void NGTDMFeatures2DMRG<T, R>::getProbability(vector<T> elementsOfWholeNeighborh
 This function returns the number of discretized grey values that have a probability >0
 */
 template<class T, size_t R>
-int NGTDMFeatures2DMRG<T, R>::getNGP(boost::multi_array<float, 2> ngtdm) {
+int NGTDMFeatures2DMRG<T, R>::getNGP(const boost::multi_array<float, 2> &ngtdm) {
 	int ngp = 0;
 	for (int i = 0; i< ngtdm.shape()[0]; i++) {
 		if (ngtdm[i][0] != 0) {
@@ -149,7 +143,7 @@ int NGTDMFeatures2DMRG<T, R>::getNGP(boost::multi_array<float, 2> ngtdm) {
 This function returns the sum of all numbers of voxels in each neighborhood
 */
 template<class T, size_t R>
-int NGTDMFeatures2DMRG<T, R>::getNV(boost::multi_array<float, 2> ngtdm) {
+int NGTDMFeatures2DMRG<T, R>::getNV(const boost::multi_array<float, 2> &ngtdm) {
 	int nv = 0;
 	for (int i = 0; i< ngtdm.shape()[0]; i++) {
 		if (!isnan(ngtdm[i][0])) {
@@ -166,7 +160,7 @@ int NGTDMFeatures2DMRG<T, R>::getNV(boost::multi_array<float, 2> ngtdm) {
 @param[out] int sumSiPi : sum over all products of column entries
 */
 template<class T, size_t R>
-double NGTDMFeatures2DMRG<T, R>::calculateSumSiPi(boost::multi_array<float, 2> ngtdm) {
+double NGTDMFeatures2DMRG<T, R>::calculateSumSiPi(const boost::multi_array<float, 2> &ngtdm) {
 	double sumSiPi = 0;
 	for (int row = 0; row<ngtdm.shape()[0]; row++) {
 		if (!isnan(ngtdm[row][1] * ngtdm[row][2])) {
@@ -183,7 +177,7 @@ double NGTDMFeatures2DMRG<T, R>::calculateSumSiPi(boost::multi_array<float, 2> n
 @param[out] int sumSi : sum over all si
 */
 template<class T, size_t R>
-double NGTDMFeatures2DMRG<T, R>::calculateSumSi(boost::multi_array<float, 2> ngtdm) {
+double NGTDMFeatures2DMRG<T, R>::calculateSumSi(const boost::multi_array<float, 2> &ngtdm) {
 	double sumSi = 0;
 	for (int row = 0; row<ngtdm.shape()[0]; row++) {
 		if (!isnan(ngtdm[row][2])) {
@@ -202,7 +196,7 @@ This function calculate the coarseness of the VOI. The coarseness is an indicato
 \f$ F_{coarseness} = \frac{1}{\sum{i=1}^{N_{g}}p_{i}s{i}}\f$
 */
 template<class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::calculateCoarseness(boost::multi_array<float, 2> ngtdm) {
+void NGTDMFeatures2DMRG<T, R>::calculateCoarseness(const boost::multi_array<float, 2> &ngtdm) {
 	double sumSiPi = calculateSumSiPi(ngtdm);
 	if (sumSiPi != 0) {
 		coarseness = 1 / sumSiPi;
@@ -220,7 +214,7 @@ This function calculate the contrast of the VOI. The value gives information abo
 \f$ F_{contrast} = ( \frac{1}{N_{g, p}(N_{g, p}-1)}\sum{i=1}^{N_{g}}\sum{j=1}^{N_{g}}p_{i}p{j}(i-j)^{2} )\frac{1}\sum{i=1}^{N_{g}} s_{i}}\f$
 */
 template<class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::calculateContrast(boost::multi_array<float, 2> ngtdm) {
+void NGTDMFeatures2DMRG<T, R>::calculateContrast(const boost::multi_array<float, 2> &ngtdm) {
 	int ng = getNGP(ngtdm);
 	int nv = getNV(ngtdm);
 	contrast = 0;
@@ -246,7 +240,7 @@ This function calculate the busyness of the VOI. It gives information about rapi
 \f$ F_{busyness} = ( \frac{\sum{i=1}^{N_{g}}p_{i}s_{i}}{\sum{j=1}^{N_{g}\sum{j=1}^{N_{g}|ip_{i}-jp_{j}|}\f$
 */
 template<class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::calculateBusyness(boost::multi_array<float, 2> ngtdm) {
+void NGTDMFeatures2DMRG<T, R>::calculateBusyness(const boost::multi_array<float, 2> &ngtdm) {
 	double sumSiPi = calculateSumSiPi(ngtdm);
 	double denominator = 0;
 	int ng = getNGP(ngtdm);
@@ -278,7 +272,7 @@ This function calculates the complexity of the VOI. It gives also information ab
 \f$ F_{complexity} = ( \frac{1}{N_{v}} \sum{i=1}^{N_{g}}\sum{j=1}^{N_{g}}|i-j|\frac{p_{i}s_{i}+p_{j}s_{j}}{p_{i}+p_{j}}\f$
 */
 template<class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::calculateComplexity(boost::multi_array<float, 2> ngtdm) {
+void NGTDMFeatures2DMRG<T, R>::calculateComplexity(const boost::multi_array<float, 2> &ngtdm) {
 	int ng = getNGP(ngtdm);
 	int nv = getNV(ngtdm);
 	complexity = 0;
@@ -312,7 +306,7 @@ This function calculates the strength of the VOI. It gives also information abou
 \f$ F_{strength} = ( \frac{\sum{i=1}^{N_{g}}\sum{j=1}^{N_{g}}(p_{i}+p_{j})j)^{2}}{\sum_{i=1}{N_{g}}s_{i}}\f$
 */
 template<class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::calculateStrength(boost::multi_array<float, 2> ngtdm) {
+void NGTDMFeatures2DMRG<T, R>::calculateStrength(const boost::multi_array<float, 2> &ngtdm) {
 	strength = 0;
 	double sumSi = calculateSumSi(ngtdm);
 	for (int row = 0; row < ngtdm.shape()[0]; row++) {
@@ -332,12 +326,14 @@ void NGTDMFeatures2DMRG<T, R>::calculateStrength(boost::multi_array<float, 2> ng
 
 
 template <class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::calculateAllNGTDMFeatures2DMRG(NGTDMFeatures2DMRG<T, R> &ngtdm, Image<T, R> imageAttr, boost::multi_array<T, R> neighborHoodSum, vector<float> spacing, ConfigFile config) {
+void NGTDMFeatures2DMRG<T, R>::calculateAllNGTDMFeatures2DMRG(NGTDMFeatures2DMRG<T, R> &ngtdm, const Image<T, R> &imageAttr, const boost::multi_array<T, R> &neighborHoodSum, const vector<float> &spacing, const ConfigFile &config) {
 	dist = config.dist;
 	this->diffGreyLevels = imageAttr.diffGreyLevels;
 	actualSpacing = spacing;
 	normNGTDM = config.normNGTDM;
-	boost::multi_array<float, 2> ngtdmMatrix = getNGTDMatrix(imageAttr.imageMatrix, neighborHoodSum);
+	ScratchMatrix<float> ngtdmMatrixBuffer(this->diffGreyLevels.size(), 3);
+	boost::multi_array<float, 2> &ngtdmMatrix = ngtdmMatrixBuffer.get();
+	getNGTDMatrix(imageAttr.imageMatrix, neighborHoodSum, ngtdmMatrix, imageAttr.getVoxelList());
 	calculateCoarseness(ngtdmMatrix);
 	calculateContrast(ngtdmMatrix);
 	calculateBusyness(ngtdmMatrix);
@@ -367,7 +363,7 @@ void NGTDMFeatures2DMRG<T, R>::writeCSVFileNGTDM(NGTDMFeatures2DMRG<T, R> ngtdmF
 }
 
 template <class T, size_t R>
-void NGTDMFeatures2DMRG<T, R>::writeOneFileNGTDM(NGTDMFeatures2DMRG<T, R> ngtdmFeatures, ConfigFile config, int &parameterSpaceNr) {
+void NGTDMFeatures2DMRG<T, R>::writeOneFileNGTDM(NGTDMFeatures2DMRG<T, R> ngtdmFeatures, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -29,13 +29,13 @@ private:
 	int dist;
 
 	void extractNGTDMData3D(vector<T> &ngtdmData, NGTDMFeatures3D<T, R> ngtdmFeatures);
-	boost::multi_array<float, 2> getNGTDMatrix3D(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> sumMatrix);
+	void getNGTDMatrix3D(const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &sumMatrix, boost::multi_array<float, 2> &NGTDMatrix, const VoxelList<T> *voxels = nullptr);
 
 public:
-	void getProbability(vector<T> elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix);
-	void calculateAllNGTDMFeatures3D(NGTDMFeatures3D<T, R> &ngtdm, boost::multi_array<T, R> sumMatrix, Image<T, R> imageAttr, vector<float> spacing, ConfigFile config);
+	void getProbability(const vector<T> &elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix);
+	void calculateAllNGTDMFeatures3D(NGTDMFeatures3D<T, R> &ngtdm, const boost::multi_array<T, R> &sumMatrix, const Image<T, R> &imageAttr, const vector<float> &spacing, const ConfigFile &config);
 	void writeCSVFileNGTDM3D(NGTDMFeatures3D<T, R> ngtdmFeatures, string outputFolder);
-	void writeOneFileNGTDM3D(NGTDMFeatures3D<T, R> ngtdmFeatures, ConfigFile config, int &parameterSpaceNr);
+	void writeOneFileNGTDM3D(NGTDMFeatures3D<T, R> ngtdmFeatures, const ConfigFile &config, int &parameterSpaceNr);
 
 
 };
@@ -46,45 +46,39 @@ public:
 In this function the NGTDM is filled for the 3D case.
 @param[in] boost multi array inputMatrix: matrix filled with intensity values
 @param[in] boost multi array inputMatrix: sumMatrix calculated before, this matrix contains for every voxel the sum of the neighborhood
-@param[out] boost multi array: filled NGTD matrix
+@param[out] NGTDMatrix: filled NGTD matrix, it has the size number of grey levels x 3 and is set to 0
+@param[in] voxels: voxel list of the VOI matrix if the mask is sparse, otherwise nullptr
 
 */
 template <class T, size_t R>
-boost::multi_array<float, 2> NGTDMFeatures3D<T, R>::getNGTDMatrix3D(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> sumMatrix) {
-	typedef boost::multi_array<float, 2>  ngtdmat;
-	int sizeMatrix = this->diffGreyLevels.size();
-	ngtdmat NGTDMatrix(boost::extents[sizeMatrix][3]);
+void NGTDMFeatures3D<T, R>::getNGTDMatrix3D(const boost::multi_array<T, R> &inputMatrix, const boost::multi_array<T, R> &sumMatrix, boost::multi_array<float, 2> &NGTDMatrix, const VoxelList<T> *voxels) {
+	voxels = sparseVoxels(voxels, inputMatrix);
 	std::vector<T> elementsOfWholeNeighborhoods;
 	T sumOfActualNeighborhood;
 	T s;
 	T actualElement;
 	int posActualElement;
 	//calculate NGTDM for every element of the original matrix
-	for (int depth = 0; depth<inputMatrix.shape()[2]; depth++) {
-		for (int row = 0; row<inputMatrix.shape()[0]; row++) {
-			for (int col = 0; col<inputMatrix.shape()[1]; col++) {
-				
-				//get actual Element if it is the centre of a whole neighborhood
-				actualElement = inputMatrix[row][col][depth];
-				if (!std::isnan(actualElement)) {
-					//get the sum of the actual neighborhood
-					sumOfActualNeighborhood = sumMatrix[row][col][depth ];
-					//get the s_i value
-					s = abs(actualElement - sumOfActualNeighborhood);
-					posActualElement = std::find(this->diffGreyLevels.begin(), this->diffGreyLevels.end(), actualElement) - this->diffGreyLevels.begin();
-					//add the s_i value to the right element in the matrix
-					NGTDMatrix[posActualElement][2] += s;
-					NGTDMatrix[posActualElement][0] += 1;
-
-					//save the actual Element in a vector, so we can calculate later the probabilities
-					elementsOfWholeNeighborhoods.push_back(actualElement);
-				}
-
-			}
+	forEachVoxel(inputMatrix, voxels, [&](int row, int col, int depth) {
+		
+		//get actual Element if it is the centre of a whole neighborhood
+		actualElement = inputMatrix[row][col][depth];
+		if (!std::isnan(actualElement)) {
+			//get the sum of the actual neighborhood
+			sumOfActualNeighborhood = sumMatrix[row][col][depth ];
+			//get the s_i value
+			s = abs(actualElement - sumOfActualNeighborhood);
+			posActualElement = std::find(this->diffGreyLevels.begin(), this->diffGreyLevels.end(), actualElement) - this->diffGreyLevels.begin();
+			//add the s_i value to the right element in the matrix
+			NGTDMatrix[posActualElement][2] += s;
+			NGTDMatrix[posActualElement][0] += 1;
+
+			//save the actual Element in a vector, so we can calculate later the probabilities
+			elementsOfWholeNeighborhoods.push_back(actualElement);
 		}
-	}
+
+	});
 	getProbability(elementsOfWholeNeighborhoods, NGTDMatrix);
-	return NGTDMatrix;
 }
 
 
@@ -98,7 +92,7 @@ In this function the second row is filled with the probability.
 
 */
 template <class T, size_t R>
-void NGTDMFeatures3D<T, R>::getProbability(vector<T> elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix) {
+void NGTDMFeatures3D<T, R>::getProbability(const vector<T> &elementsOfWholeNeighborhood, boost::multi_array<float, 2> &ngtdMatrix) {
 	int numItem = 0;
 	for (int actElementIndex = 0; actElementIndex<this->diffGreyLevels.size(); actElementIndex++) {
 		numItem += ngtdMatrix[actElementIndex][0];
@@ -110,12 +104,14 @@ void NGTDMFeatures3D<T, R>::getProbability(vector<T> elementsOfWholeNeighborhood
 
 
 template <class T, size_t R>
-void NGTDMFeatures3D<T, R>::calculateAllNGTDMFeatures3D(NGTDMFeatures3D<T, R> &ngtdm, boost::multi_array<T, R> sumMatrix, Image<T, R> imageAttr, vector<float> spacing, ConfigFile config) {
+void NGTDMFeatures3D<T, R>::calculateAllNGTDMFeatures3D(NGTDMFeatures3D<T, R> &ngtdm, const boost::multi_array<T, R> &sumMatrix, const Image<T, R> &imageAttr, const vector<float> &spacing, const ConfigFile &config) {
 	this->diffGreyLevels = imageAttr.diffGreyLevels;
 	actualSpacing = spacing;
 	normNGTDM = config.normNGTDM;
 	dist = config.dist;
-	boost::multi_array<float, 2> ngtdMatrix = getNGTDMatrix3D(imageAttr.imageMatrix, sumMatrix);
+	ScratchMatrix<float> ngtdMatrixBuffer(this->diffGreyLevels.size(), 3);
+	boost::multi_array<float, 2> &ngtdMatrix = ngtdMatrixBuffer.get();
+	getNGTDMatrix3D(imageAttr.imageMatrix, sumMatrix, ngtdMatrix, imageAttr.getVoxelList());
 
 	ngtdm.calculateCoarseness(ngtdMatrix);
 	ngtdm.calculateContrast(ngtdMatrix);
@@ -149,7 +145,7 @@ void NGTDMFeatures3D<T, R>::writeCSVFileNGTDM3D(NGTDMFeatures3D<T, R> ngtdmFeatu
 
 
 template <class T, size_t R>
-void NGTDMFeatures3D<T, R>::writeOneFileNGTDM3D(NGTDMFeatures3D<T, R> ngtdmFeatures, ConfigFile config, int &parameterSpaceNr) {
+void NGTDMFeatures3D<T, R>::writeOneFileNGTDM3D(NGTDMFeatures3D<T, R> ngtdmFeatures, const ConfigFile &config, int &parameterSpaceNr) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -0,0 +1,248 @@
+/*!
+\brief PhantomBenchmark
+The constructor sets the feature families that are calculated on their own (sections and keys of the feature selection file).
+*/
+PhantomBenchmark::PhantomBenchmark() : seed(5489) {
+	families = {
+		{ "ExactMetrics", "ExactMetrics", "CalculateExactMetrics" },
+		{ "DispersityFeatures", "DispersityFeatures", "CalculateDispersityFeat" },
+		{ "MorphologicalFeatures", "MorphologicalFeatures", "CalculateMorphologicalFeat" },
+		{ "LocalIntensityFeatures", "LocalIntensityFeatures", "CalculateLocalIntFeat" },
+		{ "StatisticalFeatures", "StatisticalFeatures", "CalculateStatFeat" },
+		{ "IntensityVolume", "IntensityVolume", "CalculateIntensityVolume" },
+		{ "IntensityHistogramFeatures", "IntensityHistogramFeatures", "CalculateIntensityHistogramFeat" },
+		{ "GLCMFeatures2DAVG", "GLCMFeatures2DAVG", "CalculateGLCMFeatures2DAVG" },
+		{ "GLCMFeatures2DDMRG", "GLCMFeatures2DDMRG", "CalculateGLCMFeatures2DDMRG" },
+		{ "GLCMFeatures2DMRG", "GLCMFeatures2DMRG", "CalculateGLCMFeatures2DMRG" },
+		{ "GLCMFeatures2DVMRG", "GLCMFeatures2DVMRG", "CalculateGLCMFeatures2DVMRG" },
+		{ "GLCMFeatures3DAVG", "GLCMFeatures3DAVG", "CalculateGLCMFeatures3DAVG" },
+		{ "GLCMFeatures3DMRG", "GLCMFeatures3DMRG", "CalculateGLCMFeatures3DMRG" },
+		{ "GLRLMFeatures2DAVG", "GLRLMFeatures2DAVG", "CalculateGLRLMFeatures2DAVG" },
+		{ "GLRLMFeatures2DDMRG", "GLRLMFeatures2DDMRG", "CalculateGLRLMFeatures2DDMRG" },
+		{ "GLRLMFeatures2DMRG", "GLRLMFeatures2DMRG", "CalculateGLRLMFeatures2DMRG" },
+		{ "GLRLMFeatures2DVMRG", "GLRLMFeatures2DVMRG", "CalculateGLRLMFeatures2DVMRG" },
+		{ "GLRLMFeatures3DAVG", "GLRLMFeatures3DAVG", "CalculateGLRLMFeatures3DAVG" },
+		{ "GLRLMFeatures3DMRG", "GLRLMFeatures3DMRG", "CalculateGLRLMFeatures3DMRG" },
+		{ "GLSZMFeatures2DAVG", "GLSZMFeatures2DAVG", "CalculateGLSZMFeatures2DAVG" },
+		{ "GLSZMFeatures2DMRG", "GLSZMFeatures2DMRG", "CalculateGLSZMFeatures2DMRG" },
+		{ "GLSZMFeatures3D", "GLSZMFeatures3D", "CalculateGLSZMFeatures3D" },
+		{ "NGTDMFeatures2DAVG", "NGTDMFeatures2DAVG", "CalculateNGTDMFeatures2DAVG" },
+		{ "NGTDMFeatures2DMRG", "NGTDMFeatures2DMRG", "CalculateNGTDMFeatures2DMRG" },
+		{ "NGTDMFeatures3D", "NGTDMFeatures3D", "CalculateNGTDMFeatures3D" },
+		{ "GLDZMFeatures2D", "GLDZMFeatures2D", "CalculateGLDZMFeatures2D" },
+		{ "GLDZMFeatures2DAVG", "GLDZMFeatures2DAVG", "CalculateGLDZMFeatures2DAVG" },
+		{ "GLDZMFeatures3D", "GLDZMFeatures3D", "CalculateGLDZMFeatures3D" },
+		{ "NGLDMFeatures2DAVG", "NGLDMFeatures2DAVG", "CalculateNGLDMFeatures2DAVG" },
+		{ "NGLDMFeatures2DMRG", "NGLDMFeatures2DMRG", "CalculateNGLDMFeatures2DMRG" },
+		{ "NGLDMFeatures3D", "NGLDMFeatures3D", "CalculateNGLDMFeatures3D" }
+	};
+}
+
+//uniform random number in [0, 1), calculated directly from the generator so that it is the same for every standard library
+double PhantomBenchmark::getUniform(mt19937 &generator) const {
+	return double(generator()) / 4294967296.0;
+}
+
+//empty cube with 1 mm voxels
+ImageType::Pointer PhantomBenchmark::createImage(int size) const {
+	ImageType::Pointer image = ImageType::New();
+	ImageType::IndexType start;
+	start.Fill(0);
+	ImageType::SizeType imageSize;
+	imageSize.Fill(size);
+	RegionType region;
+	region.SetIndex(start);
+	region.SetSize(imageSize);
+	image->SetRegions(region);
+	ImageType::SpacingType spacing;
+	spacing.Fill(1.0);
+	image->SetSpacing(spacing);
+	image->Allocate();
+	image->FillBuffer(0);
+	return image;
+}
+
+/*!
+\brief createPhantom
+The function createPhantom creates the image and the mask of one phantom. Apart from the noise phantom, the image is a smooth texture
+(periods of 8 and 12 voxels) with a gradient along z and approximately Gaussian noise; the lesions of the multi-lesion phantom are 200 higher.
+@param[in] phantom: shape of the phantom (sphere, ellipsoid, multiLesion or noise)
+@param[in] size: edge length of the phantom in voxels
+@param[out] image: image of the phantom
+@param[out] mask: mask of the phantom (1 inside, 0 outside)
+@param[out] bool: false if the shape is not available
+*/
+bool PhantomBenchmark::createPhantom(const string &phantom, int size, ImageType::Pointer &image, ImageType::Pointer &mask) const {
+	if (phantom != "sphere" && phantom != "ellipsoid" && phantom != "multiLesion" && phantom != "noise") {
+		std::cout << "The phantom " << phantom << " is not available (sphere, ellipsoid, multiLesion, noise), it is ignored" << std::endl;
+		return false;
+	}
+	const double pi = 3.141592653589793238463;
+	image = createImage(size);
+	mask = createImage(size);
+	float *imageValues = image->GetBufferPointer();
+	float *maskValues = mask->GetBufferPointer();
+	mt19937 generator(seed + uint32_t(size));
+	double center = (size - 1) / 2.0;
+	//every lesion is stored as x, y, z and radius
+	vector<double> lesions;
+	if (phantom == "multiLesion") {
+		for (int lesion = 0; lesion < 6; lesion++) {
+			for (int axis = 0; axis < 3; axis++) {
+				lesions.push_back((0.2 + 0.6 * getUniform(generator)) * (size - 1));
+			}
+			lesions.push_back(std::max(1.0, (0.08 + 0.07 * getUniform(generator)) * size));
+		}
+	}
+	size_t index = 0;
+	for (int z = 0; z < size; z++) {
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++, index++) {
+				double dx = x - center;
+				double dy = y - center;
+				double dz = z - center;
+				bool inside = false;
+				double value;
+				if (phantom == "noise") {
+					inside = std::max(std::abs(dx), std::max(std::abs(dy), std::abs(dz))) <= 0.4 * size;
+					value = 1000 * getUniform(generator);
+				}
+				else {
+					double noise = getUniform(generator) + getUniform(generator) + getUniform(generator) - 1.5;
+					value = 100 + 30 * sin(2 * pi * x / 8) * cos(2 * pi * y / 12) + 20.0 * z / size + 20 * noise;
+					if (phantom == "sphere") {
+						inside = dx * dx + dy * dy + dz * dz <= 0.16 * size * size;
+					}
+					else if (phantom == "ellipsoid") {
+						inside = pow(dx / (0.45 * size), 2) + pow(dy / (0.3 * size), 2) + pow(dz / (0.2 * size), 2) <= 1;
+					}
+					else {
+						for (size_t lesion = 0; lesion < lesions.size() && !inside; lesion += 4) {
+							double distance = pow(x - lesions[lesion], 2) + pow(y - lesions[lesion + 1], 2) + pow(z - lesions[lesion + 2], 2);
+							if (distance <= lesions[lesion + 3] * lesions[lesion + 3]) {
+								inside = true;
+								value += 200;
+							}
+						}
+					}
+				}
+				imageValues[index] = float(value);
+				maskValues[index] = inside ? 1 : 0;
+			}
+		}
+	}
+	return true;
+}
+
+//feature selection file that contains only one family (all families are set, because some are calculated if they are missing)
+bool PhantomBenchmark::writeFeatureSelection(const string &fileName, const Family &family) const {
+	ofstream featureSelection(fileName);
+	if (!featureSelection) {
+		std::cout << "The feature selection file " << fileName << " cannot be written" << std::endl;
+		return false;
+	}
+	for (size_t i = 0; i < families.size(); i++) {
+		featureSelection << "[" << families[i].section << "]\n";
+		featureSelection << families[i].key << " = " << (families[i].section == family.section ? 1 : 0) << "\n";
+	}
+	return true;
+}
+
+/*!
+\brief calculateRun
+The function calculateRun calculates the features of one phantom with calculateMaskFeatures and returns the wall time in seconds.
+The output of the last run with the same output name is overwritten.
+*/
+double PhantomBenchmark::calculateRun(ImageType *image, ImageType *mask, const MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config) const {
+	std::error_code error;
+	std::filesystem::remove(config.outputFolder + ".log", error);
+	ofstream csvOutput(config.outputFolder + ".csv", ios::trunc);
+	csvOutput.close();
+	config.createOutputFile(config);
+	//calculateMaskFeatures releases the image and the mask it gets, the phantom is kept for the next run
+	ImageType::Pointer runImage = image;
+	ImageType::Pointer runMask = mask;
+	MaskAnalysis runAnalysis = maskAnalysis;
+	resetPeakMemory();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	calculateMaskFeatures(runImage, runMask, runAnalysis, grid, config);
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/*!
+\brief run
+The function run calculates all phantoms, sizes and numbers of bins of the config and writes one line per run to outputFolder_benchmark.csv:
+phantom, size, number of bins, number of voxels of the phantom and of the mask, family, wall time in seconds, throughput (voxels of the
+phantom per second) and peak memory in MB. The phantoms are smoothed and resampled like images, if this is set in the config.
+@param[in] ConfigFile config: config file with all information of the config.ini file (see createBenchmarkConfigInfo)
+@param[out] bool: false if the results cannot be written
+*/
+bool PhantomBenchmark::run(ConfigFile config) const {
+	string resultName = config.outputFolder + "_benchmark.csv";
+	string runFolder = config.outputFolder + "_benchmarkOutput";
+	std::error_code error;
+	std::filesystem::create_directories(runFolder, error);
+	ofstream results(resultName);
+	if (!results) {
+		std::cout << "The benchmark results cannot be written to " << resultName << std::endl;
+		return false;
+	}
+	results << "Phantom,Size,NrBins,NrVoxels,NrVoxelsInMask,Family,Seconds,VoxelsPerSecond,PeakMemoryMB\n";
+	//the preparation run has a feature selection without any family, the end-to-end run calculates all features
+	vector<Family> runs;
+	if (config.benchmarkFamilies == 1) {
+		runs.push_back({ "Preparation", "", "" });
+		runs.insert(runs.end(), families.begin(), families.end());
+	}
+	for (size_t i = 0; i < runs.size(); i++) {
+		if (!writeFeatureSelection(runFolder + "/" + runs[i].name + "_featureSelection.ini", runs[i])) {
+			return false;
+		}
+	}
+	size_t nrSelectionRuns = runs.size();
+	if (config.benchmarkEndToEnd == 1) {
+		runs.push_back({ "EndToEnd", "", "" });
+	}
+	for (size_t phantomNr = 0; phantomNr < config.benchmarkPhantoms.size(); phantomNr++) {
+		const string &phantom = config.benchmarkPhantoms[phantomNr];
+		for (size_t sizeNr = 0; sizeNr < config.benchmarkSizes.size(); sizeNr++) {
+			int size = config.benchmarkSizes[sizeNr];
+			ImageType::Pointer image;
+			ImageType::Pointer mask;
+			if (!createPhantom(phantom, size, image, mask)) {
+				break;
+			}
+			MaskAnalysis maskAnalysis;
+			maskAnalysis.analyse(mask, config.threshold);
+			smoothImageRegion(image, maskAnalysis.nonZeroRegion, config);
+			ResampleGrid grid;
+			if (config.useSamplingCubic == 1 || config.useDownSampling != 0 || config.useUpSampling != 0) {
+				grid = getResampleGrid(image, config);
+			}
+			size_t nrVoxels = size_t(size) * size * size;
+			for (size_t binNr = 0; binNr < config.benchmarkNrBins.size(); binNr++) {
+				ConfigFile binConfig = config;
+				binConfig.useFixedBinWidth = 0;
+				binConfig.useFixedNrBins = 1;
+				binConfig.nrBins = config.benchmarkNrBins[binNr];
+				for (size_t runNr = 0; runNr < runs.size(); runNr++) {
+					ConfigFile runConfig = binConfig;
+					runConfig.outputFolder = runFolder + "/" + runs[runNr].name;
+					if (runNr < nrSelectionRuns) {
+						runConfig.calculateAllFeatures = 0;
+						runConfig.featureSelectionLocation = runConfig.outputFolder + "_featureSelection.ini";
+					}
+					double seconds = calculateRun(image, mask, maskAnalysis, grid, runConfig);
+					double peakMemory = getPeakMemoryMB();
+					results << phantom << "," << size << "," << binConfig.nrBins << "," << nrVoxels << "," << maskAnalysis.nrVoxels << ","
+						<< runs[runNr].name << "," << seconds << "," << (seconds > 0 ? double(nrVoxels) / seconds : 0) << "," << peakMemory << "\n";
+					results.flush();
+					std::cout << "Benchmark " << phantom << " " << size << " voxels " << binConfig.nrBins << " bins " << runs[runNr].name
+						<< ": " << seconds << " s, " << peakMemory << " MB" << std::endl;
+				}
+			}
+		}
+	}
+	std::cout << "The benchmark results are stored in the file " << resultName << std::endl;
+	return true;
+}
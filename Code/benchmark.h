@@ -0,0 +1,63 @@
+#ifndef BENCHMARK_H_INCLUDED
+#define BENCHMARK_H_INCLUDED
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "itkTypes.h"
+#include "readConfigFile.h"
+#include "featureCalculation.h"
+#include "stageTrace.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+/*!
+The class PhantomBenchmark calculates the features of synthetic phantoms, so that the run time of the feature families can be compared
+between versions and for growing VOIs (see the section Benchmark of the config file): \n
+- sphere: sphere with a radius of 40% of the edge length \n
+- ellipsoid: ellipsoid with half axes of 45%, 30% and 20% of the edge length \n
+- multiLesion: six small spheres (hot lesions) scattered in the volume, the mask is one label \n
+- noise: cube of 80% of the edge length filled with uniform noise (the worst case for the size zone and run length matrices) \n
+The phantoms are cubes with 1 mm voxels. All values are calculated from a Mersenne twister with a fixed seed (without the distributions of
+the standard library, whose results differ between compilers), so the phantoms are the same on every machine. \n
+For every phantom, size and number of bins the mask is calculated with calculateMaskFeatures like the mask of an image: once without
+features (Preparation: preprocessing, discretization and writing of the output, which is part of every other run), once for every feature
+family on its own (with a feature selection file that only contains this family) and once with all features (EndToEnd). \n
+For every run, the wall time, the throughput (voxels of the phantom per second) and the peak memory of the process are written to
+outputFolder_benchmark.csv. The feature values of the last run of every family are kept in the folder outputFolder_benchmarkOutput.
+*/
+class PhantomBenchmark {
+private:
+	//feature family: section and key of the feature selection file (empty for the runs without feature selection)
+	struct Family {
+		string name;
+		string section;
+		string key;
+	};
+	vector<Family> families;
+	uint32_t seed;
+
+	double getUniform(mt19937 &generator) const;
+	ImageType::Pointer createImage(int size) const;
+	bool writeFeatureSelection(const string &fileName, const Family &family) const;
+	double calculateRun(ImageType *image, ImageType *mask, const MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config) const;
+
+public:
+	PhantomBenchmark();
+	~PhantomBenchmark() {
+	}
+	bool createPhantom(const string &phantom, int size, ImageType::Pointer &image, ImageType::Pointer &mask) const;
+	bool run(ConfigFile config) const;
+};
+
+#include "benchmark.cpp"
+
+#endif // BENCHMARK_H_INCLUDED
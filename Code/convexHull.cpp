@@ -0,0 +1,493 @@
+/*!
+\brief getDistance
+The function getDistance returns the signed distance of a point to the plane of a face (positive outside the hull).
+*/
+double ConvexHull::getDistance(const HullFace &face, int pointNr) const {
+	const double *point = &points[3 * size_t(pointNr)];
+	return face.normal[0] * point[0] + face.normal[1] * point[1] + face.normal[2] * point[2] - face.offset;
+}
+
+/*!
+\brief createFace
+The function createFace adds the triangle (a, b, c) to the faces and calculates its plane.
+@param[out] int: number of the new face
+*/
+int ConvexHull::createFace(int a, int b, int c) {
+	HullFace face;
+	face.vertex[0] = a;
+	face.vertex[1] = b;
+	face.vertex[2] = c;
+	face.neighbour[0] = face.neighbour[1] = face.neighbour[2] = -1;
+	face.deleted = false;
+	face.visitNr = -1;
+	const double *pa = &points[3 * size_t(a)];
+	const double *pb = &points[3 * size_t(b)];
+	const double *pc = &points[3 * size_t(c)];
+	double ab[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+	double ac[3] = { pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2] };
+	face.normal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+	face.normal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+	face.normal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+	double length = std::sqrt(face.normal[0] * face.normal[0] + face.normal[1] * face.normal[1] + face.normal[2] * face.normal[2]);
+	if (length > 0) {
+		for (int i = 0; i < 3; i++) {
+			face.normal[i] /= length;
+		}
+	}
+	face.offset = face.normal[0] * pa[0] + face.normal[1] * pa[1] + face.normal[2] * pa[2];
+	faces.push_back(face);
+	return int(faces.size()) - 1;
+}
+
+/*!
+\brief createSimplex
+The function createSimplex creates the first tetrahedron of the hull from four extreme points and assigns all other
+points to the face they are outside of.
+@param[out] bool: false if all points are on a plane (then there is no 3D hull)
+*/
+bool ConvexHull::createSimplex() {
+	int nrPoints = int(points.size() / 3);
+	auto point = [&](int pointNr) { return &points[3 * size_t(pointNr)]; };
+	auto squaredDistance = [&](int p1, int p2) {
+		double sum = 0;
+		for (int i = 0; i < 3; i++) {
+			sum += (point(p1)[i] - point(p2)[i]) * (point(p1)[i] - point(p2)[i]);
+		}
+		return sum;
+	};
+	//the two points with the largest distance among the extreme points in x, y and z direction
+	int extremes[6] = { 0, 0, 0, 0, 0, 0 };
+	for (int p = 1; p < nrPoints; p++) {
+		for (int i = 0; i < 3; i++) {
+			if (point(p)[i] < point(extremes[2 * i])[i]) {
+				extremes[2 * i] = p;
+			}
+			if (point(p)[i] > point(extremes[2 * i + 1])[i]) {
+				extremes[2 * i + 1] = p;
+			}
+		}
+	}
+	int simplex[4] = { extremes[0], extremes[1], 0, 0 };
+	for (int i = 0; i < 6; i++) {
+		for (int j = i + 1; j < 6; j++) {
+			if (squaredDistance(extremes[i], extremes[j]) > squaredDistance(simplex[0], simplex[1])) {
+				simplex[0] = extremes[i];
+				simplex[1] = extremes[j];
+			}
+		}
+	}
+	double extent = std::sqrt(squaredDistance(simplex[0], simplex[1]));
+	tolerance = extent * 1e-9;
+	if (extent == 0) {
+		return false;
+	}
+	//the point with the largest distance to the line between the first two points
+	double maxDistance = 0;
+	const double *p0 = point(simplex[0]);
+	double direction[3] = { point(simplex[1])[0] - p0[0], point(simplex[1])[1] - p0[1], point(simplex[1])[2] - p0[2] };
+	for (int p = 0; p < nrPoints; p++) {
+		double diff[3] = { point(p)[0] - p0[0], point(p)[1] - p0[1], point(p)[2] - p0[2] };
+		double cross[3] = { diff[1] * direction[2] - diff[2] * direction[1], diff[2] * direction[0] - diff[0] * direction[2],
+			diff[0] * direction[1] - diff[1] * direction[0] };
+		double distance = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]) / extent;
+		if (distance > maxDistance) {
+			maxDistance = distance;
+			simplex[2] = p;
+		}
+	}
+	if (maxDistance <= tolerance) {
+		return false;
+	}
+	//the point with the largest distance to the plane of the first three points
+	int base = createFace(simplex[0], simplex[1], simplex[2]);
+	maxDistance = 0;
+	for (int p = 0; p < nrPoints; p++) {
+		double distance = std::abs(getDistance(faces[base], p));
+		if (distance > maxDistance) {
+			maxDistance = distance;
+			simplex[3] = p;
+		}
+	}
+	faces.clear();
+	if (maxDistance <= tolerance) {
+		return false;
+	}
+	//the faces of the tetrahedron, oriented such that the fourth point is inside
+	const int tetrahedron[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 }, { 2, 3, 0, 1 } };
+	for (int f = 0; f < 4; f++) {
+		int faceNr = createFace(simplex[tetrahedron[f][0]], simplex[tetrahedron[f][1]], simplex[tetrahedron[f][2]]);
+		if (getDistance(faces[faceNr], simplex[tetrahedron[f][3]]) > 0) {
+			faces.pop_back();
+			createFace(simplex[tetrahedron[f][0]], simplex[tetrahedron[f][2]], simplex[tetrahedron[f][1]]);
+		}
+	}
+	for (int f = 0; f < 4; f++) {
+		for (int i = 0; i < 3; i++) {
+			int a = faces[f].vertex[i];
+			int b = faces[f].vertex[(i + 1) % 3];
+			for (int g = 0; g < 4; g++) {
+				for (int j = 0; j < 3; j++) {
+					if (g != f && faces[g].vertex[j] == b && faces[g].vertex[(j + 1) % 3] == a) {
+						faces[f].neighbour[i] = g;
+					}
+				}
+			}
+		}
+	}
+	for (int p = 0; p < nrPoints; p++) {
+		if (p == simplex[0] || p == simplex[1] || p == simplex[2] || p == simplex[3]) {
+			continue;
+		}
+		for (int f = 0; f < 4; f++) {
+			if (getDistance(faces[f], p) > tolerance) {
+				faces[f].outside.push_back(p);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+/*!
+\brief addPoint
+The function addPoint adds the point that is farthest outside of a face to the hull. \n
+All faces that can be seen from the point are removed, the edges between removed and remaining faces (the horizon)
+are connected to the new point and the outside points of the removed faces are assigned to the new faces.
+@param[in] faceNr: face with at least one outside point
+@param[in,out] faceStack: the new faces that have outside points are added
+*/
+void ConvexHull::addPoint(int faceNr, vector<int> &faceStack) {
+	int eye = faces[faceNr].outside[0];
+	double maxDistance = getDistance(faces[faceNr], eye);
+	for (int pointNr : faces[faceNr].outside) {
+		double distance = getDistance(faces[faceNr], pointNr);
+		if (distance > maxDistance) {
+			maxDistance = distance;
+			eye = pointNr;
+		}
+	}
+	//find the visible faces and the horizon (edge a -> b of a visible face and the face behind it)
+	nrVisits++;
+	vector<int> visibleFaces;
+	vector<array<int, 3> > horizon;
+	vector<int> stack(1, faceNr);
+	faces[faceNr].visitNr = nrVisits;
+	while (!stack.empty()) {
+		int actFace = stack.back();
+		stack.pop_back();
+		visibleFaces.push_back(actFace);
+		for (int i = 0; i < 3; i++) {
+			int neighbour = faces[actFace].neighbour[i];
+			if (faces[neighbour].visitNr == nrVisits) {
+				continue;
+			}
+			if (getDistance(faces[neighbour], eye) > tolerance) {
+				faces[neighbour].visitNr = nrVisits;
+				stack.push_back(neighbour);
+			}
+			else {
+				horizon.push_back({ { faces[actFace].vertex[i], faces[actFace].vertex[(i + 1) % 3], neighbour } });
+			}
+		}
+	}
+	//connect the horizon to the new point
+	unordered_map<int, int> faceByFirstVertex;
+	unordered_map<int, int> faceBySecondVertex;
+	vector<int> newFaces;
+	for (const array<int, 3> &edge : horizon) {
+		int newFace = createFace(edge[0], edge[1], eye);
+		faces[newFace].neighbour[0] = edge[2];
+		HullFace &behind = faces[edge[2]];
+		for (int j = 0; j < 3; j++) {
+			if (behind.vertex[j] == edge[1] && behind.vertex[(j + 1) % 3] == edge[0]) {
+				behind.neighbour[j] = newFace;
+			}
+		}
+		faceByFirstVertex[edge[0]] = newFace;
+		faceBySecondVertex[edge[1]] = newFace;
+		newFaces.push_back(newFace);
+	}
+	for (int newFace : newFaces) {
+		faces[newFace].neighbour[1] = faceByFirstVertex[faces[newFace].vertex[1]];
+		faces[newFace].neighbour[2] = faceBySecondVertex[faces[newFace].vertex[0]];
+	}
+	//the outside points of the removed faces are assigned to the new faces, points inside the hull are dropped
+	for (int visibleFace : visibleFaces) {
+		for (int pointNr : faces[visibleFace].outside) {
+			if (pointNr == eye) {
+				continue;
+			}
+			for (int newFace : newFaces) {
+				if (getDistance(faces[newFace], pointNr) > tolerance) {
+					faces[newFace].outside.push_back(pointNr);
+					break;
+				}
+			}
+		}
+		faces[visibleFace].outside.clear();
+		faces[visibleFace].outside.shrink_to_fit();
+		faces[visibleFace].deleted = true;
+	}
+	for (int newFace : newFaces) {
+		if (!faces[newFace].outside.empty()) {
+			faceStack.push_back(newFace);
+		}
+	}
+}
+
+/*!
+\brief calculate
+The function calculate builds the convex hull of the points.
+@param[in] pointCoordinates: coordinates (x, y, z) of the points
+@param[out] bool: false if the points do not span a volume, then all points are used as hull vertices
+*/
+bool ConvexHull::calculate(const vector<double> &pointCoordinates) {
+	points = pointCoordinates;
+	faces.clear();
+	hullVertices.clear();
+	int nrPoints = int(points.size() / 3);
+	if (nrPoints < 4 || !createSimplex()) {
+		faces.clear();
+		for (int p = 0; p < nrPoints; p++) {
+			hullVertices.push_back(p);
+		}
+		return false;
+	}
+	vector<int> faceStack;
+	for (int f = 0; f < 4; f++) {
+		if (!faces[f].outside.empty()) {
+			faceStack.push_back(f);
+		}
+	}
+	while (!faceStack.empty()) {
+		int faceNr = faceStack.back();
+		faceStack.pop_back();
+		if (faces[faceNr].deleted || faces[faceNr].outside.empty()) {
+			continue;
+		}
+		addPoint(faceNr, faceStack);
+	}
+	//remove the deleted faces, the neighbours are not needed anymore
+	faces.erase(std::remove_if(faces.begin(), faces.end(), [](const HullFace &face) { return face.deleted; }), faces.end());
+	vector<bool> isVertex(nrPoints, false);
+	for (const HullFace &face : faces) {
+		for (int i = 0; i < 3; i++) {
+			isVertex[face.vertex[i]] = true;
+		}
+	}
+	for (int p = 0; p < nrPoints; p++) {
+		if (isVertex[p]) {
+			hullVertices.push_back(p);
+		}
+	}
+	return true;
+}
+
+/*!
+\brief getVolume
+The function getVolume returns the volume of the hull (sum of the signed volumes of the tetrahedra between the faces and the origin).
+*/
+double ConvexHull::getVolume() const {
+	double volume = 0;
+	for (const HullFace &face : faces) {
+		const double *a = &points[3 * size_t(face.vertex[0])];
+		const double *b = &points[3 * size_t(face.vertex[1])];
+		const double *c = &points[3 * size_t(face.vertex[2])];
+		volume += a[0] * (b[1] * c[2] - b[2] * c[1]) - a[1] * (b[0] * c[2] - b[2] * c[0]) + a[2] * (b[0] * c[1] - b[1] * c[0]);
+	}
+	return volume / 6;
+}
+
+/*!
+\brief getSurface
+The function getSurface returns the surface of the hull.
+*/
+double ConvexHull::getSurface() const {
+	double surface = 0;
+	for (const HullFace &face : faces) {
+		const double *a = &points[3 * size_t(face.vertex[0])];
+		const double *b = &points[3 * size_t(face.vertex[1])];
+		const double *c = &points[3 * size_t(face.vertex[2])];
+		double ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+		double ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+		double cross[3] = { ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0] };
+		surface += std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]) / 2;
+	}
+	return surface;
+}
+
+/*!
+\brief getMaximumDiameter
+The function getMaximumDiameter returns the largest distance between two points. The two points of the largest distance
+are always vertices of the convex hull, so only the hull vertices are compared.
+*/
+double ConvexHull::getMaximumDiameter() const {
+	double maxDistance = 0;
+	for (size_t i = 0; i < hullVertices.size(); i++) {
+		const double *p1 = &points[3 * size_t(hullVertices[i])];
+		for (size_t j = i + 1; j < hullVertices.size(); j++) {
+			const double *p2 = &points[3 * size_t(hullVertices[j])];
+			double distance = (p1[0] - p2[0]) * (p1[0] - p2[0]) + (p1[1] - p2[1]) * (p1[1] - p2[1]) + (p1[2] - p2[2]) * (p1[2] - p2[2]);
+			maxDistance = std::max(maxDistance, distance);
+		}
+	}
+	return std::sqrt(maxDistance);
+}
+
+/*!
+\brief getMinimumAreaRectangle
+The function getMinimumAreaRectangle calculates the rectangle with the smallest area that contains a 2D convex polygon with
+rotating calipers: one side of the rectangle lies on an edge of the polygon, for every edge the points with the largest
+extent are found by moving the calipers forward.
+@param[in] hull2D: convex polygon, counter clockwise
+@param[out] width, length: side lengths of the rectangle
+@param[out] double: area of the rectangle
+*/
+double ConvexHull::getMinimumAreaRectangle(const vector<array<double, 2> > &hull2D, double &width, double &length) const {
+	int nrPoints = int(hull2D.size());
+	double minArea = std::numeric_limits<double>::max();
+	int right = 0;
+	int top = 0;
+	int left = 0;
+	for (int i = 0; i < nrPoints; i++) {
+		const array<double, 2> &start = hull2D[i];
+		const array<double, 2> &end = hull2D[(i + 1) % nrPoints];
+		double edgeLength = std::sqrt((end[0] - start[0]) * (end[0] - start[0]) + (end[1] - start[1]) * (end[1] - start[1]));
+		if (edgeLength == 0) {
+			continue;
+		}
+		double edge[2] = { (end[0] - start[0]) / edgeLength, (end[1] - start[1]) / edgeLength };
+		//the polygon is counter clockwise, so the normal to the left of the edge points inside
+		double normal[2] = { -edge[1], edge[0] };
+		auto project = [&](int pointNr, const double(&axis)[2]) {
+			const array<double, 2> &point = hull2D[pointNr % nrPoints];
+			return (point[0] - start[0]) * axis[0] + (point[1] - start[1]) * axis[1];
+		};
+		double backwards[2] = { -edge[0], -edge[1] };
+		if (i == 0) {
+			right = 1;
+		}
+		for (int steps = 0; steps < nrPoints && project(right + 1, edge) > project(right, edge); steps++) {
+			right = (right + 1) % nrPoints;
+		}
+		if (i == 0) {
+			top = right;
+		}
+		for (int steps = 0; steps < nrPoints && project(top + 1, normal) > project(top, normal); steps++) {
+			top = (top + 1) % nrPoints;
+		}
+		if (i == 0) {
+			left = top;
+		}
+		for (int steps = 0; steps < nrPoints && project(left + 1, backwards) > project(left, backwards); steps++) {
+			left = (left + 1) % nrPoints;
+		}
+		double actWidth = project(right, edge) - project(left, edge);
+		double actLength = project(top, normal);
+		if (actWidth * actLength < minArea) {
+			minArea = actWidth * actLength;
+			width = actWidth;
+			length = actLength;
+		}
+	}
+	return minArea;
+}
+
+/*!
+\brief getApproximateMinimumBoundingBox
+The function getApproximateMinimumBoundingBox calculates the size of an oriented bounding box with a small volume. \n
+For every direction of a hull face the hull vertices are projected to the plane of the face and the minimum area rectangle of the
+projection is calculated with rotating calipers. The box with the smallest volume of all face directions is used (one side of the
+box lies on a face of the hull). Faces with the same direction are only checked once. \n
+This is an approximation: the box with the minimum volume does not need to have a side on a face of the hull (it can touch the hull
+only with edges), so the volume of the box can be larger than the minimum.
+@param[out] boxSize: side lengths of the box in ascending order
+*/
+void ConvexHull::getApproximateMinimumBoundingBox(double(&boxSize)[3]) const {
+	//without a hull the axis aligned bounding box is used
+	double minimum[3] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+	double maximum[3] = { -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max() };
+	for (int vertex : hullVertices) {
+		for (int i = 0; i < 3; i++) {
+			minimum[i] = std::min(minimum[i], points[3 * size_t(vertex) + i]);
+			maximum[i] = std::max(maximum[i], points[3 * size_t(vertex) + i]);
+		}
+	}
+	for (int i = 0; i < 3; i++) {
+		boxSize[i] = hullVertices.empty() ? 0 : maximum[i] - minimum[i];
+	}
+	double minVolume = boxSize[0] * boxSize[1] * boxSize[2];
+	set<array<long long, 3> > checkedDirections;
+	vector<array<double, 2> > projection(hullVertices.size());
+	vector<array<double, 2> > hull2D(2 * hullVertices.size());
+	for (const HullFace &face : faces) {
+		//n and -n give the same box
+		double normal[3] = { face.normal[0], face.normal[1], face.normal[2] };
+		int firstNonZero = std::abs(normal[0]) > 1e-9 ? 0 : (std::abs(normal[1]) > 1e-9 ? 1 : 2);
+		if (normal[firstNonZero] < 0) {
+			for (int i = 0; i < 3; i++) {
+				normal[i] = -normal[i];
+			}
+		}
+		array<long long, 3> direction = { { std::llround(normal[0] * 1e6), std::llround(normal[1] * 1e6), std::llround(normal[2] * 1e6) } };
+		if (!checkedDirections.insert(direction).second) {
+			continue;
+		}
+		//two axes in the plane of the face
+		double helper[3] = { 0, 0, 0 };
+		helper[std::abs(normal[0]) < 0.9 ? 0 : 1] = 1;
+		double axisU[3] = { normal[1] * helper[2] - normal[2] * helper[1], normal[2] * helper[0] - normal[0] * helper[2],
+			normal[0] * helper[1] - normal[1] * helper[0] };
+		double lengthU = std::sqrt(axisU[0] * axisU[0] + axisU[1] * axisU[1] + axisU[2] * axisU[2]);
+		for (int i = 0; i < 3; i++) {
+			axisU[i] /= lengthU;
+		}
+		double axisV[3] = { normal[1] * axisU[2] - normal[2] * axisU[1], normal[2] * axisU[0] - normal[0] * axisU[2],
+			normal[0] * axisU[1] - normal[1] * axisU[0] };
+		double minHeight = std::numeric_limits<double>::max();
+		double maxHeight = -std::numeric_limits<double>::max();
+		for (size_t v = 0; v < hullVertices.size(); v++) {
+			const double *point = &points[3 * size_t(hullVertices[v])];
+			projection[v][0] = point[0] * axisU[0] + point[1] * axisU[1] + point[2] * axisU[2];
+			projection[v][1] = point[0] * axisV[0] + point[1] * axisV[1] + point[2] * axisV[2];
+			double height = point[0] * normal[0] + point[1] * normal[1] + point[2] * normal[2];
+			minHeight = std::min(minHeight, height);
+			maxHeight = std::max(maxHeight, height);
+		}
+		//convex hull of the projection (monotone chain), counter clockwise
+		std::sort(projection.begin(), projection.end());
+		auto cross = [](const array<double, 2> &o, const array<double, 2> &a, const array<double, 2> &b) {
+			return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0]);
+		};
+		int nrHull = 0;
+		for (size_t v = 0; v < projection.size(); v++) {
+			while (nrHull >= 2 && cross(hull2D[nrHull - 2], hull2D[nrHull - 1], projection[v]) <= 0) {
+				nrHull--;
+			}
+			hull2D[nrHull++] = projection[v];
+		}
+		for (int v = int(projection.size()) - 2, lowerSize = nrHull + 1; v >= 0; v--) {
+			while (nrHull >= lowerSize && cross(hull2D[nrHull - 2], hull2D[nrHull - 1], projection[v]) <= 0) {
+				nrHull--;
+			}
+			hull2D[nrHull++] = projection[v];
+		}
+		//the first point is added again at the end
+		nrHull--;
+		if (nrHull < 3) {
+			continue;
+		}
+		vector<array<double, 2> > polygon(hull2D.begin(), hull2D.begin() + nrHull);
+		double width = 0;
+		double length = 0;
+		double height = maxHeight - minHeight;
+		double volume = getMinimumAreaRectangle(polygon, width, length) * height;
+		if (volume < minVolume) {
+			minVolume = volume;
+			boxSize[0] = width;
+			boxSize[1] = length;
+			boxSize[2] = height;
+		}
+	}
+	std::sort(boxSize, boxSize + 3);
+}
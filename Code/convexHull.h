@@ -0,0 +1,177 @@
+#ifndef CONVEXHULL_H_INCLUDED
+#define CONVEXHULL_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/*! \file */
+
+/*!
+The class ConvexHull calculates the 3D convex hull of a point cloud with the quickhull algorithm. \n
+Every face of the hull keeps the points that are outside of it, the point that is farthest away is added to the hull,
+all faces that can be seen from the point are removed and the horizon is connected to the new point. \n
+Points that are closer than the tolerance to the plane of a face are treated as lying on the face, so coplanar points of the
+voxel grid do not create extra faces. \n
+From the hull the features that need the extent of the VOI are calculated:
+- the maximum diameter (largest distance of two hull vertices)
+- an approximation of the minimum volume bounding box (only boxes with one side on a face of the hull are checked)
+- volume and surface of the hull
+*/
+class ConvexHull {
+private:
+	struct HullFace {
+		//vertices of the triangle, counter clockwise seen from outside the hull
+		int vertex[3];
+		//neighbour face across the edge vertex[i] -> vertex[(i + 1) % 3]
+		int neighbour[3];
+		double normal[3];
+		double offset;
+		//points that are outside of the face and not yet part of the hull
+		vector<int> outside;
+		bool deleted;
+		int visitNr;
+	};
+	//coordinates of the points (x, y, z of every point)
+	vector<double> points;
+	vector<HullFace> faces;
+	double tolerance;
+	int nrVisits;
+
+	double getDistance(const HullFace &face, int pointNr) const;
+	int createFace(int a, int b, int c);
+	bool createSimplex();
+	void addPoint(int faceNr, vector<int> &faceStack);
+	double getMinimumAreaRectangle(const vector<array<double, 2> > &hull2D, double &width, double &length) const;
+
+public:
+	//indices of the points that are vertices of the hull
+	vector<int> hullVertices;
+
+	ConvexHull() : tolerance(0), nrVisits(0) {
+	}
+	~ConvexHull() {
+	}
+	bool calculate(const vector<double> &pointCoordinates);
+	double getVolume() const;
+	double getSurface() const;
+	double getMaximumDiameter() const;
+	void getApproximateMinimumBoundingBox(double(&boxSize)[3]) const;
+};
+
+//vertices of the marching cubes mesh of a label image that can be on the convex hull
+template <class L>
+void getHullCandidates(const L *labels, const int(&size)[3], const double(&spacing)[3], vector<double> &points);
+//centres of the voxels of one label that can be on the convex hull of the label
+template <class L>
+void getVoxelCandidates(const L *labels, const int(&size)[3], const double(&spacing)[3], L label, const int(&first)[3], const int(&last)[3],
+	vector<double> &points);
+
+/*!
+\brief getHullCandidates
+The function getHullCandidates collects the vertices of the marching cubes mesh of all labels (> 0) of a label image. \n
+The vertices of the mesh are in the middle between a voxel inside and a voxel outside the mask. On every line in x direction
+only the first and the last vertex can be on the convex hull, so only these two are stored. This reduces the number of points
+from the number of boundary voxels to the number of lines.
+@param[in] labels: label image, stored like the ITK image buffer (x is running fastest)
+@param[in] size: size of the label image
+@param[in] spacing: voxel spacing
+@param[out] points: coordinates (x, y, z) of the vertices in mm, relative to the first voxel
+*/
+template <class L>
+void getHullCandidates(const L *labels, const int(&size)[3], const double(&spacing)[3], vector<double> &points) {
+	//the vertices are stored on a grid with half the voxel spacing, from -1 to 2 * size - 1
+	int nrY = 2 * size[1] + 1;
+	int nrZ = 2 * size[2] + 1;
+	vector<int> minX(size_t(nrY) * nrZ, INT_MAX);
+	vector<int> maxX(size_t(nrY) * nrZ, INT_MIN);
+	auto isInside = [&](int x, int y, int z) {
+		if (x < 0 || y < 0 || z < 0 || x >= size[0] || y >= size[1] || z >= size[2]) {
+			return false;
+		}
+		return labels[(size_t(z) * size[1] + y) * size[0] + x] > 0;
+	};
+	auto addVertex = [&](int x, int y, int z) {
+		size_t line = size_t(z + 1) * nrY + (y + 1);
+		minX[line] = std::min(minX[line], x);
+		maxX[line] = std::max(maxX[line], x);
+	};
+	const int neighbours[6][3] = { { -1, 0, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 } };
+	for (int z = 0; z < size[2]; z++) {
+		for (int y = 0; y < size[1]; y++) {
+			for (int x = 0; x < size[0]; x++) {
+				if (!isInside(x, y, z)) {
+					continue;
+				}
+				for (int n = 0; n < 6; n++) {
+					if (!isInside(x + neighbours[n][0], y + neighbours[n][1], z + neighbours[n][2])) {
+						addVertex(2 * x + neighbours[n][0], 2 * y + neighbours[n][1], 2 * z + neighbours[n][2]);
+					}
+				}
+			}
+		}
+	}
+	points.clear();
+	for (int z = 0; z < nrZ; z++) {
+		for (int y = 0; y < nrY; y++) {
+			size_t line = size_t(z) * nrY + y;
+			if (minX[line] > maxX[line]) {
+				continue;
+			}
+			double coordY = (y - 1) * spacing[1] / 2;
+			double coordZ = (z - 1) * spacing[2] / 2;
+			points.insert(points.end(), { minX[line] * spacing[0] / 2, coordY, coordZ });
+			if (maxX[line] != minX[line]) {
+				points.insert(points.end(), { maxX[line] * spacing[0] / 2, coordY, coordZ });
+			}
+		}
+	}
+}
+
+/*!
+\brief getVoxelCandidates
+The function getVoxelCandidates collects the centres of the voxels of one label that can be on the convex hull of the label: on every
+line in x direction only the first and the last voxel of the label are stored. \n
+The largest distance of two of these points is the Feret diameter of the label (largest distance of two voxel centres).
+@param[in] labels: label image, stored like the ITK image buffer (x is running fastest)
+@param[in] size: size of the label image
+@param[in] spacing: voxel spacing
+@param[in] label: the label
+@param[in] first, last: first and last index of the bounding box of the label in the buffer
+@param[out] points: coordinates (x, y, z) of the voxel centres in mm, relative to the first voxel
+*/
+template <class L>
+void getVoxelCandidates(const L *labels, const int(&size)[3], const double(&spacing)[3], L label, const int(&first)[3], const int(&last)[3],
+	vector<double> &points) {
+	points.clear();
+	for (int z = first[2]; z <= last[2]; z++) {
+		for (int y = first[1]; y <= last[1]; y++) {
+			const L *line = labels + (size_t(z) * size[1] + y) * size[0];
+			int minX = INT_MAX;
+			int maxX = INT_MIN;
+			for (int x = first[0]; x <= last[0]; x++) {
+				if (line[x] == label) {
+					minX = std::min(minX, x);
+					maxX = x;
+				}
+			}
+			if (minX > maxX) {
+				continue;
+			}
+			points.insert(points.end(), { minX * spacing[0], y * spacing[1], z * spacing[2] });
+			if (maxX != minX) {
+				points.insert(points.end(), { maxX * spacing[0], y * spacing[1], z * spacing[2] });
+			}
+		}
+	}
+}
+
+#include "convexHull.cpp"
+
+#endif // CONVEXHULL_H_INCLUDED
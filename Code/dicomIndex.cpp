@@ -0,0 +1,483 @@
+/*!
+\brief build
+The function build lists the files of the DICOM folder, reads the headers of all files that are not in the index file
+(or were changed since), updates the index file and groups the slices into series.
+@param[in] dicomFolder: folder with the DICOM files
+@param[in] nrThreadsIndex: number of threads, if 0 the number of cores is used
+@param[out] bool: false if the folder cannot be read or does not contain a DICOM image
+*/
+bool DicomIndex::build(string dicomFolder, unsigned int nrThreadsIndex) {
+	folder = dicomFolder;
+	nrThreads = nrThreadsIndex;
+	series.clear();
+	std::error_code error;
+	if (!std::filesystem::is_directory(folder, error)) {
+		std::cout << "The DICOM folder " << folder << " does not exist" << std::endl;
+		return false;
+	}
+	vector<DicomSliceInfo> files;
+	for (std::filesystem::directory_iterator fileIt(folder, error), end; !error && fileIt != end; fileIt.increment(error)) {
+		//the index file and the temporary index files of other processes are not DICOM files
+		if (!fileIt->is_regular_file(error) || fileIt->path().filename().string().compare(0, dicomIndexFileName.size(), dicomIndexFileName) == 0) {
+			continue;
+		}
+		DicomSliceInfo slice = DicomSliceInfo();
+		slice.fileName = fileIt->path().filename().string();
+		slice.fileSize = fileIt->file_size(error);
+		slice.modificationTime = (long long)fileIt->last_write_time(error).time_since_epoch().count();
+		files.push_back(slice);
+	}
+	std::sort(files.begin(), files.end(), [](const DicomSliceInfo &a, const DicomSliceInfo &b) {
+		return a.fileName < b.fileName;
+	});
+
+	//only the headers of new or changed files are read
+	map<string, DicomSliceInfo> indexedFiles;
+	readIndexFile(indexedFiles);
+	vector<size_t> newFiles;
+	for (size_t i = 0; i < files.size(); i++) {
+		map<string, DicomSliceInfo>::const_iterator indexIt = indexedFiles.find(files[i].fileName);
+		if (indexIt != indexedFiles.end() && indexIt->second.fileSize == files[i].fileSize
+			&& indexIt->second.modificationTime == files[i].modificationTime) {
+			files[i] = indexIt->second;
+		}
+		else {
+			newFiles.push_back(i);
+		}
+	}
+	runParallel(newFiles.size(), nrThreads, [&](size_t i) {
+		DicomSliceInfo &slice = files[newFiles[i]];
+		readHeader((std::filesystem::path(folder) / slice.fileName).string(), slice);
+	});
+	if (!newFiles.empty() || indexedFiles.size() != files.size()) {
+		writeIndexFile(files);
+	}
+	groupSeries(files);
+	if (series.empty()) {
+		std::cout << "No DICOM image was found in the folder " << folder << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/*!
+\brief readIndexFile
+The function readIndexFile reads the index file of the folder. If there is no index file or it has another version, no file is returned.
+@param[out] indexedFiles: header information of the files in the index, the key is the file name
+*/
+bool DicomIndex::readIndexFile(map<string, DicomSliceInfo> &indexedFiles) const {
+	std::ifstream indexFile((std::filesystem::path(folder) / dicomIndexFileName).string());
+	string line;
+	if (!indexFile.is_open() || !std::getline(indexFile, line) || line != dicomIndexHeader) {
+		return false;
+	}
+	while (std::getline(indexFile, line)) {
+		vector<string> fields;
+		std::istringstream lineStream(line);
+		string field;
+		while (std::getline(lineStream, field, '\t')) {
+			fields.push_back(field);
+		}
+		if (fields.size() != 21) {
+			continue;
+		}
+		DicomSliceInfo slice = DicomSliceInfo();
+		try {
+			slice.fileName = fields[0];
+			slice.fileSize = std::stoull(fields[1]);
+			slice.modificationTime = std::stoll(fields[2]);
+			slice.seriesUID = fields[3];
+			slice.seriesDate = fields[4];
+			slice.rows = unsigned(std::stoul(fields[5]));
+			slice.columns = unsigned(std::stoul(fields[6]));
+			slice.samplesPerPixel = unsigned(std::stoul(fields[7]));
+			for (int i = 0; i < 3; i++) {
+				slice.position[i] = std::stod(fields[8 + i]);
+			}
+			for (int i = 0; i < 6; i++) {
+				slice.orientation[i] = std::stod(fields[11 + i]);
+			}
+			for (int i = 0; i < 2; i++) {
+				slice.pixelSpacing[i] = std::stod(fields[17 + i]);
+			}
+			slice.rescaleSlope = std::stod(fields[19]);
+			slice.rescaleIntercept = std::stod(fields[20]);
+		}
+		catch (std::exception &) {
+			continue;
+		}
+		indexedFiles[slice.fileName] = slice;
+	}
+	return true;
+}
+
+/*!
+\brief writeIndexFile
+The function writeIndexFile writes the header information of all files of the folder in the index file (one line per file,
+the values are separated by tabs). If the folder is not writable, the index is only used for this run. \n
+The index is written to a temporary file, which then replaces the index file in one step: other threads or processes that read the
+same folder (e.g. the time points of the longitudinal mode) either read the old or the new index, never a partly written one.
+*/
+void DicomIndex::writeIndexFile(const vector<DicomSliceInfo> &files) const {
+	std::filesystem::path indexPath = std::filesystem::path(folder) / dicomIndexFileName;
+	//the name of the temporary file is unique for every thread and call
+	std::ostringstream tempName;
+	tempName << dicomIndexFileName << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << "."
+		<< std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+	std::filesystem::path tempPath = std::filesystem::path(folder) / tempName.str();
+	std::ofstream indexFile(tempPath.string());
+	if (!indexFile.is_open()) {
+		std::cout << "The DICOM index cannot be written in the folder " << folder << std::endl;
+		return;
+	}
+	indexFile << dicomIndexHeader << "\n" << std::setprecision(17);
+	for (const DicomSliceInfo &slice : files) {
+		indexFile << slice.fileName << "\t" << slice.fileSize << "\t" << slice.modificationTime << "\t" << slice.seriesUID << "\t"
+			<< slice.seriesDate << "\t" << slice.rows << "\t" << slice.columns << "\t" << slice.samplesPerPixel;
+		for (int i = 0; i < 3; i++) {
+			indexFile << "\t" << slice.position[i];
+		}
+		for (int i = 0; i < 6; i++) {
+			indexFile << "\t" << slice.orientation[i];
+		}
+		for (int i = 0; i < 2; i++) {
+			indexFile << "\t" << slice.pixelSpacing[i];
+		}
+		indexFile << "\t" << slice.rescaleSlope << "\t" << slice.rescaleIntercept << "\n";
+	}
+	indexFile.close();
+	std::error_code error;
+	if (indexFile.fail()) {
+		std::cout << "The DICOM index cannot be written in the folder " << folder << std::endl;
+		std::filesystem::remove(tempPath, error);
+		return;
+	}
+	//rename replaces an existing index in one step (if another thread wrote the index in the meantime, its index is replaced)
+	std::filesystem::rename(tempPath, indexPath, error);
+	if (error) {
+		std::cout << "The DICOM index cannot be written in the folder " << folder << std::endl;
+		std::filesystem::remove(tempPath, error);
+	}
+}
+
+/*!
+\brief readHeader
+The function readHeader reads the header of a DICOM file up to the pixel data and stores the values needed for the image.
+@param[in] path: path of the file
+@param[in,out] slice: header information, the rows are set to 0 if the file is not a DICOM image
+*/
+bool DicomIndex::readHeader(const string &path, DicomSliceInfo &slice) const {
+	slice.rows = 0;
+	slice.columns = 0;
+	slice.samplesPerPixel = 1;
+	slice.rescaleSlope = 1;
+	slice.rescaleIntercept = 0;
+	gdcm::Reader reader;
+	reader.SetFileName(path.c_str());
+	std::set<gdcm::Tag> skipTags;
+	if (!reader.ReadUpToTag(gdcm::Tag(0x7fe0, 0x0010), skipTags)) {
+		return false;
+	}
+	const gdcm::DataSet &dataSet = reader.GetFile().GetDataSet();
+	gdcm::Attribute<0x0020, 0x0032> position;
+	gdcm::Attribute<0x0020, 0x0037> orientation;
+	gdcm::Attribute<0x0028, 0x0030> pixelSpacing;
+	if (!dataSet.FindDataElement(position.GetTag()) || !dataSet.FindDataElement(orientation.GetTag())
+		|| !dataSet.FindDataElement(pixelSpacing.GetTag())) {
+		return false;
+	}
+	position.SetFromDataSet(dataSet);
+	orientation.SetFromDataSet(dataSet);
+	pixelSpacing.SetFromDataSet(dataSet);
+	for (int i = 0; i < 3; i++) {
+		slice.position[i] = position.GetValue(i);
+	}
+	for (int i = 0; i < 6; i++) {
+		slice.orientation[i] = orientation.GetValue(i);
+	}
+	for (int i = 0; i < 2; i++) {
+		slice.pixelSpacing[i] = pixelSpacing.GetValue(i);
+	}
+	gdcm::Attribute<0x0028, 0x0010> rows;
+	gdcm::Attribute<0x0028, 0x0011> columns;
+	gdcm::Attribute<0x0028, 0x0002> samplesPerPixel;
+	gdcm::Attribute<0x0028, 0x1053> rescaleSlope;
+	gdcm::Attribute<0x0028, 0x1052> rescaleIntercept;
+	rows.SetFromDataSet(dataSet);
+	columns.SetFromDataSet(dataSet);
+	if (dataSet.FindDataElement(samplesPerPixel.GetTag())) {
+		samplesPerPixel.SetFromDataSet(dataSet);
+		slice.samplesPerPixel = samplesPerPixel.GetValue();
+	}
+	if (dataSet.FindDataElement(rescaleSlope.GetTag()) && !dataSet.GetDataElement(rescaleSlope.GetTag()).IsEmpty()) {
+		rescaleSlope.SetFromDataSet(dataSet);
+		slice.rescaleSlope = rescaleSlope.GetValue();
+	}
+	if (dataSet.FindDataElement(rescaleIntercept.GetTag()) && !dataSet.GetDataElement(rescaleIntercept.GetTag()).IsEmpty()) {
+		rescaleIntercept.SetFromDataSet(dataSet);
+		slice.rescaleIntercept = rescaleIntercept.GetValue();
+	}
+	slice.seriesUID = getDicomString(dataSet, gdcm::Tag(0x0020, 0x000e));
+	slice.seriesDate = getDicomString(dataSet, gdcm::Tag(0x0008, 0x0021));
+	//multi frame files are not indexed as slices, they are left to the ITK reader
+	string nrFrames = getDicomString(dataSet, gdcm::Tag(0x0028, 0x0008));
+	if (!nrFrames.empty() && nrFrames != "1") {
+		return false;
+	}
+	slice.rows = rows.GetValue();
+	slice.columns = columns.GetValue();
+	return slice.rows > 0 && slice.columns > 0;
+}
+
+/*!
+\brief groupSeries
+The function groupSeries groups the DICOM images into series and sorts the slices of every series along the slice normal. \n
+Like the ITK series file names generator (with the series date as additional restriction), the series are identified by
+the series UID and the series date, and they are sorted by this identifier.
+*/
+void DicomIndex::groupSeries(const vector<DicomSliceInfo> &files) {
+	map<string, DicomSeries> seriesMap;
+	for (const DicomSliceInfo &file : files) {
+		if (file.rows == 0) {
+			continue;
+		}
+		DicomSliceInfo slice = file;
+		const double *row = slice.orientation;
+		const double *column = slice.orientation + 3;
+		double normal[3] = { row[1] * column[2] - row[2] * column[1], row[2] * column[0] - row[0] * column[2],
+			row[0] * column[1] - row[1] * column[0] };
+		slice.slicePosition = 0;
+		for (int i = 0; i < 3; i++) {
+			slice.slicePosition += slice.position[i] * normal[i];
+		}
+		string identifier = slice.seriesUID + "." + slice.seriesDate;
+		DicomSeries &dicomSeries = seriesMap[identifier];
+		dicomSeries.seriesIdentifier = identifier;
+		dicomSeries.slices.push_back(slice);
+	}
+	for (map<string, DicomSeries>::iterator seriesIt = seriesMap.begin(); seriesIt != seriesMap.end(); ++seriesIt) {
+		vector<DicomSliceInfo> &slices = seriesIt->second.slices;
+		std::stable_sort(slices.begin(), slices.end(), [](const DicomSliceInfo &a, const DicomSliceInfo &b) {
+			return a.slicePosition < b.slicePosition;
+		});
+		series.push_back(seriesIt->second);
+	}
+}
+
+const vector<DicomSeries> &DicomIndex::getSeries() const {
+	return series;
+}
+
+/*!
+\brief getFileNames
+The function getFileNames returns the paths of the sorted slices of a series.
+*/
+vector<string> DicomIndex::getFileNames(size_t seriesNr) const {
+	vector<string> fileNames;
+	for (const DicomSliceInfo &slice : series[seriesNr].slices) {
+		fileNames.push_back((std::filesystem::path(folder) / slice.fileName).string());
+	}
+	return fileNames;
+}
+
+/*!
+\brief hasSameGeometry
+The slices of a series can only be copied into one image if all slices have the same size, voxel spacing and orientation,
+have only one value per pixel and the distance between the slices is constant.
+*/
+bool DicomIndex::hasSameGeometry(const DicomSeries &dicomSeries) const {
+	const vector<DicomSliceInfo> &slices = dicomSeries.slices;
+	const DicomSliceInfo &first = slices[0];
+	double sliceDistance = 0;
+	if (slices.size() > 1) {
+		sliceDistance = (slices.back().slicePosition - first.slicePosition) / double(slices.size() - 1);
+		if (sliceDistance <= 0) {
+			return false;
+		}
+	}
+	for (size_t sliceNr = 0; sliceNr < slices.size(); sliceNr++) {
+		const DicomSliceInfo &slice = slices[sliceNr];
+		if (slice.rows != first.rows || slice.columns != first.columns || slice.samplesPerPixel != 1) {
+			return false;
+		}
+		for (int i = 0; i < 6; i++) {
+			if (std::abs(slice.orientation[i] - first.orientation[i]) > 1e-4) {
+				return false;
+			}
+		}
+		for (int i = 0; i < 2; i++) {
+			if (std::abs(slice.pixelSpacing[i] - first.pixelSpacing[i]) > 1e-4 * first.pixelSpacing[i]) {
+				return false;
+			}
+		}
+		if (std::abs(slice.slicePosition - first.slicePosition - double(sliceNr) * sliceDistance) > 0.01 * sliceDistance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*!
+\brief decodeSlice
+The function decodeSlice decodes the pixel data of one file (also compressed files) and writes the rescaled values in the buffer.
+@param[in] slice: header information of the file
+@param[out] buffer: buffer of the slice in the image (rows * columns values)
+*/
+bool DicomIndex::decodeSlice(const DicomSliceInfo &slice, float *buffer) const {
+	gdcm::ImageReader reader;
+	reader.SetFileName((std::filesystem::path(folder) / slice.fileName).string().c_str());
+	if (!reader.Read()) {
+		return false;
+	}
+	const gdcm::Image &image = reader.GetImage();
+	const gdcm::PixelFormat &pixelFormat = image.GetPixelFormat();
+	size_t nrPixels = size_t(slice.rows) * slice.columns;
+	vector<char> pixelData(image.GetBufferLength());
+	if (pixelData.size() < nrPixels * pixelFormat.GetPixelSize() || !image.GetBuffer(pixelData.data())) {
+		return false;
+	}
+	double slope = slice.rescaleSlope;
+	double intercept = slice.rescaleIntercept;
+	switch (pixelFormat.GetScalarType()) {
+	case gdcm::PixelFormat::UINT8:
+		convertDicomPixels<uint8_t>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	case gdcm::PixelFormat::INT8:
+		convertDicomPixels<int8_t>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	case gdcm::PixelFormat::UINT16:
+		convertDicomPixels<uint16_t>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	case gdcm::PixelFormat::INT16:
+		convertDicomPixels<int16_t>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	case gdcm::PixelFormat::UINT32:
+		convertDicomPixels<uint32_t>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	case gdcm::PixelFormat::INT32:
+		convertDicomPixels<int32_t>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	case gdcm::PixelFormat::FLOAT32:
+		convertDicomPixels<float>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	case gdcm::PixelFormat::FLOAT64:
+		convertDicomPixels<double>(pixelData.data(), nrPixels, slope, intercept, buffer);
+		break;
+	default:
+		//e.g. 12 bit values are left to the ITK reader
+		return false;
+	}
+	return true;
+}
+
+/*!
+\brief readSeries
+The function readSeries reads the slices of a series into one ITK image. The image is allocated once and every thread decodes
+its slices directly into the image buffer. \n
+Origin, spacing and direction are set like by the ITK series reader: the origin is the position of the first slice,
+the slice spacing is the mean distance of the slices.
+@param[in] seriesNr: number of the series in the index
+@param[in] firstSlice, nrSlices: if nrSlices is set, only these slices are read, the image then starts at index 0 at the position of firstSlice
+@param[out] ImageType: the image of the series
+*/
+ImageType::Pointer DicomIndex::readSeries(size_t seriesNr, unsigned int firstSlice, unsigned int nrSlices) const {
+	const DicomSeries &dicomSeries = series[seriesNr];
+	const vector<DicomSliceInfo> &slices = dicomSeries.slices;
+	if (nrSlices == 0 || size_t(firstSlice) + nrSlices > slices.size()) {
+		firstSlice = 0;
+		nrSlices = unsigned(slices.size());
+	}
+	if (!hasSameGeometry(dicomSeries)) {
+		return readSeriesITK(seriesNr, firstSlice, nrSlices);
+	}
+	const DicomSliceInfo &first = slices[0];
+	ImageType::Pointer image = ImageType::New();
+	RegionType region;
+	region.SetIndex(0, 0);
+	region.SetIndex(1, 0);
+	region.SetIndex(2, 0);
+	region.SetSize(0, first.columns);
+	region.SetSize(1, first.rows);
+	region.SetSize(2, nrSlices);
+	image->SetRegions(region);
+	ImageType::SpacingType spacing;
+	//the pixel spacing is the distance between the rows (y) and between the columns (x)
+	spacing[0] = first.pixelSpacing[1];
+	spacing[1] = first.pixelSpacing[0];
+	spacing[2] = 1;
+	if (slices.size() > 1) {
+		spacing[2] = (slices.back().slicePosition - first.slicePosition) / double(slices.size() - 1);
+	}
+	image->SetSpacing(spacing);
+	ImageType::PointType origin;
+	for (int i = 0; i < 3; i++) {
+		origin[i] = slices[firstSlice].position[i];
+	}
+	image->SetOrigin(origin);
+	ImageType::DirectionType direction;
+	const double *row = first.orientation;
+	const double *column = first.orientation + 3;
+	double normal[3] = { row[1] * column[2] - row[2] * column[1], row[2] * column[0] - row[0] * column[2],
+		row[0] * column[1] - row[1] * column[0] };
+	for (int i = 0; i < 3; i++) {
+		direction[i][0] = row[i];
+		direction[i][1] = column[i];
+		direction[i][2] = normal[i];
+	}
+	image->SetDirection(direction);
+	image->Allocate();
+
+	float *buffer = image->GetBufferPointer();
+	size_t nrPixelsSlice = size_t(first.rows) * first.columns;
+	std::atomic<bool> decoded(true);
+	runParallel(nrSlices, nrThreads, [&](size_t sliceNr) {
+		if (!decodeSlice(slices[firstSlice + sliceNr], buffer + sliceNr * nrPixelsSlice)) {
+			decoded = false;
+		}
+	});
+	if (!decoded) {
+		return readSeriesITK(seriesNr, firstSlice, nrSlices);
+	}
+	return image;
+}
+
+/*!
+\brief readSeriesITK
+The function readSeriesITK reads the slices of a series with the ITK series reader. It is used if the slices cannot be
+decoded by readSeries.
+*/
+ImageType::Pointer DicomIndex::readSeriesITK(size_t seriesNr, unsigned int firstSlice, unsigned int nrSlices) const {
+	vector<string> fileNames = getFileNames(seriesNr);
+	fileNames = vector<string>(fileNames.begin() + firstSlice, fileNames.begin() + firstSlice + nrSlices);
+	typedef itk::ImageSeriesReader< ImageType > SeriesReaderType;
+	SeriesReaderType::Pointer reader = SeriesReaderType::New();
+	typedef itk::GDCMImageIO ImageIOType;
+	ImageIOType::Pointer dicomIO = ImageIOType::New();
+	reader->SetImageIO(dicomIO);
+	reader->SetFileNames(fileNames);
+	try {
+		reader->Update();
+	}
+	catch (itk::ExceptionObject &ex) {
+		std::cout << ex << std::endl;
+	}
+	return reader->GetOutput();
+}
+
+/*!
+\brief getDicomString
+The function getDicomString returns the value of a text element of a DICOM data set without the spaces and zeros used as padding.
+If the element does not exist, an empty string is returned.
+*/
+string getDicomString(const gdcm::DataSet &dataSet, const gdcm::Tag &tag) {
+	if (!dataSet.FindDataElement(tag)) {
+		return "";
+	}
+	const gdcm::ByteValue *value = dataSet.GetDataElement(tag).GetByteValue();
+	if (value == nullptr) {
+		return "";
+	}
+	string text(value->GetPointer(), value->GetLength());
+	size_t end = text.find_last_not_of(string(" \0", 2));
+	return end == string::npos ? "" : text.substr(0, end + 1);
+}
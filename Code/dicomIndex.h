@@ -0,0 +1,115 @@
+#ifndef DICOMINDEX_H_INCLUDED
+#define DICOMINDEX_H_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gdcmAttribute.h>
+#include <gdcmImageReader.h>
+#include <gdcmReader.h>
+#include "itkTypes.h"
+#include "parallel.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+//name of the index file that is written into the folder of the DICOM files
+const string dicomIndexFileName = "racatDicomIndex.txt";
+//first line of the index file, an index file with another first line (e.g. of an older version) is ignored
+const string dicomIndexHeader = "RaCaT DICOM index 1";
+
+/*!
+The struct DicomSliceInfo keeps the header information of one DICOM file that is needed to group and sort the slices
+and to copy the pixel values into the image. \n
+Files that are not DICOM images have 0 rows.
+*/
+struct DicomSliceInfo {
+	string fileName;
+	//file size and time of the last change, used to find out if the file was changed after it was indexed
+	uintmax_t fileSize;
+	long long modificationTime;
+	string seriesUID;
+	string seriesDate;
+	unsigned int rows;
+	unsigned int columns;
+	unsigned int samplesPerPixel;
+	double position[3];
+	double orientation[6];
+	double pixelSpacing[2];
+	double rescaleSlope;
+	double rescaleIntercept;
+	//position of the slice along the normal of the slice
+	double slicePosition;
+};
+
+/*!
+A DICOM series: all slices with the same series UID and series date, sorted along the slice normal.
+*/
+struct DicomSeries {
+	string seriesIdentifier;
+	vector<DicomSliceInfo> slices;
+};
+
+/*!
+The class DicomIndex groups the files of a DICOM folder into series. \n
+The headers are read in parallel and only up to the pixel data. The result is stored in an index file in the DICOM folder
+(see dicomIndexFileName), so that on the next run only files that were added or changed have to be read again. \n
+The slices of a series are decoded in parallel directly into the buffer of one ITK image. If the slices of a series do not
+have the same geometry or cannot be decoded, the series is read with the ITK series reader instead.
+*/
+class DicomIndex {
+private:
+	string folder;
+	vector<DicomSeries> series;
+	unsigned int nrThreads;
+
+	bool readIndexFile(map<string, DicomSliceInfo> &indexedFiles) const;
+	void writeIndexFile(const vector<DicomSliceInfo> &files) const;
+	bool readHeader(const string &path, DicomSliceInfo &slice) const;
+	void groupSeries(const vector<DicomSliceInfo> &files);
+	bool hasSameGeometry(const DicomSeries &dicomSeries) const;
+	bool decodeSlice(const DicomSliceInfo &slice, float *buffer) const;
+	ImageType::Pointer readSeriesITK(size_t seriesNr, unsigned int firstSlice, unsigned int nrSlices) const;
+
+public:
+	DicomIndex() : nrThreads(1) {
+	}
+	~DicomIndex() {
+	}
+	bool build(string dicomFolder, unsigned int nrThreadsIndex = 0);
+	const vector<DicomSeries> &getSeries() const;
+	vector<string> getFileNames(size_t seriesNr) const;
+	ImageType::Pointer readSeries(size_t seriesNr, unsigned int firstSlice = 0, unsigned int nrSlices = 0) const;
+};
+
+//get a text value (e.g. an UID) from a DICOM data set without the padding at the end
+string getDicomString(const gdcm::DataSet &dataSet, const gdcm::Tag &tag);
+//convert the stored pixel values of a slice to float and apply the rescale slope and intercept
+template <class P>
+void convertDicomPixels(const char *pixelData, size_t nrPixels, double slope, double intercept, float *buffer);
+
+template <class P>
+void convertDicomPixels(const char *pixelData, size_t nrPixels, double slope, double intercept, float *buffer) {
+	const P *values = reinterpret_cast<const P*>(pixelData);
+	for (size_t i = 0; i < nrPixels; i++) {
+		buffer[i] = float(double(values[i]) * slope + intercept);
+	}
+}
+
+#include "dicomIndex.cpp"
+
+#endif // DICOMINDEX_H_INCLUDED
@@ -31,6 +31,7 @@
 #include "itkCastImageFilter.h"
 
 #include "image.h"
+#include "lesionLabels.h"
 #include "itkTypes.h"
 
 #include "itkChangeInformationImageFilter.h"
@@ -42,12 +43,6 @@ template <class T, size_t R>
 class DispersityFeatures {
 private:
 	using PointType = itk::Point<T, R>;
-	typedef itk::ConnectedComponentImageFilter <intImage, intImage> ConnectedComponentFilterType;
-
-	typedef itk::LabelImageToShapeLabelMapFilter<intImage> LabelImageToShapeLabelMapFilterType;
-	typedef int LabelType;
-	typedef itk::ShapeLabelObject<LabelType, R> ShapeLabelObjectType;
-	typedef itk::LabelMap<ShapeLabelObjectType> LabelMapType;
 	float correctionParam = 0;
 	float DmaxBulk = NAN;
 	float DmaxPatient = NAN;
@@ -71,99 +66,45 @@ private:
 	float ratioPeakPatient = NAN;
 	float ratioVolPatient = NAN;
 	float voxelSize[3];
-	void getLabelObjectFeatures(ImageType::Pointer image, ImageType::Pointer mask, ConfigFile config);
-	itk::Point<T, R> getMaxIndices(ImageType::Pointer image, ImageType::Pointer mask, int labelNr, vector<float> &maxValues);
-	void getBulkFeatures(vector<int> volume, vector<PointType> indices);
-	void getTotalFeatures(vector<int> volume, vector<PointType> indices);
+	void getLabelObjectFeatures(ImageType::Pointer image, const LesionLabels &lesions, ConfigFile config);
+	itk::Point<T, R> getMaxPoint(ImageType::Pointer image, const LabelStatistics &lesion, vector<T> &maxValues);
+	void getBulkFeatures(const vector<int> &volume, const vector<PointType> &indices);
+	void getTotalFeatures(const vector<int> &volume, const vector<PointType> &indices);
 	float getEuclideanDist(PointType p1, PointType p2);
 	void getVolumeDispersity(vector<int> volume);
 	void getMaxDispersity(vector<T> maxValues, vector<int> volume);
-	float getPEAKvalues(ImageType::Pointer mask, ImageType::Pointer image, ConfigFile config);
+	vector<float> getPEAKvalues(ImageType::Pointer image, const LesionLabels &lesions, ConfigFile config);
 	void defineDispersityFeatures(vector<string> &features);
-	ImageType::Pointer setMaskOneLesion(ImageType::Pointer mask, int labelNr);
 	void extractDispersityData(vector<T> &dispData, DispersityFeatures<T, R> dispFeatures);
 	void getPeakDispersityFeatures(vector<int> volume, vector<float> peakVector);
 public:
 	void writeOneFileDispersity(DispersityFeatures<T, R> disp, ConfigFile config);
 	void writeCSVFileDispersity(DispersityFeatures<T, R> disp, string outputFolder, ConfigFile config);
-	void calculateAllDispersityFeatures(DispersityFeatures<T, R> &dispFeatures, ImageType::Pointer image, ImageType::Pointer mask, ConfigFile config);
+	void calculateAllDispersityFeatures(DispersityFeatures<T, R> &dispFeatures, ImageType::Pointer image, const LesionLabels &lesions, ConfigFile config);
 };
 /*!
-In the function getLabelObjectFeatures a set of morphological features is calculated using
-the label image to shape label map filter
+\brief getMaxPoint
+The function getMaxPoint returns the position of the maximum intensity value of one lesion in physical coordinates
+and stores the corrected maximum value in maxValues. \n
+The maximum and its position are taken from the statistics table of the labelled mask.
+@param[in] ImageType image: image the lesion table was calculated for
+@param[in] lesion: statistics of the lesion
+@param[in,out] maxValues: vector with the maximum values of the lesions
 */
 template<class T, size_t R>
-itk::Point<T, R> DispersityFeatures<T, R>::getMaxIndices(ImageType::Pointer image, ImageType::Pointer mask, int labelNr, vector<float> &maxValues) {
-
-
-	itk::ImageRegionConstIterator<ImageType> maskIt(mask, mask->GetLargestPossibleRegion());
-	itk::ImageRegionConstIterator<ImageType> imageIt(image, image->GetLargestPossibleRegion());
-	maskIt.GoToBegin();
-	imageIt.GoToBegin();
-	float maxValue = 0;
-	itk::Index<R> actIndex;
+itk::Point<T, R> DispersityFeatures<T, R>::getMaxPoint(ImageType::Pointer image, const LabelStatistics &lesion, vector<T> &maxValues) {
 	PointType actCoordinates;
-	
-	while (!maskIt.IsAtEnd()){
-	
-		if (maskIt.Get() == labelNr && imageIt.Get()* correctionParam > maxValue)
-		{
-			maxValue = imageIt.Get() * correctionParam;
-			actIndex = maskIt.GetIndex();
-
-		}
-
-		++maskIt;
-		++imageIt;
+	image->TransformIndexToPhysicalPoint(lesion.maxIndex, actCoordinates);
+	float maxValue = lesion.maxValue * correctionParam;
+	//lesions without positive intensity values do not contribute a maximum
+	if (!(maxValue > 0)) {
+		maxValue = 0;
 	}
-	if (maxValue == 0) {
-		maskIt.GoToBegin();
-		imageIt.GoToBegin();
-		while (!maskIt.IsAtEnd())
-		{
-			if (maskIt.Get() > 0)
-			{
-				maxValue = maskIt.Get() * correctionParam;
-				actIndex = maskIt.GetIndex();
-			}
-			++maskIt;
-
-		}
-
-	}
-	const itk::Index<R> test = actIndex;
-	image->TransformIndexToPhysicalPoint(test, actCoordinates);
 	maxValues.push_back(maxValue);
 	return actCoordinates;
 }
 
 
-//setMaskOneLesion: Get a mask that contains only the mask of one lesion (set all other mask points to 0)
-//this method is only applied if there is more than one lesion present in the mask
-template<class T, size_t R>
-ImageType::Pointer DispersityFeatures<T, R>::setMaskOneLesion(ImageType::Pointer mask, int labelNr) {
-	ImageType::Pointer copyMask = ImageType::New();
-	copyMask->SetRegions(mask->GetLargestPossibleRegion());
-	copyMask->Allocate();
-	itk::ImageRegionConstIterator<ImageType> maskIt(mask, mask->GetLargestPossibleRegion());
-	itk::ImageRegionIterator<ImageType> copyIt(copyMask, copyMask->GetLargestPossibleRegion());
-	maskIt.GoToBegin();
-	copyIt.GoToBegin();
-
-	while (!maskIt.IsAtEnd())
-	{
-		if (maskIt.Get() == labelNr) {
-			copyIt.Set(100);
-		}
-		else {
-			copyIt.Set(0);
-		}
-		++maskIt;
-		++copyIt;
-	}
-	return copyMask;
-}
-
 //calculate the euclidean distance of two ITK points
 template<class T, size_t R>
 float DispersityFeatures<T, R>::getEuclideanDist(PointType p1, PointType p2) {
@@ -172,21 +113,85 @@ float DispersityFeatures<T, R>::getEuclideanDist(PointType p1, PointType p2) {
 	return dist;
 }
 
-//get global SUV peak of each lesion in order to calculate the 'Peak' dispersity features
+/*!
+\brief getPEAKvalues
+The function getPEAKvalues calculates the global SUV peak of every lesion in order to calculate the 'Peak' dispersity features. \n
+The peak is calculated like in the local intensity features, but only on the bounding box of the lesion: the mean of the
+peak region is a box filter (the values outside the bounding box are replaced by the values at its border), which is applied
+direction by direction with running sums. The global peak is the maximum of the filtered values inside the lesion.
+@param[in] ImageType image: image the lesion table was calculated for
+@param[in] lesions: label image and statistics of the lesions
+@param[in] ConfigFile config: if SUV is used, the peaks are corrected
+@param[out] vector<float>: peak of every lesion (in the order of the statistics table)
+*/
 template<class T, size_t R>
-float DispersityFeatures<T, R>::getPEAKvalues(ImageType::Pointer mask, ImageType::Pointer image, ConfigFile config) {
+vector<float> DispersityFeatures<T, R>::getPEAKvalues(ImageType::Pointer image, const LesionLabels &lesions, ConfigFile config) {
 	LocalIntensityFeatures<float, 3> localInt;
-	RegionType boundingBoxRegion = getBoundingBoxMask(mask);
-	mask = getImageMasked(mask, boundingBoxRegion);
-	image = getImageMasked(image, boundingBoxRegion);
-	localInt.calculateAllLocalIntensityFeatures(localInt, image, mask, config);
-	return localInt.globalIntensityPeak;
+	const typename ImageType::SpacingType& inputSpacing = image->GetSpacing();
+	int halfWidth[3];
+	for (int i = 0; i < 3; i++) {
+		halfWidth[i] = localInt.getPeakHalfWidth(inputSpacing[i]);
+	}
+	intImage *labelImage = lesions.getLabelImage();
+	vector<float> peakVector;
+	vector<double> values;
+	vector<double> line;
+	vector<double> runningSum;
+	for (const LabelStatistics &lesion : lesions.getStatistics()) {
+		const RegionType &boundingBox = lesion.boundingBox;
+		int size[3] = { int(boundingBox.GetSize()[0]), int(boundingBox.GetSize()[1]), int(boundingBox.GetSize()[2]) };
+		values.assign(size_t(size[0]) * size[1] * size[2], 0);
+		itk::ImageRegionConstIterator<ImageType> imageIt(image, boundingBox);
+		size_t voxelNr = 0;
+		for (imageIt.GoToBegin(); !imageIt.IsAtEnd(); ++imageIt, ++voxelNr) {
+			values[voxelNr] = imageIt.Get();
+		}
+		//mean over the peak region, one direction after the other
+		size_t stride[3] = { 1, size_t(size[0]), size_t(size[0]) * size[1] };
+		for (int direction = 0; direction < 3; direction++) {
+			int length = size[direction];
+			int width = halfWidth[direction];
+			line.resize(length);
+			runningSum.resize(length + 2 * width + 1);
+			int other1 = (direction + 1) % 3;
+			int other2 = (direction + 2) % 3;
+			for (int a = 0; a < size[other1]; a++) {
+				for (int b = 0; b < size[other2]; b++) {
+					size_t start = a * stride[other1] + b * stride[other2];
+					runningSum[0] = 0;
+					for (int k = -width; k < length + width; k++) {
+						int clamped = std::min(std::max(k, 0), length - 1);
+						runningSum[k + width + 1] = runningSum[k + width] + values[start + clamped * stride[direction]];
+					}
+					for (int k = 0; k < length; k++) {
+						line[k] = (runningSum[k + 2 * width + 1] - runningSum[k]) / (2 * width + 1);
+					}
+					for (int k = 0; k < length; k++) {
+						values[start + k * stride[direction]] = line[k];
+					}
+				}
+			}
+		}
+		float peak = 0;
+		itk::ImageRegionConstIterator<intImage> labelIt(labelImage, boundingBox);
+		voxelNr = 0;
+		for (labelIt.GoToBegin(); !labelIt.IsAtEnd(); ++labelIt, ++voxelNr) {
+			if (labelIt.Get() == lesion.label && values[voxelNr] > peak) {
+				peak = values[voxelNr];
+			}
+		}
+		if (config.imageType == "PET" && config.useSUV == 1) {
+			peak = peak * correctionParam;
+		}
+		peakVector.push_back(peak);
+	}
+	return peakVector;
 }
 
 
 //get distance of other lesions to largest lesion in the body
 template<class T, size_t R>
-void DispersityFeatures<T, R>::getBulkFeatures(vector<int> volume, vector<PointType> indices) {
+void DispersityFeatures<T, R>::getBulkFeatures(const vector<int> &volume, const vector<PointType> &indices) {
 	int maxVolume = 0;
 	PointType indexMax;
 	//get index of biggest tumor
@@ -263,7 +268,7 @@ void DispersityFeatures<T, R>::getPeakDispersityFeatures(vector<int> volume, vec
 
 //get features describing the total tumor spread
 template<class T, size_t R>
-void DispersityFeatures<T, R>::getTotalFeatures(vector<int> volume, vector<PointType> indices) {
+void DispersityFeatures<T, R>::getTotalFeatures(const vector<int> &volume, const vector<PointType> &indices) {
 
 	//calculate maxDistance and spread
 	spreadPatient = 0;
@@ -363,38 +368,11 @@ void DispersityFeatures<T, R>::getMaxDispersity(vector<T> maxValues, vector<int>
 	}
 }
 
-//calculate all dispersity features by first:
-//labelling the mask such that each lesion gets a different mask value
-//i.e. lesion 1 is labeled with 1 in the mask, lesion 2 with 2 etc. 
-//this 'labeled' mask is then further used to calculate the different types of dispersity features
+//calculate all dispersity features from the labelled mask:
+//each lesion has a different label, i.e. lesion 1 is labeled with 1, lesion 2 with 2 etc.
+//the statistics table of the labels contains volume, bounding box and maximum of every lesion
 template<class T, size_t R>
-void DispersityFeatures<T, R>::getLabelObjectFeatures(ImageType::Pointer image, ImageType::Pointer mask, ConfigFile config) {
-
-
-	//With the cast filter type function, the mask is converted to an int-image
-	//because otherwise the Label image to shape label map filter is not working
-	typename CastFilterType::Pointer castFilter = CastFilterType::New();
-	castFilter->SetInput(mask);
-	//With the ConnectedComponentFilter from the itk library the connected components of the mask are calculated
-	typename ConnectedComponentFilterType::Pointer connectedComponentImageFilter = ConnectedComponentFilterType::New();
-	connectedComponentImageFilter->SetFullyConnected(true);
-	connectedComponentImageFilter->SetInput(castFilter->GetOutput());
-	connectedComponentImageFilter->Update();
-	//With the label image to shape label map filter the mask is converted to a labeled image
-	typename LabelImageToShapeLabelMapFilterType::Pointer labelImageToShapeLabelMapFilter = LabelImageToShapeLabelMapFilterType::New();
-	labelImageToShapeLabelMapFilter->SetComputeOrientedBoundingBox(true);
-	labelImageToShapeLabelMapFilter->SetComputeFeretDiameter(true);
-	labelImageToShapeLabelMapFilter->SetInput(connectedComponentImageFilter->GetOutput());
-	labelImageToShapeLabelMapFilter->SetComputePerimeter(true);
-	labelImageToShapeLabelMapFilter->Update();
-	LabelMapType *labelMap = labelImageToShapeLabelMapFilter->GetOutput();
-	using LabelMapToLabelImageFilterType = itk::LabelMapToLabelImageFilter<LabelMapType, ImageType>;
-	LabelMapToLabelImageFilterType::Pointer labelImageConverter = LabelMapToLabelImageFilterType::New();
-	labelImageConverter->SetInput(labelMap);
-	labelImageConverter->Update();
-	ImageType::Pointer labeledMask = labelImageConverter->GetOutput();
-	//For every connected component a labelObject is created
-	//Because we are only interested in the object with the label one, we check the label number
+void DispersityFeatures<T, R>::getLabelObjectFeatures(ImageType::Pointer image, const LesionLabels &lesions, ConfigFile config) {
 	DmaxBulk = 0;
 	DmaxPatient = 0;
 	nrLesions = 1;
@@ -418,26 +396,15 @@ void DispersityFeatures<T, R>::getLabelObjectFeatures(ImageType::Pointer image,
 	ratioVolPatient = 0;
 	vector<int> volumes;
 	vector< PointType> actIndices;
-	vector<float> peakVector;
-	int nrPixels;
-	int nrObjects = labelMap->GetNumberOfLabelObjects();
+	int nrObjects = lesions.getNrLabels();
 	if (nrObjects > 1) {
-		//-1 because background is also an object
 		nrLesions = nrObjects;
 		vector<T> maxValues;
-		for (unsigned int n = 0; n < labelMap->GetNumberOfLabelObjects(); n++) {
-			ShapeLabelObjectType *labelObject = labelMap->GetNthLabelObject(n);
-			int labelNr = labelObject->GetLabel();
-
-			//if (labelNr > 0) {
-			nrPixels = labelObject->GetNumberOfPixels();
-			volumes.push_back(nrPixels);
-
-			actIndices.push_back(getMaxIndices(image, labeledMask, labelNr, maxValues));
-			ImageType::Pointer actMask = setMaskOneLesion(labeledMask, labelNr);
-			peakVector.push_back(getPEAKvalues(actMask, image, config));
-			//}
+		for (const LabelStatistics &lesion : lesions.getStatistics()) {
+			volumes.push_back(lesion.nrVoxels);
+			actIndices.push_back(getMaxPoint(image, lesion, maxValues));
 		}
+		vector<float> peakVector = getPEAKvalues(image, lesions, config);
 		getBulkFeatures(volumes, actIndices);
 		getTotalFeatures(volumes, actIndices);
 		getMaxDispersity(maxValues, volumes);
@@ -446,15 +413,12 @@ void DispersityFeatures<T, R>::getLabelObjectFeatures(ImageType::Pointer image,
 
 
 	}
-	//delete object from memory
-	labeledMask = nullptr;
-	labelMap = nullptr;
 }
 
 
 
 template <class T, size_t R>
-void DispersityFeatures<T, R>::calculateAllDispersityFeatures(DispersityFeatures<T, R> &dispFeatures, ImageType::Pointer image, ImageType::Pointer mask, ConfigFile config) {
+void DispersityFeatures<T, R>::calculateAllDispersityFeatures(DispersityFeatures<T, R> &dispFeatures, ImageType::Pointer image, const LesionLabels &lesions, ConfigFile config) {
 	const typename ImageType::SpacingType& inputSpacing = image->GetSpacing();
 	voxelSize[0] = inputSpacing[0];
 	voxelSize[1] = inputSpacing[1];
@@ -465,7 +429,7 @@ void DispersityFeatures<T, R>::calculateAllDispersityFeatures(DispersityFeatures
 	else {
 		correctionParam = config.patientWeight / (config.initActivity * 1000);
 	}
-	getLabelObjectFeatures(image, mask, config);
+	getLabelObjectFeatures(image, lesions, config);
 	volMaxPatient = volMaxPatient*voxelSize[0]* voxelSize[1]* voxelSize[2];
 	volSpreadPatient = volSpreadPatient * voxelSize[0] * voxelSize[1] * voxelSize[2];
 	volSpreadBulk = volSpreadBulk * voxelSize[0] * voxelSize[1] * voxelSize[2];
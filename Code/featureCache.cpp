@@ -0,0 +1,474 @@
+//sections and keys of the config file that never change the features
+const vector<string> featureCacheIgnoredSections = { "FeatureMaps", "FeatureCache", "OutputInformation.OverwriteCSV",
+	"ImageProperties.NrParallelLabels" };
+//sections and keys of the config file that only change some feature families (section or key, first letters of the families)
+const vector<pair<string, vector<string> > > featureCacheFamilySections = {
+	{ "NGLDMParameters", { "NGLDM" } },
+	{ "NGTDMDistance", { "NGTDM" } },
+	{ "DistanceWeightProperties.NormGLCM", { "GLCM" } },
+	{ "DistanceWeightProperties.NormGLRLM", { "GLRLM" } },
+	{ "DistanceWeightProperties.NormNGTDM", { "NGTDM" } },
+	{ "ExtendedEmphasisFeatures", { "GLRLM", "GLSZM", "GLDZM", "NGLDM" } },
+	{ "MorphologicalParameters", { "MorphologicalFeatures" } }
+};
+
+inline uint64_t rotateDigest(uint64_t value, int bits) {
+	return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t mixDigest(uint64_t value) {
+	value += 0x9E3779B97F4A7C15ULL;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+/*!
+\brief add
+The function add adds the data to the digest. The data is processed in words of 8 bytes, the last word is filled with 0 and the size
+of the data is added, so that the digest of "ab" + "c" is different from the digest of "a" + "bc".
+@param[in] data: pointer to the data
+@param[in] size: number of bytes
+*/
+void Digest::add(const void *data, size_t size) {
+	const unsigned char *bytes = static_cast<const unsigned char*>(data);
+	size_t nrWords = size / 8;
+	for (size_t i = 0; i <= nrWords; i++) {
+		uint64_t word = 0;
+		if (i < nrWords) {
+			memcpy(&word, bytes + 8 * i, 8);
+		}
+		else {
+			//last (incomplete) word and size of the data
+			if (size > 8 * nrWords) {
+				memcpy(&word, bytes + 8 * i, size - 8 * nrWords);
+			}
+			word ^= uint64_t(size) << 56 ^ uint64_t(size);
+		}
+		hash1 = (hash1 ^ word) * 0x100000001B3ULL;
+		hash1 ^= hash1 >> 29;
+		hash2 = rotateDigest(hash2 + word * 0xC2B2AE3D27D4EB4FULL, 31) * 0x9E3779B97F4A7C15ULL;
+	}
+}
+
+void Digest::add(const string &text) {
+	add(text.data(), text.size());
+}
+
+void Digest::add(const Digest &digest) {
+	add(digest.hex());
+}
+
+/*!
+\brief addFile
+The function addFile adds the name and the content of a file to the digest. If the path is a folder (e.g. a DICOM folder), all files of
+the folder and its subfolders are added in the order of their names (the DICOM index file of the folder and its temporary files are skipped).
+@param[in] path: file or folder
+@param[out] bool: false if the file or folder cannot be read
+*/
+bool Digest::addFile(const string &path) {
+	std::error_code error;
+	vector<std::filesystem::path> files;
+	std::filesystem::path basePath(path);
+	if (std::filesystem::is_directory(basePath, error)) {
+		for (std::filesystem::recursive_directory_iterator fileIt(basePath, error), end; !error && fileIt != end; fileIt.increment(error)) {
+			if (fileIt->is_regular_file(error) && fileIt->path().filename().string().compare(0, dicomIndexFileName.size(), dicomIndexFileName) != 0) {
+				files.push_back(fileIt->path());
+			}
+		}
+		if (error) {
+			return false;
+		}
+		std::sort(files.begin(), files.end());
+	}
+	else if (std::filesystem::is_regular_file(basePath, error)) {
+		files.push_back(basePath);
+	}
+	else {
+		return false;
+	}
+	vector<char> buffer(1 << 20);
+	for (size_t i = 0; i < files.size(); i++) {
+		add(files[i].lexically_relative(basePath).generic_string());
+		ifstream file(files[i], ios::in | ios::binary);
+		if (!file) {
+			return false;
+		}
+		uintmax_t nrBytes = 0;
+		while (file) {
+			file.read(buffer.data(), buffer.size());
+			add(buffer.data(), size_t(file.gcount()));
+			nrBytes += uintmax_t(file.gcount());
+		}
+		add(&nrBytes, sizeof(nrBytes));
+	}
+	return true;
+}
+
+/*!
+\brief hex
+The function hex returns the digest as 32 hexadecimal characters.
+*/
+string Digest::hex() const {
+	stringstream digest;
+	digest << std::hex << std::setfill('0') << std::setw(16) << mixDigest(hash1 ^ rotateDigest(hash2, 17))
+		<< std::setw(16) << mixDigest(hash2 + hash1);
+	return digest.str();
+}
+
+/*!
+\brief normalizeIniFile
+The function normalizeIniFile reads an ini file and returns all keys as sorted list of lines section.key=value, so that comments,
+the order of the keys and the formatting of the file do not change the digest.
+@param[in] iniFile: path of the ini file
+@param[in] ignoredSections: sections (e.g. FeatureMaps) or keys (e.g. OutputInformation.OverwriteCSV) that are left out
+@param[out] string: the normalized file, empty if the file cannot be read
+*/
+string normalizeIniFile(const string &iniFile, const vector<string> &ignoredSections) {
+	boost::property_tree::ptree pt;
+	try {
+		boost::property_tree::ini_parser::read_ini(iniFile, pt);
+	}
+	catch (boost::property_tree::ini_parser_error&) {
+		return "";
+	}
+	vector<string> lines;
+	for (boost::property_tree::ptree::const_iterator sectionIt = pt.begin(); sectionIt != pt.end(); ++sectionIt) {
+		if (std::find(ignoredSections.begin(), ignoredSections.end(), sectionIt->first) != ignoredSections.end()) {
+			continue;
+		}
+		for (boost::property_tree::ptree::const_iterator keyIt = sectionIt->second.begin(); keyIt != sectionIt->second.end(); ++keyIt) {
+			string key = sectionIt->first + "." + keyIt->first;
+			if (std::find(ignoredSections.begin(), ignoredSections.end(), key) == ignoredSections.end()) {
+				lines.push_back(key + "=" + keyIt->second.data());
+			}
+		}
+	}
+	std::sort(lines.begin(), lines.end());
+	string normalized;
+	for (size_t i = 0; i < lines.size(); i++) {
+		normalized += lines[i] + "\n";
+	}
+	return normalized;
+}
+
+/*!
+\brief getFileDigest
+The function getFileDigest returns the digest of the first nrBytes bytes of a file.
+*/
+string getFileDigest(const string &path, uintmax_t nrBytes) {
+	Digest digest;
+	ifstream file(path, ios::in | ios::binary);
+	vector<char> buffer(1 << 16);
+	while (file && nrBytes > 0) {
+		file.read(buffer.data(), std::streamsize(std::min(uintmax_t(buffer.size()), nrBytes)));
+		digest.add(buffer.data(), size_t(file.gcount()));
+		nrBytes -= uintmax_t(file.gcount());
+		if (file.gcount() == 0) {
+			break;
+		}
+	}
+	return digest.hex();
+}
+
+/*!
+\brief configure
+The function configure switches the cache on if UseCache is set in the config file and the output is written as csv file. \n
+The cache folder is created if it does not exist.
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void FeatureCache::configure(const ConfigFile &config) {
+	enabled = false;
+	if (config.useFeatureCache != 1 || config.csvOutput != 1) {
+		return;
+	}
+	if (config.ontologyOutput == 1) {
+		std::cout << "The feature cache can only be used for the csv output, no features are taken from the cache" << std::endl;
+		return;
+	}
+	outputFolder = config.outputFolder;
+	iniFile = config.fileName;
+	patientInfoFile = config.patientInfoLocation;
+	featureSelectionFile = "";
+	if (config.calculateAllFeatures != 1) {
+		featureSelectionFile = config.featureSelectionLocation;
+	}
+	inputSettings = "useAccurate=" + to_string(config.useAccurate) + ";voiFile=" + to_string(config.voiFile);
+	cacheFolder = config.featureCacheFolder;
+	if (cacheFolder.empty()) {
+		cacheFolder = (std::filesystem::path(outputFolder).parent_path() / "racatFeatureCache").string();
+	}
+	std::error_code error;
+	std::filesystem::create_directories(cacheFolder, error);
+	if (!std::filesystem::is_directory(cacheFolder, error)) {
+		std::cout << "The feature cache folder " << cacheFolder << " cannot be created, no features are taken from the cache" << std::endl;
+		return;
+	}
+	enabled = true;
+}
+
+bool FeatureCache::isEnabled() const {
+	return enabled;
+}
+
+/*!
+\brief getCSVOutputFiles
+The function getCSVOutputFiles lists the csv output files of the case that exist (see featureCSVSuffixes) with their sizes.
+Only these exact file names are used, so the outputs of other cases or calculation modes whose names start with outputFolder
+(e.g. outputFolder_label1.csv) are never taken. The files are identified by the part of the name after outputFolder.
+@param[in] outputFolder: output of the case (without .csv)
+*/
+map<string, uintmax_t> getCSVOutputFiles(const string &outputFolder) {
+	map<string, uintmax_t> files;
+	for (size_t suffixNr = 0; suffixNr < featureCSVSuffixes.size(); suffixNr++) {
+		std::error_code error;
+		uintmax_t fileSize = std::filesystem::file_size(outputFolder + featureCSVSuffixes[suffixNr], error);
+		if (!error) {
+			files[featureCSVSuffixes[suffixNr]] = fileSize;
+		}
+	}
+	return files;
+}
+
+string FeatureCache::getEntryPath(const string &key) const {
+	return (std::filesystem::path(cacheFolder) / (key + ".cache")).string();
+}
+
+/*!
+\brief getConfigDigest
+The function getConfigDigest returns the digest of the normalized config file, patient info file and the settings of the command line.
+@param[in] ignoredSections: sections and keys of the config file that are left out
+*/
+Digest FeatureCache::getConfigDigest(const vector<string> &ignoredSections) const {
+	Digest digest;
+	digest.add(normalizeIniFile(iniFile, ignoredSections));
+	digest.add(normalizeIniFile(patientInfoFile, vector<string>()));
+	digest.add(inputSettings);
+	return digest;
+}
+
+/*!
+\brief getCaseKey
+The function getCaseKey returns the key of the whole case: the digest of the image and mask files, of the config, feature selection
+and patient info files and of the settings of the command line (and of the additional images of the multi-modality mode with their config files).
+@param[in] ConfigFile config: config file with all information of the config.ini file
+@param[out] string: the key, empty if the cache is not used or the image or mask cannot be read
+*/
+string FeatureCache::getCaseKey(const ConfigFile &config) const {
+	if (!enabled) {
+		return "";
+	}
+	Digest digest;
+	digest.add(string("case"));
+	if (!digest.addFile(config.imageName) || !digest.addFile(config.voiName)) {
+		return "";
+	}
+	for (size_t i = 0; i < config.modalityImageNames.size(); i++) {
+		if (!digest.addFile(config.modalityImageNames[i])) {
+			return "";
+		}
+		digest.add(normalizeIniFile(config.modalityConfigFiles[i], vector<string>()));
+	}
+	digest.add(getConfigDigest(featureCacheIgnoredSections));
+	if (featureSelectionFile.empty()) {
+		digest.add(string("all"));
+	}
+	else {
+		digest.add(normalizeIniFile(featureSelectionFile, vector<string>()));
+	}
+	return digest.hex();
+}
+
+/*!
+\brief setImage
+The function setImage calculates the digest of the preprocessed image and mask (voxel values, size, spacing, origin and direction),
+which is part of the key of every feature family.
+@param[in] image: image cut to the bounding box of the mask
+@param[in] mask: binary mask
+*/
+void FeatureCache::setImage(ImageType *image, ImageType *mask) {
+	if (!enabled) {
+		return;
+	}
+	imageDigest = Digest();
+	ImageType *images[2] = { image, mask };
+	for (int i = 0; i < 2; i++) {
+		const ImageType::SizeType size = images[i]->GetBufferedRegion().GetSize();
+		vector<double> geometry;
+		for (unsigned int dim = 0; dim < 3; dim++) {
+			geometry.push_back(double(size[dim]));
+			geometry.push_back(images[i]->GetSpacing()[dim]);
+			geometry.push_back(images[i]->GetOrigin()[dim]);
+			for (unsigned int col = 0; col < 3; col++) {
+				geometry.push_back(images[i]->GetDirection()[dim][col]);
+			}
+		}
+		imageDigest.add(geometry.data(), geometry.size() * sizeof(double));
+		imageDigest.add(images[i]->GetBufferPointer(), images[i]->GetBufferedRegion().GetNumberOfPixels() * sizeof(float));
+	}
+}
+
+/*!
+\brief getFamilyKey
+The function getFamilyKey returns the key of a feature family: the digest of the preprocessed image and mask, the name of the family,
+the selection of the family and the config. Sections of the config that only belong to other families are left out.
+*/
+string FeatureCache::getFamilyKey(const string &family, bool selected) const {
+	vector<string> ignoredSections = featureCacheIgnoredSections;
+	for (size_t i = 0; i < featureCacheFamilySections.size(); i++) {
+		const vector<string> &families = featureCacheFamilySections[i].second;
+		bool usedByFamily = false;
+		for (size_t j = 0; j < families.size(); j++) {
+			usedByFamily = usedByFamily || family.compare(0, families[j].size(), families[j]) == 0;
+		}
+		if (!usedByFamily) {
+			ignoredSections.push_back(featureCacheFamilySections[i].first);
+		}
+	}
+	Digest digest;
+	digest.add(string("family"));
+	digest.add(imageDigest);
+	digest.add(family);
+	digest.add(string(selected ? "1" : "0"));
+	digest.add(getConfigDigest(ignoredSections));
+	return digest.hex();
+}
+
+bool FeatureCache::isCached(const string &family, bool selected) const {
+	std::error_code error;
+	return enabled && std::filesystem::is_regular_file(getEntryPath(getFamilyKey(family, selected)), error);
+}
+
+/*!
+\brief replay
+The function replay writes the output that is stored in the cache entry of the key to the output files. The whole entry is read
+and checked before anything is written, so that a broken entry does not change the output.
+@param[in] key: key of the entry
+@param[out] bool: true if the entry was found and written
+*/
+bool FeatureCache::replay(const string &key) {
+	if (!enabled || key.empty()) {
+		return false;
+	}
+	ifstream entry(getEntryPath(key), ios::in | ios::binary);
+	string line;
+	if (!entry || !getline(entry, line) || line != featureCacheHeader) {
+		return false;
+	}
+	//mode (a: append, w: write the whole file), name and content of every output file, only the csv outputs of a case are written
+	vector<string> modes;
+	vector<string> suffixes;
+	vector<string> contents;
+	while (getline(entry, line)) {
+		stringstream fileInfo(line);
+		string mode;
+		string suffix;
+		string nrBytesText;
+		if (!getline(fileInfo, mode, '\t') || !getline(fileInfo, suffix, '\t') || !getline(fileInfo, nrBytesText)
+			|| (mode != "a" && mode != "w") || std::find(featureCSVSuffixes.begin(), featureCSVSuffixes.end(), suffix) == featureCSVSuffixes.end()
+			|| nrBytesText.find_first_not_of("0123456789") != string::npos || nrBytesText.empty()) {
+			return false;
+		}
+		size_t nrBytes = size_t(std::stoull(nrBytesText));
+		string content(nrBytes, '\0');
+		if (nrBytes > 0 && !entry.read(&content[0], std::streamsize(nrBytes))) {
+			return false;
+		}
+		modes.push_back(mode);
+		suffixes.push_back(suffix);
+		contents.push_back(content);
+	}
+	for (size_t i = 0; i < suffixes.size(); i++) {
+		ios::openmode openMode = ios::out | ios::binary | (modes[i] == "a" ? ios::app : ios::trunc);
+		ofstream output(outputFolder + suffixes[i], openMode);
+		output << contents[i];
+	}
+	return true;
+}
+
+/*!
+\brief replayFamily
+The function replayFamily writes the cached output of a feature family. If the family is not in the cache, nothing is written.
+@param[in] family: name of the feature family
+@param[in] selected: true if the features of the family are selected
+@param[out] bool: true if the output was taken from the cache
+*/
+bool FeatureCache::replayFamily(const string &family, bool selected) {
+	if (!enabled || !replay(getFamilyKey(family, selected))) {
+		return false;
+	}
+	std::cout << "The " << family << " are taken from the feature cache" << std::endl;
+	return true;
+}
+
+/*!
+\brief begin
+The function begin stores the sizes and the content of the output files, store then writes everything that was written afterwards.
+*/
+void FeatureCache::begin() {
+	if (!enabled) {
+		return;
+	}
+	outputSizes = getCSVOutputFiles(outputFolder);
+	outputDigests.clear();
+	for (map<string, uintmax_t>::const_iterator fileIt = outputSizes.begin(); fileIt != outputSizes.end(); ++fileIt) {
+		outputDigests[fileIt->first] = getFileDigest(outputFolder + fileIt->first, fileIt->second);
+	}
+}
+
+/*!
+\brief store
+The function store writes the output since begin to the cache entry of the key. If lines were only appended to an output file,
+the appended lines are stored, otherwise (the file was rewritten) the whole file. \n
+The entry is written to a temporary file first and then renamed, so that other processes never read a half written entry.
+@param[in] key: key of the entry
+*/
+void FeatureCache::store(const string &key) {
+	if (!enabled || key.empty()) {
+		return;
+	}
+	map<string, uintmax_t> currentSizes = getCSVOutputFiles(outputFolder);
+	stringstream content;
+	content << featureCacheHeader << "\n";
+	for (map<string, uintmax_t>::const_iterator fileIt = currentSizes.begin(); fileIt != currentSizes.end(); ++fileIt) {
+		string path = outputFolder + fileIt->first;
+		//new files and files that were rewritten are stored completely
+		uintmax_t startByte = 0;
+		bool appended = false;
+		map<string, uintmax_t>::const_iterator oldIt = outputSizes.find(fileIt->first);
+		if (oldIt != outputSizes.end() && oldIt->second <= fileIt->second && getFileDigest(path, oldIt->second) == outputDigests[fileIt->first]) {
+			if (oldIt->second == fileIt->second) {
+				continue;
+			}
+			startByte = oldIt->second;
+			appended = true;
+		}
+		ifstream output(path, ios::in | ios::binary);
+		output.seekg(std::streamoff(startByte));
+		string fileContent((std::istreambuf_iterator<char>(output)), std::istreambuf_iterator<char>());
+		content << (appended ? "a" : "w") << "\t" << fileIt->first << "\t" << fileContent.size() << "\n"
+			<< fileContent;
+	}
+	string entryPath = getEntryPath(key);
+	stringstream tmpPath;
+	tmpPath << entryPath << ".tmp" << std::hash<std::thread::id>()(std::this_thread::get_id());
+	{
+		ofstream entry(tmpPath.str(), ios::out | ios::binary | ios::trunc);
+		entry << content.str();
+		if (!entry) {
+			std::cout << "The feature cache entry " << entryPath << " cannot be written" << std::endl;
+			return;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(tmpPath.str(), entryPath, error);
+	if (error) {
+		std::filesystem::remove(tmpPath.str(), error);
+	}
+}
+
+void FeatureCache::storeFamily(const string &family, bool selected) {
+	if (enabled) {
+		store(getFamilyKey(family, selected));
+	}
+}
@@ -0,0 +1,114 @@
+#ifndef FEATURECACHE_H_INCLUDED
+#define FEATURECACHE_H_INCLUDED
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/ini_parser.hpp>
+#include "itkTypes.h"
+#include "dicomIndex.h"
+#include "readConfigFile.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+//first line of every cache entry, entries with another first line (e.g. of an older version) are ignored
+const string featureCacheHeader = "RaCaT feature cache 1";
+
+/*!
+The class Digest calculates a 128 bit digest of data (two independent 64 bit hashes), that is used as key of the feature cache.
+*/
+class Digest {
+private:
+	uint64_t hash1;
+	uint64_t hash2;
+
+public:
+	Digest() : hash1(14695981039346656037ULL), hash2(0x9E3779B97F4A7C15ULL) {
+	}
+	~Digest() {
+	}
+	void add(const void *data, size_t size);
+	void add(const string &text);
+	void add(const Digest &digest);
+	bool addFile(const string &path);
+	string hex() const;
+};
+
+/*!
+The class FeatureCache stores the output of the feature calculation in a cache folder, so that reruns (e.g. of a whole cohort after one
+parameter or one case changed) only calculate what actually changed. \n
+The output is cached on two levels: \n
+- the whole case: the key is the digest of the bytes of the image and mask files and of the normalized config, feature selection and
+patient info files. If the key is found, image and mask are not read at all. \n
+- every feature family: the key is the digest of the preprocessed image and mask (the input of the feature calculation), of the
+normalized config (without the sections that only belong to other families) and of the selection of the family. \n
+An entry contains the lines that were appended to the csv output files while the case or the family was calculated; if the entry is
+found, these lines are appended again instead of calculating the features. The cache is only used for the csv output.
+*/
+class FeatureCache {
+private:
+	bool enabled;
+	string cacheFolder;
+	string outputFolder;
+	//config files and settings of the command line that change the features
+	string iniFile;
+	string patientInfoFile;
+	string featureSelectionFile;
+	string inputSettings;
+	//digest of the preprocessed image and mask
+	Digest imageDigest;
+	//sizes and digests of the output files when begin was called
+	map<string, uintmax_t> outputSizes;
+	map<string, string> outputDigests;
+
+	string getEntryPath(const string &key) const;
+	string getFamilyKey(const string &family, bool selected) const;
+	Digest getConfigDigest(const vector<string> &ignoredSections) const;
+
+public:
+	FeatureCache() : enabled(false) {
+	}
+	~FeatureCache() {
+	}
+	void configure(const ConfigFile &config);
+	bool isEnabled() const;
+	string getCaseKey(const ConfigFile &config) const;
+	void setImage(ImageType *image, ImageType *mask);
+	bool isCached(const string &family, bool selected) const;
+	bool replay(const string &key);
+	bool replayFamily(const string &family, bool selected);
+	void begin();
+	void store(const string &key);
+	void storeFamily(const string &family, bool selected);
+};
+
+//csv outputs of a case: outputFolder.csv (GetOneCSVFile) and the files of the feature families
+const vector<string> featureCSVSuffixes = { ".csv", "_statisticalFeatures.csv", "_intensityVolFeat.csv", "_intensityHistogram.csv",
+	"_localIntensity.csv", "_morphologicalFeatures.csv", "_dispersityFeatures.csv", "_glcmFeatures2Davg.csv", "_glcmFeatures2Dmrg.csv",
+	"_glcmFeatures2Dvmrg.csv", "_glcmFeatures2DDmrg.csv", "_glcmFeatures3Davg.csv", "_glcmFeatures3DWmrg.csv", "_GLRLMFeatures2Davg.csv",
+	"_GLRLMFeatures2DWmrg.csv", "_GLRLMFeatures2Dvmrg.csv", "_GLRLMFeatures2DDmrg.csv", "_GLRLMFeatures3Davg.csv", "_GLRLMFeatures3Dmrg.csv",
+	"_GLSZMFeatures2Davg.csv", "_GLSZMFeatures2Dvmrg.csv", "_GLSZMFeatures3D.csv", "_gldzmFeatures2Davg.csv", "_gldzmFeatures2Dmrg.csv",
+	"_gldzmFeatures3D.csv", "_ngtdmFeatures2avg.csv", "_ngtdmFeatures2Dmrg.csv", "_ngldmFeatures2Davg.csv", "_ngldmFeatures2Dmrg.csv",
+	"_ngldmFeatures3D.csv" };
+//csv output files of the case that exist, with their sizes
+map<string, uintmax_t> getCSVOutputFiles(const string &outputFolder);
+//ini file as sorted list of section.key=value lines, without comments and formatting
+string normalizeIniFile(const string &iniFile, const vector<string> &ignoredSections);
+
+#include "featureCache.cpp"
+
+#endif // FEATURECACHE_H_INCLUDED
@@ -1,32 +1,3 @@
-int getNrVoxels(ImageType *mask, float threshold) {
-	int nrInMask = 0;
-	itk::ImageRegionConstIterator<ImageType> countVoxels(mask, mask->GetLargestPossibleRegion());
-	countVoxels.GoToBegin();
-	float maxValue = 0;
-	while (!countVoxels.IsAtEnd())
-	{
-		if (countVoxels.Get() > maxValue)
-		{
-			maxValue = countVoxels.Get();
-		}
-		++countVoxels;
-	}
-	countVoxels.GoToBegin();
-
-	while (!countVoxels.IsAtEnd())
-	{
-		if (countVoxels.Get() > threshold*maxValue)
-		{
-			nrInMask += 1;
-			//std::cout << maxValue << std::endl;
-		}
-		++countVoxels;
-	}
-	return nrInMask;
-}
-
-
-
 ImageType::Pointer flipNII(ImageType::Pointer mask) {
 	typename ImageType::DirectionType direction = mask->GetDirection();
 	using FlipImageFilterType = itk::FlipImageFilter<ImageType>;
@@ -84,82 +55,176 @@ void readImageAndMask(ConfigFile config) {
 	After reading the mask, a bounding box from the region of interest is created. \n
 	The region of this bounding box is extracted from the image and the mask, which leads to smaller subimages.
 	From these subimages, image attributes are extracted.
+	If CropOnRead is set in the config file, only the region around the mask is read from the image (see readCroppedImageAndMask),
+	the image is still resampled on the grid of the whole image. \n
+	If the feature cache is used and the same case was already calculated with the same config, the output is taken from the cache. \n
+	If a texture matrix file is given (LoadMatrices), the features are calculated from this file instead (see calculateFeaturesFromMatrices). \n
+	If CalculatePerturbations is set, the features of perturbed masks are calculated in addition (see calculatePerturbationFeatures). \n
+	If CalculateImageFilters is set, the features of filtered image spaces are calculated in addition (see calculateFilteredFeatures). \n
+	If CubicVoxelSizes is set, the features are calculated for several voxel sizes (see calculatePyramidFeatures). \n
+	If additional images are set in the section MultiModality, their features are calculated with the same mask (see calculateModalityFeatures). \n
+	If time points are set in the section Longitudinal, every time point is calculated like a single case (see calculateLongitudinalFeatures). \n
+	Only one of these calculation modes can be set, the config is checked when it is read (see ConfigFile::checkCalculationModes). \n
+	If WriteTrace is set, every stage of the case is written to the trace (see TraceStage).
 	*/
+	if (!config.timePointImages.empty()) {
+		calculateLongitudinalFeatures(config);
+		return;
+	}
+	TraceStage caseStage(config, "case", "case");
 	ImageType::Pointer image;
 	ImageType::Pointer mask;
 	writeImageData2Log(config);
-	//read image and mask
-	if (config.useAccurate == 0) {
-		image = readImage(config.imageName);
-		std::cout << "The input image is a nifti image" << std::endl;
-		//to get same values for .voi/.prj and .nii, we need to flip the images
-		image = flipNII(image);
-		mask = readImage(config.voiName);
-		mask = flipNII(mask);
+	//the features are calculated from a texture matrix file, the image is not read
+	if (!config.textureMatrixFile.empty()) {
+		calculateFeaturesFromMatrices(config);
+		return;
 	}
-	if (config.useAccurate == 1) {
-		unsigned int dimPET[3];
-		float voxelSize[3];
-		image = readPrjFilePET(config.imageName, config.imageType, config.smoothingKernel, dimPET, voxelSize);
-		mask = readVoiFilePET(config.imageName, config.voiName, image, config, dimPET, voxelSize);
+	//if the image, the mask and the config files did not change, the output is taken from the feature cache
+	FeatureCache caseCache;
+	string caseKey;
+	if (config.featureMaps != 1) {
+		caseCache.configure(config);
+		caseKey = caseCache.getCaseKey(config);
 	}
-	if (config.useAccurate == 2) {
-		image = readDicom(config.imageName);
-
-		if (config.voiFile == 2) {
-			mask = readDicom(config.voiName);
+	if (caseCache.replay(caseKey)) {
+		std::cout << "The features of the case are taken from the feature cache" << std::endl;
+		return;
+	}
+	caseCache.begin();
+	//read image and mask
+	TraceStage stage(config, "read", "read");
+	RegionType cropRegion;
+	//grid of the whole image, the resampling grid is determined from it
+	ImageType::Pointer imageGeometry;
+	if (config.cropOnRead == 1) {
+		readCroppedImageAndMask(config, image, mask, cropRegion, imageGeometry);
+	}
+	else {
+		if (config.useAccurate == 0) {
+			image = readImage(config.imageName);
+			std::cout << "The input image is a nifti image" << std::endl;
+			//to get same values for .voi/.prj and .nii, we need to flip the images
+			image = flipNII(image);
+			mask = readImage(config.voiName);
+			mask = flipNII(mask);
 		}
-		else if (config.voiFile == 3) {
-			mask = readRTstruct(config.voiName, image, mask);
-			//I overwrite the image.
-			//so I read it in again... not the best solution - check again
-			if (config.useAccurate == 0) {
-				image = readImage(config.imageName);
+		if (config.useAccurate == 1) {
+			unsigned int dimPET[3];
+			float voxelSize[3];
+			image = readPrjFilePET(config.imageName, config.imageType, dimPET, voxelSize);
+			if (image.IsNull()) {
+				std::cout << "The image " << config.imageName << " cannot be read" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			mask = readVoiFilePET(config.imageName, config.voiName, image, config, dimPET, voxelSize);
+		}
+		if (config.useAccurate == 2) {
+			image = readDicom(config.imageName);
+
+			if (config.voiFile == 2) {
+				mask = readDicom(config.voiName);
 			}
-			else {
-				image = readDicom(config.imageName);
+			else if (config.voiFile == 3) {
+				mask = readRTstruct(config.voiName, image, config);
 			}
 		}
+		imageGeometry = getImageGeometry(image);
 	}
-	
-		
-	if (config.smoothingKernel > 0) {
-		image = smoothImage(image, config.smoothingKernel);
+
+	stage.setSize(image->GetLargestPossibleRegion().GetNumberOfPixels());
+	stage.next("mask analysis", "preprocessing");
+	//maximum value, number of voxels and bounding box of the mask are determined in one pass
+	MaskAnalysis maskAnalysis;
+	maskAnalysis.analyse(mask, config.threshold);
+	stage.setSize(maskAnalysis.nrVoxels);
+	stage.next("smooth", "preprocessing");
+	stage.setSize(maskAnalysis.nonZeroRegion.GetNumberOfPixels());
+	//the image is smoothed exactly once for all input formats, only in the region around the mask
+	smoothImageRegion(image, maskAnalysis.nonZeroRegion, config);
+	stage.stop();
+	if (config.multiLabel == 1) {
+		calculateLabelFeatures(image, maskAnalysis, imageGeometry, config);
+	}
+	else if (!config.modalityConfigFiles.empty()) {
+		calculateModalityFeatures(image, mask, maskAnalysis, cropRegion, imageGeometry, config);
 	}
-	
-	//resample image if required
-	//get the bounding box of the image voi
-	//RegionType boundingBoxRegion = getBoundingBoxMask(mask);
+	else if (!config.pyramidVoxelSizes.empty()) {
+		calculatePyramidFeatures(image, mask, maskAnalysis, imageGeometry, config);
+	}
+	else {
+		ResampleGrid grid;
+		if (config.useSamplingCubic == 1 || config.useDownSampling != 0 || config.useUpSampling != 0) {
+			grid = getResampleGrid(imageGeometry, config);
+		}
+		if (config.maskPerturbation == 1) {
+			calculatePerturbationFeatures(image, mask, maskAnalysis, grid, config);
+		}
+		else if (config.imageFilters == 1) {
+			calculateFilteredFeatures(image, mask, maskAnalysis, grid, config);
+		}
+		else {
+			calculateMaskFeatures(image, mask, maskAnalysis, grid, config);
+		}
+	}
+	caseCache.store(caseKey);
+}
+
+/*!
+The function labelLesions labels the connected components of the voxels inside the mask (see MaskAnalysis::getBinaryMask) in the
+bounding box of the mask (see LesionLabels). \n
+The mask is labelled once per grid: the dispersity features use the labels on the grid of the loaded image, the morphological
+features the labels on the grid the features are calculated on. If the image is not resampled, both are the same labels.
+@param[in] image: the image, it has the same grid as the mask
+@param[in] maskAnalysis: the analysed mask
+@param[out] lesions: label image and statistics of the lesions
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void labelLesions(ImageType *image, const MaskAnalysis &maskAnalysis, LesionLabels &lesions, ConfigFile config) {
+	if (maskAnalysis.nrVoxels == 0) {
+		lesions = LesionLabels();
+		return;
+	}
+	TraceStage stage(config, "lesion labels", "preprocessing", maskAnalysis.nrVoxels);
+	lesions.calculate(maskAnalysis.getBinaryMask(), getImageMasked(image, maskAnalysis.boundingBox));
+}
+
+/*!
+The function calculateMaskFeatures calculates the features of one mask: the mask is resampled (if required) and image and mask
+are cut to the bounding box of the mask before the features are calculated. \n
+Image and mask are released as soon as they are not needed anymore.
+@param[in,out] image: the (smoothed) image
+@param[in,out] mask: the mask, it has the same grid as the image
+@param[in] maskAnalysis: the analysed mask
+@param[in] grid: grid of the resampled whole image (only used if the image is resampled)
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculateMaskFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config) {
+	int nrVoxelsInMask = maskAnalysis.nrVoxels;
 	ImageType::Pointer maskFiltered = mask;
 	ImageType::Pointer imageFiltered = image;
-	int nrVoxelsInMask = getNrVoxels(maskFiltered, config.threshold);
-	
-	
-	const typename ImageType::SpacingType& inputSpacing = image->GetSpacing();
-	storePreInterpolationFeatures(image, mask, config);
+	LesionLabels lesions;
+	labelLesions(image, maskAnalysis, lesions, config);
+	storePreInterpolationFeatures(image, maskAnalysis, lesions, config);
 	if (nrVoxelsInMask < 5) {
 		fillCSVwithNANs(config);
 	}
 	else{
 		//now down or upsample the image
 		if (config.useSamplingCubic == 1 || config.useDownSampling != 0 || config.useUpSampling != 0) {
-			const typename ImageType::RegionType& imageRegion = image->GetLargestPossibleRegion();
-			const typename ImageType::SizeType& imageRegionSize = imageRegion.GetSize();
-			double outputSpacing[3];
-			vector<int> newImageSize = getImageSizeInterpolated(image, imageRegionSize, outputSpacing, config);
-			itk::Size<3> outputSize = { { double(newImageSize[0]), double(newImageSize[1]), double(newImageSize[2]) } };
-			Image<float, 3> imageMask(1, 1, 1);
-			imageFiltered = imageMask.getResampledImage(imageFiltered, outputSpacing, outputSize, config.interpolationMethod, config.rebinning_centering);
-			maskFiltered = imageMask.getResampledImage(maskFiltered, outputSpacing, outputSize, "Linear", config.rebinning_centering);
-		}
-		//convert mask values to 1 (necessary after interpolation)
-		maskFiltered = thresholdMask(maskFiltered, config.threshold);
-		//get the region of the mask
-		RegionType boundingBoxRegion = getBoundingBoxMask(maskFiltered);
-		itk::Size<3> regionSize = boundingBoxRegion.GetSize();
-		//shrink image and mask to the mask region
-		imageFiltered = getImageMasked(imageFiltered, boundingBoxRegion);
-		maskFiltered = getImageMasked(maskFiltered, boundingBoxRegion);
+			TraceStage resampleStage(config, "resample", "preprocessing");
+			//only the region around the mask is resampled
+			resampleMaskRegion(imageFiltered, maskFiltered, maskAnalysis.nonZeroRegion, grid, config);
+			//the interpolated mask has new values, so it has to be analysed again
+			maskAnalysis.analyse(maskFiltered, config.threshold);
+			resampleStage.setSize(imageFiltered->GetLargestPossibleRegion().GetNumberOfPixels());
+			resampleStage.stop();
+			//the resampled mask is on a new grid, so it is labelled again
+			labelLesions(imageFiltered, maskAnalysis, lesions, config);
+		}
+		//shrink image and mask to the mask region and convert mask values to 1 (necessary after interpolation)
+		imageFiltered = getImageMasked(imageFiltered, maskAnalysis.boundingBox);
+		maskFiltered = maskAnalysis.getBinaryMask();
 
 		//for ontology table
 		const typename ImageType::SpacingType& spacingVoxelDim = imageFiltered->GetSpacing();
@@ -171,13 +236,656 @@ void readImageAndMask(ConfigFile config) {
 		imageVoxelDim.createOntologyVoxelDimensionTable(config, voxelSize);
 		mask = nullptr;
 		image = nullptr;
-		calculateFeatures(imageFiltered, maskFiltered, config);
+		calculateFeatures(imageFiltered, maskFiltered, &lesions, config);
 		
 	}	
 }
 
+/*!
+The function calculatePerturbationFeatures calculates the features of the mask and of perturbed versions of the mask (see MaskPerturbation).
+The image is read, smoothed and resampled only once, the perturbed masks are created in memory on the grid of the resampled image. \n
+Image and mask are cut to the bounding box of the mask enlarged by the largest perturbation, so that all masks have the same grid.
+The GLCM and GLRLM count matrices of the mask are kept in the texture matrix store, the matrices of a perturbed mask are calculated from
+them and the voxels that differ between both masks (see TextureMatrixStore::loadPairDelta and TextureMatrixStore::loadRunDelta). \n
+The results of every perturbed mask are written to an own output, its name is extended by _perturbation_ and the name of the perturbation.
+The features before the interpolation (exact metrics and dispersity features) are only calculated for the mask itself.
+@param[in,out] image: the (smoothed) image
+@param[in,out] mask: the mask, it has the same grid as the image
+@param[in] maskAnalysis: the analysed mask
+@param[in] grid: grid of the resampled whole image (only used if the image is resampled)
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculatePerturbationFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config) {
+	MaskPerturbation perturbation;
+	perturbation.configure(config);
+	LesionLabels lesions;
+	labelLesions(image, maskAnalysis, lesions, config);
+	storePreInterpolationFeatures(image, maskAnalysis, lesions, config);
+	if (maskAnalysis.nrVoxels < 5) {
+		fillCSVwithNANs(config);
+		return;
+	}
+	ImageType::Pointer maskFiltered = mask;
+	ImageType::Pointer imageFiltered = image;
+	mask = nullptr;
+	image = nullptr;
+	if (config.useSamplingCubic == 1 || config.useDownSampling != 0 || config.useUpSampling != 0) {
+		resampleMaskRegion(imageFiltered, maskFiltered, maskAnalysis.nonZeroRegion, grid, config);
+		maskAnalysis.analyse(maskFiltered, config.threshold);
+	}
+	RegionType perturbationRegion = perturbation.getPerturbationRegion(maskAnalysis.boundingBox, imageFiltered->GetLargestPossibleRegion());
+	imageFiltered = getImageMasked(imageFiltered, perturbationRegion);
+	ImageType::Pointer baseMask = maskAnalysis.getBinaryMask(perturbationRegion);
+	maskFiltered = nullptr;
+
+	//for ontology table
+	const typename ImageType::SpacingType& spacingVoxelDim = imageFiltered->GetSpacing();
+	float voxelSize[3];
+	for (int i = 0; i < 3; i++) {
+		voxelSize[i] = (float)spacingVoxelDim[i];
+	}
+	Image<float, 3> imageVoxelDim(10, 10, 10);
+	imageVoxelDim.createOntologyVoxelDimensionTable(config, voxelSize);
+	//the matrices of the mask are kept for the perturbed masks
+	TextureMatrixStore &matrixStore = TextureMatrixStore::caseStore();
+	matrixStore.startPerturbations();
+	//the masks have the region of the perturbations, so their lesions are labelled on this region
+	lesions.calculate(baseMask);
+	calculateFeatures(imageFiltered, baseMask, &lesions, config);
+	for (size_t perturbationNr = 0; perturbationNr < perturbation.getNrPerturbations(); perturbationNr++) {
+		ConfigFile perturbationConfig = config;
+		perturbationConfig.outputFolder = config.outputFolder + "_perturbation_" + perturbation.getName(perturbationNr);
+		//texture matrix files and feature maps are only written for the mask itself
+		perturbationConfig.storeTextureMatrices = 0;
+		perturbationConfig.featureMaps = 0;
+		if (config.csvOutput == 1) {
+			perturbationConfig.createOutputFile(perturbationConfig);
+			ofstream perturbationCSV(perturbationConfig.outputFolder + ".csv", std::ios_base::app);
+			perturbationCSV << "Perturbation" << "," << "Mask perturbation" << "," << perturbation.getName(perturbationNr) << "\n";
+		}
+		else if (config.ontologyOutput == 1) {
+			std::error_code error;
+			std::filesystem::create_directories(perturbationConfig.outputFolder, error);
+		}
+		imageVoxelDim.createOntologyVoxelDimensionTable(perturbationConfig, voxelSize);
+		int nrVoxels;
+		ImageType::Pointer perturbedMask = perturbation.getPerturbedMask(baseMask, perturbationNr, nrVoxels);
+		std::cout << "Calculate the features of the perturbed mask " << perturbation.getName(perturbationNr) << std::endl;
+		if (nrVoxels < 5) {
+			fillCSVwithNANs(perturbationConfig);
+		}
+		else {
+			LesionLabels perturbedLesions;
+			perturbedLesions.calculate(perturbedMask);
+			calculateFeatures(imageFiltered, perturbedMask, &perturbedLesions, perturbationConfig);
+		}
+	}
+	matrixStore.reset();
+}
+
+/*!
+The function runParallelImages distributes images (time points, image spaces or labels) over several threads (see runParallel). \n
+Besides the threads of RaCaT, the ITK filters start their own threads. While the images are calculated, the ITK filters only use
+the thread budget of one image, so that not every image starts as many ITK threads as there are cores. The number of ITK threads is
+global, it is only changed by the outermost parallel part: nested parts keep the ITK threads of the outer part.
+@param[in] nrItems: number of images
+@param[in] nrThreads: number of threads, if 0 the thread budget is used (see getNrThreads)
+@param[in] process: function that calculates one image
+*/
+void runParallelImages(size_t nrItems, unsigned int nrThreads, const std::function<void(size_t)> &process) {
+	unsigned int nrUsedThreads = getNrThreads(nrThreads, nrItems);
+	if (nrUsedThreads == 1 || parallelThreadBudget() != 0) {
+		runParallel(nrItems, nrUsedThreads, process);
+		return;
+	}
+	itk::ThreadIdType nrITKThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+	itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(itk::ThreadIdType(getItemThreadBudget(nrUsedThreads)));
+	runParallel(nrItems, nrUsedThreads, process);
+	itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(nrITKThreads);
+}
+
+/*!
+The function calculateFilteredFeatures calculates the features of the image and of filtered versions of the image (image spaces,
+see ImageFilters). The image is read, smoothed and resampled only once, the region around the mask that the filters need is
+resampled with it. \n
+The image spaces are distributed over NrParallelImageSpaces threads: every thread cuts the bounding box of the mask (one after the
+other, as the ITK pipeline cannot be used by several threads at the same time), replaces the values by the filter response and
+calculates the features. \n
+The results of every filtered image space are written to an own output, its name is extended by _ and the name of the image space.
+The original image keeps the output of the config. The features before the interpolation (exact metrics and dispersity features)
+are only calculated for the original image.
+@param[in,out] image: the (smoothed) image
+@param[in,out] mask: the mask, it has the same grid as the image
+@param[in] maskAnalysis: the analysed mask
+@param[in] grid: grid of the resampled whole image (only used if the image is resampled)
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculateFilteredFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config) {
+	ImageFilters imageFilters;
+	imageFilters.configure(config);
+	//every image space gets its own output
+	vector<ConfigFile> spaceConfigs(imageFilters.getNrImageSpaces(), config);
+	for (size_t spaceNr = 0; spaceNr < imageFilters.getNrImageSpaces(); spaceNr++) {
+		ConfigFile &spaceConfig = spaceConfigs[spaceNr];
+		spaceConfig.imageSpaceName = imageFilters.getName(spaceNr);
+		if (imageFilters.isOriginal(spaceNr)) {
+			continue;
+		}
+		spaceConfig.outputFolder = config.outputFolder + "_" + imageFilters.getName(spaceNr);
+		if (config.csvOutput == 1) {
+			spaceConfig.createOutputFile(spaceConfig);
+			ofstream spaceCSV(spaceConfig.outputFolder + ".csv", std::ios_base::app);
+			spaceCSV << "ImageSpace" << "," << "Image filter" << "," << imageFilters.getName(spaceNr) << "\n";
+		}
+		else if (config.ontologyOutput == 1) {
+			std::error_code error;
+			std::filesystem::create_directories(spaceConfig.outputFolder, error);
+		}
+	}
+	LesionLabels lesions;
+	labelLesions(image, maskAnalysis, lesions, config);
+	storePreInterpolationFeatures(image, maskAnalysis, lesions, config);
+	if (maskAnalysis.nrVoxels < 5) {
+		for (size_t spaceNr = 0; spaceNr < spaceConfigs.size(); spaceNr++) {
+			fillCSVwithNANs(spaceConfigs[spaceNr]);
+		}
+		return;
+	}
+	ImageType::Pointer maskFiltered = mask;
+	ImageType::Pointer imageFiltered = image;
+	mask = nullptr;
+	image = nullptr;
+	//the filters read the values around the mask, so this region is kept (and resampled)
+	RegionType filterRegion = getPaddedRegion(maskAnalysis.nonZeroRegion, imageFiltered->GetLargestPossibleRegion(), imageFiltered->GetSpacing(),
+		getValueMargin(config), nrCropVoxelsInterpolation + imageFilters.getMarginVoxels());
+	TraceStage resampleStage(config, "resample", "preprocessing");
+	if (config.useSamplingCubic == 1 || config.useDownSampling != 0 || config.useUpSampling != 0) {
+		resampleMaskRegion(imageFiltered, maskFiltered, filterRegion, grid, config);
+	}
+	else {
+		imageFiltered = getImageMasked(imageFiltered, filterRegion);
+		maskFiltered = getImageMasked(maskFiltered, filterRegion);
+	}
+	maskAnalysis.analyse(maskFiltered, config.threshold);
+	resampleStage.setSize(imageFiltered->GetLargestPossibleRegion().GetNumberOfPixels());
+	resampleStage.stop();
+	if (config.useSamplingCubic == 1 || config.useDownSampling != 0 || config.useUpSampling != 0) {
+		//the resampled mask is on a new grid, so it is labelled again, all image spaces use the same labels
+		labelLesions(imageFiltered, maskAnalysis, lesions, config);
+	}
 
-void calculateFeatures(ImageType *imageFiltered, ImageType *maskNewSpacing, ConfigFile config) {
+	//for ontology table
+	const typename ImageType::SpacingType& spacingVoxelDim = imageFiltered->GetSpacing();
+	float voxelSize[3];
+	for (int i = 0; i < 3; i++) {
+		voxelSize[i] = (float)spacingVoxelDim[i];
+	}
+	Image<float, 3> imageVoxelDim(10, 10, 10);
+	for (size_t spaceNr = 0; spaceNr < spaceConfigs.size(); spaceNr++) {
+		imageVoxelDim.createOntologyVoxelDimensionTable(spaceConfigs[spaceNr], voxelSize);
+		if (config.ontologyOutput == 1) {
+			spaceConfigs[spaceNr].createOntologyImageFilterSpaceTable(spaceConfigs[spaceNr]);
+		}
+	}
+
+	std::mutex cutMutex;
+	runParallelImages(spaceConfigs.size(), unsigned(config.nrParallelImageSpaces), [&](size_t spaceNr) {
+		ImageType::Pointer spaceImage;
+		ImageType::Pointer spaceMask;
+		{
+			std::lock_guard<std::mutex> lock(cutMutex);
+			spaceImage = getImageMasked(imageFiltered, maskAnalysis.boundingBox);
+			spaceImage->DisconnectPipeline();
+			spaceMask = maskAnalysis.getBinaryMask();
+		}
+		std::cout << "Calculate the features of the image space " << imageFilters.getName(spaceNr) << std::endl;
+		TraceStage filterStage(spaceConfigs[spaceNr], imageFilters.getName(spaceNr), "filter", imageFiltered->GetLargestPossibleRegion().GetNumberOfPixels());
+		imageFilters.filter(imageFiltered, maskAnalysis.boundingBox, spaceNr, spaceImage);
+		filterStage.stop();
+		calculateFeatures(spaceImage, spaceMask, &lesions, spaceConfigs[spaceNr]);
+	});
+}
+
+/*!
+The function calculatePyramidFeatures calculates the features for every voxel size of CubicVoxelSizes (multi-resolution mode). \n
+Image and mask are read, cropped and smoothed only once. For every voxel size the region around the mask is resampled on the
+grid of the whole image with this voxel size (see calculateMaskFeatures). Every voxel size is interpolated from the loaded image and not
+from the previous voxel size, as interpolating an interpolated image would smooth it again and change the features. \n
+The results of every voxel size are written to an own output, its name is extended by _voxelSize, the voxel size and mm.
+The features before the interpolation (exact metrics and dispersity features) do not depend on the voxel size, they are only
+calculated once and written to the output of the config.
+@param[in,out] image: the (smoothed) image
+@param[in,out] mask: the mask, it has the same grid as the image
+@param[in] maskAnalysis: the analysed mask
+@param[in] imageGeometry: grid of the whole image (see getImageGeometry)
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculatePyramidFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, const MaskAnalysis &maskAnalysis, ImageType *imageGeometry, ConfigFile config) {
+	//every voxel size gets its own output
+	vector<ConfigFile> levelConfigs(config.pyramidVoxelSizes.size(), config);
+	for (size_t levelNr = 0; levelNr < levelConfigs.size(); levelNr++) {
+		ConfigFile &levelConfig = levelConfigs[levelNr];
+		levelConfig.cubicVoxelSize = config.pyramidVoxelSizes[levelNr];
+		levelConfig.pyramidVoxelSizes.clear();
+		levelConfig.outputFolder = config.outputFolder + "_voxelSize" + to_string(levelConfig.cubicVoxelSize) + "mm";
+		if (config.csvOutput == 1) {
+			levelConfig.createOutputFile(levelConfig);
+			ofstream levelCSV(levelConfig.outputFolder + ".csv", std::ios_base::app);
+			levelCSV << "Resolution" << "," << "Cubic voxel size" << "," << levelConfig.cubicVoxelSize << "\n";
+		}
+		else if (config.ontologyOutput == 1) {
+			std::error_code error;
+			std::filesystem::create_directories(levelConfig.outputFolder, error);
+		}
+	}
+	LesionLabels lesions;
+	labelLesions(image, maskAnalysis, lesions, config);
+	storePreInterpolationFeatures(image, maskAnalysis, lesions, config);
+	for (size_t levelNr = 0; levelNr < levelConfigs.size(); levelNr++) {
+		const ConfigFile &levelConfig = levelConfigs[levelNr];
+		if (maskAnalysis.nrVoxels < 5) {
+			fillCSVwithNANs(levelConfig);
+			continue;
+		}
+		std::cout << "Calculate the features with the cubic voxel size " << levelConfig.cubicVoxelSize << " mm" << std::endl;
+		ResampleGrid grid = getResampleGrid(imageGeometry, levelConfig);
+		ImageType::Pointer imageFiltered = image;
+		ImageType::Pointer maskFiltered = mask;
+		//the region around the mask is resampled, the loaded image is kept for the next voxel size
+		TraceStage resampleStage(levelConfig, "resample", "preprocessing");
+		resampleMaskRegion(imageFiltered, maskFiltered, maskAnalysis.nonZeroRegion, grid, levelConfig);
+		MaskAnalysis levelAnalysis;
+		levelAnalysis.analyse(maskFiltered, config.threshold);
+		resampleStage.setSize(imageFiltered->GetLargestPossibleRegion().GetNumberOfPixels());
+		resampleStage.stop();
+		LesionLabels levelLesions;
+		labelLesions(imageFiltered, levelAnalysis, levelLesions, levelConfig);
+		imageFiltered = getImageMasked(imageFiltered, levelAnalysis.boundingBox);
+		maskFiltered = levelAnalysis.getBinaryMask();
+
+		//for ontology table
+		const typename ImageType::SpacingType& spacingVoxelDim = imageFiltered->GetSpacing();
+		float voxelSize[3];
+		for (int i = 0; i < 3; i++) {
+			voxelSize[i] = (float)spacingVoxelDim[i];
+		}
+		Image<float, 3> imageVoxelDim(10, 10, 10);
+		imageVoxelDim.createOntologyVoxelDimensionTable(levelConfig, voxelSize);
+		calculateFeatures(imageFiltered, maskFiltered, &levelLesions, levelConfig);
+	}
+	mask = nullptr;
+	image = nullptr;
+}
+
+/*!
+The function calculateModalityFeatures calculates the features of several co-registered images (e.g. PET and CT) in the same mask
+(multi-modality mode). The mask is read, analysed and labelled only once: the features before the interpolation (exact metrics and
+dispersity features) and the morphological features are calculated once with the image of the command line. \n
+The additional images are read one after the other (see readModalityImage), smoothed and calculated with their own config
+(see ConfigFile::getModalityConfig), so every image is resampled and discretized with its own settings, but only the intensity and
+texture families are calculated. \n
+Every image is calculated with its own output outputFolder_modalityN (N = 0 for the image of the command line), which keeps its ontology
+tables, texture matrices, feature maps and log. The csv lines of the image are then moved to the output of the config, so all features
+are in one row; the names of the features of every image start with its image type (e.g. CT_meanIntensity, see appendPrefixedFeatures).
+@param[in,out] image: the (smoothed) image of the command line
+@param[in,out] mask: the mask, it has the same grid as the image
+@param[in] maskAnalysis: the analysed mask
+@param[in] cropRegion: region of the image files that was read (see readCroppedImageAndMask), empty if the whole images were read
+@param[in] imageGeometry: grid of the whole image (see getImageGeometry), the additional images are brought on this grid
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculateModalityFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, const MaskAnalysis &maskAnalysis, const RegionType &cropRegion, ImageType *imageGeometry, ConfigFile config) {
+	LesionLabels lesions;
+	labelLesions(image, maskAnalysis, lesions, config);
+	storePreInterpolationFeatures(image, maskAnalysis, lesions, config);
+	if (maskAnalysis.nrVoxels < 5) {
+		fillCSVwithNANs(config);
+		mask = nullptr;
+		image = nullptr;
+		return;
+	}
+	//images of the same type get a number, so that the feature names stay unique
+	map<string, int> imageTypeCounts;
+	for (size_t modalityNr = 0; modalityNr <= config.modalityConfigFiles.size(); modalityNr++) {
+		ConfigFile modalityConfig = config;
+		if (modalityNr > 0) {
+			modalityConfig = config.getModalityConfig(modalityNr - 1);
+		}
+		modalityConfig.outputFolder = config.outputFolder + "_modality" + to_string(modalityNr);
+		//csv lines of a previous run are not moved again
+		map<string, uintmax_t> oldOutputs = getCSVOutputFiles(modalityConfig.outputFolder);
+		for (map<string, uintmax_t>::const_iterator fileIt = oldOutputs.begin(); fileIt != oldOutputs.end(); ++fileIt) {
+			std::error_code error;
+			std::filesystem::remove(modalityConfig.outputFolder + fileIt->first, error);
+		}
+		if (config.ontologyOutput == 1) {
+			std::error_code error;
+			std::filesystem::create_directories(modalityConfig.outputFolder, error);
+		}
+		ImageType::Pointer imageFiltered = image;
+		if (modalityNr > 0) {
+			imageFiltered = readModalityImage(modalityConfig, mask, cropRegion);
+			if (imageFiltered.IsNull()) {
+				std::cout << "The image " << modalityConfig.imageName << " cannot be read, its features are not calculated" << std::endl;
+				continue;
+			}
+			smoothImageRegion(imageFiltered, maskAnalysis.nonZeroRegion, modalityConfig);
+		}
+		else {
+			image = nullptr;
+		}
+		std::cout << "Calculate the features of the " << modalityConfig.imageType << " image " << modalityConfig.imageName << std::endl;
+		string prefix = modalityConfig.imageType;
+		int imageTypeCount = ++imageTypeCounts[prefix];
+		if (imageTypeCount > 1) {
+			prefix += to_string(imageTypeCount);
+		}
+		//the mask is needed for the next image, so the resampled mask and its analysis are kept apart
+		ImageType::Pointer maskFiltered = mask;
+		MaskAnalysis modalityAnalysis = maskAnalysis;
+		if (modalityConfig.useSamplingCubic == 1 || modalityConfig.useDownSampling != 0 || modalityConfig.useUpSampling != 0) {
+			ResampleGrid grid = getResampleGrid(imageGeometry, modalityConfig);
+			TraceStage resampleStage(modalityConfig, "resample", "preprocessing");
+			resampleMaskRegion(imageFiltered, maskFiltered, maskAnalysis.nonZeroRegion, grid, modalityConfig);
+			modalityAnalysis.analyse(maskFiltered, modalityConfig.threshold);
+			resampleStage.setSize(imageFiltered->GetLargestPossibleRegion().GetNumberOfPixels());
+			resampleStage.stop();
+			//the morphological features are calculated on the grid of the first image
+			if (modalityNr == 0) {
+				labelLesions(imageFiltered, modalityAnalysis, lesions, modalityConfig);
+			}
+		}
+		imageFiltered = getImageMasked(imageFiltered, modalityAnalysis.boundingBox);
+		maskFiltered = modalityAnalysis.getBinaryMask();
+
+		//for ontology table
+		const typename ImageType::SpacingType& spacingVoxelDim = imageFiltered->GetSpacing();
+		float voxelSize[3];
+		for (int i = 0; i < 3; i++) {
+			voxelSize[i] = (float)spacingVoxelDim[i];
+		}
+		Image<float, 3> imageVoxelDim(10, 10, 10);
+		imageVoxelDim.createOntologyVoxelDimensionTable(modalityConfig, voxelSize);
+		calculateFeatures(imageFiltered, maskFiltered, modalityNr == 0 ? &lesions : nullptr, modalityConfig);
+		appendPrefixedFeatures(modalityConfig.outputFolder, config.outputFolder, prefix + "_", "Morphology");
+	}
+	mask = nullptr;
+}
+
+/*!
+The function appendPrefixedFeatures moves the csv outputs of one image of the multi-modality mode (see getCSVOutputFiles) to the
+csv outputs of the case: their lines are appended to the file of the case with the same name and the files of the image are removed.
+The lines have the form group,feature name,value; the prefix is put in front of the feature names.
+@param[in] imageOutput: output of the image (without .csv)
+@param[in] outputFolder: output of the case (without .csv)
+@param[in] prefix: prefix of the feature names
+@param[in] keptGroup: group whose feature names are not changed (e.g. the morphological features, which belong to the mask)
+*/
+void appendPrefixedFeatures(const string &imageOutput, const string &outputFolder, const string &prefix, const string &keptGroup) {
+	map<string, uintmax_t> imageFiles = getCSVOutputFiles(imageOutput);
+	for (map<string, uintmax_t>::const_iterator fileIt = imageFiles.begin(); fileIt != imageFiles.end(); ++fileIt) {
+		string imagePath = imageOutput + fileIt->first;
+		string prefixed;
+		{
+			ifstream imageCSV(imagePath);
+			string line;
+			while (getline(imageCSV, line)) {
+				size_t nameStart = line.find(',');
+				if (nameStart != string::npos && line.find(',', nameStart + 1) != string::npos && line.compare(0, nameStart, keptGroup) != 0) {
+					line.insert(nameStart + 1, prefix);
+				}
+				prefixed += line + "\n";
+			}
+		}
+		ofstream caseCSV(outputFolder + fileIt->first, std::ios_base::app);
+		caseCSV << prefixed;
+		if (!caseCSV) {
+			std::cout << "The features of " << imagePath << " cannot be written to " << outputFolder << fileIt->first << std::endl;
+			continue;
+		}
+		caseCSV.close();
+		std::error_code error;
+		std::filesystem::remove(imagePath, error);
+	}
+}
+
+/*!
+The function readModalityImage reads an additional image of the multi-modality mode in the format of the config (nifti, .prj file
+of the accurate tool or dicom) and brings it on the grid of the mask: if the image has the spacing and the direction of the mask and
+the voxels are aligned, the region of the mask is cut from the image, otherwise the image is resampled on the grid of the mask
+(with the interpolation method of the config). \n
+Nifti images are flipped like the mask, so if only a region of the mask was read, the same region is read from the image before flipping.
+@param[in] ConfigFile config: config of the image (see ConfigFile::getModalityConfig)
+@param[in] mask: the mask (possibly cut from a larger image)
+@param[in] cropRegion: region of the mask file that was read, empty if the whole mask was read
+@param[out] ImageType: the image on the grid of the mask, null if it cannot be read
+*/
+ImageType::Pointer readModalityImage(ConfigFile config, ImageType *mask, const RegionType &cropRegion) {
+	TraceStage readStage(config, "read", "read", mask->GetLargestPossibleRegion().GetNumberOfPixels());
+	ImageType::Pointer modalityImage;
+	if (config.useAccurate == 0) {
+		if (cropRegion.GetNumberOfPixels() > 0) {
+			modalityImage = readImageRegion(config.imageName, cropRegion);
+		}
+		else {
+			modalityImage = readImage(config.imageName);
+		}
+		modalityImage = flipNII(modalityImage);
+	}
+	else if (config.useAccurate == 1) {
+		unsigned int dimPET[3];
+		float voxelSize[3];
+		modalityImage = readPrjFilePET(config.imageName, config.imageType, dimPET, voxelSize);
+	}
+	else if (config.useAccurate == 2) {
+		modalityImage = readDicom(config.imageName);
+	}
+	if (modalityImage.IsNull()) {
+		return modalityImage;
+	}
+	const RegionType &maskRegion = mask->GetLargestPossibleRegion();
+	const RegionType &imageRegion = modalityImage->GetLargestPossibleRegion();
+	itk::ContinuousIndex<double, 3> maskStart;
+	modalityImage->TransformPhysicalPointToContinuousIndex(mask->GetOrigin(), maskStart);
+	bool sameGrid = modalityImage->GetDirection() == mask->GetDirection();
+	RegionType cutRegion;
+	for (int i = 0; i < 3; i++) {
+		long startIndex = long(std::lround(maskStart[i]));
+		sameGrid = sameGrid && std::abs(modalityImage->GetSpacing()[i] - mask->GetSpacing()[i]) < 1e-4 * mask->GetSpacing()[i]
+			&& std::abs(maskStart[i] - startIndex) < 1e-3;
+		cutRegion.SetIndex(i, startIndex);
+		cutRegion.SetSize(i, maskRegion.GetSize()[i]);
+	}
+	if (sameGrid && imageRegion.IsInside(cutRegion)) {
+		if (cutRegion == imageRegion) {
+			return modalityImage;
+		}
+		return getImageMasked(modalityImage, cutRegion);
+	}
+	std::cout << "The image " << config.imageName << " does not have the grid of the mask, it is resampled" << std::endl;
+	double maskSpacing[3] = { mask->GetSpacing()[0], mask->GetSpacing()[1], mask->GetSpacing()[2] };
+	Image<float, 3> imageResample(1, 1, 1);
+	return imageResample.resampleToGrid(modalityImage, maskSpacing, mask->GetOrigin(), maskRegion.GetSize(), config.interpolationMethod);
+}
+
+/*!
+The function calculateLongitudinalFeatures calculates the features of all time points of a patient (longitudinal mode). \n
+The time points share the config and the feature selection, every time point is read and calculated like a single case
+(see readImageAndMask) with its own output (outputFolder_name of the time point). NrParallelTimePoints time points are
+calculated at the same time, the cores are split between the time points (see runParallelImages). \n
+Afterwards the csv outputs are joined to the table outputFolder_longitudinal.csv, which contains the values of all time points,
+their changes to the first time point and the relative changes (see LongitudinalTable).
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculateLongitudinalFeatures(ConfigFile config) {
+	vector<ConfigFile> timePointConfigs;
+	for (size_t timePointNr = 0; timePointNr < config.timePointImages.size(); timePointNr++) {
+		timePointConfigs.push_back(config.getTimePointConfig(timePointNr));
+		ConfigFile &timePointConfig = timePointConfigs.back();
+		if (config.csvOutput == 1) {
+			timePointConfig.createOutputFile(timePointConfig);
+		}
+		else if (config.ontologyOutput == 1) {
+			std::error_code error;
+			std::filesystem::create_directories(timePointConfig.outputFolder, error);
+		}
+	}
+
+	runParallelImages(timePointConfigs.size(), unsigned(config.nrParallelTimePoints), [&](size_t timePointNr) {
+		std::cout << "Calculate the features of the time point " << config.timePointNames[timePointNr] << std::endl;
+		readImageAndMask(timePointConfigs[timePointNr]);
+	});
+
+	if (config.csvOutput != 1) {
+		std::cout << "The longitudinal table is only written for the csv output" << std::endl;
+		return;
+	}
+	LongitudinalTable table;
+	for (size_t timePointNr = 0; timePointNr < timePointConfigs.size(); timePointNr++) {
+		table.addTimePoint(config.timePointNames[timePointNr], timePointConfigs[timePointNr].outputFolder + ".csv");
+	}
+	table.write(config.outputFolder + "_longitudinal.csv");
+}
+
+/*!
+The function calculateLabelFeatures calculates the features for every label of a label image. \n
+Image and label image are read (and the image is smoothed) only once. For every label, the region around the label is cut from
+image and label image and the label is calculated like a single mask (see calculateMaskFeatures), resampled on the grid of the whole image. \n
+The labels are distributed over NrParallelLabels threads, the ITK filters of one label only use the share of the cores of its
+thread (see runParallelImages). The regions are cut one after the other, as the ITK pipeline of the whole image cannot be used by
+several threads at the same time. \n
+The results of every label are written to an own output, its name is extended by _label and the label value.
+@param[in] image: the (smoothed) image
+@param[in] labelAnalysis: the analysed label image
+@param[in] imageGeometry: grid of the whole image (see getImageGeometry)
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculateLabelFeatures(ImageType *image, const MaskAnalysis &labelAnalysis, ImageType *imageGeometry, ConfigFile config) {
+	vector<int> labels;
+	vector<RegionType> labelRegions;
+	labelAnalysis.getLabels(labels, labelRegions);
+	std::cout << "Number of labels in the mask: " << labels.size() << std::endl;
+	ResampleGrid grid;
+	if (config.useSamplingCubic == 1 || config.useDownSampling != 0 || config.useUpSampling != 0) {
+		grid = getResampleGrid(imageGeometry, config);
+	}
+	int nrCropVoxels = nrCropVoxelsInterpolation;
+	if (config.interpolationMethod == "Spline" || config.interpolationMethod == "spline") {
+		nrCropVoxels = nrCropVoxelsSpline;
+	}
+	//every label gets its own output
+	vector<ConfigFile> labelConfigs(labels.size(), config);
+	for (size_t labelNr = 0; labelNr < labels.size(); labelNr++) {
+		ConfigFile &labelConfig = labelConfigs[labelNr];
+		labelConfig.outputFolder = config.outputFolder + "_label" + to_string(labels[labelNr]);
+		if (config.csvOutput == 1) {
+			labelConfig.createOutputFile(labelConfig);
+			ofstream labelCSV(labelConfig.outputFolder + ".csv", std::ios_base::app);
+			labelCSV << "Label" << "," << "Label value" << "," << labels[labelNr] << "\n";
+		}
+		else if (config.ontologyOutput == 1) {
+			std::error_code error;
+			std::filesystem::create_directories(labelConfig.outputFolder, error);
+		}
+	}
+
+	std::mutex cutMutex;
+	runParallelImages(labels.size(), unsigned(config.nrParallelLabels), [&](size_t labelNr) {
+		ImageType::Pointer labelImage;
+		ImageType::Pointer labelMask;
+		{
+			std::lock_guard<std::mutex> lock(cutMutex);
+			RegionType cutRegion = getPaddedRegion(labelRegions[labelNr], image->GetLargestPossibleRegion(), image->GetSpacing(),
+				getValueMargin(config), nrCropVoxels);
+			labelImage = getImageMasked(image, cutRegion);
+			labelImage->DisconnectPipeline();
+			labelMask = labelAnalysis.getLabelMask(labels[labelNr], cutRegion);
+		}
+		std::cout << "Calculate the features of label " << labels[labelNr] << std::endl;
+		MaskAnalysis maskAnalysis;
+		maskAnalysis.analyse(labelMask, config.threshold, 1);
+		calculateMaskFeatures(labelImage, labelMask, maskAnalysis, grid, labelConfigs[labelNr]);
+	});
+}
+
+
+/*!
+The function readCroppedImageAndMask reads the mask first and determines the region around the mask that is needed
+for the feature calculation (see getCropRegion). \n
+From the image only this region is read, so that smoothing and interpolation are only applied to the part of the image around the VOI. \n
+After reading, image and mask have the same size and the same position. \n
+The grid of the whole image is taken from the mask before it is cut, so that the region around the mask is resampled on the same grid
+as if the whole image was read (see getResampleGrid).
+@param[in] ConfigFile config: config file with all information of the config.ini file
+@param[out] image: the region of the image around the mask
+@param[out] mask: the region of the mask
+@param[out] cropRegion: the region of the mask file that was read
+@param[out] imageGeometry: grid of the whole image (see getImageGeometry)
+*/
+void readCroppedImageAndMask(ConfigFile config, ImageType::Pointer &image, ImageType::Pointer &mask, RegionType &cropRegion, ImageType::Pointer &imageGeometry) {
+	if (config.useAccurate == 0) {
+		std::cout << "The input image is a nifti image" << std::endl;
+		//crop before flipping, so that image and mask are flipped in the same way
+		mask = readImage(config.voiName);
+		imageGeometry = getImageGeometry(flipNII(mask));
+		cropRegion = getCropRegion(mask, config);
+		mask = getImageMasked(mask, cropRegion);
+		image = readImageRegion(config.imageName, cropRegion);
+		image = flipNII(image);
+		mask = flipNII(mask);
+	}
+	if (config.useAccurate == 1) {
+		unsigned int dimPET[3];
+		float voxelSize[3];
+		if (getPrjDimensions(config.imageName, dimPET, voxelSize) == false) {
+			exit(0);
+		}
+		mask = readVoiFilePET(config.imageName, config.voiName, nullptr, config, dimPET, voxelSize);
+		imageGeometry = getImageGeometry(mask);
+		cropRegion = getCropRegion(mask, config);
+		RegionType imageRegion = cropRegion;
+		if (config.imageType == "PET") {
+			//only the slices of the region are copied from the prj file
+			image = readPrjFilePET(config.imageName, config.imageType, dimPET, voxelSize, cropRegion.GetIndex()[2], cropRegion.GetSize()[2]);
+			if (image.IsNull()) {
+				std::cout << "The image " << config.imageName << " cannot be read" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			imageRegion.SetIndex(2, image->GetLargestPossibleRegion().GetIndex()[2]);
+		}
+		else {
+			image = readPrjFilePET(config.imageName, config.imageType, dimPET, voxelSize);
+			if (image.IsNull()) {
+				std::cout << "The image " << config.imageName << " cannot be read" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+		}
+		image = getImageMasked(image, imageRegion);
+		mask = getImageMasked(mask, cropRegion);
+	}
+	if (config.useAccurate == 2) {
+		if (config.voiFile == 2) {
+			mask = readDicom(config.voiName);
+			imageGeometry = getImageGeometry(mask);
+			cropRegion = getCropRegion(mask, config);
+			image = readDicomRegion(config.imageName, cropRegion);
+		}
+		else if (config.voiFile == 3) {
+			//the RT struct is converted on the grid of the whole image, so the whole image is needed
+			image = readDicom(config.imageName);
+			mask = readRTstruct(config.voiName, image, config);
+			imageGeometry = getImageGeometry(image);
+			cropRegion = getCropRegion(mask, config);
+			image = getImageMasked(image, cropRegion);
+		}
+		mask = getImageMasked(mask, cropRegion);
+	}
+}
+
+void calculateFeatures(ImageType *imageFiltered, ImageType *maskNewSpacing, const LesionLabels *lesions, ConfigFile config) {
+	if (config.featureMaps == 1) {
+		calculateFeatureMaps(imageFiltered, maskNewSpacing, config);
+	}
 	//get size of shrinked image (in order to produce an image objectwith right size)
 	const typename ImageType::RegionType regionFilter = imageFiltered->GetLargestPossibleRegion();
 	const typename ImageType::SizeType imageSizeFilter = regionFilter.GetSize();
@@ -190,25 +898,134 @@ void calculateFeatures(ImageType *imageFiltered, ImageType *maskNewSpacing, Conf
 	//now store the intensity values of thes selected region in an image object
 	Image<float, 3> imageAttr(imageSize[0], imageSize[1], imageSize[2]);
 
+	//feature families whose input and parameters did not change are taken from the feature cache
+	FeatureCache featureCache;
+	featureCache.configure(config);
+	featureCache.setImage(imageFiltered, maskNewSpacing);
+	//the count matrices of the texture features are recorded and written with the discretized VOI
+	if (config.storeTextureMatrices == 1) {
+		TextureMatrixStore::caseStore().startRecording();
+	}
+	TraceStage stage(config, "image attributes", "preprocessing", regionFilter.GetNumberOfPixels());
 	imageAttr.getImageAttributes(imageFiltered, maskNewSpacing, config);
-	CalculateRelFeatures(imageAttr, config);
+	stage.stop();
+	CalculateRelFeatures(imageAttr, lesions, config, featureCache);
 	Image<float, 3> imageAttr2(0, 0, 0);
 	imageAttr = imageAttr2;
 	if (config.useFixedBinWidth == 1 || config.useFixedNrBins == 1) {
 
 		//we do not interpolate the image, so the image size is the same, however we still need to discretize it
 		Image<float, 3> imageAttrDis(imageSize[0], imageSize[1], imageSize[2]);
+		stage.next("discretization", "preprocessing");
 		imageAttrDis.getImageAttributesDiscretized(imageFiltered, maskNewSpacing, config);
-		
-		calculateRelFeaturesDiscretized(imageAttrDis, spacing, config);
+		stage.setSize(imageAttrDis.vectorOfMatrixElements.size(), imageAttrDis.diffGreyLevels.size());
+		stage.stop();
+		TextureMatrixStore::caseStore().setVOI(imageAttrDis.imageMatrix, imageAttrDis.vectorOfMatrixElements, spacing);
+		calculateRelFeaturesDiscretized(imageAttrDis, spacing, config, featureCache);
 	}
 	else {
+		TextureMatrixStore::caseStore().setVOI(imageAttr.imageMatrix, imageAttr.vectorOfMatrixElements, spacing);
+		calculateRelFeaturesDiscretized(imageAttr, spacing, config, featureCache);
+	}
+	if (config.storeTextureMatrices == 1) {
+		TraceStage matrixStage(config, "texture matrix writer", "writer");
+		string matrixFile = config.outputFolder + "_textureMatrices.bin";
+		if (!TextureMatrixStore::caseStore().write(matrixFile)) {
+			std::cout << "The texture matrices cannot be written to " << matrixFile << std::endl;
+		}
+	}
+	TextureMatrixStore::caseStore().finishMask();
+	//the case is finished, free the texture matrices kept by the matrix pool
+	MatrixPool<float>::casePool().reset();
+	std::cout << "The data is stored in the file " << config.outputFolder << std::endl;
+}
 
-		calculateRelFeaturesDiscretized(imageAttr, spacing, config);
+/*!
+The function calculateFeaturesFromMatrices calculates the features from a texture matrix file (see TextureMatrixStore) instead of the image:
+the discretized VOI is taken from the file and the stored count matrices of GLCM and GLRLM are used instead of calculating them again.
+So other aggregation methods, distance norms or emphasis powers can be calculated without reading and preprocessing the image. \n
+Only the features that need nothing but the discretized VOI are calculated (intensity histogram, GLCM, GLRLM and GLSZM features).
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculateFeaturesFromMatrices(ConfigFile config) {
+	TextureMatrixStore &matrixStore = TextureMatrixStore::caseStore();
+	if (!matrixStore.read(config.textureMatrixFile)) {
+		std::cout << "The texture matrix file " << config.textureMatrixFile << " cannot be read" << std::endl;
+		return;
 	}
+	std::cout << "The features are calculated from the texture matrix file " << config.textureMatrixFile << std::endl;
+	Image<float, 3> imageAttr(0, 0, 0);
+	vector<float> spacing;
+	matrixStore.getVOI(imageAttr.imageMatrix, imageAttr.vectorOfMatrixElements, spacing);
+	imageAttr.diffGreyLevels = imageAttr.getGreyLevels();
+	imageAttr.fillVoxelList();
+	//the results are not taken from or written to the feature cache
+	FeatureCache featureCache;
+	calculateRelFeaturesDiscretized(imageAttr, spacing, config, featureCache);
+	matrixStore.reset();
+	MatrixPool<float>::casePool().reset();
 	std::cout << "The data is stored in the file " << config.outputFolder << std::endl;
 }
 
+/*!
+The function calculateFeatureMaps calculates the voxel-wise feature maps of the VOI (see FeatureMaps) and writes every map as NIfTI image
+(outputFolder_map_featureName.nii.gz) with the grid of the image. \n
+Values and grey levels are prepared in the same way as for the features of the whole VOI (SUV conversion, resegmentation and discretization).
+@param[in] imageFiltered: image cut to the bounding box of the mask
+@param[in] maskNewSpacing: binary mask
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void calculateFeatureMaps(ImageType *imageFiltered, ImageType *maskNewSpacing, ConfigFile config) {
+	const ImageType::SizeType imageSize = imageFiltered->GetLargestPossibleRegion().GetSize();
+	bool useGreyLevels = (config.useFixedBinWidth == 1 || config.useFixedNrBins == 1);
+	FeatureMaps featureMaps;
+	featureMaps.setWindow(config.featureMapRadius, config.featureMapShape, unsigned(config.nrThreadsFeatureMaps));
+	vector<string> features = featureMaps.selectFeatures(config.featureMapFeatures, useGreyLevels);
+	if (features.empty()) {
+		return;
+	}
+	std::cout << "Calculate the feature maps" << std::endl;
+	vector<boost::multi_array<float, 3> > maps;
+	{
+		Image<float, 3> imageValues(imageSize[0], imageSize[1], imageSize[2]);
+		imageValues.getImageAttributes(imageFiltered, maskNewSpacing, config);
+		if (useGreyLevels) {
+			Image<float, 3> imageGreyLevels(imageSize[0], imageSize[1], imageSize[2]);
+			imageGreyLevels.getImageAttributesDiscretized(imageFiltered, maskNewSpacing, config);
+			featureMaps.calculate(imageValues.imageMatrix, imageGreyLevels.imageMatrix, features, maps);
+		}
+		else {
+			featureMaps.calculate(imageValues.imageMatrix, imageValues.imageMatrix, features, maps);
+		}
+	}
+	for (size_t featureNr = 0; featureNr < features.size(); featureNr++) {
+		ImageType::Pointer mapImage = ImageType::New();
+		mapImage->CopyInformation(imageFiltered);
+		mapImage->SetRegions(imageFiltered->GetLargestPossibleRegion());
+		mapImage->Allocate();
+		//the maps are stored as [x][y][z], the image buffer with x running fastest
+		float *buffer = mapImage->GetBufferPointer();
+		for (unsigned int z = 0; z < imageSize[2]; z++) {
+			for (unsigned int y = 0; y < imageSize[1]; y++) {
+				for (unsigned int x = 0; x < imageSize[0]; x++) {
+					buffer[(size_t(z) * imageSize[1] + y) * imageSize[0] + x] = maps[featureNr][x][y][z];
+				}
+			}
+		}
+		maps[featureNr].resize(boost::extents[0][0][0]);
+		WriterType::Pointer writer = WriterType::New();
+		writer->SetFileName(config.outputFolder + "_map_" + features[featureNr] + ".nii.gz");
+		writer->SetInput(mapImage);
+		try {
+			writer->Update();
+		}
+		catch (itk::ExceptionObject &excp) {
+			std::cerr << excp << std::endl;
+		}
+	}
+	std::cout << "The feature maps are stored in " << config.outputFolder << "_map_*.nii.gz" << std::endl;
+}
+
 void writeImageData2Log(ConfigFile config) {
 	//write parameters to logFile
 	string introduction = "The following software and images were used:";
@@ -13,19 +13,39 @@
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 #include "processing.h"
 #include "dispersityFeatures.h"
+#include "featureMaps.h"
+#include "maskPerturbation.h"
+#include "imageFilters.h"
+#include "longitudinalTable.h"
+#include "parallel.h"
+#include "itkMultiThreaderBase.h"
 /*! \file */
 
 
 void readImageAndMask(ConfigFile config);
-void calculateFeatures(ImageType *imageFiltered, ImageType *maskNewSpacing, ConfigFile config);
+void readCroppedImageAndMask(ConfigFile config, ImageType::Pointer &image, ImageType::Pointer &mask, RegionType &cropRegion, ImageType::Pointer &imageGeometry);
+void calculateMaskFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config);
+void runParallelImages(size_t nrItems, unsigned int nrThreads, const std::function<void(size_t)> &process);
+void calculatePerturbationFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config);
+void calculateFilteredFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, MaskAnalysis &maskAnalysis, const ResampleGrid &grid, ConfigFile config);
+void calculatePyramidFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, const MaskAnalysis &maskAnalysis, ImageType *imageGeometry, ConfigFile config);
+void calculateModalityFeatures(ImageType::Pointer &image, ImageType::Pointer &mask, const MaskAnalysis &maskAnalysis, const RegionType &cropRegion, ImageType *imageGeometry, ConfigFile config);
+void appendPrefixedFeatures(const string &imageOutput, const string &outputFolder, const string &prefix, const string &keptGroup);
+ImageType::Pointer readModalityImage(ConfigFile config, ImageType *mask, const RegionType &cropRegion);
+void calculateLongitudinalFeatures(ConfigFile config);
+void calculateLabelFeatures(ImageType *image, const MaskAnalysis &labelAnalysis, ImageType *imageGeometry, ConfigFile config);
+void labelLesions(ImageType *image, const MaskAnalysis &maskAnalysis, LesionLabels &lesions, ConfigFile config);
+void calculateFeatures(ImageType *imageFiltered, ImageType *maskNewSpacing, const LesionLabels *lesions, ConfigFile config);
+void calculateFeatureMaps(ImageType *imageFiltered, ImageType *maskNewSpacing, ConfigFile config);
+void calculateFeaturesFromMatrices(ConfigFile config);
 void writeImageData2Log(ConfigFile config);
 ImageType::Pointer flipNII(ImageType::Pointer mask);
-int getNrVoxels(ImageType *mask, float threshold);
 
 #include "featureCalculation.cpp"
 #endif
\ No newline at end of file
@@ -0,0 +1,395 @@
+/*!
+\brief setWindow
+The function setWindow defines the window that is moved over the image.
+@param[in] windowRadius: radius of the window in voxels
+@param[in] windowShape: "cube" or "sphere", a voxel is inside the sphere if the distance of its center (in voxels) is smaller or equal to the radius
+@param[in] nrThreadsMaps: number of threads, if 0 the number of cores is used
+*/
+void FeatureMaps::setWindow(int windowRadius, string windowShape, unsigned int nrThreadsMaps) {
+	radius = std::max(0, windowRadius);
+	bool useSphere = (windowShape == "sphere" || windowShape == "Sphere");
+	int width = 2 * radius + 1;
+	lineHalfWidth.assign(width * width, -1);
+	for (int dz = -radius; dz <= radius; dz++) {
+		for (int dy = -radius; dy <= radius; dy++) {
+			int halfWidth = radius;
+			if (useSphere) {
+				int remaining = radius * radius - dy * dy - dz * dz;
+				halfWidth = remaining < 0 ? -1 : int(std::floor(std::sqrt(double(remaining))));
+			}
+			lineHalfWidth[(dz + radius) * width + dy + radius] = halfWidth;
+		}
+	}
+	uniqueDirections.clear();
+	neighborDirections.clear();
+	for (int dz = -1; dz <= 1; dz++) {
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				if (dx == 0 && dy == 0 && dz == 0) {
+					continue;
+				}
+				neighborDirections.push_back({ dx, dy, dz });
+				//every direction is used only once: the neighbor has to come after the voxel
+				if (dz > 0 || (dz == 0 && dy > 0) || (dz == 0 && dy == 0 && dx > 0)) {
+					uniqueDirections.push_back({ dx, dy, dz });
+				}
+			}
+		}
+	}
+	nrThreads = nrThreadsMaps;
+}
+
+/*!
+\brief selectFeatures
+The function selectFeatures checks the names of the features that should be calculated as maps.
+@param[in] featureNames: names of the features separated by commas, if empty all features are calculated
+@param[in] useGreyLevels: if false, the image is not discretized and the histogram and GLCM features cannot be calculated
+@param[out] vector<string>: names of the features
+*/
+vector<string> FeatureMaps::selectFeatures(string featureNames, bool useGreyLevels) const {
+	vector<string> knownFeatures = statisticalMapFeatures;
+	knownFeatures.insert(knownFeatures.end(), histogramMapFeatures.begin(), histogramMapFeatures.end());
+	knownFeatures.insert(knownFeatures.end(), glcmMapFeatures.begin(), glcmMapFeatures.end());
+	vector<string> names;
+	std::istringstream nameStream(featureNames);
+	string name;
+	while (std::getline(nameStream, name, ',')) {
+		size_t first = name.find_first_not_of(' ');
+		if (first == string::npos) {
+			continue;
+		}
+		names.push_back(name.substr(first, name.find_last_not_of(' ') - first + 1));
+	}
+	if (names.empty()) {
+		names = knownFeatures;
+	}
+	vector<string> features;
+	for (const string &featureName : names) {
+		if (std::find(knownFeatures.begin(), knownFeatures.end(), featureName) == knownFeatures.end()) {
+			std::cout << "The feature " << featureName << " cannot be calculated as map" << std::endl;
+		}
+		else if (!useGreyLevels && std::find(statisticalMapFeatures.begin(), statisticalMapFeatures.end(), featureName) == statisticalMapFeatures.end()) {
+			std::cout << "The map of " << featureName << " needs a discretized image (fixed bin width or fixed number of bins)" << std::endl;
+		}
+		else if (std::find(features.begin(), features.end(), featureName) == features.end()) {
+			features.push_back(featureName);
+		}
+	}
+	return features;
+}
+
+/*!
+\brief calculate
+The function calculate moves the window over the image and calculates the feature maps.
+@param[in] values: intensity values of the bounding box of the VOI, NAN outside the VOI
+@param[in] greyLevels: discretized grey levels (starting with 1), NAN outside the VOI, only used for the histogram and GLCM features
+@param[in] features: names of the features (see selectFeatures)
+@param[out] maps: one map for every feature, with the same size as values
+*/
+void FeatureMaps::calculate(const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels, const vector<string> &features,
+	vector<boost::multi_array<float, 3> > &maps) {
+	nrX = int(values.shape()[0]);
+	nrY = int(values.shape()[1]);
+	nrZ = int(values.shape()[2]);
+	//the histogram and the GLC-matrix are only needed if a grey level feature is calculated
+	nrGreyLevels = 0;
+	bool useGreyLevels = std::any_of(features.begin(), features.end(), [](const string &feature) {
+		return std::find(statisticalMapFeatures.begin(), statisticalMapFeatures.end(), feature) == statisticalMapFeatures.end();
+	});
+	double sum = 0;
+	size_t nrVoxels = 0;
+	for (size_t i = 0; i < values.num_elements(); i++) {
+		float value = values.origin()[i];
+		if (!std::isnan(value)) {
+			sum += value;
+			nrVoxels++;
+			if (useGreyLevels && !std::isnan(greyLevels.origin()[i])) {
+				nrGreyLevels = std::max(nrGreyLevels, int(greyLevels.origin()[i]));
+			}
+		}
+	}
+	valueShift = nrVoxels > 0 ? sum / double(nrVoxels) : 0;
+	if (useGreyLevels) {
+		nrGreyLevels = std::max(nrGreyLevels, 1);
+	}
+	maps.resize(features.size());
+	for (size_t featureNr = 0; featureNr < features.size(); featureNr++) {
+		maps[featureNr].resize(boost::extents[nrX][nrY][nrZ]);
+		std::fill(maps[featureNr].origin(), maps[featureNr].origin() + maps[featureNr].num_elements(), 0.0f);
+	}
+
+	//the lines are processed in blocks, so that the matrix of the window is only allocated once per block
+	int nrLines = nrY * nrZ;
+	int nrBlocks = (nrLines + featureMapsLinesPerBlock - 1) / featureMapsLinesPerBlock;
+	runParallel(size_t(nrBlocks), nrThreads, [&](size_t blockNr) {
+		boost::multi_array<float, 2> probMatrix(boost::extents[nrGreyLevels][nrGreyLevels]);
+		int lastLine = std::min(int(blockNr + 1) * featureMapsLinesPerBlock, nrLines);
+		for (int line = int(blockNr) * featureMapsLinesPerBlock; line < lastLine; line++) {
+			calculateRow(values, greyLevels, line % nrY, line / nrY, features, maps, probMatrix);
+		}
+	});
+}
+
+int FeatureMaps::getHalfWidth(int dy, int dz) const {
+	if (dy < -radius || dy > radius || dz < -radius || dz > radius) {
+		return -1;
+	}
+	return lineHalfWidth[(dz + radius) * (2 * radius + 1) + dy + radius];
+}
+
+bool FeatureMaps::isInWindow(const boost::multi_array<float, 3> &values, int x, int y, int z, int centerX, int centerY, int centerZ) const {
+	if (x < 0 || x >= nrX || y < 0 || y >= nrY || z < 0 || z >= nrZ) {
+		return false;
+	}
+	int halfWidth = getHalfWidth(y - centerY, z - centerZ);
+	return halfWidth >= 0 && std::abs(x - centerX) <= halfWidth && !std::isnan(values[x][y][z]);
+}
+
+/*!
+\brief addVoxel
+The function addVoxel adds a voxel to the window (sign 1) or removes it from the window (sign -1).
+The pairs of the GLC-matrix are updated separately (see addPair).
+*/
+void FeatureMaps::addVoxel(WindowState &state, const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels,
+	int x, int y, int z, int sign) const {
+	double value = double(values[x][y][z]) - valueShift;
+	state.nrVoxels += sign;
+	double power = sign;
+	for (int k = 0; k < 4; k++) {
+		power *= value;
+		state.sums[k] += power;
+	}
+	if (nrGreyLevels > 0 && !std::isnan(greyLevels[x][y][z])) {
+		int greyLevel = std::min(std::max(int(greyLevels[x][y][z]) - 1, 0), nrGreyLevels - 1);
+		double count = state.histogram[greyLevel];
+		double newCount = count + sign;
+		state.histSumCLogC += (newCount > 0 ? newCount * std::log2(newCount) : 0) - (count > 0 ? count * std::log2(count) : 0);
+		state.histSumSquares += newCount * newCount - count * count;
+		state.histogram[greyLevel] += sign;
+	}
+}
+
+/*!
+\brief addPair
+The function addPair adds a pair of neighbors to the symmetric GLC-matrix of the window (sign 1) or removes it (sign -1).
+*/
+void FeatureMaps::addPair(WindowState &state, const boost::multi_array<float, 3> &greyLevels, int x, int y, int z, int xn, int yn, int zn, int sign) const {
+	if (std::isnan(greyLevels[x][y][z]) || std::isnan(greyLevels[xn][yn][zn])) {
+		return;
+	}
+	int greyLevel = std::min(std::max(int(greyLevels[x][y][z]) - 1, 0), nrGreyLevels - 1);
+	int greyLevelNeighbor = std::min(std::max(int(greyLevels[xn][yn][zn]) - 1, 0), nrGreyLevels - 1);
+	state.glcMatrix[greyLevel * nrGreyLevels + greyLevelNeighbor] += sign;
+	state.glcMatrix[greyLevelNeighbor * nrGreyLevels + greyLevel] += sign;
+	state.nrPairs += 2 * sign;
+}
+
+/*!
+\brief updateSlab
+The function updateSlab removes the voxels that leave the window (sign -1) or adds the voxels that enter the window (sign 1) when the
+window is moved by one voxel in x direction. \n
+The slab contains the voxels that are inside the window at centerX but not at otherCenterX. Together with a voxel of the slab
+all pairs with its neighbors inside the window at centerX are updated; a pair of two voxels of the slab is updated only once.
+@param[in,out] state: state of the window
+@param[in] y, z: position of the row
+@param[in] centerX: center of the window that contains the slab (old center if voxels are removed, new center if voxels are added)
+@param[in] otherCenterX: the other center
+@param[in] sign: -1 to remove, 1 to add
+*/
+void FeatureMaps::updateSlab(WindowState &state, const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels,
+	int y, int z, int centerX, int otherCenterX, int sign) const {
+	int direction = centerX - otherCenterX;
+	for (int dz = -radius; dz <= radius; dz++) {
+		for (int dy = -radius; dy <= radius; dy++) {
+			int halfWidth = getHalfWidth(dy, dz);
+			if (halfWidth < 0) {
+				continue;
+			}
+			int x = centerX + direction * halfWidth;
+			if (!isInWindow(values, x, y + dy, z + dz, centerX, y, z)) {
+				continue;
+			}
+			addVoxel(state, values, greyLevels, x, y + dy, z + dz, sign);
+			if (nrGreyLevels == 0) {
+				continue;
+			}
+			long long index = (long long)(z + dz) * nrY * nrX + (long long)(y + dy) * nrX + x;
+			for (const vector<int> &neighbor : neighborDirections) {
+				int xn = x + neighbor[0];
+				int yn = y + dy + neighbor[1];
+				int zn = z + dz + neighbor[2];
+				if (!isInWindow(values, xn, yn, zn, centerX, y, z)) {
+					continue;
+				}
+				long long indexNeighbor = (long long)zn * nrY * nrX + (long long)yn * nrX + xn;
+				if (isInWindow(values, xn, yn, zn, otherCenterX, y, z) || indexNeighbor > index) {
+					addPair(state, greyLevels, x, y + dy, z + dz, xn, yn, zn, sign);
+				}
+			}
+		}
+	}
+}
+
+/*!
+\brief calculateRow
+The function calculateRow calculates the maps for all VOI voxels of one row. The window is filled at the first VOI voxel of the row and
+then moved voxel by voxel to the last VOI voxel of the row.
+*/
+void FeatureMaps::calculateRow(const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels, int y, int z,
+	const vector<string> &features, vector<boost::multi_array<float, 3> > &maps, boost::multi_array<float, 2> &probMatrix) const {
+	int firstX = 0;
+	while (firstX < nrX && std::isnan(values[firstX][y][z])) {
+		firstX++;
+	}
+	if (firstX == nrX) {
+		return;
+	}
+	int lastX = nrX - 1;
+	while (std::isnan(values[lastX][y][z])) {
+		lastX--;
+	}
+	WindowState state;
+	state.nrVoxels = 0;
+	std::fill(state.sums, state.sums + 4, 0.0);
+	state.histogram.assign(nrGreyLevels, 0);
+	state.histSumCLogC = 0;
+	state.histSumSquares = 0;
+	state.glcMatrix.assign(size_t(nrGreyLevels) * nrGreyLevels, 0);
+	state.nrPairs = 0;
+	//fill the window at the first voxel
+	for (int dz = -radius; dz <= radius; dz++) {
+		for (int dy = -radius; dy <= radius; dy++) {
+			int halfWidth = getHalfWidth(dy, dz);
+			for (int x = firstX - halfWidth; x <= firstX + halfWidth; x++) {
+				if (!isInWindow(values, x, y + dy, z + dz, firstX, y, z)) {
+					continue;
+				}
+				addVoxel(state, values, greyLevels, x, y + dy, z + dz, 1);
+				if (nrGreyLevels == 0) {
+					continue;
+				}
+				for (const vector<int> &direction : uniqueDirections) {
+					if (isInWindow(values, x + direction[0], y + dy + direction[1], z + dz + direction[2], firstX, y, z)) {
+						addPair(state, greyLevels, x, y + dy, z + dz, x + direction[0], y + dy + direction[1], z + dz + direction[2], 1);
+					}
+				}
+			}
+		}
+	}
+	vector<float> featureValues;
+	for (int centerX = firstX; centerX <= lastX; centerX++) {
+		if (centerX > firstX) {
+			updateSlab(state, values, greyLevels, y, z, centerX - 1, centerX, -1);
+			updateSlab(state, values, greyLevels, y, z, centerX, centerX - 1, 1);
+		}
+		if (std::isnan(values[centerX][y][z])) {
+			continue;
+		}
+		getWindowFeatures(state, features, probMatrix, featureValues);
+		for (size_t featureNr = 0; featureNr < features.size(); featureNr++) {
+			maps[featureNr][centerX][y][z] = featureValues[featureNr];
+		}
+	}
+}
+
+/*!
+\brief getWindowFeatures
+The function getWindowFeatures calculates the features of the window from the sums, the histogram and the GLC-matrix of the window. \n
+The central moments are calculated from the sums of the powers of the values, skewness and kurtosis are defined as in StatisticalFeatures
+(the kurtosis is the excess kurtosis). Entropy and uniformity of the histogram are defined as in IntensityHistogram. The GLCM features are
+calculated with the functions of GLCMFeatures from the normalized GLC-matrix.
+@param[in] state: state of the window
+@param[in] features: names of the features
+@param[in,out] probMatrix: matrix for the normalized GLC-matrix
+@param[out] featureValues: values of the features
+*/
+void FeatureMaps::getWindowFeatures(const WindowState &state, const vector<string> &features, boost::multi_array<float, 2> &probMatrix,
+	vector<float> &featureValues) const {
+	featureValues.assign(features.size(), NAN);
+	double nrVoxels = state.nrVoxels;
+	double a = state.sums[0] / nrVoxels;
+	double b = state.sums[1] / nrVoxels;
+	double c = state.sums[2] / nrVoxels;
+	double d = state.sums[3] / nrVoxels;
+	double variance = b - a * a;
+	double moment3 = c - 3 * a * b + 2 * a * a * a;
+	double moment4 = d - 4 * a * c + 6 * a * a * b - 3 * a * a * a * a;
+	bool glcmNormalized = false;
+	GLCMFeatures<float, 3> glcm;
+	for (size_t featureNr = 0; featureNr < features.size(); featureNr++) {
+		const string &feature = features[featureNr];
+		float &value = featureValues[featureNr];
+		if (feature == "mean") {
+			value = float(valueShift + a);
+		}
+		else if (feature == "variance") {
+			value = float(std::max(variance, 0.0));
+		}
+		else if (feature == "skewness") {
+			value = variance > 0 ? float(moment3 / std::pow(variance, 1.5)) : NAN;
+		}
+		else if (feature == "kurtosis") {
+			value = variance > 0 ? float(moment4 / (variance * variance) - 3) : NAN;
+		}
+		else if (feature == "entropy") {
+			value = float(std::log2(nrVoxels) - state.histSumCLogC / nrVoxels);
+		}
+		else if (feature == "uniformity") {
+			value = float(state.histSumSquares / (nrVoxels * nrVoxels));
+		}
+		else if (state.nrPairs > 0) {
+			if (!glcmNormalized) {
+				for (size_t i = 0; i < state.glcMatrix.size(); i++) {
+					probMatrix.origin()[i] = float(state.glcMatrix[i] / state.nrPairs);
+				}
+				//calculateJointMaximum also sets the number of grey levels of the matrix
+				glcm.calculateJointMaximum(probMatrix);
+				glcmNormalized = true;
+			}
+			if (feature == "jointMaximum") {
+				value = glcm.jointMaximum;
+			}
+			else if (feature == "jointAverage") {
+				glcm.calculateJointAverage(probMatrix);
+				value = glcm.jointAverage;
+			}
+			else if (feature == "jointVariance") {
+				glcm.calculateJointAverage(probMatrix);
+				glcm.calculateJointVariance(probMatrix, glcm.jointAverage);
+				value = glcm.jointVariance;
+			}
+			else if (feature == "jointEntropy") {
+				glcm.calculateJointEntropy(probMatrix);
+				value = glcm.jointEntropy;
+			}
+			else if (feature == "angSecMoment") {
+				glcm.calculateAngSecMoment(probMatrix);
+				value = glcm.angSecMoment;
+			}
+			else if (feature == "contrast") {
+				glcm.calculateContrast(probMatrix);
+				value = glcm.contrast;
+			}
+			else if (feature == "dissimilarity") {
+				glcm.calculateDissimilarity(probMatrix);
+				value = glcm.dissimilarity;
+			}
+			else if (feature == "inverseDiff") {
+				glcm.calculateInverseDiff(probMatrix);
+				value = glcm.inverseDiff;
+			}
+			else if (feature == "inverseDiffMom") {
+				glcm.calculateInverseDiffMom(probMatrix);
+				value = glcm.inverseDiffMom;
+			}
+			else if (feature == "correlation") {
+				glcm.calculateCorrelation(probMatrix);
+				value = glcm.correlation;
+			}
+			else if (feature == "autoCorrelation") {
+				glcm.calculateAutoCorrelation(probMatrix);
+				value = glcm.autoCorrelation;
+			}
+		}
+	}
+}
@@ -0,0 +1,91 @@
+#ifndef FEATUREMAPS_H_INCLUDED
+#define FEATUREMAPS_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "boost/multi_array.hpp"
+#include "GLCMFeatures.h"
+#include "parallel.h"
+using namespace std;
+
+/*! \file */
+
+//features that can be calculated as maps
+const vector<string> statisticalMapFeatures = { "mean", "variance", "skewness", "kurtosis" };
+const vector<string> histogramMapFeatures = { "entropy", "uniformity" };
+const vector<string> glcmMapFeatures = { "jointMaximum", "jointAverage", "jointVariance", "jointEntropy", "angSecMoment", "contrast",
+	"dissimilarity", "inverseDiff", "inverseDiffMom", "correlation", "autoCorrelation" };
+//number of rows a thread calculates at once
+const int featureMapsLinesPerBlock = 16;
+
+/*!
+The class FeatureMaps calculates voxel-wise feature maps: a window (cube or sphere with a radius in voxels) is moved over the
+bounding box of the VOI and for every voxel of the VOI the features of the voxels that are inside the window and inside the VOI
+are calculated. \n
+The window is moved along the rows of the image (x direction). It is filled completely only at the first VOI voxel of a row, afterwards
+only the slab of voxels that leaves the window and the slab of voxels that enters the window are updated: \n
+- the sums of the values and their powers (for mean, variance, skewness and kurtosis, as in StatisticalFeatures) \n
+- the histogram of the discretized grey levels (for entropy and uniformity, as in IntensityHistogram) \n
+- the merged 3D GLC-matrix of all 13 directions (the features are calculated with the functions of GLCMFeatures) \n
+The rows are distributed in blocks over several threads (see runParallel). \n
+The maps have the size of the bounding box, voxels outside the VOI are set to 0.
+*/
+class FeatureMaps {
+private:
+	int radius;
+	int nrX;
+	int nrY;
+	int nrZ;
+	int nrGreyLevels;
+	unsigned int nrThreads;
+	//half width of the window in x direction for every line (y and z offset) of the window, -1 if the line is not part of the window
+	vector<int> lineHalfWidth;
+	//the 13 unique directions of the neighbors and all 26 neighbors
+	vector<vector<int> > uniqueDirections;
+	vector<vector<int> > neighborDirections;
+	//value that is subtracted from all values before the sums are calculated (reduces the rounding errors of the higher powers)
+	double valueShift;
+
+	//state of the window while it is moved along one row
+	struct WindowState {
+		double nrVoxels;
+		double sums[4];
+		vector<int> histogram;
+		//sum of c*log2(c) and c^2 of the histogram counts
+		double histSumCLogC;
+		double histSumSquares;
+		vector<double> glcMatrix;
+		double nrPairs;
+	};
+
+	int getHalfWidth(int dy, int dz) const;
+	bool isInWindow(const boost::multi_array<float, 3> &values, int x, int y, int z, int centerX, int centerY, int centerZ) const;
+	void addVoxel(WindowState &state, const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels,
+		int x, int y, int z, int sign) const;
+	void addPair(WindowState &state, const boost::multi_array<float, 3> &greyLevels, int x, int y, int z, int xn, int yn, int zn, int sign) const;
+	void updateSlab(WindowState &state, const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels,
+		int y, int z, int centerX, int otherCenterX, int sign) const;
+	void calculateRow(const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels, int y, int z,
+		const vector<string> &features, vector<boost::multi_array<float, 3> > &maps, boost::multi_array<float, 2> &probMatrix) const;
+	void getWindowFeatures(const WindowState &state, const vector<string> &features, boost::multi_array<float, 2> &probMatrix,
+		vector<float> &featureValues) const;
+
+public:
+	FeatureMaps() : radius(1), nrX(0), nrY(0), nrZ(0), nrGreyLevels(0), nrThreads(1), valueShift(0) {
+		setWindow(1, "cube", 1);
+	}
+	~FeatureMaps() {
+	}
+	void setWindow(int windowRadius, string windowShape, unsigned int nrThreadsMaps = 0);
+	vector<string> selectFeatures(string featureNames, bool useGreyLevels) const;
+	void calculate(const boost::multi_array<float, 3> &values, const boost::multi_array<float, 3> &greyLevels, const vector<string> &features,
+		vector<boost::multi_array<float, 3> > &maps);
+};
+
+#include "featureMaps.cpp"
+
+#endif // FEATUREMAPS_H_INCLUDED
@@ -31,7 +31,7 @@ void fillConvolutionalVector(vector<T> &convolutionalVector, int is3D) {
 
 
 template<typename T>
-ImageType::Pointer constructEmptyNewImage(Image<T, 3> imageAttr, boost::multi_array<T, 3> actualMatrix, int is3D) {
+ImageType::Pointer constructEmptyNewImage(const Image<T, 3> &imageAttr, const boost::multi_array<T, 3> &actualMatrix, int is3D) {
 	//get the actual image and matrix
 	ImageType::Pointer actImage = imageAttr.image;
 	//get image size and spacing
@@ -87,7 +87,7 @@ ImageType::Pointer convolutionImage(ImageType::Pointer image, ImageType::Pointer
 }
 //construct a new image 
 template<typename T>
-ImageType::Pointer constructNewImage(ImageType::Pointer actImage, boost::multi_array<T, 3> actualMatrix) {
+ImageType::Pointer constructNewImage(ImageType::Pointer actImage, const boost::multi_array<T, 3> &actualMatrix) {
 
 	//get image size
 	const typename ImageType::RegionType regionFilter = actImage->GetLargestPossibleRegion();
@@ -151,7 +151,7 @@ ImageType::Pointer constructNewImage(ImageType::Pointer actImage, boost::multi_a
 }
 
 template<typename T>
-void getNGLDMatrix3D_convolution(Image<T, 3> imageAttr, boost::multi_array<float, 2> &ngldm3D, vector<float> spacing, ConfigFile config) {
+void getNGLDMatrix3D_convolution(const Image<T, 3> &imageAttr, boost::multi_array<float, 2> &ngldm3D, const vector<float> &spacing, const ConfigFile &config) {
 	int sizeGreyLevels = (imageAttr.diffGreyLevels).size();
 	vector<float> convolutionalVector;
 	fillConvolutionalVector(convolutionalVector, 1);
@@ -171,7 +171,7 @@ void getNGLDMatrix3D_convolution(Image<T, 3> imageAttr, boost::multi_array<float
 	//the original (not discretize image!)
 	ImageType::Pointer actImage = imageAttr.image;
 	//assign the image matrix
-	boost::multi_array<T, 3> actualMatrix = imageAttr.imageMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = imageAttr.imageMatrix;
 	for (int greyLevelNr = 0; greyLevelNr < sizeGreyLevels; greyLevelNr++) {
 		float actGreyLevel = (imageAttr.diffGreyLevels)[greyLevelNr];
 		//how many grey levels do I have
@@ -270,9 +270,9 @@ void getNGLDMatrix3D_convolution(Image<T, 3> imageAttr, boost::multi_array<float
 
 //generate the image that is later used for the convolution in order to get the NGTDM matrix
 template<typename T>
-ImageType::Pointer generateImageForConvolutionNGTDM(Image<T,3> imageAttr) {
+ImageType::Pointer generateImageForConvolutionNGTDM(const Image<T,3> &imageAttr) {
 	//assign the image matrix
-	boost::multi_array<T, 3> actualMatrix = imageAttr.imageMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = imageAttr.imageMatrix;
 	//how many grey levels do I have
 	int sizeGreyLevels = (imageAttr.diffGreyLevels).size();
 	//the original (not discretize image!)
@@ -308,9 +308,9 @@ ImageType::Pointer generateImageForConvolutionNGTDM(Image<T,3> imageAttr) {
 
 //generate the mask that is later used for the convolution in order to get the NGTDM matrix
 template<typename T>
-ImageType::Pointer generateMaskForConvolutionNGTDM(Image<T, 3> imageAttr, ConfigFile config) {
+ImageType::Pointer generateMaskForConvolutionNGTDM(const Image<T, 3> &imageAttr, const ConfigFile &config) {
 	//assign the image matrix
-	boost::multi_array<T, 3> actualMatrix = imageAttr.imageMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = imageAttr.imageMatrix;
 	//the original (not discretize image!)
 	ImageType::Pointer actImage = imageAttr.image;
 		//generate mask image
@@ -345,7 +345,7 @@ ImageType::Pointer generateMaskForConvolutionNGTDM(Image<T, 3> imageAttr, Config
 }
 
 template<typename T>
-void getNeighborhoodMatrix3D_convolution(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngtdm3D, vector<float> spacing, ConfigFile config) {
+void getNeighborhoodMatrix3D_convolution(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngtdm3D, const vector<float> &spacing, const ConfigFile &config) {
 	//construct convolutional kernel
 	vector<float> convolutionalVector;
 	fillConvolutionalVector(convolutionalVector, 1);
@@ -365,7 +365,7 @@ void getNeighborhoodMatrix3D_convolution(Image<T, 3> imageAttr, boost::multi_arr
 	int actualGreyIndex;
 
 	//assign the image matrix
-	boost::multi_array<T, 3> actualMatrix = imageAttr.imageMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = imageAttr.imageMatrix;
 	//how many grey levels do I have
 	int sizeGreyLevels = (imageAttr.diffGreyLevels).size();
 	//the original (not discretize image!)
@@ -437,7 +437,7 @@ NGTDM and NGLDM matrix are given as reference to this function. \n
 @param[in] ConfigFile config: ConfigFile to read the distances the user set for the NGTDM and NGLDM case
 */
 template<typename T>
-void getNeighborhoodMatrix2D(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngtdm2D, vector<float> spacing, ConfigFile config) {
+void getNeighborhoodMatrix2D(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngtdm2D, const vector<float> &spacing, const ConfigFile &config) {
 	//construct convolutional kernel
 	vector<float> convolutionalVector;
 	fillConvolutionalVector(convolutionalVector, 0);
@@ -458,7 +458,7 @@ void getNeighborhoodMatrix2D(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ng
 	int actualGreyIndex;
 
 	//assign the image matrix
-	boost::multi_array<T, 3> actualMatrix = imageAttr.imageMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = imageAttr.imageMatrix;
 	//how many grey levels do I have
 	int sizeGreyLevels = (imageAttr.diffGreyLevels).size();
 	//the original (not discretize image!)
@@ -571,7 +571,7 @@ void getNeighborhoodMatrix2D(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ng
 
 
 template<typename T>
-void getNeighborhoodMatrix2DNGLDM(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngldm2D, vector<float> spacing, ConfigFile config) {
+void getNeighborhoodMatrix2DNGLDM(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngldm2D, const vector<float> &spacing, const ConfigFile &config) {
 	int sizeGreyLevels = (imageAttr.diffGreyLevels).size();
 	vector<float> convolutionalVector;
 	fillConvolutionalVector(convolutionalVector, 0);
@@ -588,7 +588,7 @@ void getNeighborhoodMatrix2DNGLDM(Image<T, 3> imageAttr, boost::multi_array<T, 3
 	int actualGreyIndex;
 
 	ImageType::Pointer actImage = imageAttr.image;
-	boost::multi_array<T, 3> actualMatrix = imageAttr.imageMatrix;
+	const boost::multi_array<T, 3> &actualMatrix = imageAttr.imageMatrix;
 
 	ImageType::Pointer kernel = converArray2Image(kernelArray, dimKernel, voxelSize);
 	for (int greyLevelNr = 0; greyLevelNr < sizeGreyLevels; greyLevelNr++) {
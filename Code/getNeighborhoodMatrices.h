@@ -20,36 +20,36 @@ using namespace Concurrency;
 using namespace std;
 
 template<typename T>
-vector<T> getNeighborhood3D(boost::multi_array<T, 3> inputMatrix, int *indexOfElement, vector<float> spacing, ConfigFile config);
+vector<T> getNeighborhood3D(const boost::multi_array<T, 3> &inputMatrix, int *indexOfElement, const vector<float> &spacing, const ConfigFile &config);
 template<typename T>
-void getNeighborhoodMatrix3D(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngtdm3D, boost::multi_array<float, 2> &ngldm3D, vector<double> spacing, ConfigFile config);
+void getNeighborhoodMatrix3D(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngtdm3D, boost::multi_array<float, 2> &ngldm3D, const vector<double> &spacing, const ConfigFile &config);
 template<typename T>
-void getNeighborhoodMatrix3DNGTDM(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngtdm3D, boost::multi_array<T, 3> nrNeighborMatrix, boost::multi_array<T, 3> sumMatrix, vector<double> spacing, ConfigFile config);
+void getNeighborhoodMatrix3DNGTDM(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngtdm3D, const boost::multi_array<T, 3> &nrNeighborMatrix, const boost::multi_array<T, 3> &sumMatrix, const vector<double> &spacing, const ConfigFile &config);
 template<typename T>
-void getNeighborhoodMatrix2DNGTDM(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngtdm2D, boost::multi_array<T, 3> nrNeighborMatrix, boost::multi_array<T, 3> sumMatrix);
+void getNeighborhoodMatrix2DNGTDM(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngtdm2D, const boost::multi_array<T, 3> &nrNeighborMatrix, const boost::multi_array<T, 3> &sumMatrix);
 template<typename T>
-void getNeighborhoodMatrix2D(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngtdm2D, vector<double> spacing, ConfigFile config); 
+void getNeighborhoodMatrix2D(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngtdm2D, const vector<double> &spacing, const ConfigFile &config); 
 template<typename T>
 void fillConvolutionalVector(vector<T> &convolutionalVector, int is3D);
 template<typename T>
-ImageType::Pointer constructEmptyNewImage(Image<T, 3> imageAttr, boost::multi_array<T, 3> actualMatrix, int is3D);
+ImageType::Pointer constructEmptyNewImage(const Image<T, 3> &imageAttr, const boost::multi_array<T, 3> &actualMatrix, int is3D);
 template<typename T>
-vector<T> getNeighborhood(boost::multi_array<T, 3> inputMatrix, boost::multi_array<T, 3> &ngtdm2D, boost::multi_array<T, 3> &ngldm2D,int *indexOfElement, vector<double> spacing, ConfigFile config); 
+vector<T> getNeighborhood(const boost::multi_array<T, 3> &inputMatrix, boost::multi_array<T, 3> &ngtdm2D, boost::multi_array<T, 3> &ngldm2D,int *indexOfElement, const vector<double> &spacing, const ConfigFile &config); 
 template<typename T>
 ImageType::Pointer convolutionImage(ImageType::Pointer image, ImageType::Pointer kernel);
 template<typename T>
-ImageType::Pointer generateImageForConvolutionNGTDM(Image<T, 3> imageAttr);
+ImageType::Pointer generateImageForConvolutionNGTDM(const Image<T, 3> &imageAttr);
 template<typename T>
-ImageType::Pointer generateMaskForConvolutionNGTDM(Image<T, 3> imageAttr, ConfigFile config);
+ImageType::Pointer generateMaskForConvolutionNGTDM(const Image<T, 3> &imageAttr, const ConfigFile &config);
 template<typename T>
-void getNeighborhoodMatrix2DNGLDM(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngldm2D, vector<float> spacing, ConfigFile config);
+void getNeighborhoodMatrix2DNGLDM(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngldm2D, const vector<float> &spacing, const ConfigFile &config);
 template<typename T>
-void getNeighborhoodMatrix3D_convolution(Image<T, 3> imageAttr, boost::multi_array<T, 3> &ngtdm3D, vector<float> spacing, ConfigFile config);
+void getNeighborhoodMatrix3D_convolution(const Image<T, 3> &imageAttr, boost::multi_array<T, 3> &ngtdm3D, const vector<float> &spacing, const ConfigFile &config);
 template<typename T>
-void getNGLDMatrix3D_convolution(Image<T, 3> imageAttr,  boost::multi_array<float, 2> &ngldm3D, vector<float> spacing, ConfigFile config);
+void getNGLDMatrix3D_convolution(const Image<T, 3> &imageAttr,  boost::multi_array<float, 2> &ngldm3D, const vector<float> &spacing, const ConfigFile &config);
 template<typename T>
-ImageType::Pointer constructNewImage(ImageType::Pointer actImage, boost::multi_array<T, 3> actualMatrix);
+ImageType::Pointer constructNewImage(ImageType::Pointer actImage, const boost::multi_array<T, 3> &actualMatrix);
 template<typename T>
-vector<T> getNeighborhood3D_convolution(boost::multi_array<T, 3> inputMatrix, int *indexOfElement, vector<float> spacing, ConfigFile config);
+vector<T> getNeighborhood3D_convolution(const boost::multi_array<T, 3> &inputMatrix, int *indexOfElement, const vector<float> &spacing, const ConfigFile &config);
 #include "getNeighborhoodMatrices.cpp"
 #endif
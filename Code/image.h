@@ -27,6 +27,7 @@
 #include <itkImageFileWriter.h>
 
 #include "readConfigFile.h"
+#include "voxelList.h"
 /*! \file */
 
 /*!
@@ -72,6 +73,11 @@ public:
 	vector<T> vectorOfMatrixElements;
 	//to discretize a resegmented image with a fixed number of bins, I need the original min and max value
 	vector<T> vectorOfMatrixElementsOriginal;
+	//sparse representation of imageMatrix, only filled if the mask occupies a small part of the bounding box
+	VoxelList<T> voxelList;
+	bool useVoxelList;
+	//generation of imageMatrix, a new one is taken every time imageMatrix is filled (see nextMatrixGeneration)
+	unsigned long long matrixGeneration;
 	int nrRows;
 	int nrCols;
 	int nrDepth;
@@ -92,6 +98,10 @@ public:
 	
 	//resample the image to the desired outputSpacing and outputSize
 	ImageType::Pointer getResampledImage(ImageType *originalImage, double *outputSpacing, itk::Size<3> outputSize, string interpolationMethod, int rebinning_centering);
+	//origin of the resampled image (position of the first voxel center)
+	ImageType::PointType getResampledOrigin(ImageType *originalImage, double *outputSpacing, itk::Size<3> outputSize, int rebinning_centering);
+	//resample the image to the grid given by outputOrigin, outputSpacing and outputSize
+	ImageType::Pointer resampleToGrid(ImageType *originalImage, double *outputSpacing, ImageType::PointType outputOrigin, itk::Size<3> outputSize, string interpolationMethod);
 	//assign the values of the image that are lying inside the mask to a boost multi array
 	boost::multi_array<T, R> get3Dimage(ImageType *image, ImageType *mask, ConfigFile config);
 	boost::multi_array<T, R> get3DimageResegmented(ImageType *image, ImageType *mask, ConfigFile config);
@@ -99,7 +109,10 @@ public:
 	//determine the different grey levels of the image
 	vector<T> getGreyLevels();
 	//save all values which are not NAN in one vector
-	vector<T> getVectorOfMatrixElementsNotNAN(boost::multi_array<T, R> inputMatrix);
+	vector<T> getVectorOfMatrixElementsNotNAN(const boost::multi_array<T, R> &inputMatrix);
+	//create the voxel list of imageMatrix if the mask is sparse
+	void fillVoxelList();
+	const VoxelList<T> *getVoxelList() const;
 	//methods for discretization
 	void discretizationFixedWidth(boost::multi_array<T, R> &inputMatrix, float intervalWidth, ConfigFile config);
 	void discretizationFixedWidthIVH(boost::multi_array<T, R> &inputMatrix, float intervalWidth, ConfigFile config);
@@ -122,7 +135,7 @@ public:
 //every time when an image object is created, the image matrix is also created
 //and the config file is read to read in the image information
 template<class T, size_t R>
-Image<T, R>::Image(unsigned int row, unsigned int col, unsigned int depth) : imageMatrix(boost::extents[row][col][depth]), imageMatrixOriginal(boost::extents[row][col][depth]), imageMatrixLocalInt(boost::extents[row][col][depth]), imageMatrixIVH(boost::extents[row][col][depth]) {
+Image<T, R>::Image(unsigned int row, unsigned int col, unsigned int depth) : imageMatrix(boost::extents[row][col][depth]), imageMatrixOriginal(boost::extents[row][col][depth]), imageMatrixLocalInt(boost::extents[row][col][depth]), imageMatrixIVH(boost::extents[row][col][depth]), useVoxelList(false), matrixGeneration(nextMatrixGeneration()) {
 	diffGreyLevels.clear();
 	vectorOfMatrixElements.clear();
 }
@@ -236,6 +249,8 @@ void Image<T, R>::getInterpolatedImageMask(ConfigFile config, ImageType *imageFi
 			imageMatrixLocalInt = get3DimageLocalInt(image, mask, config);
 		}
 	}
+	//imageMatrix can be filled in the same memory, so its voxel list must not be used anymore
+	matrixGeneration = nextMatrixGeneration();
 
 
 }
@@ -250,17 +265,51 @@ resample the image to the desired outputSize with desired spacing
 */
 template<class T, size_t R>
 ImageType::Pointer Image<T, R>::getResampledImage(ImageType *originalImage, double *outputSpacing, itk::Size<3> outputSize, string interpolationMethod, int rebinning_centering) {
-	//use trilinear interpolation
-	typename LinearInterpolatorType::Pointer linearInterpolator = LinearInterpolatorType::New();
-	typename ImageType::DirectionType direction;
-	typename TransformType::Pointer transform = TransformType::New();
+	ImageType::PointType newOrigin = getResampledOrigin(originalImage, outputSpacing, outputSize, rebinning_centering);
+	return resampleToGrid(originalImage, outputSpacing, newOrigin, outputSize, interpolationMethod);
+}
+
+/*!
+\brief getResampledOrigin
+The function getResampledOrigin calculates the origin of the resampled image. \n
+If rebinning_centering is 0, the voxel centers of original and resampled image are aligned in the center of the image
+(and not the origin of the images) to be in compliance with IBSI. Otherwise the resampled image has the origin of the original image.
+@param[in] originalImage
+@param[in] float outputSpacing: the spacing of the resampled image
+@param[in] itk::size: outputSize: the size of the resampled image
+@param[out] origin of the resampled image
+*/
+template<class T, size_t R>
+ImageType::PointType Image<T, R>::getResampledOrigin(ImageType *originalImage, double *outputSpacing, itk::Size<3> outputSize, int rebinning_centering) {
+	ImageType::PointType newOrigin = originalImage->GetOrigin();
+	const typename ImageType::SpacingType& inputSpacing = originalImage->GetSpacing();
+	const typename ImageType::RegionType& inputRegion = originalImage->GetLargestPossibleRegion();
+	const typename ImageType::SizeType& inputSize = inputRegion.GetSize();
+	if(rebinning_centering ==0){
+		newOrigin[0] += 0.5*(inputSize[0] - 1)*inputSpacing[0] - 0.5*(outputSize[0] - 1)*outputSpacing[0];
+		newOrigin[1] += 0.5*(inputSize[1] - 1)*inputSpacing[1] - 0.5*(outputSize[1] - 1)*outputSpacing[1];
+		newOrigin[2] += 0.5*(inputSize[2] - 1)*inputSpacing[2] - 0.5*(outputSize[2] - 1)*outputSpacing[2];
+	}
+	return newOrigin;
+}
+
+/*!
+\brief resampleToGrid
+The function resampleToGrid resamples the image to the grid given by origin, spacing and size, with the direction
+of the original image. Points outside the original image get the value 0.
+@param[in] originalImage
+@param[in] float outputSpacing: the spacing of the resampled image
+@param[in] outputOrigin: the origin of the resampled image
+@param[in] itk::size: outputSize: the size of the resampled image
+@param[in] string interpolationMethod: Linear, Spline or NearestNeighbor
+*/
+template<class T, size_t R>
+ImageType::Pointer Image<T, R>::resampleToGrid(ImageType *originalImage, double *outputSpacing, ImageType::PointType outputOrigin, itk::Size<3> outputSize, string interpolationMethod) {
 	typename InterpolatorType::Pointer interpolator;
 	typename ResampleFilterType::Pointer resizeFilterImage = ResampleFilterType::New();
-	typedef itk::RecursiveGaussianImageFilter<ImageType, ImageType > GaussianFilterType;
 	//if interpolation method is trilinear
 	if (interpolationMethod == "Linear" || interpolationMethod == "linear") {
 		interpolator= InterpolatorType::New();
-		resizeFilterImage->SetOutputOrigin(originalImage->GetOrigin());
 		resizeFilterImage->SetInterpolator(interpolator);
 	}
 	//if interpolation method is spline
@@ -279,32 +328,13 @@ ImageType::Pointer Image<T, R>::getResampledImage(ImageType *originalImage, doub
 	resizeFilterImage->SetDefaultPixelValue(0);
 	// Set the output spacing as specified on the command line
 	resizeFilterImage->SetOutputSpacing(outputSpacing);
-	//align voxel centers in interpolation step (and not the origin of the images) to be in compliance with IBSI
-	ImageType::PointType newOrigin = originalImage->GetOrigin();
-	const typename ImageType::SpacingType& inputSpacing = originalImage->GetSpacing();
-	const typename ImageType::RegionType& inputRegion = originalImage->GetLargestPossibleRegion();
-	const typename ImageType::SizeType& inputSize = inputRegion.GetSize();
-	if(rebinning_centering ==0){
-		newOrigin[0] += 0.5*(inputSize[0] - 1)*inputSpacing[0] - 0.5*(outputSize[0] - 1)*outputSpacing[0];
-		newOrigin[1] += 0.5*(inputSize[1] - 1)*inputSpacing[1] - 0.5*(outputSize[1] - 1)*outputSpacing[1];
-		newOrigin[2] += 0.5*(inputSize[2] - 1)*inputSpacing[2] - 0.5*(outputSize[2] - 1)*outputSpacing[2];
-		resizeFilterImage->SetOutputOrigin(newOrigin);
-	}
-	if (rebinning_centering == 1) {
-		resizeFilterImage->SetOutputOrigin(originalImage->GetOrigin());
-
-	}
+	resizeFilterImage->SetOutputOrigin(outputOrigin);
 	resizeFilterImage->SetOutputDirection(originalImage->GetDirection());
 	// Set the computed size
 	resizeFilterImage->SetSize(outputSize);
-	// Specify the input for the resamplersitk::Size<3> outputSize
 	resizeFilterImage->SetInput(originalImage);
 	resizeFilterImage->Update();
-
-	ImageType::Pointer newImage = resizeFilterImage->GetOutput();
-	originalImage = nullptr;
 	return resizeFilterImage->GetOutput();
-	
 }
 
 
@@ -582,7 +612,7 @@ vector<T> Image<T, R>::getGreyLevels() {
 In this function, all matrix elements, which are contained in the mask, are stored in a vector
 */
 template<class T, size_t R>
-vector<T> Image<T, R>::getVectorOfMatrixElementsNotNAN(boost::multi_array<T, R> inputMatrix) {
+vector<T> Image<T, R>::getVectorOfMatrixElementsNotNAN(const boost::multi_array<T, R> &inputMatrix) {
 	vectorOfMatrixElements.clear();
 	vector<T> elementVector;
 	for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
@@ -827,6 +857,7 @@ void Image<T, R>::getImageAttributes(ImageType *filteredImage, ImageType *maskFi
 		imageMatrix = get3Dimage(filteredImage, maskFilter, config);
 		imageMatrixLocalInt = get3DimageLocalInt(filteredImage, maskFilter, config);
 	}
+	matrixGeneration = nextMatrixGeneration();
 	
 	if (config.imageType == "PET") {
 		if (config.useSUV == 1) {
@@ -841,7 +872,7 @@ void Image<T, R>::getImageAttributes(ImageType *filteredImage, ImageType *maskFi
 	}
 	vectorOfMatrixElements = getVectorOfMatrixElementsNotNAN(imageMatrix);
 	diffGreyLevels = getGreyLevels();
-	
+	fillVoxelList();
 }
 
 /*!
@@ -870,6 +901,7 @@ void Image<T, R>::getImageAttributesDiscretized(ImageType *filteredImage, ImageT
 	else {
 		imageMatrix = get3Dimage(filteredImage, maskFilter, config);
 	}
+	matrixGeneration = nextMatrixGeneration();
 	
 
 	if (config.imageType == "PET") {
@@ -904,6 +936,38 @@ void Image<T, R>::getImageAttributesDiscretized(ImageType *filteredImage, ImageT
 		discretizationFixedBinNr(imageMatrix, vectorOfMatrixElements, config.nrBins);
 	}
 	diffGreyLevels = getGreyLevels();
+	fillVoxelList();
+}
+
+/*!
+\brief fillVoxelList
+If only a small part of the bounding box is inside the mask (less than maxOccupancyDenseMatrix), the voxels of imageMatrix
+are additionally stored in a voxel list. \n
+The texture calculations then iterate over this list instead of looping over the whole box. \n
+The function has to be called again every time imageMatrix is changed.
+*/
+template<class T, size_t R>
+void Image<T, R>::fillVoxelList() {
+	voxelList.clear();
+	useVoxelList = false;
+	size_t boxSize = imageMatrix.num_elements();
+	if (boxSize > 0 && double(vectorOfMatrixElements.size()) / boxSize < maxOccupancyDenseMatrix) {
+		voxelList.fill(imageMatrix, matrixGeneration);
+		useVoxelList = true;
+	}
+}
+
+/*!
+\brief getVoxelList
+Returns the voxel list of imageMatrix or nullptr if the dense matrix should be used.
+If imageMatrix was filled again after the list was created, the list is not used.
+*/
+template<class T, size_t R>
+const VoxelList<T> *Image<T, R>::getVoxelList() const {
+	if (useVoxelList && voxelList.describes(imageMatrix, matrixGeneration)) {
+		return &voxelList;
+	}
+	return nullptr;
 }
 
 
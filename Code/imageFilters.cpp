@@ -0,0 +1,263 @@
+/*!
+\brief addImageSpace
+The function addImageSpace adds an image space to the list of image spaces.
+*/
+void ImageFilters::addImageSpace(const string &name, const string &type, float sigma, const string &subband) {
+	ImageSpace imageSpace;
+	imageSpace.name = name;
+	imageSpace.type = type;
+	imageSpace.sigma = sigma;
+	imageSpace.subband = subband;
+	imageSpaces.push_back(imageSpace);
+}
+
+/*!
+\brief configure
+The function configure reads the image spaces from the config file: \n
+LoGSigma is a list of widths in mm (separated by commas), for every width one LoG image space is added. Wavelet is the name of the
+wavelet (haar or coif1), WaveletSubbands is a list of sub-bands (e.g. LLH,HHH), if it is empty all 8 sub-bands are added.
+The original image is the first image space, unless CalculateOriginal is 0.
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void ImageFilters::configure(const ConfigFile &config) {
+	imageSpaces.clear();
+	waveletLowPass.clear();
+	waveletHighPass.clear();
+	if (config.imageFilters != 1) {
+		return;
+	}
+	if (config.calculateOriginalSpace == 1) {
+		addImageSpace("original", "original", 0, "");
+	}
+	stringstream sigmaList(config.logSigmas);
+	string entry;
+	while (getline(sigmaList, entry, ',')) {
+		stringstream entryStream(entry);
+		float sigma = 0;
+		if (!(entryStream >> sigma) || sigma <= 0) {
+			std::cout << "The LoG width " << entry << " is not a positive number, it is ignored" << std::endl;
+			continue;
+		}
+		stringstream name;
+		name << "LoG_sigma" << sigma;
+		addImageSpace(name.str(), "LoG", sigma, "");
+	}
+	if (config.waveletName.empty()) {
+		return;
+	}
+	//decomposition low pass filters, the high pass filters are the quadrature mirror filters
+	if (config.waveletName == "haar") {
+		waveletLowPass = { 1 / sqrt(2.0), 1 / sqrt(2.0) };
+	}
+	else if (config.waveletName == "coif1") {
+		waveletLowPass = { -0.01565572813546454, -0.0727326195128539, 0.38486484686420286, 0.8525720202122554,
+			0.3378976624578092, -0.0727326195128539 };
+	}
+	else {
+		std::cout << "The wavelet " << config.waveletName << " is not available (haar, coif1), no wavelet is calculated" << std::endl;
+		return;
+	}
+	for (size_t k = 0; k < waveletLowPass.size(); k++) {
+		waveletHighPass.push_back((k % 2 == 0 ? -1 : 1) * waveletLowPass[waveletLowPass.size() - 1 - k]);
+	}
+	vector<string> subbands;
+	stringstream subbandList(config.waveletSubbands);
+	while (getline(subbandList, entry, ',')) {
+		entry.erase(std::remove(entry.begin(), entry.end(), ' '), entry.end());
+		std::transform(entry.begin(), entry.end(), entry.begin(), ::toupper);
+		if (entry.size() != 3 || entry.find_first_not_of("LH") != string::npos) {
+			std::cout << "The wavelet sub-band " << entry << " does not consist of 3 letters L or H, it is ignored" << std::endl;
+			continue;
+		}
+		subbands.push_back(entry);
+	}
+	if (config.waveletSubbands.empty()) {
+		subbands = { "LLL", "LLH", "LHL", "LHH", "HLL", "HLH", "HHL", "HHH" };
+	}
+	for (size_t i = 0; i < subbands.size(); i++) {
+		addImageSpace("wavelet_" + config.waveletName + "_" + subbands[i], "wavelet", 0, subbands[i]);
+	}
+}
+
+/*!
+\brief getMarginMM
+The function getMarginMM returns the margin (in mm) around the mask that is read by the LoG filters (4 sigma).
+*/
+float ImageFilters::getMarginMM() const {
+	float margin = 0;
+	for (size_t i = 0; i < imageSpaces.size(); i++) {
+		if (imageSpaces[i].type == "LoG") {
+			margin = std::max(margin, 4 * imageSpaces[i].sigma);
+		}
+	}
+	return margin;
+}
+
+/*!
+\brief getMarginVoxels
+The function getMarginVoxels returns the number of voxels around the mask that are read by the wavelet filters.
+*/
+int ImageFilters::getMarginVoxels() const {
+	return int(waveletLowPass.size()) / 2;
+}
+
+size_t ImageFilters::getNrImageSpaces() const {
+	return imageSpaces.size();
+}
+
+string ImageFilters::getName(size_t spaceNr) const {
+	return imageSpaces[spaceNr].name;
+}
+
+bool ImageFilters::isOriginal(size_t spaceNr) const {
+	return imageSpaces[spaceNr].type == "original";
+}
+
+/*!
+\brief filter
+The function filter calculates one image space: the filter is applied to the whole image and the values of the region are copied
+to the output.
+@param[in] image: image around the mask (with the margin of the filters)
+@param[in] region: region of the image that is copied to the output (usually the bounding box of the mask)
+@param[in] spaceNr: number of the image space
+@param[in,out] output: image with the size of the region, its values are replaced by the filtered values
+*/
+void ImageFilters::filter(ImageType *image, const RegionType &region, size_t spaceNr, ImageType *output) const {
+	const ImageSpace &imageSpace = imageSpaces[spaceNr];
+	if (imageSpace.type == "original") {
+		return;
+	}
+	const RegionType &bufferedRegion = image->GetBufferedRegion();
+	int size[3] = { int(bufferedRegion.GetSize()[0]), int(bufferedRegion.GetSize()[1]), int(bufferedRegion.GetSize()[2]) };
+	const float *imageValues = image->GetBufferPointer();
+	vector<float> values(imageValues, imageValues + size_t(size[0]) * size[1] * size[2]);
+	if (imageSpace.type == "LoG") {
+		filterLoG(values, size, image->GetSpacing(), imageSpace.sigma);
+	}
+	else {
+		filterWavelet(values, size, imageSpace.subband);
+	}
+	float *outputValues = output->GetBufferPointer();
+	int offset[3];
+	for (int i = 0; i < 3; i++) {
+		offset[i] = int(region.GetIndex()[i] - bufferedRegion.GetIndex()[i]);
+	}
+	size_t outputIndex = 0;
+	for (int z = 0; z < int(region.GetSize()[2]); z++) {
+		for (int y = 0; y < int(region.GetSize()[1]); y++) {
+			size_t index = (size_t(z + offset[2]) * size[1] + y + offset[1]) * size[0] + offset[0];
+			for (int x = 0; x < int(region.GetSize()[0]); x++, outputIndex++) {
+				outputValues[outputIndex] = values[index + x];
+			}
+		}
+	}
+}
+
+//position of a voxel outside of the line, the values are mirrored at the border (-1 -> 0, length -> length - 1)
+inline int getMirroredPosition(int position, int length) {
+	while (position < 0 || position >= length) {
+		position = position < 0 ? -position - 1 : 2 * length - position - 1;
+	}
+	return position;
+}
+
+//one-dimensional convolution along one axis, the center of the kernel is the element size/2
+void ImageFilters::convolve(const vector<float> &input, vector<float> &output, const int(&size)[3], int axis, const vector<double> &kernel) const {
+	output.assign(input.size(), 0);
+	const size_t stride = axis == 0 ? 1 : (axis == 1 ? size_t(size[0]) : size_t(size[0]) * size[1]);
+	const int length = size[axis];
+	const int center = int(kernel.size()) / 2;
+	size_t index = 0;
+	for (int z = 0; z < size[2]; z++) {
+		for (int y = 0; y < size[1]; y++) {
+			for (int x = 0; x < size[0]; x++, index++) {
+				int position = axis == 0 ? x : (axis == 1 ? y : z);
+				size_t lineStart = index - position * stride;
+				double sum = 0;
+				for (int k = 0; k < int(kernel.size()); k++) {
+					sum += kernel[k] * input[lineStart + getMirroredPosition(position + center - k, length) * stride];
+				}
+				output[index] = float(sum);
+			}
+		}
+	}
+}
+
+/*!
+\brief getGaussianKernels
+The function getGaussianKernels calculates the Gaussian kernel (sum 1) and its second derivative (sum 0) for one axis,
+both are cut at 4 sigma.
+@param[in] sigma: width of the Gaussian in mm
+@param[in] spacing: voxel spacing of the axis in mm
+*/
+void ImageFilters::getGaussianKernels(float sigma, double spacing, vector<double> &gaussian, vector<double> &secondDerivative) const {
+	int radius = int(ceil(4 * sigma / spacing));
+	double variance = double(sigma) * sigma;
+	gaussian.assign(2 * radius + 1, 0);
+	secondDerivative.assign(2 * radius + 1, 0);
+	double sum = 0;
+	for (int k = -radius; k <= radius; k++) {
+		double position = k * spacing;
+		gaussian[k + radius] = exp(-position * position / (2 * variance));
+		sum += gaussian[k + radius];
+	}
+	double derivativeSum = 0;
+	for (int k = -radius; k <= radius; k++) {
+		double position = k * spacing;
+		gaussian[k + radius] /= sum;
+		secondDerivative[k + radius] = gaussian[k + radius] * (position * position - variance) / (variance * variance);
+		derivativeSum += secondDerivative[k + radius];
+	}
+	//the cut kernel does not sum up to 0, so constant regions would have a response
+	for (size_t k = 0; k < secondDerivative.size(); k++) {
+		secondDerivative[k] -= derivativeSum * gaussian[k];
+	}
+}
+
+/*!
+\brief filterLoG
+The function filterLoG calculates the Laplacian of Gaussian as sum of the second derivatives along x, y and z (every one is the
+second derivative along one axis and the Gaussian along the other axes), multiplied by sigma^2.
+*/
+void ImageFilters::filterLoG(vector<float> &values, const int(&size)[3], const ImageType::SpacingType &spacing, float sigma) const {
+	vector<double> gaussian[3];
+	vector<double> secondDerivative[3];
+	for (int axis = 0; axis < 3; axis++) {
+		getGaussianKernels(sigma, spacing[axis], gaussian[axis], secondDerivative[axis]);
+	}
+	vector<float> smoothed;
+	vector<float> temp;
+	vector<float> derivative;
+	vector<float> result(values.size(), 0);
+	//the derivatives along x and y share the smoothing along z
+	convolve(values, smoothed, size, 2, gaussian[2]);
+	convolve(smoothed, temp, size, 1, gaussian[1]);
+	convolve(temp, derivative, size, 0, secondDerivative[0]);
+	for (size_t i = 0; i < result.size(); i++) {
+		result[i] += derivative[i];
+	}
+	convolve(smoothed, temp, size, 0, gaussian[0]);
+	convolve(temp, derivative, size, 1, secondDerivative[1]);
+	for (size_t i = 0; i < result.size(); i++) {
+		result[i] += derivative[i];
+	}
+	convolve(values, smoothed, size, 0, gaussian[0]);
+	convolve(smoothed, temp, size, 1, gaussian[1]);
+	convolve(temp, derivative, size, 2, secondDerivative[2]);
+	for (size_t i = 0; i < result.size(); i++) {
+		values[i] = (result[i] + derivative[i]) * sigma * sigma;
+	}
+}
+
+/*!
+\brief filterWavelet
+The function filterWavelet calculates one sub-band of the undecimated wavelet: the letters of the sub-band give the filter
+(L: low pass, H: high pass) along x, y and z.
+*/
+void ImageFilters::filterWavelet(vector<float> &values, const int(&size)[3], const string &subband) const {
+	vector<float> filtered;
+	for (int axis = 0; axis < 3; axis++) {
+		convolve(values, filtered, size, axis, subband[axis] == 'L' ? waveletLowPass : waveletHighPass);
+		values.swap(filtered);
+	}
+}
@@ -0,0 +1,61 @@
+#ifndef IMAGEFILTERS_H_INCLUDED
+#define IMAGEFILTERS_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "itkTypes.h"
+#include "readConfigFile.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+/*!
+The class ImageFilters calculates filtered versions of the image (image spaces), so that the features of all image spaces can be
+calculated from one loaded image (see calculateFilteredFeatures): \n
+- Laplacian of Gaussian (LoG) for a list of widths sigma (in mm), scale-normalized by sigma^2 \n
+- undecimated wavelets of level 1 (haar or coif1): for every sub-band the low or high pass filter is applied in x, y and z direction \n
+All filters are separable, so they are calculated as one-dimensional convolutions along the three axes. At the border of the image the
+values are mirrored. The values inside the mask are only exact, if the image contains the values of getMarginMM and getMarginVoxels
+around the mask.
+*/
+class ImageFilters {
+private:
+	//one image space: LoG width in mm or wavelet sub-band ("LLH": low pass in x and y, high pass in z)
+	struct ImageSpace {
+		string name;
+		string type;
+		float sigma;
+		string subband;
+	};
+	vector<ImageSpace> imageSpaces;
+	vector<double> waveletLowPass;
+	vector<double> waveletHighPass;
+
+	void addImageSpace(const string &name, const string &type, float sigma, const string &subband);
+	void convolve(const vector<float> &input, vector<float> &output, const int(&size)[3], int axis, const vector<double> &kernel) const;
+	void getGaussianKernels(float sigma, double spacing, vector<double> &gaussian, vector<double> &secondDerivative) const;
+	void filterLoG(vector<float> &values, const int(&size)[3], const ImageType::SpacingType &spacing, float sigma) const;
+	void filterWavelet(vector<float> &values, const int(&size)[3], const string &subband) const;
+
+public:
+	ImageFilters() {
+	}
+	~ImageFilters() {
+	}
+	void configure(const ConfigFile &config);
+	float getMarginMM() const;
+	int getMarginVoxels() const;
+	size_t getNrImageSpaces() const;
+	string getName(size_t spaceNr) const;
+	bool isOriginal(size_t spaceNr) const;
+	void filter(ImageType *image, const RegionType &region, size_t spaceNr, ImageType *output) const;
+};
+
+#include "imageFilters.cpp"
+
+#endif // IMAGEFILTERS_H_INCLUDED
@@ -29,7 +29,7 @@ class IntensityHistogram : StatisticalFeatures<T,R>{
         typedef accumulator_set<T, features<tag::density> > accIntensity;
 		//vector containing the probabilities
         vector<T> probabilities;
-		void getProbabilities(boost::multi_array<T, R> inputMatrix);
+		void getProbabilities(const boost::multi_array<T, R> &inputMatrix);
 		void getSkewnessKurtosisIntHist();
 		//feature values
         T entropy = NAN;
@@ -67,9 +67,9 @@ class IntensityHistogram : StatisticalFeatures<T,R>{
 		~IntensityHistogram() {
 		}
 
-		void calculateAllIntFeatures(IntensityHistogram<T, R> &intense, boost::multi_array<T, R> inputMatrix, vector<T> vectorOfMatrElements, vector<T> diffGrey);
+		void calculateAllIntFeatures(IntensityHistogram<T, R> &intense, const boost::multi_array<T, R> &inputMatrix, const vector<T> &vectorOfMatrElements, const vector<T> &diffGrey);
 		void writeCSVFileIntensity(IntensityHistogram<T, R> intensHist, string outputFolder);
-		void writeOneFileIntensity(IntensityHistogram<T, R> intense, ConfigFile config);
+		void writeOneFileIntensity(IntensityHistogram<T, R> intense, const ConfigFile &config);
 };
 
 
@@ -79,7 +79,7 @@ in the vector probElements \n
 @param[in] inputMatrix: the original matrix of the VOI
 */
 template <class T,  size_t R>
-void IntensityHistogram<T,R>::getProbabilities(boost::multi_array<T, R> inputMatrix){
+void IntensityHistogram<T,R>::getProbabilities(const boost::multi_array<T, R> &inputMatrix){
     //save matrix elements in a vector
     getNrElements(nrElementsH);
     probElements = nrElementsH;
@@ -235,7 +235,7 @@ template <class T,  size_t R>
 
 
 
-void IntensityHistogram<T,R>::calculateAllIntFeatures(IntensityHistogram<T,R> &intense, boost::multi_array<T,R> inputMatrix, vector<T> vectorOfMatrElements, vector<T> diffGrey ){
+void IntensityHistogram<T,R>::calculateAllIntFeatures(IntensityHistogram<T,R> &intense, const boost::multi_array<T,R> &inputMatrix, const vector<T> &vectorOfMatrElements, const vector<T> &diffGrey ){
   this->diffGreyLevels = diffGrey;
  
   vectorOfMatrixElem = vectorOfMatrElements;
@@ -293,7 +293,7 @@ void IntensityHistogram<T,R>::writeCSVFileIntensity(IntensityHistogram<T,R> inte
 }
 
 template <class T, size_t R>
-void IntensityHistogram<T, R>::writeOneFileIntensity(IntensityHistogram<T, R> intense, ConfigFile config)
+void IntensityHistogram<T, R>::writeOneFileIntensity(IntensityHistogram<T, R> intense, const ConfigFile &config)
 {
 	string csvName;
 	if (config.csvOutput == 1) {
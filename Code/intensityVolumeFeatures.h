@@ -36,7 +36,7 @@ class IntensityVolumeFeatures{
         T diffIntAtVolFrac = NAN;
 
         T getVolumeAtIntFraction(double percent);
-        T getIntAtVolFraction(double percent, vector<T> diffGreyLevels);
+        T getIntAtVolFraction(double percent, const vector<T> &diffGreyLevels);
         void defineIntVolFeatures(vector<string> &features);
 		void defineIntVolFeaturesOntology(vector<string> &features);
         void extractIntVolData(vector<T> &intVolData, IntensityVolumeFeatures<T, R> intVolFeatures);
@@ -48,11 +48,11 @@ class IntensityVolumeFeatures{
 		~IntensityVolumeFeatures() {
 			
 		}
-        void getFractionalVolume(boost::multi_array<T,R> inputMatrix, vector<T> vectorMatrElem);
-        void getGreyLevelFraction(boost::multi_array<T,R> inputMatrix);
-        void calculateAllIntensVolFeatures(IntensityVolumeFeatures<T,R> &intVolFeatures, boost::multi_array<T, R> inputMatrix, vector<T> vectorMatrElem);
+        void getFractionalVolume(const boost::multi_array<T,R> &inputMatrix, const vector<T> &vectorMatrElem);
+        void getGreyLevelFraction(const boost::multi_array<T,R> &inputMatrix);
+        void calculateAllIntensVolFeatures(IntensityVolumeFeatures<T,R> &intVolFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &vectorMatrElem);
         void writeCSVFileIntVol(IntensityVolumeFeatures<T,R> intVol, string outputFolder);
-		void writeOneFileIntVol(IntensityVolumeFeatures<T, R> intVol, ConfigFile config);
+		void writeOneFileIntVol(IntensityVolumeFeatures<T, R> intVol, const ConfigFile &config);
 };
 
 
@@ -63,7 +63,7 @@ The vector fractional volume vector is filled in this function
 @parameter[in] vectorMatrElemen: vector containing all grey levels of VOI
 */
 template <class T, size_t R>
-void IntensityVolumeFeatures<T, R>::getFractionalVolume(boost::multi_array<T, R> inputMatrix, vector<T> vectorMatrElem) {
+void IntensityVolumeFeatures<T, R>::getFractionalVolume(const boost::multi_array<T, R> &inputMatrix, const vector<T> &vectorMatrElem) {
 	T actFracVolume;
 	double nrElementsSmaller;
 	double nrElementsNotNAN;
@@ -96,7 +96,7 @@ In the function getGreyLevelFraction the grey level fraction is calculated and a
 @parameter[in] vectorMatrElemen: vector containing all grey levels of VOI
 */
 template <class T, size_t R>
-void IntensityVolumeFeatures<T, R>::getGreyLevelFraction(boost::multi_array<T, R> inputMatrix) {
+void IntensityVolumeFeatures<T, R>::getGreyLevelFraction(const boost::multi_array<T, R> &inputMatrix) {
 	T actGreyLevelFraction;
 
 	for (int actGreyLevel = minGreyLevel; actGreyLevel < maxGreyLevel + 1; actGreyLevel++) {
@@ -128,7 +128,7 @@ In the function getIntAtVolFraction calculates the intensity at a certain volume
 @parameter[in] double percent: percentage value for which the volume fraction is calculated
 */
 template <class T, size_t R>
-T IntensityVolumeFeatures<T, R>::getIntAtVolFraction(double percent, vector<T> diffGreyLevels) {
+T IntensityVolumeFeatures<T, R>::getIntAtVolFraction(double percent, const vector<T> &diffGreyLevels) {
 	vector<T> tempVector = fracVolume;
 	typename vector<T>::iterator it;
 	typename vector<T>::iterator greaterThan;
@@ -150,7 +150,7 @@ T IntensityVolumeFeatures<T, R>::getIntAtVolFraction(double percent, vector<T> d
 }
 
 template <class T, size_t R>
-void IntensityVolumeFeatures<T, R>::calculateAllIntensVolFeatures(IntensityVolumeFeatures<T,R> &intVolFeatures, boost::multi_array<T, R> inputMatrix, vector<T> diffGreyLevels){
+void IntensityVolumeFeatures<T, R>::calculateAllIntensVolFeatures(IntensityVolumeFeatures<T,R> &intVolFeatures, const boost::multi_array<T, R> &inputMatrix, const vector<T> &diffGreyLevels){
 	
 	vector<T> elementVector;
 	for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
@@ -207,7 +207,7 @@ void IntensityVolumeFeatures<T, R>::writeCSVFileIntVol(IntensityVolumeFeatures<T
 }
 
 template <class T, size_t R>
-void IntensityVolumeFeatures<T, R>::writeOneFileIntVol(IntensityVolumeFeatures<T, R> intVol, ConfigFile config) {
+void IntensityVolumeFeatures<T, R>::writeOneFileIntVol(IntensityVolumeFeatures<T, R> intVol, const ConfigFile &config) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
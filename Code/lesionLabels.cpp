@@ -0,0 +1,159 @@
+/*!
+\brief calculate
+The function calculate labels the connected components of the mask and fills the statistics table in one pass over the label image.
+The second order moments are calculated in index space and converted to physical space like in the ITK shape label map filter,
+so that the principal moments are the same.
+@param[in] ImageType mask: the mask of the VOI
+@param[in] ImageType image: image with the same size as the mask, if given the maximum value of every component is determined
+*/
+void LesionLabels::calculate(ImageType *mask, ImageType *image) {
+	CastFilterType::Pointer castFilter = CastFilterType::New();
+	castFilter->SetInput(mask);
+	ConnectedComponentFilterType::Pointer connectedComponentImageFilter = ConnectedComponentFilterType::New();
+	connectedComponentImageFilter->SetFullyConnected(true);
+	connectedComponentImageFilter->SetInput(castFilter->GetOutput());
+	connectedComponentImageFilter->Update();
+	labelImage = connectedComponentImageFilter->GetOutput();
+	int nrLabels = int(connectedComponentImageFilter->GetObjectCount());
+
+	//sums of the indices (x, y, z) and of their products (xx, yy, zz, xy, xz, yz) of every component
+	vector<vector<double> > sums(nrLabels, vector<double>(9, 0));
+	vector<ImageType::IndexType> firstIndex(nrLabels);
+	vector<ImageType::IndexType> lastIndex(nrLabels);
+	statistics.assign(nrLabels, LabelStatistics());
+	for (int n = 0; n < nrLabels; n++) {
+		statistics[n].label = n + 1;
+		statistics[n].nrVoxels = 0;
+		statistics[n].maxValue = -std::numeric_limits<float>::max();
+	}
+	const float *imageBuffer = nullptr;
+	if (image != nullptr) {
+		imageBuffer = image->GetBufferPointer();
+	}
+	size_t voxelNr = 0;
+	itk::ImageRegionConstIteratorWithIndex<intImage> labelIt(labelImage, labelImage->GetLargestPossibleRegion());
+	for (labelIt.GoToBegin(); !labelIt.IsAtEnd(); ++labelIt, ++voxelNr) {
+		int label = labelIt.Get();
+		if (label <= 0) {
+			continue;
+		}
+		LabelStatistics &lesion = statistics[label - 1];
+		vector<double> &sum = sums[label - 1];
+		const ImageType::IndexType &index = labelIt.GetIndex();
+		double x = double(index[0]);
+		double y = double(index[1]);
+		double z = double(index[2]);
+		sum[0] += x;
+		sum[1] += y;
+		sum[2] += z;
+		sum[3] += x * x;
+		sum[4] += y * y;
+		sum[5] += z * z;
+		sum[6] += x * y;
+		sum[7] += x * z;
+		sum[8] += y * z;
+		if (lesion.nrVoxels == 0) {
+			firstIndex[label - 1] = index;
+			lastIndex[label - 1] = index;
+		}
+		for (int i = 0; i < 3; i++) {
+			firstIndex[label - 1][i] = std::min(firstIndex[label - 1][i], index[i]);
+			lastIndex[label - 1][i] = std::max(lastIndex[label - 1][i], index[i]);
+		}
+		lesion.nrVoxels += 1;
+		if (imageBuffer != nullptr && imageBuffer[voxelNr] > lesion.maxValue) {
+			lesion.maxValue = imageBuffer[voxelNr];
+			lesion.maxIndex = index;
+		}
+	}
+
+	const intImage::SpacingType &spacing = labelImage->GetSpacing();
+	for (int n = 0; n < nrLabels; n++) {
+		LabelStatistics &lesion = statistics[n];
+		const vector<double> &sum = sums[n];
+		double nrVoxels = double(std::max(lesion.nrVoxels, 1));
+		double mean[3] = { sum[0] / nrVoxels, sum[1] / nrVoxels, sum[2] / nrVoxels };
+		double moments[3][3];
+		moments[0][0] = sum[3] / nrVoxels - mean[0] * mean[0];
+		moments[1][1] = sum[4] / nrVoxels - mean[1] * mean[1];
+		moments[2][2] = sum[5] / nrVoxels - mean[2] * mean[2];
+		moments[0][1] = sum[6] / nrVoxels - mean[0] * mean[1];
+		moments[0][2] = sum[7] / nrVoxels - mean[0] * mean[2];
+		moments[1][2] = sum[8] / nrVoxels - mean[1] * mean[2];
+		moments[1][0] = moments[0][1];
+		moments[2][0] = moments[0][2];
+		moments[2][1] = moments[1][2];
+		for (int i = 0; i < 3; i++) {
+			//second order central moment of one voxel
+			moments[i][i] += 1.0 / 12.0;
+			for (int j = 0; j < 3; j++) {
+				moments[i][j] *= spacing[i] * spacing[j];
+			}
+		}
+		getEigenvaluesSymmetric3x3(moments, lesion.principalMoments);
+
+		itk::ContinuousIndex<double, 3> centroidIndex;
+		for (int i = 0; i < 3; i++) {
+			centroidIndex[i] = mean[i];
+		}
+		ImageType::PointType centroidPoint;
+		labelImage->TransformContinuousIndexToPhysicalPoint(centroidIndex, centroidPoint);
+		for (int i = 0; i < 3; i++) {
+			lesion.centroid[i] = centroidPoint[i];
+		}
+
+		RegionType::SizeType boxSize;
+		for (int i = 0; i < 3; i++) {
+			boxSize[i] = lastIndex[n][i] - firstIndex[n][i] + 1;
+		}
+		lesion.boundingBox.SetIndex(firstIndex[n]);
+		lesion.boundingBox.SetSize(boxSize);
+	}
+}
+
+intImage *LesionLabels::getLabelImage() const {
+	return labelImage.GetPointer();
+}
+
+int LesionLabels::getNrLabels() const {
+	return int(statistics.size());
+}
+
+const vector<LabelStatistics> &LesionLabels::getStatistics() const {
+	return statistics;
+}
+
+/*!
+\brief getEigenvaluesSymmetric3x3
+The function calculates the eigenvalues of a symmetric 3x3 matrix with the closed form solution (trigonometric method).
+@param[in] matrix: symmetric matrix
+@param[out] eigenvalues: eigenvalues in ascending order
+*/
+void getEigenvaluesSymmetric3x3(const double(&matrix)[3][3], double(&eigenvalues)[3]) {
+	const double pi = 3.141592653589793238463;
+	double offDiagonal = matrix[0][1] * matrix[0][1] + matrix[0][2] * matrix[0][2] + matrix[1][2] * matrix[1][2];
+	if (offDiagonal == 0) {
+		for (int i = 0; i < 3; i++) {
+			eigenvalues[i] = matrix[i][i];
+		}
+		std::sort(eigenvalues, eigenvalues + 3);
+		return;
+	}
+	double q = (matrix[0][0] + matrix[1][1] + matrix[2][2]) / 3.0;
+	double p2 = (matrix[0][0] - q) * (matrix[0][0] - q) + (matrix[1][1] - q) * (matrix[1][1] - q)
+		+ (matrix[2][2] - q) * (matrix[2][2] - q) + 2 * offDiagonal;
+	double p = std::sqrt(p2 / 6.0);
+	double b[3][3];
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			b[i][j] = (matrix[i][j] - (i == j ? q : 0)) / p;
+		}
+	}
+	double r = (b[0][0] * (b[1][1] * b[2][2] - b[1][2] * b[2][1]) - b[0][1] * (b[1][0] * b[2][2] - b[1][2] * b[2][0])
+		+ b[0][2] * (b[1][0] * b[2][1] - b[1][1] * b[2][0])) / 2.0;
+	r = std::max(-1.0, std::min(1.0, r));
+	double phi = std::acos(r) / 3.0;
+	eigenvalues[2] = q + 2 * p * std::cos(phi);
+	eigenvalues[0] = q + 2 * p * std::cos(phi + 2 * pi / 3.0);
+	eigenvalues[1] = 3 * q - eigenvalues[0] - eigenvalues[2];
+}
@@ -0,0 +1,64 @@
+#ifndef LESIONLABELS_H_INCLUDED
+#define LESIONLABELS_H_INCLUDED
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "itkConnectedComponentImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkCastImageFilter.h"
+#include "itkTypes.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+/*!
+The struct LabelStatistics contains the values of one connected component (lesion) of the mask that are needed by
+the morphological and the dispersity features.
+*/
+struct LabelStatistics {
+	//label of the component in the label image
+	int label;
+	int nrVoxels;
+	//centroid in physical coordinates
+	double centroid[3];
+	//bounding box of the component in the label image
+	RegionType boundingBox;
+	//eigenvalues of the second order central moments in physical space (ascending order)
+	double principalMoments[3];
+	//maximum intensity value of the component and its position (only set if an image is given)
+	float maxValue;
+	ImageType::IndexType maxIndex;
+};
+
+/*!
+The class LesionLabels labels the connected components of a mask and calculates for every component a table of statistics
+(LabelStatistics). \n
+The labelling is done only once per mask and grid (see labelLesions), the label image and the table are then used by all feature
+classes that need the single lesions (surface and mesh volume, morphological features, dispersity features). \n
+The components are fully connected (26-neighbourhood).
+*/
+class LesionLabels {
+private:
+	typedef itk::ConnectedComponentImageFilter<intImage, intImage> ConnectedComponentFilterType;
+	intImage::Pointer labelImage;
+	vector<LabelStatistics> statistics;
+
+public:
+	LesionLabels() {
+	}
+	~LesionLabels() {
+	}
+	void calculate(ImageType *mask, ImageType *image = nullptr);
+	intImage *getLabelImage() const;
+	int getNrLabels() const;
+	const vector<LabelStatistics> &getStatistics() const;
+};
+
+//eigenvalues of a symmetric 3x3 matrix in ascending order
+void getEigenvaluesSymmetric3x3(const double(&matrix)[3][3], double(&eigenvalues)[3]);
+
+#include "lesionLabels.cpp"
+
+#endif // LESIONLABELS_H_INCLUDED
@@ -40,8 +40,8 @@ private:
 	void getConvMatrixSize(ImageType::Pointer mask, int &nrVoxelsDirection, float spacing, float radius);
 	//fill the convolutional matrix
 	void fillConvMatrix(boost::multi_array<T, R> &matrix, ImageType::Pointer mask);
-	void fillVector(vector<float> &index, boost::multi_array<T, R> convMatrix);
-	ImageType::Pointer calculatePeaks(boost::multi_array<T, R> convolutionalMatrix, ImageType::Pointer image);
+	void fillVector(vector<float> &index, const boost::multi_array<T, R> &convMatrix);
+	ImageType::Pointer calculatePeaks(const boost::multi_array<T, R> &convolutionalMatrix, ImageType::Pointer image);
 	boost::multi_array<T, R> calculateConvolutionMatrix(ImageType::Pointer mask);
 	void calculateLocalIntensityPeak(ImageType::Pointer peakMatrix, ImageType::Pointer image, ImageType::Pointer mask );
 	void calculateGlobalIntensityPeak(ImageType::Pointer peakMatrix, ImageType::Pointer mask);
@@ -57,11 +57,13 @@ public:
 	}
 	T localIntensityPeak = NAN;
 	T globalIntensityPeak = NAN;
-	void calculateAllLocalIntensityFeatures(LocalIntensityFeatures<T, R> &localInt, ImageType::Pointer image, ImageType::Pointer mask, ConfigFile config);
+	void calculateAllLocalIntensityFeatures(LocalIntensityFeatures<T, R> &localInt, ImageType::Pointer image, ImageType::Pointer mask, const ConfigFile &config);
 	void writeCSVFileLocalIntensity(LocalIntensityFeatures<T, R> localInt, string outputfolder);
-	void writeOneFileLocalInt(LocalIntensityFeatures<T, R> localInt, ConfigFile config);
-	void writeCSVFileLocalIntensityPET(LocalIntensityFeatures<T, R> localInt, ConfigFile config);
-	void writeOneFileLocalIntPET(LocalIntensityFeatures<T, R> localInt, ConfigFile config);
+	void writeOneFileLocalInt(LocalIntensityFeatures<T, R> localInt, const ConfigFile &config);
+	void writeCSVFileLocalIntensityPET(LocalIntensityFeatures<T, R> localInt, const ConfigFile &config);
+	void writeOneFileLocalIntPET(LocalIntensityFeatures<T, R> localInt, const ConfigFile &config);
+	//number of voxels of the peak region in one direction from the center voxel
+	int getPeakHalfWidth(float spacing);
 
 };
 
@@ -180,7 +182,7 @@ void LocalIntensityFeatures<T, R>::fillConvMatrix(boost::multi_array<T, R> &conv
 
 //fill a vector with indices
 template<class T, size_t R>
-void LocalIntensityFeatures<T, R>::fillVector(vector<float> &index, boost::multi_array<T, R> convMatrix) {
+void LocalIntensityFeatures<T, R>::fillVector(vector<float> &index, const boost::multi_array<T, R> &convMatrix) {
 	index.push_back(float(convMatrix.shape()[0] -1 )/ 2.0);
 	index.push_back(float(convMatrix.shape()[1] -1)/ 2.0);
 	index.push_back(float(convMatrix.shape()[2] -1)/ 2.0);
@@ -224,7 +226,7 @@ Every matrix element is the corresponding peak value to the element in the input
 @parameter[out]: boost multi_array peak matrix
 */
 template<class T, size_t R>
-ImageType::Pointer LocalIntensityFeatures<T, R>::calculatePeaks(boost::multi_array<T, R> convolutionalMatrix, ImageType::Pointer image) {
+ImageType::Pointer LocalIntensityFeatures<T, R>::calculatePeaks(const boost::multi_array<T, R> &convolutionalMatrix, ImageType::Pointer image) {
 //boost::multi_array<T, R> LocalIntensityFeatures<T, R>::calculatePeaks(boost::multi_array<T, R> inputMatrix, boost::multi_array<T, R> localIntMatrix, boost::multi_array<T, R> convolutionalMatrix, ImageType::Pointer image) {
 	
 	//assign the image matrix
@@ -289,6 +291,29 @@ ImageType::Pointer LocalIntensityFeatures<T, R>::calculatePeaks(boost::multi_arr
 
 
 
+/*!
+In the function getPeakHalfWidth the number of voxels that are included in the peak region in one direction from the center
+voxel is calculated, in the same way as the convolutional matrix is filled. \n
+The convolutional matrix is the product of one indicator function per direction, so it can also be applied as box filter with
+this half width in every direction.
+@parameter[in]: float spacing: image spacing in this direction
+@parameter[out]: int: half width of the peak region in voxels
+*/
+template<class T, size_t R>
+int LocalIntensityFeatures<T, R>::getPeakHalfWidth(float spacing) {
+	int nrVoxelsDirection;
+	getConvMatrixSize(nullptr, nrVoxelsDirection, spacing, originalRadius);
+	float indexOfCenter = float(nrVoxelsDirection - 1) / 2.0;
+	int halfWidth = 0;
+	for (int row = 0; row < nrVoxelsDirection; ++row) {
+		float actPos = float(row)*spacing + spacing / 2 - (indexOfCenter + 0.5)*spacing;
+		if (abs(actPos) <= 6.2) {
+			halfWidth = std::max(halfWidth, int(std::abs(row - indexOfCenter) + 0.5));
+		}
+	}
+	return halfWidth;
+}
+
 /*!
 In the function calculateLocalIntensityPeak the local intensity peak is calculated using the peak matrix. \n
 @parameter[in]: boost multi_array input matrix
@@ -334,7 +359,7 @@ void LocalIntensityFeatures<T, R>::calculateGlobalIntensityPeak(ImageType::Point
 }
 
 template<class T, size_t R>
-void LocalIntensityFeatures<T, R>::calculateAllLocalIntensityFeatures(LocalIntensityFeatures<T, R> &localInt, ImageType::Pointer image, ImageType::Pointer mask, ConfigFile config) {
+void LocalIntensityFeatures<T, R>::calculateAllLocalIntensityFeatures(LocalIntensityFeatures<T, R> &localInt, ImageType::Pointer image, ImageType::Pointer mask, const ConfigFile &config) {
 	const typename ImageType::SpacingType& inputSpacing = mask->GetSpacing();
 	voxelSize[0] = inputSpacing[0];
 	voxelSize[1] = inputSpacing[1];
@@ -389,7 +414,7 @@ void LocalIntensityFeatures<T, R>::writeCSVFileLocalIntensity(LocalIntensityFeat
 }
 
 template <class T, size_t R>
-void LocalIntensityFeatures<T, R>::writeOneFileLocalInt(LocalIntensityFeatures<T, R> localInt, ConfigFile config) {
+void LocalIntensityFeatures<T, R>::writeOneFileLocalInt(LocalIntensityFeatures<T, R> localInt, const ConfigFile &config) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -430,7 +455,7 @@ void LocalIntensityFeatures<T, R>::writeOneFileLocalInt(LocalIntensityFeatures<T
 
 
 template<class T, size_t R>
-void LocalIntensityFeatures<T, R>::writeCSVFileLocalIntensityPET(LocalIntensityFeatures<T, R> localInt, ConfigFile config) {
+void LocalIntensityFeatures<T, R>::writeCSVFileLocalIntensityPET(LocalIntensityFeatures<T, R> localInt, const ConfigFile &config) {
 	string csvName = config.outputFolder + "_localIntensity.csv";
 	char * name = new char[csvName.size() + 1];
 	std::copy(csvName.begin(), csvName.end(), name);
@@ -457,7 +482,7 @@ void LocalIntensityFeatures<T, R>::writeCSVFileLocalIntensityPET(LocalIntensityF
 }
 
 template <class T, size_t R>
-void LocalIntensityFeatures<T, R>::writeOneFileLocalIntPET(LocalIntensityFeatures<T, R> localInt, ConfigFile config) {
+void LocalIntensityFeatures<T, R>::writeOneFileLocalIntPET(LocalIntensityFeatures<T, R> localInt, const ConfigFile &config) {
 	string csvName;
 	if (config.csvOutput == 1) {
 		csvName = config.outputFolder + ".csv";
@@ -0,0 +1,110 @@
+/*!
+\brief addTimePoint
+The function addTimePoint reads the csv output of one time point and adds its values to the table.
+@param[in] timePoint: name of the time point
+@param[in] csvName: csv output of the time point
+@param[out] bool: false if the file cannot be read
+*/
+bool LongitudinalTable::addTimePoint(const string &timePoint, const string &csvName) {
+	ifstream csvFile(csvName);
+	if (!csvFile) {
+		std::cout << "The output " << csvName << " of the time point " << timePoint << " cannot be read" << std::endl;
+		return false;
+	}
+	size_t timePointNr = timePoints.size();
+	timePoints.push_back(timePoint);
+	for (size_t i = 0; i < rows.size(); i++) {
+		rows[i].values.push_back("");
+	}
+	map<string, int> occurrences;
+	string line;
+	while (getline(csvFile, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		//group and name do not contain commas, the value can (e.g. in the patient details)
+		size_t firstComma = line.find(',');
+		size_t secondComma = firstComma == string::npos ? string::npos : line.find(',', firstComma + 1);
+		if (secondComma == string::npos) {
+			continue;
+		}
+		Row row;
+		row.group = line.substr(0, firstComma);
+		row.name = line.substr(firstComma + 1, secondComma - firstComma - 1);
+		string key = row.group + "\n" + row.name;
+		key += "\n" + to_string(occurrences[key]++);
+		map<string, size_t>::const_iterator rowIndex = rowIndices.find(key);
+		if (rowIndex == rowIndices.end()) {
+			row.values.assign(timePoints.size(), "");
+			rowIndex = rowIndices.insert(std::make_pair(key, rows.size())).first;
+			rows.push_back(row);
+		}
+		rows[rowIndex->second].values[timePointNr] = line.substr(secondComma + 1);
+	}
+	return true;
+}
+
+//the text is a number if it is read completely (nan and inf are numbers too)
+bool LongitudinalTable::getNumber(const string &text, double &number) const {
+	if (text.empty()) {
+		return false;
+	}
+	char *end = nullptr;
+	number = strtod(text.c_str(), &end);
+	return end != text.c_str() && *end == '\0';
+}
+
+/*!
+\brief write
+The function write writes the table: group, name, the values of all time points, the changes to the first time point and the relative changes.
+@param[in] csvName: name of the table
+@param[out] bool: false if the file cannot be written
+*/
+bool LongitudinalTable::write(const string &csvName) const {
+	ofstream table(csvName);
+	if (!table) {
+		std::cout << "The longitudinal table " << csvName << " cannot be written" << std::endl;
+		return false;
+	}
+	table << "Group" << "," << "Name";
+	for (size_t i = 0; i < timePoints.size(); i++) {
+		table << "," << timePoints[i];
+	}
+	for (size_t i = 1; i < timePoints.size(); i++) {
+		table << "," << "delta_" << timePoints[i];
+	}
+	for (size_t i = 1; i < timePoints.size(); i++) {
+		table << "," << "relativeChange_" << timePoints[i];
+	}
+	table << "\n";
+	for (size_t rowNr = 0; rowNr < rows.size(); rowNr++) {
+		const Row &row = rows[rowNr];
+		table << row.group << "," << row.name;
+		for (size_t i = 0; i < row.values.size(); i++) {
+			//values with commas cannot be one column
+			table << "," << (row.values[i].find(',') == string::npos ? row.values[i] : "\"" + row.values[i] + "\"");
+		}
+		double baseline = 0;
+		bool baselineNumber = getNumber(row.values[0], baseline);
+		vector<string> relativeChanges;
+		for (size_t i = 1; i < row.values.size(); i++) {
+			double value = 0;
+			string relativeChange;
+			table << ",";
+			if (baselineNumber && getNumber(row.values[i], value)) {
+				table << value - baseline;
+				if (baseline != 0) {
+					stringstream relative;
+					relative << (value - baseline) / std::abs(baseline);
+					relativeChange = relative.str();
+				}
+			}
+			relativeChanges.push_back(relativeChange);
+		}
+		for (size_t i = 0; i < relativeChanges.size(); i++) {
+			table << "," << relativeChanges[i];
+		}
+		table << "\n";
+	}
+	return true;
+}
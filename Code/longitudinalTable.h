@@ -0,0 +1,48 @@
+#ifndef LONGITUDINALTABLE_H_INCLUDED
+#define LONGITUDINALTABLE_H_INCLUDED
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+using namespace std;
+
+/*! \file */
+
+/*!
+The class LongitudinalTable joins the csv outputs of several time points of one patient (see calculateLongitudinalFeatures): \n
+every line of an output (group, name and value) is one row of the table, the rows are in the order of the first output that contains them.
+If a name appears several times in a group (e.g. the lines of the multi-modality mode), the n-th line of one output is joined with the
+n-th line of the other outputs. \n
+For every row, the table contains the values of all time points, the changes to the first time point and the relative changes (change
+divided by the absolute value of the first time point). Changes are only calculated if both values are numbers.
+*/
+class LongitudinalTable {
+private:
+	struct Row {
+		string group;
+		string name;
+		vector<string> values;
+	};
+	vector<string> timePoints;
+	vector<Row> rows;
+	map<string, size_t> rowIndices;
+
+	bool getNumber(const string &text, double &number) const;
+
+public:
+	LongitudinalTable() {
+	}
+	~LongitudinalTable() {
+	}
+	bool addTimePoint(const string &timePoint, const string &csvName);
+	bool write(const string &csvName) const;
+};
+
+#include "longitudinalTable.cpp"
+
+#endif // LONGITUDINALTABLE_H_INCLUDED
@@ -4,6 +4,7 @@ using namespace std;
 
 #include "softwareParameters.h"
 #include "featureCalculation.h"
+#include "benchmark.h"
 
 #include <filesystem>
 
@@ -50,6 +51,11 @@ If the mask is a RT-struct, --voi has to be replaced by --rts:
 \endcode
 \arg Help
 With --h, a help is called, that gives an example of how the executable should be called.\n
+\arg Benchmark
+With --bench, the features are calculated for synthetic phantoms instead of an image (see the section Benchmark of the config file). Only --ini and --out are required:
+\code{.unparsed}
+/path/to/.exe --ini /path/to/iniFile --bench --out /path/to/outputfolder
+\endcode
 \arg Example data
 Example files for config, feature selection, and patient information are stored in the folder 'ExampleFiles'. Also batch-files with examples how to call the executable can be found in this folder. 
 */
@@ -58,6 +64,7 @@ Example files for config, feature selection, and patient information are stored
 	//the arguments given by the user are saved in a vector in a specific order
 	string* arguments = new string[8] {"0", "0","0","0", "0", "0","0", "0"};
 	string* nameArgument = new string[8]{ "ini", "img", "voi", "out" ,"acc", "voi", "pat", "fts"};
+	bool benchmark = false;
 	for (int i = 1; i < argc; ++i) {
 		std::string arg = argv[i];
 		//get ini file path and store it in vector
@@ -121,6 +128,10 @@ Example files for config, feature selection, and patient information are stored
 			arguments[7] = string(argv[i]);
 			
 		}
+		//calculate the synthetic phantoms of the benchmark instead of an image
+		else if (arg == "--bench") {
+			benchmark = true;
+		}
 		//call the help
 		else if (arg == "--h") {
 			arguments[0] = "--h";
@@ -130,6 +141,17 @@ Example files for config, feature selection, and patient information are stored
 		
 	}
 	
+	//the benchmark does not read an image, it only needs the ini file and the output
+	if (benchmark && arguments[0] != "--h") {
+		if (arguments[0] == "0" || arguments[3] == "0") {
+			std::cout << "For the benchmark, the input parameters ini and out have to be set" << std::endl;
+			return 0;
+		}
+		config.createBenchmarkConfigInfo(config, arguments[0], arguments[3]);
+		PhantomBenchmark phantomBenchmark;
+		phantomBenchmark.run(config);
+		return 0;
+	}
 	for (int i = 0; i < 4; i++) {
 		if (arguments[i] == "0" && arguments[0]!="--h") {
 			std::cout << "You forgot to set the input parameter " + nameArgument[i] << std::endl;
@@ -144,6 +166,7 @@ Example files for config, feature selection, and patient information are stored
 				std::cout << "--out: location of desired output folder" << std::endl;
 				std::cout << "IF mask is RT struct, --voi has to be replaced by --rts: \n --ini: location of ini file  \n --pat: location of patient info file" << std::endl;
 				std::cout << "--img: location of image or project file \n --rts: location of rt struct" << std::endl;
+				std::cout << "--bench: calculates the features of synthetic phantoms instead of an image (only --ini and --out are required)" << std::endl;
 
 				return 0;
 			
@@ -0,0 +1,477 @@
+#ifndef MARCHINGCUBES_H_INCLUDED
+#define MARCHINGCUBES_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "parallel.h"
+using namespace std;
+
+/*! \file */
+
+//position of the corners of a cube (x, y, z offset to the first corner)
+const int marchingCubesCorners[8][3] = {
+	{ 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 },
+	{ 0, 0, 1 }, { 1, 0, 1 }, { 1, 1, 1 }, { 0, 1, 1 }
+};
+//the two corners of every edge of the cube
+const int marchingCubesEdges[12][2] = {
+	{ 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },
+	{ 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },
+	{ 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+};
+//number of cube layers (in z direction) that are processed together by one thread
+const int marchingCubesSlabSize = 8;
+
+/*!
+Lookup table of the marching cubes algorithm. \n
+For every configuration of a cube (bit i is set if corner i is inside the mask) the table contains the triangles of the surface
+in this cube. Every triangle is given by the three edges on which its corners lie, the list is terminated by -1. \n
+The triangles are oriented counter clockwise seen from outside the mask, so that their normals point out of the mask. \n
+The table was created by tracing the contour of the mask on the six faces of the cube. On faces where two diagonal corners are inside
+the mask, these corners are separated. Two neighbouring cubes therefore always create the same contour on their common face and the
+surface of every connected component is closed.
+*/
+const int marchingCubesTriangles[256][16] = {
+	{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 3, 8, 9, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 10, 2, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 0, 9, 10, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 3, 9, 10, 3, 8, 9, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 2, 11, 8, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, 9, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 2, 8, 9, 2, 11, 8, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 1, 10, 11, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 1, 11, 8, 1, 10, 11, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 0, 10, 11, 0, 9, 10, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 8, 9, 10, 11, 9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 7, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 7, 4, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 0, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 3, 4, 9, 3, 7, 4, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 1, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 7, 4, 3, 10, 2, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 0, 9, 10, 0, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 3, 9, 10, 3, 4, 9, 3, 7, 4, 3, -1, -1, -1, -1 },
+	{ 11, 3, 2, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 2, 7, 4, 2, 11, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, 9, 1, 0, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 2, 4, 9, 2, 7, 4, 2, 11, 7, 2, -1, -1, -1, -1 },
+	{ 11, 3, 1, 10, 11, 1, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 1, 7, 4, 1, 11, 7, 1, 10, 11, 1, -1, -1, -1, -1 },
+	{ 11, 3, 0, 10, 11, 0, 9, 10, 0, 8, 7, 4, -1, -1, -1, -1 },
+	{ 11, 7, 4, 10, 11, 4, 9, 10, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 9, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 5, 1, 0, 4, 5, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 5, 1, 3, 4, 5, 3, 8, 4, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 1, 9, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 10, 2, 1, 9, 4, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 0, 5, 10, 0, 4, 5, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 3, 5, 10, 3, 4, 5, 3, 8, 4, 3, -1, -1, -1, -1 },
+	{ 11, 3, 2, 9, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 2, 11, 8, 2, 9, 4, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, 5, 1, 0, 4, 5, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 5, 1, 2, 4, 5, 2, 8, 4, 2, 11, 8, 2, -1, -1, -1, -1 },
+	{ 11, 3, 1, 10, 11, 1, 9, 4, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 1, 11, 8, 1, 10, 11, 1, 9, 4, 5, -1, -1, -1, -1 },
+	{ 11, 3, 0, 10, 11, 0, 5, 10, 0, 4, 5, 0, -1, -1, -1, -1 },
+	{ 8, 4, 5, 11, 8, 5, 10, 11, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 7, 5, 9, 8, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 3, 5, 9, 3, 7, 5, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 5, 1, 0, 7, 5, 0, 8, 7, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 5, 1, 3, 7, 5, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 1, 8, 7, 5, 9, 8, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 3, 5, 9, 3, 7, 5, 3, 10, 2, 1, -1, -1, -1, -1 },
+	{ 10, 2, 0, 5, 10, 0, 7, 5, 0, 8, 7, 0, -1, -1, -1, -1 },
+	{ 10, 2, 3, 5, 10, 3, 7, 5, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, 8, 7, 5, 9, 8, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 2, 5, 9, 2, 7, 5, 2, 11, 7, 2, -1, -1, -1, -1 },
+	{ 11, 3, 2, 5, 1, 0, 7, 5, 0, 8, 7, 0, -1, -1, -1, -1 },
+	{ 5, 1, 2, 7, 5, 2, 11, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 1, 10, 11, 1, 8, 7, 5, 9, 8, 5, -1, -1, -1, -1 },
+	{ 9, 0, 1, 5, 9, 1, 7, 5, 1, 11, 7, 1, 10, 11, 1, -1 },
+	{ 11, 3, 0, 10, 11, 0, 5, 10, 0, 7, 5, 0, 8, 7, 0, -1 },
+	{ 11, 7, 5, 10, 11, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 0, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 3, 8, 9, 3, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 6, 2, 1, 5, 6, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 6, 2, 1, 5, 6, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 6, 2, 0, 5, 6, 0, 9, 5, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 6, 2, 3, 5, 6, 3, 9, 5, 3, 8, 9, 3, -1, -1, -1, -1 },
+	{ 11, 3, 2, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 2, 11, 8, 2, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, 9, 1, 0, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 2, 8, 9, 2, 11, 8, 2, 10, 5, 6, -1, -1, -1, -1 },
+	{ 11, 3, 1, 6, 11, 1, 5, 6, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 1, 11, 8, 1, 6, 11, 1, 5, 6, 1, -1, -1, -1, -1 },
+	{ 11, 3, 0, 6, 11, 0, 5, 6, 0, 9, 5, 0, -1, -1, -1, -1 },
+	{ 9, 5, 6, 8, 9, 6, 11, 8, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 7, 4, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 7, 4, 3, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 0, 8, 7, 4, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 3, 4, 9, 3, 7, 4, 3, 10, 5, 6, -1, -1, -1, -1 },
+	{ 6, 2, 1, 5, 6, 1, 8, 7, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 7, 4, 3, 6, 2, 1, 5, 6, 1, -1, -1, -1, -1 },
+	{ 6, 2, 0, 5, 6, 0, 9, 5, 0, 8, 7, 4, -1, -1, -1, -1 },
+	{ 6, 2, 3, 5, 6, 3, 9, 5, 3, 4, 9, 3, 7, 4, 3, -1 },
+	{ 11, 3, 2, 8, 7, 4, 10, 5, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 2, 7, 4, 2, 11, 7, 2, 10, 5, 6, -1, -1, -1, -1 },
+	{ 11, 3, 2, 9, 1, 0, 8, 7, 4, 10, 5, 6, -1, -1, -1, -1 },
+	{ 9, 1, 2, 4, 9, 2, 7, 4, 2, 11, 7, 2, 10, 5, 6, -1 },
+	{ 11, 3, 1, 6, 11, 1, 5, 6, 1, 8, 7, 4, -1, -1, -1, -1 },
+	{ 4, 0, 1, 7, 4, 1, 11, 7, 1, 6, 11, 1, 5, 6, 1, -1 },
+	{ 11, 3, 0, 6, 11, 0, 5, 6, 0, 9, 5, 0, 8, 7, 4, -1 },
+	{ 11, 7, 4, 6, 11, 4, 5, 6, 4, 9, 5, 4, -1, -1, -1, -1 },
+	{ 9, 4, 6, 10, 9, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 9, 4, 6, 10, 9, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 1, 0, 6, 10, 0, 4, 6, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 1, 3, 6, 10, 3, 4, 6, 3, 8, 4, 3, -1, -1, -1, -1 },
+	{ 6, 2, 1, 4, 6, 1, 9, 4, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 6, 2, 1, 4, 6, 1, 9, 4, 1, -1, -1, -1, -1 },
+	{ 6, 2, 0, 4, 6, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 6, 2, 3, 4, 6, 3, 8, 4, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, 9, 4, 6, 10, 9, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 2, 11, 8, 2, 9, 4, 6, 10, 9, 6, -1, -1, -1, -1 },
+	{ 11, 3, 2, 10, 1, 0, 6, 10, 0, 4, 6, 0, -1, -1, -1, -1 },
+	{ 10, 1, 2, 6, 10, 2, 4, 6, 2, 8, 4, 2, 11, 8, 2, -1 },
+	{ 11, 3, 1, 6, 11, 1, 4, 6, 1, 9, 4, 1, -1, -1, -1, -1 },
+	{ 8, 0, 1, 11, 8, 1, 6, 11, 1, 4, 6, 1, 9, 4, 1, -1 },
+	{ 11, 3, 0, 6, 11, 0, 4, 6, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 4, 6, 11, 8, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 7, 6, 9, 8, 6, 10, 9, 6, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 3, 10, 9, 3, 6, 10, 3, 7, 6, 3, -1, -1, -1, -1 },
+	{ 10, 1, 0, 6, 10, 0, 7, 6, 0, 8, 7, 0, -1, -1, -1, -1 },
+	{ 10, 1, 3, 6, 10, 3, 7, 6, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 6, 2, 1, 7, 6, 1, 8, 7, 1, 9, 8, 1, -1, -1, -1, -1 },
+	{ 9, 0, 3, 1, 9, 3, 2, 1, 3, 6, 2, 3, 7, 6, 3, -1 },
+	{ 6, 2, 0, 7, 6, 0, 8, 7, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 6, 2, 3, 7, 6, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 2, 8, 7, 6, 9, 8, 6, 10, 9, 6, -1, -1, -1, -1 },
+	{ 9, 0, 2, 10, 9, 2, 6, 10, 2, 7, 6, 2, 11, 7, 2, -1 },
+	{ 11, 3, 2, 10, 1, 0, 6, 10, 0, 7, 6, 0, 8, 7, 0, -1 },
+	{ 10, 1, 2, 6, 10, 2, 7, 6, 2, 11, 7, 2, -1, -1, -1, -1 },
+	{ 11, 3, 1, 6, 11, 1, 7, 6, 1, 8, 7, 1, 9, 8, 1, -1 },
+	{ 9, 0, 1, 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 3, 0, 6, 11, 0, 7, 6, 0, 8, 7, 0, -1, -1, -1, -1 },
+	{ 11, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 0, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 3, 8, 9, 3, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 1, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 10, 2, 1, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 0, 9, 10, 0, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 3, 9, 10, 3, 8, 9, 3, 11, 6, 7, -1, -1, -1, -1 },
+	{ 7, 3, 2, 6, 7, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 2, 7, 8, 2, 6, 7, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 7, 3, 2, 6, 7, 2, 9, 1, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 2, 8, 9, 2, 7, 8, 2, 6, 7, 2, -1, -1, -1, -1 },
+	{ 7, 3, 1, 6, 7, 1, 10, 6, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 1, 7, 8, 1, 6, 7, 1, 10, 6, 1, -1, -1, -1, -1 },
+	{ 7, 3, 0, 6, 7, 0, 10, 6, 0, 9, 10, 0, -1, -1, -1, -1 },
+	{ 10, 6, 7, 9, 10, 7, 8, 9, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 6, 4, 8, 11, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 6, 4, 3, 11, 6, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 0, 11, 6, 4, 8, 11, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 3, 4, 9, 3, 6, 4, 3, 11, 6, 3, -1, -1, -1, -1 },
+	{ 10, 2, 1, 11, 6, 4, 8, 11, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 6, 4, 3, 11, 6, 3, 10, 2, 1, -1, -1, -1, -1 },
+	{ 10, 2, 0, 9, 10, 0, 11, 6, 4, 8, 11, 4, -1, -1, -1, -1 },
+	{ 10, 2, 3, 9, 10, 3, 4, 9, 3, 6, 4, 3, 11, 6, 3, -1 },
+	{ 8, 3, 2, 4, 8, 2, 6, 4, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 2, 6, 4, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 2, 4, 8, 2, 6, 4, 2, 9, 1, 0, -1, -1, -1, -1 },
+	{ 9, 1, 2, 4, 9, 2, 6, 4, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 1, 4, 8, 1, 6, 4, 1, 10, 6, 1, -1, -1, -1, -1 },
+	{ 4, 0, 1, 6, 4, 1, 10, 6, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 0, 4, 8, 0, 6, 4, 0, 10, 6, 0, 9, 10, 0, -1 },
+	{ 10, 6, 4, 9, 10, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 4, 5, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 9, 4, 5, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 5, 1, 0, 4, 5, 0, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 5, 1, 3, 4, 5, 3, 8, 4, 3, 11, 6, 7, -1, -1, -1, -1 },
+	{ 10, 2, 1, 9, 4, 5, 11, 6, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 10, 2, 1, 9, 4, 5, 11, 6, 7, -1, -1, -1, -1 },
+	{ 10, 2, 0, 5, 10, 0, 4, 5, 0, 11, 6, 7, -1, -1, -1, -1 },
+	{ 10, 2, 3, 5, 10, 3, 4, 5, 3, 8, 4, 3, 11, 6, 7, -1 },
+	{ 7, 3, 2, 6, 7, 2, 9, 4, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 2, 7, 8, 2, 6, 7, 2, 9, 4, 5, -1, -1, -1, -1 },
+	{ 7, 3, 2, 6, 7, 2, 5, 1, 0, 4, 5, 0, -1, -1, -1, -1 },
+	{ 5, 1, 2, 4, 5, 2, 8, 4, 2, 7, 8, 2, 6, 7, 2, -1 },
+	{ 7, 3, 1, 6, 7, 1, 10, 6, 1, 9, 4, 5, -1, -1, -1, -1 },
+	{ 8, 0, 1, 7, 8, 1, 6, 7, 1, 10, 6, 1, 9, 4, 5, -1 },
+	{ 7, 3, 0, 6, 7, 0, 10, 6, 0, 5, 10, 0, 4, 5, 0, -1 },
+	{ 8, 4, 5, 7, 8, 5, 6, 7, 5, 10, 6, 5, -1, -1, -1, -1 },
+	{ 11, 6, 5, 8, 11, 5, 9, 8, 5, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 3, 5, 9, 3, 6, 5, 3, 11, 6, 3, -1, -1, -1, -1 },
+	{ 5, 1, 0, 6, 5, 0, 11, 6, 0, 8, 11, 0, -1, -1, -1, -1 },
+	{ 5, 1, 3, 6, 5, 3, 11, 6, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 2, 1, 11, 6, 5, 8, 11, 5, 9, 8, 5, -1, -1, -1, -1 },
+	{ 9, 0, 3, 5, 9, 3, 6, 5, 3, 11, 6, 3, 10, 2, 1, -1 },
+	{ 10, 2, 0, 5, 10, 0, 6, 5, 0, 11, 6, 0, 8, 11, 0, -1 },
+	{ 10, 2, 3, 5, 10, 3, 6, 5, 3, 11, 6, 3, -1, -1, -1, -1 },
+	{ 8, 3, 2, 9, 8, 2, 5, 9, 2, 6, 5, 2, -1, -1, -1, -1 },
+	{ 9, 0, 2, 5, 9, 2, 6, 5, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 2, 0, 8, 2, 1, 0, 2, 5, 1, 2, 6, 5, 2, -1 },
+	{ 5, 1, 2, 6, 5, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 1, 9, 8, 1, 5, 9, 1, 6, 5, 1, 10, 6, 1, -1 },
+	{ 9, 0, 1, 5, 9, 1, 6, 5, 1, 10, 6, 1, -1, -1, -1, -1 },
+	{ 8, 3, 0, 10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 6, 5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 5, 7, 11, 10, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 10, 5, 7, 11, 10, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 0, 10, 5, 7, 11, 10, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 1, 3, 8, 9, 3, 10, 5, 7, 11, 10, 7, -1, -1, -1, -1 },
+	{ 11, 2, 1, 7, 11, 1, 5, 7, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 11, 2, 1, 7, 11, 1, 5, 7, 1, -1, -1, -1, -1 },
+	{ 11, 2, 0, 7, 11, 0, 5, 7, 0, 9, 5, 0, -1, -1, -1, -1 },
+	{ 11, 2, 3, 7, 11, 3, 5, 7, 3, 9, 5, 3, 8, 9, 3, -1 },
+	{ 7, 3, 2, 5, 7, 2, 10, 5, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 2, 7, 8, 2, 5, 7, 2, 10, 5, 2, -1, -1, -1, -1 },
+	{ 7, 3, 2, 5, 7, 2, 10, 5, 2, 9, 1, 0, -1, -1, -1, -1 },
+	{ 9, 1, 2, 8, 9, 2, 7, 8, 2, 5, 7, 2, 10, 5, 2, -1 },
+	{ 7, 3, 1, 5, 7, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 1, 7, 8, 1, 5, 7, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 7, 3, 0, 5, 7, 0, 9, 5, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 5, 7, 8, 9, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 5, 4, 11, 10, 4, 8, 11, 4, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 5, 4, 3, 10, 5, 3, 11, 10, 3, -1, -1, -1, -1 },
+	{ 9, 1, 0, 10, 5, 4, 11, 10, 4, 8, 11, 4, -1, -1, -1, -1 },
+	{ 9, 1, 3, 4, 9, 3, 5, 4, 3, 10, 5, 3, 11, 10, 3, -1 },
+	{ 11, 2, 1, 8, 11, 1, 4, 8, 1, 5, 4, 1, -1, -1, -1, -1 },
+	{ 4, 0, 3, 5, 4, 3, 1, 5, 3, 2, 1, 3, 11, 2, 3, -1 },
+	{ 11, 2, 0, 8, 11, 0, 4, 8, 0, 5, 4, 0, 9, 5, 0, -1 },
+	{ 11, 2, 3, 9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 2, 4, 8, 2, 5, 4, 2, 10, 5, 2, -1, -1, -1, -1 },
+	{ 4, 0, 2, 5, 4, 2, 10, 5, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 2, 4, 8, 2, 5, 4, 2, 10, 5, 2, 9, 1, 0, -1 },
+	{ 9, 1, 2, 4, 9, 2, 5, 4, 2, 10, 5, 2, -1, -1, -1, -1 },
+	{ 8, 3, 1, 4, 8, 1, 5, 4, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 4, 0, 1, 5, 4, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 0, 4, 8, 0, 5, 4, 0, 9, 5, 0, -1, -1, -1, -1 },
+	{ 9, 5, 4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 4, 7, 10, 9, 7, 11, 10, 7, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 9, 4, 7, 10, 9, 7, 11, 10, 7, -1, -1, -1, -1 },
+	{ 10, 1, 0, 11, 10, 0, 7, 11, 0, 4, 7, 0, -1, -1, -1, -1 },
+	{ 10, 1, 3, 11, 10, 3, 7, 11, 3, 4, 7, 3, 8, 4, 3, -1 },
+	{ 11, 2, 1, 7, 11, 1, 4, 7, 1, 9, 4, 1, -1, -1, -1, -1 },
+	{ 8, 0, 3, 11, 2, 1, 7, 11, 1, 4, 7, 1, 9, 4, 1, -1 },
+	{ 11, 2, 0, 7, 11, 0, 4, 7, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 2, 3, 7, 11, 3, 4, 7, 3, 8, 4, 3, -1, -1, -1, -1 },
+	{ 7, 3, 2, 4, 7, 2, 9, 4, 2, 10, 9, 2, -1, -1, -1, -1 },
+	{ 8, 0, 2, 7, 8, 2, 4, 7, 2, 9, 4, 2, 10, 9, 2, -1 },
+	{ 7, 3, 2, 4, 7, 2, 0, 4, 2, 1, 0, 2, 10, 1, 2, -1 },
+	{ 10, 1, 2, 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 7, 3, 1, 4, 7, 1, 9, 4, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 0, 1, 7, 8, 1, 4, 7, 1, 9, 4, 1, -1, -1, -1, -1 },
+	{ 7, 3, 0, 4, 7, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 4, 7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 9, 8, 11, 10, 8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 3, 10, 9, 3, 11, 10, 3, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 1, 0, 11, 10, 0, 8, 11, 0, -1, -1, -1, -1, -1, -1, -1 },
+	{ 10, 1, 3, 11, 10, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 2, 1, 8, 11, 1, 9, 8, 1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 3, 1, 9, 3, 2, 1, 3, 11, 2, 3, -1, -1, -1, -1 },
+	{ 11, 2, 0, 8, 11, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 11, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 2, 9, 8, 2, 10, 9, 2, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 2, 10, 9, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 2, 0, 8, 2, 1, 0, 2, 10, 1, 2, -1, -1, -1, -1 },
+	{ 10, 1, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 1, 9, 8, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 9, 0, 1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ 8, 3, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 }
+};
+
+
+/*!
+The class MarchingCubes calculates the surface and the volume of the mesh of a mask with the marching cubes algorithm. \n
+The mask is given as label image (0 outside the mask, label of the connected component inside), so all components are processed
+in one pass. The triangles are not stored: for every triangle the area and the signed volume of the tetrahedron between the
+triangle and the origin are added to the values of its label. As the surface of every component is closed, the sum of the signed
+volumes is the volume enclosed by the mesh. \n
+The image is divided in slabs of marchingCubesSlabSize cube layers that are processed in parallel. The results of the slabs are
+added in the order of the slabs, so they do not depend on the number of threads. \n
+If keepMesh is set, the triangles are stored as well, so that the mesh can be written to a file to check it.
+*/
+template <class L>
+class MarchingCubes {
+private:
+	//labels of the voxels, stored like the ITK image buffer (x is running fastest)
+	const L *labels;
+	int size[3];
+	double spacing[3];
+	int nrLabels;
+	bool keepMesh;
+
+	L getLabel(int x, int y, int z) const;
+	void calculateSlab(int firstLayer, int lastLayer, vector<double> &slabSurface, vector<double> &slabVolume, vector<float> &slabTriangles) const;
+
+public:
+	//surface and volume of the mesh of every label (index 0 is not used)
+	vector<double> surfacePerLabel;
+	vector<double> volumePerLabel;
+	//coordinates (x, y, z) of the corners of the triangles, only filled if keepMesh is set
+	vector<float> triangles;
+
+	MarchingCubes(const L *labelBuffer, const int(&imageSize)[3], const double(&voxelSpacing)[3], int maxLabel, bool storeMesh = false);
+	~MarchingCubes() {
+	}
+	void calculate(unsigned int nrThreads = 0);
+	bool writeOBJ(string fileName, const double(&origin)[3]) const;
+};
+
+template <class L>
+MarchingCubes<L>::MarchingCubes(const L *labelBuffer, const int(&imageSize)[3], const double(&voxelSpacing)[3], int maxLabel, bool storeMesh)
+	: labels(labelBuffer), nrLabels(maxLabel), keepMesh(storeMesh) {
+	for (int i = 0; i < 3; i++) {
+		size[i] = imageSize[i];
+		spacing[i] = voxelSpacing[i];
+	}
+}
+
+/*!
+\brief getLabel
+The function getLabel returns the label of a voxel. Voxels outside the image are outside the mask, so the cubes at the
+border of the image also close the surface.
+*/
+template <class L>
+L MarchingCubes<L>::getLabel(int x, int y, int z) const {
+	if (x < 0 || y < 0 || z < 0 || x >= size[0] || y >= size[1] || z >= size[2]) {
+		return L(0);
+	}
+	return labels[(size_t(z) * size[1] + y) * size[0] + x];
+}
+
+/*!
+\brief calculate
+The function calculate runs the marching cubes algorithm over the whole image and stores the surface and volume of every label.
+@param[in] nrThreads: number of threads, if 0 the number of cores is used
+*/
+template <class L>
+void MarchingCubes<L>::calculate(unsigned int nrThreads) {
+	//the cubes start one voxel before the image, so that the layers -1 ... size[2]-1 have to be processed
+	int nrLayers = size[2] + 1;
+	int nrSlabs = (nrLayers + marchingCubesSlabSize - 1) / marchingCubesSlabSize;
+	vector<vector<double> > slabSurface(nrSlabs, vector<double>(nrLabels + 1, 0));
+	vector<vector<double> > slabVolume(nrSlabs, vector<double>(nrLabels + 1, 0));
+	vector<vector<float> > slabTriangles(nrSlabs);
+	runParallel(nrSlabs, nrThreads, [&](size_t slab) {
+		int firstLayer = int(slab) * marchingCubesSlabSize - 1;
+		int lastLayer = std::min(firstLayer + marchingCubesSlabSize, nrLayers - 1);
+		calculateSlab(firstLayer, lastLayer, slabSurface[slab], slabVolume[slab], slabTriangles[slab]);
+	});
+	surfacePerLabel.assign(nrLabels + 1, 0);
+	volumePerLabel.assign(nrLabels + 1, 0);
+	triangles.clear();
+	for (int slab = 0; slab < nrSlabs; slab++) {
+		for (int label = 0; label <= nrLabels; label++) {
+			surfacePerLabel[label] += slabSurface[slab][label];
+			volumePerLabel[label] += slabVolume[slab][label];
+		}
+		triangles.insert(triangles.end(), slabTriangles[slab].begin(), slabTriangles[slab].end());
+	}
+}
+
+/*!
+\brief calculateSlab
+The function calculateSlab processes the cubes of the layers firstLayer to lastLayer (the first corner of the cube lies in this layer). \n
+As the mask is binary, the corners of the triangles lie in the middle of the edges.
+@param[in] firstLayer, lastLayer: layers of the slab, lastLayer is not included
+@param[out] slabSurface, slabVolume: surface and volume of every label in this slab
+@param[out] slabTriangles: triangles of the slab (only if keepMesh is set)
+*/
+template <class L>
+void MarchingCubes<L>::calculateSlab(int firstLayer, int lastLayer, vector<double> &slabSurface, vector<double> &slabVolume, vector<float> &slabTriangles) const {
+	L cornerLabels[8];
+	double edgePoints[12][3];
+	for (int z = firstLayer; z < lastLayer; z++) {
+		for (int y = -1; y < size[1]; y++) {
+			for (int x = -1; x < size[0]; x++) {
+				int configuration = 0;
+				L label = L(0);
+				for (int corner = 0; corner < 8; corner++) {
+					cornerLabels[corner] = getLabel(x + marchingCubesCorners[corner][0], y + marchingCubesCorners[corner][1], z + marchingCubesCorners[corner][2]);
+					if (cornerLabels[corner] != L(0)) {
+						configuration |= 1 << corner;
+						label = cornerLabels[corner];
+					}
+				}
+				const int *cubeTriangles = marchingCubesTriangles[configuration];
+				if (cubeTriangles[0] == -1) {
+					continue;
+				}
+				for (int edge = 0; edge < 12; edge++) {
+					const int *corner1 = marchingCubesCorners[marchingCubesEdges[edge][0]];
+					const int *corner2 = marchingCubesCorners[marchingCubesEdges[edge][1]];
+					edgePoints[edge][0] = (x + 0.5 * (corner1[0] + corner2[0])) * spacing[0];
+					edgePoints[edge][1] = (y + 0.5 * (corner1[1] + corner2[1])) * spacing[1];
+					edgePoints[edge][2] = (z + 0.5 * (corner1[2] + corner2[2])) * spacing[2];
+				}
+				for (int i = 0; cubeTriangles[i] != -1; i += 3) {
+					const double *p1 = edgePoints[cubeTriangles[i]];
+					const double *p2 = edgePoints[cubeTriangles[i + 1]];
+					const double *p3 = edgePoints[cubeTriangles[i + 2]];
+					double a[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+					double b[3] = { p3[0] - p1[0], p3[1] - p1[1], p3[2] - p1[2] };
+					double cross[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+					slabSurface[label] += 0.5 * sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+					//signed volume of the tetrahedron origin, p1, p2, p3
+					slabVolume[label] += (p1[0] * (p2[1] * p3[2] - p2[2] * p3[1]) + p1[1] * (p2[2] * p3[0] - p2[0] * p3[2])
+						+ p1[2] * (p2[0] * p3[1] - p2[1] * p3[0])) / 6.0;
+					if (keepMesh) {
+						for (int k = 0; k < 3; k++) {
+							slabTriangles.push_back(float(p1[k]));
+						}
+						for (int k = 0; k < 3; k++) {
+							slabTriangles.push_back(float(p2[k]));
+						}
+						for (int k = 0; k < 3; k++) {
+							slabTriangles.push_back(float(p3[k]));
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+/*!
+\brief writeOBJ
+The function writeOBJ writes the stored triangles as Wavefront .obj file, so that the mesh can be checked in a viewer.
+@param[in] fileName: name of the .obj file
+@param[in] origin: physical position of the first voxel, added to all points
+@param[out] false if the mesh was not stored or the file could not be written
+*/
+template <class L>
+bool MarchingCubes<L>::writeOBJ(string fileName, const double(&origin)[3]) const {
+	if (!keepMesh) {
+		std::cout << "The mesh was not stored and can not be written" << std::endl;
+		return false;
+	}
+	ofstream objFile(fileName.c_str());
+	if (!objFile) {
+		std::cout << "Cannot open the mesh file " << fileName << std::endl;
+		return false;
+	}
+	for (size_t i = 0; i < triangles.size(); i += 3) {
+		objFile << "v " << triangles[i] + origin[0] << " " << triangles[i + 1] + origin[1] << " " << triangles[i + 2] + origin[2] << "\n";
+	}
+	for (size_t i = 0; i < triangles.size() / 9; i++) {
+		objFile << "f " << 3 * i + 1 << " " << 3 * i + 2 << " " << 3 * i + 3 << "\n";
+	}
+	return true;
+}
+
+#endif // MARCHINGCUBES_H_INCLUDED
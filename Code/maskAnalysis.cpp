@@ -0,0 +1,209 @@
+/*!
+\brief isInside
+A voxel is inside the mask if its value is positive and at least thresholdValue.
+*/
+bool MaskAnalysis::isInside(float value, float thresholdValue) const {
+	return value > 0 && value >= thresholdValue;
+}
+
+/*!
+\brief analyse
+The function analyse reads the mask once and stores maximum value, number of voxels and bounding box of the mask.
+@param[in] ImageType maskImage: the mask
+@param[in] float maskThreshold: voxels with a value >= maskThreshold * maximum value are inside the mask
+@param[in] nrThreads: number of threads, if 0 the number of cores is used
+*/
+void MaskAnalysis::analyse(ImageType *maskImage, float maskThreshold, unsigned int nrThreads) {
+	mask = maskImage;
+	threshold = maskThreshold;
+	const RegionType &maskRegion = mask->GetBufferedRegion();
+	const ImageType::SizeType &size = maskRegion.GetSize();
+	int nrSlices = int(size[2]);
+	unsigned int nrBlocks = getNrThreads(nrThreads, size_t(std::max(nrSlices, 1)));
+
+	//every thread reads a block of slices and stores maximum and bounding box of the non zero voxels of its block
+	vector<float> blockMax(nrBlocks, 0);
+	vector<vector<long> > blockFirst(nrBlocks, vector<long>(3, 0));
+	vector<vector<long> > blockLast(nrBlocks, vector<long>(3, -1));
+	const float *buffer = mask->GetBufferPointer();
+	runParallel(nrBlocks, nrBlocks, [&](size_t blockNr) {
+		int firstSlice = int((size_t(nrSlices) * blockNr) / nrBlocks);
+		int lastSlice = int((size_t(nrSlices) * (blockNr + 1)) / nrBlocks);
+		float maximum = 0;
+		vector<long> &first = blockFirst[blockNr];
+		vector<long> &last = blockLast[blockNr];
+		bool found = false;
+		for (int z = firstSlice; z < lastSlice; z++) {
+			for (int y = 0; y < int(size[1]); y++) {
+				const float *line = buffer + (size_t(z) * size[1] + y) * size[0];
+				for (int x = 0; x < int(size[0]); x++) {
+					if (line[x] == 0) {
+						continue;
+					}
+					maximum = std::max(maximum, line[x]);
+					long index[3] = { x, y, z };
+					for (int i = 0; i < 3; i++) {
+						first[i] = found ? std::min(first[i], index[i]) : index[i];
+						last[i] = found ? std::max(last[i], index[i]) : index[i];
+					}
+					found = true;
+				}
+			}
+		}
+		blockMax[blockNr] = maximum;
+	});
+
+	maxValue = 0;
+	long first[3] = { 0, 0, 0 };
+	long last[3] = { -1, -1, -1 };
+	bool found = false;
+	for (unsigned int blockNr = 0; blockNr < nrBlocks; blockNr++) {
+		maxValue = std::max(maxValue, blockMax[blockNr]);
+		if (blockLast[blockNr][0] < 0) {
+			continue;
+		}
+		for (int i = 0; i < 3; i++) {
+			first[i] = found ? std::min(first[i], blockFirst[blockNr][i]) : blockFirst[blockNr][i];
+			last[i] = found ? std::max(last[i], blockLast[blockNr][i]) : blockLast[blockNr][i];
+		}
+		found = true;
+	}
+	for (int i = 0; i < 3; i++) {
+		nonZeroRegion.SetIndex(i, maskRegion.GetIndex()[i] + first[i]);
+		nonZeroRegion.SetSize(i, found ? last[i] - first[i] + 1 : 0);
+	}
+	countRegion(threshold * maxValue, nrVoxels, boundingBox);
+}
+
+/*!
+\brief countRegion
+The function countRegion counts the voxels inside the mask for a threshold value and determines their bounding box.
+Only the bounding box of the non zero voxels is read.
+*/
+void MaskAnalysis::countRegion(float thresholdValue, int &nrInside, RegionType &insideRegion) const {
+	nrInside = 0;
+	long first[3] = { 0, 0, 0 };
+	long last[3] = { -1, -1, -1 };
+	if (nonZeroRegion.GetNumberOfPixels() > 0) {
+		itk::ImageRegionConstIteratorWithIndex<ImageType> maskIt(mask, nonZeroRegion);
+		for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt) {
+			if (!isInside(maskIt.Get(), thresholdValue)) {
+				continue;
+			}
+			const ImageType::IndexType &index = maskIt.GetIndex();
+			for (int i = 0; i < 3; i++) {
+				first[i] = nrInside > 0 ? std::min(first[i], long(index[i])) : long(index[i]);
+				last[i] = nrInside > 0 ? std::max(last[i], long(index[i])) : long(index[i]);
+			}
+			nrInside += 1;
+		}
+	}
+	for (int i = 0; i < 3; i++) {
+		insideRegion.SetIndex(i, nrInside > 0 ? first[i] : nonZeroRegion.GetIndex()[i]);
+		insideRegion.SetSize(i, nrInside > 0 ? last[i] - first[i] + 1 : 0);
+	}
+}
+
+/*!
+\brief countVoxels
+The function countVoxels counts the voxels with a value >= countThreshold * maximum value. \n
+The mask has to be analysed before.
+*/
+int MaskAnalysis::countVoxels(float countThreshold) const {
+	int nrInside;
+	RegionType insideRegion;
+	countRegion(countThreshold * maxValue, nrInside, insideRegion);
+	return nrInside;
+}
+
+/*!
+\brief getBinaryMask
+The function getBinaryMask cuts a region from the mask and sets the voxels inside the mask to 1 and all others to 0. \n
+The region has the same position as the region cut by getImageMasked, so the image can be cut in the same way.
+@param[in] region: region of the mask
+@param[out] ImageType: binary mask of the region
+*/
+ImageType::Pointer MaskAnalysis::getBinaryMask(const RegionType &region) const {
+	FilterType::Pointer filter = FilterType::New();
+	filter->SetRegionOfInterest(region);
+	filter->SetInput(mask);
+	filter->Update();
+	ImageType::Pointer binaryMask = filter->GetOutput();
+	binaryMask->DisconnectPipeline();
+	float thresholdValue = threshold * maxValue;
+	itk::ImageRegionIterator<ImageType> maskIt(binaryMask, binaryMask->GetLargestPossibleRegion());
+	for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt) {
+		maskIt.Set(isInside(maskIt.Get(), thresholdValue) ? 1 : 0);
+	}
+	return binaryMask;
+}
+
+/*!
+\brief getBinaryMask
+Binary mask of the bounding box of the voxels inside the mask.
+*/
+ImageType::Pointer MaskAnalysis::getBinaryMask() const {
+	return getBinaryMask(boundingBox);
+}
+
+/*!
+\brief getLabels
+The function getLabels finds all labels (positive integer values) of a label image and the bounding box of every label.
+The mask has to be analysed before.
+@param[out] labels: the labels in ascending order
+@param[out] labelRegions: bounding box of every label
+*/
+void MaskAnalysis::getLabels(vector<int> &labels, vector<RegionType> &labelRegions) const {
+	map<int, pair<ImageType::IndexType, ImageType::IndexType> > labelBoxes;
+	if (nonZeroRegion.GetNumberOfPixels() > 0) {
+		itk::ImageRegionConstIteratorWithIndex<ImageType> maskIt(mask, nonZeroRegion);
+		for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt) {
+			int label = int(std::lround(maskIt.Get()));
+			if (label <= 0) {
+				continue;
+			}
+			const ImageType::IndexType &index = maskIt.GetIndex();
+			map<int, pair<ImageType::IndexType, ImageType::IndexType> >::iterator boxIt = labelBoxes.find(label);
+			if (boxIt == labelBoxes.end()) {
+				labelBoxes[label] = make_pair(index, index);
+				continue;
+			}
+			for (int i = 0; i < 3; i++) {
+				boxIt->second.first[i] = std::min(boxIt->second.first[i], index[i]);
+				boxIt->second.second[i] = std::max(boxIt->second.second[i], index[i]);
+			}
+		}
+	}
+	labels.clear();
+	labelRegions.clear();
+	for (map<int, pair<ImageType::IndexType, ImageType::IndexType> >::const_iterator boxIt = labelBoxes.begin(); boxIt != labelBoxes.end(); ++boxIt) {
+		RegionType labelRegion;
+		for (int i = 0; i < 3; i++) {
+			labelRegion.SetIndex(i, boxIt->second.first[i]);
+			labelRegion.SetSize(i, boxIt->second.second[i] - boxIt->second.first[i] + 1);
+		}
+		labels.push_back(boxIt->first);
+		labelRegions.push_back(labelRegion);
+	}
+}
+
+/*!
+\brief getLabelMask
+The function getLabelMask cuts a region from a label image and sets the voxels of the label to 1 and all others to 0.
+@param[in] label: the label
+@param[in] region: region of the mask
+@param[out] ImageType: binary mask of the label
+*/
+ImageType::Pointer MaskAnalysis::getLabelMask(int label, const RegionType &region) const {
+	FilterType::Pointer filter = FilterType::New();
+	filter->SetRegionOfInterest(region);
+	filter->SetInput(mask);
+	filter->Update();
+	ImageType::Pointer labelMask = filter->GetOutput();
+	labelMask->DisconnectPipeline();
+	itk::ImageRegionIterator<ImageType> maskIt(labelMask, labelMask->GetLargestPossibleRegion());
+	for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt) {
+		maskIt.Set(int(std::lround(maskIt.Get())) == label ? 1 : 0);
+	}
+	return labelMask;
+}
@@ -0,0 +1,58 @@
+#ifndef MASKANALYSIS_H_INCLUDED
+#define MASKANALYSIS_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkTypes.h"
+#include "parallel.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+/*!
+The class MaskAnalysis collects the information about a mask that is needed before the feature calculation in one pass
+over the mask: \n
+- the maximum value in the mask
+- the bounding box of all voxels that are not 0
+- the number of voxels and the bounding box of the voxels inside the mask (value >= threshold * maximum value) \n
+The whole image is read only once (in parallel, slice by slice), the voxels inside the mask are then counted only in the
+bounding box of the non zero voxels, which is usually much smaller than the field of view. \n
+Other thresholds (e.g. for the original volume) can be counted afterwards with countVoxels, which also only needs the bounding box. \n
+If the mask is a label image, getLabels finds the labels and their bounding boxes, again only in the bounding box of the non zero voxels.
+*/
+class MaskAnalysis {
+private:
+	ImageType *mask;
+	float threshold;
+
+	bool isInside(float value, float thresholdValue) const;
+	void countRegion(float thresholdValue, int &nrInside, RegionType &insideRegion) const;
+
+public:
+	float maxValue;
+	//bounding box of the voxels that are not 0
+	RegionType nonZeroRegion;
+	//number of voxels and bounding box of the voxels inside the mask
+	int nrVoxels;
+	RegionType boundingBox;
+
+	MaskAnalysis() : mask(nullptr), threshold(0), maxValue(0), nrVoxels(0) {
+	}
+	~MaskAnalysis() {
+	}
+	void analyse(ImageType *maskImage, float maskThreshold, unsigned int nrThreads = 0);
+	int countVoxels(float countThreshold) const;
+	ImageType::Pointer getBinaryMask(const RegionType &region) const;
+	ImageType::Pointer getBinaryMask() const;
+	//labels of a label image and the bounding box of every label
+	void getLabels(vector<int> &labels, vector<RegionType> &labelRegions) const;
+	ImageType::Pointer getLabelMask(int label, const RegionType &region) const;
+};
+
+#include "maskAnalysis.cpp"
+
+#endif // MASKANALYSIS_H_INCLUDED
@@ -0,0 +1,202 @@
+void MaskPerturbation::addPerturbation(const string &name, int erosionDilation, int translationX, int translationY, int translationZ, int contourNr) {
+	Perturbation perturbation;
+	perturbation.name = name;
+	perturbation.erosionDilation = erosionDilation;
+	perturbation.translation[0] = translationX;
+	perturbation.translation[1] = translationY;
+	perturbation.translation[2] = translationZ;
+	perturbation.contourNr = contourNr;
+	perturbations.push_back(perturbation);
+}
+
+/*!
+\brief configure
+The function configure reads the perturbations from the config file: \n
+ErosionDilation is a list of voxel numbers (separated by commas), negative numbers erode and positive numbers dilate the mask.
+Translation moves the mask by this number of voxels in both directions of x, y and z (6 masks). NrRandomContours masks with randomized
+contours are created, ContourProbability is the probability that a voxel on the contour is changed.
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void MaskPerturbation::configure(const ConfigFile &config) {
+	perturbations.clear();
+	contourProbability = config.contourProbability;
+	randomSeed = unsigned(config.perturbationSeed);
+	stringstream erosionDilationList(config.perturbationErosionDilation);
+	string entry;
+	while (getline(erosionDilationList, entry, ',')) {
+		stringstream entryStream(entry);
+		int voxels = 0;
+		if (!(entryStream >> voxels) || voxels == 0) {
+			std::cout << "The erosion/dilation " << entry << " is not a number of voxels, it is ignored" << std::endl;
+			continue;
+		}
+		addPerturbation((voxels < 0 ? "erosion" : "dilation") + to_string(std::abs(voxels)), voxels, 0, 0, 0, -1);
+	}
+	if (config.perturbationTranslation > 0) {
+		const string axes[3] = { "x", "y", "z" };
+		for (int axis = 0; axis < 3; axis++) {
+			for (int sign = 1; sign >= -1; sign -= 2) {
+				int translation[3] = { 0, 0, 0 };
+				translation[axis] = sign * config.perturbationTranslation;
+				addPerturbation("translation_" + axes[axis] + to_string(translation[axis]), 0, translation[0], translation[1], translation[2], -1);
+			}
+		}
+	}
+	for (int contourNr = 0; contourNr < config.nrRandomContours; contourNr++) {
+		addPerturbation("contour" + to_string(contourNr + 1), 0, 0, 0, 0, contourNr);
+	}
+}
+
+/*!
+\brief getMargin
+The function getMargin returns the number of voxels that the perturbed masks can be larger than the base mask in every direction.
+*/
+int MaskPerturbation::getMargin() const {
+	int margin = 0;
+	for (size_t i = 0; i < perturbations.size(); i++) {
+		margin = std::max(margin, perturbations[i].erosionDilation);
+		for (int axis = 0; axis < 3; axis++) {
+			margin = std::max(margin, std::abs(perturbations[i].translation[axis]));
+		}
+		if (perturbations[i].contourNr >= 0) {
+			margin = std::max(margin, 1);
+		}
+	}
+	return margin;
+}
+
+/*!
+\brief getPerturbationRegion
+The function getPerturbationRegion enlarges the bounding box of the base mask by the margin of the perturbations. \n
+Image and masks are cut to this region, so that all masks have the same grid.
+@param[in] boundingBox: bounding box of the base mask
+@param[in] imageRegion: region of the image, the enlarged region is cropped to it
+@param[out] RegionType: region of the perturbed masks
+*/
+RegionType MaskPerturbation::getPerturbationRegion(const RegionType &boundingBox, const RegionType &imageRegion) const {
+	RegionType region = boundingBox;
+	region.PadByRadius(getMargin());
+	region.Crop(imageRegion);
+	return region;
+}
+
+size_t MaskPerturbation::getNrPerturbations() const {
+	return perturbations.size();
+}
+
+string MaskPerturbation::getName(size_t perturbationNr) const {
+	return perturbations[perturbationNr].name;
+}
+
+/*!
+\brief getPerturbedMask
+The function getPerturbedMask creates one perturbed mask from the base mask.
+@param[in] mask: binary base mask (cut to the region of getPerturbationRegion)
+@param[in] perturbationNr: number of the perturbation
+@param[out] nrVoxels: number of voxels of the perturbed mask
+@param[out] ImageType: binary perturbed mask with the grid of the base mask
+*/
+ImageType::Pointer MaskPerturbation::getPerturbedMask(ImageType *mask, size_t perturbationNr, int &nrVoxels) const {
+	const Perturbation &perturbation = perturbations[perturbationNr];
+	const ImageType::SizeType &maskSize = mask->GetBufferedRegion().GetSize();
+	int size[3] = { int(maskSize[0]), int(maskSize[1]), int(maskSize[2]) };
+	const float *maskValues = mask->GetBufferPointer();
+	vector<unsigned char> values(size_t(size[0]) * size[1] * size[2]);
+	for (size_t i = 0; i < values.size(); i++) {
+		values[i] = maskValues[i] > 0 ? 1 : 0;
+	}
+	for (int step = 0; step < std::abs(perturbation.erosionDilation); step++) {
+		erodeDilate(values, size, perturbation.erosionDilation > 0);
+	}
+	translate(values, size, perturbation.translation);
+	if (perturbation.contourNr >= 0) {
+		randomizeContour(values, size, perturbation.contourNr);
+	}
+
+	FilterType::Pointer filter = FilterType::New();
+	filter->SetRegionOfInterest(mask->GetBufferedRegion());
+	filter->SetInput(mask);
+	filter->Update();
+	ImageType::Pointer perturbedMask = filter->GetOutput();
+	perturbedMask->DisconnectPipeline();
+	float *perturbedValues = perturbedMask->GetBufferPointer();
+	nrVoxels = 0;
+	for (size_t i = 0; i < values.size(); i++) {
+		perturbedValues[i] = values[i];
+		nrVoxels += values[i];
+	}
+	return perturbedMask;
+}
+
+//erosion or dilation by one voxel, a voxel outside of the region counts as voxel outside of the mask
+void MaskPerturbation::erodeDilate(vector<unsigned char> &values, const int(&size)[3], bool dilate) const {
+	const int neighbours[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+	vector<unsigned char> original = values;
+	size_t index = 0;
+	for (int z = 0; z < size[2]; z++) {
+		for (int y = 0; y < size[1]; y++) {
+			for (int x = 0; x < size[0]; x++, index++) {
+				//dilation adds voxels with a neighbour inside the mask, erosion removes voxels with a neighbour outside of the mask
+				if (original[index] == (dilate ? 1 : 0)) {
+					continue;
+				}
+				for (int i = 0; i < 6; i++) {
+					int position[3] = { x + neighbours[i][0], y + neighbours[i][1], z + neighbours[i][2] };
+					bool inside = position[0] >= 0 && position[0] < size[0] && position[1] >= 0 && position[1] < size[1]
+						&& position[2] >= 0 && position[2] < size[2]
+						&& original[(size_t(position[2]) * size[1] + position[1]) * size[0] + position[0]] == 1;
+					if (inside == dilate) {
+						values[index] = dilate ? 1 : 0;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+//translation of the mask, voxels that are moved out of the region are lost
+void MaskPerturbation::translate(vector<unsigned char> &values, const int(&size)[3], const int(&translation)[3]) const {
+	if (translation[0] == 0 && translation[1] == 0 && translation[2] == 0) {
+		return;
+	}
+	vector<unsigned char> original(values.size(), 0);
+	original.swap(values);
+	size_t index = 0;
+	for (int z = 0; z < size[2]; z++) {
+		for (int y = 0; y < size[1]; y++) {
+			for (int x = 0; x < size[0]; x++, index++) {
+				int position[3] = { x + translation[0], y + translation[1], z + translation[2] };
+				if (original[index] == 1 && position[0] >= 0 && position[0] < size[0] && position[1] >= 0 && position[1] < size[1]
+					&& position[2] >= 0 && position[2] < size[2]) {
+					values[(size_t(position[2]) * size[1] + position[1]) * size[0] + position[0]] = 1;
+				}
+			}
+		}
+	}
+}
+
+//every voxel with a face neighbour on the other side of the contour is changed with the probability contourProbability
+void MaskPerturbation::randomizeContour(vector<unsigned char> &values, const int(&size)[3], int contourNr) const {
+	const int neighbours[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+	std::mt19937 generator(randomSeed + unsigned(contourNr));
+	std::bernoulli_distribution change(contourProbability);
+	vector<unsigned char> original = values;
+	size_t index = 0;
+	for (int z = 0; z < size[2]; z++) {
+		for (int y = 0; y < size[1]; y++) {
+			for (int x = 0; x < size[0]; x++, index++) {
+				bool onContour = false;
+				for (int i = 0; i < 6 && !onContour; i++) {
+					int position[3] = { x + neighbours[i][0], y + neighbours[i][1], z + neighbours[i][2] };
+					if (position[0] >= 0 && position[0] < size[0] && position[1] >= 0 && position[1] < size[1] && position[2] >= 0 && position[2] < size[2]) {
+						onContour = original[(size_t(position[2]) * size[1] + position[1]) * size[0] + position[0]] != original[index];
+					}
+				}
+				if (onContour && change(generator)) {
+					values[index] = 1 - original[index];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#ifndef MASKPERTURBATION_H_INCLUDED
+#define MASKPERTURBATION_H_INCLUDED
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "itkTypes.h"
+#include "readConfigFile.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+/*!
+The class MaskPerturbation creates perturbed versions of a binary mask in memory, so that the robustness of the features against
+small changes of the segmentation can be calculated in one run (see calculatePerturbationFeatures): \n
+- erosion and dilation by a number of voxels (every voxel step uses the 6-neighbourhood) \n
+- translation by a number of voxels in positive and negative x, y and z direction \n
+- randomized contours: every voxel on the contour of the mask (inside or outside of the mask, with a face neighbour on the other side)
+is added to or removed from the mask with a given probability; the random numbers are seeded, so that the contours can be reproduced \n
+All perturbed masks have the grid of the base mask. The region of the base mask has to be enlarged by getMargin voxels, so that
+dilated and translated masks are not cut.
+*/
+class MaskPerturbation {
+private:
+	//one perturbed mask: erosion (negative) or dilation (positive), translation or number of the random contour
+	struct Perturbation {
+		string name;
+		int erosionDilation;
+		int translation[3];
+		int contourNr;
+	};
+	vector<Perturbation> perturbations;
+	float contourProbability;
+	unsigned int randomSeed;
+
+	void addPerturbation(const string &name, int erosionDilation, int translationX, int translationY, int translationZ, int contourNr);
+	void erodeDilate(vector<unsigned char> &values, const int(&size)[3], bool dilate) const;
+	void translate(vector<unsigned char> &values, const int(&size)[3], const int(&translation)[3]) const;
+	void randomizeContour(vector<unsigned char> &values, const int(&size)[3], int contourNr) const;
+
+public:
+	MaskPerturbation() : contourProbability(0.5), randomSeed(1) {
+	}
+	~MaskPerturbation() {
+	}
+	void configure(const ConfigFile &config);
+	int getMargin() const;
+	RegionType getPerturbationRegion(const RegionType &boundingBox, const RegionType &imageRegion) const;
+	size_t getNrPerturbations() const;
+	string getName(size_t perturbationNr) const;
+	ImageType::Pointer getPerturbedMask(ImageType *mask, size_t perturbationNr, int &nrVoxels) const;
+};
+
+#include "maskPerturbation.cpp"
+
+#endif // MASKPERTURBATION_H_INCLUDED
@@ -1,6 +1,6 @@
 #include "matrixFunctions.h"
 
-void matrixSum(boost::multi_array<float, 2> &matrix1, boost::multi_array<float, 2> matrix2){
+void matrixSum(boost::multi_array<float, 2> &matrix1, const boost::multi_array<float, 2> &matrix2){
     for(int i = 0; i<matrix1.shape()[0]; i++){
         for(int j = 0; j<matrix1.shape()[1]; j++){
                 matrix1[i][j]+=matrix2[i][j];
@@ -8,7 +8,7 @@ void matrixSum(boost::multi_array<float, 2> &matrix1, boost::multi_array<float,
     }
 }
 
-void inverse(boost::multi_array<float, 2> matrix, boost::multi_array<float, 2> &inverseMatrix){
+void inverse(const boost::multi_array<float, 2> &matrix, boost::multi_array<float, 2> &inverseMatrix){
     for(int i = 0; i<matrix.shape()[0]; i++){
         for(int j = 0; j<matrix.shape()[1]; j++){
             inverseMatrix[j][i]=matrix[i][j];
@@ -24,7 +24,16 @@ void multSkalarMatrix(boost::multi_array<float, 2> &matrix, float weight){
     }
 }
 
-float calculateWeight2D(int directionX, int directionY, string norm, vector<float> spacing){
+//copies the first columns of matrix to smallMatrix, the number of columns is given by smallMatrix
+void copyColumns(const boost::multi_array<float, 2> &matrix, boost::multi_array<float, 2> &smallMatrix){
+    for(int i = 0; i<smallMatrix.shape()[0]; i++){
+        for(int j = 0; j<smallMatrix.shape()[1]; j++){
+            smallMatrix[i][j]=matrix[i][j];
+        }
+    }
+}
+
+float calculateWeight2D(int directionX, int directionY, string norm, const vector<float> &spacing){
 	float weight;
     if(!norm.compare("Manhattan") || !norm.compare("manhattan")){
         weight = calculateManhattanNorm2D(directionX, directionY, spacing);
@@ -42,7 +51,7 @@ float calculateWeight2D(int directionX, int directionY, string norm, vector<floa
      return weight;
 }
 
-float calculateWeight3D(int directionX, int directionY, int directionZ, string norm, vector<float> spacing) {
+float calculateWeight3D(int directionX, int directionY, int directionZ, string norm, const vector<float> &spacing) {
 	float weight;
 	if (!norm.compare("Manhattan") || !norm.compare("manhattan")) {
 		weight = calculateManhattanNorm3D(directionX, directionY, directionZ, spacing);
@@ -59,3 +68,23 @@ float calculateWeight3D(int directionX, int directionY, int directionZ, string n
 	}
 	return weight;
 }
+
+
+/*!
+In the function getSliceCopy one slice of a 3D matrix is copied into a 2D matrix. \n
+It is used as scratch buffer by functions that have to mark already visited elements, so that
+the matrix of the VOI itself can be passed as const reference.
+@param[in] inputMatrix: the matrix of the VOI
+@param[in] depth: number of the slice
+@param[out] 2D matrix containing the values of the slice
+*/
+template <class T>
+boost::multi_array<T, 2> getSliceCopy(const boost::multi_array<T, 3> &inputMatrix, int depth) {
+	boost::multi_array<T, 2> slice(boost::extents[inputMatrix.shape()[0]][inputMatrix.shape()[1]]);
+	for (int row = 0; row < inputMatrix.shape()[0]; row++) {
+		for (int col = 0; col < inputMatrix.shape()[1]; col++) {
+			slice[row][col] = inputMatrix[row][col][depth];
+		}
+	}
+	return slice;
+}
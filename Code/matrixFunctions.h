@@ -6,15 +6,20 @@
 #include "boost/multi_array.hpp"
 #include "math.h"
 #include "distanceWeights.h"
+#include "matrixPool.h"
+#include "textureMatrixStore.h"
 using namespace std;
 typedef boost::multi_array<float,2> mat;
 
 
-void matrixSum(boost::multi_array<float, 2> &matrix1, boost::multi_array<float, 2> matrix2);
-void inverse(boost::multi_array<float, 2> matrix, boost::multi_array<float, 2> &inverseMatrix);
+void matrixSum(boost::multi_array<float, 2> &matrix1, const boost::multi_array<float, 2> &matrix2);
+void inverse(const boost::multi_array<float, 2> &matrix, boost::multi_array<float, 2> &inverseMatrix);
 void multSkalarMatrix(boost::multi_array<float, 2> &matrix, float weight);
-float calculateWeight2D(int directionX, int directionY, string norm, vector<float> spacing);
-float calculateWeight3D(int directionX, int directionY, int directionZ, string norm, vector<float> spacing);
+void copyColumns(const boost::multi_array<float, 2> &matrix, boost::multi_array<float, 2> &smallMatrix);
+float calculateWeight2D(int directionX, int directionY, string norm, const vector<float> &spacing);
+float calculateWeight3D(int directionX, int directionY, int directionZ, string norm, const vector<float> &spacing);
+template <class T>
+boost::multi_array<T, 2> getSliceCopy(const boost::multi_array<T, 3> &inputMatrix, int depth);
 //#ifdef _WIN32
 #include "matrixFunctions.cpp"
 //#endif // _WIN32
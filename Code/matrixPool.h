@@ -0,0 +1,152 @@
+#ifndef MATRIXPOOL_H_INCLUDED
+#define MATRIXPOOL_H_INCLUDED
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "boost/multi_array.hpp"
+using namespace std;
+
+/*! \file */
+
+/*!
+The class MatrixPool keeps the 2D matrices that are used as scratch buffers in the texture feature calculations
+(GLCM, GLRLM, GLSZM, ...). \n
+The texture classes need for every slice and every direction matrices of the same size. Instead of allocating and freeing
+these matrices again and again, they are taken from the pool and given back after use. A matrix that is given back is kept
+and handed out again (set to 0) the next time a matrix of the same size is requested. \n
+GLCM, GLRLM, GLSZM, GLDZM, NGTDM and NGLDM take the matrices of one slice or direction, the merged matrices and the probability
+matrices from the pool; the functions that calculate these matrices therefore fill a matrix that is given as reference instead of
+returning a new one. The matrices are held by a ScratchMatrix, which gives its matrix back at the end of its scope (e.g. at the end
+of one iteration of the slice or direction loop). \n
+Every thread has its own pool (casePool), so no locking is necessary. The pool is emptied with reset() when the calculation
+of one case (image + mask) is finished, so that the memory of a big VOI is not kept for the following cases.
+*/
+template <class T>
+class MatrixPool {
+private:
+	typedef boost::multi_array<T, 2> matrix;
+	typedef std::pair<size_t, size_t> matrixShape;
+
+	//all matrices that were allocated by the pool, the pool is the owner
+	vector<std::unique_ptr<matrix> > buffers;
+	//matrices that are not in use at the moment, sorted by their size
+	std::map<matrixShape, vector<matrix*> > freeMatrices;
+	int nrLeasedMatrices;
+
+public:
+	MatrixPool() : nrLeasedMatrices(0) {
+	}
+	~MatrixPool() {
+	}
+	MatrixPool(const MatrixPool &) = delete;
+	MatrixPool &operator=(const MatrixPool &) = delete;
+
+	static MatrixPool<T> &casePool();
+	matrix *acquire(size_t rows, size_t cols);
+	void release(matrix *buffer);
+	void reset();
+	size_t getNrBuffers() const;
+};
+
+/*!
+\brief casePool
+The function casePool returns the pool of the actual thread. \n
+All texture matrices of one case are taken from this pool.
+*/
+template <class T>
+MatrixPool<T> &MatrixPool<T>::casePool() {
+	static thread_local MatrixPool<T> pool;
+	return pool;
+}
+
+/*!
+\brief acquire
+The function acquire returns a matrix of size rows x cols in which all elements are set to 0. \n
+If a matrix of this size was given back before, it is reused, otherwise a new matrix is allocated.
+@param[in] size_t rows: number of rows
+@param[in] size_t cols: number of columns
+@param[out] pointer to the matrix, it has to be given back with release
+*/
+template <class T>
+boost::multi_array<T, 2> *MatrixPool<T>::acquire(size_t rows, size_t cols) {
+	matrix *buffer;
+	vector<matrix*> &freeList = freeMatrices[matrixShape(rows, cols)];
+	if (!freeList.empty()) {
+		buffer = freeList.back();
+		freeList.pop_back();
+		std::fill(buffer->origin(), buffer->origin() + buffer->num_elements(), T(0));
+	}
+	else {
+		buffers.push_back(std::unique_ptr<matrix>(new matrix(boost::extents[rows][cols])));
+		buffer = buffers.back().get();
+	}
+	nrLeasedMatrices += 1;
+	return buffer;
+}
+
+/*!
+\brief release
+The function release gives a matrix back to the pool, so that it can be used again.
+@param[in] matrix *buffer: matrix that was returned by acquire
+*/
+template <class T>
+void MatrixPool<T>::release(matrix *buffer) {
+	freeMatrices[matrixShape(buffer->shape()[0], buffer->shape()[1])].push_back(buffer);
+	nrLeasedMatrices -= 1;
+}
+
+/*!
+\brief reset
+The function reset frees all matrices of the pool. \n
+It is called when the calculation of one case is finished.
+*/
+template <class T>
+void MatrixPool<T>::reset() {
+	if (nrLeasedMatrices != 0) {
+		std::cout << "Warning: the matrix pool can not be emptied, " << nrLeasedMatrices << " matrices are still in use" << std::endl;
+		return;
+	}
+	freeMatrices.clear();
+	buffers.clear();
+}
+
+template <class T>
+size_t MatrixPool<T>::getNrBuffers() const {
+	return buffers.size();
+}
+
+
+/*!
+The class ScratchMatrix takes a matrix from the pool of the actual thread and gives it back
+when it goes out of scope. \n
+The matrix itself is accessed with get():
+\code
+ScratchMatrix<float> GLCMatrixBuffer(sizeMatrix, sizeMatrix);
+boost::multi_array<float, 2> &GLCMatrix = GLCMatrixBuffer.get();
+\endcode
+*/
+template <class T>
+class ScratchMatrix {
+private:
+	MatrixPool<T> &pool;
+	boost::multi_array<T, 2> *buffer;
+
+public:
+	ScratchMatrix(size_t rows, size_t cols, MatrixPool<T> &matrixPool = MatrixPool<T>::casePool())
+		: pool(matrixPool), buffer(matrixPool.acquire(rows, cols)) {
+	}
+	~ScratchMatrix() {
+		pool.release(buffer);
+	}
+	ScratchMatrix(const ScratchMatrix &) = delete;
+	ScratchMatrix &operator=(const ScratchMatrix &) = delete;
+
+	boost::multi_array<T, 2> &get() {
+		return *buffer;
+	}
+};
+
+#endif // MATRIXPOOL_H_INCLUDED
@@ -15,19 +15,12 @@
 #include <vector>
 #include <exception>
 #include "itkTetrahedronCell.h"
-#ifdef _WIN32
-#else
-#include "itkVTKPolyDataReader.h"
-#endif
-#include "itkMesh.h"
-#include "itkBinaryMask3DMeshSource.h"
 #include "itkBinaryThresholdImageFilter.h"
 
 #include "itkSimplexMesh.h"
 #include "itkSimplexMeshVolumeCalculator.h"
 #include "itkTriangleMeshToSimplexMeshFilter.h"
 
-#include "itkLabelImageToShapeLabelMapFilter.h"
 #include "itkConnectedComponentImageFilter.h"
 #include "itkBinaryFillholeImageFilter.h"
 #include "itkImageMaskSpatialObject.h"
@@ -35,6 +28,9 @@
 #include "itkCastImageFilter.h"
 
 #include "image.h"
+#include "marchingCubes.h"
+#include "convexHull.h"
+#include "lesionLabels.h"
 #include "itkTypes.h"
 #include "readImages.h"
 #include "itkChangeInformationImageFilter.h"
@@ -49,29 +45,8 @@ private:
 
 	ImageType::Pointer image;
 	ImageType::Pointer mask;
-	typedef itk::DefaultStaticMeshTraits<float, 3, 3, float, float, float> MeshTrait;
-	int actNrPixels = 0;
-	//in order to calculate the surface we have to convert our mask in a mesh
-	typedef itk::Mesh<float, 3, MeshTrait> MeshType;
-	typedef itk::BinaryMask3DMeshSource<ImageType, MeshType> MeshSourceType;
-	typedef unsigned char PixelType;
-	//to calculate the surface we have to iterate over all cells of the mesh
-	typedef MeshType::CellType CellType;
-	typedef MeshType::CellsContainer::ConstIterator Celliterator;
-
-#ifdef _WIN32
-#else
-	//to get the coordinates of the points of our mesh, we need a VTKPolyDataReader
-	typedef itk::VTKPolyDataReader< MeshType > ReaderTypeVTK;
-	typedef ReaderTypeVTK::PointType PointType;
-#endif
-	//in order to calculate volume and flatness etc we need a shape label object
-	typedef itk::ConnectedComponentImageFilter <intImage, intImage> ConnectedComponentFilterType;
-
-	typedef itk::LabelImageToShapeLabelMapFilter<intImage> LabelImageToShapeLabelMapFilterType;
-	typedef int LabelType;
-	typedef itk::ShapeLabelObject<LabelType, R> ShapeLabelObjectType;
-	typedef itk::LabelMap<ShapeLabelObjectType> LabelMapType;
+	//only connected components with more voxels are included in surface and mesh volume
+	static const int minNrVoxelsMesh = 20;
 	typedef boost::accumulators::features <tag::mean> Features;
 	typedef accumulator_set <T, Features> Accumulator;
 	//the attributes of the class are the radiomics features
@@ -108,18 +83,18 @@ private:
 	float volDensityAABB = NAN;
 	float areaDensityAABB = NAN;
 
+	float volDensityConvexHull = NAN;
+	float areaDensityConvexHull = NAN;
+
 	float volDensityMEE = NAN;
 	float areaDensityMEE = NAN;
 
-	vector<vector<float> > vec;
-	vector<float> coordinates;
 	itk::Vector< float, 3> principalMoments;
 	typename ImageType::PointType origin;
 
 	float imageSpacingX;
 	float imageSpacingY;
 	float imageSpacingZ;
-	float calculateSurface(vector<vector<float> > vec);
 
 	//two help functions that are needed in order to calculate some of the features
 	//calculate the euclidean distance
@@ -131,11 +106,12 @@ private:
 	ImageType::Pointer subsampleImage(ImageType::Pointer image, float factor);
 
 	//get all features that can be calculated by using the itk::label object
-	void getLabelObjectFeatures(ImageType::Pointer mask);
+	void getLabelObjectFeatures(const LesionLabels &lesions, const ConfigFile &config);
 
 	void getBoundingBoxValues(ImageType::Pointer mask);
 	void calculateVADensity(float &volDensity, float &areaDensity, itk::Size<R> regionSize);
-	void calculateApproximateVolume(boost::multi_array<T, R> inputMatrix, vector<T> vectorOfMatrElements);
+	void calculateVADensity(float &volDensity, float &areaDensity, const double(&boxSize)[3]);
+	void calculateApproximateVolume(const boost::multi_array<T, R> &inputMatrix, const vector<T> &vectorOfMatrElements);
 	void calculateSurface2Volume();
 	void calculateCompactness1();
 	void calculateCompactness2();
@@ -151,9 +127,9 @@ private:
 	void calculateFlatness();
 	//calculate MoransI calculates MoransI, GearysC and the maximum 3D diameter (because all these features need to
 	//do two for loops)
-	void calculateMoransI(boost::multi_array<T, R> inputMatrix);
-	void calculateIntegratedIntensity(vector<T> vectorOfMatrixElements);
-	void calculateCentreOfMassShift(boost::multi_array<T, R> inputMatrix, vector<T> vectorOfMatrElements);
+	void calculateMoransI(const boost::multi_array<T, R> &inputMatrix);
+	void calculateIntegratedIntensity(const vector<T> &vectorOfMatrixElements);
+	void calculateCentreOfMassShift(const boost::multi_array<T, R> &inputMatrix, const vector<T> &vectorOfMatrElements);
 	int binomialCoefficient(int n, int k);
 	float legendrePolynom(float x, int exponent);
 	void calculateVolDensityAEE();
@@ -163,11 +139,9 @@ private:
 	void calculateAreaDensityMEE();
 
 	ImageType::Pointer changeMaskSpacingToImageSpacing(ImageType::Pointer image, ImageType::Pointer mask);
-	ImageType::Pointer thresholdMask(ImageType::Pointer mask, ConfigFile config);
-	void defineMorphologicalFeatures(vector<string> &features);
-	void extractMorphologicalData(vector<T> &morphData, MorphologicalFeatures<T, R> morphFeatures);
-	float getSurface(ImageType::Pointer mask);
-	ImageType::Pointer labelMaskImage(ImageType::Pointer mask, ImageType::Pointer labeledMask, int labelNr);
+	void defineMorphologicalFeatures(vector<string> &features, const ConfigFile &config);
+	void extractMorphologicalData(vector<T> &morphData, MorphologicalFeatures<T, R> morphFeatures, const ConfigFile &config);
+	float getSurface(const LesionLabels &lesions, const ConfigFile &config);
 public:
 	//constructor
 	MorphologicalFeatures() {
@@ -179,10 +153,10 @@ public:
 	vector<T> voxVolumeROI;
 	const float pi = 3.141592653589793238463;
 	boost::multi_array<vector<T>, R> coordinatesMatrix;
-	void defineMorphologicalFeaturesOntology(vector<string> &features);
-	void calculateAllMorphologicalFeatures(MorphologicalFeatures<T, R> &morphFeatures, Image<float, 3> imageAttr, ConfigFile config);
-	void writeCSVFileMorphological(MorphologicalFeatures<T, R> morph, string outputFolder, ConfigFile config);
-	void writeOneFileMorphological(MorphologicalFeatures<T, R> morph, ConfigFile config);
+	void defineMorphologicalFeaturesOntology(vector<string> &features, const ConfigFile &config);
+	void calculateAllMorphologicalFeatures(MorphologicalFeatures<T, R> &morphFeatures, const Image<float, 3> &imageAttr, const LesionLabels &lesions, const ConfigFile &config);
+	void writeCSVFileMorphological(MorphologicalFeatures<T, R> morph, string outputFolder, const ConfigFile &config);
+	void writeOneFileMorphological(MorphologicalFeatures<T, R> morph, const ConfigFile &config);
 	
 
 };
@@ -263,58 +237,75 @@ ImageType::Pointer MorphologicalFeatures<T, R>::subsampleImage(ImageType::Pointe
 }
 
 /*!
-In the function getLabelObjectFeatures a set of morphological features is calculated using
-the label image to shape label map filter
+In the function getLabelObjectFeatures a set of morphological features is calculated from the statistics table
+of the labeled mask. \n
+The maximum diameter is the sum of the Feret diameters of the lesions (largest distance of two voxel centres of a lesion),
+which is calculated from the convex hull of the voxel centres of every lesion. \n
+If ConvexHullFeatures is set in the config, the maximum diameter is instead the largest distance of two vertices of the mesh of
+the whole VOI, and the densities of the (approximate) minimum volume bounding box and of the convex hull are calculated from the
+convex hull of the marching cubes vertices of all lesions.
 */
 template<class T, size_t R>
-void MorphologicalFeatures<T, R>::getLabelObjectFeatures(ImageType::Pointer mask) {
-	
-	//With the cast filter type function, the mask is converted to an int-image
-	//because otherwise the Label image to shape label map filter is not working
-	typename CastFilterType::Pointer castFilter = CastFilterType::New();
-	castFilter->SetInput(mask);
-
-	//With the ConnectedComponentFilter from the itk library the connected components of the mask are calculated
-	typename ConnectedComponentFilterType::Pointer connectedComponentImageFilter = ConnectedComponentFilterType::New();
-	connectedComponentImageFilter->SetInput(castFilter->GetOutput());
-	connectedComponentImageFilter->Update();
-
-	//With the label image to shape label map filter the mask is converted to a labeled image
-	typename LabelImageToShapeLabelMapFilterType::Pointer labelImageToShapeLabelMapFilter = LabelImageToShapeLabelMapFilterType::New();
-	labelImageToShapeLabelMapFilter->SetComputeOrientedBoundingBox(true);
-	labelImageToShapeLabelMapFilter->SetComputeFeretDiameter(true);
-	labelImageToShapeLabelMapFilter->SetInput(connectedComponentImageFilter->GetOutput());
-	labelImageToShapeLabelMapFilter->SetComputePerimeter(true);
-	labelImageToShapeLabelMapFilter->Update();
-	LabelMapType *labelMap = labelImageToShapeLabelMapFilter->GetOutput();
-	//For every connected component a labelObject is created
-	//Because we are only interested in the object with the label one, we check the label number
-
+void MorphologicalFeatures<T, R>::getLabelObjectFeatures(const LesionLabels &lesions, const ConfigFile &config) {
 	nrPixels = 0;
-	maximumDiameter = 0;
-	for (unsigned int n = 0; n < labelMap->GetNumberOfLabelObjects(); n++) {
-		ShapeLabelObjectType *labelObject = labelMap->GetNthLabelObject(n);
-		int labelNr = labelObject->GetLabel();
-		//if (labelNr >0) {
+	const vector<LabelStatistics> &statistics = lesions.getStatistics();
+	for (int n = 0; n < lesions.getNrLabels(); n++) {
+		const LabelStatistics &lesion = statistics[n];
+		itk::Vector<float, 3> lesionMoments;
+		for (int i = 0; i < 3; i++) {
+			lesionMoments[i] = float(lesion.principalMoments[i]);
+		}
 #ifdef _WIN32
-			maximumDiameter += labelObject->GetFeretDiameter();
-			if (labelNr == 0) {
-				principalMoments = labelObject->GetPrincipalMoments();
-			}
-			else {
-				principalMoments += labelObject->GetPrincipalMoments();
-			}
-			nrPixels += labelObject->GetNumberOfPixels();
-			const itk::Vector<float, R> bbSize = labelObject->GetOrientedBoundingBoxSize();
-			itk::Size<R> bbSizeITK = { { bbSize[0], bbSize[1], bbSize[2] } };
-			calculateVADensity(volDensityOMBB, areaDensityOMBB, bbSizeITK);
+		if (n == 0) {
+			principalMoments = lesionMoments;
+		}
+		else {
+			principalMoments += lesionMoments;
+		}
+		nrPixels += lesion.nrVoxels;
 #else
-			volume += labelObject->GetPhysicalSize();
+		volume += lesion.nrVoxels * imageSpacingX * imageSpacingY * imageSpacingZ;
 
-			principalMoments = labelObject->GetPrincipalMoments();
-			nrPixels += labelObject->GetNumberOfPixels();
+		principalMoments = lesionMoments;
+		nrPixels += lesion.nrVoxels;
 #endif
+	}
 
+	intImage *labeledMask = lesions.getLabelImage();
+	const typename intImage::RegionType& maskRegion = labeledMask->GetLargestPossibleRegion();
+	const typename intImage::SizeType& maskSize = maskRegion.GetSize();
+	const typename intImage::SpacingType& maskSpacing = labeledMask->GetSpacing();
+	int size[3] = { int(maskSize[0]), int(maskSize[1]), int(maskSize[2]) };
+	double spacing[3] = { maskSpacing[0], maskSpacing[1], maskSpacing[2] };
+	if (config.convexHullFeatures == 1) {
+		vector<double> hullCandidates;
+		getHullCandidates(labeledMask->GetBufferPointer(), size, spacing, hullCandidates);
+		ConvexHull convexHull;
+		bool hasVolume = convexHull.calculate(hullCandidates);
+		maximumDiameter = convexHull.getMaximumDiameter();
+		double boxSize[3];
+		convexHull.getApproximateMinimumBoundingBox(boxSize);
+		calculateVADensity(volDensityOMBB, areaDensityOMBB, boxSize);
+		if (hasVolume) {
+			volDensityConvexHull = volume / convexHull.getVolume();
+			areaDensityConvexHull = surface / convexHull.getSurface();
+		}
+		return;
+	}
+	maximumDiameter = 0;
+	vector<double> voxelCandidates;
+	ConvexHull lesionHull;
+	for (int n = 0; n < lesions.getNrLabels(); n++) {
+		//the bounding box of the lesion is given in the index space of the label image
+		int first[3];
+		int last[3];
+		for (int i = 0; i < 3; i++) {
+			first[i] = int(statistics[n].boundingBox.GetIndex()[i] - maskRegion.GetIndex()[i]);
+			last[i] = first[i] + int(statistics[n].boundingBox.GetSize()[i]) - 1;
+		}
+		getVoxelCandidates(labeledMask->GetBufferPointer(), size, spacing, statistics[n].label, first, last, voxelCandidates);
+		lesionHull.calculate(voxelCandidates);
+		maximumDiameter += lesionHull.getMaximumDiameter();
 	}
 }
 
@@ -359,12 +350,21 @@ void MorphologicalFeatures<T, R>::calculateVADensity(float &volDensity, float &a
 	areaDensity = surface/ areaDensity;
 }
 
+/*!
+In the function calculateVADensity the volume and the area density of a bounding box are calculated, given the side lengths of the box in mm.
+*/
+template<class T, size_t R>
+void MorphologicalFeatures<T, R>::calculateVADensity(float &volDensity, float &areaDensity, const double(&boxSize)[3]) {
+	volDensity = volume / (boxSize[0] * boxSize[1] * boxSize[2]);
+	areaDensity = surface / (2 * (boxSize[0] * boxSize[1] + boxSize[1] * boxSize[2] + boxSize[0] * boxSize[2]));
+}
+
 /*!
 To calculate the integrated intensity, we calculate the mean value of the VOI and mulitplicate
 the value by the volume
 */
 template<class T, size_t R>
-void MorphologicalFeatures<T, R>::calculateIntegratedIntensity(vector<T> vectorOfMatrixElements) {
+void MorphologicalFeatures<T, R>::calculateIntegratedIntensity(const vector<T> &vectorOfMatrixElements) {
 	
 	Accumulator acc;
 	for_each(vectorOfMatrixElements.begin(), vectorOfMatrixElements.end(), boost::bind<void>(boost::ref(acc), _1));
@@ -377,7 +377,7 @@ To calculate the volume, we count the voxels present in the image
 The amount of voxels is multiplied by the volume of one voxel
 */
 template <class T, size_t R>
-void MorphologicalFeatures<T, R>::calculateApproximateVolume(boost::multi_array<T, R> inputMatrix, vector<T> vectorOfMatrElement) {
+void MorphologicalFeatures<T, R>::calculateApproximateVolume(const boost::multi_array<T, R> &inputMatrix, const vector<T> &vectorOfMatrElement) {
 	int nrVoxels = 0;
 	for (int i = 0; i < inputMatrix.shape()[0]; i++) {
 		for (int j = 0; j < inputMatrix.shape()[1]; j++) {
@@ -469,7 +469,7 @@ In the function calculateCentreOfMassShift, the center of mass shift is calculat
 as input the original matrix and a vector containing the matrix elements
 */
 template <class T, size_t R>
-void MorphologicalFeatures<T, R>::calculateCentreOfMassShift(boost::multi_array<T, R> inputMatrix, vector<T> vectorOfMatrElements) {
+void MorphologicalFeatures<T, R>::calculateCentreOfMassShift(const boost::multi_array<T, R> &inputMatrix, const vector<T> &vectorOfMatrElements) {
 	//calculate the sum of all matrix elements
 	T sumMatrElement = accumulate(vectorOfMatrElements.begin(), vectorOfMatrElements.end(), 0);
 	vector<float> tempVector;
@@ -513,7 +513,7 @@ If the VOI is very big, the image is downsampled before this calculation to avoi
 Still, for big VOIs, the calculation of these two features can take some time.
 */
 template <class T, size_t R>
-void  MorphologicalFeatures<T, R>::calculateMoransI(boost::multi_array<T, R> inputMatrix) {
+void  MorphologicalFeatures<T, R>::calculateMoransI(const boost::multi_array<T, R> &inputMatrix) {
 	T actualElement;
 	int rowDiff;
 	int colDiff;
@@ -684,337 +684,58 @@ ImageType::Pointer MorphologicalFeatures<T, R>::changeMaskSpacingToImageSpacing(
 	return newMask;
 }
 
-template <class T, size_t R>
-ImageType::Pointer MorphologicalFeatures<T, R>::thresholdMask(ImageType::Pointer mask, ConfigFile config) {
-	itk::ImageRegionConstIterator<ImageType> countVoxels(mask, mask->GetLargestPossibleRegion());
-	
-	countVoxels.GoToBegin();
-	float maxValue = 0;
-	while (!countVoxels.IsAtEnd())
-	{   
-		if (countVoxels.Get() > maxValue)
-		{
-			maxValue = countVoxels.Get();
-		}
-		++countVoxels;
-	}
-	using FilterType = itk::BinaryThresholdImageFilter<ImageType, ImageType>;
-	
-	FilterType::Pointer filter = FilterType::New();
-	filter->SetInput(mask);
-	//filter->SetLowerThreshold(0);
-	filter->SetLowerThreshold((config.threshold)*maxValue);
-	filter->SetOutsideValue(0);
-	filter->SetInsideValue(1);
-	filter->Update();
-	ImageType::Pointer updatedMask =filter->GetOutput();
-	return updatedMask;
-
-
-}
-
-template<class T, size_t R>
-ImageType::Pointer MorphologicalFeatures<T, R>::labelMaskImage(ImageType::Pointer mask, ImageType::Pointer labeledMask, int labelNr) {
-	itk::ImageRegionIterator<ImageType> maskIt(mask, mask->GetLargestPossibleRegion());
-	itk::ImageRegionIterator<ImageType> labeledmaskIt(labeledMask, labeledMask->GetLargestPossibleRegion());
-
-	maskIt.GoToBegin();
-	labeledmaskIt.GoToBegin();
-	while (!maskIt.IsAtEnd())
-	{
-		if (labeledmaskIt.Get() == labelNr)
-		{
-			maskIt.Set(1);
-			actNrPixels++;
-		}
-		else {
-			maskIt.Set(0);
-		}
-
-		++maskIt;
-		++labeledmaskIt;
-	}
-	RegionType boundingBoxRegion = getBoundingBoxMask(mask);
-	itk::Size<3> regionSize = boundingBoxRegion.GetSize();
-	//shrink image and mask to the mask region
-	ImageType::Pointer testMask = getImageMasked(mask, boundingBoxRegion);
-	return testMask;
-}
-
+/*!
+In the function getSurface the surface and the volume of the mesh of the mask are calculated. \n
+The marching cubes algorithm runs over the label image of the lesions, so that all components are meshed in one pass.
+Only components with more than minNrVoxelsMesh voxels are included. \n
+The volume of the mesh is stored in the attribute volume.
+@param[in] LesionLabels lesions: label image and statistics of the connected components of the mask
+@param[in] ConfigFile config: if exportMesh is set, the mesh is written to an .obj file
+@param[out] float: surface of the mesh
+*/
 template<class T, size_t R>
-float MorphologicalFeatures<T, R>::getSurface(ImageType::Pointer mask) {
-	const typename ImageType::SpacingType& inputSpacing = mask->GetSpacing();
-
-	typename CastFilterType::Pointer castFilter = CastFilterType::New();
-	castFilter->SetInput(mask);
+float MorphologicalFeatures<T, R>::getSurface(const LesionLabels &lesions, const ConfigFile &config) {
+	intImage *labeledMask = lesions.getLabelImage();
+	const typename intImage::SpacingType& inputSpacing = labeledMask->GetSpacing();
+	int nrLabels = lesions.getNrLabels();
+	const typename intImage::SizeType& maskSize = labeledMask->GetLargestPossibleRegion().GetSize();
+	int size[3] = { int(maskSize[0]), int(maskSize[1]), int(maskSize[2]) };
+	double spacing[3] = { inputSpacing[0], inputSpacing[1], inputSpacing[2] };
+	const int *labelBuffer = labeledMask->GetBufferPointer();
+	const vector<LabelStatistics> &statistics = lesions.getStatistics();
+
+	MarchingCubes<int> marchingCubes(labelBuffer, size, spacing, nrLabels, config.exportMesh == 1);
+	marchingCubes.calculate();
 	volume = 0;
 	float totalSurface = 0;
-	
-	typename ConnectedComponentFilterType::Pointer connectedComponentImageFilter = ConnectedComponentFilterType::New();
-	connectedComponentImageFilter->SetFullyConnected(true);
-	connectedComponentImageFilter->SetInput(castFilter->GetOutput());
-	connectedComponentImageFilter->Update();
-
-	//With the label image to shape label map filter the mask is converted to a labeled image
-	typename LabelImageToShapeLabelMapFilterType::Pointer labelImageToShapeLabelMapFilter = LabelImageToShapeLabelMapFilterType::New();
-	labelImageToShapeLabelMapFilter->SetInput(connectedComponentImageFilter->GetOutput());
-	labelImageToShapeLabelMapFilter->Update();
-	LabelMapType *labelMap = labelImageToShapeLabelMapFilter->GetOutput();
-
-	using LabelMapToLabelImageFilterType = itk::LabelMapToLabelImageFilter<LabelMapType, ImageType>;
-	LabelMapToLabelImageFilterType::Pointer labelImageConverter = LabelMapToLabelImageFilterType::New();
-	labelImageConverter->SetInput(labelMap);
-	labelImageConverter->Update();
-	ImageType::Pointer labeledMask = labelImageConverter->GetOutput();
-	using DuplicatorType = itk::ImageDuplicator<ImageType>;
-	DuplicatorType::Pointer duplicator = DuplicatorType::New();
-	duplicator->SetInputImage(mask);
-	duplicator->Update();
-
-	ImageType::Pointer tmpMask = duplicator->GetOutput();
-	typename MeshSourceType::Pointer meshSource = MeshSourceType::New();
-	//For every connected component a labelObject is created
-	for (unsigned int n = 0; n < labelMap->GetNumberOfLabelObjects(); n++) {
-		ShapeLabelObjectType *labelObject = labelMap->GetNthLabelObject(n);
-		actNrPixels = 0;
-		
-		ImageType::Pointer testMask = labelMaskImage(tmpMask, labeledMask, n);
-		if (actNrPixels > 20) {
-			const PixelType objectValue = static_cast<PixelType>(1);
-			meshSource->SetObjectValue(objectValue);
-			meshSource->SetInput(testMask);
-
-
-			try {
-				meshSource->Update();
-
-			}
-			catch (itk::ExceptionObject &exp) {
-				std::cerr << "Exception throwing during update()" << std::endl;
-			}
-
-			//ensure that all cells are triangles (I do not think that is really necessary, maybe
-			//it can be deleted in another version
-			for (MeshType::CellsContainerIterator it = meshSource->GetOutput()->GetCells()->Begin();
-				it != meshSource->GetOutput()->GetCells()->End(); ++it) {
-				MeshType::CellAutoPointer cell;
-				meshSource->GetOutput()->GetCell(it->Index(), cell);
-				if (3 != cell->GetNumberOfPoints()) {
-					std::cerr << "ERROR: All cells must be trianglar." << std::endl;
-				}
-			}
-			//to calculate the surface, we have to iterate over all cells of our mesh
-			Celliterator cellIterator = meshSource->GetOutput()->GetCells()->Begin();
-			Celliterator cellEnd = meshSource->GetOutput()->GetCells()->End();
-
-			//to really get the coordinates of the points of the cell, we need a polyDataReader
-			//iterate over all cells and store the indices of the points in a vector
-			//this vector is used later to calculate the surface of each cell
-#ifdef _WIN32
-
-			MeshType::PointType pointOnMesh;
-			bool pointExists;
-			float testtest = 0;
-			while (cellIterator != cellEnd) {
-				CellType *cell = cellIterator.Value();
-				typedef CellType::PointIdIterator PointIdIterator;
-				PointIdIterator pointIdIter = cell->PointIdsBegin();
-				PointIdIterator pointIdend = cell->PointIdsEnd();
-				//testtest = cell->IsExplicitBoundary();
-				while (pointIdIter != pointIdend) {
-
-					pointExists = meshSource->GetOutput()->GetPoint(*pointIdIter, &pointOnMesh);
-					if (pointExists) {
-
-						coordinates.push_back(pointOnMesh[0] - mask->GetOrigin()[0]);
-						coordinates.push_back(pointOnMesh[1] - mask->GetOrigin()[1]);
-						coordinates.push_back(pointOnMesh[2] - mask->GetOrigin()[2]);
-						vec.push_back(coordinates);
-						coordinates.clear();
-					}
-					++pointIdIter;
-				}
-				++cellIterator;
-			}
-			totalSurface += calculateSurface(vec);
-			vec.clear();
-		}
-#else
-		ReaderTypeVTK::Pointer polyDataReader = ReaderTypeVTK::New();
-		PointType pointOnMesh;
-		bool pointExists;
-
-		//now iterate over all cells and store the coordinates of each cell in a vector
-		while (cellIterator != cellEnd) {
-			CellType *cell = cellIterator.Value();
-			typedef CellType::PointIdIterator PointIdIterator;
-			PointIdIterator pointIdIter = cell->PointIdsBegin();
-			PointIdIterator pointIdend = cell->PointIdsEnd();
-			while (pointIdIter != pointIdend) {
-				pointExists = meshSource->GetOutput()->GetPoint(*pointIdIter, &pointOnMesh);
-				if (pointExists) {
-					coordinates.push_back(pointOnMesh[0]);
-					coordinates.push_back(pointOnMesh[1]);
-					coordinates.push_back(pointOnMesh[2]);
-					vec.push_back(coordinates);
-					coordinates.clear();
-				}
-				++pointIdIter;
-			}
-			++cellIterator;
+	for (int label = 1; label <= nrLabels; label++) {
+		if (statistics[label - 1].nrVoxels > minNrVoxelsMesh) {
+			totalSurface += marchingCubes.surfacePerLabel[label];
+			volume += marchingCubes.volumePerLabel[label];
 		}
-		surface = calculateSurface(vec);
-
 	}
-#endif
+	if (config.exportMesh == 1) {
+		const typename intImage::PointType& maskOrigin = labeledMask->GetOrigin();
+		double origin[3] = { maskOrigin[0], maskOrigin[1], maskOrigin[2] };
+		marchingCubes.writeOBJ(config.outputFolder + "_mesh.obj", origin);
 	}
 	return totalSurface;
 }
 
-//calculate the surface of a mesh
-//as input the function takes a vector that consists of the points of each cells
-//these points are used to calculate the surface of each cell
-//the surfaces of the different cells are added
-template<class T, size_t R>
-float MorphologicalFeatures<T, R>::calculateSurface(vector<vector<float> > vec) {
-	//vector<float> a;
-	//vector<float> b;
-	//vector<float> c;
-	vector<float> ab;
-	vector<float> ac;
-	vector<float> bc;
-	//vector<float> cross;
-	double m_Volume, m_VolumeX, m_VolumeY, m_VolumeZ = 0.0;
-	double m_Area, m_Kx, m_Ky, m_Kz = 0.0;
-	double m_Wxyz, m_Wxy, m_Wxz, m_Wyz, m_Muncx, m_Muncy, m_Muncz = 0;
-	double area;
-	double a, b, c, s;
-	int m_NumberOfTriangles = 0;
-	surface = 0;
-	double i[3] , j[3], k[3], u[3], absu[3], length;
-	double ii[3], jj[3], kk[3];
-	double xavg, yavg, zavg;
-	vector<T> tmpPoint;
-	double p1[3], p2[3], p3[3];
-	double cross[3];
-	vector<T> centerPoint = vec[0];
-	float surface = 0;
-	for (int nr = 0; nr < (vec.size() / 3) - 1; nr++) {
-		tmpPoint = vec[3 * nr];
-		p1[0] = tmpPoint[0] -centerPoint[0];
-		p1[1] = tmpPoint[1] -centerPoint[1];
-		p1[2] = tmpPoint[2] -centerPoint[2];
-		tmpPoint = vec[3 * nr + 1];
-		p2[0] = tmpPoint[0] -centerPoint[0];
-		p2[1] = tmpPoint[1] -centerPoint[1];
-		p2[2] = tmpPoint[2] -centerPoint[2];
-		tmpPoint = vec[3 * nr + 2];
-		p3[0] = tmpPoint[0] -centerPoint[0];
-		p3[1] = tmpPoint[1] -centerPoint[1];
-		p3[2] = tmpPoint[2] -centerPoint[2];
-		//cross[0] =p1[0]* (p2[1] * p3[2] - p3[2] * p2[1]);
-		//cross[1] = p1[1] * (p3[2] * p2[0] - p3[0] * p2[1]);
-		//cross[2] = p1[2] * (p2[0] * p3[1] - p3[0] * p2[1]);
-
-		//std::cout << "vol" << (cross[0] + cross[1] + cross[2]) / 6 << std::endl;
-		// Get i j k vectors ...
-  ////
-		i[0] = (p2[0] -p1[0]); j[0] = (p2[1] - p1[1]); k[0] =  (p2[2] - p1[2]);
-		i[1] = (p3[0] - p1[0]); j[1] = (p3[1] - p1[1]); k[1] =  (p3[2] - p1[2]);
-		i[2] = (p3[0] - p2[0]); j[2] =  (p3[1] - p2[1]); k[2] =  (p3[2] - p2[2]);
-
-		// Cross product between two vectors, to determine normal vector
-		//
-		u[0] = (j[0] * k[1] - k[0] * j[1]);
-		u[1] = (k[0] * i[1] - i[0] * k[1]);
-		u[2] = (i[0] * j[1] - j[0] * i[1]);
-
-		// Normalize normal
-		//
-		length = std::sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
-		if (length != 0.0)
-		{
-			u[0] /= length;
-			u[1] /= length;
-			u[2] /= length;
-		}
-		else
-		{
-			u[0] = u[1] = u[2] = 0.0;
-		}
-			//// Determine max unit normal component...
-		////
-		absu[0] = std::fabs(u[0]); absu[1] = std::fabs(u[1]); absu[2] = std::fabs(u[2]);
-		if ((absu[0] > absu[1]) && (absu[0] > absu[2]))
-		{
-			m_Muncx++;
-		}
-		else if ((absu[1] > absu[0]) && (absu[1] > absu[2]))
-		{
-			m_Muncy++;
-		}
-		else if ((absu[2] > absu[0]) && (absu[2] > absu[1]))
-		{
-			m_Muncz++;
-		}
-		else if (itk::Math::AlmostEquals(absu[0], absu[1]) && itk::Math::AlmostEquals(absu[0], absu[2]))
-		{
-			m_Wxyz++;
-		}
-		else if (itk::Math::AlmostEquals(absu[0], absu[1]) && (absu[0] > absu[2]))
-		{
-			m_Wxy++;
-		}
-		else if (itk::Math::AlmostEquals(absu[0], absu[2]) && (absu[0] > absu[1]))
-		{
-			m_Wxz++;
-		}
-		else if (itk::Math::AlmostEquals(absu[1], absu[2]) && (absu[0] < absu[2]))
-		{
-			m_Wyz++;
-		}
-		
-		// This is reduced to ...
-		ii[0] = i[0] * i[0]; ii[1] = i[1] * i[1]; ii[2] = i[2] * i[2];
-		jj[0] = j[0] * j[0]; jj[1] = j[1] * j[1]; jj[2] = j[2] * j[2];
-		kk[0] = k[0] * k[0]; kk[1] = k[1] * k[1]; kk[2] = k[2] * k[2];
-
-		
-		// Area of a triangle using Heron's formula...
-		a = std::sqrt(ii[1] + jj[1] + kk[1]);
-		b = std::sqrt(ii[0] + jj[0] + kk[0]);
-		c = std::sqrt(ii[2] + jj[2] + kk[2]);
-		s = 0.5 * (a + b + c);
-		area = std::sqrt(std::fabs(s * (s - a) * (s - b) * (s - c)));
-		// Volume elements ...
-		zavg = (p1[2] + p2[2] + p3[2]) / 3.0;
-		yavg = (p1[1] + p2[1] + p3[1]) / 3.0;
-		xavg = (p1[0] + p2[0] + p3[0]) / 3.0;
-		m_VolumeX += (area * (double)u[2] * (double)zavg);
-		m_VolumeY += (area * (double)u[1] * (double)yavg);
-		m_VolumeZ += (area * (double)u[0] * (double)xavg);
-		//S	rface += (cross[0] + cross[1] + cross[2]) / 6;
-		surface += area;
-		m_NumberOfTriangles++;
-		
-	}
-	// Compute fraction of elements that primarily point along the x, y
-  // and z directions
-	m_Kx = (m_Muncx + (m_Wxyz / 3.0) + ((m_Wxy + m_Wxz) / 2.0)) / m_NumberOfTriangles;
-	m_Ky = (m_Muncy + (m_Wxyz / 3.0) + ((m_Wxy + m_Wyz) / 2.0)) / m_NumberOfTriangles;
-	m_Kz = (m_Muncz + (m_Wxyz / 3.0) + ((m_Wxz + m_Wyz) / 2.0)) / m_NumberOfTriangles;
-
-	m_Volume = (m_Kx * m_VolumeX
-		+ m_Ky * m_VolumeY
-		+ m_Kz * m_VolumeZ);
-	m_Volume = std::fabs(m_Volume);
-	volume += m_Volume;
-	return surface;
-}
-
 
+/*!
+In the function calculateAllMorphologicalFeatures all morphological features are calculated. \n
+The connected components of the mask are labelled before (see labelLesions), the labels have to be on the grid of imageAttr. As the
+dispersity features use the same labelling, the components are fully connected (26-neighbourhood), also for the features of
+getLabelObjectFeatures, which used face connectivity before. For masks with lesions that only touch at an edge or a corner these
+features (e.g. the principal moments) change.
+@param[in,out] morphFeatures: the morphological features
+@param[in] imageAttr: image attributes of the VOI
+@param[in] lesions: label image and statistics of the connected components of the mask
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
 template <class T, size_t R>
-void MorphologicalFeatures<T, R>::calculateAllMorphologicalFeatures(MorphologicalFeatures<T, R> &morphFeatures, Image<float, 3> imageAttr, ConfigFile config) {
+void MorphologicalFeatures<T, R>::calculateAllMorphologicalFeatures(MorphologicalFeatures<T, R> &morphFeatures, const Image<float, 3> &imageAttr, const LesionLabels &lesions, const ConfigFile &config) {
 	const typename ImageType::SpacingType& inputSpacing = imageAttr.image->GetSpacing();
 
 	//mask = changeMaskSpacingToImageSpacing(imageAttr.image, mask);
@@ -1032,8 +753,9 @@ void MorphologicalFeatures<T, R>::calculateAllMorphologicalFeatures(Morphologica
 	itk::ImageRegionConstIterator<ImageType> countVoxels(imageAttr.mask, imageAttr.mask->GetLargestPossibleRegion());
 	mask = imageAttr.mask;
 	
-	surface = getSurface(imageAttr.mask);
-	morphFeatures.getLabelObjectFeatures(imageAttr.mask);
+	//the same labels are used for surface, mesh volume and the label object features
+	surface = getSurface(lesions, config);
+	morphFeatures.getLabelObjectFeatures(lesions, config);
 	morphFeatures.getBoundingBoxValues(imageAttr.mask);
 	morphFeatures.calculateMajorAxisLength();
 
@@ -1089,7 +811,7 @@ void MorphologicalFeatures<T, R>::calculateAllMorphologicalFeatures(Morphologica
 }
 
 template <class T, size_t R>
-void MorphologicalFeatures<T, R>::writeCSVFileMorphological(MorphologicalFeatures<T, R> morph, string outputFolder, ConfigFile config)
+void MorphologicalFeatures<T, R>::writeCSVFileMorphological(MorphologicalFeatures<T, R> morph, string outputFolder, const ConfigFile &config)
 {
 	string csvName = outputFolder + "_morphologicalFeatures.csv";
 	char * name = new char[csvName.size() + 1];
@@ -1102,10 +824,10 @@ void MorphologicalFeatures<T, R>::writeCSVFileMorphological(MorphologicalFeature
 	
 	
 	vector<string> features;
-	defineMorphologicalFeatures(features);
+	defineMorphologicalFeatures(features, config);
 
 	vector<T> morphData;
-	extractMorphologicalData(morphData, morph);
+	extractMorphologicalData(morphData, morph, config);
 	for (int i = 0; i< morphData.size(); i++) {
 		morphCSV << "Morphology" << "," << features[i] << ",";
 		morphCSV << morphData[i];
@@ -1116,7 +838,7 @@ void MorphologicalFeatures<T, R>::writeCSVFileMorphological(MorphologicalFeature
 
 
 template <class T, size_t R>
-void MorphologicalFeatures<T, R>::writeOneFileMorphological(MorphologicalFeatures<T, R> morph, ConfigFile config) {
+void MorphologicalFeatures<T, R>::writeOneFileMorphological(MorphologicalFeatures<T, R> morph, const ConfigFile &config) {
 	string csvName;
 	if (config.getOneCSVFile == 1) {
 		csvName = config.outputFolder + ".csv";		
@@ -1133,9 +855,9 @@ void MorphologicalFeatures<T, R>::writeOneFileMorphological(MorphologicalFeature
 	
 	vector<string> features;
 	vector<T> morphData;
-	extractMorphologicalData(morphData, morph);
+	extractMorphologicalData(morphData, morph, config);
 	if (config.getOneCSVFile == 1) {
-		defineMorphologicalFeatures(features);
+		defineMorphologicalFeatures(features, config);
 		for (int i = 0; i < morphData.size(); i++) {
 			morphCSV << "Morphology" << "," << features[i] << ",";
 			morphCSV << morphData[i];
@@ -1144,7 +866,7 @@ void MorphologicalFeatures<T, R>::writeOneFileMorphological(MorphologicalFeature
 		morphCSV.close();
 	}
 	else if (config.ontologyOutput == 1) {
-		defineMorphologicalFeaturesOntology(features);
+		defineMorphologicalFeaturesOntology(features, config);
 		for (int i = 0; i < morphData.size(); i++) {
 			
 			morphCSV << config.patientID<<","<<config.patientLabel<<","<< features[i] << ",";
@@ -1155,7 +877,7 @@ void MorphologicalFeatures<T, R>::writeOneFileMorphological(MorphologicalFeature
 	}
 }
 template <class T, size_t R>
-void MorphologicalFeatures<T, R>::defineMorphologicalFeatures(vector<string> &features) {
+void MorphologicalFeatures<T, R>::defineMorphologicalFeatures(vector<string> &features, const ConfigFile &config) {
 	features.push_back("Volume");
 	features.push_back("approximate volume");
 	features.push_back("Surface");
@@ -1174,8 +896,12 @@ void MorphologicalFeatures<T, R>::defineMorphologicalFeatures(vector<string> &fe
 	features.push_back("flatness");
 	features.push_back("vol density AABB");
 	features.push_back("area density AABB");
-	//features.push_back("vol density OMBB");
-	//features.push_back("area density OMBB");
+	if (config.convexHullFeatures == 1) {
+		features.push_back("vol density OMBB");
+		features.push_back("area density OMBB");
+		features.push_back("vol density convex hull");
+		features.push_back("area density convex hull");
+	}
 	features.push_back("vol density AEE");
 	//features.push_back("area density AEE");
 	//features.push_back("vol density MEE");
@@ -1186,7 +912,7 @@ void MorphologicalFeatures<T, R>::defineMorphologicalFeatures(vector<string> &fe
 }
 
 template <class T, size_t R>
-void  MorphologicalFeatures<T, R>::defineMorphologicalFeaturesOntology(vector<string> &features) {
+void  MorphologicalFeatures<T, R>::defineMorphologicalFeaturesOntology(vector<string> &features, const ConfigFile &config) {
 	features.push_back("Fmorph.vol");
 	features.push_back("Fmorph.approx.vol");
 	features.push_back("Fmorph.area");
@@ -1205,8 +931,12 @@ void  MorphologicalFeatures<T, R>::defineMorphologicalFeaturesOntology(vector<st
 	features.push_back("Fmorph.pca.flatness");	
 	features.push_back("Fmorph.v.dens.aabb");
 	features.push_back("Fmorph.a.dens.aabb");
-	//features.push_back("Fmorph.v.dens.ombb");
-	//features.push_back("Fmorph.a.dens.ombb");
+	if (config.convexHullFeatures == 1) {
+		features.push_back("Fmorph.v.dens.ombb");
+		features.push_back("Fmorph.a.dens.ombb");
+		features.push_back("Fmorph.v.dens.conv.hull");
+		features.push_back("Fmorph.a.dens.conv.hull");
+	}
 	features.push_back("Fmorph.v.dens.aee");
 	//features.push_back("Fmorph.a.dens.aee");
 	//features.push_back("Fmorph.v.dens.mee");
@@ -1217,7 +947,7 @@ void  MorphologicalFeatures<T, R>::defineMorphologicalFeaturesOntology(vector<st
 }
 
 template <class T, size_t R>
-void MorphologicalFeatures<T, R>::extractMorphologicalData(vector<T> &morphData, MorphologicalFeatures<T, R> morphFeatures) {
+void MorphologicalFeatures<T, R>::extractMorphologicalData(vector<T> &morphData, MorphologicalFeatures<T, R> morphFeatures, const ConfigFile &config) {
 	morphData.push_back(morphFeatures.volume);
 	morphData.push_back(morphFeatures.appVolume);
 	morphData.push_back(morphFeatures.surface);
@@ -1236,8 +966,12 @@ void MorphologicalFeatures<T, R>::extractMorphologicalData(vector<T> &morphData,
 	morphData.push_back(morphFeatures.flatness);
 	morphData.push_back(morphFeatures.volDensityAABB);
 	morphData.push_back(morphFeatures.areaDensityAABB);
-	//morphData.push_back(morphFeatures.volDensityOMBB);
-	//morphData.push_back(morphFeatures.areaDensityOMBB);
+	if (config.convexHullFeatures == 1) {
+		morphData.push_back(morphFeatures.volDensityOMBB);
+		morphData.push_back(morphFeatures.areaDensityOMBB);
+		morphData.push_back(morphFeatures.volDensityConvexHull);
+		morphData.push_back(morphFeatures.areaDensityConvexHull);
+	}
 	morphData.push_back(morphFeatures.volDensityAEE);
 	//morphData.push_back(morphFeatures.areaDensityAEE);
 	//morphData.push_back(morphFeatures.volDensityMEE);
@@ -0,0 +1,76 @@
+/*!
+\brief parallelThreadBudget
+The function parallelThreadBudget returns the number of threads the calling thread may use for nested parallel parts. \n
+It is 0 outside of runParallel, inside runParallel it is set to the share of the thread budget of one item (see runParallel).
+*/
+unsigned int &parallelThreadBudget() {
+	static thread_local unsigned int threadBudget = 0;
+	return threadBudget;
+}
+
+/*!
+\brief getThreadBudget
+The function getThreadBudget returns the number of threads the calling thread may use: the number of cores outside of runParallel,
+the share of the outer parallel part inside of runParallel.
+*/
+unsigned int getThreadBudget() {
+	if (parallelThreadBudget() != 0) {
+		return parallelThreadBudget();
+	}
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/*!
+\brief getNrThreads
+The function getNrThreads returns the number of threads that is used for nrItems items: at least 1 and not more threads than items. \n
+Inside of runParallel, not more threads than the thread budget of the calling thread are used, so that nested parallel parts do not
+start more threads than there are cores.
+@param[in] nrThreads: number of threads, if 0 the thread budget is used (number of cores outside of runParallel)
+@param[in] nrItems: number of items
+*/
+unsigned int getNrThreads(unsigned int nrThreads, size_t nrItems) {
+	if (nrThreads == 0 || (parallelThreadBudget() != 0 && nrThreads > parallelThreadBudget())) {
+		nrThreads = getThreadBudget();
+	}
+	return unsigned(std::max(size_t(1), std::min(size_t(nrThreads), nrItems)));
+}
+
+/*!
+\brief getItemThreadBudget
+The function getItemThreadBudget returns the thread budget of one item, if the items are distributed over nrUsedThreads threads.
+@param[in] nrUsedThreads: number of threads of the parallel part (see getNrThreads)
+*/
+unsigned int getItemThreadBudget(unsigned int nrUsedThreads) {
+	return std::max(1u, getThreadBudget() / std::max(1u, nrUsedThreads));
+}
+
+/*!
+\brief runParallel
+The function runParallel calls process for the items 0 ... nrItems - 1 and returns when all items are processed. \n
+The thread budget is split between the threads: while an item is processed, nested parallel parts only use the share of its thread
+(e.g. the image spaces of one time point, see getNrThreads).
+@param[in] nrItems: number of items
+@param[in] nrThreads: number of threads, if 0 the thread budget is used (number of cores outside of runParallel)
+@param[in] process: function that processes one item, it is called by several threads at the same time
+*/
+void runParallel(size_t nrItems, unsigned int nrThreads, const std::function<void(size_t)> &process) {
+	unsigned int nrUsedThreads = getNrThreads(nrThreads, nrItems);
+	unsigned int itemThreadBudget = getItemThreadBudget(nrUsedThreads);
+	std::atomic<size_t> nextItem(0);
+	auto processItems = [&]() {
+		unsigned int outerThreadBudget = parallelThreadBudget();
+		parallelThreadBudget() = itemThreadBudget;
+		for (size_t item = nextItem++; item < nrItems; item = nextItem++) {
+			process(item);
+		}
+		parallelThreadBudget() = outerThreadBudget;
+	};
+	vector<std::thread> threads;
+	for (unsigned int i = 1; i < nrUsedThreads; i++) {
+		threads.push_back(std::thread(processItems));
+	}
+	processItems();
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+}
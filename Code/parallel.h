@@ -0,0 +1,30 @@
+#ifndef PARALLEL_H_INCLUDED
+#define PARALLEL_H_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+using namespace std;
+
+/*! \file */
+
+/*!
+The functions of this file distribute independent items (e.g. slices, labels, image spaces or time points) over several threads. \n
+The items are taken one after the other from a shared counter, so threads that get fast items take more of them. The calling thread
+also processes items, so one thread does not start a new thread. \n
+Every parallel part of RaCaT uses these functions, the number of threads is set in the config file (0: number of cores). \n
+Parallel parts can be nested (e.g. time points and image spaces). The cores are split between the levels: every thread of the outer
+part gets a thread budget, and the nested parts do not use more threads than this budget.
+*/
+
+unsigned int &parallelThreadBudget();
+unsigned int getThreadBudget();
+unsigned int getNrThreads(unsigned int nrThreads, size_t nrItems);
+unsigned int getItemThreadBudget(unsigned int nrUsedThreads);
+void runParallel(size_t nrItems, unsigned int nrThreads, const std::function<void(size_t)> &process);
+
+#include "parallel.cpp"
+
+#endif // PARALLEL_H_INCLUDED
@@ -233,31 +233,6 @@ void fillCSVwithNANs(ConfigFile config) {
 
 }
 
-ImageType::Pointer thresholdMask(ImageType *mask, float threshold) {
-	itk::ImageRegionIterator<ImageType> countVoxels(mask, mask->GetLargestPossibleRegion());
-	countVoxels.GoToBegin();
-
-	float maxValue = 0;
-	while (!countVoxels.IsAtEnd()){
-		if (countVoxels.Get() > maxValue){
-			maxValue = countVoxels.Get();
-
-		}
-		++countVoxels;
-	}
-	countVoxels.GoToBegin();
-	while (!countVoxels.IsAtEnd()){
-		if (countVoxels.Get() >= threshold * maxValue){
-			countVoxels.Set(1);
-		}
-		else {
-			countVoxels.Set(0);
-		}
-		++countVoxels;
-	}
-	return mask;
-}
-
 //write PET metrics to .csv
 void writePETmetrics(float value, string nameVariable, ConfigFile config) {
 	string csvName;
@@ -293,39 +268,11 @@ void writePETmetrics(float value, string nameVariable, ConfigFile config) {
 
 }
 
-//calculate the original volume before interpolation
-float getOriginalVolume(ImageType::Pointer mask) {
-	itk::ImageRegionConstIterator<ImageType> countVoxels(mask, mask->GetLargestPossibleRegion());
-	countVoxels.GoToBegin();
-	float maxValue = 0;
-	while (!countVoxels.IsAtEnd())
-	{
-		if (countVoxels.Get() > maxValue)
-		{
-			maxValue = countVoxels.Get();
-		}
-		++countVoxels;
-	}
-	float volume = 0;
-	countVoxels.GoToBegin();
-	while (!countVoxels.IsAtEnd())
-	{
-		if (countVoxels.Get() >= 0.5*maxValue)
-		{
-			volume += 1;
-		}
-		++countVoxels;
-	}
-	return volume;
-}
-
-
-void calculatePETmetrics(ImageType::Pointer image, ImageType::Pointer mask, int volume, ConfigFile config) {
+void calculatePETmetrics(ImageType::Pointer image, const MaskAnalysis &maskAnalysis, int volume, ConfigFile config) {
 	//upsampled or downsampled include PET metrics
-	RegionType boundingBoxRegionTmp = getBoundingBoxMask(mask);
-	ImageType::Pointer tmpmaskFiltered = getImageMasked(mask, boundingBoxRegionTmp);
-	ImageType::Pointer tmpimageFiltered = getImageMasked(image, boundingBoxRegionTmp);
-	tmpmaskFiltered = thresholdMask(tmpmaskFiltered, config.threshold);
+	//the mask is cut to the region of its non zero voxels and converted to 1
+	ImageType::Pointer tmpmaskFiltered = maskAnalysis.getBinaryMask(maskAnalysis.nonZeroRegion);
+	ImageType::Pointer tmpimageFiltered = getImageMasked(image, maskAnalysis.nonZeroRegion);
 	const typename ImageType::RegionType& imageRegion = tmpimageFiltered->GetLargestPossibleRegion();
 	const typename ImageType::SizeType& imageRegionSize = imageRegion.GetSize();
 	Image<float, 3> imageTestTmp(imageRegionSize[0], imageRegionSize[1], imageRegionSize[2]);
@@ -359,7 +306,8 @@ void calculatePETmetrics(ImageType::Pointer image, ImageType::Pointer mask, int
 }
 
 
-void storePreInterpolationFeatures(ImageType::Pointer image, ImageType::Pointer maskImage, ConfigFile config) {
+//the dispersity features use the lesions of the mask on the grid of the loaded image (see labelLesions)
+void storePreInterpolationFeatures(ImageType::Pointer image, const MaskAnalysis &maskAnalysis, const LesionLabels &lesions, ConfigFile config) {
 	//do the PET uptake metrics have to be calculated?
 	const typename ImageType::SpacingType& inputSpacing = image->GetSpacing();
 	std::string a = "1";
@@ -373,9 +321,12 @@ void storePreInterpolationFeatures(ImageType::Pointer image, ImageType::Pointer
 	//calculate PET Uptake metrics if required
 
 	if (config.calculateAllFeatures == 1 || rebinning == 1) {
-		float volume = getOriginalVolume(maskImage);
+		//the exact metrics are written while they are calculated, so the writer is part of the stage
+		TraceStage exactStage(config, "ExactMetrics", "feature", maskAnalysis.nrVoxels);
+		//original volume before interpolation: all voxels with at least half of the maximum value
+		float volume = maskAnalysis.countVoxels(0.5);
 		volume = volume * inputSpacing[0] * inputSpacing[1] * inputSpacing[2];
-		calculatePETmetrics(image, maskImage, volume, config);
+		calculatePETmetrics(image, maskAnalysis, volume, config);
 		writeExactVolume(volume, config);
 	}
 	std::cout << "Exact metrics calculated" << std::endl;
@@ -392,12 +343,14 @@ void storePreInterpolationFeatures(ImageType::Pointer image, ImageType::Pointer
 		std::cout << "DISP" << dispersity << std::endl;
 	}
 
+	TraceStage dispersityStage(config, "DispersityFeatures", "feature", maskAnalysis.nrVoxels);
 	if (dispersity == 1 || config.calculateAllFeatures == 1) {
-		disp.calculateAllDispersityFeatures(disp, image, maskImage, config);
+		disp.calculateAllDispersityFeatures(disp, image, lesions, config);
 		string forLog = "Dispersity features were calculated.";
 		writeLogFile(config.outputFolder, forLog);
 		std::cout << "Dispersity features are calculated" << std::endl;
 	}
+	dispersityStage.next("DispersityFeatures writer", "writer");
 	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
 		disp.writeCSVFileDispersity(disp, config.outputFolder, config);
 	}
@@ -56,11 +56,9 @@
 #include "string"
 
 void fillCSVwithNANs(ConfigFile config);
-ImageType::Pointer thresholdMask(ImageType *mask, float threshold);
 void writePETmetrics(float value, string nameVariable, ConfigFile config);
 void writeExactVolume(float volume, ConfigFile config);
-void calculatePETmetrics(ImageType::Pointer image, ImageType::Pointer mask, int volume, ConfigFile config);
-void storePreInterpolationFeatures(ImageType::Pointer image, ImageType::Pointer mask, ConfigFile config);
-float getOriginalVolume(ImageType::Pointer mask);
+void calculatePETmetrics(ImageType::Pointer image, const MaskAnalysis &maskAnalysis, int volume, ConfigFile config);
+void storePreInterpolationFeatures(ImageType::Pointer image, const MaskAnalysis &maskAnalysis, const LesionLabels &lesions, ConfigFile config);
 #include "processing.cpp"
 #endif
\ No newline at end of file
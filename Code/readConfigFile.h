@@ -6,11 +6,17 @@
 #include <ctime>
 #include <direct.h>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include "itkMetaDataObject.h"
 #include "itkTypes.h"
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 #include <boost/tokenizer.hpp>
+#include <boost/algorithm/string/trim.hpp>
+#include <sstream>
 using namespace itkTypes;
 //#include <boost/filesystem.hpp>
 #ifdef _WIN32
@@ -35,6 +41,75 @@ In the config.ini file you can set the preprocessing steps you want to use.
 
 \arg Smoothing: \n
 If you want to use additional smoothing to the image, you can set a Gaussian kernel to the desired full-width-at-half-maximum. Smoothing is applied as soon as the Smoothing kernel is not equal to 0. \n
+The image is smoothed once, independent of the image format, and only in the bounding box of the mask plus the margin of the
+local intensity features. For this, the image is read up to 4 times the kernel around this region. \n
+
+\arg Crop on read: \n
+If CropOnRead in the section ImageProperties is set to 1, the mask is read first and only the part of the image around the mask is read
+(bounding box of the mask plus a margin for smoothing, interpolation and the local intensity features). Smoothing and interpolation are then
+only applied to this part of the image. This is much faster for big images (e.g. whole body scans) with small VOIs. \n
+As the interpolation grid depends on the size of the image, the values of interpolated images can differ slightly from the values
+obtained without cropping. The default value is 0. \n
+
+\arg RT struct ROIs: \n
+If the VOI is a RT struct file, RTStructROIs in the section ImageProperties contains the names of the ROIs that are used, separated by commas.
+All ROIs with contours are used if no name is given. The contours are filled on the grid of the image, if more than one ROI is used the features
+are calculated for the union of the ROIs, unless MultiLabel is set. \n
+
+\arg Multi label: \n
+If MultiLabel in the section ImageProperties is set to 1, the mask is a label image (or a RT struct with several ROIs) and the features are
+calculated for every label. The image is read and smoothed only once, then the region around every label is cut from the image and
+the label is calculated like a single mask. The results of every label are stored in an own output file, the name of the output
+is extended by _label and the label value. NrParallelLabels sets how many labels are calculated at the same time
+(default 1, 0 uses the number of cores); every label needs the memory of a single calculation of the cut region. \n
+
+\arg Feature maps: \n
+If CalculateFeatureMaps in the section FeatureMaps is set to 1, voxel-wise feature maps are calculated in addition to the features of the VOI.
+A window is moved over the VOI and for every voxel of the VOI the features of the VOI voxels inside the window are calculated. WindowRadius
+sets the radius of the window in voxels (default 2), WindowShape is cube (default) or sphere. Features contains the names of the features,
+separated by commas (all features if empty): mean, variance, skewness, kurtosis, entropy, uniformity, jointMaximum, jointAverage, jointVariance,
+jointEntropy, angSecMoment, contrast, dissimilarity, inverseDiff, inverseDiffMom, correlation and autoCorrelation. The histogram and GLCM
+features use the discretized image and the merged 3D GLC-matrix without distance weights. The rows of the image are distributed over
+NrThreads threads (default 0: number of cores). Every map is written as NIfTI image outputFolder_map_featureName.nii.gz. \n
+
+\arg Feature cache: \n
+If UseCache in the section FeatureCache is set to 1, the results are stored in a cache folder (CacheFolder, default: the folder
+racatFeatureCache next to the output) and reused when the same calculation is run again, e.g. when a whole cohort is recalculated
+after one parameter changed. A case whose image, mask, config, feature selection and patient info files did not change is not read
+at all. Otherwise every feature family whose input (the preprocessed image and mask) and parameters did not change is taken from the
+cache, only the other families are calculated (if feature maps are calculated, only the families are cached). The cache is
+only used for the csv output. \n
+
+\arg Texture matrices: \n
+If StoreMatrices in the section TextureMatrices is set to 1, the count matrices of the GLCM and GLRLM features (for every slice
+and direction, without distance weights) are written together with the discretized VOI to outputFolder_textureMatrices.bin.
+If LoadMatrices is set to such a file, the image is not read: the features are calculated from the stored VOI and matrices, so that
+other aggregation methods, distance norms (NormGLCM, NormGLRLM) or emphasis powers can be calculated without recalculating the matrices.
+The discretization of the stored VOI is used. Features that need the image itself (morphological, local intensity, statistical,
+intensity volume, NGTDM, GLDZM and NGLDM features) are not calculated from a matrix file. \n
+
+\arg Mask perturbation: \n
+If CalculatePerturbations in the section MaskPerturbation is set to 1, the features are also calculated for perturbed versions of the mask,
+e.g. to test the robustness of the features against the segmentation. The perturbed masks are created in memory on the grid of the
+(resampled) image, which is read and preprocessed only once: ErosionDilation is a list of voxel numbers separated by commas (negative
+numbers erode, positive numbers dilate the mask, e.g. -2,-1,1,2), Translation moves the mask by this number of voxels in both directions
+of x, y and z, NrRandomContours masks with randomized contours are created (every voxel on the contour is changed with the probability
+ContourProbability, default 0.5, the random numbers start with RandomSeed). The GLCM and GLRLM matrices of a perturbed mask are calculated
+from the matrices of the mask, only the voxel pairs and runs that contain a changed voxel are counted again (this needs a discretization that
+does not depend on the minimum of the VOI, e.g. a fixed bin width with a resegmentation minimum, otherwise the matrices are calculated as usual).
+The results of every perturbed mask are written to the output outputFolder_perturbation_name. The mask itself is calculated in the
+region of the largest perturbation. It cannot be combined with MultiLabel. \n
+
+\arg Image filters: \n
+If CalculateImageFilters in the section ImageFilters is set to 1, the features are also calculated on filtered versions of the image
+(image spaces). The image is read, smoothed and resampled only once, the filters are applied to the (resampled) region around the mask:
+LoGSigma is a list of widths in mm separated by commas (e.g. 1,2,3), for every width the Laplacian of Gaussian response (scale-normalized
+by sigma^2) is calculated. Wavelet is the name of an undecimated wavelet of level 1 (haar or coif1, empty: no wavelet), WaveletSubbands
+is a list of the sub-bands that are calculated (e.g. LLH,HHH, the letters give the low or high pass filter in x, y and z direction; all 8
+sub-bands if empty). The features of the original image are calculated too, unless CalculateOriginal is set to 0. NrParallelImageSpaces
+image spaces are calculated at the same time (0: number of cores). The results of every filtered image space are written to the output
+outputFolder_name (e.g. outputFolder_LoG_sigma2 or outputFolder_wavelet_coif1_LLH). It cannot be combined with MultiLabel or
+CalculatePerturbations. \n
 
 \arg Threshold (in %) for including voxels in the VOI:
 Masks can contain different values. A mask can contain only 1s, values from 1-100, or other ranges. You can determine which voxels will be included in the final mask by setting a threshold. The program determines the
@@ -50,6 +125,51 @@ You can set the bin width and the number of bins you want to use.  \n
 \arg Interpolation method: \n
 If you want to up- or downsample the image, you can say it in the part "interpolation method". You can choose between up- or downsampling or if you want to sample the image to cubic voxels of 2 mm voxel size. \n
 For interpolation, trilinear interpolation is used. \n
+If CubicVoxelSizes is set to a list of voxel sizes (integers in mm, separated by commas, e.g. 1,2,3,4) and UseSamplingToCubic is 1, the features are
+calculated for every voxel size (multi-resolution mode, e.g. for harmonization studies). Every voxel size can only be set once.
+The image is read, cropped and smoothed only once, the region around the mask is resampled for every voxel size. The results of every
+voxel size are written to the output outputFolder_voxelSizeNmm, the features before the interpolation (exact metrics and dispersity
+features) only to the output itself.
+It cannot be combined with MultiLabel, CalculatePerturbations or CalculateImageFilters. \n
+
+\arg Multi-modality: \n
+In the section MultiModality, ConfigFiles is a list of config files (separated by commas) of additional images, e.g. the CT of a PET/CT,
+whose features are calculated in the VOI of the mask. ImageNames is the list of these images (in the format of the image of the command line);
+an empty entry uses the image of the command line (e.g. the CT of the same .prj file). The mask is read, analysed and labelled only once,
+the exact metrics, dispersity and morphological features are calculated once with the image of the command line. For every image only the
+intensity and texture features are calculated: every image is read, smoothed, resampled and discretized with the image type and the settings
+of its own config file (ImageProperties, smoothing, interpolation, resegmentation and discretization), all other settings are taken from this
+config file. Images that do not have the grid of the mask are resampled on the grid of the mask. The csv features of all images are written
+to one row of the same output, the feature names of every image start with its image type, e.g. CT_meanIntensity. Ontology tables,
+texture matrices, feature maps and the log of every image are written to outputFolder_modalityN (N = 0 for the image of the command line).
+It cannot be combined with MultiLabel, CalculatePerturbations,
+CalculateImageFilters or CubicVoxelSizes. \n
+
+\arg Longitudinal: \n
+For delta radiomics, the section Longitudinal contains the follow-up time points of the patient: Images and Masks are lists of images
+and masks (separated by commas, in the format of the command line), TimePoints their names (default: followupN) and PatientInfos their
+patient info files (default: the patient info file of the command line). The image and mask of the command line are the first time point
+(BaselineName, default: baseline). All time points are calculated with the same config and feature selection, NrParallelTimePoints of them
+at the same time (0: number of cores). The cores are split between the time points: the image spaces, the labels and the ITK filters
+of one time point only use its share of the cores. The features of every time point are written to outputFolder_name; the table outputFolder_longitudinal.csv
+contains for every feature the values of all time points, the changes to the first time point and the relative changes (change divided by the
+absolute value of the first time point). The table is only written for the csv output. \n
+
+\arg Calculation modes: \n
+MultiLabel, LoadMatrices, CalculatePerturbations, CalculateImageFilters, CubicVoxelSizes, the section MultiModality and the section
+Longitudinal each change how a case is calculated and where its results are written. Only one of them can be set: if several are set,
+the program stops with an error that lists them. Feature maps, the feature cache and StoreMatrices can be combined with all of them, except
+that feature maps cannot be calculated from a texture matrix file. \n
+
+\arg Benchmark: \n
+The section Benchmark is only read if the executable is called with --bench instead of --img and --voi: the features are then calculated
+for synthetic phantoms (see PhantomBenchmark) instead of an image. Phantoms is a list of shapes (sphere, ellipsoid, multiLesion and noise),
+Sizes a list of edge lengths of the phantoms in voxels and NrBins a list of numbers of bins (fixed number of bins). If Sizes or NrBins are
+not set, they are taken from Preset: full (default) sweeps phantoms from 10^3 to 400^3 voxels (10,25,50,100,200,400) and 8 to 1024 bins
+(8,32,128,1024), quick only goes up to 100^3 voxels and 128 bins (10,25,50,100 and 8,32,128) for a short check.
+If CalculateFamilies is 1, every feature family is calculated on its own, if CalculateEndToEnd is 1, all features are calculated together.
+The wall time, the throughput (voxels per second) and the peak memory of every run are written to outputFolder_benchmark.csv. All other
+settings of the config file (e.g. interpolation, resegmentation) are used like for an image. \n
 
 \arg Resegmentation: \n
 If you want to resegment the image region, you can state that here. I.e. if you want to exclude values above/below a maximum/minimum value or if you want to exclude outliers from the segmentation.\n
@@ -73,6 +193,13 @@ to this distance are regarded as part of the neighborhood. The default value is
 \arg NGTDM parameters: \n
 You can set the size (distance to center voxel) of a neighborhood. The default value is also 1. \n
 
+\arg Morphological parameters: \n
+By default, the maximum 3D diameter is the sum of the Feret diameters of the lesions of the mask (largest distance of two voxel centres
+of one lesion). If ConvexHullFeatures in the section MorphologicalParameters is set to 1, the maximum diameter is the largest distance
+of two vertices of the mesh of the whole VOI, and the volume and area densities of the oriented minimum bounding box (OMBB) and of the
+convex hull are written as additional morphological features. The OMBB is an approximation: only boxes with one side on a face of
+the convex hull are checked (see ConvexHull::getApproximateMinimumBoundingBox). \n
+
 \arg Distance weight properties: \n
 The contents of GLCM, GLRLM and NGTDM matrices can be updated by the distance between voxels. Herefore, different definitions of 
 the distance can be used. Possible distances are: \n
@@ -89,6 +216,10 @@ If the extended emphasis features should be calculated, the CalculateExtendedEmp
 \arg Output information: \n
 Here, you can set the output format. You can choose between csv or ontology output. If you want to have a csv file as output, you can decide if you want to have it as one csv file or 
 one csv file per feature group.\n
+If ExportMesh is set to 1, the mesh that is used to calculate surface and volume of the VOI is written to an .obj file (outputFolder_mesh.obj). \n
+If WriteTrace is set to 1, the wall time, CPU time, peak memory increase and size of every stage of the calculation (reading, preprocessing,
+every feature family and its writer) are written to a trace (see TraceStage). TraceFormat chrome (default) writes outputFolder_trace.json,
+which can be opened with chrome://tracing or Perfetto, TraceFormat jsonl writes one JSON object per stage to outputFolder_trace.jsonl. \n
  
 The class ConfigFile has as attributes exactly the attributes which can be set in the config-file. \n
 @page PatientInfo Setting up the patientInfo.ini file
@@ -129,12 +260,70 @@ class ConfigFile{
         config pt;
 		//!float for smoothing kernel if !=0, image is smoothed
 		float smoothingKernel;
+		//!integer which states if only the region around the mask is read from the image
+		int cropOnRead;
 		//!threshold in %; all voxels which contain values higher than this percentage of the maximum mask value will be included in the mask
 		float threshold;
 		//!integer which states if exe is called by accurate tool
 		int useAccurate;
 		//!integer which states if .voi is dicom, nii or else
 		int voiFile;
+		//!names of the ROIs of a RT struct that are used (separated by commas), all ROIs if empty
+		string rtStructROIs;
+		//!integer which states if the mask is a label image and the features are calculated for every label
+		int multiLabel;
+		//!number of labels that are calculated at the same time (0: number of cores)
+		int nrParallelLabels;
+		//!integer which states if voxel-wise feature maps are calculated
+		int featureMaps = 0;
+		//!radius (in voxels) and shape of the window of the feature maps
+		int featureMapRadius;
+		string featureMapShape;
+		//!features that are calculated as maps (separated by commas), all if empty
+		string featureMapFeatures;
+		//!number of threads for the feature maps (0: number of cores)
+		int nrThreadsFeatureMaps;
+		//!integer which states if the feature results are cached and the folder of the cache (default: folder of the output)
+		int useFeatureCache = 0;
+		string featureCacheFolder;
+		//!integer which states if the texture matrices are stored and the matrix file from which the features are calculated
+		int storeTextureMatrices = 0;
+		string textureMatrixFile;
+		//!integer which states if the features of perturbed masks are calculated and the perturbations (see MaskPerturbation)
+		int maskPerturbation = 0;
+		string perturbationErosionDilation;
+		int perturbationTranslation;
+		int nrRandomContours;
+		float contourProbability;
+		int perturbationSeed;
+		//!integer which states if the features of filtered image spaces are calculated and the filters (see ImageFilters)
+		int imageFilters = 0;
+		string logSigmas;
+		string waveletName;
+		string waveletSubbands;
+		int calculateOriginalSpace;
+		//!number of image spaces that are calculated at the same time (0: number of cores)
+		int nrParallelImageSpaces;
+		//!additional images of the multi-modality mode and their config files, the images share the mask
+		vector<string> modalityImageNames;
+		vector<string> modalityConfigFiles;
+		//!time points of the longitudinal mode (the first one is the image and mask of the command line): images, masks, names and patient info files
+		vector<string> timePointImages;
+		vector<string> timePointMasks;
+		vector<string> timePointNames;
+		vector<string> timePointPatientInfos;
+		//!number of time points that are calculated at the same time (0: number of cores)
+		int nrParallelTimePoints;
+		//!shapes of the synthetic phantoms of the benchmark mode
+		vector<string> benchmarkPhantoms;
+		//!edge lengths (in voxels) of the phantoms of the benchmark mode
+		vector<int> benchmarkSizes;
+		//!numbers of bins of the benchmark mode
+		vector<int> benchmarkNrBins;
+		//!integer which states if every feature family is calculated on its own in the benchmark mode
+		int benchmarkFamilies;
+		//!integer which states if all features are calculated together in the benchmark mode
+		int benchmarkEndToEnd;
         //!integer which states if we use fixed bin width
         int useFixedBinWidth;
         float binWidth;
@@ -159,6 +348,8 @@ class ConfigFile{
 		int useUpSampling;
 		int useSamplingCubic;
 		int cubicVoxelSize;
+		//!cubic voxel sizes of the multi-resolution mode, empty if only CubicVoxelSize is calculated
+		vector<int> pyramidVoxelSizes;
 		//! integer which states if resegmentation is used
 		int useReSegmentation;
 		int excludeOutliers;
@@ -177,6 +368,8 @@ class ConfigFile{
 		int coarsenessParam;
 		//!distance defined by user for NGTDM matrices
 		int dist;
+		//!integer which states if maximum diameter, OMBB and convex hull densities are calculated from the convex hull of the whole VOI
+		int convexHullFeatures = 0;
 		string featureSelectionLocation;
 		int calculateAllFeatures = 0;
 		string patientInfoLocation;
@@ -192,6 +385,12 @@ class ConfigFile{
 		int getOneCSVFile;
 		int csvOutput;
 		int ontologyOutput = 0;
+		//!integer which states if the surface mesh of the mask is written to an .obj file
+		int exportMesh = 0;
+		//!integer which states if the stages of the calculation are written to a trace, its format (chrome or jsonl) and file
+		int writeTrace = 0;
+		string traceFormat;
+		string traceFile;
 		//!parameters to calculate the SUV value in case we have a PET image; this values can be set in the patientInfo.ini file
         int useSUV;
         int useSUL;
@@ -209,10 +408,31 @@ class ConfigFile{
 		void getSmoothingKernel();
 		//!get threshold
 		void getThreshold();
+		//!get information if the image is cropped while reading
+		void getCropOnRead();
 		//!get information if we are working with prj file
 		void getAccurateState(string accState);
 		//!get information with what kind of .voi we are working
 		inline void getVoiState(string accState);
+		//!get the ROIs of the RT struct that are used
+		void getRTStructROIs();
+		//!get information if the mask is a label image
+		void getMultiLabel();
+		//!get information about the feature maps
+		void getFeatureMapInformation();
+		void getFeatureCacheInformation();
+		void getTextureMatrixInformation();
+		void getMaskPerturbationInformation();
+		void getImageFilterInformation();
+		void getMultiModalityInformation();
+		//!config of an additional image of the multi-modality mode
+		ConfigFile getModalityConfig(size_t modalityNr) const;
+		void getLongitudinalInformation();
+		//!config of one time point of the longitudinal mode
+		ConfigFile getTimePointConfig(size_t timePointNr) const;
+		void getBenchmarkInformation();
+		//!stop if several calculation modes are set that cannot be combined
+		void checkCalculationModes() const;
 		//! get information about resegmentation
 		inline void getResegmentationState();
 		//!get the location of the featureSelection.ini
@@ -230,6 +450,8 @@ class ConfigFile{
 		void getNGLDMParameters();
 		//! get the NGTDM distance value
 		void getNGTDMdistanceValue();
+		//! get the parameters of the morphological features
+		void getMorphologicalParameters();
         //! read the information about the folders where the images are saved
         void getImageFolder(string imageName, string voiName);
 		//! read information about outputFolder location
@@ -243,6 +465,8 @@ class ConfigFile{
 		void createOutputFile(ConfigFile &config);
 		//! adjusts all values to the attributes in the ConfigFile
 		void createConfigInfo(ConfigFile &config, string arguments[7]);
+		//! adjusts the attributes for the benchmark mode, no image is read
+		void createBenchmarkConfigInfo(ConfigFile &config, string iniName, string outputFolder);
 		void getDemographicInfo(string image);
 		//! tables to create ontology output
 		string patientID;
@@ -276,6 +500,24 @@ class ConfigFile{
 		void createOntologyImageSpaceTable(ConfigFile config);
 };
 
+//entries of a list in the config file (separated by commas, without leading and trailing spaces, empty entries are kept)
+inline vector<string> splitConfigList(const string &list) {
+	vector<string> entries;
+	if (list.empty()) {
+		return entries;
+	}
+	stringstream listStream(list);
+	string entry;
+	while (getline(listStream, entry, ',')) {
+		boost::algorithm::trim(entry);
+		entries.push_back(entry);
+	}
+	if (list.back() == ',') {
+		entries.push_back("");
+	}
+	return entries;
+}
+
 /*!
 The method readIni reads the desired ini-file
 @param[in]: string iniName: path + name of the iniFile (given user)
@@ -305,6 +547,18 @@ inline void ConfigFile::getThreshold() {
 	threshold = pt.get<float>("ThresholdForVOI.threshold", 0.5);
 }
 
+/*!
+The method getCropOnRead reads if only the region around the mask should be read from the image.
+*/
+inline void ConfigFile::getCropOnRead() {
+	config pt = readIni(fileName);
+	cropOnRead = pt.get("ImageProperties.CropOnRead", 0);
+	if (cropOnRead != 0 && cropOnRead != 1) {
+		std::cout << "You inserted a value for CropOnRead that is not 0 or 1, it will be set to 0" << std::endl;
+		cropOnRead = 0;
+	}
+}
+
 /*!
 The method getAccurateState sets the useAccurate value. \n
 If we have a prj file, the value is set to 1. \n
@@ -339,6 +593,306 @@ inline void ConfigFile::getVoiState(string voiState) {
 	}
 }
 
+/*!
+The method getRTStructROIs reads the names of the ROIs that are used from a RT struct file (separated by commas).
+If no name is given, all ROIs are used.
+*/
+inline void ConfigFile::getRTStructROIs() {
+	config pt = readIni(fileName);
+	rtStructROIs = pt.get<std::string>("ImageProperties.RTStructROIs", "");
+}
+
+/*!
+The method getMultiLabel reads if the mask is a label image and how many labels are calculated at the same time.
+*/
+inline void ConfigFile::getMultiLabel() {
+	config pt = readIni(fileName);
+	multiLabel = pt.get("ImageProperties.MultiLabel", 0);
+	if (multiLabel != 0 && multiLabel != 1) {
+		std::cout << "You inserted a value for MultiLabel that is not 0 or 1, it will be set to 0" << std::endl;
+		multiLabel = 0;
+	}
+	nrParallelLabels = pt.get("ImageProperties.NrParallelLabels", 1);
+	if (nrParallelLabels < 0) {
+		nrParallelLabels = 1;
+	}
+}
+
+/*!
+The method getFeatureMapInformation reads if voxel-wise feature maps are calculated and the window that is used for the maps.
+*/
+inline void ConfigFile::getFeatureMapInformation() {
+	config pt = readIni(fileName);
+	featureMaps = pt.get("FeatureMaps.CalculateFeatureMaps", 0);
+	if (featureMaps != 0 && featureMaps != 1) {
+		std::cout << "You inserted a value for CalculateFeatureMaps that is not 0 or 1, it will be set to 0" << std::endl;
+		featureMaps = 0;
+	}
+	featureMapRadius = pt.get("FeatureMaps.WindowRadius", 2);
+	if (featureMapRadius < 1) {
+		std::cout << "The window radius of the feature maps has to be at least 1, it will be set to 2" << std::endl;
+		featureMapRadius = 2;
+	}
+	featureMapShape = pt.get<std::string>("FeatureMaps.WindowShape", "cube");
+	if (featureMapShape != "cube" && featureMapShape != "Cube" && featureMapShape != "sphere" && featureMapShape != "Sphere") {
+		std::cout << "The window shape of the feature maps has to be cube or sphere, it will be set to cube" << std::endl;
+		featureMapShape = "cube";
+	}
+	featureMapFeatures = pt.get<std::string>("FeatureMaps.Features", "");
+	nrThreadsFeatureMaps = pt.get("FeatureMaps.NrThreads", 0);
+	if (nrThreadsFeatureMaps < 0) {
+		nrThreadsFeatureMaps = 0;
+	}
+}
+
+/*!
+The method getFeatureCacheInformation reads if the feature results are cached and where the cache is stored.
+*/
+inline void ConfigFile::getFeatureCacheInformation() {
+	config pt = readIni(fileName);
+	useFeatureCache = pt.get("FeatureCache.UseCache", 0);
+	if (useFeatureCache != 0 && useFeatureCache != 1) {
+		std::cout << "You inserted a value for UseCache that is not 0 or 1, it will be set to 0" << std::endl;
+		useFeatureCache = 0;
+	}
+	featureCacheFolder = pt.get<std::string>("FeatureCache.CacheFolder", "");
+}
+
+/*!
+The method getTextureMatrixInformation reads if the texture matrices are stored or if the features are calculated from stored matrices.
+*/
+inline void ConfigFile::getTextureMatrixInformation() {
+	config pt = readIni(fileName);
+	storeTextureMatrices = pt.get("TextureMatrices.StoreMatrices", 0);
+	if (storeTextureMatrices != 0 && storeTextureMatrices != 1) {
+		std::cout << "You inserted a value for StoreMatrices that is not 0 or 1, it will be set to 0" << std::endl;
+		storeTextureMatrices = 0;
+	}
+	textureMatrixFile = pt.get<std::string>("TextureMatrices.LoadMatrices", "");
+}
+
+/*!
+The method getMaskPerturbationInformation reads if the features of perturbed masks are calculated and which perturbations are used.
+*/
+inline void ConfigFile::getMaskPerturbationInformation() {
+	config pt = readIni(fileName);
+	maskPerturbation = pt.get("MaskPerturbation.CalculatePerturbations", 0);
+	if (maskPerturbation != 0 && maskPerturbation != 1) {
+		std::cout << "You inserted a value for CalculatePerturbations that is not 0 or 1, it will be set to 0" << std::endl;
+		maskPerturbation = 0;
+	}
+	perturbationErosionDilation = pt.get<std::string>("MaskPerturbation.ErosionDilation", "");
+	perturbationTranslation = pt.get("MaskPerturbation.Translation", 0);
+	if (perturbationTranslation < 0) {
+		std::cout << "The translation of the perturbed masks cannot be negative, it will be set to 0" << std::endl;
+		perturbationTranslation = 0;
+	}
+	nrRandomContours = pt.get("MaskPerturbation.NrRandomContours", 0);
+	if (nrRandomContours < 0) {
+		nrRandomContours = 0;
+	}
+	contourProbability = pt.get("MaskPerturbation.ContourProbability", 0.5f);
+	if (contourProbability < 0 || contourProbability > 1) {
+		std::cout << "The probability of the random contours has to be between 0 and 1, it will be set to 0.5" << std::endl;
+		contourProbability = 0.5;
+	}
+	perturbationSeed = pt.get("MaskPerturbation.RandomSeed", 1);
+}
+
+/*!
+The method getImageFilterInformation reads if the features of filtered image spaces (LoG and wavelet) are calculated and which filters are used.
+*/
+inline void ConfigFile::getImageFilterInformation() {
+	config pt = readIni(fileName);
+	imageFilters = pt.get("ImageFilters.CalculateImageFilters", 0);
+	if (imageFilters != 0 && imageFilters != 1) {
+		std::cout << "You inserted a value for CalculateImageFilters that is not 0 or 1, it will be set to 0" << std::endl;
+		imageFilters = 0;
+	}
+	logSigmas = pt.get<std::string>("ImageFilters.LoGSigma", "");
+	waveletName = pt.get<std::string>("ImageFilters.Wavelet", "");
+	waveletSubbands = pt.get<std::string>("ImageFilters.WaveletSubbands", "");
+	calculateOriginalSpace = pt.get("ImageFilters.CalculateOriginal", 1);
+	if (calculateOriginalSpace != 0 && calculateOriginalSpace != 1) {
+		std::cout << "You inserted a value for CalculateOriginal that is not 0 or 1, it will be set to 1" << std::endl;
+		calculateOriginalSpace = 1;
+	}
+	nrParallelImageSpaces = pt.get("ImageFilters.NrParallelImageSpaces", 1);
+	if (nrParallelImageSpaces < 0) {
+		nrParallelImageSpaces = 1;
+	}
+}
+
+/*!
+The method getMultiModalityInformation reads the additional images of the multi-modality mode and their config files.
+Empty image names are replaced by the image of the command line, empty config file names by this config file.
+*/
+inline void ConfigFile::getMultiModalityInformation() {
+	config pt = readIni(fileName);
+	modalityImageNames.clear();
+	modalityConfigFiles.clear();
+	vector<string> configNames = splitConfigList(pt.get<std::string>("MultiModality.ConfigFiles", ""));
+	vector<string> imageNames = splitConfigList(pt.get<std::string>("MultiModality.ImageNames", ""));
+	for (size_t i = 0; i < configNames.size(); i++) {
+		modalityConfigFiles.push_back(configNames[i].empty() ? fileName : configNames[i]);
+		modalityImageNames.push_back(i >= imageNames.size() || imageNames[i].empty() ? imageName : imageNames[i]);
+	}
+}
+
+/*!
+The method getModalityConfig creates the config of an additional image of the multi-modality mode: the image type and the settings of the
+preprocessing (smoothing, interpolation, resegmentation) and of the discretization are read from the config file of the image,
+all other settings (mask, output, feature calculation) are taken from this config.
+@param[in] modalityNr: number of the additional image
+*/
+inline ConfigFile ConfigFile::getModalityConfig(size_t modalityNr) const {
+	ConfigFile modalityConfig = *this;
+	modalityConfig.modalityImageNames.clear();
+	modalityConfig.modalityConfigFiles.clear();
+	modalityConfig.readIni(modalityConfigFiles[modalityNr]);
+	modalityConfig.getImageFolder(modalityImageNames[modalityNr], voiName);
+	modalityConfig.getResegmentationState();
+	modalityConfig.getSmoothingKernel();
+	modalityConfig.getDiscretizationInformation();
+	modalityConfig.getDiscretizationInformationIVH();
+	modalityConfig.getPETimageInformation(modalityImageNames[modalityNr], patientInfoLocation, modalityConfig);
+	modalityConfig.getInterpolation();
+	return modalityConfig;
+}
+
+/*!
+The method getLongitudinalInformation reads the follow-up time points of the longitudinal mode. The image and mask of the command line are
+the first time point (BaselineName, default: baseline), the lists Images and Masks contain the other time points (the same number of entries).
+TimePoints are the names of the other time points (default: followupN), PatientInfos their patient info files (empty: the patient info
+file of the command line).
+*/
+inline void ConfigFile::getLongitudinalInformation() {
+	config pt = readIni(fileName);
+	timePointImages.clear();
+	timePointMasks.clear();
+	timePointNames.clear();
+	timePointPatientInfos.clear();
+	vector<string> images = splitConfigList(pt.get<std::string>("Longitudinal.Images", ""));
+	vector<string> masks = splitConfigList(pt.get<std::string>("Longitudinal.Masks", ""));
+	vector<string> names = splitConfigList(pt.get<std::string>("Longitudinal.TimePoints", ""));
+	vector<string> patientInfos = splitConfigList(pt.get<std::string>("Longitudinal.PatientInfos", ""));
+	nrParallelTimePoints = pt.get("Longitudinal.NrParallelTimePoints", 0);
+	if (nrParallelTimePoints < 0) {
+		nrParallelTimePoints = 0;
+	}
+	if (images.empty()) {
+		return;
+	}
+	if (images.size() != masks.size()) {
+		std::cout << "The number of images and masks of the time points is not the same, the time points are not calculated" << std::endl;
+		return;
+	}
+	timePointImages.push_back(imageName);
+	timePointMasks.push_back(voiName);
+	timePointNames.push_back(pt.get<std::string>("Longitudinal.BaselineName", "baseline"));
+	timePointPatientInfos.push_back(patientInfoLocation);
+	for (size_t i = 0; i < images.size(); i++) {
+		timePointImages.push_back(images[i]);
+		timePointMasks.push_back(masks[i]);
+		timePointNames.push_back(i < names.size() && !names[i].empty() ? names[i] : "followup" + to_string(i + 1));
+		timePointPatientInfos.push_back(i < patientInfos.size() && !patientInfos[i].empty() ? patientInfos[i] : patientInfoLocation);
+	}
+}
+
+/*!
+The method getTimePointConfig creates the config of one time point of the longitudinal mode: image, mask and patient info are the ones of
+the time point, the output is extended by _ and the name of the time point, all other settings are taken from this config.
+@param[in] timePointNr: number of the time point (0: image and mask of the command line)
+*/
+inline ConfigFile ConfigFile::getTimePointConfig(size_t timePointNr) const {
+	ConfigFile timePointConfig = *this;
+	timePointConfig.timePointImages.clear();
+	timePointConfig.timePointMasks.clear();
+	timePointConfig.timePointNames.clear();
+	timePointConfig.timePointPatientInfos.clear();
+	timePointConfig.modalityImageNames.clear();
+	timePointConfig.modalityConfigFiles.clear();
+	timePointConfig.patientInfoLocation = timePointPatientInfos[timePointNr];
+	//the rescaling of nifti images and the PET information can differ between the time points
+	timePointConfig.getImageFolder(timePointImages[timePointNr], timePointMasks[timePointNr]);
+	timePointConfig.getPETimageInformation(timePointImages[timePointNr], timePointPatientInfos[timePointNr], timePointConfig);
+	timePointConfig.outputFolder = outputFolder + "_" + timePointNames[timePointNr];
+	return timePointConfig;
+}
+
+/*!
+The method checkCalculationModes stops the program if more than one calculation mode is set (see Calculation modes), as every mode
+calculates the case on its own and the other modes would be ignored.
+*/
+inline void ConfigFile::checkCalculationModes() const {
+	vector<string> modes;
+	if (multiLabel == 1) {
+		modes.push_back("ImageProperties.MultiLabel");
+	}
+	if (!textureMatrixFile.empty()) {
+		modes.push_back("TextureMatrices.LoadMatrices");
+	}
+	if (maskPerturbation == 1) {
+		modes.push_back("MaskPerturbation.CalculatePerturbations");
+	}
+	if (imageFilters == 1) {
+		modes.push_back("ImageFilters.CalculateImageFilters");
+	}
+	if (!pyramidVoxelSizes.empty()) {
+		modes.push_back("Interpolation.CubicVoxelSizes");
+	}
+	if (!modalityConfigFiles.empty()) {
+		modes.push_back("MultiModality.ConfigFiles");
+	}
+	if (!timePointImages.empty()) {
+		modes.push_back("Longitudinal.Images");
+	}
+	if (featureMaps == 1 && !textureMatrixFile.empty()) {
+		modes.push_back("FeatureMaps.CalculateFeatureMaps");
+	}
+	if (modes.size() > 1) {
+		std::cout << "The calculation modes ";
+		for (size_t i = 0; i < modes.size(); i++) {
+			std::cout << (i == 0 ? "" : i + 1 == modes.size() ? " and " : ", ") << modes[i];
+		}
+		std::cout << " cannot be combined, only one of them can be set. Program stops." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+}
+
+/*!
+The method getBenchmarkInformation reads the phantoms, sizes and numbers of bins of the benchmark mode (see PhantomBenchmark). Sizes and
+numbers of bins that are not set are taken from the preset (full: 10^3 to 400^3 voxels and 8 to 1024 bins).
+Entries that are not positive numbers are ignored.
+*/
+inline void ConfigFile::getBenchmarkInformation() {
+	config pt = readIni(fileName);
+	benchmarkPhantoms = splitConfigList(pt.get<std::string>("Benchmark.Phantoms", "sphere,ellipsoid,multiLesion,noise"));
+	benchmarkFamilies = pt.get("Benchmark.CalculateFamilies", 1);
+	benchmarkEndToEnd = pt.get("Benchmark.CalculateEndToEnd", 1);
+	string preset = pt.get<std::string>("Benchmark.Preset", "full");
+	if (preset != "full" && preset != "quick") {
+		std::cout << "The benchmark preset " << preset << " is not known, the preset full is used" << std::endl;
+		preset = "full";
+	}
+	vector<string> sizes = splitConfigList(pt.get<std::string>("Benchmark.Sizes", preset == "full" ? "10,25,50,100,200,400" : "10,25,50,100"));
+	vector<string> nrBins = splitConfigList(pt.get<std::string>("Benchmark.NrBins", preset == "full" ? "8,32,128,1024" : "8,32,128"));
+	benchmarkSizes.clear();
+	benchmarkNrBins.clear();
+	for (int list = 0; list < 2; list++) {
+		const vector<string> &entries = list == 0 ? sizes : nrBins;
+		for (size_t i = 0; i < entries.size(); i++) {
+			stringstream entryStream(entries[i]);
+			int value = 0;
+			if (!(entryStream >> value) || value <= 0) {
+				std::cout << "The benchmark entry " << entries[i] << " is not a positive number, it is ignored" << std::endl;
+				continue;
+			}
+			(list == 0 ? benchmarkSizes : benchmarkNrBins).push_back(value);
+		}
+	}
+}
+
 /*!
 The method getResegmentationState reads the provided resampling information. 
 */
@@ -499,7 +1053,29 @@ inline void ConfigFile::getInterpolation() {
 			useUpSampling = 0;
 		}
 	}
-
+	pyramidVoxelSizes.clear();
+	string voxelSizeList = pt.get<std::string>("Interpolation.CubicVoxelSizes", "");
+	boost::char_separator<char> separator(", ");
+	boost::tokenizer<boost::char_separator<char> > voxelSizes(voxelSizeList, separator);
+	for (boost::tokenizer<boost::char_separator<char> >::iterator it = voxelSizes.begin(); it != voxelSizes.end(); ++it) {
+		//the voxel sizes name the outputs, so they have to be integers: 1.5 must not be calculated as 1
+		char *end = nullptr;
+		double value = strtod(it->c_str(), &end);
+		if (*end != '\0' || !(value > 0) || value != std::floor(value) || value > double(std::numeric_limits<int>::max())) {
+			std::cout << "The cubic voxel size " << *it << " in CubicVoxelSizes is not a positive integer (in mm). Program stops." << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		int voxelSize = int(value);
+		if (std::find(pyramidVoxelSizes.begin(), pyramidVoxelSizes.end(), voxelSize) != pyramidVoxelSizes.end()) {
+			std::cout << "The cubic voxel size " << voxelSize << " is set more than once in CubicVoxelSizes. Program stops." << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		pyramidVoxelSizes.push_back(voxelSize);
+	}
+	if (!pyramidVoxelSizes.empty() && useSamplingCubic != 1) {
+		std::cout << "CubicVoxelSizes is only used if UseSamplingToCubic is 1, only one voxel size is calculated" << std::endl;
+		pyramidVoxelSizes.clear();
+	}
 }
 
 /*!
@@ -535,6 +1111,11 @@ inline void ConfigFile::getNGLDMParameters() {
 	coarsenessParam = pt.get("NGLDMParameters.coarseness", 0);
 }
 
+inline void ConfigFile::getMorphologicalParameters() {
+	config pt = readIni(fileName);
+	convexHullFeatures = pt.get("MorphologicalParameters.ConvexHullFeatures", 0);
+}
+
 /*!
 The method getImageFolder gets the image and voi path information the user provided in the command line. \n
 Furthermore it reads the image type.
@@ -635,6 +1216,14 @@ inline void ConfigFile::getOutputInformation(string output) {
 	ontologyOutput = pt.get("OutputInformation.OntologyOutput", 1);
 	getOneCSVFile = pt.get("OutputInformation.GetOneCSVFile", 1);
 	overWriteCSV = pt.get("OutputInformation.OverwriteCSV", 1);
+	exportMesh = pt.get("OutputInformation.ExportMesh", 0);
+	writeTrace = pt.get("OutputInformation.WriteTrace", 0);
+	traceFormat = pt.get<std::string>("OutputInformation.TraceFormat", "chrome");
+	if (traceFormat != "chrome" && traceFormat != "jsonl") {
+		std::cout << "The trace format " << traceFormat << " is not available (chrome, jsonl), the chrome format is used" << std::endl;
+		traceFormat = "chrome";
+	}
+	traceFile = output + (traceFormat == "jsonl" ? "_trace.jsonl" : "_trace.json");
 	if (csvOutput == 0 && getOneCSVFile == 1) {
 		std::cout << "The CSVOutput is set to 0, but getOneCSVFile is set to 1. The CSVOutput is still generated" << std::endl;
 		csvOutput = 1;
@@ -801,10 +1390,20 @@ inline void ConfigFile::createConfigInfo(ConfigFile &config, string arguments[8]
 	config.getAccurateState(arguments[4]);
 
 	config.getVoiState(arguments[5]);
+	config.getRTStructROIs();
+	config.getMultiLabel();
+	config.getFeatureMapInformation();
+	config.getFeatureCacheInformation();
+	config.getTextureMatrixInformation();
+	config.getMaskPerturbationInformation();
+	config.getImageFilterInformation();
 	config.getImageFolder(arguments[1], arguments[2]);
+	config.getMultiModalityInformation();
+	config.getLongitudinalInformation();
 	config.getResegmentationState();
 	config.getOutputInformation(arguments[3]);
 	config.getSmoothingKernel();
+	config.getCropOnRead();
 	config.getFeatureSelectionLocation(arguments[7]);
 	config.getDiscretizationInformation();
 	config.getDiscretizationInformationIVH();
@@ -814,6 +1413,8 @@ inline void ConfigFile::createConfigInfo(ConfigFile &config, string arguments[8]
 	config.getExtendedEmphasisInformation();
 	config.getNGLDMParameters();
 	config.getNGTDMdistanceValue();
+	config.getMorphologicalParameters();
+	config.checkCalculationModes();
 	
 	if (config.ontologyOutput == 1) {
 		
@@ -867,6 +1468,53 @@ inline void ConfigFile::createConfigInfo(ConfigFile &config, string arguments[8]
 	}
 }
 
+/*!
+The method createBenchmarkConfigInfo adjusts the attributes for the benchmark mode: the preprocessing and feature settings are read from the
+ini-file like in createConfigInfo. The phantoms are created in memory, so all settings that concern the image file, the PET conversion
+and the other calculation modes are switched off; the output is always one csv file.
+@param[in]: string iniName: path + name of the iniFile
+@param[in]: string outputFolder: output of the benchmark, the results are written to outputFolder_benchmark.csv
+*/
+inline void ConfigFile::createBenchmarkConfigInfo(ConfigFile &config, string iniName, string outputFolder) {
+	config.readIni(iniName);
+	config.getThreshold();
+	config.getResegmentationState();
+	config.getOutputInformation(outputFolder);
+	config.getSmoothingKernel();
+	config.getDiscretizationInformation();
+	config.getDiscretizationInformationIVH();
+	config.getInterpolation();
+	config.getDistanceWeightProperties();
+	config.getExtendedEmphasisInformation();
+	config.getNGLDMParameters();
+	config.getNGTDMdistanceValue();
+	config.getMorphologicalParameters();
+	config.getBenchmarkInformation();
+	config.imageName = "phantom";
+	config.voiName = "phantom";
+	config.imageType = "CT";
+	config.patientInfoLocation = "0";
+	config.niftiSlope = 1;
+	config.niftiIntercept = 0;
+	config.useAccurate = 0;
+	config.voiFile = 0;
+	config.cropOnRead = 0;
+	config.multiLabel = 0;
+	config.featureMaps = 0;
+	config.useFeatureCache = 0;
+	config.storeTextureMatrices = 0;
+	config.textureMatrixFile = "";
+	config.maskPerturbation = 0;
+	config.imageFilters = 0;
+	config.pyramidVoxelSizes.clear();
+	config.csvOutput = 1;
+	config.getOneCSVFile = 1;
+	config.ontologyOutput = 0;
+	config.overWriteCSV = 1;
+	config.exportMesh = 0;
+	config.calculateAllFeatures = 1;
+}
+
 /*!
 The method createOutputFolder creates the outputFolder, if it does not already exists.\n
 If it exists, a warning message is printed on the screen, that the data will be overwritten
@@ -939,7 +1587,12 @@ inline void ConfigFile::createOntologyImageFilterSpaceTable(ConfigFile config) {
 	std::ofstream imageFilterSpace;
 	imageFilterSpace.open(name);
 	imageFilterSpace << "ImageFilterSpace_name, WaveletFilterParameters_name\n";
-	imageFilterSpace << " " << "," << " ";
+	//the wavelet spaces are named wavelet_wavelet name_sub-band
+	string waveletParameters = " ";
+	if (config.imageSpaceName.compare(0, 8, "wavelet_") == 0) {
+		waveletParameters = config.imageSpaceName.substr(8);
+	}
+	imageFilterSpace << (config.imageSpaceName.empty() ? " " : config.imageSpaceName) << "," << waveletParameters;
 
 	imageFilterSpace.close();
 
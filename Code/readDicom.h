@@ -1,18 +1,20 @@
 #ifndef _READDICOM_H_
 #define _READDICOM_H_
 #include "readImages.h"
+#include "dicomIndex.h"
+#include "rtStruct.h"
 #include "itkSpatialObject.h"
 
 namespace gdcm { class Reader; }
 
 ImageType::Pointer readDicom(string prjPath);
+vector<string> getDicomFileNames(string path);
+void printDicomSeries(const DicomIndex &dicomIndex);
+ImageType::Pointer readDicomRegion(string path, RegionType region);
 ImageType::Pointer resetImage(ImageType *mask);
 void trim(std::string &str);
-void reset2DImage(ImageSliceType::Pointer imageSlice);
-void mergeImages(ImageSliceType::Pointer tempSlice, ImageType::Pointer finalImage, int iRequiredSlice);
-void insertRegion(GroupType * group, ImageType::Pointer finalImage, int iSlice);
 void writeFile(ImageType::Pointer mask, std::string outputFileName);
-ImageType::Pointer readRTstruct(string voiPath, ImageType *imageDicom, ImageType *mask);
+ImageType::Pointer readRTstruct(string voiPath, ImageType *imageDicom, ConfigFile config);
 #include "readDicom.cpp"
 
 #endif
\ No newline at end of file
@@ -54,6 +54,107 @@ ImageType::Pointer getImageMasked(ImageType *image, RegionType boundingBoxRegion
 	return imageMask;
 }
 
+/*!
+The method readImageRegion reads only the given region of the image. \n
+The region of interest filter requests only this region from the reader, so for file formats that support streaming
+(e.g. uncompressed nifti) only the required part of the file is read.
+@param[in]: string imageName: the name of the image that should be read
+@param[in]: RegionType region: region of the image that is needed
+@param[out]: ITK image of the region
+*/
+ImageType::Pointer readImageRegion(string imageName, RegionType region) {
+	typename ReaderType::Pointer reader = ReaderType::New();
+	reader->SetFileName(imageName);
+	FilterType::Pointer filter = FilterType::New();
+	filter->SetRegionOfInterest(region);
+	filter->SetInput(reader->GetOutput());
+	try {
+		filter->Update();
+	}
+	catch (itk::ExceptionObject &excp) {
+		std::cerr << excp << std::endl;
+	}
+	return filter->GetOutput();
+}
+
+/*!
+The method getValueMargin determines the margin (in mm) around the mask in which the preprocessed image values are needed: \n
+- local intensity features: radius of the 1 cm3 sphere (6.2 mm) \n
+- interpolation: one voxel of the new voxel size (the largest one in the multi-resolution mode) \n
+- image filters: the width of the largest LoG filter (see ImageFilters)
+@param[in]: ConfigFile config: config file with all information of the config.ini file
+@param[out]: margin in mm
+*/
+float getValueMargin(ConfigFile config) {
+	float margin = localIntensityRadius;
+	if (config.useSamplingCubic == 1) {
+		int voxelSize = config.cubicVoxelSize;
+		for (size_t i = 0; i < config.pyramidVoxelSizes.size(); i++) {
+			voxelSize = std::max(voxelSize, config.pyramidVoxelSizes[i]);
+		}
+		margin += float(voxelSize);
+	}
+	ImageFilters imageFilters;
+	imageFilters.configure(config);
+	margin += imageFilters.getMarginMM();
+	return margin;
+}
+
+/*!
+The method getCropMargin determines the margin (in mm) that is needed around the mask, so that cropping the image before
+smoothing and interpolation does not change the values inside the mask: \n
+the margin of getValueMargin plus nrSigmaSmoothing times the Gaussian kernel, which is read by the smoothing
+@param[in]: ConfigFile config: config file with all information of the config.ini file
+@param[out]: margin in mm
+*/
+float getCropMargin(ConfigFile config) {
+	return getValueMargin(config) + nrSigmaSmoothing * std::max(config.smoothingKernel, 0.0f);
+}
+
+/*!
+The method getPaddedRegion adds a margin to a region. The margin is given in mm plus a number of voxels. \n
+The padded region is limited to limitRegion. If the region is empty, limitRegion is returned.
+@param[in]: RegionType region: region that is padded
+@param[in]: RegionType limitRegion: the padded region is not larger than this region (usually the region of the image)
+@param[in]: spacing: voxel spacing of the image
+@param[in]: float marginMM: margin in mm
+@param[in]: long nrVoxels: number of voxels added to the margin
+@param[out]: RegionType paddedRegion: padded region
+*/
+RegionType getPaddedRegion(const RegionType &region, const RegionType &limitRegion, const ImageType::SpacingType &spacing, float marginMM, long nrVoxels) {
+	RegionType paddedRegion = limitRegion;
+	for (int i = 0; i < 3; i++) {
+		if (region.GetSize()[i] == 0) {
+			return limitRegion;
+		}
+		long margin = long(ceil(marginMM / spacing[i])) + nrVoxels;
+		long firstIndex = std::max(long(region.GetIndex()[i]) - margin, long(limitRegion.GetIndex()[i]));
+		long lastIndex = std::min(long(region.GetIndex()[i] + region.GetSize()[i]) + margin,
+			long(limitRegion.GetIndex()[i] + limitRegion.GetSize()[i]));
+		paddedRegion.SetIndex(i, firstIndex);
+		paddedRegion.SetSize(i, lastIndex - firstIndex);
+	}
+	return paddedRegion;
+}
+
+/*!
+The method getCropRegion determines the region of the image that has to be read: the bounding box of the mask
+plus the margin from getCropMargin and some voxels for the interpolation kernel and the wavelet filters. \n
+The region is limited to the size of the mask image.
+If the mask is empty, the whole image region is returned.
+@param[in]: ImageType mask: ITK mask
+@param[in]: ConfigFile config: config file with all information of the config.ini file
+@param[out]: RegionType cropRegion: region of the image that is needed for the feature calculation
+*/
+RegionType getCropRegion(ImageType *mask, ConfigFile config) {
+	MaskAnalysis maskAnalysis;
+	maskAnalysis.analyse(mask, config.threshold);
+	ImageFilters imageFilters;
+	imageFilters.configure(config);
+	return getPaddedRegion(maskAnalysis.nonZeroRegion, mask->GetLargestPossibleRegion(), mask->GetSpacing(),
+		getCropMargin(config), nrCropVoxelsInterpolation + imageFilters.getMarginVoxels());
+}
+
 /*!
 The method getMaskNewSpacing changes the spacing of the mask, so that it fits with the spacing of the image
 @param[in]: ImageType imageFiltered: ITK image
@@ -113,6 +214,39 @@ ImageType::Pointer smoothImage(ImageType *image, float kernel) {
 	return filterZ->GetOutput();
 }
 
+/*!
+The method smoothImageRegion smoothes the image only in the region around the mask. \n
+The region where smoothed values are needed (bounding box of the mask plus the margin of getValueMargin) is cut from the image
+together with nrSigmaSmoothing times the kernel around it. Only this part is smoothed with smoothImage, the recursive Gaussian
+filters of ITK split the lines of every direction between the threads. Afterwards the smoothed values are copied back into the image,
+the image outside of the region keeps its original values. \n
+The image is changed in place, image and mask have to have the same grid.
+@param[in,out]: ImageType image: ITK image
+@param[in]: RegionType maskRegion: bounding box of the mask (see MaskAnalysis)
+@param[in]: ConfigFile config: config file with all information of the config.ini file
+*/
+void smoothImageRegion(ImageType *image, const RegionType &maskRegion, ConfigFile config) {
+	if (config.smoothingKernel <= 0) {
+		return;
+	}
+	const RegionType &imageRegion = image->GetBufferedRegion();
+	const ImageType::SpacingType &spacing = image->GetSpacing();
+	RegionType valueRegion = getPaddedRegion(maskRegion, imageRegion, spacing, getValueMargin(config), nrCropVoxelsInterpolation);
+	RegionType inputRegion = getPaddedRegion(valueRegion, imageRegion, spacing, nrSigmaSmoothing * config.smoothingKernel, 0);
+	ImageType::Pointer inputImage = getImageMasked(image, inputRegion);
+	ImageType::Pointer smoothedImage = smoothImage(inputImage, config.smoothingKernel);
+	//the cut image starts at index 0, so the region of the values is shifted by the start of the input region
+	RegionType smoothedRegion = valueRegion;
+	for (int i = 0; i < 3; i++) {
+		smoothedRegion.SetIndex(i, valueRegion.GetIndex()[i] - inputRegion.GetIndex()[i]);
+	}
+	itk::ImageRegionConstIterator<ImageType> smoothedIt(smoothedImage, smoothedRegion);
+	itk::ImageRegionIterator<ImageType> imageIt(image, valueRegion);
+	for (smoothedIt.GoToBegin(), imageIt.GoToBegin(); !imageIt.IsAtEnd(); ++smoothedIt, ++imageIt) {
+		imageIt.Set(smoothedIt.Get());
+	}
+}
+
 /*!
 The method getImageSizeInterpolated determines the new image size after interpolation to cubic voxels
 That is necessary, as I need the image size to determine the size of the boost::multi_array
@@ -199,6 +333,120 @@ vector<int> getImageSizeInterpolated(ImageType *imageFiltered, ImageType::SizeTy
 	return newImageSize;
 }
 
+/*!
+\brief resampleMaskRegion
+The method resampleMaskRegion resamples image and mask to the new voxel size, but only in the region of the mask. \n
+The grid of the resampled image is the same as if the whole image was resampled (see getImageSizeInterpolated and
+getResampledOrigin), only the part of the grid around the mask is calculated: the bounding box of the mask plus one
+original voxel in every direction (the linearly interpolated mask is 0 further away). \n
+Image and mask are cut before resampling with a margin for the interpolation kernel, so that the values in this region
+are the same as after resampling the whole image. For spline interpolation the margin is larger, because the spline
+coefficients depend on the whole image (their influence decreases exponentially with the distance).
+@param[in,out] image: ITK image, replaced by the resampled region
+@param[in,out] mask: ITK mask, replaced by the resampled region
+@param[in] maskRegion: region of the non zero voxels of the mask
+@param[in] ConfigFile config: config file with all information of the config.ini file
+*/
+void resampleMaskRegion(ImageType::Pointer &image, ImageType::Pointer &mask, const RegionType &maskRegion, ConfigFile config) {
+	resampleMaskRegion(image, mask, maskRegion, getResampleGrid(image, config), config);
+}
+
+/*!
+\brief getResampleGrid
+The method getResampleGrid determines spacing, origin and size of the resampled image, as if the whole image was resampled.
+@param[in] image: ITK image
+@param[in] ConfigFile config: config file with all information of the config.ini file
+@param[out] ResampleGrid: grid of the resampled image
+*/
+ResampleGrid getResampleGrid(ImageType *image, ConfigFile config) {
+	ResampleGrid grid;
+	vector<int> newImageSize = getImageSizeInterpolated(image, image->GetLargestPossibleRegion().GetSize(), grid.spacing, config);
+	for (int i = 0; i < 3; i++) {
+		grid.size[i] = (unsigned long)newImageSize[i];
+	}
+	Image<float, 3> imageResample(1, 1, 1);
+	grid.origin = imageResample.getResampledOrigin(image, grid.spacing, grid.size, config.rebinning_centering);
+	return grid;
+}
+
+/*!
+\brief getImageGeometry
+The method getImageGeometry returns an image with the region, spacing, origin and direction of the image, but without voxel values. \n
+If only the region around the mask is read (CropOnRead), the resampling grid is determined from this image (see getResampleGrid),
+so that it is the same as if the whole image was read.
+@param[in] image: ITK image
+@param[out] ImageType: image with the grid of the image
+*/
+ImageType::Pointer getImageGeometry(ImageType *image) {
+	ImageType::Pointer geometry = ImageType::New();
+	geometry->SetRegions(image->GetLargestPossibleRegion());
+	geometry->SetSpacing(image->GetSpacing());
+	geometry->SetOrigin(image->GetOrigin());
+	geometry->SetDirection(image->GetDirection());
+	return geometry;
+}
+
+/*!
+\brief resampleMaskRegion
+Like resampleMaskRegion above, but the grid is given. So image and mask can already be cut from a larger image
+(e.g. for every label of a label image), the resampled region is still part of the grid of the whole image.
+@param[in] grid: grid of the resampled whole image (see getResampleGrid)
+*/
+void resampleMaskRegion(ImageType::Pointer &image, ImageType::Pointer &mask, const RegionType &maskRegion, const ResampleGrid &grid, ConfigFile config) {
+	const RegionType &imageRegion = image->GetLargestPossibleRegion();
+	double outputSpacing[3] = { grid.spacing[0], grid.spacing[1], grid.spacing[2] };
+	itk::Size<3> outputSize = grid.size;
+	Image<float, 3> imageResample(1, 1, 1);
+	ImageType::PointType outputOrigin = grid.origin;
+	if (maskRegion.GetNumberOfPixels() == 0) {
+		image = imageResample.resampleToGrid(image, outputSpacing, outputOrigin, outputSize, config.interpolationMethod);
+		mask = imageResample.resampleToGrid(mask, outputSpacing, outputOrigin, outputSize, "Linear");
+		return;
+	}
+	const ImageType::PointType &inputOrigin = image->GetOrigin();
+	const ImageType::SpacingType &inputSpacing = image->GetSpacing();
+	const ImageType::DirectionType &direction = image->GetDirection();
+	int margin = nrCropVoxelsInterpolation;
+	if (config.interpolationMethod == "Spline" || config.interpolationMethod == "spline") {
+		margin = nrCropVoxelsSpline;
+	}
+	RegionType inputRegion;
+	itk::Size<3> regionSize;
+	double firstVoxel[3];
+	for (int i = 0; i < 3; i++) {
+		//both grids have the same direction, so the position along every image axis can be compared directly
+		double offset = 0;
+		for (int j = 0; j < 3; j++) {
+			offset += direction[j][i] * (inputOrigin[j] - outputOrigin[j]);
+		}
+		//resampled voxels between the original voxels before and after the mask
+		double first = (offset + (maskRegion.GetIndex()[i] - 1) * inputSpacing[i]) / outputSpacing[i];
+		double last = (offset + (maskRegion.GetIndex()[i] + long(maskRegion.GetSize()[i])) * inputSpacing[i]) / outputSpacing[i];
+		long firstOutput = std::max(long(floor(first)), 0L);
+		long lastOutput = std::min(long(ceil(last)), long(outputSize[i]) - 1);
+		lastOutput = std::max(lastOutput, firstOutput);
+		regionSize[i] = lastOutput - firstOutput + 1;
+		firstVoxel[i] = firstOutput * outputSpacing[i];
+		//original voxels that are needed to interpolate these voxels
+		long firstInput = long(floor((firstOutput * outputSpacing[i] - offset) / inputSpacing[i])) - margin;
+		long lastInput = long(ceil((lastOutput * outputSpacing[i] - offset) / inputSpacing[i])) + margin;
+		firstInput = std::max(firstInput, long(imageRegion.GetIndex()[i]));
+		lastInput = std::min(lastInput, long(imageRegion.GetIndex()[i] + imageRegion.GetSize()[i]) - 1);
+		inputRegion.SetIndex(i, firstInput);
+		inputRegion.SetSize(i, std::max(lastInput - firstInput + 1, 1L));
+	}
+	ImageType::PointType regionOrigin = outputOrigin;
+	for (int j = 0; j < 3; j++) {
+		for (int i = 0; i < 3; i++) {
+			regionOrigin[j] += direction[j][i] * firstVoxel[i];
+		}
+	}
+	ImageType::Pointer imageRegionCut = getImageMasked(image, inputRegion);
+	ImageType::Pointer maskRegionCut = getImageMasked(mask, inputRegion);
+	image = imageResample.resampleToGrid(imageRegionCut, outputSpacing, regionOrigin, regionSize, config.interpolationMethod);
+	mask = imageResample.resampleToGrid(maskRegionCut, outputSpacing, regionOrigin, regionSize, "Linear");
+}
+
 /*!
 \brief maskValues2One
 After resampling, the mask can contain intensity values from 0-1
@@ -5,6 +5,8 @@
 #include "readInFeatureSelection.h"
 #include "morphologicalFeatures.h"
 #include "itkTypes.h"
+#include "maskAnalysis.h"
+#include "imageFilters.h"
 #include <fstream>
 #include <iterator>
 #include <algorithm>
@@ -16,12 +18,42 @@ using namespace itkTypes;
 /*! \file */
 //    define the types we will use later for reading the image and getting a specific region
 
+//radius (in mm) of the 1 cm3 sphere of the local intensity features, needed as margin if the image is cropped while reading
+const float localIntensityRadius = 6.2f;
+//number of voxels added to the margin for the interpolation kernel
+const int nrCropVoxelsInterpolation = 2;
+//number of voxels added to the margin for spline interpolation (the influence of the border on the spline coefficients is then below 1e-6)
+const int nrCropVoxelsSpline = 12;
+//the Gaussian smoothing reads the image up to nrSigmaSmoothing times the kernel around the region that is smoothed
+const float nrSigmaSmoothing = 4.0f;
+
 ImageType::Pointer readImage(string imageName);
 RegionType getBoundingBoxMask(ImageType *mask);
 ImageType::Pointer getImageMasked(ImageType *image, RegionType boundingBoxRegion);
+//read only a part of the image
+ImageType::Pointer readImageRegion(string imageName, RegionType region);
+//get the region around the mask that is needed for the feature calculation
+float getValueMargin(ConfigFile config);
+float getCropMargin(ConfigFile config);
+RegionType getPaddedRegion(const RegionType &region, const RegionType &limitRegion, const ImageType::SpacingType &spacing, float marginMM, long nrVoxels);
+RegionType getCropRegion(ImageType *mask, ConfigFile config);
 ImageType::Pointer getMaskNewSpacing(ImageType *imageFiltered, ImageType *maskFiltered);
 ImageType::Pointer smoothImage(ImageType *image, float kernel);
+//smooth the image only in the region around the mask
+void smoothImageRegion(ImageType *image, const RegionType &maskRegion, ConfigFile config);
 vector<int> getImageSizeInterpolated(ImageType *imageFiltered, ImageType::SizeType imageSize, double (&outputSpacing)[3], ConfigFile config);
+//grid of the resampled image (spacing, origin and size), the same as if the whole image was resampled
+struct ResampleGrid {
+	double spacing[3];
+	ImageType::PointType origin;
+	itk::Size<3> size;
+};
+ResampleGrid getResampleGrid(ImageType *image, ConfigFile config);
+//image without voxel values that keeps the grid of the whole image after the image was cut
+ImageType::Pointer getImageGeometry(ImageType *image);
+//resample image and mask only in the region around the mask
+void resampleMaskRegion(ImageType::Pointer &image, ImageType::Pointer &mask, const RegionType &maskRegion, ConfigFile config);
+void resampleMaskRegion(ImageType::Pointer &image, ImageType::Pointer &mask, const RegionType &maskRegion, const ResampleGrid &grid, ConfigFile config);
 //change values inside mask to 1
 ImageType::Pointer maskValues2One(ImageType *originalMask);
 
@@ -65,12 +65,31 @@ This matrices contain information about the coarseness of the VOI.
 
 
 
+/*!
+The function calculateFamily calculates one feature family with the feature cache: if the output of the family is in the cache
+(see FeatureCache::replayFamily), it is written from the cache, otherwise calculate is called and the output it writes is stored in the cache.
+@param[in,out] featureCache: feature cache of the image
+@param[in] familyName: name of the feature family (section of the feature selection file)
+@param[in] selected: true if the features of the family are calculated, otherwise only their writers are called
+@param[in] calculate: calculates and writes the features of the family
+*/
+template <class F>
+void calculateFamily(FeatureCache &featureCache, const string &familyName, bool selected, F calculate) {
+	if (featureCache.replayFamily(familyName, selected)) {
+		return;
+	}
+	featureCache.begin();
+	calculate();
+	featureCache.storeFamily(familyName, selected);
+}
+
 /*!
 In the function CalculateRelFeatures, all features that do not require interpolation are calculated. \n
 If one feature group should not be calculated, this group is skipped from the calculation \n
-The feature values are stored in the outputfile set by the user.
+The feature values are stored in the outputfile set by the user. The morphological features use the labelled mask lesions,
+they are skipped if no lesions are given.
 */
-void CalculateRelFeatures(Image<float, 3> imageAttr, ConfigFile config)
+void CalculateRelFeatures(const Image<float, 3> &imageAttr, const LesionLabels *lesions, const ConfigFile &config, FeatureCache &featureCache)
 {
 	int a =1;
 	int morph;
@@ -106,84 +125,102 @@ void CalculateRelFeatures(Image<float, 3> imageAttr, ConfigFile config)
 		
 	}
 	
-	MorphologicalFeatures<float, 3> morphFeat;
-	std::cout << "morph" << std::endl;
-	if (morph == a || config.calculateAllFeatures == 1) {
-		std::cout << "here" << std::endl;
-		morphFeat.calculateAllMorphologicalFeatures(morphFeat, imageAttr, config);
-		string forLog = "Morphological features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-		std::cout << "Morphological features are calculated" << std::endl;
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		morphFeat.writeCSVFileMorphological(morphFeat, config.outputFolder, config);
+	//without lesions (the additional images of the multi-modality mode) the morphological features are neither calculated nor written
+	if (lesions != nullptr) {
+		calculateFamily(featureCache, "MorphologicalFeatures", config.calculateAllFeatures == 1 || morph == a, [&]() {
+			TraceStage familyStage(config, "MorphologicalFeatures", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+			MorphologicalFeatures<float, 3> morphFeat;
+			if (morph == a || config.calculateAllFeatures == 1) {
+				morphFeat.calculateAllMorphologicalFeatures(morphFeat, imageAttr, *lesions, config);
+				string forLog = "Morphological features were calculated.";
+				writeLogFile(config.outputFolder, forLog);
+				std::cout << "Morphological features are calculated" << std::endl;
+			}
+			familyStage.next("MorphologicalFeatures writer", "writer");
+			if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+				morphFeat.writeCSVFileMorphological(morphFeat, config.outputFolder, config);
 		
-	}
-	else if (config.csvOutput == 1 && config.getOneCSVFile == 1) {
-		morphFeat.writeOneFileMorphological(morphFeat, config);
+			}
+			else if (config.csvOutput == 1 && config.getOneCSVFile == 1) {
+				morphFeat.writeOneFileMorphological(morphFeat, config);
 		
+			}
+		});
 	}
 	
-	LocalIntensityFeatures<float, 3> localIntFeat;
-	if (localInt == a || config.calculateAllFeatures == 1) {
-		localIntFeat.calculateAllLocalIntensityFeatures(localIntFeat, imageAttr.image, imageAttr.mask, config);
-		std::string forLog = "Local intensity features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-		std::cout << "Local intensity features are calculated" << std::endl;
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		localIntFeat.writeCSVFileLocalIntensity(localIntFeat, config.outputFolder);
+	calculateFamily(featureCache, "LocalIntensityFeatures", config.calculateAllFeatures == 1 || localInt == a, [&]() {
+		TraceStage familyStage(config, "LocalIntensityFeatures", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		LocalIntensityFeatures<float, 3> localIntFeat;
+		if (localInt == a || config.calculateAllFeatures == 1) {
+			localIntFeat.calculateAllLocalIntensityFeatures(localIntFeat, imageAttr.image, imageAttr.mask, config);
+			std::string forLog = "Local intensity features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+			std::cout << "Local intensity features are calculated" << std::endl;
+		}
+		familyStage.next("LocalIntensityFeatures writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			localIntFeat.writeCSVFileLocalIntensity(localIntFeat, config.outputFolder);
 		
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		localIntFeat.writeOneFileLocalInt(localIntFeat, config);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			localIntFeat.writeOneFileLocalInt(localIntFeat, config);
 		
-	}
+		}
+	});
 	
-	StatisticalFeatures<float, 3> statFeatures;
-	if (statFeat == a || config.calculateAllFeatures == 1) {
-		statFeatures.calculateAllStatFeatures(statFeatures, imageAttr.vectorOfMatrixElements);
-		std::string forLog = "Statistical features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-		std::cout << "Statistical Features are calculated" << std::endl;
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		statFeatures.writeCSVFileStatistic(statFeatures, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1)|| config.ontologyOutput == 1) {
-		statFeatures.writeOneFileStatistic(statFeatures, config);
-	}
-	StatisticalFeatures<float, 3> statFeatures2;
-	statFeatures = statFeatures2;
-	IntensityVolumeFeatures<float, 3> intVol;
-	if ((intVolFeatures == a || config.calculateAllFeatures == 1) && (config.discretizeIVH == 0)) {
-
-		if (config.discretizeIVHSeparated == 0) {
-			intVol.calculateAllIntensVolFeatures(intVol, imageAttr.imageMatrix, imageAttr.diffGreyLevels);
+	calculateFamily(featureCache, "StatisticalFeatures", config.calculateAllFeatures == 1 || statFeat == a, [&]() {
+		TraceStage familyStage(config, "StatisticalFeatures", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		StatisticalFeatures<float, 3> statFeatures;
+		if (statFeat == a || config.calculateAllFeatures == 1) {
+			statFeatures.calculateAllStatFeatures(statFeatures, imageAttr.vectorOfMatrixElements);
+			std::string forLog = "Statistical features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+			std::cout << "Statistical Features are calculated" << std::endl;
 		}
-	}
-	if (config.discretizeIVHSeparated == 0) {
+		familyStage.next("StatisticalFeatures writer", "writer");
 		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-			intVol.writeCSVFileIntVol(intVol, config.outputFolder);
+			statFeatures.writeCSVFileStatistic(statFeatures, config.outputFolder);
 		}
-		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-			intVol.writeOneFileIntVol(intVol, config);
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1)|| config.ontologyOutput == 1) {
+			statFeatures.writeOneFileStatistic(statFeatures, config);
 		}
-		IntensityVolumeFeatures<float, 3> intVol2;
-		intVol = intVol2;
-		std::string forLog = "Intensity volume features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-		std::cout << "Intensity volume features are calculated" << std::endl;
-	}
+		StatisticalFeatures<float, 3> statFeatures2;
+		statFeatures = statFeatures2;
+	});
+	calculateFamily(featureCache, "IntensityVolume", config.calculateAllFeatures == 1 || intVolFeatures == a, [&]() {
+		TraceStage familyStage(config, "IntensityVolume", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		IntensityVolumeFeatures<float, 3> intVol;
+		if ((intVolFeatures == a || config.calculateAllFeatures == 1) && (config.discretizeIVH == 0)) {
+
+			if (config.discretizeIVHSeparated == 0) {
+				intVol.calculateAllIntensVolFeatures(intVol, imageAttr.imageMatrix, imageAttr.diffGreyLevels);
+			}
+		}
+		familyStage.next("IntensityVolume writer", "writer");
+		if (config.discretizeIVHSeparated == 0) {
+			if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+				intVol.writeCSVFileIntVol(intVol, config.outputFolder);
+			}
+			else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+				intVol.writeOneFileIntVol(intVol, config);
+			}
+			IntensityVolumeFeatures<float, 3> intVol2;
+			intVol = intVol2;
+			std::string forLog = "Intensity volume features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+			std::cout << "Intensity volume features are calculated" << std::endl;
+		}
+	});
 		
 }
 
 /*!
 In the function calculateRelFeaturesDiscretized, all features that do require interpolation are calculated. \n
 If one feature group should not be calculated, this group is skipped from the calculation \n
-The feature values are stored in the outputfile set by the user.
+The feature values are stored in the outputfile set by the user. \n
+config is taken by value on purpose: the writers count the feature parameter spaces in config.featureParameterSpaceNr.
 */
-void calculateRelFeaturesDiscretized(Image<float, 3> imageAttr, vector<float> spacing, ConfigFile config)
+void calculateRelFeaturesDiscretized(const Image<float, 3> &imageAttr, const vector<float> &spacing, ConfigFile config, FeatureCache &featureCache)
 {
 
 	int a = 1;
@@ -278,303 +315,385 @@ void calculateRelFeaturesDiscretized(Image<float, 3> imageAttr, vector<float> sp
 			exit(EXIT_FAILURE);
 		}
 	}
-	IntensityVolumeFeatures<float, 3> intVol;
-	if ((intVolFeatures == a || config.calculateAllFeatures == 1) && (config.discretizeIVHSeparated == 1 && config.discretizeIVH == 1)) {
-
-
-		intVol.calculateAllIntensVolFeatures(intVol, imageAttr.imageMatrixIVH, imageAttr.diffGreyLevels);
-	}
-	if(config.discretizeIVHSeparated == 1 && config.discretizeIVH == 1){
+	//if the features are calculated from a texture matrix file, only the discretized VOI is available (no image)
+	bool imageAvailable = imageAttr.image.IsNotNull();
+	if (imageAvailable) {
+		calculateFamily(featureCache, "IntensityVolumeDiscretized", config.calculateAllFeatures == 1 || intVolFeatures == a, [&]() {
+			//the alternatives of the discretized IVH are calculated and written in one stage
+			TraceStage familyStage(config, "IntensityVolumeDiscretized", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+			IntensityVolumeFeatures<float, 3> intVol;
+			if ((intVolFeatures == a || config.calculateAllFeatures == 1) && (config.discretizeIVHSeparated == 1 && config.discretizeIVH == 1)) {
+
+
+				intVol.calculateAllIntensVolFeatures(intVol, imageAttr.imageMatrixIVH, imageAttr.diffGreyLevels);
+			}
+			if(config.discretizeIVHSeparated == 1 && config.discretizeIVH == 1){
+				if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+					intVol.writeCSVFileIntVol(intVol, config.outputFolder);
+				}
+				else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+					intVol.writeOneFileIntVol(intVol, config);
+				}
+				std::string forLog = "Intensity volume features were calculated.";
+				writeLogFile(config.outputFolder, forLog);
+				std::cout << "Intensity volume features are calculated" << std::endl;
+			}
+
+			if ((intVolFeatures == a || config.calculateAllFeatures == 1) && (config.discretizeIVHSeparated == 0 && config.discretizeIVH == 1)) {
+
+				intVol.calculateAllIntensVolFeatures(intVol, imageAttr.imageMatrix, imageAttr.diffGreyLevels);
+			}
+			if(config.discretizeIVHSeparated == 0 && config.discretizeIVH == 1){
+				if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+					intVol.writeCSVFileIntVol(intVol, config.outputFolder);
+				}
+				else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+					intVol.writeOneFileIntVol(intVol, config);
+				}
+				std::string forLog = "Intensity volume features were calculated.";
+				writeLogFile(config.outputFolder, forLog);
+				std::cout << "Intensity volume features are calculated" << std::endl;
+			}
+			IntensityVolumeFeatures<float, 3> intVol2;
+			intVol = intVol2;
+		});
+	}
+	calculateFamily(featureCache, "IntensityHistogramFeatures", config.calculateAllFeatures == 1 || inthist == a, [&]() {
+		TraceStage familyStage(config, "IntensityHistogramFeatures", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+	   IntensityHistogram<float, 3> intensityHist;
+	   if (inthist == a || config.calculateAllFeatures == 1) {
+
+		   intensityHist.calculateAllIntFeatures(intensityHist, imageAttr.imageMatrix, imageAttr.vectorOfMatrixElements, imageAttr.diffGreyLevels);
+		   std::string forLog = "Intensity histogram features were calculated.";
+		   writeLogFile(config.outputFolder, forLog);
+		   std::cout << "Intensity histogram features are calculated" << std::endl;
+
+	   }
+		familyStage.next("IntensityHistogramFeatures writer", "writer");
 		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-			intVol.writeCSVFileIntVol(intVol, config.outputFolder);
+				intensityHist.writeCSVFileIntensity(intensityHist, config.outputFolder);
 		}
 		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-			intVol.writeOneFileIntVol(intVol, config);
+			intensityHist.writeOneFileIntensity(intensityHist, config);
 		}
-		std::string forLog = "Intensity volume features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-		std::cout << "Intensity volume features are calculated" << std::endl;
-	}
-
-	if ((intVolFeatures == a || config.calculateAllFeatures == 1) && (config.discretizeIVHSeparated == 0 && config.discretizeIVH == 1)) {
-
-		intVol.calculateAllIntensVolFeatures(intVol, imageAttr.imageMatrix, imageAttr.diffGreyLevels);
-	}
-	if(config.discretizeIVHSeparated == 0 && config.discretizeIVH == 1){
+		IntensityHistogram<float, 3> intensityHist2;
+		intensityHist = intensityHist2;
+	});
+   
+   
+    float maxIntensity = float(*max_element(imageAttr.vectorOfMatrixElements.begin(), imageAttr.vectorOfMatrixElements.end()));
+	calculateFamily(featureCache, "GLCMFeatures2DAVG", config.calculateAllFeatures == 1 || glcmFeatures2DAVG == a, [&]() {
+		TraceStage familyStage(config, "GLCMFeatures2DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLCMFeatures2DAVG<float, 3> glcm2DAVG;
+		if (glcmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
+
+			glcm2DAVG.setVoxelList(imageAttr.getVoxelList());
+			glcm2DAVG.calculateAllGLCMFeatures2DAVG(glcm2DAVG, imageAttr.imageMatrix, maxIntensity);
+			std::string forLog = "GLCM2DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLCMFeatures2DAVG writer", "writer");
 		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-			intVol.writeCSVFileIntVol(intVol, config.outputFolder);
+			glcm2DAVG.writeCSVFileGLCM2DAVG(glcm2DAVG, config.outputFolder);
 		}
 		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-			intVol.writeOneFileIntVol(intVol, config);
+			glcm2DAVG.writeOneFileGLCM2DAVG(glcm2DAVG, config, config.featureParameterSpaceNr);
 		}
-		std::string forLog = "Intensity volume features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-		std::cout << "Intensity volume features are calculated" << std::endl;
-	}
-	IntensityVolumeFeatures<float, 3> intVol2;
-	intVol = intVol2;
-   IntensityHistogram<float, 3> intensityHist;
-   if (inthist == a || config.calculateAllFeatures == 1) {
-
-	   intensityHist.calculateAllIntFeatures(intensityHist, imageAttr.imageMatrix, imageAttr.vectorOfMatrixElements, imageAttr.diffGreyLevels);
-	   std::string forLog = "Intensity histogram features were calculated.";
-	   writeLogFile(config.outputFolder, forLog);
-	   std::cout << "Intensity histogram features are calculated" << std::endl;
-
-   }
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-			intensityHist.writeCSVFileIntensity(intensityHist, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		intensityHist.writeOneFileIntensity(intensityHist, config);
-	}
-	IntensityHistogram<float, 3> intensityHist2;
-	intensityHist = intensityHist2;
-   
-   
-    float maxIntensity = float(*max_element(imageAttr.vectorOfMatrixElements.begin(), imageAttr.vectorOfMatrixElements.end()));
-	GLCMFeatures2DAVG<float, 3> glcm2DAVG;
-	if (glcmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
-
-		glcm2DAVG.calculateAllGLCMFeatures2DAVG(glcm2DAVG, imageAttr.imageMatrix, maxIntensity);
-		std::string forLog = "GLCM2DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glcm2DAVG.writeCSVFileGLCM2DAVG(glcm2DAVG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glcm2DAVG.writeOneFileGLCM2DAVG(glcm2DAVG, config, config.featureParameterSpaceNr);
-	}
-	GLCMFeatures2DAVG<float, 3> glcm2DAVG2;
-	glcm2DAVG = glcm2DAVG2;
-	GLCMFeatures2DDMRG<float, 3> glcm2DDMRG;
-	if (glcmFeatures2DDMRG == a || config.calculateAllFeatures == 1) {
-
-
-		glcm2DDMRG.calculateAllGLCMFeatures2DDMRG(glcm2DDMRG, imageAttr.imageMatrix, maxIntensity);
-		std::string forLog = "GLCM2DDMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glcm2DDMRG.writeCSVFileGLCM2DDMRG(glcm2DDMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glcm2DDMRG.writeOneFileGLCM2DDMRG(glcm2DDMRG, config, config.featureParameterSpaceNr);
-	}
-	GLCMFeatures2DDMRG<float, 3> glcm2DDMRG2;
-	glcm2DDMRG = glcm2DDMRG2;
-	GLCMFeatures2DMRG<float, 3> glcm2DMRG;
-	if (glcmFeatures2DMRG == a || config.calculateAllFeatures == 1) {
-
-		glcm2DMRG.calculateAllGLCMFeatures2DMRG(glcm2DMRG, imageAttr.imageMatrix, maxIntensity, spacing, config);
-		std::string forLog = "GLCM2DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glcm2DMRG.writeCSVFileGLCM2DMRG(glcm2DMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glcm2DMRG.writeOneFileGLCM2DMRG(glcm2DMRG, config, config.featureParameterSpaceNr);
-	}
-	GLCMFeatures2DMRG<float, 3> glcm2DMRG2;
-	glcm2DMRG = glcm2DMRG2;
+		GLCMFeatures2DAVG<float, 3> glcm2DAVG2;
+		glcm2DAVG = glcm2DAVG2;
+	});
+	calculateFamily(featureCache, "GLCMFeatures2DDMRG", config.calculateAllFeatures == 1 || glcmFeatures2DDMRG == a, [&]() {
+		TraceStage familyStage(config, "GLCMFeatures2DDMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLCMFeatures2DDMRG<float, 3> glcm2DDMRG;
+		if (glcmFeatures2DDMRG == a || config.calculateAllFeatures == 1) {
+
+
+			glcm2DDMRG.setVoxelList(imageAttr.getVoxelList());
+			glcm2DDMRG.calculateAllGLCMFeatures2DDMRG(glcm2DDMRG, imageAttr.imageMatrix, maxIntensity);
+			std::string forLog = "GLCM2DDMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLCMFeatures2DDMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glcm2DDMRG.writeCSVFileGLCM2DDMRG(glcm2DDMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glcm2DDMRG.writeOneFileGLCM2DDMRG(glcm2DDMRG, config, config.featureParameterSpaceNr);
+		}
+		GLCMFeatures2DDMRG<float, 3> glcm2DDMRG2;
+		glcm2DDMRG = glcm2DDMRG2;
+	});
+	calculateFamily(featureCache, "GLCMFeatures2DMRG", config.calculateAllFeatures == 1 || glcmFeatures2DMRG == a, [&]() {
+		TraceStage familyStage(config, "GLCMFeatures2DMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLCMFeatures2DMRG<float, 3> glcm2DMRG;
+		if (glcmFeatures2DMRG == a || config.calculateAllFeatures == 1) {
+
+			glcm2DMRG.setVoxelList(imageAttr.getVoxelList());
+			glcm2DMRG.calculateAllGLCMFeatures2DMRG(glcm2DMRG, imageAttr.imageMatrix, maxIntensity, spacing, config);
+			std::string forLog = "GLCM2DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLCMFeatures2DMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glcm2DMRG.writeCSVFileGLCM2DMRG(glcm2DMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glcm2DMRG.writeOneFileGLCM2DMRG(glcm2DMRG, config, config.featureParameterSpaceNr);
+		}
+		GLCMFeatures2DMRG<float, 3> glcm2DMRG2;
+		glcm2DMRG = glcm2DMRG2;
+	});
 	
-	GLCMFeatures2DVMRG<float, 3> glcm2DVMRG;
-	if (glcmFeat2DVMRG == a || config.calculateAllFeatures == 1) {
-
-		glcm2DVMRG.calculateAllGLCMFeatures2DVMRG(glcm2DVMRG, imageAttr.imageMatrix, maxIntensity, spacing, config);
-		std::string forLog = "GLCM2DVMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+	calculateFamily(featureCache, "GLCMFeatures2DVMRG", config.calculateAllFeatures == 1 || glcmFeat2DVMRG == a, [&]() {
+		TraceStage familyStage(config, "GLCMFeatures2DVMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLCMFeatures2DVMRG<float, 3> glcm2DVMRG;
+		if (glcmFeat2DVMRG == a || config.calculateAllFeatures == 1) {
+
+			glcm2DVMRG.setVoxelList(imageAttr.getVoxelList());
+			glcm2DVMRG.calculateAllGLCMFeatures2DVMRG(glcm2DVMRG, imageAttr.imageMatrix, maxIntensity, spacing, config);
+			std::string forLog = "GLCM2DVMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glcm2DVMRG.writeCSVFileGLCM2DVMRG(glcm2DVMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glcm2DVMRG.writeOneFileGLCM2DVMRG(glcm2DVMRG, config, config.featureParameterSpaceNr);
-	}
-	GLCMFeatures2DVMRG<float, 3> glcm2DVMRG2;
-	glcm2DVMRG = glcm2DVMRG2;
-	GLCMFeatures3DAVG<float, 3> glcmFeat3DAVGFeat;
-	if (glcmFeat3DAVG == a || config.calculateAllFeatures == 1) {
-
-		glcmFeat3DAVGFeat.calculateAllGLCMFeatures3DAVG(glcmFeat3DAVGFeat, imageAttr.imageMatrix, maxIntensity);
-		std::string forLog = "GLCM3DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glcmFeat3DAVGFeat.writeCSVFileGLCM3DAVG(glcmFeat3DAVGFeat, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glcmFeat3DAVGFeat.writeOneFileGLCM3DAVG(glcmFeat3DAVGFeat, config, config.featureParameterSpaceNr);
-	}
-	GLCMFeatures3DAVG<float, 3> glcmFeat3DAVGFeat2;
-	glcmFeat3DAVGFeat = glcmFeat3DAVGFeat2;
-	GLCMFeatures3DMRG<float, 3> glcm3DMRG;
-	if (glcmFeat3DMRG == a || config.calculateAllFeatures == 1) {
-
-		glcm3DMRG.calculateAllGLCMFeatures3DMRG(glcm3DMRG, imageAttr.imageMatrix, maxIntensity, spacing, config);
-		std::string forLog = "GLCM3DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glcm3DMRG.writeCSVFileGLCM3DMRG(glcm3DMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glcm3DMRG.writeOneFileGLCM3DMRG(glcm3DMRG, config, config.featureParameterSpaceNr);
-	}
-	GLCMFeatures3DMRG<float, 3> glcm3DMRG2;
-	glcm3DMRG = glcm3DMRG2;
+		}
+		familyStage.next("GLCMFeatures2DVMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glcm2DVMRG.writeCSVFileGLCM2DVMRG(glcm2DVMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glcm2DVMRG.writeOneFileGLCM2DVMRG(glcm2DVMRG, config, config.featureParameterSpaceNr);
+		}
+		GLCMFeatures2DVMRG<float, 3> glcm2DVMRG2;
+		glcm2DVMRG = glcm2DVMRG2;
+	});
+	calculateFamily(featureCache, "GLCMFeatures3DAVG", config.calculateAllFeatures == 1 || glcmFeat3DAVG == a, [&]() {
+		TraceStage familyStage(config, "GLCMFeatures3DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLCMFeatures3DAVG<float, 3> glcmFeat3DAVGFeat;
+		if (glcmFeat3DAVG == a || config.calculateAllFeatures == 1) {
+
+			glcmFeat3DAVGFeat.setVoxelList(imageAttr.getVoxelList());
+			glcmFeat3DAVGFeat.calculateAllGLCMFeatures3DAVG(glcmFeat3DAVGFeat, imageAttr.imageMatrix, maxIntensity);
+			std::string forLog = "GLCM3DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLCMFeatures3DAVG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glcmFeat3DAVGFeat.writeCSVFileGLCM3DAVG(glcmFeat3DAVGFeat, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glcmFeat3DAVGFeat.writeOneFileGLCM3DAVG(glcmFeat3DAVGFeat, config, config.featureParameterSpaceNr);
+		}
+		GLCMFeatures3DAVG<float, 3> glcmFeat3DAVGFeat2;
+		glcmFeat3DAVGFeat = glcmFeat3DAVGFeat2;
+	});
+	calculateFamily(featureCache, "GLCMFeatures3DMRG", config.calculateAllFeatures == 1 || glcmFeat3DMRG == a, [&]() {
+		TraceStage familyStage(config, "GLCMFeatures3DMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLCMFeatures3DMRG<float, 3> glcm3DMRG;
+		if (glcmFeat3DMRG == a || config.calculateAllFeatures == 1) {
+
+			glcm3DMRG.setVoxelList(imageAttr.getVoxelList());
+			glcm3DMRG.calculateAllGLCMFeatures3DMRG(glcm3DMRG, imageAttr.imageMatrix, maxIntensity, spacing, config);
+			std::string forLog = "GLCM3DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLCMFeatures3DMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glcm3DMRG.writeCSVFileGLCM3DMRG(glcm3DMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glcm3DMRG.writeOneFileGLCM3DMRG(glcm3DMRG, config, config.featureParameterSpaceNr);
+		}
+		GLCMFeatures3DMRG<float, 3> glcm3DMRG2;
+		glcm3DMRG = glcm3DMRG2;
+	});
 	std::cout << "GLCM features are calculated" << std::endl;
 	
-	GLRLMFeatures2DAVG<float, 3> glrlm2DAVG;
-	if (glrlmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
-
-		glrlm2DAVG.calculateAllGLRLMFeatures2DAVG(glrlm2DAVG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, config);
-		std::string forLog = "GLRLM2DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glrlm2DAVG.writeCSVFileGLRLM2DAVG(glrlm2DAVG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glrlm2DAVG.writeOneFileGLRLM2DAVG(glrlm2DAVG, config, config.featureParameterSpaceNr);
-	}
-	GLRLMFeatures2DAVG<float, 3> glrlm2DAVG2;
-	glrlm2DAVG = glrlm2DAVG2;
-	GLRLMFEATURES2DDMRG<float, 3> glrlm2DDMRG;
-	if (glrlmFeatures2DDMRG == a || config.calculateAllFeatures == 1) {
-
-		glrlm2DDMRG.calculateAllGLRLMFeatures2DDMRG(glrlm2DDMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, spacing, config);
-		std::string forLog = "GLRLM2DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+	calculateFamily(featureCache, "GLRLMFeatures2DAVG", config.calculateAllFeatures == 1 || glrlmFeatures2DAVG == a, [&]() {
+		TraceStage familyStage(config, "GLRLMFeatures2DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLRLMFeatures2DAVG<float, 3> glrlm2DAVG;
+		if (glrlmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glrlm2DDMRG.writeCSVFileGLRLM2DDMRG(glrlm2DDMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glrlm2DDMRG.writeOneFileGLRLM2DDMRG(glrlm2DDMRG, config, config.featureParameterSpaceNr);
-	}
-	GLRLMFEATURES2DDMRG<float, 3> glrlm2DDMRG2;
-	glrlm2DDMRG = glrlm2DDMRG2;
-	GLRLMFeatures2DMRG<float, 3> glrlm2DMRG;
-	if (glrlmFeat2DMRG == a || config.calculateAllFeatures == 1) {
-
-		glrlm2DMRG.calculateAllGLRLMFeatures2DMRG(glrlm2DMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, spacing, config);
-		std::string forLog = "GLRLM2DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glrlm2DMRG.writeCSVFileGLRLM2DMRG(glrlm2DMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glrlm2DMRG.writeOneFileGLRLM2DMRG(glrlm2DMRG, config, config.featureParameterSpaceNr);
-	}
-	GLRLMFeatures2DMRG<float, 3> glrlm2DMRG2;
-	glrlm2DMRG = glrlm2DMRG2;
-	GLRLMFeatures2DVMRG<float, 3> glrlm2DVMRG;
-	if (glrlmFeatures2DVMRG == a || config.calculateAllFeatures == 1) {
+			glrlm2DAVG.calculateAllGLRLMFeatures2DAVG(glrlm2DAVG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, config);
+			std::string forLog = "GLRLM2DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-		glrlm2DVMRG.calculateAllGLRLMFeatures2DVMRG(glrlm2DVMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, spacing, config);
-		std::string forLog = "GLRLM2DVMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLRLMFeatures2DAVG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glrlm2DAVG.writeCSVFileGLRLM2DAVG(glrlm2DAVG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glrlm2DAVG.writeOneFileGLRLM2DAVG(glrlm2DAVG, config, config.featureParameterSpaceNr);
+		}
+		GLRLMFeatures2DAVG<float, 3> glrlm2DAVG2;
+		glrlm2DAVG = glrlm2DAVG2;
+	});
+	calculateFamily(featureCache, "GLRLMFeatures2DDMRG", config.calculateAllFeatures == 1 || glrlmFeatures2DDMRG == a, [&]() {
+		TraceStage familyStage(config, "GLRLMFeatures2DDMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLRLMFEATURES2DDMRG<float, 3> glrlm2DDMRG;
+		if (glrlmFeatures2DDMRG == a || config.calculateAllFeatures == 1) {
+
+			glrlm2DDMRG.calculateAllGLRLMFeatures2DDMRG(glrlm2DDMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, spacing, config);
+			std::string forLog = "GLRLM2DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glrlm2DVMRG.writeCSVFileGLRLM2DVMRG(glrlm2DVMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glrlm2DVMRG.writeOneFileGLRLM2DVMRG(glrlm2DVMRG, config, config.featureParameterSpaceNr);
-	}
-	GLRLMFeatures2DVMRG<float, 3> glrlm2DVMRG2;
-	glrlm2DVMRG = glrlm2DVMRG2;
-	GLRLMFeatures3DAVG<float, 3> glrlm3DAVG;
-	if (glrlmFeatures3DAVG == a || config.calculateAllFeatures == 1) {
+		}
+		familyStage.next("GLRLMFeatures2DDMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glrlm2DDMRG.writeCSVFileGLRLM2DDMRG(glrlm2DDMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glrlm2DDMRG.writeOneFileGLRLM2DDMRG(glrlm2DDMRG, config, config.featureParameterSpaceNr);
+		}
+		GLRLMFEATURES2DDMRG<float, 3> glrlm2DDMRG2;
+		glrlm2DDMRG = glrlm2DDMRG2;
+	});
+	calculateFamily(featureCache, "GLRLMFeatures2DMRG", config.calculateAllFeatures == 1 || glrlmFeat2DMRG == a, [&]() {
+		TraceStage familyStage(config, "GLRLMFeatures2DMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLRLMFeatures2DMRG<float, 3> glrlm2DMRG;
+		if (glrlmFeat2DMRG == a || config.calculateAllFeatures == 1) {
+
+			glrlm2DMRG.calculateAllGLRLMFeatures2DMRG(glrlm2DMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, spacing, config);
+			std::string forLog = "GLRLM2DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-		glrlm3DAVG.calculateAllGLRLMFeatures3DAVG(glrlm3DAVG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, config);
-		std::string forLog = "GLRLM3DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLRLMFeatures2DMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glrlm2DMRG.writeCSVFileGLRLM2DMRG(glrlm2DMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glrlm2DMRG.writeOneFileGLRLM2DMRG(glrlm2DMRG, config, config.featureParameterSpaceNr);
+		}
+		GLRLMFeatures2DMRG<float, 3> glrlm2DMRG2;
+		glrlm2DMRG = glrlm2DMRG2;
+	});
+	calculateFamily(featureCache, "GLRLMFeatures2DVMRG", config.calculateAllFeatures == 1 || glrlmFeatures2DVMRG == a, [&]() {
+		TraceStage familyStage(config, "GLRLMFeatures2DVMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLRLMFeatures2DVMRG<float, 3> glrlm2DVMRG;
+		if (glrlmFeatures2DVMRG == a || config.calculateAllFeatures == 1) {
+
+			glrlm2DVMRG.calculateAllGLRLMFeatures2DVMRG(glrlm2DVMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, spacing, config);
+			std::string forLog = "GLRLM2DVMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glrlm3DAVG.writeCSVFileGLRLM3DAVG(glrlm3DAVG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glrlm3DAVG.writeOneFileGLRLM3DAVG(glrlm3DAVG, config, config.featureParameterSpaceNr);
-	}
-	GLRLMFeatures3DAVG<float, 3> glrlm3DAVG2;
-	glrlm3DAVG = glrlm3DAVG2;
-	GLRLMFeatures3D<float, 3> glrlm3DMRG;
-	if (glrlmFeatures3DMRG == a || config.calculateAllFeatures == 1) {
+		}
+		familyStage.next("GLRLMFeatures2DVMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glrlm2DVMRG.writeCSVFileGLRLM2DVMRG(glrlm2DVMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glrlm2DVMRG.writeOneFileGLRLM2DVMRG(glrlm2DVMRG, config, config.featureParameterSpaceNr);
+		}
+		GLRLMFeatures2DVMRG<float, 3> glrlm2DVMRG2;
+		glrlm2DVMRG = glrlm2DVMRG2;
+	});
+	calculateFamily(featureCache, "GLRLMFeatures3DAVG", config.calculateAllFeatures == 1 || glrlmFeatures3DAVG == a, [&]() {
+		TraceStage familyStage(config, "GLRLMFeatures3DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLRLMFeatures3DAVG<float, 3> glrlm3DAVG;
+		if (glrlmFeatures3DAVG == a || config.calculateAllFeatures == 1) {
+
+			glrlm3DAVG.calculateAllGLRLMFeatures3DAVG(glrlm3DAVG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, config);
+			std::string forLog = "GLRLM3DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-		glrlm3DMRG.calculateAllGLRLMFeatures3D(glrlm3DMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, spacing, config);
-		std::string forLog = "GLRLM3DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLRLMFeatures3DAVG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glrlm3DAVG.writeCSVFileGLRLM3DAVG(glrlm3DAVG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glrlm3DAVG.writeOneFileGLRLM3DAVG(glrlm3DAVG, config, config.featureParameterSpaceNr);
+		}
+		GLRLMFeatures3DAVG<float, 3> glrlm3DAVG2;
+		glrlm3DAVG = glrlm3DAVG2;
+	});
+	calculateFamily(featureCache, "GLRLMFeatures3DMRG", config.calculateAllFeatures == 1 || glrlmFeatures3DMRG == a, [&]() {
+		TraceStage familyStage(config, "GLRLMFeatures3DMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLRLMFeatures3D<float, 3> glrlm3DMRG;
+		if (glrlmFeatures3DMRG == a || config.calculateAllFeatures == 1) {
+
+			glrlm3DMRG.calculateAllGLRLMFeatures3D(glrlm3DMRG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, spacing, config);
+			std::string forLog = "GLRLM3DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glrlm3DMRG.writeCSVFileGLRLM3D(glrlm3DMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glrlm3DMRG.writeOneFileGLRLM3D(glrlm3DMRG, config, config.featureParameterSpaceNr);
-	}
-	GLRLMFeatures3D<float, 3> glrlm3DMRG2;
-	glrlm3DMRG = glrlm3DMRG2;
+		}
+		familyStage.next("GLRLMFeatures3DMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glrlm3DMRG.writeCSVFileGLRLM3D(glrlm3DMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glrlm3DMRG.writeOneFileGLRLM3D(glrlm3DMRG, config, config.featureParameterSpaceNr);
+		}
+		GLRLMFeatures3D<float, 3> glrlm3DMRG2;
+		glrlm3DMRG = glrlm3DMRG2;
+	});
 	std::cout << "GLRLM features are calculated" << std::endl;
-	GLSZMFeatures2DAVG<float, 3> glszm2DAVG;
-	if (glszmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
-
-		glszm2DAVG.calculateAllGLSZMFeatures2DAVG(glszm2DAVG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, config);
-		std::string forLog = "GLSZM2DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+	calculateFamily(featureCache, "GLSZMFeatures2DAVG", config.calculateAllFeatures == 1 || glszmFeatures2DAVG == a, [&]() {
+		TraceStage familyStage(config, "GLSZMFeatures2DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLSZMFeatures2DAVG<float, 3> glszm2DAVG;
+		if (glszmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glszm2DAVG.writeCSVFileGLSZM2DAVG(glszm2DAVG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glszm2DAVG.writeOneFileGLSZM2DAVG(glszm2DAVG, config, config.featureParameterSpaceNr);
-	}
-	GLSZMFeatures2DAVG<float, 3> glszm2DAVG2;
-	glszm2DAVG = glszm2DAVG2;
-	GLSZMFeatures2DMRG<float, 3> glszm2D;
-	if (glszmFeatures2DMRG == a || config.calculateAllFeatures == 1) {
-
-		glszm2D.calculateAllGLSZMFeatures2DMRG(glszm2D, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, config);
-		std::string forLog = "GLSZM2DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+			glszm2DAVG.calculateAllGLSZMFeatures2DAVG(glszm2DAVG, imageAttr.imageMatrix, imageAttr.diffGreyLevels, config);
+			std::string forLog = "GLSZM2DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glszm2D.writeCSVFileGLSZM(glszm2D, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glszm2D.writeOneFileGLSZM(glszm2D, config, config.featureParameterSpaceNr);
-	}
-	GLSZMFeatures2DMRG<float, 3> glszm2D2;
-	glszm2D = glszm2D2;
-	GLSZMFeatures3D<float, 3> glszm3D;
-	if (glszmFeatures3D == a || config.calculateAllFeatures == 1) {
+		}
+		familyStage.next("GLSZMFeatures2DAVG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glszm2DAVG.writeCSVFileGLSZM2DAVG(glszm2DAVG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glszm2DAVG.writeOneFileGLSZM2DAVG(glszm2DAVG, config, config.featureParameterSpaceNr);
+		}
+		GLSZMFeatures2DAVG<float, 3> glszm2DAVG2;
+		glszm2DAVG = glszm2DAVG2;
+	});
+	calculateFamily(featureCache, "GLSZMFeatures2DMRG", config.calculateAllFeatures == 1 || glszmFeatures2DMRG == a, [&]() {
+		TraceStage familyStage(config, "GLSZMFeatures2DMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLSZMFeatures2DMRG<float, 3> glszm2D;
+		if (glszmFeatures2DMRG == a || config.calculateAllFeatures == 1) {
+
+			glszm2D.calculateAllGLSZMFeatures2DMRG(glszm2D, imageAttr.imageMatrix, imageAttr.diffGreyLevels, imageAttr.vectorOfMatrixElements, config);
+			std::string forLog = "GLSZM2DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-		glszm3D.calculateAllGLSZMFeatures3D(glszm3D, imageAttr, config);
-		std::string forLog = "GLSZM3D features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLSZMFeatures2DMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glszm2D.writeCSVFileGLSZM(glszm2D, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glszm2D.writeOneFileGLSZM(glszm2D, config, config.featureParameterSpaceNr);
+		}
+		GLSZMFeatures2DMRG<float, 3> glszm2D2;
+		glszm2D = glszm2D2;
+	});
+	calculateFamily(featureCache, "GLSZMFeatures3D", config.calculateAllFeatures == 1 || glszmFeatures3D == a, [&]() {
+		TraceStage familyStage(config, "GLSZMFeatures3D", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLSZMFeatures3D<float, 3> glszm3D;
+		if (glszmFeatures3D == a || config.calculateAllFeatures == 1) {
+
+			glszm3D.calculateAllGLSZMFeatures3D(glszm3D, imageAttr, config);
+			std::string forLog = "GLSZM3D features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		glszm3D.writeCSVFileGLSZM3D(glszm3D, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		glszm3D.writeOneFileGLSZM3D(glszm3D, config, config.featureParameterSpaceNr);
-	}
-	GLSZMFeatures3D<float, 3> glszm3D2;
-	glszm3D = glszm3D2;
+		}
+		familyStage.next("GLSZMFeatures3D writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			glszm3D.writeCSVFileGLSZM3D(glszm3D, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			glszm3D.writeOneFileGLSZM3D(glszm3D, config, config.featureParameterSpaceNr);
+		}
+		GLSZMFeatures3D<float, 3> glszm3D2;
+		glszm3D = glszm3D2;
+	});
 
 	std::cout << "GLSZM features are calculated" << std::endl;	
+	//NGTDM, GLDZM and NGLDM need the image for the neighborhoods and the distance map
+	if (!imageAvailable) {
+		return;
+	}
 
 	boost::multi_array<float, 3> ngtdm2D(boost::extents[imageAttr.imageMatrix.shape()[0]][imageAttr.imageMatrix.shape()[1]][imageAttr.imageMatrix.shape()[2]]);
 	boost::multi_array<float, 3> nrNeighborMatrix(boost::extents[imageAttr.imageMatrix.shape()[0] + 1][imageAttr.imageMatrix.shape()[1]][imageAttr.imageMatrix.shape()[2]]);
@@ -585,169 +704,217 @@ void calculateRelFeaturesDiscretized(Image<float, 3> imageAttr, vector<float> sp
 	boost::multi_array<float, 3> ngtdm3DMatrix(boost::extents[imageAttr.imageMatrix.shape()[0]][imageAttr.imageMatrix.shape()[1]][imageAttr.imageMatrix.shape()[2]]);
 	boost::multi_array<float, 2> ngldm3DMatrixSum(boost::extents[sizeGreyLevels][27]);
 
+	//the neighborhood matrices are not needed for families that are taken from the cache
 	if (ngtdmFeatures2DAVG == a || config.calculateAllFeatures == 1 || ngtdmFeat2DMRG == a || ngldmFeat2DMRG == a || ngldmFeat2DAVG == a) {
-		getNeighborhoodMatrix2D(imageAttr, ngtdm2D, spacing, config);
-		getNeighborhoodMatrix2DNGLDM(imageAttr, NGLDMatrix, spacing, config);
+		if (!featureCache.isCached("NGTDMFeatures2DAVG", config.calculateAllFeatures == 1 || ngtdmFeatures2DAVG == a) || !featureCache.isCached("NGTDMFeatures2DMRG", config.calculateAllFeatures == 1 || ngtdmFeat2DMRG == a)) {
+			getNeighborhoodMatrix2D(imageAttr, ngtdm2D, spacing, config);
+		}
+		if (!featureCache.isCached("NGLDMFeatures2DAVG", config.calculateAllFeatures == 1 || ngldmFeat2DAVG == a) || !featureCache.isCached("NGLDMFeatures2DMRG", config.calculateAllFeatures == 1 || ngldmFeat2DMRG == a)) {
+			getNeighborhoodMatrix2DNGLDM(imageAttr, NGLDMatrix, spacing, config);
+		}
 	}
 
 	if (ngtdmFeatures3D == a || config.calculateAllFeatures == 1 || ngldmFeat3D == a) {
-		getNeighborhoodMatrix3D_convolution(imageAttr, ngtdm3DMatrix, spacing, config);
-		getNGLDMatrix3D_convolution(imageAttr, ngldm3DMatrixSum, spacing, config);
+		if (!featureCache.isCached("NGTDMFeatures3D", config.calculateAllFeatures == 1 || ngtdmFeatures3D == a)) {
+			getNeighborhoodMatrix3D_convolution(imageAttr, ngtdm3DMatrix, spacing, config);
+		}
+		if (!featureCache.isCached("NGLDMFeatures3D", config.calculateAllFeatures == 1 || ngldmFeat3D == a)) {
+			getNGLDMatrix3D_convolution(imageAttr, ngldm3DMatrixSum, spacing, config);
+		}
 	}
 	
 			
 	
-	NGTDM2DAVG<float, 3> ngtdm2Davg;
-	if (ngtdmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
-
-		ngtdm2Davg.calculateAllNGTDMFeatures2DAVG(ngtdm2Davg, imageAttr, ngtdm2D, spacing, config);
-		std::string forLog = "NGTDM2DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+	calculateFamily(featureCache, "NGTDMFeatures2DAVG", config.calculateAllFeatures == 1 || ngtdmFeatures2DAVG == a, [&]() {
+		TraceStage familyStage(config, "NGTDMFeatures2DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		NGTDM2DAVG<float, 3> ngtdm2Davg;
+		if (ngtdmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		ngtdm2Davg.writeCSVFileNGTDM2DAVG(ngtdm2Davg, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		ngtdm2Davg.writeOneFileNGTDM2DAVG(ngtdm2Davg, config, config.featureParameterSpaceNr);
-	}
-	NGTDM2DAVG<float, 3> NGTDM2DAVG2;
-	ngtdm2Davg = NGTDM2DAVG2;
-	NGTDMFeatures2DMRG<float, 3> ngtdm2DMRG;
-	if (ngtdmFeat2DMRG == a || config.calculateAllFeatures == 1) {
+			ngtdm2Davg.calculateAllNGTDMFeatures2DAVG(ngtdm2Davg, imageAttr, ngtdm2D, spacing, config);
+			std::string forLog = "NGTDM2DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-		ngtdm2DMRG.calculateAllNGTDMFeatures2DMRG(ngtdm2DMRG, imageAttr, ngtdm2D, spacing, config);
-		std::string forLog = "NGTDM2DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("NGTDMFeatures2DAVG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			ngtdm2Davg.writeCSVFileNGTDM2DAVG(ngtdm2Davg, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			ngtdm2Davg.writeOneFileNGTDM2DAVG(ngtdm2Davg, config, config.featureParameterSpaceNr);
+		}
+		NGTDM2DAVG<float, 3> NGTDM2DAVG2;
+		ngtdm2Davg = NGTDM2DAVG2;
+	});
+	calculateFamily(featureCache, "NGTDMFeatures2DMRG", config.calculateAllFeatures == 1 || ngtdmFeat2DMRG == a, [&]() {
+		TraceStage familyStage(config, "NGTDMFeatures2DMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		NGTDMFeatures2DMRG<float, 3> ngtdm2DMRG;
+		if (ngtdmFeat2DMRG == a || config.calculateAllFeatures == 1) {
+
+			ngtdm2DMRG.calculateAllNGTDMFeatures2DMRG(ngtdm2DMRG, imageAttr, ngtdm2D, spacing, config);
+			std::string forLog = "NGTDM2DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		ngtdm2DMRG.writeCSVFileNGTDM(ngtdm2DMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		ngtdm2DMRG.writeOneFileNGTDM(ngtdm2DMRG, config, config.featureParameterSpaceNr);
-	}
-	NGTDMFeatures2DMRG<float, 3> ngtdm2DMRG2;
-	ngtdm2DMRG = ngtdm2DMRG2;
-	NGTDMFeatures3D<float, 3> ngtdm3D;
-	if (ngtdmFeatures3D == a || config.calculateAllFeatures == 1) {
-
-		ngtdm3D.calculateAllNGTDMFeatures3D(ngtdm3D, ngtdm3DMatrix, imageAttr, spacing, config);
-		std::string forLog = "NGTDM3D features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		ngtdm3D.writeCSVFileNGTDM3D(ngtdm3D, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		ngtdm3D.writeOneFileNGTDM3D(ngtdm3D, config, config.featureParameterSpaceNr);
-	}
+		}
+		familyStage.next("NGTDMFeatures2DMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			ngtdm2DMRG.writeCSVFileNGTDM(ngtdm2DMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			ngtdm2DMRG.writeOneFileNGTDM(ngtdm2DMRG, config, config.featureParameterSpaceNr);
+		}
+		NGTDMFeatures2DMRG<float, 3> ngtdm2DMRG2;
+		ngtdm2DMRG = ngtdm2DMRG2;
+	});
+	calculateFamily(featureCache, "NGTDMFeatures3D", config.calculateAllFeatures == 1 || ngtdmFeatures3D == a, [&]() {
+		TraceStage familyStage(config, "NGTDMFeatures3D", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		NGTDMFeatures3D<float, 3> ngtdm3D;
+		if (ngtdmFeatures3D == a || config.calculateAllFeatures == 1) {
+
+			ngtdm3D.calculateAllNGTDMFeatures3D(ngtdm3D, ngtdm3DMatrix, imageAttr, spacing, config);
+			std::string forLog = "NGTDM3D features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("NGTDMFeatures3D writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			ngtdm3D.writeCSVFileNGTDM3D(ngtdm3D, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			ngtdm3D.writeOneFileNGTDM3D(ngtdm3D, config, config.featureParameterSpaceNr);
+		}
+		NGTDMFeatures3D<float, 3> ngtdm3D2;
+		ngtdm3D = ngtdm3D2;
+	});
 	std::cout << "NGTDM features are calculated" << std::endl;
-	NGTDMFeatures3D<float, 3> ngtdm3D2;
-	ngtdm3D = ngtdm3D2;
 	boost::multi_array<float, 3> ngtdm3DMatrix2(boost::extents[0][0][0]);
 	ngtdm3DMatrix = ngtdm3DMatrix2;
 
 	GLDZMFeatures2DAVG<float, 3> gldzm2DAVG;
 	boost::multi_array<float, 3> distanceMap(boost::extents[imageAttr.imageMatrix.shape()[0]][imageAttr.imageMatrix.shape()[1]][imageAttr.imageMatrix.shape()[2]]);
-	if (config.useReSegmentation == 1 || config.excludeOutliers == 1) {
+	//the distance map is not needed if all GLDZM families are taken from the cache
+	bool useDistanceMap = !featureCache.isCached("GLDZMFeatures2DAVG", config.calculateAllFeatures == 1 || gldzmFeatures2DAVG == a) || !featureCache.isCached("GLDZMFeatures2D", config.calculateAllFeatures == 1 || gldzmFeatures2D == a)
+		|| !featureCache.isCached("GLDZMFeatures3D", config.calculateAllFeatures == 1 || gldzmFeatures3D == a);
+	if (useDistanceMap && (config.useReSegmentation == 1 || config.excludeOutliers == 1)) {
 		gldzm2DAVG.generateDistanceMap(imageAttr.imageMatrixOriginal, imageAttr, distanceMap, config);
 	}
-	else {
+	else if (useDistanceMap) {
 		gldzm2DAVG.generateDistanceMap(imageAttr.imageMatrix, imageAttr, distanceMap, config);
 	}
 
 
-	if (gldzmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
-
-		gldzm2DAVG.calculateAllGLDZMFeatures2DAVG(gldzm2DAVG, imageAttr, distanceMap, config);
-		std::string forLog = "GLDZM2DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		gldzm2DAVG.writeCSVFileGLDZM2DAVG(gldzm2DAVG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		gldzm2DAVG.writeOneFileGLDZM2DAVG(gldzm2DAVG, config, config.featureParameterSpaceNr);
-	}
-	GLDZMFeatures2DAVG<float, 3> gldzm2DAVG2;
-	gldzm2DAVG = gldzm2DAVG2;
-	GLDZMFeatures2D<float, 3> gldzm2D;
-	if (gldzmFeatures2D == a || config.calculateAllFeatures == 1) {
+	calculateFamily(featureCache, "GLDZMFeatures2DAVG", config.calculateAllFeatures == 1 || gldzmFeatures2DAVG == a, [&]() {
+		TraceStage familyStage(config, "GLDZMFeatures2DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		if (gldzmFeatures2DAVG == a || config.calculateAllFeatures == 1) {
 
-		gldzm2D.calculateAllGLDZMFeatures2D(gldzm2D, distanceMap, imageAttr, config);
-		std::string forLog = "GLDZM2DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+			gldzm2DAVG.calculateAllGLDZMFeatures2DAVG(gldzm2DAVG, imageAttr, distanceMap, config);
+			std::string forLog = "GLDZM2DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		gldzm2D.writeCSVFileGLDZM(gldzm2D, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		gldzm2D.writeOneFileGLDZM(gldzm2D, config, config.featureParameterSpaceNr);
-	}
-	GLDZMFeatures2D<float, 3> gldzm2D2;
-	gldzm2D = gldzm2D2;
-	GLDZMFeatures3D<float, 3> gldzm3D;
-	if (gldzmFeatures3D == a || config.calculateAllFeatures == 1) {
+		}
+		familyStage.next("GLDZMFeatures2DAVG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			gldzm2DAVG.writeCSVFileGLDZM2DAVG(gldzm2DAVG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			gldzm2DAVG.writeOneFileGLDZM2DAVG(gldzm2DAVG, config, config.featureParameterSpaceNr);
+		}
+		GLDZMFeatures2DAVG<float, 3> gldzm2DAVG2;
+		gldzm2DAVG = gldzm2DAVG2;
+	});
+	calculateFamily(featureCache, "GLDZMFeatures2D", config.calculateAllFeatures == 1 || gldzmFeatures2D == a, [&]() {
+		TraceStage familyStage(config, "GLDZMFeatures2D", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLDZMFeatures2D<float, 3> gldzm2D;
+		if (gldzmFeatures2D == a || config.calculateAllFeatures == 1) {
+
+			gldzm2D.calculateAllGLDZMFeatures2D(gldzm2D, distanceMap, imageAttr, config);
+			std::string forLog = "GLDZM2DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-		gldzm3D.calculateAllGLDZMFeatures3D(gldzm3D, distanceMap, imageAttr, config);
-		std::string forLog = "GLDZM3D features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("GLDZMFeatures2D writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			gldzm2D.writeCSVFileGLDZM(gldzm2D, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			gldzm2D.writeOneFileGLDZM(gldzm2D, config, config.featureParameterSpaceNr);
+		}
+		GLDZMFeatures2D<float, 3> gldzm2D2;
+		gldzm2D = gldzm2D2;
+	});
+	calculateFamily(featureCache, "GLDZMFeatures3D", config.calculateAllFeatures == 1 || gldzmFeatures3D == a, [&]() {
+		TraceStage familyStage(config, "GLDZMFeatures3D", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		GLDZMFeatures3D<float, 3> gldzm3D;
+		if (gldzmFeatures3D == a || config.calculateAllFeatures == 1) {
+
+			gldzm3D.calculateAllGLDZMFeatures3D(gldzm3D, distanceMap, imageAttr, config);
+			std::string forLog = "GLDZM3D features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		gldzm3D.writeCSVFileGLDZM3D(gldzm3D, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		gldzm3D.writeOneFileGLDZM3D(gldzm3D, config, config.featureParameterSpaceNr);
-	}
-	GLDZMFeatures3D<float, 3> gldzm3D2;
-	gldzm3D = gldzm3D2;
+		}
+		familyStage.next("GLDZMFeatures3D writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			gldzm3D.writeCSVFileGLDZM3D(gldzm3D, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			gldzm3D.writeOneFileGLDZM3D(gldzm3D, config, config.featureParameterSpaceNr);
+		}
+		GLDZMFeatures3D<float, 3> gldzm3D2;
+		gldzm3D = gldzm3D2;
+	});
 	std::cout << "GLDZM features are calculated" << std::endl;
-	NGLDMFeatures2DAVG<float, 3> ngldm2DAVG;
-	if (ngldmFeat2DAVG == a || config.calculateAllFeatures == 1) {
+	calculateFamily(featureCache, "NGLDMFeatures2DAVG", config.calculateAllFeatures == 1 || ngldmFeat2DAVG == a, [&]() {
+		TraceStage familyStage(config, "NGLDMFeatures2DAVG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		NGLDMFeatures2DAVG<float, 3> ngldm2DAVG;
+		if (ngldmFeat2DAVG == a || config.calculateAllFeatures == 1) {
 
-		ngldm2DAVG.calculateAllNGLDMFeatures2DAVG(ngldm2DAVG, imageAttr, NGLDMatrix, config);
-		std::string forLog = "NGLDM2DAVG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		ngldm2DAVG.writeCSVFileNGLDM2DAVG(ngldm2DAVG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		ngldm2DAVG.writeOneFileNGLDM2DAVG(ngldm2DAVG, config, config.featureParameterSpaceNr);
-	}
+			ngldm2DAVG.calculateAllNGLDMFeatures2DAVG(ngldm2DAVG, imageAttr, NGLDMatrix, config);
+			std::string forLog = "NGLDM2DAVG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("NGLDMFeatures2DAVG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			ngldm2DAVG.writeCSVFileNGLDM2DAVG(ngldm2DAVG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			ngldm2DAVG.writeOneFileNGLDM2DAVG(ngldm2DAVG, config, config.featureParameterSpaceNr);
+		}
+	});
 	
-	NGLDMFeatures2DMRG<float, 3> ngldm2DMRG;
-	if (ngldmFeat2DMRG == a || config.calculateAllFeatures == 1) {
+	calculateFamily(featureCache, "NGLDMFeatures2DMRG", config.calculateAllFeatures == 1 || ngldmFeat2DMRG == a, [&]() {
+		TraceStage familyStage(config, "NGLDMFeatures2DMRG", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		NGLDMFeatures2DMRG<float, 3> ngldm2DMRG;
+		if (ngldmFeat2DMRG == a || config.calculateAllFeatures == 1) {
 
-		ngldm2DMRG.calculateAllNGLDMFeatures2DMRG(ngldm2DMRG, imageAttr, NGLDMatrix, config);
-		std::string forLog = "NGLDM2DMRG features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
+			ngldm2DMRG.calculateAllNGLDMFeatures2DMRG(ngldm2DMRG, imageAttr, NGLDMatrix, config);
+			std::string forLog = "NGLDM2DMRG features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
 
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		ngldm2DMRG.writeCSVFileNGLDM2DMRG(ngldm2DMRG, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		ngldm2DMRG.writeOneFileNGLDM2DMRG(ngldm2DMRG, config, config.featureParameterSpaceNr);
-	}
+		}
+		familyStage.next("NGLDMFeatures2DMRG writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			ngldm2DMRG.writeCSVFileNGLDM2DMRG(ngldm2DMRG, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			ngldm2DMRG.writeOneFileNGLDM2DMRG(ngldm2DMRG, config, config.featureParameterSpaceNr);
+		}
+	});
 	
-	NGLDMFeatures3D<float, 3> ngldm3D;
-	if (ngldmFeat3D == a || config.calculateAllFeatures == 1) {
+	calculateFamily(featureCache, "NGLDMFeatures3D", config.calculateAllFeatures == 1 || ngldmFeat3D == a, [&]() {
+		TraceStage familyStage(config, "NGLDMFeatures3D", "feature", imageAttr.vectorOfMatrixElements.size(), imageAttr.diffGreyLevels.size());
+		NGLDMFeatures3D<float, 3> ngldm3D;
+		if (ngldmFeat3D == a || config.calculateAllFeatures == 1) {
 
-		ngldm3D.calculateAllNGLDMFeatures3D(ngldm3D, ngldm3DMatrixSum, imageAttr, config);
-		std::string forLog = "NGLDM3D features were calculated.";
-		writeLogFile(config.outputFolder, forLog);
-	}
-	if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
-		ngldm3D.writeCSVFileNGLDM3D(ngldm3D, config.outputFolder);
-	}
-	else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
-		ngldm3D.writeOneFileNGLDM3D(ngldm3D, config, config.featureParameterSpaceNr);
-	}
+			ngldm3D.calculateAllNGLDMFeatures3D(ngldm3D, ngldm3DMatrixSum, imageAttr, config);
+			std::string forLog = "NGLDM3D features were calculated.";
+			writeLogFile(config.outputFolder, forLog);
+		}
+		familyStage.next("NGLDMFeatures3D writer", "writer");
+		if (config.csvOutput == 1 && config.getOneCSVFile == 0) {
+			ngldm3D.writeCSVFileNGLDM3D(ngldm3D, config.outputFolder);
+		}
+		else if ((config.csvOutput == 1 && config.getOneCSVFile == 1) || config.ontologyOutput == 1) {
+			ngldm3D.writeOneFileNGLDM3D(ngldm3D, config, config.featureParameterSpaceNr);
+		}
+	});
 		
 	std::cout << "NGLDM features are calculated" << std::endl;
 
@@ -3,11 +3,15 @@
 
 #include "configFlags.h"
 #include "getNeighborhoodMatrices.h"
+#include "featureCache.h"
+#include "stageTrace.h"
 
 
 //void readInFeatureSelection(EFoobar::Flags &featureFlags, string featureSelectionPath);
-void CalculateRelFeatures(Image<float, 3> imageAttr, ConfigFile config);
-void calculateRelFeaturesDiscretized(Image<float, 3> imageAttr, vector<double> spacing, ConfigFile config);
+template <class F>
+void calculateFamily(FeatureCache &featureCache, const string &familyName, bool selected, F calculate);
+void CalculateRelFeatures(const Image<float, 3> &imageAttr, const LesionLabels *lesions, const ConfigFile &config, FeatureCache &featureCache);
+void calculateRelFeaturesDiscretized(const Image<float, 3> &imageAttr, const vector<float> &spacing, ConfigFile config, FeatureCache &featureCache);
 void writeLogFile(string logFileName, std::string &text);
 #include "readInFeatureSelection.cpp"
 
@@ -1,5 +1,8 @@
 //convert an array to an ITK image
-ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float *voxelSize) {
+//if imageOwnsArray is set, the array has to be allocated with new[] and is freed by ITK together with the image
+//if nrSlices is set, the array contains only the slices firstSlice to firstSlice + nrSlices of the image with size dim,
+//the origin is shifted, so that the slices have the same position as in the whole image
+ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float *voxelSize, bool imageOwnsArray, unsigned int firstSlice, unsigned int nrSlices) {
 	
 	ImageType::Pointer finalImage;
 	//write the array in image
@@ -9,8 +12,11 @@ ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float
 	size[0] = dim[0];
 	size[1] = dim[1];
 	size[2] = dim[2];
+	if (nrSlices > 0) {
+		size[2] = nrSlices;
+	}
 
-	int nrVoxelsPET = dim[0] * dim[1] * dim[2];
+	int nrVoxelsPET = size[0] * size[1] * size[2];
 	//start with importing the image
 	ImportFilterType::IndexType start;
 	start.Fill(0);
@@ -24,7 +30,8 @@ ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float
 	float centerY = float((voxelSize[1] * dim[1]) / 2.0);
 
 	float centerZ = float((voxelSize[2] * dim[2]) / 2.0);
-	const itk::SpacePrecisionType origin[3] = { centerX, centerY, -centerZ };
+	float firstSliceZ = float(voxelSize[2] * firstSlice);
+	const itk::SpacePrecisionType origin[3] = { centerX, centerY, -centerZ + firstSliceZ };
 	const itk::SpacePrecisionType spacing[3] = { voxelSize[0], voxelSize[1], voxelSize[2] };
 	importFilter->SetOrigin(origin);
 	importFilter->SetSpacing(spacing);
@@ -32,7 +39,9 @@ ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float
 	importFilter->SetImportPointer(imageArray, nrVoxelsPET, importImageFilterWillOwnTheBuffer);
 	importFilter->Update();
 	finalImage = importFilter->GetOutput();
-	finalImage->Register();
+	if (imageOwnsArray == false) {
+		finalImage->Register();
+	}
 
 	using FlipImageFilterType = itk::FlipImageFilter<ImageType>;
 	FlipImageFilterType::Pointer flipFilter = FlipImageFilterType::New();
@@ -49,70 +58,157 @@ ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float
 
 
 //the project file of the accurate tool is read in
-ImageType::Pointer readPrjFilePET(string prjPath, string imageType, float smoothingKernel, unsigned int(&dimPET)[3], float(&voxelSize)[3]) {
-	//help array to read in the integer byte
-	unsigned int dimCT[3];
-	float voxelSizeCT[3];
-	float halfLife, volumeScale, frameScale;
+//the file is mapped into memory, only the section of the image type set in the config file is copied
+//if nrSlices is set, only the PET slices firstSlice to firstSlice + nrSlices are copied
+//the image is not smoothed here, smoothing is applied once in readImageAndMask for all input formats
+ImageType::Pointer readPrjFilePET(string prjPath, string imageType, unsigned int(&dimPET)[3], float(&voxelSize)[3], unsigned int firstSlice, unsigned int nrSlices) {
 	ImageType::Pointer PETimage;
-	//read in prj file
-	ifstream prjfile;
-	prjfile.open(prjPath, ios::binary);
-	if (prjfile.is_open() == false) {
+	boost::interprocess::file_mapping prjMapping;
+	boost::interprocess::mapped_region prjRegion;
+	try {
+		prjMapping = boost::interprocess::file_mapping(prjPath.c_str(), boost::interprocess::read_only);
+		prjRegion = boost::interprocess::mapped_region(prjMapping, boost::interprocess::read_only);
+	}
+	catch (boost::interprocess::interprocess_exception &) {
 		std::cout << "Cannot open project file\n";
+		return PETimage;
 	}
-	else {
-		//get the image dimensions, voxel sizes and half life of the tracer
-		getImageDimension(prjfile, dimPET);
-		getVoxelSize(prjfile, voxelSize);
-		getHalfLifeScale(prjfile, halfLife, volumeScale, frameScale);
-		getImageDimension(prjfile, dimCT);
-		getVoxelSize(prjfile, voxelSizeCT);
-		int nrVoxelsPET = int(dimPET[0] * dimPET[1] * dimPET[2]);
-		vector<float> petVector(nrVoxelsPET);
-		vector<float> ctVector(nrVoxelsPET);
-		getImageValues(prjfile, petVector);
-		
-		
-		//if image is PET image get array with PET values
-		if (imageType == "PET") {
-			float *arr = &petVector[0];
-			PETimage = converArray2Image(arr, dimPET, voxelSize);
-			PETimage->Update();
-			vector<float>().swap(petVector);
-			arr = nullptr;
-		}
+	const char *prjData = static_cast<const char*>(prjRegion.get_address());
+	size_t fileSize = prjRegion.get_size();
+	if (fileSize < prjHeaderSize) {
+		std::cout << "The project file is too small to contain an image\n";
+		return PETimage;
+	}
+	//get the image dimensions, voxel sizes and half life of the tracer
+	PrjHeader header;
+	getPrjHeader(prjData, header);
+	std::copy(header.dimPET, header.dimPET + 3, dimPET);
+	std::copy(header.voxelSizePET, header.voxelSizePET + 3, voxelSize);
+	int nrVoxelsPET = int(dimPET[0] * dimPET[1] * dimPET[2]);
+	int nrVoxelsCT = int(header.dimCT[0] * header.dimCT[1] * header.dimCT[2]);
+	//the PET values follow the header, the CT values follow the PET values
+	size_t offsetPET = prjHeaderSize;
+	size_t offsetCT = offsetPET + size_t(nrVoxelsPET) * sizeof(float);
 
-		//else get arrat with CT values
-		else if (imageType == "CT") {
-			getImageValues(prjfile, ctVector);
-			float *arr = &ctVector[0];
-			PETimage = converArray2Image(arr, dimCT, voxelSizeCT);
-			PETimage->Update();
+	//if image is PET image get array with PET values
+	if (imageType == "PET") {
+		if (offsetPET + size_t(nrVoxelsPET) * sizeof(float) > fileSize) {
+			std::cout << "The project file does not contain the whole PET image\n";
+			return PETimage;
+		}
+		if (nrSlices > 0 && firstSlice + nrSlices <= dimPET[2]) {
+			//the slices are stored one after the other, so the slab is one section of the file
+			int nrVoxelsSlice = int(dimPET[0] * dimPET[1]);
+			size_t offsetSlab = offsetPET + size_t(firstSlice) * size_t(nrVoxelsSlice) * sizeof(float);
+			float *arr = getPrjSection(prjData, offsetSlab, nrVoxelsSlice * int(nrSlices));
+			PETimage = converArray2Image(arr, dimPET, voxelSize, true, firstSlice, nrSlices);
 		}
 		else {
-			std::cout << "Unknown image type. Please check the image type in the config file" << std::endl;
+			float *arr = getPrjSection(prjData, offsetPET, nrVoxelsPET);
+			PETimage = converArray2Image(arr, dimPET, voxelSize, true);
 		}
-		itk::FixedArray<bool, 3> flipAxes;
-		flipAxes[0] = false;
-		flipAxes[1] = false;
-		flipAxes[2] = false;
-		typedef itk::FlipImageFilter <ImageType> FlipImageFilterType;
-		FlipImageFilterType::Pointer flipFilter = FlipImageFilterType::New();
-		flipFilter->SetInput(PETimage);
-		flipFilter->SetFlipAxes(flipAxes);
-		flipFilter->Update();
-		PETimage = flipFilter->GetOutput();
 		PETimage->Update();
-		if (smoothingKernel > 0) {
+	}
 
-			PETimage = smoothImage(PETimage, smoothingKernel);
+	//else get arrat with CT values
+	else if (imageType == "CT") {
+		if (offsetCT + size_t(nrVoxelsCT) * sizeof(float) > fileSize) {
+			std::cout << "The project file does not contain the whole CT image\n";
+			return PETimage;
 		}
-		prjfile.close();
+		float *arr = getPrjSection(prjData, offsetCT, nrVoxelsCT);
+		PETimage = converArray2Image(arr, header.dimCT, header.voxelSizeCT, true);
+		PETimage->Update();
+	}
+	else {
+		std::cout << "Unknown image type. Please check the image type in the config file" << std::endl;
+		return PETimage;
 	}
+	itk::FixedArray<bool, 3> flipAxes;
+	flipAxes[0] = false;
+	flipAxes[1] = false;
+	flipAxes[2] = false;
+	typedef itk::FlipImageFilter <ImageType> FlipImageFilterType;
+	FlipImageFilterType::Pointer flipFilter = FlipImageFilterType::New();
+	flipFilter->SetInput(PETimage);
+	flipFilter->SetFlipAxes(flipAxes);
+	flipFilter->Update();
+	PETimage = flipFilter->GetOutput();
+	PETimage->Update();
 	return PETimage;
 }
 
+/*!
+\brief getPrjDimensions
+The function reads only the PET image dimensions and voxel sizes from the header of the prj file. \n
+They are needed to read the voi file before the image.
+@param[in] prjPath: path of the prj file
+@param[out] dimPET: dimensions of the PET image
+@param[out] voxelSize: voxel size of the PET image
+@param[out] false if the file could not be read
+*/
+bool getPrjDimensions(string prjPath, unsigned int(&dimPET)[3], float(&voxelSize)[3]) {
+	ifstream inFile(prjPath.c_str(), ios::in | ios::binary);
+	if (!inFile) {
+		std::cout << "Cannot open project file\n";
+		return false;
+	}
+	char headerData[prjHeaderSize];
+	if (!inFile.read(headerData, prjHeaderSize)) {
+		std::cout << "The project file is too small to contain an image\n";
+		return false;
+	}
+	PrjHeader header;
+	getPrjHeader(headerData, header);
+	std::copy(header.dimPET, header.dimPET + 3, dimPET);
+	std::copy(header.voxelSizePET, header.voxelSizePET + 3, voxelSize);
+	return true;
+}
+
+/*!
+\brief getPrjHeader
+The function reads the header of the prj file: the dimensions are stored as short, the voxel sizes and scales as float.
+@param[in] prjData: start of the mapped prj file
+@param[out] header: values of the header
+*/
+void getPrjHeader(const char *prjData, PrjHeader &header) {
+	short dim[3];
+	size_t offset = 0;
+	std::memcpy(dim, prjData + offset, sizeof(dim));
+	offset += sizeof(dim);
+	for (int i = 0; i < 3; i++) {
+		header.dimPET[i] = int(dim[i]);
+	}
+	std::memcpy(header.voxelSizePET, prjData + offset, sizeof(header.voxelSizePET));
+	offset += sizeof(header.voxelSizePET);
+	std::memcpy(&header.halfLife, prjData + offset, sizeof(float));
+	offset += sizeof(float);
+	std::memcpy(&header.volumeScale, prjData + offset, sizeof(float));
+	offset += sizeof(float);
+	std::memcpy(&header.frameScale, prjData + offset, sizeof(float));
+	offset += sizeof(float);
+	std::memcpy(dim, prjData + offset, sizeof(dim));
+	offset += sizeof(dim);
+	for (int i = 0; i < 3; i++) {
+		header.dimCT[i] = int(dim[i]);
+	}
+	std::memcpy(header.voxelSizeCT, prjData + offset, sizeof(header.voxelSizeCT));
+}
+
+/*!
+\brief getPrjSection
+The function copies the float values of one image from the mapped file in a new array. \n
+This is the only copy of the values, the array is given to ITK which frees it together with the image.
+@param[in] prjData: start of the mapped prj file
+@param[in] offset: position of the first value in bytes
+@param[in] nrVoxels: number of values
+*/
+float *getPrjSection(const char *prjData, size_t offset, int nrVoxels) {
+	float *imageArray = new float[nrVoxels];
+	std::memcpy(imageArray, prjData + offset, size_t(nrVoxels) * sizeof(float));
+	return imageArray;
+}
+
 //to do: read in as array
 void getHalfLifeScale(ifstream &inFile, float &halfLife, float &volumeScale, float &frameScale) {
 	inFile.read((char*)&halfLife, sizeof(float));
@@ -121,9 +217,7 @@ void getHalfLifeScale(ifstream &inFile, float &halfLife, float &volumeScale, flo
 }
 
 void getImageValues(ifstream &inFile, vector<float> &imageArray) {
-	for (int i = 0; i < boost::size(imageArray); i++) {
-		inFile.read((char*)&imageArray[i], sizeof(float));
-	}
+	inFile.read((char*)&imageArray[0], boost::size(imageArray) * sizeof(float));
 }
 //get the dimension of the image
 void getImageDimension(ifstream &inFile, unsigned int(&dim)[3]) {
@@ -148,47 +242,40 @@ void getVoxelSize(ifstream &inFile, float(&voxelSize)[3]) {
 
 }
 
+//the voi file is mapped into memory, the mask values are stored in the second half of the file (one byte per voxel)
 ImageType::Pointer readVoiFilePET(string prjPath, string voiPath, ImageType *image, ConfigFile config, unsigned int(&dimPET)[3], float voxelSize[3]) {
 	ImageType::Pointer maskImage;
-	//parameters to store the dimension of the PET and CT image
-	//the voxel size, halfLife of the tracer, the volume scale and the frame scale
 	int nrVoxelsPET = int(dimPET[0] * dimPET[1] * dimPET[2]);
-	//prjfile.close();
 	//open the voi file
-	ifstream voiFile;
-	voiFile.open(voiPath, ios::in | ios::binary);
-	if (voiFile.is_open() == false) {
+	boost::interprocess::file_mapping voiMapping;
+	boost::interprocess::mapped_region voiRegion;
+	try {
+		voiMapping = boost::interprocess::file_mapping(voiPath.c_str(), boost::interprocess::read_only);
+		voiRegion = boost::interprocess::mapped_region(voiMapping, boost::interprocess::read_only);
+	}
+	catch (boost::interprocess::interprocess_exception &) {
 		std::cout << "Cannot open voi file\n";
 		exit(0);
 	}
-	else {
-		//read the voi file
-		streampos begin, end;
-		begin = voiFile.tellg();
-		voiFile.seekg(0, ios::end);
-		end = voiFile.tellg();
-		int fileSize = (end - begin);
-		//vector to store all the elements
-		vector<char> wholeFile(fileSize);
-
-		voiFile.seekg(0, std::ios::beg);
-		voiFile.read(&wholeFile[0], fileSize);
-		vector< float> mask(fileSize);
-
-		transform(wholeFile.begin(), wholeFile.end(), mask.begin(), [](auto& elem) {return ((float)(elem)); });
-
-		vector< float> voi(wholeFile.begin() + (fileSize / 2), wholeFile.end());
-
-		float *voiArray = &voi[0];
-		//convert the array to an ITK image
-		maskImage = converArray2Image(voiArray, dimPET, voxelSize);
-		maskImage->Update();
-		voiFile.close();
-		//clean memory
-		voiArray = nullptr;
-		vector<float>().swap(voi);
-		vector<float>().swap(mask);
-
+	const char *voiData = static_cast<const char*>(voiRegion.get_address());
+	size_t fileSize = voiRegion.get_size();
+	size_t voiStart = fileSize / 2;
+	size_t nrVoiValues = fileSize - voiStart;
+	if (nrVoiValues < size_t(nrVoxelsPET)) {
+		std::cout << "The voi file is smaller than the PET image, the missing voxels are set to 0\n";
 	}
+	//convert the mask values directly in the array that is given to ITK
+	float *voiArray = new float[nrVoxelsPET];
+	for (size_t i = 0; i < size_t(nrVoxelsPET); i++) {
+		if (i < nrVoiValues) {
+			voiArray[i] = float(voiData[voiStart + i]);
+		}
+		else {
+			voiArray[i] = 0;
+		}
+	}
+	//convert the array to an ITK image
+	maskImage = converArray2Image(voiArray, dimPET, voxelSize, true);
+	maskImage->Update();
 	return maskImage;
-}
\ No newline at end of file
+}
@@ -4,11 +4,27 @@
 #include "readImages.h"
 #include "featureCalculation.h"
 #include "itkTypes.h"
+#include <cstring>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+//header at the beginning of the prj file: PET dimension, PET voxel size, half life and scales, CT dimension, CT voxel size
+struct PrjHeader {
+	unsigned int dimPET[3];
+	float voxelSizePET[3];
+	float halfLife;
+	float volumeScale;
+	float frameScale;
+	unsigned int dimCT[3];
+	float voxelSizeCT[3];
+};
+//size of the header in bytes (the dimensions are stored as short, all other values as float)
+const size_t prjHeaderSize = 6 * sizeof(short) + 9 * sizeof(float);
 
 //functions to read accurate files
-ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float *voxelSize);
+ImageType::Pointer converArray2Image(float *imageArray, unsigned int* dim, float *voxelSize, bool imageOwnsArray = false, unsigned int firstSlice = 0, unsigned int nrSlices = 0);
 //read the file into array and stores it as ITK image
-ImageType::Pointer readPrjFilePET(string prjPath, string imageType, float smoothingKernel, unsigned int(&dim)[3], float (&voxelSize)[3]);
+ImageType::Pointer readPrjFilePET(string prjPath, string imageType, unsigned int(&dim)[3], float (&voxelSize)[3], unsigned int firstSlice = 0, unsigned int nrSlices = 0);
 //get image dimensions etc from the prj file
 ImageType::Pointer readVoiFilePET(string prjPath, string voiPath, ImageType *image, ConfigFile config, unsigned int(&dim)[3], float voxelSize[3]);
 
@@ -16,6 +32,12 @@ void getImageDimension(ifstream &inFile, unsigned int(&dim)[3]);
 void getVoxelSize(ifstream &inFile, float(&voxelSize)[3]);
 void getImageValues(ifstream &inFile, vector<float> &imageArray);
 void getHalfLifeScale(ifstream &inFile, float &halfLife, float &volumeScale, float &frameScale);
+//read only the PET dimensions and voxel sizes from the prj file
+bool getPrjDimensions(string prjPath, unsigned int(&dimPET)[3], float(&voxelSize)[3]);
+//read the header from the mapped prj file
+void getPrjHeader(const char *prjData, PrjHeader &header);
+//copy one image section of a mapped file in a new array that can be given to ITK
+float *getPrjSection(const char *prjData, size_t offset, int nrVoxels);
 #include "readPrj.cpp"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,226 @@
+/*!
+\brief read
+The function read parses the RT struct file once: the names and numbers of all ROIs (structure set ROI sequence) and
+the contours of all ROIs (ROI contour sequence). Contours of the type POINT are ignored, as they cannot be filled.
+@param[in] rtStructPath: path of the RT struct file
+@param[out] bool: false if the file cannot be read or is not a RT struct file
+*/
+bool RTStruct::read(string rtStructPath) {
+	rois.clear();
+	gdcm::Reader reader;
+	reader.SetFileName(rtStructPath.c_str());
+	if (!reader.Read()) {
+		std::cout << "Problem reading file: " << rtStructPath << std::endl;
+		return false;
+	}
+	const gdcm::DataSet &dataSet = reader.GetFile().GetDataSet();
+	// (3006,0020) SQ StructureSetROISequence
+	gdcm::Tag structureSetTag(0x3006, 0x0020);
+	// (3006,0039) SQ ROIContourSequence
+	gdcm::Tag roiContourTag(0x3006, 0x0039);
+	if (!dataSet.FindDataElement(structureSetTag) || !dataSet.FindDataElement(roiContourTag)) {
+		std::cout << "Problem locating 0x3006,0x0020 or 0x3006,0x0039 - Is this a valid RT Struct file?" << std::endl;
+		return false;
+	}
+	gdcm::SmartPointer<gdcm::SequenceOfItems> structureSet = dataSet.GetDataElement(structureSetTag).GetValueAsSQ();
+	gdcm::SmartPointer<gdcm::SequenceOfItems> roiContours = dataSet.GetDataElement(roiContourTag).GetValueAsSQ();
+	if (!structureSet || !roiContours) {
+		std::cout << "The RT struct file " << rtStructPath << " does not contain any structure" << std::endl;
+		return false;
+	}
+	for (size_t itemNr = 1; itemNr <= structureSet->GetNumberOfItems(); itemNr++) {
+		const gdcm::DataSet &roiDataSet = structureSet->GetItem(itemNr).GetNestedDataSet();
+		gdcm::Attribute<0x3006, 0x0022> roiNumber;
+		roiNumber.SetFromDataSet(roiDataSet);
+		RTStructROI roi;
+		roi.number = roiNumber.GetValue();
+		roi.name = getDicomString(roiDataSet, gdcm::Tag(0x3006, 0x0026));
+		rois.push_back(roi);
+	}
+	for (size_t itemNr = 1; itemNr <= roiContours->GetNumberOfItems(); itemNr++) {
+		const gdcm::DataSet &roiDataSet = roiContours->GetItem(itemNr).GetNestedDataSet();
+		gdcm::Attribute<0x3006, 0x0084> referencedNumber;
+		referencedNumber.SetFromDataSet(roiDataSet);
+		vector<RTStructROI>::iterator roiIt = std::find_if(rois.begin(), rois.end(), [&](const RTStructROI &roi) {
+			return roi.number == referencedNumber.GetValue();
+		});
+		// (3006,0040) SQ ContourSequence
+		gdcm::Tag contourSequenceTag(0x3006, 0x0040);
+		if (roiIt == rois.end() || !roiDataSet.FindDataElement(contourSequenceTag)) {
+			continue;
+		}
+		gdcm::SmartPointer<gdcm::SequenceOfItems> contours = roiDataSet.GetDataElement(contourSequenceTag).GetValueAsSQ();
+		if (!contours) {
+			continue;
+		}
+		for (size_t contourNr = 1; contourNr <= contours->GetNumberOfItems(); contourNr++) {
+			const gdcm::DataSet &contourDataSet = contours->GetItem(contourNr).GetNestedDataSet();
+			// (3006,0042) CS ContourGeometricType, (3006,0050) DS ContourData
+			gdcm::Tag contourDataTag(0x3006, 0x0050);
+			if (getDicomString(contourDataSet, gdcm::Tag(0x3006, 0x0042)) == "POINT" || !contourDataSet.FindDataElement(contourDataTag)) {
+				continue;
+			}
+			gdcm::Attribute<0x3006, 0x0050> contourData;
+			contourData.SetFromDataElement(contourDataSet.GetDataElement(contourDataTag));
+			const double *points = contourData.GetValues();
+			vector<double> contour(points, points + contourData.GetNumberOfValues());
+			//a polygon needs at least three points
+			if (contour.size() >= 9) {
+				roiIt->contours.push_back(contour);
+			}
+		}
+	}
+	return true;
+}
+
+const vector<RTStructROI> &RTStruct::getROIs() const {
+	return rois;
+}
+
+/*!
+\brief selectROIs
+The function selectROIs finds the ROIs with the given names.
+@param[in] roiNames: names of the ROIs separated by commas, if empty all ROIs that have contours are selected
+@param[out] vector<int>: positions of the selected ROIs in the ROI list
+*/
+vector<int> RTStruct::selectROIs(string roiNames) const {
+	vector<int> selectedROIs;
+	std::istringstream nameStream(roiNames);
+	string name;
+	while (std::getline(nameStream, name, ',')) {
+		size_t first = name.find_first_not_of(' ');
+		if (first == string::npos) {
+			continue;
+		}
+		name = name.substr(first, name.find_last_not_of(' ') - first + 1);
+		vector<RTStructROI>::const_iterator roiIt = std::find_if(rois.begin(), rois.end(), [&](const RTStructROI &roi) {
+			return roi.name == name;
+		});
+		if (roiIt == rois.end()) {
+			std::cout << "The ROI " << name << " was not found in the RT struct file" << std::endl;
+			continue;
+		}
+		selectedROIs.push_back(int(roiIt - rois.begin()));
+	}
+	if (roiNames.find_first_not_of(" ,") == string::npos) {
+		for (size_t roiNr = 0; roiNr < rois.size(); roiNr++) {
+			if (!rois[roiNr].contours.empty()) {
+				selectedROIs.push_back(int(roiNr));
+			}
+		}
+	}
+	return selectedROIs;
+}
+
+/*!
+\brief rasterize
+The function rasterize converts the contours of the selected ROIs to a label image on the grid of the image.
+@param[in] image: image that defines the grid of the label image
+@param[in] selectedROIs: positions of the ROIs in the ROI list (see selectROIs), the n-th ROI gets the label n
+@param[in] nrThreads: number of threads, if 0 the number of cores is used
+@param[out] ImageType: label image
+*/
+ImageType::Pointer RTStruct::rasterize(ImageType *image, const vector<int> &selectedROIs, unsigned int nrThreads) const {
+	ImageType::Pointer labelImage = ImageType::New();
+	labelImage->CopyInformation(image);
+	labelImage->SetRegions(image->GetLargestPossibleRegion());
+	labelImage->Allocate();
+	labelImage->FillBuffer(0);
+	const RegionType &region = labelImage->GetLargestPossibleRegion();
+	int nrColumns = int(region.GetSize()[0]);
+	int nrRows = int(region.GetSize()[1]);
+	int nrSlices = int(region.GetSize()[2]);
+
+	//the contours are converted to index coordinates (x, y of every point) and sorted by slice and label
+	vector<vector<vector<vector<double> > > > sliceContours(nrSlices, vector<vector<vector<double> > >(selectedROIs.size()));
+	int nrPointsOutside = 0;
+	for (size_t labelNr = 0; labelNr < selectedROIs.size(); labelNr++) {
+		for (const vector<double> &contour : rois[selectedROIs[labelNr]].contours) {
+			size_t nrPoints = contour.size() / 3;
+			vector<double> indexContour(2 * nrPoints);
+			double sliceIndex = 0;
+			for (size_t pointNr = 0; pointNr < nrPoints; pointNr++) {
+				ImageType::PointType point;
+				for (int i = 0; i < 3; i++) {
+					point[i] = contour[3 * pointNr + i];
+				}
+				itk::ContinuousIndex<double, 3> index;
+				labelImage->TransformPhysicalPointToContinuousIndex(point, index);
+				indexContour[2 * pointNr] = index[0] - double(region.GetIndex()[0]);
+				indexContour[2 * pointNr + 1] = index[1] - double(region.GetIndex()[1]);
+				sliceIndex += index[2] - double(region.GetIndex()[2]);
+			}
+			//the contour is assigned to the nearest slice
+			long slice = std::lround(sliceIndex / double(nrPoints));
+			if (slice < 0 || slice >= nrSlices) {
+				nrPointsOutside += int(nrPoints);
+				continue;
+			}
+			sliceContours[slice][labelNr].push_back(indexContour);
+		}
+	}
+	if (nrPointsOutside > 0) {
+		std::cout << " --" << nrPointsOutside << " contour points detected outside image boundary. Please check the output volume. " << std::endl;
+	}
+
+	float *buffer = labelImage->GetBufferPointer();
+	runParallel(size_t(std::max(nrSlices, 0)), nrThreads, [&](size_t slice) {
+		float *sliceBuffer = buffer + slice * nrColumns * nrRows;
+		for (size_t labelNr = 0; labelNr < selectedROIs.size(); labelNr++) {
+			if (!sliceContours[slice][labelNr].empty()) {
+				fillSlice(sliceContours[slice][labelNr], int(labelNr + 1), nrColumns, nrRows, sliceBuffer);
+			}
+		}
+	});
+	return labelImage;
+}
+
+/*!
+\brief fillSlice
+The function fillSlice fills the contours of one ROI on one slice with a scanline algorithm (even-odd rule).
+@param[in] sliceContours: contours in index coordinates (x, y of every point)
+@param[in] label: value of the voxels inside the ROI
+@param[in] nrColumns, nrRows: size of the slice
+@param[in,out] sliceBuffer: values of the slice
+*/
+void RTStruct::fillSlice(const vector<vector<double> > &sliceContours, int label, int nrColumns, int nrRows, float *sliceBuffer) const {
+	double minY = std::numeric_limits<double>::max();
+	double maxY = -std::numeric_limits<double>::max();
+	for (const vector<double> &contour : sliceContours) {
+		for (size_t i = 1; i < contour.size(); i += 2) {
+			minY = std::min(minY, contour[i]);
+			maxY = std::max(maxY, contour[i]);
+		}
+	}
+	int firstRow = std::max(0, int(std::ceil(minY)));
+	int lastRow = std::min(nrRows - 1, int(std::floor(maxY)));
+	vector<double> crossings;
+	for (int row = firstRow; row <= lastRow; row++) {
+		//the voxel centers of the row have the index coordinate y = row
+		double y = double(row);
+		crossings.clear();
+		for (const vector<double> &contour : sliceContours) {
+			size_t nrPoints = contour.size() / 2;
+			for (size_t i = 0; i < nrPoints; i++) {
+				size_t j = (i + 1) % nrPoints;
+				double y0 = contour[2 * i + 1];
+				double y1 = contour[2 * j + 1];
+				//an edge contains its lower end point and not the upper one, so a vertex on the row is counted once
+				if ((y0 <= y && y < y1) || (y1 <= y && y < y0)) {
+					double x0 = contour[2 * i];
+					double x1 = contour[2 * j];
+					crossings.push_back(x0 + (y - y0) * (x1 - x0) / (y1 - y0));
+				}
+			}
+		}
+		std::sort(crossings.begin(), crossings.end());
+		for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+			//voxels with crossings[k] <= x < crossings[k + 1] are inside
+			int firstColumn = std::max(0, int(std::ceil(crossings[k])));
+			int lastColumn = std::min(nrColumns - 1, int(std::ceil(crossings[k + 1])) - 1);
+			for (int column = firstColumn; column <= lastColumn; column++) {
+				sliceBuffer[size_t(row) * nrColumns + column] = float(label);
+			}
+		}
+	}
+}
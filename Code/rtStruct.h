@@ -0,0 +1,58 @@
+#ifndef RTSTRUCT_H_INCLUDED
+#define RTSTRUCT_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gdcmAttribute.h>
+#include <gdcmReader.h>
+#include <gdcmSequenceOfItems.h>
+#include "itkTypes.h"
+#include "dicomIndex.h"
+using namespace itkTypes;
+using namespace std;
+
+/*! \file */
+
+/*!
+One ROI of a RT struct file: number and name from the structure set ROI sequence and the contours of the ROI contour sequence.
+The points of every contour are stored as x, y, z in mm.
+*/
+struct RTStructROI {
+	int number;
+	string name;
+	vector<vector<double> > contours;
+};
+
+/*!
+The class RTStruct reads all ROIs of a RT struct file in one pass and rasterizes the selected ROIs on the grid of an image. \n
+The contours of every ROI are assigned to the nearest slice of the image. In every slice the ROI is filled with a scanline algorithm:
+for every row the crossings of all contours of the ROI on the slice are sorted and the voxels between pairs of crossings are set
+(even-odd rule, so holes given as inner contours are kept). A voxel is inside if its center is inside. \n
+The slices are filled in parallel. The result is a label image: the voxels of the n-th selected ROI get the value n.
+If ROIs overlap, the ROI that is selected later is kept.
+*/
+class RTStruct {
+private:
+	vector<RTStructROI> rois;
+
+	void fillSlice(const vector<vector<double> > &sliceContours, int label, int nrColumns, int nrRows, float *sliceBuffer) const;
+
+public:
+	RTStruct() {
+	}
+	~RTStruct() {
+	}
+	bool read(string rtStructPath);
+	const vector<RTStructROI> &getROIs() const;
+	vector<int> selectROIs(string roiNames) const;
+	ImageType::Pointer rasterize(ImageType *image, const vector<int> &selectedROIs, unsigned int nrThreads = 0) const;
+};
+
+#include "rtStruct.cpp"
+
+#endif // RTSTRUCT_H_INCLUDED
@@ -0,0 +1,213 @@
+//all traces of the process are written under one lock, the threads get small numbers in the order they write their first stage
+struct TraceWriter {
+	mutex writeMutex;
+	set<string> startedFiles;
+	map<std::thread::id, int> threadNrs;
+};
+
+static TraceWriter &getTraceWriter() {
+	static TraceWriter writer;
+	return writer;
+}
+
+//string in JSON notation (paths can contain backslashes)
+static string getJSONString(const string &text) {
+	string json = "\"";
+	for (size_t i = 0; i < text.size(); i++) {
+		if (text[i] == '"' || text[i] == '\\') {
+			json += '\\';
+		}
+		json += text[i];
+	}
+	return json + "\"";
+}
+
+/*!
+\brief TraceStage
+The constructor starts the stage, if the config writes a trace.
+@param[in] config: config file with all information of the config.ini file
+@param[in] stageName: name of the stage, e.g. the name of the feature family
+@param[in] stageCategory: kind of the stage (e.g. read, preprocessing, feature, writer)
+@param[in] nrVoxels: number of voxels the stage works on (0: not written)
+@param[in] nrGreyLevels: number of grey levels, i.e. the number of rows of the texture matrices (0: not written)
+*/
+TraceStage::TraceStage(const ConfigFile &config, const string &stageName, const string &stageCategory, size_t nrVoxels, size_t nrGreyLevels)
+	: voxels(nrVoxels), greyLevels(nrGreyLevels), running(false), startSeconds(0), startCPUSeconds(0), startPeakMemory(0) {
+	if (config.writeTrace != 1) {
+		return;
+	}
+	traceFile = config.traceFile;
+	traceFormat = config.traceFormat;
+	output = config.outputFolder;
+	start(stageName, stageCategory);
+}
+
+TraceStage::~TraceStage() {
+	stop();
+}
+
+void TraceStage::start(const string &stageName, const string &stageCategory) {
+	name = stageName;
+	category = stageCategory;
+	running = true;
+	startPeakMemory = getPeakMemoryMB();
+	startCPUSeconds = getThreadCPUSeconds();
+	startSeconds = getTraceSeconds();
+}
+
+//sizes that are only known during the stage (e.g. after reading the image)
+void TraceStage::setSize(size_t nrVoxels, size_t nrGreyLevels) {
+	voxels = nrVoxels;
+	greyLevels = nrGreyLevels;
+}
+
+/*!
+\brief next
+The function next ends the stage and starts the next one with the same sizes (e.g. the writer after the calculation of a feature family).
+*/
+void TraceStage::next(const string &stageName, const string &stageCategory) {
+	if (traceFile.empty()) {
+		return;
+	}
+	stop();
+	start(stageName, stageCategory);
+}
+
+/*!
+\brief stop
+The function stop ends the stage and writes it to the trace, afterwards the object does nothing.
+*/
+void TraceStage::stop() {
+	if (!running) {
+		return;
+	}
+	running = false;
+	double wallSeconds = getTraceSeconds() - startSeconds;
+	double cpuSeconds = getThreadCPUSeconds() - startCPUSeconds;
+	//the peak of the process can also be raised by other threads, it is only an upper bound for the stage
+	double peakMemoryDelta = std::max(0.0, getPeakMemoryMB() - startPeakMemory);
+	writeEvent(wallSeconds, cpuSeconds, peakMemoryDelta);
+}
+
+/*!
+\brief writeEvent
+The function writeEvent writes the stage to the trace. The Chrome trace is a JSON array that is closed after every stage, so it can be read
+while the calculation is running; the first stage of the process overwrites an existing trace.
+*/
+void TraceStage::writeEvent(double wallSeconds, double cpuSeconds, double peakMemoryDelta) const {
+	TraceWriter &writer = getTraceWriter();
+	lock_guard<mutex> lock(writer.writeMutex);
+	map<std::thread::id, int>::const_iterator threadNr = writer.threadNrs.find(std::this_thread::get_id());
+	if (threadNr == writer.threadNrs.end()) {
+		threadNr = writer.threadNrs.insert(std::make_pair(std::this_thread::get_id(), int(writer.threadNrs.size()) + 1)).first;
+	}
+	stringstream sizes;
+	sizes << fixed << setprecision(3) << "\"output\":" << getJSONString(output) << ",\"cpuTimeUs\":" << llround(cpuSeconds * 1e6)
+		<< ",\"peakMemoryDeltaMB\":" << peakMemoryDelta;
+	if (voxels > 0) {
+		sizes << ",\"voxels\":" << voxels;
+	}
+	if (greyLevels > 0) {
+		sizes << ",\"greyLevels\":" << greyLevels;
+	}
+	stringstream event;
+	bool firstEvent = writer.startedFiles.insert(traceFile).second;
+	if (traceFormat == "jsonl") {
+		event << "{\"name\":" << getJSONString(name) << ",\"category\":" << getJSONString(category) << ",\"thread\":" << threadNr->second
+			<< ",\"startUs\":" << llround(startSeconds * 1e6) << ",\"wallTimeUs\":" << llround(wallSeconds * 1e6) << "," << sizes.str() << "}\n";
+		ofstream trace(traceFile, firstEvent ? ios::trunc : ios::app);
+		trace << event.str();
+	}
+	else {
+		event << "{\"name\":" << getJSONString(name) << ",\"cat\":" << getJSONString(category) << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadNr->second
+			<< ",\"ts\":" << llround(startSeconds * 1e6) << ",\"dur\":" << llround(wallSeconds * 1e6) << ",\"args\":{" << sizes.str() << "}}";
+		if (firstEvent) {
+			ofstream trace(traceFile, ios::binary | ios::trunc);
+			trace << "[\n" << event.str() << "\n]\n";
+		}
+		else {
+			//the closing bracket is replaced by the new stage
+			fstream trace(traceFile, ios::binary | ios::in | ios::out);
+			trace.seekp(-3, ios::end);
+			trace << ",\n" << event.str() << "\n]\n";
+		}
+	}
+}
+
+/*!
+\brief getTraceSeconds
+The function getTraceSeconds returns the wall time in seconds since the first call, so all stages of the process have the same time axis.
+*/
+double getTraceSeconds() {
+	static const chrono::steady_clock::time_point traceStart = chrono::steady_clock::now();
+	return chrono::duration<double>(chrono::steady_clock::now() - traceStart).count();
+}
+
+/*!
+\brief getThreadCPUSeconds
+The function getThreadCPUSeconds returns the CPU time (user and system) of the calling thread in seconds. Threads that a stage starts
+(e.g. the parallel mask analysis) are not included.
+*/
+double getThreadCPUSeconds() {
+#ifdef _WIN32
+	FILETIME creationTime;
+	FILETIME exitTime;
+	FILETIME kernelTime;
+	FILETIME userTime;
+	if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+		ULARGE_INTEGER kernel;
+		ULARGE_INTEGER user;
+		kernel.LowPart = kernelTime.dwLowDateTime;
+		kernel.HighPart = kernelTime.dwHighDateTime;
+		user.LowPart = userTime.dwLowDateTime;
+		user.HighPart = userTime.dwHighDateTime;
+		//the times are given in units of 100 ns
+		return (kernel.QuadPart + user.QuadPart) * 1e-7;
+	}
+	return 0;
+#else
+	timespec time;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0) {
+		return time.tv_sec + time.tv_nsec * 1e-9;
+	}
+	return 0;
+#endif
+}
+
+/*!
+\brief getPeakMemoryMB
+The function getPeakMemoryMB returns the peak memory (resident set size) of the process in MB. On Linux it is the peak since the last call
+of resetPeakMemory, on other systems the peak since the start of the process.
+*/
+double getPeakMemoryMB() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+	}
+	return 0;
+#else
+	ifstream status("/proc/self/status");
+	string line;
+	while (getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0) {
+			return stod(line.substr(6)) / 1024;
+		}
+	}
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+	return usage.ru_maxrss / 1024.0;
+#endif
+#endif
+}
+
+//the peak memory can only be reset on Linux, there it is set to the actual memory of the process
+void resetPeakMemory() {
+#ifdef __linux__
+	ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+#endif
+}
@@ -0,0 +1,73 @@
+#ifndef STAGETRACE_H_INCLUDED
+#define STAGETRACE_H_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#include "readConfigFile.h"
+using namespace std;
+
+/*! \file */
+
+/*!
+The class TraceStage measures one stage of the calculation (e.g. reading the image, the mask analysis, one feature family or its writer)
+and writes it to the trace of the case (see WriteTrace in the section OutputInformation of the config file): \n
+the stage starts when the object is created and ends when it is destroyed (or with stop and next). For every stage, the wall time, the CPU
+time of the thread, the increase of the peak memory of the process and the number of voxels and grey levels it works on are written. \n
+The trace is either a Chrome trace (outputFolder_trace.json, can be opened with chrome://tracing or Perfetto) or a file with one JSON
+object per line (outputFolder_trace.jsonl). The stages of all threads of a case are written to the same trace, every thread has its own
+number (tid), so parallel stages are shown side by side. \n
+If no trace is written, a TraceStage does nothing, so the stages can stay in the code.
+*/
+class TraceStage {
+private:
+	string traceFile;
+	string traceFormat;
+	string output;
+	string name;
+	string category;
+	size_t voxels;
+	size_t greyLevels;
+	bool running;
+	double startSeconds;
+	double startCPUSeconds;
+	double startPeakMemory;
+
+	void start(const string &stageName, const string &stageCategory);
+	void writeEvent(double wallSeconds, double cpuSeconds, double peakMemoryDelta) const;
+
+public:
+	TraceStage(const ConfigFile &config, const string &stageName, const string &stageCategory, size_t nrVoxels = 0, size_t nrGreyLevels = 0);
+	~TraceStage();
+	TraceStage(const TraceStage &) = delete;
+	TraceStage &operator=(const TraceStage &) = delete;
+
+	void setSize(size_t nrVoxels, size_t nrGreyLevels = 0);
+	void next(const string &stageName, const string &stageCategory);
+	void stop();
+};
+
+double getTraceSeconds();
+double getThreadCPUSeconds();
+double getPeakMemoryMB();
+void resetPeakMemory();
+
+#include "stageTrace.cpp"
+
+#endif // STAGETRACE_H_INCLUDED
@@ -58,7 +58,7 @@ class StatisticalFeatures{
         Accumulator acc;
 
 
-        void fillAccumulator(Accumulator &acc, vector<T> vectorMatrElem);
+        void fillAccumulator(Accumulator &acc, const vector<T> &vectorMatrElem);
         void defineStatFeatures(vector<string> &features);
 		void defineStatFeaturesOntology(vector<string> &features);
         void extractStatData(vector<T> &statData, StatisticalFeatures<T, R> statFeatures);
@@ -93,33 +93,33 @@ class StatisticalFeatures{
         T robustMeanAbsDev = NAN;
 
 
-        void calculateMean(vector<T> vectorMatrElem);
+        void calculateMean(const vector<T> &vectorMatrElem);
         void calculateVariance();
         void calculateSkewness();
         void calculateKurtosis();
-        void getMedian(std::vector<T> vectorMatrElement);
-        void getMinimum(vector<T> matrixVector);
-        void getMaximum(vector<T> matrixVector);
+        void getMedian(const std::vector<T> &vectorMatrElement);
+        void getMinimum(const vector<T> &matrixVector);
+        void getMaximum(const vector<T> &matrixVector);
         void getRange();
 
-        double getPercentile(vector<T> matrixVector, T probability);
-        void get10percentile(vector<T> matrixVector);
-        void get90percentile(vector<T> matrixVector);
-        void getInterquartileRange(vector<T> matrixVector);
+        double getPercentile(const vector<T> &matrixVector, T probability);
+        void get10percentile(const vector<T> &matrixVector);
+        void get90percentile(const vector<T> &matrixVector);
+        void getInterquartileRange(const vector<T> &matrixVector);
         void getQuartileCoeff();
         void getCoeffOfVar();
-        void rootMeanSquare(vector<T> vectorMatrElem);
-        void energy(vector<T> vectorMatrElem);
-        void meanAbsoluteDev(vector<T> vectorMatrElem);
-        void medianAbsoluteDev(vector<T> vectorMatrElem);
-        void getRobustMeanAbsDev(vector<T> vectorMatrElem);
+        void rootMeanSquare(const vector<T> &vectorMatrElem);
+        void energy(const vector<T> &vectorMatrElem);
+        void meanAbsoluteDev(const vector<T> &vectorMatrElem);
+        void medianAbsoluteDev(const vector<T> &vectorMatrElem);
+        void getRobustMeanAbsDev(const vector<T> &vectorMatrElem);
 
         void getGreaterElements(vector<T> &vectorOfMatrixElem, T &value);
         void getSmallerElements(vector<T> &vectorOfMatrixElem, T &value);
 
-        void calculateAllStatFeatures(StatisticalFeatures<T,R> &stat, vector<T> vectorMatrElement);
+        void calculateAllStatFeatures(StatisticalFeatures<T,R> &stat, const vector<T> &vectorMatrElement);
         void writeCSVFileStatistic(StatisticalFeatures<T, R> stat, string outputFolder);
-		void writeOneFileStatistic(StatisticalFeatures<T, R> stat, ConfigFile config);
+		void writeOneFileStatistic(StatisticalFeatures<T, R> stat, const ConfigFile &config);
 
 
 };
@@ -132,7 +132,7 @@ class StatisticalFeatures{
 The intensity values of the image are copied in the accumulator.
 */
 template <class T,  size_t R>
-void StatisticalFeatures<T, R>::fillAccumulator(Accumulator &acc, std::vector<T> vectorMatrElem){
+void StatisticalFeatures<T, R>::fillAccumulator(Accumulator &acc, const std::vector<T> &vectorMatrElem){
 
     for_each( vectorMatrElem.begin(), vectorMatrElem.end(), boost::bind<void>( boost::ref(acc), _1 ) );
 }
@@ -146,7 +146,7 @@ F_{mean} = \frac{1}{N_{v}}\sum{X_{gl}}
 \f$
 */
 template <class T,  size_t R>
-void StatisticalFeatures<T, R>::calculateMean(std::vector<T> vectorMatrElement){
+void StatisticalFeatures<T, R>::calculateMean(const std::vector<T> &vectorMatrElement){
     fillAccumulator(acc, vectorMatrElement);
     meanValue = mean(acc);
 
@@ -195,7 +195,7 @@ void StatisticalFeatures<T, R>::calculateKurtosis(){
 The median of the intensity distribution is calculated
 */
 template <class T,  size_t R>
-void StatisticalFeatures<T, R>::getMedian(std::vector<T> vectorMatrElement){
+void StatisticalFeatures<T, R>::getMedian(const std::vector<T> &vectorMatrElement){
 	vector<T> test = vectorMatrElement;
 	int size = int(boost::size(test) / 2);
 	std::sort(test.begin(), test.end());
@@ -209,7 +209,7 @@ F_{min}
 \f$
 */
 template <class T,  size_t R>
-void StatisticalFeatures<T, R>::getMinimum(vector<T> vectorOfMatrixElem){
+void StatisticalFeatures<T, R>::getMinimum(const vector<T> &vectorOfMatrixElem){
     minimumValue = *min_element( vectorOfMatrixElem.begin(), vectorOfMatrixElem.end());
 }
 
@@ -220,7 +220,7 @@ F_{max}
 \f$
 */
 template <class T,  size_t R>
-void StatisticalFeatures<T, R>::getMaximum(vector<T> vectorOfMatrixElem){
+void StatisticalFeatures<T, R>::getMaximum(const vector<T> &vectorOfMatrixElem){
     maximumValue = *max_element( vectorOfMatrixElem.begin(), vectorOfMatrixElem.end());
 }
 
@@ -244,7 +244,7 @@ The function is a help function to calculate percentiles of a certain probabilit
 It uses the accumulator function of the boost library together with the p_square_quantile-tag
 */
 template <class T,  size_t R>
-double StatisticalFeatures<T, R>::getPercentile(vector<T> matrixVector, T probability){
+double StatisticalFeatures<T, R>::getPercentile(const vector<T> &matrixVector, T probability){
 
 	vector<T> vectorToSort = matrixVector;
 	int size = int(probability*boost::size(vectorToSort));
@@ -258,7 +258,7 @@ double StatisticalFeatures<T, R>::getPercentile(vector<T> matrixVector, T probab
 The function calculates the \f$ 10^{th} \f$ percentile \f$ P_{10} \f$.
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::get10percentile(vector<T> matrixVector){
+void StatisticalFeatures<T, R>::get10percentile(const vector<T> &matrixVector){
     percentile10 = getPercentile(matrixVector, 0.1);
 }
 
@@ -268,7 +268,7 @@ void StatisticalFeatures<T, R>::get10percentile(vector<T> matrixVector){
 The function calculates the \f$ 90^{th} \f$ percentile \f$ P_{90} \f$.
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::get90percentile(vector<T> matrixVector){
+void StatisticalFeatures<T, R>::get90percentile(const vector<T> &matrixVector){
     percentile90 =  getPercentile(matrixVector, 0.89);
     percentile90 = percentile90;
 }
@@ -282,7 +282,7 @@ F_{intquarRange} = P_{75}-P_{25}
 With \f$ P_{75} \f$ and \f$ P_{25} \f$ being the \f$ 75^{th} \f$ and \f$ 25^{th} \f$ percentile.
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::getInterquartileRange(vector<T> matrixVector){
+void StatisticalFeatures<T, R>::getInterquartileRange(const vector<T> &matrixVector){
     percentile25 = getPercentile(matrixVector, 0.25);
     percentile75 = getPercentile(matrixVector, 0.75);
     interquartileRange = (percentile75 - percentile25);
@@ -325,7 +325,7 @@ F_{energy} = \sum{ X_{gl}^{2}}
 \f$
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::energy(vector<T> vectorMatrElem){
+void StatisticalFeatures<T, R>::energy(const vector<T> &vectorMatrElem){
     energyValue = for_each(vectorMatrElem.begin(), vectorMatrElem.end(), square_accumulate<float>()).result();
 }
 
@@ -337,7 +337,7 @@ F_{rootMeanSquare} = \sqrt{\frac{\sum{ X_{gl}^{2}}}{N_{V}}}
 \f$
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::rootMeanSquare(vector<T> vectorMatrElem){
+void StatisticalFeatures<T, R>::rootMeanSquare(const vector<T> &vectorMatrElem){
     rootMean = pow(this->energyValue/vectorMatrElem.size(),0.5);
 }
 
@@ -349,7 +349,7 @@ F_{meanAbsoulteDev} =  \frac{1}{N_{V}}\sum{ X_{gl,j}^{2} - \mu }
 \f$
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::meanAbsoluteDev(vector<T> vectorMatrElem){
+void StatisticalFeatures<T, R>::meanAbsoluteDev(const vector<T> &vectorMatrElem){
     vector<T> tempVector = vectorMatrElem;
     transform( tempVector.begin(), tempVector.end(), tempVector.begin(),
                      std::bind2nd( minus<T>(), this->meanValue) );
@@ -366,7 +366,7 @@ F_{medianAbsoulteDev} =  \frac{1}{N_{V}}\sum{ X_{gl,j}^{2} - F_{median} }
 \f$
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::medianAbsoluteDev(vector<T> vectorMatrElem){
+void StatisticalFeatures<T, R>::medianAbsoluteDev(const vector<T> &vectorMatrElem){
     vector<T> tempVector = vectorMatrElem;
     transform( tempVector.begin(), tempVector.end(), tempVector.begin(),
                      std::bind2nd( minus<T>(), this->medianValue) );
@@ -393,7 +393,7 @@ F_{robmeanAbsDev} =  \frac{1}{N_{10-90}}\sum{ X_{gl10-90,j} -X_{gl10-90,j}}
 \f$
 */
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::getRobustMeanAbsDev(vector<T> vectorMatrElem){
+void StatisticalFeatures<T, R>::getRobustMeanAbsDev(const vector<T> &vectorMatrElem){
     vector<T> tempVector = vectorMatrElem;
     getSmallerElements(tempVector, percentile10);
     getGreaterElements(tempVector, percentile90);
@@ -435,7 +435,7 @@ void StatisticalFeatures<T, R>::getGreaterElements(vector<T> &vectorOfElem, T &v
 
 
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::calculateAllStatFeatures(StatisticalFeatures<T,R> &statFeatures, vector<T> vectorMatrElement){
+void StatisticalFeatures<T, R>::calculateAllStatFeatures(StatisticalFeatures<T,R> &statFeatures, const vector<T> &vectorMatrElement){
    statFeatures.calculateMean(vectorMatrElement);
    statFeatures.getMedian(vectorMatrElement);
    statFeatures.calculateVariance();
@@ -486,7 +486,7 @@ void StatisticalFeatures<T, R>::writeCSVFileStatistic(StatisticalFeatures<T,R> s
 
 
 template <class T, size_t R>
-void StatisticalFeatures<T, R>::writeOneFileStatistic(StatisticalFeatures<T, R> stat, ConfigFile config)
+void StatisticalFeatures<T, R>::writeOneFileStatistic(StatisticalFeatures<T, R> stat, const ConfigFile &config)
 {
 	string csvName;
 	if (config.csvOutput == 1) {
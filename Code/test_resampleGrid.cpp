@@ -0,0 +1,130 @@
+//
+//
+#include "readImages.h"
+
+
+#define BOOST_TEST_MODULE Resample_Grid
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+using namespace std;
+
+//with CropOnRead only the region around the mask is read, the region has to be resampled on the grid of the whole image
+
+ImageType::Pointer createTestImage(bool maskImage) {
+	ImageType::Pointer image = ImageType::New();
+	RegionType region;
+	for (int i = 0; i < 3; i++) {
+		region.SetIndex(i, 0);
+	}
+	region.SetSize(0, 47);
+	region.SetSize(1, 39);
+	region.SetSize(2, 17);
+	image->SetRegions(region);
+	ImageType::SpacingType spacing;
+	spacing[0] = 0.9;
+	spacing[1] = 0.9;
+	spacing[2] = 2.5;
+	image->SetSpacing(spacing);
+	ImageType::PointType origin;
+	origin[0] = -12.3;
+	origin[1] = 5.1;
+	origin[2] = 40.0;
+	image->SetOrigin(origin);
+	image->Allocate();
+	float *values = image->GetBufferPointer();
+	size_t index = 0;
+	for (int z = 0; z < 17; z++) {
+		for (int y = 0; y < 39; y++) {
+			for (int x = 0; x < 47; x++, index++) {
+				if (maskImage) {
+					//ellipsoid away from the center of the image, so that the cropped region is not centered
+					double dx = (x - 30.0) / 7.0;
+					double dy = (y - 12.0) / 6.0;
+					double dz = (z - 6.0) / 3.0;
+					values[index] = dx * dx + dy * dy + dz * dz <= 1 ? 1.0f : 0.0f;
+				}
+				else {
+					values[index] = float(100 + 40 * sin(0.5 * x) + 25 * cos(0.3 * y) + 10 * z);
+				}
+			}
+		}
+	}
+	return image;
+}
+
+ConfigFile getTestConfig() {
+	ConfigFile config;
+	config.useSamplingCubic = 1;
+	config.useDownSampling = 0;
+	config.useUpSampling = 0;
+	config.cubicVoxelSize = 2;
+	config.interpolation2D = 0;
+	config.interpolationMethod = "Linear";
+	config.rebinning_centering = 0;
+	config.threshold = 0.5;
+	config.imageFilters = 0;
+	config.smoothingKernel = 0;
+	return config;
+}
+
+BOOST_AUTO_TEST_CASE(cropped_image_has_grid_of_whole_image) {
+	ConfigFile config = getTestConfig();
+	ImageType::Pointer image = createTestImage(false);
+	ImageType::Pointer mask = createTestImage(true);
+	RegionType cropRegion = getCropRegion(mask, config);
+	BOOST_REQUIRE(cropRegion != image->GetLargestPossibleRegion());
+	ImageType::Pointer croppedImage = getImageMasked(image, cropRegion);
+
+	ResampleGrid wholeGrid = getResampleGrid(image, config);
+	ResampleGrid croppedGrid = getResampleGrid(getImageGeometry(image), config);
+	//the grid of the cropped image itself is different, this is why the geometry of the whole image is kept
+	ResampleGrid cropGrid = getResampleGrid(croppedImage, config);
+	for (int i = 0; i < 3; i++) {
+		BOOST_CHECK_EQUAL(croppedGrid.size[i], wholeGrid.size[i]);
+		BOOST_CHECK_CLOSE(croppedGrid.spacing[i], wholeGrid.spacing[i], 1e-9);
+		BOOST_CHECK_SMALL(croppedGrid.origin[i] - wholeGrid.origin[i], 1e-9);
+	}
+	BOOST_CHECK(cropGrid.size != wholeGrid.size);
+}
+
+BOOST_AUTO_TEST_CASE(cropped_image_is_resampled_like_whole_image) {
+	ConfigFile config = getTestConfig();
+	ImageType::Pointer image = createTestImage(false);
+	ImageType::Pointer mask = createTestImage(true);
+	ImageType::Pointer imageGeometry = getImageGeometry(image);
+	RegionType cropRegion = getCropRegion(mask, config);
+	ImageType::Pointer croppedImage = getImageMasked(image, cropRegion);
+	ImageType::Pointer croppedMask = getImageMasked(mask, cropRegion);
+
+	MaskAnalysis wholeAnalysis;
+	wholeAnalysis.analyse(mask, config.threshold);
+	resampleMaskRegion(image, mask, wholeAnalysis.nonZeroRegion, getResampleGrid(image, config), config);
+	MaskAnalysis croppedAnalysis;
+	croppedAnalysis.analyse(croppedMask, config.threshold);
+	resampleMaskRegion(croppedImage, croppedMask, croppedAnalysis.nonZeroRegion, getResampleGrid(imageGeometry, config), config);
+
+	//every resampled voxel of the cropped image is a voxel of the resampled whole image with the same value
+	const RegionType &croppedRegion = croppedImage->GetLargestPossibleRegion();
+	BOOST_REQUIRE(croppedRegion.GetNumberOfPixels() > 0);
+	itk::ImageRegionConstIteratorWithIndex<ImageType> voxelIt(croppedImage, croppedRegion);
+	size_t nrVoxels = 0;
+	for (; !voxelIt.IsAtEnd(); ++voxelIt) {
+		ImageType::PointType point;
+		croppedImage->TransformIndexToPhysicalPoint(voxelIt.GetIndex(), point);
+		itk::ContinuousIndex<double, 3> wholeIndex;
+		image->TransformPhysicalPointToContinuousIndex(point, wholeIndex);
+		ImageType::IndexType voxel;
+		for (int i = 0; i < 3; i++) {
+			voxel[i] = long(std::lround(wholeIndex[i]));
+			BOOST_REQUIRE_SMALL(wholeIndex[i] - voxel[i], 1e-6);
+		}
+		BOOST_REQUIRE(image->GetLargestPossibleRegion().IsInside(voxel));
+		BOOST_CHECK_CLOSE(voxelIt.Get(), image->GetPixel(voxel), 1e-3);
+		BOOST_CHECK_SMALL(croppedMask->GetPixel(voxelIt.GetIndex()) - mask->GetPixel(voxel), 1e-5f);
+		nrVoxels++;
+	}
+	BOOST_CHECK(nrVoxels > 0);
+}
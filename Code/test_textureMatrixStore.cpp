@@ -0,0 +1,243 @@
+//
+//
+#include "textureMatrixStore.h"
+
+
+#define BOOST_TEST_MODULE Texture_Matrix_Store
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+using namespace std;
+
+//the delta of a perturbed mask (loadPairDelta, loadRunDelta) has to give the same matrix as counting the perturbed VOI again
+
+const int nrTestCases = 60;
+const int nrTestGreyLevels = 4;
+
+//random VOI: about 70% of the voxels are inside, the grey levels are 1 ... nrTestGreyLevels
+void getRandomVOI(mt19937 &generator, boost::multi_array<float, 3> &voi) {
+	float *values = voi.origin();
+	for (size_t i = 0; i < voi.num_elements(); i++) {
+		values[i] = generator() % 10 < 7 ? float(1 + generator() % nrTestGreyLevels) : NAN;
+	}
+}
+
+//perturbed VOI: some voxels are removed or added, the voxels of both VOIs keep their grey level
+void getPerturbedVOI(mt19937 &generator, const boost::multi_array<float, 3> &voi, boost::multi_array<float, 3> &perturbedVOI) {
+	perturbedVOI.resize(boost::extents[voi.shape()[0]][voi.shape()[1]][voi.shape()[2]]);
+	perturbedVOI = voi;
+	float *values = perturbedVOI.origin();
+	for (size_t i = 0; i < perturbedVOI.num_elements(); i++) {
+		if (generator() % 10 == 0) {
+			values[i] = std::isnan(values[i]) ? float(1 + generator() % nrTestGreyLevels) : NAN;
+		}
+	}
+}
+
+vector<float> getGreyLevels(const boost::multi_array<float, 3> &voi) {
+	vector<float> greyLevels;
+	for (size_t i = 0; i < voi.num_elements(); i++) {
+		if (!std::isnan(voi.origin()[i])) {
+			greyLevels.push_back(voi.origin()[i]);
+		}
+	}
+	std::sort(greyLevels.begin(), greyLevels.end());
+	greyLevels.erase(std::unique(greyLevels.begin(), greyLevels.end()), greyLevels.end());
+	return greyLevels;
+}
+
+bool isInVOI(const boost::multi_array<float, 3> &voi, int row, int col, int depth) {
+	return row >= 0 && row < int(voi.shape()[0]) && col >= 0 && col < int(voi.shape()[1]) && depth >= 0 && depth < int(voi.shape()[2]);
+}
+
+//counts all voxel pairs of a slice (depth >= 0) or of the whole VOI, the grey levels are the indices of the matrix
+void countPairs(const boost::multi_array<float, 3> &voi, int depth, int offsetRow, int offsetCol, int offsetDepth, boost::multi_array<float, 2> &matrix) {
+	for (int row = 0; row < int(voi.shape()[0]); row++) {
+		for (int col = 0; col < int(voi.shape()[1]); col++) {
+			for (int voxelDepth = 0; voxelDepth < int(voi.shape()[2]); voxelDepth++) {
+				if ((depth >= 0 && voxelDepth != depth) || !isInVOI(voi, row + offsetRow, col + offsetCol, voxelDepth + offsetDepth)) {
+					continue;
+				}
+				float first = voi[row][col][voxelDepth];
+				float second = voi[row + offsetRow][col + offsetCol][voxelDepth + offsetDepth];
+				if (!std::isnan(first) && !std::isnan(second)) {
+					matrix[int(first) - 1][int(second) - 1] += 1;
+				}
+			}
+		}
+	}
+}
+
+//counts all runs of a slice (depth >= 0) or of the whole VOI, the rows are the indices of the grey levels of the VOI
+void countRuns(const boost::multi_array<float, 3> &voi, int depth, int stepRow, int stepCol, int stepDepth, boost::multi_array<float, 2> &matrix) {
+	vector<float> greyLevels = getGreyLevels(voi);
+	for (int row = 0; row < int(voi.shape()[0]); row++) {
+		for (int col = 0; col < int(voi.shape()[1]); col++) {
+			for (int voxelDepth = 0; voxelDepth < int(voi.shape()[2]); voxelDepth++) {
+				float value = voi[row][col][voxelDepth];
+				if ((depth >= 0 && voxelDepth != depth) || std::isnan(value)) {
+					continue;
+				}
+				//a run starts at a voxel whose predecessor in the direction has another grey level
+				if (isInVOI(voi, row - stepRow, col - stepCol, voxelDepth - stepDepth) && voi[row - stepRow][col - stepCol][voxelDepth - stepDepth] == value) {
+					continue;
+				}
+				int runLength = 1;
+				while (isInVOI(voi, row + runLength * stepRow, col + runLength * stepCol, voxelDepth + runLength * stepDepth)
+					&& voi[row + runLength * stepRow][col + runLength * stepCol][voxelDepth + runLength * stepDepth] == value) {
+					runLength++;
+				}
+				if (size_t(runLength) <= matrix.shape()[1]) {
+					size_t greyIndex = std::lower_bound(greyLevels.begin(), greyLevels.end(), value) - greyLevels.begin();
+					matrix[greyIndex][runLength - 1] += 1;
+				}
+			}
+		}
+	}
+}
+
+//directions of the 2D (offsetDepth 0) and 3D matrices
+vector<vector<int> > getTestDirections() {
+	vector<vector<int> > directions;
+	for (int dz = -1; dz <= 1; dz++) {
+		for (int dy = -1; dy <= 1; dy++) {
+			for (int dx = -1; dx <= 1; dx++) {
+				if (dz > 0 || (dz == 0 && dy > 0) || (dz == 0 && dy == 0 && dx > 0)) {
+					directions.push_back({ dy, dx, dz });
+				}
+			}
+		}
+	}
+	return directions;
+}
+
+bool isEqual(const boost::multi_array<float, 2> &first, const boost::multi_array<float, 2> &second) {
+	return first.num_elements() == second.num_elements() && std::equal(first.origin(), first.origin() + first.num_elements(), second.origin());
+}
+
+BOOST_AUTO_TEST_CASE(pair_delta_test) {
+	mt19937 generator(5489u);
+	vector<vector<int> > directions = getTestDirections();
+	vector<float> spacing(3, 1);
+	int nrMismatches = 0;
+	int nrMatrices = 0;
+	for (int testCase = 0; testCase < nrTestCases; testCase++) {
+		boost::multi_array<float, 3> voi(boost::extents[5 + generator() % 4][5 + generator() % 4][2 + generator() % 3]);
+		boost::multi_array<float, 3> perturbedVOI;
+		getRandomVOI(generator, voi);
+		getPerturbedVOI(generator, voi, perturbedVOI);
+		int nrDepths = int(voi.shape()[2]);
+		TextureMatrixStore store;
+		store.startPerturbations();
+		store.setVOI(voi, vector<float>(), spacing);
+		for (size_t directionNr = 0; directionNr < directions.size(); directionNr++) {
+			const vector<int> &direction = directions[directionNr];
+			for (int depth = direction[2] == 0 ? 0 : -1; depth < (direction[2] == 0 ? nrDepths : 0); depth++) {
+				boost::multi_array<float, 2> matrix(boost::extents[nrTestGreyLevels][nrTestGreyLevels]);
+				store.beginCount(matrix);
+				countPairs(voi, depth, direction[0], direction[1], direction[2], matrix);
+				store.record(getTextureMatrixKey("GLCM", depth, int(directionNr)), matrix);
+			}
+		}
+		store.finishMask();
+		store.setVOI(perturbedVOI, vector<float>(), spacing);
+		for (size_t directionNr = 0; directionNr < directions.size(); directionNr++) {
+			const vector<int> &direction = directions[directionNr];
+			for (int depth = direction[2] == 0 ? 0 : -1; depth < (direction[2] == 0 ? nrDepths : 0); depth++) {
+				boost::multi_array<float, 2> expected(boost::extents[nrTestGreyLevels][nrTestGreyLevels]);
+				countPairs(perturbedVOI, depth, direction[0], direction[1], direction[2], expected);
+				boost::multi_array<float, 2> matrix(boost::extents[nrTestGreyLevels][nrTestGreyLevels]);
+				bool counted = false;
+				store.fillPairMatrix(getTextureMatrixKey("GLCM", depth, int(directionNr)), perturbedVOI, matrix, depth, direction[0], direction[1],
+					direction[2], [&]() {
+					counted = true;
+				});
+				BOOST_CHECK(!counted);
+				nrMismatches += isEqual(matrix, expected) ? 0 : 1;
+				nrMatrices++;
+			}
+		}
+	}
+	BOOST_CHECK_GT(nrMatrices, 0);
+	BOOST_CHECK_EQUAL(nrMismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE(run_delta_test) {
+	mt19937 generator(5490u);
+	vector<vector<int> > directions = getTestDirections();
+	vector<float> spacing(3, 1);
+	int nrMismatches = 0;
+	int nrMatrices = 0;
+	for (int testCase = 0; testCase < nrTestCases; testCase++) {
+		boost::multi_array<float, 3> voi(boost::extents[5 + generator() % 4][5 + generator() % 4][2 + generator() % 3]);
+		boost::multi_array<float, 3> perturbedVOI;
+		getRandomVOI(generator, voi);
+		getPerturbedVOI(generator, voi, perturbedVOI);
+		int nrDepths = int(voi.shape()[2]);
+		//runs longer than the number of columns are not counted, as in the GLRLM classes (few columns, so that this happens)
+		size_t nrRunLengths = 2 + testCase % 3;
+		size_t nrBaseGreyLevels = getGreyLevels(voi).size();
+		size_t nrPerturbedGreyLevels = getGreyLevels(perturbedVOI).size();
+		TextureMatrixStore store;
+		store.startPerturbations();
+		store.setVOI(voi, vector<float>(), spacing);
+		for (size_t directionNr = 0; directionNr < directions.size(); directionNr++) {
+			const vector<int> &direction = directions[directionNr];
+			for (int depth = direction[2] == 0 ? 0 : -1; depth < (direction[2] == 0 ? nrDepths : 0); depth++) {
+				boost::multi_array<float, 2> matrix(boost::extents[nrBaseGreyLevels][nrRunLengths]);
+				store.beginCount(matrix);
+				countRuns(voi, depth, direction[0], direction[1], direction[2], matrix);
+				store.record(getTextureMatrixKey("GLRLM", depth, int(directionNr)), matrix);
+			}
+		}
+		store.finishMask();
+		store.setVOI(perturbedVOI, vector<float>(), spacing);
+		for (size_t directionNr = 0; directionNr < directions.size(); directionNr++) {
+			const vector<int> &direction = directions[directionNr];
+			for (int depth = direction[2] == 0 ? 0 : -1; depth < (direction[2] == 0 ? nrDepths : 0); depth++) {
+				boost::multi_array<float, 2> expected(boost::extents[nrPerturbedGreyLevels][nrRunLengths]);
+				countRuns(perturbedVOI, depth, direction[0], direction[1], direction[2], expected);
+				boost::multi_array<float, 2> matrix(boost::extents[nrPerturbedGreyLevels][nrRunLengths]);
+				bool counted = false;
+				store.fillRunMatrix(getTextureMatrixKey("GLRLM", depth, int(directionNr)), perturbedVOI, matrix, depth, direction[0], direction[1],
+					direction[2], [&]() {
+					counted = true;
+				});
+				BOOST_CHECK(!counted);
+				nrMismatches += isEqual(matrix, expected) ? 0 : 1;
+				nrMatrices++;
+			}
+		}
+	}
+	BOOST_CHECK_GT(nrMatrices, 0);
+	BOOST_CHECK_EQUAL(nrMismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE(record_and_load_test) {
+	mt19937 generator(5491u);
+	boost::multi_array<float, 3> voi(boost::extents[6][7][3]);
+	getRandomVOI(generator, voi);
+	vector<float> spacing(3, 1);
+	TextureMatrixStore store;
+	store.startRecording();
+	store.setVOI(voi, vector<float>(), spacing);
+	boost::multi_array<float, 2> matrix(boost::extents[nrTestGreyLevels][nrTestGreyLevels]);
+	store.fillPairMatrix(getTextureMatrixKey("GLCM", 1, 0), voi, matrix, 1, 0, 1, 0, [&]() {
+		countPairs(voi, 1, 0, 1, 0, matrix);
+	});
+	string fileName = (std::filesystem::temp_directory_path() / "racatTestTextureMatrices.bin").string();
+	BOOST_REQUIRE(store.write(fileName));
+	TextureMatrixStore loadedStore;
+	BOOST_REQUIRE(loadedStore.read(fileName));
+	std::remove(fileName.c_str());
+	boost::multi_array<float, 2> loadedMatrix(boost::extents[nrTestGreyLevels][nrTestGreyLevels]);
+	bool counted = false;
+	loadedStore.fillPairMatrix(getTextureMatrixKey("GLCM", 1, 0), voi, loadedMatrix, 1, 0, 1, 0, [&]() {
+		counted = true;
+	});
+	BOOST_CHECK(!counted);
+	BOOST_CHECK(isEqual(matrix, loadedMatrix));
+}
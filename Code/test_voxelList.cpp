@@ -0,0 +1,68 @@
+//
+//
+#include "voxelList.h"
+
+
+#define BOOST_TEST_MODULE Voxel_List
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+//a voxel list must not be used for a matrix that was filled again in the same memory
+
+//sparse VOI: every seventh voxel (shifted by offset) is inside the mask
+void fillSparseVOI(boost::multi_array<float, 3> &voi, int offset) {
+	float *values = voi.origin();
+	for (size_t i = 0; i < voi.num_elements(); i++) {
+		values[i] = (i + offset) % 7 == 0 ? float(1 + (i + offset) % 5) : NAN;
+	}
+}
+
+BOOST_AUTO_TEST_CASE(refilled_matrix_is_not_described) {
+	boost::multi_array<float, 3> voi(boost::extents[6][5][4]);
+	fillSparseVOI(voi, 0);
+	unsigned long long generation = nextMatrixGeneration();
+	VoxelList<float> voxels;
+	voxels.fill(voi, generation);
+	BOOST_CHECK(voxels.describes(voi, generation));
+
+	//the same buffer with a new content: address and size do not change
+	const float *data = voi.data();
+	boost::multi_array<float, 3> newVOI(boost::extents[6][5][4]);
+	fillSparseVOI(newVOI, 3);
+	voi = newVOI;
+	BOOST_REQUIRE(voi.data() == data);
+	BOOST_CHECK(voxels.describes(voi));
+	unsigned long long newGeneration = nextMatrixGeneration();
+	BOOST_CHECK(newGeneration != generation);
+	BOOST_CHECK(!voxels.describes(voi, newGeneration));
+
+	//after filling the list again it describes the new content
+	voxels.fill(voi, newGeneration);
+	BOOST_CHECK(voxels.describes(voi, newGeneration));
+	int nrVoxels = 0;
+	for (int voxelNr = 0; voxelNr < voxels.size(); voxelNr++) {
+		int row, col, depth;
+		voxels.getPosition(voxelNr, row, col, depth);
+		BOOST_CHECK_EQUAL(voxels.values[voxelNr], voi[row][col][depth]);
+		nrVoxels++;
+	}
+	int nrVoxelsInVOI = 0;
+	for (size_t i = 0; i < voi.num_elements(); i++) {
+		nrVoxelsInVOI += std::isnan(voi.origin()[i]) ? 0 : 1;
+	}
+	BOOST_CHECK_EQUAL(nrVoxels, nrVoxelsInVOI);
+}
+
+BOOST_AUTO_TEST_CASE(other_matrix_is_not_described) {
+	boost::multi_array<float, 3> voi(boost::extents[6][5][4]);
+	fillSparseVOI(voi, 0);
+	unsigned long long generation = nextMatrixGeneration();
+	VoxelList<float> voxels;
+	voxels.fill(voi, generation);
+	boost::multi_array<float, 3> copy = voi;
+	BOOST_CHECK(!voxels.describes(copy, generation));
+	BOOST_CHECK(sparseVoxels(&voxels, copy) == nullptr);
+	voxels.clear();
+	BOOST_CHECK(!voxels.describes(voi, generation));
+}
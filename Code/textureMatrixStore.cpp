@@ -0,0 +1,559 @@
+/*!
+\brief caseStore
+The function caseStore returns the store of the actual thread. \n
+All texture matrices of one case are recorded in (or loaded from) this store.
+*/
+TextureMatrixStore &TextureMatrixStore::caseStore() {
+	static thread_local TextureMatrixStore store;
+	return store;
+}
+
+/*!
+\brief startRecording
+The function startRecording empties the store and records the matrices of the next mask. \n
+If the recording was already started for the perturbed masks (see startPerturbations), it is continued.
+*/
+void TextureMatrixStore::startRecording() {
+	if (!recording) {
+		reset();
+		recording = true;
+	}
+}
+
+/*!
+\brief startPerturbations
+The function startPerturbations records the matrices of the next mask and keeps them afterwards, the masks calculated after this mask are
+perturbed versions of it.
+*/
+void TextureMatrixStore::startPerturbations() {
+	reset();
+	recording = true;
+	keepBase = true;
+}
+
+/*!
+\brief finishMask
+The function finishMask is called when the features of a mask are calculated: the store is emptied, unless the matrices are kept for the
+perturbed masks.
+*/
+void TextureMatrixStore::finishMask() {
+	if (!keepBase) {
+		reset();
+		return;
+	}
+	recording = false;
+	perturbed = false;
+	changedVoxels.clear();
+}
+
+bool TextureMatrixStore::isLoaded() const {
+	return loaded;
+}
+
+string TextureMatrixStore::getStoreKey(const string &key, const boost::multi_array<float, 2> &matrix) const {
+	return key + "_" + to_string(matrix.shape()[0]) + "x" + to_string(matrix.shape()[1]);
+}
+
+//stored matrix of the base mask with this key (of any size)
+const TextureMatrixStore::StoredMatrix *TextureMatrixStore::getBaseMatrix(const string &key) const {
+	string prefix = key + "_";
+	map<string, StoredMatrix>::const_iterator matrixIt = matrices.lower_bound(prefix);
+	if (matrixIt == matrices.end() || matrixIt->first.compare(0, prefix.size(), prefix) != 0) {
+		return nullptr;
+	}
+	return &matrixIt->second;
+}
+
+/*!
+\brief load
+The function load adds the stored counts to the matrix, if a file was loaded and contains the key for a matrix of this size.
+@param[in] key: key of the matrix (see getTextureMatrixKey)
+@param[in,out] matrix: count matrix
+@param[out] bool: true if the counts were taken from the store, otherwise the matrix has to be filled as usual
+*/
+bool TextureMatrixStore::load(const string &key, boost::multi_array<float, 2> &matrix) const {
+	if (!loaded) {
+		return false;
+	}
+	map<string, StoredMatrix>::const_iterator matrixIt = matrices.find(getStoreKey(key, matrix));
+	if (matrixIt == matrices.end()) {
+		return false;
+	}
+	float *elements = matrix.origin();
+	for (size_t i = 0; i < matrixIt->second.indices.size(); i++) {
+		elements[matrixIt->second.indices[i]] += matrixIt->second.counts[i];
+	}
+	return true;
+}
+
+/*!
+\brief loadPairDelta
+The function loadPairDelta fills a co-occurrence matrix of a perturbed mask from the matrix of the base mask: only the voxel pairs that
+contain a voxel which was added to or removed from the VOI are counted again, pairs of the base VOI are subtracted and pairs of the
+perturbed VOI are added. \n
+The grey levels are the indices of the matrix (as in the GLCM classes), so the matrices may have different sizes.
+@param[in] key: key of the matrix (see getTextureMatrixKey)
+@param[in] inputMatrix: discretized perturbed VOI
+@param[in,out] matrix: count matrix
+@param[in] depth: slice of the matrix, -1 for a matrix of the whole VOI
+@param[in] offsetRow, offsetCol, offsetDepth: position of the second voxel of a pair relative to the first voxel
+@param[out] bool: true if the matrix was filled, otherwise it has to be filled as usual
+*/
+bool TextureMatrixStore::loadPairDelta(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix,
+	int depth, int offsetRow, int offsetCol, int offsetDepth) const {
+	const StoredMatrix *base = perturbed ? getBaseMatrix(key) : nullptr;
+	if (base == nullptr) {
+		return false;
+	}
+	size_t size = std::max(std::max(base->nrRows, base->nrCols), std::max(matrix.shape()[0], matrix.shape()[1]));
+	vector<float> counts(size * size, 0);
+	for (size_t i = 0; i < base->indices.size(); i++) {
+		counts[(base->indices[i] / base->nrCols) * size + base->indices[i] % base->nrCols] += base->counts[i];
+	}
+	int nrRows = int(voiShape[0]);
+	int nrCols = int(voiShape[1]);
+	int nrDepths = int(voiShape[2]);
+	const float *newValues = inputMatrix.origin();
+	//removes the pair from the counts if it is part of the base VOI and adds it if it is part of the perturbed VOI
+	auto countPair = [&](size_t first, size_t second) {
+		const float *values[2] = { voiMatrix.data(), newValues };
+		for (int i = 0; i < 2; i++) {
+			if (std::isnan(values[i][first]) || std::isnan(values[i][second])) {
+				continue;
+			}
+			long row = long(values[i][first]) - 1;
+			long col = long(values[i][second]) - 1;
+			if (row < 0 || col < 0 || row >= long(size) || col >= long(size)) {
+				return false;
+			}
+			counts[row * size + col] += i == 0 ? -1 : 1;
+		}
+		return true;
+	};
+	vector<size_t> voxels;
+	getChangedVoxels(depth, voxels);
+	for (size_t i = 0; i < voxels.size(); i++) {
+		int voxelDepth = int(voxels[i] % nrDepths);
+		int col = int((voxels[i] / nrDepths) % nrCols);
+		int row = int(voxels[i] / (size_t(nrDepths) * nrCols));
+		//the changed voxel is the first voxel of a pair
+		int pairRow = row + offsetRow;
+		int pairCol = col + offsetCol;
+		int pairDepth = voxelDepth + offsetDepth;
+		if (pairRow >= 0 && pairRow < nrRows && pairCol >= 0 && pairCol < nrCols && pairDepth >= 0 && pairDepth < nrDepths) {
+			if (!countPair(voxels[i], (size_t(pairRow) * nrCols + pairCol) * nrDepths + pairDepth)) {
+				return false;
+			}
+		}
+		//the changed voxel is the second voxel of a pair (if the first voxel changed too, the pair was already counted)
+		pairRow = row - offsetRow;
+		pairCol = col - offsetCol;
+		pairDepth = voxelDepth - offsetDepth;
+		if (pairRow >= 0 && pairRow < nrRows && pairCol >= 0 && pairCol < nrCols && pairDepth >= 0 && pairDepth < nrDepths) {
+			size_t pairVoxel = (size_t(pairRow) * nrCols + pairCol) * nrDepths + pairDepth;
+			if (std::isnan(voiMatrix[pairVoxel]) == std::isnan(newValues[pairVoxel]) && !countPair(pairVoxel, voxels[i])) {
+				return false;
+			}
+		}
+	}
+	//grey levels that are not part of the perturbed VOI cannot have counts
+	for (size_t row = 0; row < size; row++) {
+		for (size_t col = 0; col < size; col++) {
+			if ((row >= matrix.shape()[0] || col >= matrix.shape()[1]) && counts[row * size + col] != 0) {
+				return false;
+			}
+		}
+	}
+	for (size_t row = 0; row < matrix.shape()[0]; row++) {
+		for (size_t col = 0; col < matrix.shape()[1]; col++) {
+			matrix[row][col] += counts[row * size + col];
+		}
+	}
+	return true;
+}
+
+/*!
+\brief loadRunDelta
+The function loadRunDelta fills a run length matrix of a perturbed mask from the matrix of the base mask: only the lines (in the direction
+of the runs) that contain a voxel which was added to or removed from the VOI are counted again, the runs of these lines in the base VOI
+are subtracted and the runs in the perturbed VOI are added. \n
+The rows of the matrix are the indices of the grey levels of the VOI (as in the GLRLM classes), runs that are longer than the number of
+columns are not counted.
+@param[in] key: key of the matrix (see getTextureMatrixKey)
+@param[in] inputMatrix: discretized perturbed VOI
+@param[in,out] matrix: count matrix
+@param[in] depth: slice of the matrix, -1 for a matrix of the whole VOI
+@param[in] stepRow, stepCol, stepDepth: direction of the runs
+@param[out] bool: true if the matrix was filled, otherwise it has to be filled as usual
+*/
+bool TextureMatrixStore::loadRunDelta(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix,
+	int depth, int stepRow, int stepCol, int stepDepth) const {
+	const StoredMatrix *base = perturbed ? getBaseMatrix(key) : nullptr;
+	if (base == nullptr || base->nrRows != baseGreyLevels.size() || base->nrCols != matrix.shape()[1]
+		|| matrix.shape()[0] != perturbedGreyLevels.size()) {
+		return false;
+	}
+	size_t nrRunLengths = matrix.shape()[1];
+	vector<float> counts(deltaGreyLevels.size() * nrRunLengths, 0);
+	auto getDeltaIndex = [&](float greyLevel) {
+		return size_t(std::lower_bound(deltaGreyLevels.begin(), deltaGreyLevels.end(), greyLevel) - deltaGreyLevels.begin());
+	};
+	for (size_t i = 0; i < base->indices.size(); i++) {
+		counts[getDeltaIndex(baseGreyLevels[base->indices[i] / nrRunLengths]) * nrRunLengths + base->indices[i] % nrRunLengths] += base->counts[i];
+	}
+	int nrRows = int(voiShape[0]);
+	int nrCols = int(voiShape[1]);
+	int nrDepths = int(voiShape[2]);
+	auto isInside = [&](int row, int col, int voxelDepth) {
+		return row >= 0 && row < nrRows && col >= 0 && col < nrCols && voxelDepth >= 0 && voxelDepth < nrDepths;
+	};
+	//every line is identified by its first voxel
+	vector<size_t> voxels;
+	getChangedVoxels(depth, voxels);
+	vector<size_t> lineStarts;
+	for (size_t i = 0; i < voxels.size(); i++) {
+		int voxelDepth = int(voxels[i] % nrDepths);
+		int col = int((voxels[i] / nrDepths) % nrCols);
+		int row = int(voxels[i] / (size_t(nrDepths) * nrCols));
+		while (isInside(row - stepRow, col - stepCol, voxelDepth - stepDepth)) {
+			row -= stepRow;
+			col -= stepCol;
+			voxelDepth -= stepDepth;
+		}
+		lineStarts.push_back((size_t(row) * nrCols + col) * nrDepths + voxelDepth);
+	}
+	std::sort(lineStarts.begin(), lineStarts.end());
+	lineStarts.erase(std::unique(lineStarts.begin(), lineStarts.end()), lineStarts.end());
+	const float *values[2] = { voiMatrix.data(), inputMatrix.origin() };
+	vector<size_t> line;
+	for (size_t i = 0; i < lineStarts.size(); i++) {
+		line.clear();
+		int voxelDepth = int(lineStarts[i] % nrDepths);
+		int col = int((lineStarts[i] / nrDepths) % nrCols);
+		int row = int(lineStarts[i] / (size_t(nrDepths) * nrCols));
+		for (; isInside(row, col, voxelDepth); row += stepRow, col += stepCol, voxelDepth += stepDepth) {
+			line.push_back((size_t(row) * nrCols + col) * nrDepths + voxelDepth);
+		}
+		//the runs of the line in the base VOI are removed, the runs in the perturbed VOI are added
+		for (int j = 0; j < 2; j++) {
+			size_t runLength = 0;
+			for (size_t k = 0; k < line.size(); k++) {
+				float value = values[j][line[k]];
+				if (std::isnan(value)) {
+					continue;
+				}
+				runLength++;
+				if (k + 1 < line.size() && values[j][line[k + 1]] == value) {
+					continue;
+				}
+				if (runLength <= nrRunLengths) {
+					counts[getDeltaIndex(value) * nrRunLengths + runLength - 1] += j == 0 ? -1 : 1;
+				}
+				runLength = 0;
+			}
+		}
+	}
+	//grey levels that are not part of the perturbed VOI cannot have counts
+	vector<long> perturbedIndex(deltaGreyLevels.size(), -1);
+	for (size_t i = 0; i < perturbedGreyLevels.size(); i++) {
+		perturbedIndex[getDeltaIndex(perturbedGreyLevels[i])] = long(i);
+	}
+	for (size_t i = 0; i < deltaGreyLevels.size(); i++) {
+		for (size_t j = 0; j < nrRunLengths; j++) {
+			if (perturbedIndex[i] < 0 && counts[i * nrRunLengths + j] != 0) {
+				return false;
+			}
+		}
+	}
+	for (size_t i = 0; i < deltaGreyLevels.size(); i++) {
+		if (perturbedIndex[i] < 0) {
+			continue;
+		}
+		for (size_t j = 0; j < nrRunLengths; j++) {
+			matrix[perturbedIndex[i]][j] += counts[i * nrRunLengths + j];
+		}
+	}
+	return true;
+}
+
+/*!
+\brief beginCount
+The function beginCount is called before a count matrix is filled, record then stores only the counts that were added.
+*/
+void TextureMatrixStore::beginCount(const boost::multi_array<float, 2> &matrix) {
+	if (recording) {
+		countStart.assign(matrix.origin(), matrix.origin() + matrix.num_elements());
+	}
+}
+
+/*!
+\brief record
+The function record stores the counts that were added to the matrix since beginCount. \n
+If the key was already recorded (e.g. the same slice and direction by another aggregation method), it is not stored again.
+@param[in] key: key of the matrix (see getTextureMatrixKey)
+@param[in] matrix: filled count matrix (without distance weights)
+*/
+void TextureMatrixStore::record(const string &key, const boost::multi_array<float, 2> &matrix) {
+	if (!recording) {
+		return;
+	}
+	string storeKey = getStoreKey(key, matrix);
+	if (matrices.find(storeKey) != matrices.end() || countStart.size() != matrix.num_elements()) {
+		return;
+	}
+	StoredMatrix &stored = matrices[storeKey];
+	stored.nrRows = matrix.shape()[0];
+	stored.nrCols = matrix.shape()[1];
+	const float *elements = matrix.origin();
+	for (size_t i = 0; i < matrix.num_elements(); i++) {
+		if (elements[i] != countStart[i]) {
+			stored.indices.push_back(uint32_t(i));
+			stored.counts.push_back(elements[i] - countStart[i]);
+		}
+	}
+}
+
+/*!
+\brief fillPairMatrix
+The function fillPairMatrix fills a co-occurrence matrix: the counts are taken from a loaded file (load) or from the matrix of the base mask
+(loadPairDelta), otherwise count is called and the counts it adds are recorded.
+@param[in] key: key of the matrix (see getTextureMatrixKey)
+@param[in] inputMatrix: discretized VOI
+@param[in,out] matrix: count matrix
+@param[in] depth, offsetRow, offsetCol, offsetDepth: slice and direction of the pairs (see loadPairDelta)
+@param[in] count: function that counts the voxel pairs of the VOI in the matrix
+*/
+template <class F>
+void TextureMatrixStore::fillPairMatrix(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix,
+	int depth, int offsetRow, int offsetCol, int offsetDepth, F count) {
+	if (load(key, matrix) || loadPairDelta(key, inputMatrix, matrix, depth, offsetRow, offsetCol, offsetDepth)) {
+		return;
+	}
+	beginCount(matrix);
+	count();
+	record(key, matrix);
+}
+
+/*!
+\brief fillRunMatrix
+The function fillRunMatrix fills a run length matrix like fillPairMatrix, the counts of the base mask are used with loadRunDelta.
+@param[in] depth, stepRow, stepCol, stepDepth: slice and direction of the runs (see loadRunDelta)
+@param[in] count: function that counts the runs of the VOI in the matrix
+*/
+template <class F>
+void TextureMatrixStore::fillRunMatrix(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix,
+	int depth, int stepRow, int stepCol, int stepDepth, F count) {
+	if (load(key, matrix) || loadRunDelta(key, inputMatrix, matrix, depth, stepRow, stepCol, stepDepth)) {
+		return;
+	}
+	beginCount(matrix);
+	count();
+	record(key, matrix);
+}
+
+/*!
+\brief setVOI
+The function setVOI stores the discretized VOI while the matrices are recorded, it is needed for all calculations that do not use the
+stored matrices (e.g. the number of grey levels or the intensity histogram). \n
+If the matrices of a base mask are kept, the VOI is the VOI of a perturbed mask and is compared with the base VOI (see setPerturbedVOI).
+@param[in] imageMatrix: discretized VOI (NAN outside of the mask)
+@param[in] elements: values of the VOI before the discretization
+@param[in] spacing: voxel size
+*/
+void TextureMatrixStore::setVOI(const boost::multi_array<float, 3> &imageMatrix, const vector<float> &elements, const vector<float> &spacing) {
+	if (!recording) {
+		if (keepBase) {
+			setPerturbedVOI(imageMatrix);
+		}
+		return;
+	}
+	voiShape.assign(imageMatrix.shape(), imageMatrix.shape() + 3);
+	voiMatrix.assign(imageMatrix.origin(), imageMatrix.origin() + imageMatrix.num_elements());
+	voiElements = elements;
+	voiSpacing = spacing;
+}
+
+/*!
+\brief setPerturbedVOI
+The function setPerturbedVOI determines the voxels that were added to or removed from the base VOI. \n
+The matrices of the base mask can only be used if both VOIs have the same size and all voxels of both VOIs have the same grey level
+(e.g. not if the discretization depends on the minimum and maximum value of the VOI and these changed).
+@param[in] imageMatrix: discretized VOI of the perturbed mask
+*/
+void TextureMatrixStore::setPerturbedVOI(const boost::multi_array<float, 3> &imageMatrix) {
+	perturbed = false;
+	changedVoxels.clear();
+	if (voiShape.size() != 3 || !std::equal(voiShape.begin(), voiShape.end(), imageMatrix.shape())) {
+		return;
+	}
+	const float *values = imageMatrix.origin();
+	size_t nrDepths = voiShape[2];
+	vector<vector<size_t> > voxels(nrDepths);
+	perturbedGreyLevels.clear();
+	for (size_t i = 0; i < voiMatrix.size(); i++) {
+		bool inBase = !std::isnan(voiMatrix[i]);
+		bool inPerturbed = !std::isnan(values[i]);
+		if (inBase && inPerturbed && voiMatrix[i] != values[i]) {
+			return;
+		}
+		if (inBase != inPerturbed) {
+			voxels[i % nrDepths].push_back(i);
+		}
+		if (inPerturbed) {
+			perturbedGreyLevels.push_back(values[i]);
+		}
+	}
+	if (baseGreyLevels.empty()) {
+		for (size_t i = 0; i < voiMatrix.size(); i++) {
+			if (!std::isnan(voiMatrix[i])) {
+				baseGreyLevels.push_back(voiMatrix[i]);
+			}
+		}
+		std::sort(baseGreyLevels.begin(), baseGreyLevels.end());
+		baseGreyLevels.erase(std::unique(baseGreyLevels.begin(), baseGreyLevels.end()), baseGreyLevels.end());
+	}
+	std::sort(perturbedGreyLevels.begin(), perturbedGreyLevels.end());
+	perturbedGreyLevels.erase(std::unique(perturbedGreyLevels.begin(), perturbedGreyLevels.end()), perturbedGreyLevels.end());
+	deltaGreyLevels.clear();
+	std::set_union(baseGreyLevels.begin(), baseGreyLevels.end(), perturbedGreyLevels.begin(), perturbedGreyLevels.end(),
+		back_inserter(deltaGreyLevels));
+	changedVoxels.swap(voxels);
+	perturbed = true;
+}
+
+//changed voxels of one slice (depth >= 0) or of the whole VOI
+void TextureMatrixStore::getChangedVoxels(int depth, vector<size_t> &voxels) const {
+	voxels.clear();
+	if (depth >= 0) {
+		if (size_t(depth) < changedVoxels.size()) {
+			voxels = changedVoxels[depth];
+		}
+		return;
+	}
+	for (size_t i = 0; i < changedVoxels.size(); i++) {
+		voxels.insert(voxels.end(), changedVoxels[i].begin(), changedVoxels[i].end());
+	}
+}
+
+void TextureMatrixStore::getVOI(boost::multi_array<float, 3> &imageMatrix, vector<float> &elements, vector<float> &spacing) const {
+	imageMatrix.resize(boost::extents[voiShape[0]][voiShape[1]][voiShape[2]]);
+	std::copy(voiMatrix.begin(), voiMatrix.end(), imageMatrix.origin());
+	elements = voiElements;
+	spacing = voiSpacing;
+}
+
+template <class V>
+void writeStoreVector(ofstream &file, const vector<V> &values) {
+	uint64_t size = values.size();
+	file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	if (size > 0) {
+		file.write(reinterpret_cast<const char*>(values.data()), std::streamsize(size * sizeof(V)));
+	}
+}
+
+template <class V>
+bool readStoreVector(ifstream &file, vector<V> &values) {
+	uint64_t size = 0;
+	if (!file.read(reinterpret_cast<char*>(&size), sizeof(size)) || size > (uint64_t(1) << 34) / sizeof(V)) {
+		return false;
+	}
+	values.resize(size_t(size));
+	return size == 0 || bool(file.read(reinterpret_cast<char*>(values.data()), std::streamsize(size * sizeof(V))));
+}
+
+/*!
+\brief write
+The function write writes the discretized VOI and all recorded matrices to a binary file.
+@param[in] fileName: name of the file
+@param[out] bool: false if the file cannot be written
+*/
+bool TextureMatrixStore::write(const string &fileName) const {
+	ofstream file(fileName, ios::out | ios::binary | ios::trunc);
+	file << textureMatrixHeader << "\n";
+	vector<uint64_t> shape(voiShape.begin(), voiShape.end());
+	writeStoreVector(file, shape);
+	writeStoreVector(file, voiSpacing);
+	writeStoreVector(file, voiMatrix);
+	writeStoreVector(file, voiElements);
+	uint64_t nrMatrices = matrices.size();
+	file.write(reinterpret_cast<const char*>(&nrMatrices), sizeof(nrMatrices));
+	for (map<string, StoredMatrix>::const_iterator matrixIt = matrices.begin(); matrixIt != matrices.end(); ++matrixIt) {
+		writeStoreVector(file, vector<char>(matrixIt->first.begin(), matrixIt->first.end()));
+		vector<uint64_t> size = { matrixIt->second.nrRows, matrixIt->second.nrCols };
+		writeStoreVector(file, size);
+		writeStoreVector(file, matrixIt->second.indices);
+		writeStoreVector(file, matrixIt->second.counts);
+	}
+	return bool(file);
+}
+
+/*!
+\brief read
+The function read loads a file written by write, afterwards the stored matrices are used by the texture classes.
+@param[in] fileName: name of the file
+@param[out] bool: false if the file cannot be read or is not a texture matrix file
+*/
+bool TextureMatrixStore::read(const string &fileName) {
+	reset();
+	ifstream file(fileName, ios::in | ios::binary);
+	string header;
+	if (!file || !getline(file, header) || header != textureMatrixHeader) {
+		return false;
+	}
+	vector<uint64_t> shape;
+	uint64_t nrMatrices = 0;
+	if (!readStoreVector(file, shape) || shape.size() != 3 || !readStoreVector(file, voiSpacing) || voiSpacing.size() != 3
+		|| !readStoreVector(file, voiMatrix) || voiMatrix.size() != shape[0] * shape[1] * shape[2] || !readStoreVector(file, voiElements)
+		|| !file.read(reinterpret_cast<char*>(&nrMatrices), sizeof(nrMatrices))) {
+		reset();
+		return false;
+	}
+	voiShape.assign(shape.begin(), shape.end());
+	for (uint64_t i = 0; i < nrMatrices; i++) {
+		vector<char> key;
+		vector<uint64_t> size;
+		StoredMatrix stored;
+		if (!readStoreVector(file, key) || !readStoreVector(file, size) || size.size() != 2 || !readStoreVector(file, stored.indices)
+			|| !readStoreVector(file, stored.counts) || stored.indices.size() != stored.counts.size()) {
+			reset();
+			return false;
+		}
+		stored.nrRows = size_t(size[0]);
+		stored.nrCols = size_t(size[1]);
+		for (size_t j = 0; j < stored.indices.size(); j++) {
+			if (stored.indices[j] >= stored.nrRows * stored.nrCols) {
+				reset();
+				return false;
+			}
+		}
+		matrices[string(key.begin(), key.end())] = stored;
+	}
+	loaded = true;
+	return true;
+}
+
+/*!
+\brief reset
+The function reset empties the store and stops recording. \n
+It is called when the calculation of one case is finished.
+*/
+void TextureMatrixStore::reset() {
+	recording = false;
+	loaded = false;
+	keepBase = false;
+	perturbed = false;
+	matrices.clear();
+	changedVoxels.clear();
+	baseGreyLevels.clear();
+	perturbedGreyLevels.clear();
+	deltaGreyLevels.clear();
+	countStart.clear();
+	voiShape.clear();
+	voiMatrix.clear();
+	voiElements.clear();
+	voiSpacing.clear();
+}
+
+string getTextureMatrixKey(const string &matrixType, int first, int second, int third) {
+	return matrixType + "_" + to_string(first) + "_" + to_string(second) + "_" + to_string(third);
+}
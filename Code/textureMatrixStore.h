@@ -0,0 +1,108 @@
+#ifndef TEXTUREMATRIXSTORE_H_INCLUDED
+#define TEXTUREMATRIXSTORE_H_INCLUDED
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+#include "boost/multi_array.hpp"
+using namespace std;
+
+/*! \file */
+
+//first line of every texture matrix file
+const string textureMatrixHeader = "RaCaT texture matrices 1";
+
+/*!
+The class TextureMatrixStore keeps the count matrices of the texture features (GLCM and GLRLM for every slice and direction,
+before the distance weights are applied), so that the features can be calculated again with other aggregation methods,
+distance norms or emphasis powers without touching the image. \n
+When recording, every count matrix that is filled is stored (only the elements that are not 0). The store is written together
+with the discretized VOI to a binary file per case (outputFolder_textureMatrices.bin). \n
+When the file is loaded, the fill functions of the texture classes take the counts from the store instead of going through the
+VOI; matrices that are not in the store (e.g. other sizes or families) are calculated from the stored VOI. \n
+The fill functions only call fillPairMatrix (GLCM) or fillRunMatrix (GLRLM) with the counting of the matrix, these functions decide
+whether the counts are loaded, calculated from the base mask or counted and recorded. \n
+Like the matrix pool, every thread has its own store (caseStore), it is emptied with reset() after every case. \n
+For the perturbed masks of a case (see MaskPerturbation) the matrices of the base mask are kept: as the perturbed VOI differs from the
+base VOI only in a few voxels, only the voxel pairs (GLCM) and the runs (GLRLM) that contain one of these voxels are counted again
+and the difference is added to the stored counts (loadPairDelta, loadRunDelta).
+*/
+class TextureMatrixStore {
+private:
+	//count matrix, only the elements that are not 0 are stored
+	struct StoredMatrix {
+		size_t nrRows;
+		size_t nrCols;
+		vector<uint32_t> indices;
+		vector<float> counts;
+	};
+	bool recording;
+	bool loaded;
+	//the matrices are kept as base for the perturbed masks of the case
+	bool keepBase;
+	//the actual VOI is a perturbed version of the base VOI, changedVoxels contains for every slice the voxels that were added or removed
+	bool perturbed;
+	vector<vector<size_t> > changedVoxels;
+	//grey levels of the base VOI, of the perturbed VOI and of both (the GLRLM rows are the indices of the grey levels)
+	vector<float> baseGreyLevels;
+	vector<float> perturbedGreyLevels;
+	vector<float> deltaGreyLevels;
+	map<string, StoredMatrix> matrices;
+	//content of the matrix before the counting started (the fill functions add to matrices that can already contain counts)
+	vector<float> countStart;
+	//discretized VOI and its values before the discretization
+	vector<size_t> voiShape;
+	vector<float> voiMatrix;
+	vector<float> voiElements;
+	vector<float> voiSpacing;
+
+	string getStoreKey(const string &key, const boost::multi_array<float, 2> &matrix) const;
+	const StoredMatrix *getBaseMatrix(const string &key) const;
+	void setPerturbedVOI(const boost::multi_array<float, 3> &imageMatrix);
+	void getChangedVoxels(int depth, vector<size_t> &voxels) const;
+
+public:
+	TextureMatrixStore() : recording(false), loaded(false), keepBase(false), perturbed(false) {
+	}
+	~TextureMatrixStore() {
+	}
+	TextureMatrixStore(const TextureMatrixStore &) = delete;
+	TextureMatrixStore &operator=(const TextureMatrixStore &) = delete;
+
+	static TextureMatrixStore &caseStore();
+	void startRecording();
+	void startPerturbations();
+	void finishMask();
+	bool isLoaded() const;
+	bool load(const string &key, boost::multi_array<float, 2> &matrix) const;
+	bool loadPairDelta(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix, int depth,
+		int offsetRow, int offsetCol, int offsetDepth) const;
+	bool loadRunDelta(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix, int depth,
+		int stepRow, int stepCol, int stepDepth) const;
+	void beginCount(const boost::multi_array<float, 2> &matrix);
+	void record(const string &key, const boost::multi_array<float, 2> &matrix);
+	template <class F>
+	void fillPairMatrix(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix, int depth,
+		int offsetRow, int offsetCol, int offsetDepth, F count);
+	template <class F>
+	void fillRunMatrix(const string &key, const boost::multi_array<float, 3> &inputMatrix, boost::multi_array<float, 2> &matrix, int depth,
+		int stepRow, int stepCol, int stepDepth, F count);
+	void setVOI(const boost::multi_array<float, 3> &imageMatrix, const vector<float> &elements, const vector<float> &spacing);
+	void getVOI(boost::multi_array<float, 3> &imageMatrix, vector<float> &elements, vector<float> &spacing) const;
+	bool write(const string &fileName) const;
+	bool read(const string &fileName);
+	void reset();
+};
+
+//key of a count matrix, e.g. GLCM2D_3_45_0 for the GLCM of slice 3 and angle 45
+string getTextureMatrixKey(const string &matrixType, int first, int second, int third = 0);
+
+#include "textureMatrixStore.cpp"
+
+#endif // TEXTUREMATRIXSTORE_H_INCLUDED
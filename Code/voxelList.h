@@ -0,0 +1,212 @@
+#ifndef VOXELLIST_H_INCLUDED
+#define VOXELLIST_H_INCLUDED
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+#include "boost/multi_array.hpp"
+using namespace std;
+
+/*! \file */
+
+//if less than this part of the bounding box of the VOI is inside the mask, the voxel list is used
+const double maxOccupancyDenseMatrix = 0.1;
+
+/*!
+\brief nextMatrixGeneration
+Every time a VOI matrix is filled, its owner takes a new generation (unique in the process). A voxel list is only used for the
+generation it was created from, so it is never used for a matrix that was refilled in the same memory (the address and the size
+of a matrix do not show that its content changed).
+*/
+inline unsigned long long nextMatrixGeneration() {
+	static std::atomic<unsigned long long> generation(0);
+	return ++generation;
+}
+
+/*!
+The class VoxelList is a sparse representation of the VOI matrix: it only contains the voxels inside the mask. \n
+This is useful for masks that fill only a small part of their bounding box (e.g. several lesions in a whole body PET),
+where looping over the whole box and checking every element for NAN takes most of the time. \n
+The voxels are stored slice by slice in the same order as the loops over the dense matrix
+(depth, row, col), so that the results of the calculations do not change: \n
+- linearIndices: position of the voxel in the box, (depth*nrRows + row)*nrCols + col \n
+- values: intensity value of the voxel \n
+- sliceOffsets: the voxels of slice depth are stored from sliceOffsets[depth] to sliceOffsets[depth+1] \n
+The list belongs to one generation of the matrix (see nextMatrixGeneration).
+*/
+template <class T>
+class VoxelList {
+private:
+	//the matrix and its generation from which the list was created, used to check that a matrix is described by the list
+	const T *sourceData;
+	unsigned long long sourceGeneration;
+
+public:
+	vector<int> linearIndices;
+	vector<T> values;
+	vector<int> sliceOffsets;
+	int nrRows;
+	int nrCols;
+	int nrDepth;
+
+	VoxelList() : sourceData(nullptr), sourceGeneration(0), nrRows(0), nrCols(0), nrDepth(0) {
+	}
+	~VoxelList() {
+	}
+
+	template <size_t R>
+	void fill(const boost::multi_array<T, R> &inputMatrix, unsigned long long generation);
+	void clear();
+	template <size_t R>
+	bool describes(const boost::multi_array<T, R> &inputMatrix) const;
+	template <size_t R>
+	bool describes(const boost::multi_array<T, R> &inputMatrix, unsigned long long generation) const;
+	void getPosition(int voxelNr, int &row, int &col, int &depth) const;
+	int size() const {
+		return int(linearIndices.size());
+	}
+};
+
+/*!
+\brief fill
+The function fill stores all elements of the matrix that are not NAN in the list.
+@param[in] inputMatrix: matrix of the VOI
+@param[in] generation: generation of the matrix (see nextMatrixGeneration)
+*/
+template <class T>
+template <size_t R>
+void VoxelList<T>::fill(const boost::multi_array<T, R> &inputMatrix, unsigned long long generation) {
+	clear();
+	nrRows = inputMatrix.shape()[0];
+	nrCols = inputMatrix.shape()[1];
+	nrDepth = inputMatrix.shape()[2];
+	sourceData = inputMatrix.data();
+	sourceGeneration = generation;
+	sliceOffsets.reserve(nrDepth + 1);
+	for (int depth = 0; depth < nrDepth; depth++) {
+		sliceOffsets.push_back(int(linearIndices.size()));
+		for (int row = 0; row < nrRows; row++) {
+			for (int col = 0; col < nrCols; col++) {
+				if (!std::isnan(inputMatrix[row][col][depth])) {
+					linearIndices.push_back((depth*nrRows + row)*nrCols + col);
+					values.push_back(inputMatrix[row][col][depth]);
+				}
+			}
+		}
+	}
+	sliceOffsets.push_back(int(linearIndices.size()));
+}
+
+template <class T>
+void VoxelList<T>::clear() {
+	linearIndices.clear();
+	values.clear();
+	sliceOffsets.clear();
+	sourceData = nullptr;
+	sourceGeneration = 0;
+	nrRows = 0;
+	nrCols = 0;
+	nrDepth = 0;
+}
+
+/*!
+\brief describes
+The function describes checks if the list was created from the memory of this matrix with its size. \n
+This does not show that the content of the matrix did not change, so the owner of the matrix has to check the generation as well
+(see Image::getVoxelList).
+*/
+template <class T>
+template <size_t R>
+bool VoxelList<T>::describes(const boost::multi_array<T, R> &inputMatrix) const {
+	return sourceData != nullptr && inputMatrix.data() == sourceData && int(inputMatrix.shape()[0]) == nrRows
+		&& int(inputMatrix.shape()[1]) == nrCols && int(inputMatrix.shape()[2]) == nrDepth;
+}
+
+/*!
+\brief describes
+Like describes above, but the list also has to be created from this generation of the matrix (see nextMatrixGeneration).
+Only then the voxel list can be used instead of looping over the matrix.
+*/
+template <class T>
+template <size_t R>
+bool VoxelList<T>::describes(const boost::multi_array<T, R> &inputMatrix, unsigned long long generation) const {
+	return generation != 0 && generation == sourceGeneration && describes(inputMatrix);
+}
+
+/*!
+\brief getPosition
+The function getPosition converts the linear index of a voxel back to its row, column and depth in the matrix.
+*/
+template <class T>
+void VoxelList<T>::getPosition(int voxelNr, int &row, int &col, int &depth) const {
+	int index = linearIndices[voxelNr];
+	col = index % nrCols;
+	index = index / nrCols;
+	row = index % nrRows;
+	depth = index / nrRows;
+}
+
+
+/*!
+\brief sparseVoxels
+Returns the voxel list if it can be used for this matrix, otherwise nullptr (then the dense matrix has to be used).
+The generation of the list was already checked when it was taken from the image (see Image::getVoxelList).
+*/
+template <class T, size_t R>
+const VoxelList<T> *sparseVoxels(const VoxelList<T> *voxelList, const boost::multi_array<T, R> &inputMatrix) {
+	if (voxelList != nullptr && voxelList->describes(inputMatrix)) {
+		return voxelList;
+	}
+	return nullptr;
+}
+
+/*!
+\brief forEachVoxel
+The function forEachVoxel calls visit(row, col, depth) for the voxels of the matrix in the order depth, row, col. \n
+If a voxel list is given, only the voxels of the list are visited, otherwise every element of the matrix.
+The NAN check of the visited elements stays in the calling function.
+@param[in] inputMatrix: matrix of the VOI (only its size is used)
+@param[in] voxels: voxel list of the matrix or nullptr
+@param[in] visit: function that is called for every voxel
+*/
+template <class T, size_t R, class F>
+void forEachVoxel(const boost::multi_array<T, R> &inputMatrix, const VoxelList<T> *voxels, F visit) {
+	if (voxels != nullptr) {
+		int row, col, depth;
+		for (int voxelNr = 0; voxelNr < voxels->size(); voxelNr++) {
+			voxels->getPosition(voxelNr, row, col, depth);
+			visit(row, col, depth);
+		}
+		return;
+	}
+	for (int depth = 0; depth < inputMatrix.shape()[2]; depth++) {
+		for (int row = 0; row < inputMatrix.shape()[0]; row++) {
+			for (int col = 0; col < inputMatrix.shape()[1]; col++) {
+				visit(row, col, depth);
+			}
+		}
+	}
+}
+
+/*!
+\brief forEachVoxelInSlice
+Same as forEachVoxel, but only for the slice depth.
+*/
+template <class T, size_t R, class F>
+void forEachVoxelInSlice(const boost::multi_array<T, R> &inputMatrix, const VoxelList<T> *voxels, int depth, F visit) {
+	if (voxels != nullptr) {
+		int row, col, voxelDepth;
+		for (int voxelNr = voxels->sliceOffsets[depth]; voxelNr < voxels->sliceOffsets[depth + 1]; voxelNr++) {
+			voxels->getPosition(voxelNr, row, col, voxelDepth);
+			visit(row, col, depth);
+		}
+		return;
+	}
+	for (int row = 0; row < inputMatrix.shape()[0]; row++) {
+		for (int col = 0; col < inputMatrix.shape()[1]; col++) {
+			visit(row, col, depth);
+		}
+	}
+}
+
+#endif // VOXELLIST_H_INCLUDED